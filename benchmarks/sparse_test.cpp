@@ -14,6 +14,7 @@
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/SGSparseMatrix.h>
 #include <shogun/lib/SGSparseVector.h>
+#include <shogun/features/SparseFeatures.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/eigen3.h>
 #include <pthread.h>
@@ -103,6 +104,27 @@ SGVector<float64_t> sg_m_apply(SGSparseMatrix<float64_t> m, SGVector<float64_t>
 	return r;
 }
 
+/* copies the array of sparse vectors into CSR buffers */
+void to_csr(SGSparseMatrix<float64_t> m, SGVector<index_t>& indptr,
+		SGVector<index_t>& indices, SGVector<float64_t>& values)
+{
+	indptr=SGVector<index_t>(m.num_vectors+1);
+	indptr[0]=0;
+	for (index_t i=0; i<m.num_vectors; ++i)
+		indptr[i+1]=indptr[i]+m[i].num_feat_entries;
+
+	indices=SGVector<index_t>(indptr[m.num_vectors]);
+	values=SGVector<float64_t>(indptr[m.num_vectors]);
+	for (index_t i=0; i<m.num_vectors; ++i)
+	{
+		for (index_t j=0; j<m[i].num_feat_entries; ++j)
+		{
+			indices[indptr[i]+j]=m[i].features[j].feat_index;
+			values[indptr[i]+j]=m[i].features[j].entry;
+		}
+	}
+}
+
 int main(int argc, char** argv)
 {
 	Eigen::initParallel();
@@ -118,7 +140,7 @@ int main(int argc, char** argv)
 	CTime time;
 	CMath::init_random(17);
 
-	SG_SPRINT("time\tshogun (s)\teigen3 (s)\n\n");
+	SG_SPRINT("time\tshogun (s)\tshogun csr (s)\teigen3 (s)\n\n");
 	for (index_t t=0; t<times; ++t)
 	{
 //#ifdef RUN_SHOGUN
@@ -180,6 +202,26 @@ int main(int argc, char** argv)
 		Map<VectorXd> map_r(r.vector, r.vlen);
 		float64_t sg_norm=map_r.norm();
 
+		// same matrix in CSR layout, the buffers are used without copying
+		SGVector<index_t> indptr;
+		SGVector<index_t> indices;
+		SGVector<float64_t> values;
+		to_csr(sg_m, indptr, indices, values);
+		CSparseFeatures<float64_t>* csr_feats=new CSparseFeatures<float64_t>(
+				indptr, indices, values, size);
+		SG_REF(csr_feats);
+		csr_feats->parallel->set_num_threads(8);
+		SGVector<float64_t> csr_r(size);
+
+		time.start();
+		for (index_t i=0; i<n; ++i)
+			csr_feats->dense_dot_range(csr_r.vector, 0, size, NULL, v.vector, v.vlen, 0.0);
+		float64_t csr_time = time.cur_time_diff();
+
+		Map<VectorXd> map_csr_r(csr_r.vector, csr_r.vlen);
+		float64_t csr_norm=map_csr_r.norm();
+		SG_UNREF(csr_feats);
+
 //#endif // RUN_SHOGUN
 
 //#ifdef RUN_EIGEN
@@ -195,9 +237,10 @@ int main(int argc, char** argv)
 		float64_t eig_norm=eig_r.norm();
 //#endif // RUN_EIGEN
 
-		SG_SPRINT("%d\t%lf\t%lf\n", t, sg_time, eig_time);
+		SG_SPRINT("%d\t%lf\t%lf\t%lf\n", t, sg_time, csr_time, eig_time);
 		//ASSERT(sg_time>eig_time);
 		ASSERT(CMath::abs(sg_norm-eig_norm)<=CMath::MACHINE_EPSILON)
+		ASSERT(CMath::abs(csr_norm-sg_norm)<=1E-10*sg_norm)
 
 		SG_FREE(vec);
 		SG_FREE(rest);
@@ -43,6 +43,7 @@
 %rename(LPBoost) CLPBoost;
 %rename(LPM) CLPM;
 %rename(MPDSVM) CMPDSVM;
+%rename(SGDEngine) CSGDEngine;
 %rename(OnlineSVMSGD) COnlineSVMSGD;
 %rename(OnlineLibLinear) COnlineLibLinear;
 %rename(Perceptron) CPerceptron;
@@ -103,6 +104,7 @@
 %include <shogun/classifier/LPBoost.h>
 %include <shogun/classifier/LPM.h>
 %include <shogun/classifier/svm/MPDSVM.h>
+%include <shogun/optimization/SGDEngine.h>
 %include <shogun/classifier/svm/OnlineSVMSGD.h>
 %include <shogun/classifier/svm/OnlineLibLinear.h>
 %include <shogun/classifier/Perceptron.h>
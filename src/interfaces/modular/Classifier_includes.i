@@ -16,6 +16,7 @@
  #include <shogun/classifier/LPBoost.h>
  #include <shogun/classifier/LPM.h>
  #include <shogun/classifier/svm/MPDSVM.h>
+ #include <shogun/optimization/SGDEngine.h>
  #include <shogun/classifier/svm/OnlineSVMSGD.h>
  #include <shogun/classifier/svm/OnlineLibLinear.h>
  #include <shogun/classifier/Perceptron.h>
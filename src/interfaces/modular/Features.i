@@ -86,6 +86,7 @@ PROTOCOLS_DENSELABELS(CRegressionLabels, RegressionLabels, float64_t, "d\0", NPY
 %rename(TOPFeatures) CTOPFeatures;
 %rename(SNPFeatures) CSNPFeatures;
 %rename(WDFeatures) CWDFeatures;
+%rename(PackedStringFeatures) CPackedStringFeatures;
 %rename(HashedWDFeatures) CHashedWDFeatures;
 %rename(HashedWDFeaturesTransposed) CHashedWDFeaturesTransposed;
 %rename(PolyFeatures) CPolyFeatures;
@@ -510,6 +511,7 @@ namespace shogun
 %include <shogun/features/TOPFeatures.h>
 %include <shogun/features/SNPFeatures.h>
 %include <shogun/features/WDFeatures.h>
+%include <shogun/features/PackedStringFeatures.h>
 %include <shogun/features/HashedWDFeatures.h>
 %include <shogun/features/HashedWDFeaturesTransposed.h>
 %include <shogun/features/PolyFeatures.h>
@@ -39,6 +39,7 @@
 #include <shogun/features/TOPFeatures.h>
 #include <shogun/features/SNPFeatures.h>
 #include <shogun/features/WDFeatures.h>
+#include <shogun/features/PackedStringFeatures.h>
 #include <shogun/features/HashedWDFeatures.h>
 #include <shogun/features/HashedWDFeaturesTransposed.h>
 #include <shogun/features/PolyFeatures.h>
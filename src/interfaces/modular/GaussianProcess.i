@@ -17,6 +17,7 @@
 %rename(LaplacianInferenceMethod) CLaplacianInferenceMethod;
 %rename(FITCInferenceMethod) CFITCInferenceMethod;
 %rename(EPInferenceMethod) CEPInferenceMethod;
+%rename(MatrixFreeInferenceMethod) CMatrixFreeInferenceMethod;
 
 %rename(LikelihoodModel) CLikelihoodModel;
 %rename(ProbitLikelihood) CProbitLikelihood;
@@ -50,6 +51,7 @@
 %include <shogun/machine/gp/LaplacianInferenceMethod.h>
 %include <shogun/machine/gp/FITCInferenceMethod.h>
 %include <shogun/machine/gp/EPInferenceMethod.h>
+%include <shogun/machine/gp/MatrixFreeInferenceMethod.h>
 
 %include <shogun/machine/GaussianProcessMachine.h>
 %include <shogun/classifier/GaussianProcessBinaryClassification.h>
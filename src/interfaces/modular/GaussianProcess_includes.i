@@ -17,6 +17,7 @@
  #include <shogun/machine/gp/LaplacianInferenceMethod.h>
  #include <shogun/machine/gp/FITCInferenceMethod.h>
  #include <shogun/machine/gp/EPInferenceMethod.h>
+ #include <shogun/machine/gp/MatrixFreeInferenceMethod.h>
 
  #include <shogun/machine/gp/MeanFunction.h>
  #include <shogun/machine/gp/ZeroMean.h>
@@ -31,9 +31,15 @@
 %rename(IndexBlockGroup) CIndexBlockGroup;
 %rename(IndexBlockTree) CIndexBlockTree;
 %rename(Data) CData;
+%rename(NeighborIndex) CNeighborIndex;
+%rename(SpaceTreeIndex) CSpaceTreeIndex;
+%rename(KDTreeIndex) CKDTreeIndex;
+%rename(BallTreeIndex) CBallTreeIndex;
+%rename(HNSWIndex) CHNSWIndex;
 
 %rename(IndependentComputationEngine) CIndependentComputationEngine;
 %rename(SerialComputationEngine) CSerialComputationEngine;
+%rename(ThreadPoolComputationEngine) CThreadPoolComputationEngine;
 
 
 %ignore RADIX_STACK_SIZE;
@@ -403,15 +409,22 @@ namespace shogun
 %include <shogun/lib/IndexBlockGroup.h>
 %include <shogun/lib/IndexBlockTree.h>
 %include <shogun/lib/Data.h>
+%include <shogun/lib/NeighborIndex.h>
+%include <shogun/lib/SpaceTreeIndex.h>
+%include <shogun/lib/KDTreeIndex.h>
+%include <shogun/lib/BallTreeIndex.h>
+%include <shogun/lib/HNSWIndex.h>
 
 /* Computation framework */
 
 /* Computation Engine */
 %rename (IndependentComputationEngine) CIndependentComputationEngine;
 %rename (SerialComputationEngine) CSerialComputationEngine;
+%rename (ThreadPoolComputationEngine) CThreadPoolComputationEngine;
 
 %include <shogun/lib/computation/engine/IndependentComputationEngine.h>
 %include <shogun/lib/computation/engine/SerialComputationEngine.h>
+%include <shogun/lib/computation/engine/ThreadPoolComputationEngine.h>
 
 /* Independent compution-job */
 %rename (IndependentJob) CIndepenentJob;
@@ -26,11 +26,17 @@
 #include <shogun/lib/IndexBlockGroup.h>
 #include <shogun/lib/IndexBlockTree.h>
 #include <shogun/lib/Data.h>
+#include <shogun/lib/NeighborIndex.h>
+#include <shogun/lib/SpaceTreeIndex.h>
+#include <shogun/lib/KDTreeIndex.h>
+#include <shogun/lib/BallTreeIndex.h>
+#include <shogun/lib/HNSWIndex.h>
 #include <shogun/lib/Tokenizer.h>
 #include <shogun/lib/DelimiterTokenizer.h>
 #include <shogun/lib/NGramTokenizer.h>
 #include <shogun/lib/computation/engine/IndependentComputationEngine.h>
 #include <shogun/lib/computation/engine/SerialComputationEngine.h>
+#include <shogun/lib/computation/engine/ThreadPoolComputationEngine.h>
 #include <shogun/lib/computation/job/IndependentJob.h>
 #include <shogun/lib/computation/jobresult/JobResult.h>
 #include <shogun/lib/computation/jobresult/ScalarResult.h>
@@ -23,6 +23,7 @@
 %rename(ProbingSampler) CProbingSampler;
 
 /* Linear operators */
+%rename(KernelMatrixOperator) CKernelMatrixOperator;
 %include <shogun/mathematics/linalg/linop/LinearOperator.h>
 namespace shogun
 {
@@ -141,6 +142,7 @@ namespace shogun
 %include <shogun/mathematics/linalg/linop/MatrixOperator.h>
 %include <shogun/mathematics/linalg/linop/SparseMatrixOperator.h>
 %include <shogun/mathematics/linalg/linop/DenseMatrixOperator.h>
+%include <shogun/mathematics/linalg/linop/KernelMatrixOperator.h>
 
 %include <shogun/mathematics/linalg/ratapprox/opfunc/OperatorFunction.h>
 %include <shogun/mathematics/linalg/ratapprox/opfunc/RationalApproximation.h>
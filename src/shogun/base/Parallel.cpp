@@ -64,6 +64,24 @@ int32_t Parallel::get_num_threads() const
 	return num_threads;
 }
 
+void Parallel::parallel_for(int32_t start, int32_t end,
+		range_function_t func, void* data, int32_t chunk_size) const
+{
+	if (start>=end)
+		return;
+
+#ifdef HAVE_PTHREAD
+	if (num_threads>1)
+	{
+		CThreadPool::get_thread_pool()->parallel_for(start, end, func, data,
+				num_threads, chunk_size);
+		return;
+	}
+#endif
+
+	func(start, end, 0, data);
+}
+
 int32_t Parallel::ref()
 {
 	return m_refcount->ref();
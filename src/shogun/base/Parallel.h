@@ -14,6 +14,7 @@
 #include <shogun/lib/config.h>
 #include <shogun/lib/common.h>
 #include <shogun/io/SGIO.h>
+#include <shogun/lib/ThreadPool.h>
 
 namespace shogun
 {
@@ -23,6 +24,9 @@ class RefCount;
  * For example it can be used to determine the number of CPU cores in your
  * computer and is the place where you define the number of CPUs that shall be
  * used in computations.
+ *
+ * Parallel loops should be run through parallel_for(), which hands them to
+ * the process wide CThreadPool instead of creating threads on every call.
  */
 class Parallel
 {
@@ -51,6 +55,27 @@ public:
 	 */
 	int32_t get_num_threads() const;
 
+	/** run func on all indices in [start, end) using up to get_num_threads()
+	 * threads of the process wide thread pool
+	 *
+	 * The range is processed in chunks that are distributed dynamically
+	 * among the threads, i.e. func is called on (possibly many) disjoint sub
+	 * ranges whose union is [start, end). Using a chunk_size of 1 turns each
+	 * index into an independent task.
+	 *
+	 * If the pool is busy with another loop (nested or concurrent calls),
+	 * func runs serially in the calling thread, see CThreadPool.
+	 *
+	 * @param start first index
+	 * @param end one past the last index
+	 * @param func function to call on sub ranges
+	 * @param data user data passed to func
+	 * @param chunk_size number of indices processed at once, if <=0 a chunk
+	 * size is chosen automatically
+	 */
+	void parallel_for(int32_t start, int32_t end, range_function_t func,
+			void* data, int32_t chunk_size=0) const;
+
 	/** ref
 	 * @return current ref counter
 	 */
@@ -2530,6 +2530,12 @@ void TParameter::get_incremental_hash(
 	}
 }
 
+bool
+TParameter::is_cont_data()
+{
+	return m_datatype.m_stype==ST_NONE && m_datatype.m_ptype!=PT_SGOBJECT;
+}
+
 bool
 TParameter::is_valid()
 {
@@ -2601,7 +2607,16 @@ TParameter::save(CSerializableFile* file, const char* prefix)
 
 		/* ******************************************************** */
 
-		for (index_t x=0; x<len_real_x; x++)
+		bool cont_data=file->supports_cont_data() && is_cont_data();
+		if (cont_data) {
+			int64_t num_bytes=int64_t(len_real_x)*len_real_y
+				*m_datatype.sizeof_stype();
+			if (num_bytes>0 && !file->write_cont_data(&m_datatype, m_name,
+						prefix, *(void**) m_parameter, num_bytes))
+				return false;
+		}
+
+		for (index_t x=0; !cont_data && x<len_real_x; x++)
 			for (index_t y=0; y<len_real_y; y++) {
 				if (!file->write_item_begin(
 						&m_datatype, m_name, prefix, y, x))
@@ -2666,26 +2681,44 @@ TParameter::load(CSerializableFile* file, const char* prefix)
 						&dims.vector[1], &dims.vector[0]))
 				return false;
 
-			switch (m_datatype.m_ctype)
+			if (m_datatype.m_ctype==CT_VECTOR ||
+					m_datatype.m_ctype==CT_SGVECTOR)
+				dims[0]=1;
+
+			bool cont_data=file->supports_cont_data() && is_cont_data();
+			if (cont_data)
 			{
-				case CT_NDARRAY:
-					SG_SNOTIMPLEMENTED
-					break;
-				case CT_VECTOR: case CT_SGVECTOR:
-					dims[0]=1;
-					new_cont(dims);
-					break;
-				case CT_MATRIX: case CT_SGMATRIX:
-					new_cont(dims);
-					break;
-				case CT_SCALAR:
-					break;
-				case CT_UNDEFINED: default:
-					SG_SERROR("Implementation error: undefined container type\n");
-					break;
+				/* the file provides the memory, e.g. as a view into a
+				 * memory mapped region that is released via SG_FREE */
+				delete_cont();
+				*(void**) m_parameter=NULL;
+
+				int64_t num_bytes=int64_t(dims[0])*dims[1]
+					*m_datatype.sizeof_stype();
+				if (num_bytes>0 && !file->read_cont_data(&m_datatype,
+							m_name, prefix, (void**) m_parameter, num_bytes))
+					return false;
+			}
+			else
+			{
+				switch (m_datatype.m_ctype)
+				{
+					case CT_NDARRAY:
+						SG_SNOTIMPLEMENTED
+						break;
+					case CT_VECTOR: case CT_SGVECTOR:
+					case CT_MATRIX: case CT_SGMATRIX:
+						new_cont(dims);
+						break;
+					case CT_SCALAR:
+						break;
+					case CT_UNDEFINED: default:
+						SG_SERROR("Implementation error: undefined container type\n");
+						break;
+				}
 			}
 
-			for (index_t x=0; x<dims[0]; x++)
+			for (index_t x=0; !cont_data && x<dims[0]; x++)
 			{
 				for (index_t y=0; y<dims[1]; y++)
 				{
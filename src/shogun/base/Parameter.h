@@ -190,6 +190,12 @@ struct TParameter
 	 */
 	bool is_valid();
 
+	/** test if the elements of this container parameter are plain data
+	 * that can be stored as one contiguous block (neither strings, sparse
+	 * vectors nor objects)
+	 */
+	bool is_cont_data();
+
 private:
 	char* new_prefix(const char* s1, const char* s2);
 	void delete_cont();
@@ -14,6 +14,7 @@
 #include <shogun/lib/common.h>
 #include <shogun/lib/Map.h>
 #include <shogun/base/Parallel.h>
+#include <shogun/lib/ThreadPool.h>
 #include <shogun/base/Version.h>
 
 #ifdef TRACE_MEMORY_ALLOCS
@@ -102,6 +103,7 @@ namespace shogun
 		SG_UNREF(sg_math);
 		SG_UNREF(sg_version);
 		SG_UNREF(sg_parallel);
+		CThreadPool::destroy_thread_pool();
 		SG_UNREF(sg_io);
 
 	}
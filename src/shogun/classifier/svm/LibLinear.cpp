@@ -14,6 +14,7 @@
 #include <shogun/lib/Signal.h>
 #include <shogun/lib/Time.h>
 #include <shogun/base/Parameter.h>
+#include <shogun/base/Parallel.h>
 #include <shogun/classifier/svm/LibLinear.h>
 #include <shogun/optimization/liblinear/tron.h>
 #include <shogun/features/DotFeatures.h>
@@ -188,6 +189,12 @@ bool CLibLinear::train_machine(CFeatures* data)
 		case L2R_L1LOSS_SVC_DUAL:
 			solve_l2r_l1l2_svc(&prob, epsilon, Cp, Cn, L2R_L1LOSS_SVC_DUAL);
 			break;
+		case L2R_L2LOSS_SVC_DUAL_ASYNC:
+			solve_l2r_l1l2_svc_async(&prob, epsilon, Cp, Cn, L2R_L2LOSS_SVC_DUAL);
+			break;
+		case L2R_L1LOSS_SVC_DUAL_ASYNC:
+			solve_l2r_l1l2_svc_async(&prob, epsilon, Cp, Cn, L2R_L1LOSS_SVC_DUAL);
+			break;
 		case L1R_L2LOSS_SVC:
 		{
 			//ASSUME FEATURES ARE TRANSPOSED ALREADY
@@ -434,6 +441,210 @@ void CLibLinear::solve_l2r_l1l2_svc(
 	SG_FREE(index);
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+struct LIBLINEAR_ASYNC_THREAD_PARAM
+{
+	const liblinear_problem* prob;
+	int32_t n;
+	int32_t* index;
+	int32_t* y;
+	float64_t* alpha;
+	float64_t* QD;
+	float64_t* diag;
+	float64_t* upper_bound;
+	float64_t* linear_term;
+	float64_t* w;
+	float64_t* PGmax;
+	float64_t* PGmin;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+static void solve_l2r_l1l2_svc_async_helper(int32_t start, int32_t end,
+		int32_t thread, void* p)
+{
+	LIBLINEAR_ASYNC_THREAD_PARAM* params=(LIBLINEAR_ASYNC_THREAD_PARAM*) p;
+	const liblinear_problem* prob=params->prob;
+	int32_t n=params->n;
+	int32_t* y=params->y;
+	float64_t* alpha=params->alpha;
+	float64_t* diag=params->diag;
+	float64_t* w=params->w;
+	float64_t PGmax=params->PGmax[thread];
+	float64_t PGmin=params->PGmin[thread];
+
+	for (int32_t s=start; s<end; s++)
+	{
+		int32_t i=params->index[s];
+		int32_t yi=y[i];
+
+		/* w is shared by all threads and read and updated without locking,
+		 * alpha[i] is only touched by the thread owning i in this pass */
+		float64_t G=prob->x->dense_dot(i, w, n);
+		if (prob->use_bias)
+			G+=w[n];
+
+		if (params->linear_term)
+			G=G*yi+params->linear_term[i];
+		else
+			G=G*yi-1;
+
+		float64_t C=params->upper_bound[GETI(i)];
+		G+=alpha[i]*diag[GETI(i)];
+
+		float64_t PG=0;
+		if (alpha[i]==0)
+		{
+			if (G<0)
+				PG=G;
+		}
+		else if (alpha[i]==C)
+		{
+			if (G>0)
+				PG=G;
+		}
+		else
+			PG=G;
+
+		PGmax=CMath::max(PGmax, PG);
+		PGmin=CMath::min(PGmin, PG);
+
+		if (fabs(PG)>1.0e-12)
+		{
+			float64_t alpha_old=alpha[i];
+			alpha[i]=CMath::min(CMath::max(alpha[i]-G/params->QD[i], 0.0), C);
+			float64_t d=(alpha[i]-alpha_old)*yi;
+
+			prob->x->add_to_dense_vec(d, i, w, n);
+
+			if (prob->use_bias)
+				w[n]+=d;
+		}
+	}
+
+	params->PGmax[thread]=PGmax;
+	params->PGmin[thread]=PGmin;
+}
+
+// An asynchronous parallel variant of the above coordinate descent
+// (Hogwild): every pass over the shuffled variables is split among the
+// threads, which update the shared w without locking. Lost updates only
+// perturb w slightly and w is recomputed from alpha at the end. There is
+// no shrinking as the active set would have to be shared.
+
+void CLibLinear::solve_l2r_l1l2_svc_async(
+			const liblinear_problem *prob, double eps, double Cp, double Cn, LIBLINEAR_SOLVER_TYPE st)
+{
+	int32_t l=prob->l;
+	int32_t w_size=prob->n;
+	int32_t iter=0;
+	float64_t* QD=SG_MALLOC(float64_t, l);
+	int32_t* index=SG_MALLOC(int32_t, l);
+	float64_t* alpha=SG_MALLOC(float64_t, l);
+	int32_t* y=SG_MALLOC(int32_t, l);
+
+	float64_t diag[3]={0.5/Cn, 0, 0.5/Cp};
+	float64_t upper_bound[3]={CMath::INFTY, 0, CMath::INFTY};
+	if (st==L2R_L1LOSS_SVC_DUAL)
+	{
+		diag[0]=0;
+		diag[2]=0;
+		upper_bound[0]=Cn;
+		upper_bound[2]=Cp;
+	}
+
+	int32_t n=prob->n;
+
+	if (prob->use_bias)
+		n--;
+
+	for (int32_t i=0; i<w_size; i++)
+		w[i]=0;
+
+	for (int32_t i=0; i<l; i++)
+	{
+		alpha[i]=0;
+		y[i]=prob->y[i]>0 ? +1 : -1;
+		QD[i]=diag[GETI(i)]+prob->x->dot(i, prob->x, i);
+		index[i]=i;
+	}
+
+	int32_t num_threads=parallel->get_num_threads();
+	LIBLINEAR_ASYNC_THREAD_PARAM params;
+	params.prob=prob;
+	params.n=n;
+	params.index=index;
+	params.y=y;
+	params.alpha=alpha;
+	params.QD=QD;
+	params.diag=diag;
+	params.upper_bound=upper_bound;
+	params.linear_term=m_linear_term.vector;
+	params.w=w.vector;
+	params.PGmax=SG_MALLOC(float64_t, num_threads);
+	params.PGmin=SG_MALLOC(float64_t, num_threads);
+
+	CTime start_time;
+	while (iter < max_iterations && !CSignal::cancel_computations())
+	{
+		if (m_max_train_time > 0 && start_time.cur_time_diff() > m_max_train_time)
+		  break;
+
+		for (int32_t i=0; i<l; i++)
+		{
+			int32_t j=CMath::random(i, l-1);
+			CMath::swap(index[i], index[j]);
+		}
+
+		for (int32_t t=0; t<num_threads; t++)
+		{
+			params.PGmax[t]=-CMath::INFTY;
+			params.PGmin[t]=CMath::INFTY;
+		}
+
+		parallel->parallel_for(0, l, solve_l2r_l1l2_svc_async_helper,
+				(void*) &params);
+
+		float64_t PGmax=SGVector<float64_t>::max(params.PGmax, num_threads);
+		float64_t PGmin=SGVector<float64_t>::min(params.PGmin, num_threads);
+
+		iter++;
+		float64_t gap=PGmax - PGmin;
+		SG_SABS_PROGRESS(gap, -CMath::log10(gap), -CMath::log10(1), -CMath::log10(eps), 6)
+
+		if (gap <= eps)
+			break;
+	}
+
+	SG_DONE()
+	SG_INFO("optimization finished, #iter = %d\n",iter)
+	if (iter >= max_iterations)
+		SG_WARNING("reaching max number of iterations\n")
+
+	/* w = \sum_i alpha_i y_i x_i, without the updates lost among threads */
+	for (int32_t i=0; i<l; i++)
+		alpha[i]*=y[i];
+
+	memset(w.vector, 0, sizeof(float64_t)*w_size);
+	prob->x->add_to_dense_vec_range(alpha, NULL, l, w.vector, n);
+	if (prob->use_bias)
+		w.vector[n]=SGVector<float64_t>::sum(alpha, l);
+
+	int32_t nSV=0;
+	for (int32_t i=0; i<l; i++)
+	{
+		if (alpha[i]!=0)
+			++nSV;
+	}
+	SG_INFO("nSV = %d\n",nSV)
+
+	SG_FREE(params.PGmax);
+	SG_FREE(params.PGmin);
+	SG_FREE(QD);
+	SG_FREE(alpha);
+	SG_FREE(y);
+	SG_FREE(index);
+}
+
 // A coordinate descent algorithm for
 // L1-regularized L2-loss support vector classification
 //
@@ -38,7 +38,13 @@ namespace shogun
 		/// L1 regularized logistic regression
 		L1R_LR,
 		/// L2 regularized linear logistic regression via dual
-		L2R_LR_DUAL
+		L2R_LR_DUAL,
+		/// L2 regularized SVM with L2-loss using asynchronous parallel dual
+		/// coordinate descent
+		L2R_L2LOSS_SVC_DUAL_ASYNC,
+		/// L2 regularized linear SVM with L1-loss using asynchronous
+		/// parallel dual coordinate descent
+		L2R_L1LOSS_SVC_DUAL_ASYNC
 	};
 
 /** @brief class to implement LibLinear */
@@ -177,6 +183,8 @@ class CLibLinear : public CLinearMachine
 		void train_one(const liblinear_problem *prob, const liblinear_parameter *param, double Cp, double Cn);
 		void solve_l2r_l1l2_svc(
 			const liblinear_problem *prob, double eps, double Cp, double Cn, LIBLINEAR_SOLVER_TYPE st);
+		void solve_l2r_l1l2_svc_async(
+			const liblinear_problem *prob, double eps, double Cp, double Cn, LIBLINEAR_SOLVER_TYPE st);
 
 		void solve_l1r_l2_svc(liblinear_problem *prob_col, double eps, double Cp, double Cn);
 		void solve_l1r_lr(const liblinear_problem *prob_col, double eps, double Cp, double Cn);
@@ -26,10 +26,14 @@
 #include <shogun/machine/OnlineLinearMachine.h>
 #include <shogun/features/streaming/StreamingDotFeatures.h>
 #include <shogun/loss/LossFunction.h>
+#include <shogun/optimization/SGDEngine.h>
 
 namespace shogun
 {
-/** @brief class OnlineSVMSGD */
+/** @brief class OnlineSVMSGD, trains with CSGDEngine
+ *
+ * The mini-batch size can be set up on the engine, see get_engine().
+ */
 class COnlineSVMSGD : public COnlineLinearMachine
 {
 	public:
@@ -94,91 +98,77 @@ class COnlineSVMSGD : public COnlineLinearMachine
 		 *
 		 * @param e new number of training epochs
 		 */
-		inline void set_epochs(int32_t e) { epochs=e; }
+		inline void set_epochs(int32_t e) { m_engine->set_epochs(e); }
 
 		/** get epochs
 		 *
 		 * @return the number of training epochs
 		 */
-		inline int32_t get_epochs() { return epochs; }
+		inline int32_t get_epochs() { return m_engine->get_epochs(); }
 
 		/** set lambda
 		 *
 		 * @param l value of regularization parameter lambda
 		 */
-		inline void set_lambda(float64_t l) { lambda=l; }
+		inline void set_lambda(float64_t l) { m_engine->set_lambda(l); }
 
 		/** get lambda
 		 *
 		 * @return the regularization parameter lambda
 		 */
-		inline float64_t get_lambda() { return lambda; }
+		inline float64_t get_lambda() { return m_engine->get_lambda(); }
 
 		/** set if bias shall be enabled
 		 *
 		 * @param enable_bias if bias shall be enabled
 		 */
-		inline void set_bias_enabled(bool enable_bias) { use_bias=enable_bias; }
+		inline void set_bias_enabled(bool enable_bias) { m_engine->set_bias_enabled(enable_bias); }
 
 		/** check if bias is enabled
 		 *
 		 * @return if bias is enabled
 		 */
-		inline bool get_bias_enabled() { return use_bias; }
+		inline bool get_bias_enabled() { return m_engine->get_bias_enabled(); }
 
 		/** set if regularized bias shall be enabled
 		 *
 		 * @param enable_bias if regularized bias shall be enabled
 		 */
-		inline void set_regularized_bias_enabled(bool enable_bias) { use_regularized_bias=enable_bias; }
+		inline void set_regularized_bias_enabled(bool enable_bias) { m_engine->set_regularized_bias_enabled(enable_bias); }
 
 		/** check if regularized bias is enabled
 		 *
 		 * @return if regularized bias is enabled
 		 */
-		inline bool get_regularized_bias_enabled() { return use_regularized_bias; }
+		inline bool get_regularized_bias_enabled() { return m_engine->get_regularized_bias_enabled(); }
 
 		/** Set the loss function to use
 		 *
 		 * @param loss_func object derived from CLossFunction
 		 */
-		void set_loss_function(CLossFunction* loss_func);
+		inline void set_loss_function(CLossFunction* loss_func) { m_engine->set_loss_function(loss_func); }
 
 		/** Return the loss function
 		 *
 		 * @return loss function as CLossFunction*
 		 */
-		inline CLossFunction* get_loss_function() { SG_REF(loss); return loss; }
+		inline CLossFunction* get_loss_function() { return m_engine->get_loss_function(); }
+
+		/** @return the engine used for training, to set the batch size */
+		inline CSGDEngine* get_engine() { SG_REF(m_engine); return m_engine; }
 
 		/** @return object name */
 		inline const char* get_name() const { return "OnlineSVMSGD"; }
 
-	protected:
-		/** calibrate
-		 *
-		 * @param max_vec_num Maximum number of vectors to calibrate using
-		 * (optional) if set to -1, tries to calibrate using all vectors
-		 * */
-		void calibrate(int32_t max_vec_num=1000);
-
 	private:
 		void init();
 
 	private:
-		float64_t t;
-		float64_t lambda;
 		float64_t C1;
 		float64_t C2;
-		float64_t wscale;
-		float64_t bscale;
-		int32_t epochs;
-		int32_t skip;
-		int32_t count;
-
-		bool use_bias;
-		bool use_regularized_bias;
 
-		CLossFunction* loss;
+		/** SGD solver */
+		CSGDEngine* m_engine;
 };
 }
 #endif
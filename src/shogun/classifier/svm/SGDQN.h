@@ -27,10 +27,15 @@
 #include <shogun/features/DotFeatures.h>
 #include <shogun/labels/Labels.h>
 #include <shogun/loss/LossFunction.h>
+#include <shogun/optimization/SGDEngine.h>
 
 namespace shogun
 {
-/** @brief class SGDQN */
+/** @brief class SGDQN, trains with the diagonal quasi-Newton rescaling of
+ * CSGDEngine
+ *
+ * The mini-batch size can be set up on the engine, see get_engine().
+ */
 class CSGDQN : public CLinearMachine
 {
 	public:
@@ -99,13 +104,13 @@ class CSGDQN : public CLinearMachine
 		 *
 		 * @param e new number of training epochs
 		 */
-		inline void set_epochs(int32_t e) { epochs=e; }
+		inline void set_epochs(int32_t e) { m_engine->set_epochs(e); }
 
 		/** get epochs
 		 *
 		 * @return the number of training epochs
 		 */
-		inline int32_t get_epochs() { return epochs; }
+		inline int32_t get_epochs() { return m_engine->get_epochs(); }
 
 		/**computing diagonal scaling matrix B as ratio*/
 		void compute_ratio(float64_t* W,float64_t* W_1,float64_t* B,float64_t* dst,int32_t dim,float64_t regularizer_lambda,float64_t loss);
@@ -117,33 +122,29 @@ class CSGDQN : public CLinearMachine
 		 *
 		 * @param loss_func object derived from CLossFunction
 		 */
-		void set_loss_function(CLossFunction* loss_func);
+		inline void set_loss_function(CLossFunction* loss_func) { m_engine->set_loss_function(loss_func); }
 
 		/** Return the loss function
 		 *
 		 * @return loss function as CLossFunction*
 		 */
-		inline CLossFunction* get_loss_function() { SG_REF(loss); return loss; }
+		inline CLossFunction* get_loss_function() { return m_engine->get_loss_function(); }
+
+		/** @return the engine used for training, to set the batch size */
+		inline CSGDEngine* get_engine() { SG_REF(m_engine); return m_engine; }
 
 		/** @return object name */
 		virtual const char* get_name() const { return "SGDQN"; }
 
-	protected:
-		/** calibrate */
-		void calibrate();
-
 	private:
 		void init();
 
 	private:
-		float64_t t;
 		float64_t C1;
 		float64_t C2;
-		int32_t epochs;
-		int32_t skip;
-		int32_t count;
 
-		CLossFunction* loss;
+		/** SGD solver */
+		CSGDEngine* m_engine;
 };
 }
 #endif
@@ -27,10 +27,15 @@
 #include <shogun/features/DotFeatures.h>
 #include <shogun/labels/Labels.h>
 #include <shogun/loss/LossFunction.h>
+#include <shogun/optimization/SGDEngine.h>
 
 namespace shogun
 {
-/** @brief class SVMSGD */
+/** @brief class SVMSGD, trains with CSGDEngine
+ *
+ * Mini-batches and the use of several threads can be set up on the engine,
+ * see get_engine().
+ */
 class CSVMSGD : public CLinearMachine
 {
 	public:
@@ -89,57 +94,58 @@ class CSVMSGD : public CLinearMachine
 		 *
 		 * @param e new number of training epochs
 		 */
-		inline void set_epochs(int32_t e) { epochs=e; }
+		inline void set_epochs(int32_t e) { m_engine->set_epochs(e); }
 
 		/** get epochs
 		 *
 		 * @return the number of training epochs
 		 */
-		inline int32_t get_epochs() { return epochs; }
+		inline int32_t get_epochs() { return m_engine->get_epochs(); }
 
 		/** set if bias shall be enabled
 		 *
 		 * @param enable_bias if bias shall be enabled
 		 */
-		inline void set_bias_enabled(bool enable_bias) { use_bias=enable_bias; }
+		inline void set_bias_enabled(bool enable_bias) { m_engine->set_bias_enabled(enable_bias); }
 
 		/** check if bias is enabled
 		 *
 		 * @return if bias is enabled
 		 */
-		inline bool get_bias_enabled() { return use_bias; }
+		inline bool get_bias_enabled() { return m_engine->get_bias_enabled(); }
 
 		/** set if regularized bias shall be enabled
 		 *
 		 * @param enable_bias if regularized bias shall be enabled
 		 */
-		inline void set_regularized_bias_enabled(bool enable_bias) { use_regularized_bias=enable_bias; }
+		inline void set_regularized_bias_enabled(bool enable_bias) { m_engine->set_regularized_bias_enabled(enable_bias); }
 
 		/** check if regularized bias is enabled
 		 *
 		 * @return if regularized bias is enabled
 		 */
-		inline bool get_regularized_bias_enabled() { return use_regularized_bias; }
+		inline bool get_regularized_bias_enabled() { return m_engine->get_regularized_bias_enabled(); }
 
 		/** Set the loss function to use
 		 *
 		 * @param loss_func object derived from CLossFunction
 		 */
-		void set_loss_function(CLossFunction* loss_func);
+		inline void set_loss_function(CLossFunction* loss_func) { m_engine->set_loss_function(loss_func); }
 
 		/** Return the loss function
 		 *
 		 * @return loss function as CLossFunction*
 		 */
-		inline CLossFunction* get_loss_function() { SG_REF(loss); return loss; }
+		inline CLossFunction* get_loss_function() { return m_engine->get_loss_function(); }
+
+		/** @return the engine used for training, to set batch size and
+		 * thread mode */
+		inline CSGDEngine* get_engine() { SG_REF(m_engine); return m_engine; }
 
 		/** @return object name */
 		virtual const char* get_name() const { return "SVMSGD"; }
 
 	protected:
-		/** calibrate */
-		void calibrate();
-
 		/** train classifier
 		 *
 		 * @param data training data (parameter can be avoided if distance or
@@ -154,19 +160,11 @@ class CSVMSGD : public CLinearMachine
 		void init();
 
 	private:
-		float64_t t;
 		float64_t C1;
 		float64_t C2;
-		float64_t wscale;
-		float64_t bscale;
-		int32_t epochs;
-		int32_t skip;
-		int32_t count;
-
-		bool use_bias;
-		bool use_regularized_bias;
 
-		CLossFunction* loss;
+		/** SGD solver */
+		CSGDEngine* m_engine;
 };
 }
 #endif
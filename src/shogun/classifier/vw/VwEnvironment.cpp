@@ -13,6 +13,7 @@
  */
 
 #include <shogun/classifier/vw/VwEnvironment.h>
+#include <shogun/mathematics/Math.h>
 
 using namespace shogun;
 
@@ -72,3 +73,12 @@ void CVwEnvironment::set_stride(vw_size_t new_stride)
 	vw_size_t len = ((vw_size_t) 1) << num_bits;
 	thread_mask = (stride * (len >> thread_bits)) - 1;
 }
+
+void CVwEnvironment::update_label_range(float64_t label)
+{
+	label_range_lock.lock();
+	min_label = CMath::min(min_label, label);
+	if (label != FLT_MAX)
+		max_label = CMath::max(max_label, label);
+	label_range_lock.unlock();
+}
@@ -20,6 +20,7 @@
 #include <shogun/lib/DataType.h>
 #include <shogun/lib/common.h>
 #include <shogun/lib/v_array.h>
+#include <shogun/lib/Lock.h>
 #include <shogun/classifier/vw/vw_constants.h>
 
 namespace shogun
@@ -106,6 +107,14 @@ public:
 	 */
 	void set_stride(vw_size_t new_stride);
 
+	/**
+	 * Update min and max labels seen.
+	 * May be called concurrently by several parse threads.
+	 *
+	 * @param label label based on which to update
+	 */
+	void update_label_range(float64_t label);
+
 	/**
 	 * Return the name of the object
 	 *
@@ -197,6 +206,10 @@ public:
 	const char* vw_version;
 	/// Length of version string
 	vw_size_t v_length;
+
+private:
+	/// Lock protecting min_label and max_label
+	CLock label_range_lock;
 };
 
 }
@@ -138,9 +138,7 @@ public:
 	 */
 	void set_mm(float64_t label)
 	{
-		env->min_label = CMath::min(env->min_label, label);
-		if (label != FLT_MAX)
-			env->max_label = CMath::max(env->max_label, label);
+		env->update_label_range(label);
 	}
 
 	/**
@@ -15,6 +15,7 @@
 #include <shogun/clustering/KMeans.h>
 #include <shogun/distance/EuclideanDistance.h>
 #include <shogun/base/Parameter.h>
+#include <shogun/base/Parallel.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/lapack.h>
 #include <shogun/labels/MulticlassLabels.h>
@@ -25,6 +26,252 @@
 using namespace shogun;
 using namespace std;
 
+/** number of points whitened by one matrix product */
+#define GMM_BLOCK_SIZE 128
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+struct GMM_COMPONENT
+{
+	/** covariance type */
+	ECovType cov_type;
+	/** mean */
+	float64_t* mean;
+	/** whitening transform: rows of u scaled by 1/sqrt(d) (FULL), inverse
+	 * variances (DIAG) or inverse variance (SPHERICAL) */
+	float64_t* whiten;
+	/** whitened mean (FULL) */
+	float64_t* whitened_mean;
+	/** log of mixing coefficient minus half of the normalization constant */
+	float64_t offset;
+};
+
+struct GMM_ESTEP_THREAD_PARAM
+{
+	/** data */
+	CDotFeatures* dotdata;
+	/** dimension */
+	int32_t dim;
+	/** number of components */
+	int32_t num_comp;
+	/** components */
+	const GMM_COMPONENT* components;
+	/** log joint probabilities (output) */
+	float64_t* logPxy;
+	/** log probabilities of the points (output) */
+	float64_t* logPx;
+	/** log likelihood, per thread */
+	float64_t* log_likelihood;
+};
+
+struct GMM_MSTEP_THREAD_PARAM
+{
+	/** data */
+	CDotFeatures* dotdata;
+	/** dimension */
+	int32_t dim;
+	/** number of components */
+	int32_t num_comp;
+	/** point assignment, row-major */
+	const float64_t* alpha;
+	/** accumulate covariances around means instead of means */
+	bool second_moments;
+	/** means, row-major (second moments only) */
+	const float64_t* means;
+	/** covariance types */
+	const ECovType* cov_types;
+	/** offset of the covariance sum of each component */
+	const int64_t* cov_offsets;
+	/** size of the statistics of one thread */
+	int64_t stats_size;
+	/** per thread: sums of alpha, weighted sums of points, covariance sums */
+	float64_t* stats;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/* copy a block of points into the rows of X */
+static void get_block(CDotFeatures* dotdata, int32_t start, int32_t num,
+		int32_t dim, float64_t* X)
+{
+	for (int32_t i=0; i<num; i++)
+	{
+		SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(start+i);
+		memcpy(&X[int64_t(i)*dim], v.vector, sizeof(float64_t)*dim);
+	}
+}
+
+static void estep_helper(int32_t start, int32_t end, int32_t thread, void* p)
+{
+	GMM_ESTEP_THREAD_PARAM* params=(GMM_ESTEP_THREAD_PARAM*) p;
+	int32_t dim=params->dim;
+	int32_t num_comp=params->num_comp;
+	float64_t* X=SG_MALLOC(float64_t, int64_t(GMM_BLOCK_SIZE)*dim);
+	float64_t* Y=SG_MALLOC(float64_t, int64_t(GMM_BLOCK_SIZE)*dim);
+	float64_t log_likelihood=0;
+
+	for (int32_t b=start; b<end; b+=GMM_BLOCK_SIZE)
+	{
+		int32_t num=CMath::min(GMM_BLOCK_SIZE, end-b);
+		get_block(params->dotdata, b, num, dim, X);
+		float64_t* logPxy=&params->logPxy[int64_t(b)*num_comp];
+
+		for (int32_t j=0; j<num_comp; j++)
+		{
+			const GMM_COMPONENT* comp=&params->components[j];
+
+			switch (comp->cov_type)
+			{
+				case FULL:
+					/* Y=X*W', the whitened mean is subtracted below */
+					cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasTrans, num,
+							dim, dim, 1.0, X, dim, comp->whiten, dim, 0.0, Y,
+							dim);
+
+					for (int32_t i=0; i<num; i++)
+					{
+						float64_t* y=&Y[int64_t(i)*dim];
+						float64_t dist=0;
+						for (int32_t k=0; k<dim; k++)
+							dist+=CMath::sq(y[k]-comp->whitened_mean[k]);
+
+						logPxy[i*num_comp+j]=comp->offset-0.5*dist;
+					}
+					break;
+				case DIAG:
+					for (int32_t i=0; i<num; i++)
+					{
+						float64_t* x=&X[int64_t(i)*dim];
+						float64_t dist=0;
+						for (int32_t k=0; k<dim; k++)
+							dist+=CMath::sq(x[k]-comp->mean[k])*comp->whiten[k];
+
+						logPxy[i*num_comp+j]=comp->offset-0.5*dist;
+					}
+					break;
+				case SPHERICAL:
+					for (int32_t i=0; i<num; i++)
+					{
+						float64_t* x=&X[int64_t(i)*dim];
+						float64_t dist=0;
+						for (int32_t k=0; k<dim; k++)
+							dist+=CMath::sq(x[k]-comp->mean[k]);
+
+						logPxy[i*num_comp+j]=comp->offset-0.5*dist*comp->whiten[0];
+					}
+					break;
+			}
+		}
+
+		/* log-sum-exp over the components, shifted by the largest term */
+		for (int32_t i=0; i<num; i++)
+		{
+			float64_t* row=&logPxy[i*num_comp];
+			float64_t max_log=row[0];
+			for (int32_t j=1; j<num_comp; j++)
+				max_log=CMath::max(max_log, row[j]);
+
+			float64_t logPx=max_log;
+			if (max_log>-CMath::INFTY)
+			{
+				float64_t sum=0;
+				for (int32_t j=0; j<num_comp; j++)
+					sum+=CMath::exp(row[j]-max_log);
+				logPx+=CMath::log(sum);
+			}
+
+			params->logPx[b+i]=logPx;
+			log_likelihood+=logPx;
+		}
+	}
+
+	params->log_likelihood[thread]+=log_likelihood;
+
+	SG_FREE(X);
+	SG_FREE(Y);
+}
+
+static void mstep_helper(int32_t start, int32_t end, int32_t thread, void* p)
+{
+	GMM_MSTEP_THREAD_PARAM* params=(GMM_MSTEP_THREAD_PARAM*) p;
+	int32_t dim=params->dim;
+	int32_t num_comp=params->num_comp;
+	float64_t* alpha_sums=&params->stats[thread*params->stats_size];
+	float64_t* mean_sums=&alpha_sums[num_comp];
+	float64_t* X=SG_MALLOC(float64_t, int64_t(GMM_BLOCK_SIZE)*dim);
+	float64_t* Z=NULL;
+	if (params->second_moments)
+		Z=SG_MALLOC(float64_t, int64_t(GMM_BLOCK_SIZE)*dim);
+
+	for (int32_t b=start; b<end; b+=GMM_BLOCK_SIZE)
+	{
+		int32_t num=CMath::min(GMM_BLOCK_SIZE, end-b);
+		get_block(params->dotdata, b, num, dim, X);
+		const float64_t* alpha=&params->alpha[int64_t(b)*num_comp];
+
+		if (!params->second_moments)
+		{
+			for (int32_t i=0; i<num; i++)
+			{
+				for (int32_t j=0; j<num_comp; j++)
+					alpha_sums[j]+=alpha[i*num_comp+j];
+			}
+
+			/* mean_sums+=alpha'*X */
+			cblas_dgemm(CblasRowMajor, CblasTrans, CblasNoTrans, num_comp,
+					dim, num, 1.0, alpha, num_comp, X, dim, 1.0, mean_sums,
+					dim);
+			continue;
+		}
+
+		for (int32_t j=0; j<num_comp; j++)
+		{
+			const float64_t* mean=&params->means[int64_t(j)*dim];
+			float64_t* cov_sum=&alpha_sums[params->cov_offsets[j]];
+
+			switch (params->cov_types[j])
+			{
+				case FULL:
+					/* rows of Z are the centered points scaled by
+					 * sqrt(alpha), the upper triangle of Z'*Z is added */
+					for (int32_t i=0; i<num; i++)
+					{
+						float64_t scale=CMath::sqrt(alpha[i*num_comp+j]);
+						float64_t* x=&X[int64_t(i)*dim];
+						float64_t* z=&Z[int64_t(i)*dim];
+						for (int32_t k=0; k<dim; k++)
+							z[k]=(x[k]-mean[k])*scale;
+					}
+
+					cblas_dsyrk(CblasRowMajor, CblasUpper, CblasTrans, dim, num,
+							1.0, Z, dim, 1.0, cov_sum, dim);
+					break;
+				case DIAG:
+					for (int32_t i=0; i<num; i++)
+					{
+						float64_t a=alpha[i*num_comp+j];
+						float64_t* x=&X[int64_t(i)*dim];
+						for (int32_t k=0; k<dim; k++)
+							cov_sum[k]+=CMath::sq(x[k]-mean[k])*a;
+					}
+					break;
+				case SPHERICAL:
+					for (int32_t i=0; i<num; i++)
+					{
+						float64_t* x=&X[int64_t(i)*dim];
+						float64_t temp=0;
+						for (int32_t k=0; k<dim; k++)
+							temp+=CMath::sq(x[k]-mean[k]);
+
+						cov_sum[0]+=temp*alpha[i*num_comp+j];
+					}
+					break;
+			}
+		}
+	}
+
+	SG_FREE(X);
+	SG_FREE(Z);
+}
+
 CGMM::CGMM() : CDistribution(), m_components(),	m_coefficients()
 {
 	register_params();
@@ -156,31 +403,16 @@ float64_t CGMM::train_em(float64_t min_cov, int32_t max_iter, float64_t min_chan
 	float64_t log_likelihood_cur=0;
 	float64_t* logPxy=SG_MALLOC(float64_t, num_vectors*m_components.size());
 	float64_t* logPx=SG_MALLOC(float64_t, num_vectors);
-	//float64_t* logPost=SG_MALLOC(float64_t, num_vectors*m_components.vlen);
 
 	while (iter<max_iter)
 	{
 		log_likelihood_prev=log_likelihood_cur;
-		log_likelihood_cur=0;
+		log_likelihood_cur=estep(m_components, m_coefficients, logPxy, logPx);
 
 		for (int32_t i=0; i<num_vectors; i++)
 		{
-			logPx[i]=0;
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
-			for (int32_t j=0; j<int32_t(m_components.size()); j++)
-			{
-				logPxy[i*m_components.size()+j]=m_components[j]->compute_log_PDF(v)+CMath::log(m_coefficients[j]);
-				logPx[i]+=CMath::exp(logPxy[i*m_components.size()+j]);
-			}
-
-			logPx[i]=CMath::log(logPx[i]);
-			log_likelihood_cur+=logPx[i];
-
 			for (int32_t j=0; j<int32_t(m_components.size()); j++)
-			{
-				//logPost[i*m_components.vlen+j]=logPxy[i*m_components.vlen+j]-logPx[i];
 				alpha.matrix[i*m_components.size()+j]=CMath::exp(logPxy[i*m_components.size()+j]-logPx[i]);
-			}
 		}
 
 		if (iter>0 && log_likelihood_cur-log_likelihood_prev<min_change)
@@ -227,18 +459,9 @@ float64_t CGMM::train_smem(int32_t max_iter, int32_t max_cand, float64_t min_cov
 		memset(logPostSum, 0, m_components.size()*sizeof(float64_t));
 		memset(logPostSum2, 0, m_components.size()*sizeof(float64_t));
 		memset(logPostSumSum, 0, (m_components.size()*(m_components.size()-1)/2)*sizeof(float64_t));
+		estep(m_components, m_coefficients, logPxy, logPx);
 		for (int32_t i=0; i<num_vectors; i++)
 		{
-			logPx[i]=0;
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
-			for (int32_t j=0; j<int32_t(m_components.size()); j++)
-			{
-				logPxy[i*m_components.size()+j]=m_components[j]->compute_log_PDF(v)+CMath::log(m_coefficients[j]);
-				logPx[i]+=CMath::exp(logPxy[i*m_components.size()+j]);
-			}
-
-			logPx[i]=CMath::log(logPx[i]);
-
 			for (int32_t j=0; j<int32_t(m_components.size()); j++)
 			{
 				logPost[i*m_components.size()+j]=logPxy[i*m_components.size()+j]-logPx[i];
@@ -345,23 +568,18 @@ void CGMM::partial_em(int32_t comp1, int32_t comp2, int32_t comp3, float64_t min
 	float64_t* init_logPx_fix=SG_MALLOC(float64_t, num_vectors);
 	float64_t* post_add=SG_MALLOC(float64_t, num_vectors);
 
+	estep(m_components, m_coefficients, init_logPxy, init_logPx);
 	for (int32_t i=0; i<num_vectors; i++)
 	{
-		init_logPx[i]=0;
 		init_logPx_fix[i]=0;
-
-		SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
 		for (int32_t j=0; j<int32_t(m_components.size()); j++)
 		{
-			init_logPxy[i*m_components.size()+j]=m_components[j]->compute_log_PDF(v)+CMath::log(m_coefficients[j]);
-			init_logPx[i]+=CMath::exp(init_logPxy[i*m_components.size()+j]);
 			if (j!=comp1 && j!=comp2 && j!=comp3)
 			{
 				init_logPx_fix[i]+=CMath::exp(init_logPxy[i*m_components.size()+j]);
 			}
 		}
 
-		init_logPx[i]=CMath::log(init_logPx[i]);
 		post_add[i]=CMath::log(CMath::exp(init_logPxy[i*m_components.size()+comp1]-init_logPx[i])+
 					CMath::exp(init_logPxy[i*m_components.size()+comp2]-init_logPx[i])+
 					CMath::exp(init_logPxy[i*m_components.size()+comp3]-init_logPx[i]));
@@ -466,31 +684,20 @@ void CGMM::partial_em(int32_t comp1, int32_t comp2, int32_t comp3, float64_t min
 	SGMatrix<float64_t> alpha(num_vectors, 3);
 	float64_t* logPxy=SG_MALLOC(float64_t, num_vectors*3);
 	float64_t* logPx=SG_MALLOC(float64_t, num_vectors);
-	//float64_t* logPost=SG_MALLOC(float64_t, num_vectors*m_components.vlen);
 
 	while (iter<max_em_iter)
 	{
 		log_likelihood_prev=log_likelihood_cur;
 		log_likelihood_cur=0;
 
+		estep(components, coefficients, logPxy, logPx);
 		for (int32_t i=0; i<num_vectors; i++)
 		{
-			logPx[i]=0;
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
-			for (int32_t j=0; j<3; j++)
-			{
-				logPxy[i*3+j]=components[j]->compute_log_PDF(v)+CMath::log(coefficients[j]);
-				logPx[i]+=CMath::exp(logPxy[i*3+j]);
-			}
-
-			logPx[i]=CMath::log(logPx[i]+init_logPx_fix[i]);
+			logPx[i]=CMath::log(CMath::exp(logPx[i])+init_logPx_fix[i]);
 			log_likelihood_cur+=logPx[i];
 
 			for (int32_t j=0; j<3; j++)
-			{
-				//logPost[i*m_components.vlen+j]=logPxy[i*m_components.vlen+j]-logPx[i];
 				alpha.matrix[i*3+j]=CMath::exp(logPxy[i*3+j]-logPx[i]+post_add[i]);
-			}
 		}
 
 		if (iter>0 && log_likelihood_cur-log_likelihood_prev<min_change)
@@ -516,83 +723,194 @@ void CGMM::partial_em(int32_t comp1, int32_t comp2, int32_t comp3, float64_t min
 	SG_FREE(post_add);
 }
 
-void CGMM::max_likelihood(SGMatrix<float64_t> alpha, float64_t min_cov)
+float64_t CGMM::estep(const vector<CGaussian*>& components,
+		SGVector<float64_t> coefficients, float64_t* logPxy, float64_t* logPx)
 {
 	CDotFeatures* dotdata=(CDotFeatures *) features;
+	int32_t num_vectors=dotdata->get_num_vectors();
 	int32_t num_dim=dotdata->get_dim_feature_space();
+	int32_t num_comp=int32_t(components.size());
+	int32_t num_threads=parallel->get_num_threads();
 
-	float64_t alpha_sum;
-	float64_t alpha_sum_sum=0;
-	float64_t* mean_sum;
-	float64_t* cov_sum=NULL;
-
-	for (int32_t i=0; i<alpha.num_cols; i++)
+	GMM_COMPONENT* comps=SG_MALLOC(GMM_COMPONENT, num_comp);
+	for (int32_t j=0; j<num_comp; j++)
 	{
-		alpha_sum=0;
-		mean_sum=SG_MALLOC(float64_t, num_dim);
-		memset(mean_sum, 0, num_dim*sizeof(float64_t));
-
-		for (int32_t j=0; j<alpha.num_rows; j++)
+		SGVector<float64_t> mean=components[j]->get_mean();
+		SGVector<float64_t> d=components[j]->get_d();
+		REQUIRE(mean.vlen==num_dim, "Dimension of component %d (%d) does not "
+				"match dimension of features (%d)!\n", j, mean.vlen, num_dim)
+
+		/* same constant as CGaussian::init() */
+		float64_t constant=CMath::log(2*M_PI)*num_dim;
+		comps[j].cov_type=components[j]->get_cov_type();
+		comps[j].mean=mean.vector;
+		comps[j].whitened_mean=NULL;
+
+		switch (comps[j].cov_type)
 		{
-			alpha_sum+=alpha.matrix[j*alpha.num_cols+i];
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(j);
-			SGVector<float64_t>::add(mean_sum, alpha.matrix[j*alpha.num_cols+i], v.vector, 1, mean_sum, v.vlen);
+			case FULL:
+			{
+				SGMatrix<float64_t> u=components[j]->get_u();
+				comps[j].whiten=SG_MALLOC(float64_t, num_dim*num_dim);
+				comps[j].whitened_mean=SG_MALLOC(float64_t, num_dim);
+				for (int32_t i=0; i<num_dim; i++)
+				{
+					float64_t scale=1.0/CMath::sqrt(d[i]);
+					float64_t* w=&comps[j].whiten[i*num_dim];
+					comps[j].whitened_mean[i]=0;
+					for (int32_t k=0; k<num_dim; k++)
+					{
+						w[k]=u.matrix[i*num_dim+k]*scale;
+						comps[j].whitened_mean[i]+=w[k]*mean[k];
+					}
+
+					constant+=CMath::log(d[i]);
+				}
+				break;
+			}
+			case DIAG:
+				comps[j].whiten=SG_MALLOC(float64_t, num_dim);
+				for (int32_t i=0; i<num_dim; i++)
+				{
+					comps[j].whiten[i]=1.0/d[i];
+					constant+=CMath::log(d[i]);
+				}
+				break;
+			case SPHERICAL:
+				comps[j].whiten=SG_MALLOC(float64_t, 1);
+				comps[j].whiten[0]=1.0/d[0];
+				constant+=num_dim*CMath::log(d[0]);
+				break;
 		}
 
-		for (int32_t j=0; j<num_dim; j++)
-			mean_sum[j]/=alpha_sum;
+		comps[j].offset=CMath::log(coefficients[j])-0.5*constant;
+	}
 
-		m_components[i]->set_mean(SGVector<float64_t>(mean_sum, num_dim));
+	GMM_ESTEP_THREAD_PARAM params;
+	params.dotdata=dotdata;
+	params.dim=num_dim;
+	params.num_comp=num_comp;
+	params.components=comps;
+	params.logPxy=logPxy;
+	params.logPx=logPx;
+	params.log_likelihood=SG_CALLOC(float64_t, num_threads);
+	parallel->parallel_for(0, num_vectors, estep_helper, &params,
+			GMM_BLOCK_SIZE);
+
+	float64_t log_likelihood=0;
+	for (int32_t t=0; t<num_threads; t++)
+		log_likelihood+=params.log_likelihood[t];
+
+	for (int32_t j=0; j<num_comp; j++)
+	{
+		SG_FREE(comps[j].whiten);
+		SG_FREE(comps[j].whitened_mean);
+	}
+	SG_FREE(comps);
+	SG_FREE(params.log_likelihood);
 
-		ECovType cov_type=m_components[i]->get_cov_type();
+	return log_likelihood;
+}
 
-		if (cov_type==FULL)
-		{
-			cov_sum=SG_MALLOC(float64_t, num_dim*num_dim);
-			memset(cov_sum, 0, num_dim*num_dim*sizeof(float64_t));
-		}
-		else if(cov_type==DIAG)
-		{
-			cov_sum=SG_MALLOC(float64_t, num_dim);
-			memset(cov_sum, 0, num_dim*sizeof(float64_t));
-		}
-		else if(cov_type==SPHERICAL)
-		{
-			cov_sum=SG_MALLOC(float64_t, 1);
-			cov_sum[0]=0;
-		}
+void CGMM::max_likelihood(SGMatrix<float64_t> alpha, float64_t min_cov)
+{
+	CDotFeatures* dotdata=(CDotFeatures *) features;
+	int32_t num_dim=dotdata->get_dim_feature_space();
+	int32_t num_comp=alpha.num_cols;
+	int32_t num_threads=parallel->get_num_threads();
+
+	/* per thread statistics: sums of alpha, weighted sums of points and
+	 * covariance sums of all components */
+	SGVector<int64_t> cov_offsets(num_comp);
+	ECovType* cov_types=SG_MALLOC(ECovType, num_comp);
+	int64_t stats_size=num_comp+int64_t(num_comp)*num_dim;
+	for (int32_t i=0; i<num_comp; i++)
+	{
+		cov_types[i]=m_components[i]->get_cov_type();
+		cov_offsets[i]=stats_size;
 
-		for (int32_t j=0; j<alpha.num_rows; j++)
+		switch (cov_types[i])
 		{
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(j);
-			SGVector<float64_t>::add(v.vector, 1, v.vector, -1, mean_sum, v.vlen);
+			case FULL:
+				stats_size+=int64_t(num_dim)*num_dim;
+				break;
+			case DIAG:
+				stats_size+=num_dim;
+				break;
+			case SPHERICAL:
+				stats_size+=1;
+				break;
+		}
+	}
 
-			switch (cov_type)
-			{
-				case FULL:
-					cblas_dger(CblasRowMajor, num_dim, num_dim, alpha.matrix[j*alpha.num_cols+i], v.vector, 1, v.vector,
-								 1, (double*) cov_sum, num_dim);
+	GMM_MSTEP_THREAD_PARAM params;
+	params.dotdata=dotdata;
+	params.dim=num_dim;
+	params.num_comp=num_comp;
+	params.alpha=alpha.matrix;
+	params.second_moments=false;
+	params.means=NULL;
+	params.cov_types=cov_types;
+	params.cov_offsets=cov_offsets.vector;
+	params.stats_size=stats_size;
+	params.stats=SG_CALLOC(float64_t, stats_size*num_threads);
+	parallel->parallel_for(0, alpha.num_rows, mstep_helper, &params,
+			GMM_BLOCK_SIZE);
+
+	SGVector<float64_t> alpha_sums(num_comp);
+	SGMatrix<float64_t> means(num_dim, num_comp);
+	alpha_sums.zero();
+	means.zero();
+	for (int32_t t=0; t<num_threads; t++)
+	{
+		float64_t* stats=&params.stats[t*stats_size];
+		SGVector<float64_t>::add(alpha_sums.vector, 1, alpha_sums.vector, 1,
+				stats, num_comp);
+		SGVector<float64_t>::add(means.matrix, 1, means.matrix, 1,
+				&stats[num_comp], num_comp*num_dim);
+	}
 
-					break;
-				case DIAG:
-					for (int32_t k=0; k<num_dim; k++)
-						cov_sum[k]+=v.vector[k]*v.vector[k]*alpha.matrix[j*alpha.num_cols+i];
+	for (int32_t i=0; i<num_comp; i++)
+	{
+		SGVector<float64_t> mean_sum(num_dim);
+		for (int32_t j=0; j<num_dim; j++)
+		{
+			means(j,i)/=alpha_sums[i];
+			mean_sum[j]=means(j,i);
+		}
 
-					break;
-				case SPHERICAL:
-					float64_t temp=0;
+		m_components[i]->set_mean(mean_sum);
+	}
 
-					for (int32_t k=0; k<num_dim; k++)
-						temp+=v.vector[k]*v.vector[k];
+	params.second_moments=true;
+	params.means=means.matrix;
+	memset(params.stats, 0, sizeof(float64_t)*stats_size*num_threads);
+	parallel->parallel_for(0, alpha.num_rows, mstep_helper, &params,
+			GMM_BLOCK_SIZE);
 
-					cov_sum[0]+=temp*alpha.matrix[j*alpha.num_cols+i];
-					break;
-			}
+	float64_t alpha_sum_sum=0;
+	for (int32_t i=0; i<num_comp; i++)
+	{
+		float64_t alpha_sum=alpha_sums[i];
+		int64_t cov_size=(i+1<num_comp ? cov_offsets[i+1] : stats_size)-
+			cov_offsets[i];
+		float64_t* cov_sum=SG_CALLOC(float64_t, cov_size);
+		for (int32_t t=0; t<num_threads; t++)
+		{
+			SGVector<float64_t>::add(cov_sum, 1, cov_sum, 1,
+					&params.stats[t*stats_size+cov_offsets[i]], cov_size);
 		}
 
-		switch (cov_type)
+		switch (cov_types[i])
 		{
 			case FULL:
+				/* only the upper triangle was accumulated */
+				for (int32_t j=0; j<num_dim; j++)
+				{
+					for (int32_t k=0; k<j; k++)
+						cov_sum[j*num_dim+k]=cov_sum[k*num_dim+j];
+				}
+
 				for (int32_t j=0; j<num_dim*num_dim; j++)
 					cov_sum[j]/=alpha_sum;
 
@@ -628,7 +946,10 @@ void CGMM::max_likelihood(SGMatrix<float64_t> alpha, float64_t min_cov)
 		alpha_sum_sum+=alpha_sum;
 	}
 
-	for (int32_t i=0; i<alpha.num_cols; i++)
+	SG_FREE(params.stats);
+	SG_FREE(cov_types);
+
+	for (int32_t i=0; i<num_comp; i++)
 		m_coefficients.vector[i]/=alpha_sum_sum;
 }
 
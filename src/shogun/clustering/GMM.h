@@ -95,6 +95,9 @@ class CGMM : public CDistribution
 				float64_t min_change=1e-9);
 
 		/** maximum likelihood estimation
+		 *
+		 * The weighted sums of the points and of their outer products are
+		 * accumulated in parallel, per thread and per block of points.
 		 *
 		 * @param alpha point assignment
 		 * @param min_cov minimum covariance
@@ -232,6 +235,23 @@ class CGMM : public CDistribution
 		/** Initialize parameters for serialization */
 		void register_params();
 
+		/** batched expectation step, evaluates all points against all
+		 * components in parallel, blocks of points are whitened with one
+		 * matrix product per full covariance component
+		 *
+		 * @param components mixture components
+		 * @param coefficients mixing coefficients
+		 * @param logPxy log of the joint probability of each point and
+		 * component (output, num_vectors x number of components, row-major)
+		 * @param logPx log of the probability of each point (output,
+		 * num_vectors)
+		 *
+		 * @return log likelihood of training data
+		 */
+		float64_t estep(const vector<CGaussian*>& components,
+				SGVector<float64_t> coefficients, float64_t* logPxy,
+				float64_t* logPx);
+
 		/** apply the partial EM algorithm on 3 components
 		 *
 		 * @param comp1 index of first component
@@ -21,25 +21,85 @@
 
 using namespace shogun;
 
+/** number of entries of the buffer holding a block of rows of the distance
+ * matrix */
+#define HIERARCHICAL_BLOCK_ELEMENTS 4194304
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
-struct pair
+struct HIERARCHICAL_PRIM_THREAD_PARAM
 {
-	/** index 1 */
-	int32_t idx1;
-	/** index 2 */
-	int32_t idx2;
+	/** distance */
+	CDistance* distance;
+	/** vector added to the tree last */
+	int32_t added;
+	/** vectors not in the tree yet */
+	const int32_t* remaining;
+	/** distance of each vector to the tree */
+	float64_t* best_dist;
+	/** closest vector in the tree of each vector */
+	int32_t* best_from;
+	/** position in remaining of the closest vector, per thread */
+	int32_t* thread_min;
 };
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
+/* whether vector i is closer to the tree than vector j, ties by index */
+static inline bool prim_closer(const float64_t* best_dist, int32_t i, int32_t j)
+{
+	return best_dist[i]<best_dist[j] || (best_dist[i]==best_dist[j] && i<j);
+}
+
+static void prim_update_helper(int32_t start, int32_t end, int32_t thread,
+		void* p)
+{
+	HIERARCHICAL_PRIM_THREAD_PARAM* params=(HIERARCHICAL_PRIM_THREAD_PARAM*) p;
+	const int32_t* remaining=params->remaining;
+	float64_t* best_dist=params->best_dist;
+	int32_t added=params->added;
+	int32_t min_pos=params->thread_min[thread];
+
+	for (int32_t i=start; i<end; i++)
+	{
+		int32_t j=remaining[i];
+		float64_t d=params->distance->distance(added, j);
+		if (d<best_dist[j])
+		{
+			best_dist[j]=d;
+			params->best_from[j]=added;
+		}
+
+		if (min_pos<0 || prim_closer(best_dist, j, remaining[min_pos]))
+			min_pos=i;
+	}
+
+	params->thread_min[thread]=min_pos;
+}
+
+/* position of the pair i<j in the condensed upper triangle */
+static inline int64_t condensed_index(int32_t num, int32_t i, int32_t j)
+{
+	return int64_t(i)*(2*int64_t(num)-i-1)/2+j-i-1;
+}
+
+static inline int32_t find_root(int32_t* parent, int32_t i)
+{
+	while (parent[i]!=i)
+	{
+		parent[i]=parent[parent[i]];
+		i=parent[i];
+	}
+	return i;
+}
+
 CHierarchical::CHierarchical()
-: CDistanceMachine(), merges(3), dimensions(0), assignment(NULL),
-	table_size(0), pairs(NULL), merge_distance(NULL)
+: CDistanceMachine(), merges(3), linkage(LINKAGE_SINGLE), dimensions(0),
+	assignment(NULL), table_size(0), pairs(NULL), merge_distance(NULL)
 {
 }
 
 CHierarchical::CHierarchical(int32_t merges_, CDistance* d)
-: CDistanceMachine(), merges(merges_), dimensions(0), assignment(NULL),
-	table_size(0), pairs(NULL), merge_distance(NULL)
+: CDistanceMachine(), merges(merges_), linkage(LINKAGE_SINGLE), dimensions(0),
+	assignment(NULL), table_size(0), pairs(NULL), merge_distance(NULL)
 {
 	set_distance(d);
 }
@@ -69,8 +129,6 @@ bool CHierarchical::train_machine(CFeatures* data)
 	int32_t num=lhs->get_num_vectors();
 	ASSERT(num>0)
 
-	const int32_t num_pairs=num*(num-1)/2;
-
 	SG_FREE(merge_distance);
 	merge_distance=SG_MALLOC(float64_t, num);
 	SGVector<float64_t>::fill_vector(merge_distance, num, -1.0);
@@ -83,76 +141,241 @@ bool CHierarchical::train_machine(CFeatures* data)
 	pairs=SG_MALLOC(int32_t, 2*num);
 	SGVector<int32_t>::fill_vector(pairs, 2*num, -1);
 
-	pair* index=SG_MALLOC(pair, num_pairs);
-	float64_t* distances=SG_MALLOC(float64_t, num_pairs);
+	/* the num-1 merges, identified by a vector of each of the clusters */
+	int32_t* merge_a=SG_MALLOC(int32_t, num);
+	int32_t* merge_b=SG_MALLOC(int32_t, num);
+	float64_t* merge_dist=SG_MALLOC(float64_t, num);
+
+	if (linkage==LINKAGE_SINGLE)
+		single_linkage(num, merge_a, merge_b, merge_dist);
+	else
+		nn_chain_linkage(num, merge_a, merge_b, merge_dist);
+
+	int32_t* order=SG_MALLOC(int32_t, num);
+	SGVector<int32_t>::range_fill_vector(order, num-1);
+	CMath::qsort_index(merge_dist, order, num-1);
+
+	/* replay the merges by increasing distance, cluster c of root i is
+	 * cluster[i] */
+	int32_t* parent=SG_MALLOC(int32_t, num);
+	int32_t* cluster=SG_MALLOC(int32_t, num);
+	SGVector<int32_t>::range_fill_vector(parent, num);
+	SGVector<int32_t>::range_fill_vector(cluster, num);
+
+	int32_t num_merges=CMath::min(num-merges+1, num-1);
+	for (int32_t l=0; l<num_merges; l++)
+	{
+		int32_t i=find_root(parent, merge_a[order[l]]);
+		int32_t j=find_root(parent, merge_b[order[l]]);
+		int32_t c1=cluster[i];
+		int32_t c2=cluster[j];
+
+		pairs[2*l]=CMath::min(c1, c2);
+		pairs[2*l+1]=CMath::max(c1, c2);
+		merge_distance[l]=merge_dist[l];
+
+		parent[i]=j;
+		cluster[j]=num+l;
+#ifdef DEBUG_HIERARCHICAL
+		SG_PRINT("l=%04i c1=%+04d c2=%+04d c=%+04d dist=%6.6f\n", l, c1, c2,
+				num+l, merge_distance[l])
+#endif
+	}
+
+	for (int32_t m=0; m<num; m++)
+		assignment[m]=cluster[find_root(parent, m)];
 
-	int32_t offs=0;
-	for (int32_t i=0; i<num; i++)
+	assignment_size=num;
+	table_size=CMath::min(num-merges, num-1);
+	ASSERT(table_size>0)
+	SG_FREE(cluster);
+	SG_FREE(parent);
+	SG_FREE(order);
+	SG_FREE(merge_dist);
+	SG_FREE(merge_b);
+	SG_FREE(merge_a);
+	SG_UNREF(lhs)
+
+	return true;
+}
+
+void CHierarchical::single_linkage(int32_t num, int32_t* merge_a,
+		int32_t* merge_b, float64_t* merge_dist)
+{
+	int32_t num_threads=parallel->get_num_threads();
+	int32_t* remaining=SG_MALLOC(int32_t, num);
+	float64_t* best_dist=SG_MALLOC(float64_t, num);
+	int32_t* best_from=SG_MALLOC(int32_t, num);
+	int32_t* thread_min=SG_MALLOC(int32_t, num_threads);
+
+	SGVector<int32_t>::range_fill_vector(remaining, num-1, 1);
+	SGVector<float64_t>::fill_vector(best_dist, num, CMath::INFTY);
+
+	HIERARCHICAL_PRIM_THREAD_PARAM params;
+	params.distance=distance;
+	params.added=0;
+	params.remaining=remaining;
+	params.best_dist=best_dist;
+	params.best_from=best_from;
+	params.thread_min=thread_min;
+
+	/* grow the tree from vector 0, adding the closest vector each time */
+	for (int32_t l=0; l<num-1; l++)
 	{
-		for (int32_t j=i+1; j<num; j++)
+		SG_PROGRESS(l, 0, num-1)
+
+		int32_t num_remaining=num-1-l;
+		SGVector<int32_t>::fill_vector(thread_min, num_threads, -1);
+		parallel->parallel_for(0, num_remaining, prim_update_helper, &params);
+
+		int32_t pos=-1;
+		for (int32_t t=0; t<num_threads; t++)
 		{
-			distances[offs]=distance->distance(i,j);
-			index[offs].idx1=i;
-			index[offs].idx2=j;
-			offs++;					//offs=i*(i+1)/2+j
+			if (thread_min[t]>=0 && (pos<0 ||
+					prim_closer(best_dist, remaining[thread_min[t]], remaining[pos])))
+				pos=thread_min[t];
 		}
-		SG_PROGRESS(i, 0, num-1)
+
+		int32_t j=remaining[pos];
+		merge_a[l]=best_from[j];
+		merge_b[l]=j;
+		merge_dist[l]=best_dist[j];
+
+		remaining[pos]=remaining[num_remaining-1];
+		params.added=j;
 	}
 
-	CMath::qsort_index<float64_t,pair>(distances, index, (num-1)*num/2);
-	//CMath::display_vector(distances, (num-1)*num/2, "dists");
+	SG_FREE(thread_min);
+	SG_FREE(best_from);
+	SG_FREE(best_dist);
+	SG_FREE(remaining);
+}
+
+void CHierarchical::nn_chain_linkage(int32_t num, int32_t* merge_a,
+		int32_t* merge_b, float64_t* merge_dist)
+{
+	if (num<2)
+		return;
+
+	int64_t num_pairs=int64_t(num)*(num-1)/2;
+	float32_t* dists=SG_MALLOC(float32_t, num_pairs);
 
-	int32_t k=-1;
-	int32_t l=0;
-	for (; l<num && (num-l)>=merges && k<num_pairs-1; l++)
+	/* upper triangle in blocks of rows, each block computed in parallel */
+	int32_t block=CMath::max(1, HIERARCHICAL_BLOCK_ELEMENTS/num);
+	float64_t* buf=SG_MALLOC(float64_t, int64_t(block)*num);
+	for (int32_t r=0; r<num-1; r+=block)
 	{
-		while (k<num_pairs-1)
-		{
-			k++;
+		SG_PROGRESS(r, 0, num-1)
 
-			int32_t i=index[k].idx1;
-			int32_t j=index[k].idx2;
-			int32_t c1=assignment[i];
-			int32_t c2=assignment[j];
+		int32_t num_rows=CMath::min(block, num-1-r);
+		distance->distance_block(buf, r, num_rows, r, num-r);
 
-			if (c1==c2)
-				continue;
+		for (int32_t i=0; i<num_rows; i++)
+		{
+			float32_t* row=&dists[condensed_index(num, r+i, r+i+1)];
+			for (int32_t j=i+1; j<num-r; j++)
+				row[j-i-1]=buf[i+int64_t(j)*num_rows];
+		}
+	}
+	SG_FREE(buf);
+
+	float64_t* size=SG_MALLOC(float64_t, num);
+	int32_t* active=SG_MALLOC(int32_t, num);
+	int32_t* active_pos=SG_MALLOC(int32_t, num);
+	int32_t* chain=SG_MALLOC(int32_t, num);
+	SGVector<float64_t>::fill_vector(size, num, 1.0);
+	SGVector<int32_t>::range_fill_vector(active, num);
+	SGVector<int32_t>::range_fill_vector(active_pos, num);
+	int32_t num_active=num;
+	int32_t chain_len=0;
+
+	for (int32_t l=0; l<num-1; l++)
+	{
+		if (chain_len==0)
+			chain[chain_len++]=active[0];
 
-			SG_PROGRESS(k, 0, num_pairs-1)
+		/* follow nearest neighbors until two clusters are mutual ones */
+		int32_t a, b;
+		float64_t d_ab;
+		while (true)
+		{
+			a=chain[chain_len-1];
+			b=chain_len>1 ? chain[chain_len-2] : -1;
+			d_ab=b>=0 ? dists[condensed_index(num, CMath::min(a, b),
+					CMath::max(a, b))] : CMath::INFTY;
 
-			if (c1<c2)
+			for (int32_t t=0; t<num_active; t++)
 			{
-				pairs[2*l]=c1;
-				pairs[2*l+1]=c2;
+				int32_t x=active[t];
+				if (x==a)
+					continue;
+
+				float64_t d=dists[condensed_index(num, CMath::min(a, x),
+						CMath::max(a, x))];
+				if (d<d_ab)
+				{
+					d_ab=d;
+					b=x;
+				}
 			}
-			else
-			{
-				pairs[2*l]=c2;
-				pairs[2*l+1]=c1;
-			}
-			merge_distance[l]=distances[k];
 
-			int32_t c=num+l;
-			for (int32_t m=0; m<num; m++)
+			if (chain_len>1 && b==chain[chain_len-2])
+				break;
+
+			chain[chain_len++]=b;
+		}
+		chain_len-=2;
+
+		merge_a[l]=a;
+		merge_b[l]=b;
+		merge_dist[l]=d_ab;
+
+		/* the merged cluster takes the place of b */
+		int32_t pos=active_pos[a];
+		active[pos]=active[--num_active];
+		active_pos[active[pos]]=pos;
+
+		float64_t s_a=size[a];
+		float64_t s_b=size[b];
+		for (int32_t t=0; t<num_active; t++)
+		{
+			int32_t x=active[t];
+			if (x==b)
+				continue;
+
+			float32_t& d_bx=dists[condensed_index(num, CMath::min(b, x),
+					CMath::max(b, x))];
+			float64_t d_ax=dists[condensed_index(num, CMath::min(a, x),
+					CMath::max(a, x))];
+
+			switch (linkage)
 			{
-				if (assignment[m] == c1 || assignment[m] == c2)
-					assignment[m] = c;
+				case LINKAGE_COMPLETE:
+					d_bx=CMath::max(d_ax, (float64_t) d_bx);
+					break;
+				case LINKAGE_AVERAGE:
+					d_bx=(s_a*d_ax+s_b*d_bx)/(s_a+s_b);
+					break;
+				case LINKAGE_WARD:
+				{
+					float64_t s_x=size[x];
+					float64_t d=((s_a+s_x)*d_ax*d_ax+(s_b+s_x)*d_bx*d_bx-
+							s_x*d_ab*d_ab)/(s_a+s_b+s_x);
+					d_bx=CMath::sqrt(CMath::max(d, 0.0));
+					break;
+				}
+				default:
+					SG_ERROR("Unknown linkage %d\n", linkage)
 			}
-#ifdef DEBUG_HIERARCHICAL
-			SG_PRINT("l=%04i i=%04i j=%04i c1=%+04d c2=%+04d c=%+04d dist=%6.6f\n", l,i,j, c1,c2,c, merge_distance[l])
-#endif
-			break;
 		}
+		size[b]=s_a+s_b;
 	}
 
-	assignment_size=num;
-	table_size=l-1;
-	ASSERT(table_size>0)
-	SG_FREE(distances);
-	SG_FREE(index);
-	SG_UNREF(lhs)
-
-	return true;
+	SG_FREE(chain);
+	SG_FREE(active_pos);
+	SG_FREE(active);
+	SG_FREE(size);
+	SG_FREE(dists);
 }
 
 bool CHierarchical::load(FILE* srcfile)
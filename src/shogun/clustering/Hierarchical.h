@@ -21,7 +21,20 @@ namespace shogun
 {
 class CDistanceMachine;
 
-/** @brief Agglomerative hierarchical single linkage clustering.
+/** distance between clusters used in hierarchical clustering */
+enum ELinkage
+{
+	/** minimum distance between their elements */
+	LINKAGE_SINGLE = 0,
+	/** maximum distance between their elements */
+	LINKAGE_COMPLETE = 1,
+	/** mean distance between their elements */
+	LINKAGE_AVERAGE = 2,
+	/** increase of the within cluster variance (euclidean distances) */
+	LINKAGE_WARD = 3
+};
+
+/** @brief Agglomerative hierarchical clustering.
  *
  * Starting with each object being assigned to its own cluster clusters are
  * iteratively merged.  Here the clusters are merged whose elements have
@@ -31,9 +44,22 @@ class CDistanceMachine;
  * \min\{d({\bf x},{\bf x'}): {\bf x}\in {\cal A},{\bf x'}\in {\cal B}\}
  * \f]
  *
- * are merged.
+ * are merged (single linkage, the default).
+ *
+ * cf e.g. http://en.wikipedia.org/wiki/Data_clustering
+ *
+ * Single linkage merges are the edges of a minimum spanning tree, which is
+ * grown with Prim's algorithm computing the distances on the fly (in
+ * parallel), so only O(n) memory is needed.
+ *
+ * Complete, average and Ward linkage are computed with the nearest neighbor
+ * chain algorithm on the pairwise distances, which are computed in parallel
+ * and kept as a condensed upper triangle in single precision (n(n-1)/2
+ * floats), cluster distances are updated with the Lance-Williams formula.
  *
- * cf e.g. http://en.wikipedia.org/wiki/Data_clustering*/
+ * [1] Muellner, D. (2011). Modern hierarchical, agglomerative clustering
+ * algorithms. arXiv:1109.2378.
+ */
 class CHierarchical : public CDistanceMachine
 {
 	public:
@@ -87,6 +113,21 @@ class CHierarchical : public CDistanceMachine
 		 */
 		int32_t get_merges();
 
+		/** set linkage
+		 *
+		 * @param l linkage
+		 */
+		inline void set_linkage(ELinkage l)
+		{
+			linkage=l;
+		}
+
+		/** get linkage
+		 *
+		 * @return linkage
+		 */
+		inline ELinkage get_linkage() const { return linkage; }
+
 		/** get assignment
 		 *
 		 */
@@ -123,10 +164,36 @@ class CHierarchical : public CDistanceMachine
 
 		virtual bool train_require_labels() const { return false; }
 
+	private:
+		/** merges of single linkage, i.e. the edges of a minimum spanning
+		 * tree (Prim's algorithm)
+		 *
+		 * @param num number of vectors
+		 * @param merge_a first vector of each merge (num-1)
+		 * @param merge_b second vector of each merge (num-1)
+		 * @param merge_dist distance of each merge (num-1)
+		 */
+		void single_linkage(int32_t num, int32_t* merge_a, int32_t* merge_b,
+				float64_t* merge_dist);
+
+		/** merges of complete, average or Ward linkage (nearest neighbor
+		 * chain algorithm), not ordered by distance
+		 *
+		 * @param num number of vectors
+		 * @param merge_a a vector of the first cluster of each merge (num-1)
+		 * @param merge_b a vector of the second cluster of each merge (num-1)
+		 * @param merge_dist distance of each merge (num-1)
+		 */
+		void nn_chain_linkage(int32_t num, int32_t* merge_a, int32_t* merge_b,
+				float64_t* merge_dist);
+
 	protected:
 		/// the number of merges in hierarchical clustering
 		int32_t merges;
 
+		/// distance between clusters
+		ELinkage linkage;
+
 		/// number of dimensions
 		int32_t dimensions;
 
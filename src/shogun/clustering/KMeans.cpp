@@ -11,6 +11,7 @@
 
 #include <shogun/clustering/KMeansLloydImpl.h>
 #include "shogun/clustering/KMeansMiniBatchImpl.h"
+#include <shogun/clustering/KMeansElkanImpl.h>
 #include <shogun/clustering/KMeans.h>
 #include <shogun/distance/Distance.h>
 #include <shogun/labels/Labels.h>
@@ -121,23 +122,19 @@ void CKMeans::set_initial_centers(SGVector<float64_t> weights_set,
 	SGVector<float64_t> dists=SGVector<float64_t>(k*XSize);
 	dists.zero();
 
-	for(int32_t idx=0;idx<XSize;idx++)
-	{
-		for(int32_t m=0;m<k;m++)
-			dists[k*idx+m] = distance->distance(idx,m);
-	}
+	distance->distance_block(dists.vector, 0, XSize, 0, k);
 
 	for (int32_t i=0; i<XSize; i++)
 	{
-		float64_t mini=dists[i*k];
+		float64_t mini=dists[i];
 		int32_t Cl = 0, j;
 
 		for (j=1; j<k; j++)
 		{
-			if (dists[i*k+j]<mini)
+			if (dists[i+j*XSize]<mini)
 			{
 				Cl=j;
-				mini=dists[i*k+j];
+				mini=dists[i+j*XSize];
 			}
 		}
 		ClList[i]=Cl;
@@ -262,13 +259,20 @@ bool CKMeans::train_machine(CFeatures* data)
 	else
 		set_random_centers(weights_set, ClList, XSize);
 	
-	if (train_method==KMM_MINI_BATCH)
+	switch (train_method)
 	{
+	case KMM_MINI_BATCH:
 		CKMeansMiniBatchImpl::minibatch_KMeans(k, distance, batch_size, minib_iter, mus);
-	}
-	else
-	{
+		break;
+	case KMM_ELKAN:
+		CKMeansElkanImpl::Elkan_KMeans(k, distance, max_iter, mus, ClList, weights_set, fixed_centers);
+		break;
+	case KMM_HAMERLY:
+		CKMeansElkanImpl::Hamerly_KMeans(k, distance, max_iter, mus, ClList, weights_set, fixed_centers);
+		break;
+	default:
 		CKMeansLloydImpl::Lloyd_KMeans(k, distance, max_iter, mus, ClList, weights_set, fixed_centers);
+		break;
 	}
 
 	compute_cluster_variances();
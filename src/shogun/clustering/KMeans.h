@@ -27,7 +27,11 @@ class CDistanceMachine;
 enum EKMeansMethod
 {
     KMM_MINI_BATCH,
-    KMM_LLOYD
+    KMM_LLOYD,
+    /** batch Lloyd iterations accelerated by Elkan's bounds */
+    KMM_ELKAN,
+    /** batch Lloyd iterations accelerated by Hamerly's bounds */
+    KMM_HAMERLY
 };
 
 /** @brief KMeans clustering,  partitions the data into k (a-priori specified) clusters.
@@ -42,6 +46,11 @@ enum EKMeansMethod
  *
  * Beware that this algorithm obtains only a <em>local</em> optimum.
  *
+ * KMM_ELKAN and KMM_HAMERLY skip most distance computations using the
+ * triangle inequality (see CKMeansElkanImpl), they need a CEuclideanDistance.
+ * KMM_HAMERLY needs only O(n) extra memory and is recommended for large
+ * problems.
+ *
  * cf. http://en.wikipedia.org/wiki/K-means_algorithm
  *
  */
@@ -183,7 +192,7 @@ class CKMeans : public CDistanceMachine
 
 		/** get training method
 		 *
-		 *@return training method used - minibatch or lloyd
+		 *@return training method used - minibatch, lloyd, elkan or hamerly
 		 */
 		EKMeansMethod get_train_method() const;
 
@@ -0,0 +1,422 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/clustering/KMeansElkanImpl.h>
+#include <shogun/distance/EuclideanDistance.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/base/Parallel.h>
+
+using namespace shogun;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+struct KMEANS_ASSIGN_THREAD_PARAM
+{
+	/** distance between data (lhs) and centers (rhs) */
+	CDistance* distance;
+	/** number of centers */
+	int32_t k;
+	/** cluster of each point */
+	int32_t* ClList;
+	/** upper bound of the distance to the own center */
+	float64_t* upper;
+	/** lower bounds, k per point (Elkan) or one per point (Hamerly) */
+	float64_t* lower;
+	/** center-center distances (k x k) */
+	const float64_t* center_dists;
+	/** half the distance of each center to its closest other center */
+	const float64_t* s;
+	/** number of changed assignments, each range adds its count */
+	int32_t* changed;
+	/** number of computed point-center distances per thread */
+	int64_t* num_dists;
+};
+
+struct KMEANS_UPDATE_THREAD_PARAM
+{
+	/** data */
+	CDenseFeatures<float64_t>* lhs;
+	/** points sorted by cluster */
+	const int32_t* members;
+	/** first member of each cluster (k+1) */
+	const int32_t* offsets;
+	/** cluster centers, updated in place */
+	float64_t* mus;
+	/** dimension */
+	int32_t dim;
+	/** distance each center moved */
+	float64_t* drift;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+static void add_changed(int32_t* changed, int32_t num)
+{
+	if (num)
+	{
+#ifdef HAVE_PTHREAD
+		__sync_fetch_and_add(changed, num);
+#else
+		*changed+=num;
+#endif
+	}
+}
+
+static void elkan_assign_helper(int32_t start, int32_t end, int32_t thread,
+		void* p)
+{
+	KMEANS_ASSIGN_THREAD_PARAM* params=(KMEANS_ASSIGN_THREAD_PARAM*) p;
+	CDistance* distance=params->distance;
+	int32_t k=params->k;
+	int32_t changed=0;
+	int64_t num_dists=0;
+
+	for (int32_t i=start; i<end; i++)
+	{
+		int32_t a=params->ClList[i];
+		float64_t u=params->upper[i];
+		float64_t* l=&params->lower[int64_t(i)*k];
+
+		if (u<=params->s[a])
+			continue;
+
+		bool tight=false;
+		for (int32_t j=0; j<k; j++)
+		{
+			if (j==a || u<=l[j] || u<=0.5*params->center_dists[a*k+j])
+				continue;
+
+			if (!tight)
+			{
+				u=distance->distance(i, a);
+				l[a]=u;
+				tight=true;
+				num_dists++;
+
+				if (u<=l[j] || u<=0.5*params->center_dists[a*k+j])
+					continue;
+			}
+
+			float64_t d=distance->distance(i, j);
+			l[j]=d;
+			num_dists++;
+
+			if (d<u)
+			{
+				a=j;
+				u=d;
+			}
+		}
+
+		if (a!=params->ClList[i])
+		{
+			params->ClList[i]=a;
+			changed++;
+		}
+		params->upper[i]=u;
+	}
+
+	add_changed(params->changed, changed);
+	params->num_dists[thread]+=num_dists;
+}
+
+static void hamerly_assign_helper(int32_t start, int32_t end, int32_t thread,
+		void* p)
+{
+	KMEANS_ASSIGN_THREAD_PARAM* params=(KMEANS_ASSIGN_THREAD_PARAM*) p;
+	CDistance* distance=params->distance;
+	int32_t k=params->k;
+	int32_t changed=0;
+	int64_t num_dists=0;
+
+	for (int32_t i=start; i<end; i++)
+	{
+		int32_t a=params->ClList[i];
+		float64_t bound=CMath::max(params->s[a], params->lower[i]);
+
+		if (params->upper[i]<=bound)
+			continue;
+
+		/* tighten upper bound */
+		params->upper[i]=distance->distance(i, a);
+		num_dists++;
+		if (params->upper[i]<=bound)
+			continue;
+
+		/* closest and second closest center */
+		int32_t best=0;
+		float64_t d1=CMath::INFTY;
+		float64_t d2=CMath::INFTY;
+		for (int32_t j=0; j<k; j++)
+		{
+			float64_t d=j==a ? params->upper[i] : distance->distance(i, j);
+			if (d<d1)
+			{
+				d2=d1;
+				d1=d;
+				best=j;
+			}
+			else if (d<d2)
+				d2=d;
+		}
+		num_dists+=k-1;
+
+		if (best!=a)
+		{
+			params->ClList[i]=best;
+			changed++;
+		}
+		params->upper[i]=d1;
+		params->lower[i]=d2;
+	}
+
+	add_changed(params->changed, changed);
+	params->num_dists[thread]+=num_dists;
+}
+
+static void update_centers_helper(int32_t start, int32_t end, int32_t thread,
+		void* p)
+{
+	KMEANS_UPDATE_THREAD_PARAM* params=(KMEANS_UPDATE_THREAD_PARAM*) p;
+	int32_t dim=params->dim;
+	SGVector<float64_t> mean(dim);
+
+	for (int32_t c=start; c<end; c++)
+	{
+		int32_t first=params->offsets[c];
+		int32_t last=params->offsets[c+1];
+		float64_t* mu=&params->mus[int64_t(c)*dim];
+
+		if (first==last)
+		{
+			params->drift[c]=0;
+			continue;
+		}
+
+		/* members are sorted by index, so the sum does not depend on the
+		 * number of threads */
+		mean.zero();
+		for (int32_t m=first; m<last; m++)
+		{
+			int32_t vlen;
+			bool vfree;
+			float64_t* vec=params->lhs->get_feature_vector(params->members[m],
+					vlen, vfree);
+
+			for (int32_t j=0; j<dim; j++)
+				mean[j]+=vec[j];
+
+			params->lhs->free_feature_vector(vec, params->members[m], vfree);
+		}
+
+		float64_t drift=0;
+		for (int32_t j=0; j<dim; j++)
+		{
+			mean[j]/=last-first;
+			drift+=CMath::sq(mean[j]-mu[j]);
+			mu[j]=mean[j];
+		}
+		params->drift[c]=CMath::sqrt(drift);
+	}
+}
+
+namespace shogun
+{
+void CKMeansElkanImpl::Elkan_KMeans(int32_t k, CDistance* distance,
+		int32_t max_iter, SGMatrix<float64_t> mus, SGVector<int32_t> ClList,
+		SGVector<float64_t> weights_set, bool fixed_centers)
+{
+	bounded_KMeans(true, k, distance, max_iter, mus, ClList, weights_set,
+			fixed_centers);
+}
+
+void CKMeansElkanImpl::Hamerly_KMeans(int32_t k, CDistance* distance,
+		int32_t max_iter, SGMatrix<float64_t> mus, SGVector<int32_t> ClList,
+		SGVector<float64_t> weights_set, bool fixed_centers)
+{
+	bounded_KMeans(false, k, distance, max_iter, mus, ClList, weights_set,
+			fixed_centers);
+}
+
+void CKMeansElkanImpl::update_centers(CDenseFeatures<float64_t>* lhs,
+		CDistance* distance, SGVector<int32_t> ClList, SGMatrix<float64_t> mus,
+		SGVector<float64_t> weights_set, SGVector<float64_t> drift)
+{
+	int32_t XSize=ClList.vlen;
+	int32_t k=mus.num_cols;
+
+	/* sort points by cluster (counting sort keeps index order) */
+	SGVector<int32_t> offsets(k+1);
+	offsets.zero();
+	for (int32_t i=0; i<XSize; i++)
+		offsets[ClList[i]+1]++;
+	for (int32_t c=0; c<k; c++)
+	{
+		weights_set[c]=offsets[c+1];
+		offsets[c+1]+=offsets[c];
+	}
+
+	SGVector<int32_t> members(XSize);
+	SGVector<int32_t> pos=offsets.clone();
+	for (int32_t i=0; i<XSize; i++)
+		members[pos[ClList[i]]++]=i;
+
+	KMEANS_UPDATE_THREAD_PARAM params;
+	params.lhs=lhs;
+	params.members=members.vector;
+	params.offsets=offsets.vector;
+	params.mus=mus.matrix;
+	params.dim=mus.num_rows;
+	params.drift=drift.vector;
+	distance->parallel->parallel_for(0, k, update_centers_helper, &params, 1);
+}
+
+void CKMeansElkanImpl::bounded_KMeans(bool elkan, int32_t k,
+		CDistance* distance, int32_t max_iter, SGMatrix<float64_t> mus,
+		SGVector<int32_t> ClList, SGVector<float64_t> weights_set,
+		bool fixed_centers)
+{
+	REQUIRE(distance->get_distance_type()==D_EUCLIDEAN &&
+			!((CEuclideanDistance*) distance)->get_disable_sqrt(),
+			"%s KMeans needs a metric, i.e. a CEuclideanDistance without "
+			"disabled sqrt\n", elkan ? "Elkan's" : "Hamerly's");
+
+	CDenseFeatures<float64_t>* lhs=
+		CDenseFeatures<float64_t>::obtain_from_generic(distance->get_lhs());
+	int32_t XSize=lhs->get_num_vectors();
+	int32_t dimensions=lhs->get_num_features();
+
+	/* centers are the rhs, they are updated in place */
+	CDenseFeatures<float64_t>* rhs_mus=new CDenseFeatures<float64_t>(0);
+	CFeatures* rhs_cache=distance->replace_rhs(rhs_mus);
+	rhs_mus->set_feature_matrix(mus);
+
+	/* no bounds known yet, the first pass computes the distances */
+	SGVector<float64_t> upper(XSize);
+	upper.set_const(CMath::INFTY);
+	SGVector<float64_t> lower(elkan ? int64_t(XSize)*k : XSize);
+	lower.zero();
+
+	SGMatrix<float64_t> center_dists(k, k);
+	SGVector<float64_t> s(k);
+	SGVector<float64_t> drift(k);
+
+	int32_t num_threads=distance->parallel->get_num_threads();
+	SGVector<int64_t> num_dists(num_threads);
+	num_dists.zero();
+
+	KMEANS_ASSIGN_THREAD_PARAM params;
+	params.distance=distance;
+	params.k=k;
+	params.ClList=ClList.vector;
+	params.upper=upper.vector;
+	params.lower=lower.vector;
+	params.center_dists=center_dists.matrix;
+	params.s=s.vector;
+	params.num_dists=num_dists.vector;
+
+	int32_t changed=1;
+	int32_t iter=0;
+	while (changed && iter<max_iter)
+	{
+		iter++;
+
+		/* distances between centers, s(c) is half the distance of center c
+		 * to its closest other center */
+		for (int32_t i=0; i<k; i++)
+		{
+			center_dists(i,i)=0;
+			s[i]=CMath::INFTY;
+			for (int32_t j=0; j<i; j++)
+			{
+				float64_t d=0;
+				for (int32_t l=0; l<dimensions; l++)
+					d+=CMath::sq(mus(l,i)-mus(l,j));
+
+				d=CMath::sqrt(d);
+				center_dists(i,j)=d;
+				center_dists(j,i)=d;
+				s[i]=CMath::min(s[i], 0.5*d);
+				s[j]=CMath::min(s[j], 0.5*d);
+			}
+		}
+
+		changed=0;
+		params.changed=&changed;
+		distance->parallel->parallel_for(0, XSize,
+				elkan ? elkan_assign_helper : hamerly_assign_helper, &params);
+
+		/* the first pass assigns all points, it counts as change */
+		if (iter==1)
+			changed=CMath::max(changed, 1);
+
+		if (iter%100==0)
+			SG_SINFO("Iteration[%d/%d]: Assignment of %i patterns changed.\n",
+					iter, max_iter, changed)
+
+		if (fixed_centers)
+			break;
+
+		if (!changed)
+			break;
+
+		update_centers(lhs, distance, ClList, mus, weights_set, drift);
+
+		/* loosen bounds by the movement of the centers */
+		int32_t max_c=0;
+		int32_t second_c=-1;
+		for (int32_t c=1; c<k; c++)
+		{
+			if (drift[c]>drift[max_c])
+			{
+				second_c=max_c;
+				max_c=c;
+			}
+			else if (second_c<0 || drift[c]>drift[second_c])
+				second_c=c;
+		}
+
+		for (int32_t i=0; i<XSize; i++)
+		{
+			int32_t a=ClList[i];
+			upper[i]+=drift[a];
+
+			if (elkan)
+			{
+				float64_t* l=&lower[int64_t(i)*k];
+				for (int32_t c=0; c<k; c++)
+					l[c]=CMath::max(l[c]-drift[c], 0.0);
+			}
+			else
+			{
+				float64_t d=a==max_c && second_c>=0 ?
+					drift[second_c] : drift[max_c];
+				lower[i]=CMath::max(lower[i]-d, 0.0);
+			}
+		}
+	}
+
+	if (iter==max_iter && changed)
+		SG_SWARNING("kmeans clustering changed throughout %d iterations stopping...\n", max_iter)
+
+	/* sizes of final clusters */
+	weights_set.zero();
+	for (int32_t i=0; i<XSize; i++)
+		weights_set[ClList[i]]+=1.0;
+
+	int64_t total_dists=0;
+	for (int32_t t=0; t<num_threads; t++)
+		total_dists+=num_dists[t];
+	SG_SDEBUG("%d iterations, computed %lld of %lld point-center distances\n",
+			iter, total_dists, int64_t(iter)*XSize*k)
+
+	distance->replace_rhs(rhs_cache);
+	delete rhs_mus;
+	SG_UNREF(lhs);
+}
+}
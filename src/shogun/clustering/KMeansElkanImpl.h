@@ -0,0 +1,102 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#ifndef _EKMEANS_H__
+#define _EKMEANS_H__
+
+#include <shogun/lib/common.h>
+#include <shogun/io/SGIO.h>
+#include <shogun/distance/Distance.h>
+
+namespace shogun
+{
+template <class ST> class CDenseFeatures;
+
+/** @brief Batch KMeans that uses the triangle inequality to skip most
+ * point-center distance computations.
+ *
+ * Both methods compute exactly the iterations of batch Lloyd KMeans (assign
+ * every point to its closest center, then move every center to the mean of
+ * its points), but keep for every point an upper bound on the distance to its
+ * center and lower bounds on the distances to the other centers. Bounds are
+ * loosened by the movement of the centers after each update, a point whose
+ * upper bound stays below its lower bounds keeps its center without computing
+ * any distance.
+ *
+ * Elkan_KMeans keeps one lower bound per point and center (memory
+ * \f$O(nk)\f$) and uses all center-center distances, it skips the most
+ * distance computations for moderate n*k.
+ * Hamerly_KMeans keeps a single lower bound per point (memory \f$O(n)\f$) and
+ * is the method of choice for many points and centers.
+ *
+ * Assignment and center updates run in parallel. The distance has to be a
+ * CEuclideanDistance (without disabled sqrt), since the bounds need a metric.
+ *
+ * [1] Elkan, C. (2003). Using the triangle inequality to accelerate k-means.
+ * ICML.
+ *
+ * [2] Hamerly, G. (2010). Making k-means even faster. SDM.
+ */
+class CKMeansElkanImpl
+{
+	public:
+		/** Elkan's KMeans training method
+		 *
+		 * @param k parameter k
+		 * @param distance euclidean distance
+		 * @param max_iter max iterations allowed
+		 * @param mus cluster centers matrix (k columns)
+		 * @param ClList cluster number each data vector belongs (size no_of_vectors)
+		 * @param weights_set no. of points belonging to each cluster (size k)
+		 * @param fixed_centers keep centers fixed or not
+		 */
+		static void Elkan_KMeans(int32_t k, CDistance* distance, int32_t max_iter,
+			SGMatrix<float64_t> mus, SGVector<int32_t> ClList,
+			SGVector<float64_t> weights_set, bool fixed_centers);
+
+		/** Hamerly's KMeans training method
+		 *
+		 * @param k parameter k
+		 * @param distance euclidean distance
+		 * @param max_iter max iterations allowed
+		 * @param mus cluster centers matrix (k columns)
+		 * @param ClList cluster number each data vector belongs (size no_of_vectors)
+		 * @param weights_set no. of points belonging to each cluster (size k)
+		 * @param fixed_centers keep centers fixed or not
+		 */
+		static void Hamerly_KMeans(int32_t k, CDistance* distance, int32_t max_iter,
+			SGMatrix<float64_t> mus, SGVector<int32_t> ClList,
+			SGVector<float64_t> weights_set, bool fixed_centers);
+
+	private:
+		/** common part of both methods
+		 *
+		 * @param elkan true for Elkan's, false for Hamerly's method
+		 */
+		static void bounded_KMeans(bool elkan, int32_t k, CDistance* distance,
+			int32_t max_iter, SGMatrix<float64_t> mus, SGVector<int32_t> ClList,
+			SGVector<float64_t> weights_set, bool fixed_centers);
+
+		/** move centers to the means of their points (in parallel over the
+		 * centers), centers of empty clusters stay where they are
+		 *
+		 * @param lhs data
+		 * @param distance distance (for its parallel settings)
+		 * @param ClList cluster of each data vector
+		 * @param mus cluster centers, updated in place
+		 * @param weights_set number of points per cluster (output)
+		 * @param drift distance each center moved (output)
+		 */
+		static void update_centers(CDenseFeatures<float64_t>* lhs,
+			CDistance* distance, SGVector<int32_t> ClList,
+			SGMatrix<float64_t> mus, SGVector<float64_t> weights_set,
+			SGVector<float64_t> drift);
+};
+}
+#endif
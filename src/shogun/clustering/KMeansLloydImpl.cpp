@@ -73,6 +73,11 @@ void CKMeansLloydImpl::Lloyd_KMeans(int32_t k, CDistance* distance, int32_t max_
 			}
 		}
 		rhs_mus->copy_feature_matrix(mus);
+
+		/* distances of all points to all centers of this iteration at
+		 * once, dists(Pat,idx_k) */
+		distance->distance_block(dists.vector, 0, XSize, 0, k);
+
 		for (int32_t i=0; i<XSize; i++)
 		{
 			/* ks=ceil(rand(1,XSize)*XSize) ; */
@@ -81,16 +86,12 @@ void CKMeansLloydImpl::Lloyd_KMeans(int32_t k, CDistance* distance, int32_t max_
 			int32_t imini, j;
 			float64_t mini;
 
-			/* compute the distance of this point to all centers */
-			for(int32_t idx_k=0;idx_k<k;idx_k++)
-				dists[idx_k]=distance->distance(Pat,idx_k);
-
-			/* [mini,imini]=min(dists(:,i)) ; */
-			imini=0 ; mini=dists[0];
+			/* [mini,imini]=min(dists(Pat,:)) ; */
+			imini=0 ; mini=dists[Pat];
 			for (j=1; j<k; j++)
-				if (dists[j]<mini)
+				if (dists[Pat+j*XSize]<mini)
 				{
-					mini=dists[j];
+					mini=dists[Pat+j*XSize];
 					imini=j;
 				}
 
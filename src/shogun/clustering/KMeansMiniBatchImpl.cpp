@@ -11,9 +11,46 @@
 #include <shogun/mathematics/Math.h>
 #include <shogun/distance/Distance.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/base/Parallel.h>
 
 using namespace shogun;
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+struct MINIBATCH_ASSIGN_THREAD_PARAM
+{
+	/** distance between data (lhs) and centers (rhs) */
+	CDistance* distance;
+	/** number of centers */
+	int32_t k;
+	/** points of the batch */
+	const int32_t* batch;
+	/** closest center of each point of the batch */
+	int32_t* ncent;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+static void minibatch_assign_helper(int32_t start, int32_t end, int32_t thread,
+		void* p)
+{
+	MINIBATCH_ASSIGN_THREAD_PARAM* params=(MINIBATCH_ASSIGN_THREAD_PARAM*) p;
+
+	for (int32_t j=start; j<end; j++)
+	{
+		int32_t imin=0;
+		float64_t min=params->distance->distance(params->batch[j], 0);
+		for (int32_t c=1; c<params->k; c++)
+		{
+			float64_t dist=params->distance->distance(params->batch[j], c);
+			if (dist<min)
+			{
+				imin=c;
+				min=dist;
+			}
+		}
+		params->ncent[j]=imin;
+	}
+}
+
 namespace shogun
 {
 void CKMeansMiniBatchImpl::minibatch_KMeans(int32_t k, CDistance* distance, int32_t batch_size, int32_t minib_iter, SGMatrix<float64_t> mus)
@@ -38,24 +75,17 @@ void CKMeansMiniBatchImpl::minibatch_KMeans(int32_t k, CDistance* distance, int3
 	{
 		SGVector<int32_t> M=mbchoose_rand(batch_size,XSize);
 		SGVector<int32_t> ncent=SGVector<int32_t>(batch_size);
-		for (int32_t j=0; j<batch_size; j++)
-		{
-			SGVector<float64_t> dists=SGVector<float64_t>(k);
-			for (int32_t p=0; p<k; p++)
-				dists[p]=distance->distance(M[j],p);
 
-			int32_t imin=0;
-			float64_t min=dists[0];
-			for (int32_t p=1; p<k; p++)
-			{
-				if (dists[p]<min)
-				{
-					imin=p;
-					min=dists[p];
-				}
-			}
-			ncent[j]=imin;
-		}
+		/* assign the batch to the current centers in parallel, centers are
+		 * only updated afterwards */
+		MINIBATCH_ASSIGN_THREAD_PARAM params;
+		params.distance=distance;
+		params.k=k;
+		params.batch=M.vector;
+		params.ncent=ncent.vector;
+		distance->parallel->parallel_for(0, batch_size, minibatch_assign_helper,
+				&params);
+
 		for (int32_t j=0; j<batch_size; j++)
 		{
 			int32_t near=ncent[j];
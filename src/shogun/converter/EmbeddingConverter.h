@@ -24,6 +24,18 @@ class CFeatures;
 class CDistance;
 class CKernel;
 
+/** method used by converters based on the Tapkee library to find the
+ * neighbors of every vector */
+enum EEmbeddingNeighborsMethod
+{
+	/** compute all pairwise distances */
+	NEIGHBORS_BRUTE_FORCE = 0,
+	/** exact vantage point tree */
+	NEIGHBORS_VP_TREE = 1,
+	/** exact cover tree */
+	NEIGHBORS_COVER_TREE = 2
+};
+
 /** @brief class EmbeddingConverter (part of the Efficient Dimensionality
  * Reduction Toolkit) used to construct embeddings of
  * features, e.g. construct dense numeric embedding of string features
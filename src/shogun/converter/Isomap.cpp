@@ -19,6 +19,7 @@ using namespace shogun;
 CIsomap::CIsomap() : CMultidimensionalScaling()
 {
 	m_k = 3;
+	m_neighbors_method = NEIGHBORS_COVER_TREE;
 
 	init();
 }
@@ -26,6 +27,8 @@ CIsomap::CIsomap() : CMultidimensionalScaling()
 void CIsomap::init()
 {
 	SG_ADD(&m_k, "k", "number of neighbors", MS_AVAILABLE);
+	SG_ADD((machine_int_t*) &m_neighbors_method, "neighbors_method",
+			"method to find the neighbors", MS_NOT_AVAILABLE);
 }
 
 CIsomap::~CIsomap()
@@ -43,6 +46,16 @@ int32_t CIsomap::get_k() const
 	return m_k;
 }
 
+void CIsomap::set_neighbors_method(EEmbeddingNeighborsMethod method)
+{
+	m_neighbors_method = method;
+}
+
+EEmbeddingNeighborsMethod CIsomap::get_neighbors_method() const
+{
+	return m_neighbors_method;
+}
+
 const char* CIsomap::get_name() const
 {
 	return "Isomap";
@@ -61,6 +74,7 @@ CDenseFeatures<float64_t>* CIsomap::embed_distance(CDistance* distance)
 		parameters.method = SHOGUN_ISOMAP;
 	}
 	parameters.n_neighbors = m_k;
+	parameters.neighbors_method = m_neighbors_method;
 	parameters.target_dimension = m_target_dim;
 	parameters.distance = distance;
 	CDenseFeatures<float64_t>* embedding = tapkee_embed(parameters);
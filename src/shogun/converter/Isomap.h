@@ -64,6 +64,16 @@ public:
 	 */
 	int32_t get_k() const;
 
+	/** setter for method to find the neighbors
+	 * @param method neighbors method
+	 */
+	void set_neighbors_method(EEmbeddingNeighborsMethod method);
+
+	/** getter for method to find the neighbors
+	 * @return neighbors method
+	 */
+	EEmbeddingNeighborsMethod get_neighbors_method() const;
+
 	/** embed distance */
 	virtual CDenseFeatures<float64_t>* embed_distance(CDistance* distance);
 
@@ -79,6 +89,9 @@ protected:
 	/** k, number of neighbors for K-Isomap */
 	int32_t m_k;
 
+	/** method to find the neighbors */
+	EEmbeddingNeighborsMethod m_neighbors_method;
+
 };
 }
 #endif /* HAVE_EIGEN3 */
@@ -25,6 +25,7 @@ CLocallyLinearEmbedding::CLocallyLinearEmbedding() :
 	m_k = 10;
 	m_nullspace_shift = -1e-9;
 	m_reconstruction_shift = 1e-3;
+	m_neighbors_method = NEIGHBORS_COVER_TREE;
 	init();
 }
 
@@ -35,6 +36,8 @@ void CLocallyLinearEmbedding::init()
       "nullspace finding regularization shift",MS_NOT_AVAILABLE);
 	SG_ADD(&m_reconstruction_shift, "reconstruction_shift",
       "shift used to regularize reconstruction step", MS_NOT_AVAILABLE);
+	SG_ADD((machine_int_t*) &m_neighbors_method, "neighbors_method",
+      "method to find the neighbors", MS_NOT_AVAILABLE);
 }
 
 
@@ -53,6 +56,16 @@ int32_t CLocallyLinearEmbedding::get_k() const
 	return m_k;
 }
 
+void CLocallyLinearEmbedding::set_neighbors_method(EEmbeddingNeighborsMethod method)
+{
+	m_neighbors_method = method;
+}
+
+EEmbeddingNeighborsMethod CLocallyLinearEmbedding::get_neighbors_method() const
+{
+	return m_neighbors_method;
+}
+
 void CLocallyLinearEmbedding::set_nullspace_shift(float64_t nullspace_shift)
 {
 	m_nullspace_shift = nullspace_shift;
@@ -84,6 +97,7 @@ CFeatures* CLocallyLinearEmbedding::apply(CFeatures* features)
 	CKernel* kernel = new CLinearKernel((CDotFeatures*)features,(CDotFeatures*)features);
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
 	parameters.n_neighbors = m_k;
+	parameters.neighbors_method = m_neighbors_method;
 	parameters.eigenshift = m_nullspace_shift;
 	parameters.method = SHOGUN_LOCALLY_LINEAR_EMBEDDING;
 	parameters.target_dimension = m_target_dim;
@@ -69,6 +69,16 @@ public:
 	 */
 	int32_t get_k() const;
 
+	/** setter for method to find the neighbors
+	 * @param method neighbors method
+	 */
+	void set_neighbors_method(EEmbeddingNeighborsMethod method);
+
+	/** getter for method to find the neighbors
+	 * @return neighbors method
+	 */
+	EEmbeddingNeighborsMethod get_neighbors_method() const;
+
 	/** setter for reconstruction shift parameter
 	 * @param reconstruction_shift reconstruction shift value
 	 */
@@ -110,6 +120,9 @@ protected:
 	/** regularization shift of nullspace finding step */
 	float64_t m_nullspace_shift;
 
+	/** method to find the neighbors */
+	EEmbeddingNeighborsMethod m_neighbors_method;
+
 };
 }
 
@@ -12,6 +12,7 @@
 #include <shogun/lib/common.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/distance/CosineDistance.h>
+#include <shogun/mathematics/lapack.h>
 #include <shogun/features/Features.h>
 
 using namespace shogun;
@@ -80,3 +81,63 @@ float64_t CCosineDistance::compute(int32_t idx_a, int32_t idx_b)
 	else
 		return s ;
 }
+
+bool CCosineDistance::has_block_computation()
+{
+#ifdef HAVE_LAPACK
+	return lhs && rhs &&
+		lhs->get_feature_class()==C_DENSE && lhs->get_feature_type()==F_DREAL &&
+		rhs->get_feature_class()==C_DENSE && rhs->get_feature_type()==F_DREAL;
+#else
+	return false;
+#endif
+}
+
+void CCosineDistance::compute_block(float64_t* block, int32_t lhs_start,
+		int32_t num_lhs_block, int32_t rhs_start, int32_t num_rhs_block)
+{
+#ifdef HAVE_LAPACK
+	CDenseFeatures<float64_t>* l=(CDenseFeatures<float64_t>*) lhs;
+	CDenseFeatures<float64_t>* r=(CDenseFeatures<float64_t>*) rhs;
+	int32_t dim=l->get_num_features();
+	ASSERT(dim==r->get_num_features())
+
+	bool free_a, free_b;
+	float64_t* a=l->get_feature_block(lhs_start, num_lhs_block, free_a);
+	float64_t* b=r->get_feature_block(rhs_start, num_rhs_block, free_b);
+
+	SGVector<float64_t> norm_a(num_lhs_block);
+	for (int32_t i=0; i<num_lhs_block; i++)
+		norm_a[i]=sqrt(SGVector<float64_t>::dot(&a[int64_t(i)*dim], &a[int64_t(i)*dim], dim));
+
+	SGVector<float64_t> norm_b(num_rhs_block);
+	for (int32_t j=0; j<num_rhs_block; j++)
+		norm_b[j]=sqrt(SGVector<float64_t>::dot(&b[int64_t(j)*dim], &b[int64_t(j)*dim], dim));
+
+	/* block = a^T b */
+	cblas_dgemm(CblasColMajor, CblasTrans, CblasNoTrans,
+			num_lhs_block, num_rhs_block, dim, 1.0, a, dim, b, dim,
+			0.0, block, num_lhs_block);
+
+	l->free_feature_block(a, free_a);
+	r->free_feature_block(b, free_b);
+
+	for (int32_t j=0; j<num_rhs_block; j++)
+	{
+		float64_t* col=&block[int64_t(j)*num_lhs_block];
+		for (int32_t i=0; i<num_lhs_block; i++)
+		{
+			float64_t s=norm_a[i]*norm_b[j];
+
+			// trap division by zero
+			if (s==0)
+				col[i]=0;
+			else
+				col[i]=CMath::max(0.0, 1-col[i]/s);
+		}
+	}
+#else
+	CRealDistance::compute_block(block, lhs_start, num_lhs_block, rhs_start,
+			num_rhs_block);
+#endif
+}
@@ -74,6 +74,23 @@ class CCosineDistance: public CDenseDistance<float64_t>
 		/// idx_{a,b} denote the index of the feature vectors
 		/// in the corresponding feature object
 		virtual float64_t compute(int32_t idx_a, int32_t idx_b);
+
+		/** @return whether compute_block() is available, i.e. both sides
+		 * are dense real valued features */
+		virtual bool has_block_computation();
+
+		/** compute a block of the distance matrix at once, the inner products
+		 * of all pairs are obtained by a single matrix-matrix product
+		 *
+		 * @param block column major output of size
+		 * num_lhs_block x num_rhs_block
+		 * @param lhs_start first lhs index
+		 * @param num_lhs_block number of lhs vectors
+		 * @param rhs_start first rhs index
+		 * @param num_rhs_block number of rhs vectors
+		 */
+		virtual void compute_block(float64_t* block, int32_t lhs_start,
+				int32_t num_lhs_block, int32_t rhs_start, int32_t num_rhs_block);
 };
 
 } // namespace shogun
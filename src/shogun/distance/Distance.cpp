@@ -24,10 +24,6 @@
 #include <string.h>
 #include <unistd.h>
 
-#ifdef HAVE_PTHREAD
-#include <pthread.h>
-#endif
-
 using namespace shogun;
 
 /** distance thread parameters */
@@ -55,6 +51,31 @@ template <class T> struct D_THREAD_PARAM
 	bool verbose;
 };
 
+/** distance block thread parameters */
+template <class T> struct D_BLOCK_THREAD_PARAM
+{
+	/** distance */
+	CDistance* distance;
+	/** result */
+	T* result;
+	/** first lhs index */
+	int32_t lhs_start;
+	/** first rhs index */
+	int32_t rhs_start;
+	/** m */
+	int32_t m;
+	/** n */
+	int32_t n;
+	/** number of tiles along the rows */
+	int32_t num_blocks_m;
+	/** distance matrix k(i,j)=k(j,i) */
+	bool symmetric;
+};
+
+/** number of rows/columns of the tiles in which distance matrices of
+ * distances with block computation are computed */
+#define DISTANCE_BLOCK_SIZE 256
+
 CDistance::CDistance() : CSGObject()
 {
 	init();
@@ -224,6 +245,46 @@ float64_t CDistance::distance(int32_t idx_a, int32_t idx_b)
 	return compute(idx_a, idx_b);
 }
 
+void CDistance::compute_block(float64_t* block, int32_t lhs_start,
+		int32_t num_lhs_block, int32_t rhs_start, int32_t num_rhs_block)
+{
+	for (int32_t j=0; j<num_rhs_block; j++)
+	{
+		for (int32_t i=0; i<num_lhs_block; i++)
+			block[i+int64_t(j)*num_lhs_block]=distance(lhs_start+i, rhs_start+j);
+	}
+}
+
+void CDistance::distance_block(float64_t* result, int32_t lhs_start,
+		int32_t num_lhs_block, int32_t rhs_start, int32_t num_rhs_block)
+{
+	REQUIRE(has_features(), "no features assigned to distance\n")
+	REQUIRE(lhs_start>=0 && num_lhs_block>=0 &&
+			lhs_start+num_lhs_block<=lhs->get_num_vectors(),
+			"lhs block [%d, %d) out of range [0, %d)\n", lhs_start,
+			lhs_start+num_lhs_block, lhs->get_num_vectors())
+	REQUIRE(rhs_start>=0 && num_rhs_block>=0 &&
+			rhs_start+num_rhs_block<=rhs->get_num_vectors(),
+			"rhs block [%d, %d) out of range [0, %d)\n", rhs_start,
+			rhs_start+num_rhs_block, rhs->get_num_vectors())
+
+	D_BLOCK_THREAD_PARAM<float64_t> params;
+	params.distance=this;
+	params.result=result;
+	params.lhs_start=lhs_start;
+	params.rhs_start=rhs_start;
+	params.m=num_lhs_block;
+	params.n=num_rhs_block;
+	params.num_blocks_m=(num_lhs_block+DISTANCE_BLOCK_SIZE-1)/DISTANCE_BLOCK_SIZE;
+	params.symmetric=false;
+
+	int32_t num_blocks_n=(num_rhs_block+DISTANCE_BLOCK_SIZE-1)/DISTANCE_BLOCK_SIZE;
+
+	/* every tile is a task of its own */
+	parallel->parallel_for(0, params.num_blocks_m*num_blocks_n,
+			CDistance::get_distance_block_helper<float64_t>, (void*) &params, 1);
+}
+
 void CDistance::do_precompute_matrix()
 {
 	int32_t num_left=lhs->get_num_vectors();
@@ -313,6 +374,62 @@ template <class T> void* CDistance::get_distance_matrix_helper(void* p)
 	return NULL;
 }
 
+template <class T> void CDistance::get_distance_matrix_range_helper(
+		int32_t start, int32_t end, int32_t thread, void* p)
+{
+	D_THREAD_PARAM<T> params=*((D_THREAD_PARAM<T>*) p);
+	params.start=start;
+	params.end=end;
+	get_distance_matrix_helper<T>((void*) &params);
+}
+
+template <class T> void CDistance::get_distance_block_helper(
+		int32_t start, int32_t end, int32_t thread, void* p)
+{
+	D_BLOCK_THREAD_PARAM<T>* params=(D_BLOCK_THREAD_PARAM<T>*) p;
+	CDistance* d=params->distance;
+	T* result=params->result;
+	int32_t m=params->m;
+	int32_t n=params->n;
+	bool symmetric=params->symmetric;
+
+	float64_t* block=SG_MALLOC(float64_t, DISTANCE_BLOCK_SIZE*DISTANCE_BLOCK_SIZE);
+
+	for (int32_t b=start; b<end && !CSignal::cancel_computations(); b++)
+	{
+		int32_t bi=b%params->num_blocks_m;
+		int32_t bj=b/params->num_blocks_m;
+
+		/* lower triangle is filled by mirroring the upper one */
+		if (symmetric && bj<bi)
+			continue;
+
+		int32_t i_start=bi*DISTANCE_BLOCK_SIZE;
+		int32_t j_start=bj*DISTANCE_BLOCK_SIZE;
+		int32_t num_i=CMath::min(DISTANCE_BLOCK_SIZE, m-i_start);
+		int32_t num_j=CMath::min(DISTANCE_BLOCK_SIZE, n-j_start);
+
+		d->compute_block(block, params->lhs_start+i_start, num_i,
+				params->rhs_start+j_start, num_j);
+
+		for (int32_t j=0; j<num_j; j++)
+		{
+			for (int32_t i=0; i<num_i; i++)
+			{
+				int32_t row=i_start+i;
+				int32_t col=j_start+j;
+				T v=(T) block[i+j*num_i];
+				result[row+int64_t(col)*m]=v;
+
+				if (symmetric)
+					result[col+int64_t(row)*m]=v;
+			}
+		}
+	}
+
+	SG_FREE(block);
+}
+
 template <class T>
 SGMatrix<T> CDistance::get_distance_matrix()
 {
@@ -332,76 +449,51 @@ SGMatrix<T> CDistance::get_distance_matrix()
 
 		result=SG_MALLOC(T, total_num);
 
+	if (has_block_computation())
+	{
+		D_BLOCK_THREAD_PARAM<T> block_params;
+		block_params.distance=this;
+		block_params.result=result;
+		block_params.lhs_start=0;
+		block_params.rhs_start=0;
+		block_params.m=m;
+		block_params.n=n;
+		block_params.num_blocks_m=(m+DISTANCE_BLOCK_SIZE-1)/DISTANCE_BLOCK_SIZE;
+		block_params.symmetric=symmetric;
+
+		int32_t num_blocks_n=(n+DISTANCE_BLOCK_SIZE-1)/DISTANCE_BLOCK_SIZE;
+
+		/* every tile is a task of its own */
+		parallel->parallel_for(0, block_params.num_blocks_m*num_blocks_n,
+				CDistance::get_distance_block_helper<T>,
+				(void*) &block_params, 1);
+
+		SG_DONE()
+
+		return SGMatrix<T>(result,m,n,true);
+	}
+
 	int32_t num_threads=parallel->get_num_threads();
+	D_THREAD_PARAM<T> params;
+	params.distance=this;
+	params.result=result;
+	params.start=0;
+	params.end=m;
+	params.total_start=0;
+	params.total_end=total_num;
+	params.n=n;
+	params.m=m;
+	params.symmetric=symmetric;
+	params.verbose=num_threads<2;
+
 	if (num_threads < 2)
-	{
-		D_THREAD_PARAM<T> params;
-		params.distance=this;
-		params.result=result;
-		params.start=0;
-		params.end=m;
-		params.total_start=0;
-		params.total_end=total_num;
-		params.n=n;
-		params.m=m;
-		params.symmetric=symmetric;
-		params.verbose=true;
 		get_distance_matrix_helper<T>((void*) &params);
-	}
 	else
 	{
-		pthread_t* threads = SG_MALLOC(pthread_t, num_threads-1);
-		D_THREAD_PARAM<T>* params = SG_MALLOC(D_THREAD_PARAM<T>, num_threads);
-		int64_t step= total_num/num_threads;
-
-		int32_t t;
-
-		num_threads--;
-		for (t=0; t<num_threads; t++)
-		{
-			params[t].distance = this;
-			params[t].result = result;
-			params[t].start = compute_row_start(t*step, n, symmetric);
-			params[t].end = compute_row_start((t+1)*step, n, symmetric);
-			params[t].total_start=t*step;
-			params[t].total_end=(t+1)*step;
-			params[t].n=n;
-			params[t].m=m;
-			params[t].symmetric=symmetric;
-			params[t].verbose=false;
-
-			int code=pthread_create(&threads[t], NULL,
-					CDistance::get_distance_matrix_helper<T>, (void*)&params[t]);
-
-			if (code != 0)
-			{
-				SG_WARNING("Thread creation failed (thread %d of %d) "
-						"with error:'%s'\n",t, num_threads, strerror(code));
-				num_threads=t;
-				break;
-			}
-		}
-
-		params[t].distance = this;
-		params[t].result = result;
-		params[t].start = compute_row_start(t*step, n, symmetric);
-		params[t].end = m;
-		params[t].total_start=t*step;
-		params[t].total_end=total_num;
-		params[t].n=n;
-		params[t].m=m;
-		params[t].symmetric=symmetric;
-		params[t].verbose=true;
-		get_distance_matrix_helper<T>(&params[t]);
-
-		for (t=0; t<num_threads; t++)
-		{
-			if (pthread_join(threads[t], NULL) != 0)
-				SG_WARNING("pthread_join of thread %d/%d failed\n", t, num_threads)
-		}
-
-		SG_FREE(params);
-		SG_FREE(threads);
+		/* rows of a symmetric matrix get shorter towards the end, dynamic
+		 * chunking takes care of balancing the load */
+		parallel->parallel_for(0, m,
+				CDistance::get_distance_matrix_range_helper<T>, (void*) &params);
 	}
 
 	SG_DONE()
@@ -414,3 +506,13 @@ template SGMatrix<float32_t> CDistance::get_distance_matrix<float32_t>();
 
 template void* CDistance::get_distance_matrix_helper<float64_t>(void* p);
 template void* CDistance::get_distance_matrix_helper<float32_t>(void* p);
+
+template void CDistance::get_distance_matrix_range_helper<float64_t>(
+		int32_t start, int32_t end, int32_t thread, void* p);
+template void CDistance::get_distance_matrix_range_helper<float32_t>(
+		int32_t start, int32_t end, int32_t thread, void* p);
+
+template void CDistance::get_distance_block_helper<float64_t>(
+		int32_t start, int32_t end, int32_t thread, void* p);
+template void CDistance::get_distance_block_helper<float32_t>(
+		int32_t start, int32_t end, int32_t thread, void* p);
@@ -119,6 +119,24 @@ class CDistance : public CSGObject
 			return distance(idx_a, idx_b);
 		}
 
+		/** compute the distances between a block of lhs and a block of rhs
+		 * feature vectors at once, i.e.
+		 * result[i+j*num_lhs_block]=distance(lhs_start+i, rhs_start+j).
+		 *
+		 * Distances that provide a block computation (e.g. via BLAS) process
+		 * the block in tiles which are computed in parallel, all others
+		 * fall back to distance().
+		 *
+		 * @param result column major output of size
+		 * num_lhs_block x num_rhs_block
+		 * @param lhs_start first lhs index
+		 * @param num_lhs_block number of lhs vectors
+		 * @param rhs_start first rhs index
+		 * @param num_rhs_block number of rhs vectors
+		 */
+		void distance_block(float64_t* result, int32_t lhs_start,
+				int32_t num_lhs_block, int32_t rhs_start, int32_t num_rhs_block);
+
 		/** get distance matrix
 		 *
 		 * @return computed distance matrix (needs to be cleaned up)
@@ -158,6 +176,28 @@ class CDistance : public CSGObject
 		 */
 		template <class T> static void* get_distance_matrix_helper(void* p);
 
+		/** helper for computing rows [start, end) of the distance matrix,
+		 * used by Parallel::parallel_for
+		 *
+		 * @param start first row
+		 * @param end one past the last row
+		 * @param thread index of the executing thread
+		 * @param p parameters shared by all threads
+		 */
+		template <class T> static void get_distance_matrix_range_helper(
+				int32_t start, int32_t end, int32_t thread, void* p);
+
+		/** helper for computing tiles [start, end) of a distance matrix
+		 * via compute_block(), used by Parallel::parallel_for
+		 *
+		 * @param start first tile
+		 * @param end one past the last tile
+		 * @param thread index of the executing thread
+		 * @param p parameters shared by all threads
+		 */
+		template <class T> static void get_distance_block_helper(
+				int32_t start, int32_t end, int32_t thread, void* p);
+
 		/** init distance
 		 *
 		 *  make sure to check that your distance can deal with the
@@ -321,6 +361,29 @@ class CDistance : public CSGObject
 		/// in the corresponding feature object
 		virtual float64_t compute(int32_t idx_a, int32_t idx_b)=0;
 
+		/** check whether compute_block() is available for the current
+		 * features. Distances that can compute whole blocks of the
+		 * distance matrix faster than by single compute() calls (e.g. via
+		 * BLAS) should override this and compute_block().
+		 *
+		 * @return whether blocks can be computed at once
+		 */
+		virtual bool has_block_computation() { return false; }
+
+		/** compute a block of the distance matrix, i.e.
+		 * block[i+j*num_lhs_block]=distance(lhs_start+i, rhs_start+j).
+		 * This default implementation loops over distance().
+		 *
+		 * @param block column major output of size
+		 * num_lhs_block x num_rhs_block
+		 * @param lhs_start first lhs index
+		 * @param num_lhs_block number of lhs vectors
+		 * @param rhs_start first rhs index
+		 * @param num_rhs_block number of rhs vectors
+		 */
+		virtual void compute_block(float64_t* block, int32_t lhs_start,
+				int32_t num_lhs_block, int32_t rhs_start, int32_t num_rhs_block);
+
 		/// matrix precomputation
 		void do_precompute_matrix();
 
@@ -11,6 +11,7 @@
 #include <shogun/lib/common.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/distance/EuclideanDistance.h>
+#include <shogun/mathematics/lapack.h>
 
 using namespace shogun;
 
@@ -66,6 +67,62 @@ float64_t CEuclideanDistance::compute(int32_t idx_a, int32_t idx_b)
 	return CMath::sqrt(result);
 }
 
+bool CEuclideanDistance::has_block_computation()
+{
+#ifdef HAVE_LAPACK
+	return lhs && rhs &&
+		lhs->get_feature_class()==C_DENSE && lhs->get_feature_type()==F_DREAL &&
+		rhs->get_feature_class()==C_DENSE && rhs->get_feature_type()==F_DREAL;
+#else
+	return false;
+#endif
+}
+
+void CEuclideanDistance::compute_block(float64_t* block, int32_t lhs_start,
+		int32_t num_lhs_block, int32_t rhs_start, int32_t num_rhs_block)
+{
+#ifdef HAVE_LAPACK
+	CDenseFeatures<float64_t>* l=(CDenseFeatures<float64_t>*) lhs;
+	CDenseFeatures<float64_t>* r=(CDenseFeatures<float64_t>*) rhs;
+	int32_t dim=l->get_num_features();
+	ASSERT(dim==r->get_num_features())
+
+	bool free_a, free_b;
+	float64_t* a=l->get_feature_block(lhs_start, num_lhs_block, free_a);
+	float64_t* b=r->get_feature_block(rhs_start, num_rhs_block, free_b);
+
+	SGVector<float64_t> sq_a(num_lhs_block);
+	for (int32_t i=0; i<num_lhs_block; i++)
+		sq_a[i]=SGVector<float64_t>::dot(&a[int64_t(i)*dim], &a[int64_t(i)*dim], dim);
+
+	SGVector<float64_t> sq_b(num_rhs_block);
+	for (int32_t j=0; j<num_rhs_block; j++)
+		sq_b[j]=SGVector<float64_t>::dot(&b[int64_t(j)*dim], &b[int64_t(j)*dim], dim);
+
+	/* block = -2 a^T b */
+	cblas_dgemm(CblasColMajor, CblasTrans, CblasNoTrans,
+			num_lhs_block, num_rhs_block, dim, -2.0, a, dim, b, dim,
+			0.0, block, num_lhs_block);
+
+	l->free_feature_block(a, free_a);
+	r->free_feature_block(b, free_b);
+
+	for (int32_t j=0; j<num_rhs_block; j++)
+	{
+		float64_t* col=&block[int64_t(j)*num_lhs_block];
+		for (int32_t i=0; i<num_lhs_block; i++)
+		{
+			/* cancellation may render the result slightly negative */
+			float64_t result=CMath::max(0.0, col[i]+sq_a[i]+sq_b[j]);
+			col[i]=disable_sqrt ? result : CMath::sqrt(result);
+		}
+	}
+#else
+	CRealDistance::compute_block(block, lhs_start, num_lhs_block, rhs_start,
+			num_rhs_block);
+#endif
+}
+
 void CEuclideanDistance::init()
 {
 	disable_sqrt=false;
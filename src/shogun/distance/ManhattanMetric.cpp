@@ -70,3 +70,50 @@ float64_t CManhattanMetric::compute(int32_t idx_a, int32_t idx_b)
 
 	return result;
 }
+
+bool CManhattanMetric::has_block_computation()
+{
+	return lhs && rhs &&
+		lhs->get_feature_class()==C_DENSE && lhs->get_feature_type()==F_DREAL &&
+		rhs->get_feature_class()==C_DENSE && rhs->get_feature_type()==F_DREAL;
+}
+
+void CManhattanMetric::compute_block(float64_t* block, int32_t lhs_start,
+		int32_t num_lhs_block, int32_t rhs_start, int32_t num_rhs_block)
+{
+	CDenseFeatures<float64_t>* l=(CDenseFeatures<float64_t>*) lhs;
+	CDenseFeatures<float64_t>* r=(CDenseFeatures<float64_t>*) rhs;
+	int32_t dim=l->get_num_features();
+	ASSERT(dim==r->get_num_features())
+
+	bool free_a, free_b;
+	float64_t* a=l->get_feature_block(lhs_start, num_lhs_block, free_a);
+	float64_t* b=r->get_feature_block(rhs_start, num_rhs_block, free_b);
+
+	for (int32_t j=0; j<num_rhs_block; j++)
+	{
+		const float64_t* bvec=&b[int64_t(j)*dim];
+		for (int32_t i=0; i<num_lhs_block; i++)
+		{
+			const float64_t* avec=&a[int64_t(i)*dim];
+
+			/* independent partial sums let the compiler vectorize */
+			float64_t r0=0, r1=0, r2=0, r3=0;
+			int32_t k=0;
+			for (; k+3<dim; k+=4)
+			{
+				r0+=fabs(avec[k]-bvec[k]);
+				r1+=fabs(avec[k+1]-bvec[k+1]);
+				r2+=fabs(avec[k+2]-bvec[k+2]);
+				r3+=fabs(avec[k+3]-bvec[k+3]);
+			}
+			for (; k<dim; k++)
+				r0+=fabs(avec[k]-bvec[k]);
+
+			block[i+int64_t(j)*num_lhs_block]=(r0+r1)+(r2+r3);
+		}
+	}
+
+	l->free_feature_block(a, free_a);
+	r->free_feature_block(b, free_b);
+}
@@ -15,11 +15,54 @@
 #include <shogun/base/Parameter.h>
 #include <shogun/base/ParameterMap.h>
 #include <shogun/mathematics/Statistics.h>
+#include <shogun/mathematics/Math.h>
 #include <shogun/evaluation/CrossValidationOutput.h>
 #include <shogun/lib/List.h>
+#include <shogun/base/Parallel.h>
 
 using namespace shogun;
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/** one fold of one run, evaluated concurrently */
+struct CROSSVALIDATION_FOLD
+{
+	/** indices of training vectors */
+	SGVector<index_t> train_indices;
+	/** indices of test vectors */
+	SGVector<index_t> test_indices;
+	/** predicted labels of the test vectors, if kept */
+	CLabels* result_labels;
+	/** evaluation result of this fold */
+	float64_t result;
+};
+
+/** copy of the machine and its data, used by one thread at a time */
+struct CROSSVALIDATION_COPY
+{
+	/** clone of the machine */
+	CMachine* machine;
+	/** labels of the clone */
+	CLabels* labels;
+	/** copy of the features */
+	CFeatures* features;
+	/** clone of the evaluation criterion */
+	CEvaluation* evaluation_criterion;
+};
+
+/** parameters of a thread evaluating folds */
+struct CROSSVALIDATION_THREAD_PARAM
+{
+	/** the cross-validation instance */
+	CCrossValidation* xval;
+	/** the folds */
+	CROSSVALIDATION_FOLD* folds;
+	/** one copy per fold if results are kept, one per thread otherwise */
+	CROSSVALIDATION_COPY* copies;
+	/** whether to keep trained machines and predictions */
+	bool keep_results;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 CCrossValidation::CCrossValidation() : CMachineEvaluation()
 {
 	init();
@@ -52,6 +95,13 @@ void CCrossValidation::init()
 {
 	m_num_runs=1;
 	m_conf_int_alpha=0;
+	m_parallel_folds=false;
+	m_abandon=false;
+	m_abandon_threshold=0;
+	m_abandon_bound=0;
+	m_abandoned=false;
+	m_num_evaluated_folds=0;
+	m_evaluated_folds_sum=0;
 
 	/* do reference counting for output objects */
 	m_xval_outputs=new CList(true);
@@ -63,6 +113,8 @@ void CCrossValidation::init()
 	SG_ADD((CSGObject**)&m_xval_outputs, "m_xval_outputs", "List of output "
 			"classes for intermediade cross-validation results",
 			MS_NOT_AVAILABLE);
+	SG_ADD(&m_parallel_folds, "parallel_folds", "Whether folds are "
+			"evaluated concurrently", MS_NOT_AVAILABLE);
 }
 
 CEvaluationResult* CCrossValidation::evaluate()
@@ -88,7 +140,43 @@ CEvaluationResult* CCrossValidation::evaluate()
 	/* set labels in any case (no locking needs this) */
 	m_machine->set_labels(m_labels);
 
-	if (m_autolock)
+	SGVector<float64_t> results(m_num_runs);
+
+	/* reset early abandoning state */
+	m_abandoned=false;
+	m_num_evaluated_folds=0;
+	m_evaluated_folds_sum=0;
+
+	/* evtl. update xvalidation output class */
+	CCrossValidationOutput* current=(CCrossValidationOutput*)
+			m_xval_outputs->get_first_element();
+	while (current)
+	{
+		current->init_num_runs(m_num_runs);
+		current->init_num_folds(m_splitting_strategy->get_num_subsets());
+		current->init_expose_labels(m_labels);
+		current->post_init();
+		SG_UNREF(current);
+		current=(CCrossValidationOutput*)
+				m_xval_outputs->get_next_element();
+	}
+
+	/* perform all the x-val runs concurrently if possible. Every fold
+	 * is trained on its own clone of the machine then, so the machine is
+	 * not autolocked for it */
+	bool done=false;
+	if (m_parallel_folds && can_evaluate_parallel())
+	{
+		SG_DEBUG("starting %d runs of cross-validation in parallel\n", m_num_runs)
+		done=evaluate_parallel(results);
+		if (!done)
+		{
+			SG_WARNING("%s could not be cloned, evaluating folds serially\n",
+					m_machine->get_name());
+		}
+	}
+
+	if (m_autolock && !done)
 	{
 		/* if machine supports locking try to do so */
 		if (m_machine->supports_locking())
@@ -108,26 +196,16 @@ CEvaluationResult* CCrossValidation::evaluate()
 		}
 	}
 
-	SGVector<float64_t> results(m_num_runs);
-
-	/* evtl. update xvalidation output class */
-	CCrossValidationOutput* current=(CCrossValidationOutput*)
-			m_xval_outputs->get_first_element();
-	while (current)
-	{
-		current->init_num_runs(m_num_runs);
-		current->init_num_folds(m_splitting_strategy->get_num_subsets());
-		current->init_expose_labels(m_labels);
-		current->post_init();
-		SG_UNREF(current);
-		current=(CCrossValidationOutput*)
-				m_xval_outputs->get_next_element();
-	}
-
-	/* perform all the x-val runs */
-	SG_DEBUG("starting %d runs of cross-validation\n", m_num_runs)
-	for (index_t i=0; i <m_num_runs; ++i)
+	if (!done)
+		SG_DEBUG("starting %d runs of cross-validation\n", m_num_runs)
+	for (index_t i=0; i <m_num_runs && !done; ++i)
 	{
+		/* remaining runs of an abandoned evaluation yield the bound */
+		if (m_abandoned)
+		{
+			results[i]=m_abandon_bound;
+			continue;
+		}
 
 		/* evtl. update xvalidation output class */
 		current=(CCrossValidationOutput*)m_xval_outputs->get_first_element();
@@ -191,6 +269,98 @@ void CCrossValidation::set_conf_int_alpha(float64_t conf_int_alpha)
 		m_conf_int_alpha=conf_int_alpha;
 }
 
+void CCrossValidation::set_parallel_folds(bool parallel_folds)
+{
+	m_parallel_folds=parallel_folds;
+}
+
+void CCrossValidation::set_abandon_threshold(float64_t threshold,
+		float64_t bound)
+{
+	m_abandon=true;
+	m_abandon_threshold=threshold;
+	m_abandon_bound=bound;
+}
+
+void CCrossValidation::unset_abandon_threshold()
+{
+	m_abandon=false;
+}
+
+bool CCrossValidation::check_abandon(float64_t fold_result)
+{
+	m_num_evaluated_folds++;
+	m_evaluated_folds_sum+=fold_result;
+
+	if (!m_abandon)
+		return false;
+
+	/* best mean that is still reachable with the remaining folds */
+	index_t num_folds=m_num_runs*m_splitting_strategy->get_num_subsets();
+	float64_t reachable=(m_evaluated_folds_sum+
+			(num_folds-m_num_evaluated_folds)*m_abandon_bound)/num_folds;
+
+	if (get_evaluation_direction()==ED_MAXIMIZE)
+		m_abandoned=reachable<m_abandon_threshold;
+	else
+		m_abandoned=reachable>m_abandon_threshold;
+
+	if (m_abandoned)
+	{
+		SG_DEBUG("abandoning evaluation after %d of %d folds, reachable "
+				"result %f does not beat %f\n", m_num_evaluated_folds,
+				num_folds, reachable, m_abandon_threshold)
+	}
+
+	return m_abandoned;
+}
+
+CCrossValidation* CCrossValidation::duplicate(CMachine* machine)
+{
+	REQUIRE(machine, "%s::duplicate(): No machine provided\n", get_name())
+
+	/* combined features cannot be duplicated and preprocessors are
+	 * shared by all copies of the features */
+	if (!m_features || m_features->get_feature_class()==C_COMBINED ||
+			m_features->get_num_preprocessors()>0)
+		return NULL;
+
+	CLabels* labels=(CLabels*) m_labels->clone();
+	CSplittingStrategy* splitting_strategy=(CSplittingStrategy*)
+			m_splitting_strategy->clone();
+	CEvaluation* evaluation_criterion=(CEvaluation*)
+			m_evaluation_criterion->clone();
+
+	CCrossValidation* xval=NULL;
+	if (labels && splitting_strategy && evaluation_criterion)
+	{
+		xval=new CCrossValidation(machine, m_features->duplicate(), labels,
+				splitting_strategy, evaluation_criterion, m_autolock);
+		xval->m_num_runs=m_num_runs;
+		xval->m_conf_int_alpha=m_conf_int_alpha;
+		xval->m_parallel_folds=m_parallel_folds;
+		xval->m_abandon=m_abandon;
+		xval->m_abandon_threshold=m_abandon_threshold;
+		xval->m_abandon_bound=m_abandon_bound;
+	}
+
+	SG_UNREF(labels);
+	SG_UNREF(splitting_strategy);
+	SG_UNREF(evaluation_criterion);
+
+	return xval;
+}
+
+bool CCrossValidation::lock_machine()
+{
+	if (!m_autolock || !m_machine->supports_locking() ||
+			m_machine->is_data_locked())
+		return false;
+
+	m_machine->data_lock(m_labels, m_features);
+	return true;
+}
+
 void CCrossValidation::set_num_runs(int32_t num_runs)
 {
 	if (num_runs <1)
@@ -284,6 +454,14 @@ float64_t CCrossValidation::evaluate_one_run()
 			SG_UNREF(result_labels);
 
 			SG_DEBUG("done locked evaluation\n", get_name())
+
+			/* skip remaining folds if they cannot beat the threshold */
+			if (check_abandon(results[i]))
+			{
+				for (index_t j=i+1; j<num_subsets; j++)
+					results[j]=m_abandon_bound;
+				break;
+			}
 		}
 	}
 	else
@@ -307,19 +485,11 @@ float64_t CCrossValidation::evaluate_one_run()
 						m_xval_outputs->get_next_element();
 			}
 
-			/* set feature subset for training */
+			/* index sets for training and testing */
 			SGVector<index_t> inverse_subset_indices=
 					m_splitting_strategy->generate_subset_inverse(i);
-			m_features->add_subset(inverse_subset_indices);
-			for (index_t p=0; p<m_features->get_num_preprocessors(); p++)
-			{
-				CPreprocessor* preprocessor = m_features->get_preprocessor(p);
-				preprocessor->init(m_features);
-				SG_UNREF(preprocessor);
-			}
-
-			/* set label subset for training */
-			m_labels->add_subset(inverse_subset_indices);
+			SGVector<index_t> subset_indices =
+					m_splitting_strategy->generate_subset_indices(i);
 
 			SG_DEBUG("training set %d:\n", i)
 			if (io->get_loglevel()==MSG_DEBUG)
@@ -328,33 +498,6 @@ float64_t CCrossValidation::evaluate_one_run()
 						inverse_subset_indices.vlen, "training indices");
 			}
 
-			/* train machine on training features and remove subset */
-			SG_DEBUG("starting training\n")
-			m_machine->train(m_features);
-			SG_DEBUG("finished training\n")
-
-			/* evtl. update xvalidation output class */
-			current=(CCrossValidationOutput*)m_xval_outputs->get_first_element();
-			while (current)
-			{
-				current->update_train_indices(inverse_subset_indices, "\t");
-				current->update_trained_machine(m_machine, "\t");
-				SG_UNREF(current);
-				current=(CCrossValidationOutput*)
-						m_xval_outputs->get_next_element();
-			}
-
-			m_features->remove_subset();
-			m_labels->remove_subset();
-
-			/* set feature subset for testing (subset method that stores pointer) */
-			SGVector<index_t> subset_indices =
-					m_splitting_strategy->generate_subset_indices(i);
-			m_features->add_subset(subset_indices);
-
-			/* set label subset for testing */
-			m_labels->add_subset(subset_indices);
-
 			SG_DEBUG("test set %d:\n", i)
 			if (io->get_loglevel()==MSG_DEBUG)
 			{
@@ -362,22 +505,20 @@ float64_t CCrossValidation::evaluate_one_run()
 						subset_indices.vlen, "test indices");
 			}
 
-			/* apply machine to test features and remove subset */
-			SG_DEBUG("starting evaluation\n")
-			SG_DEBUG("%p\n", m_features)
-			CLabels* result_labels=m_machine->apply(m_features);
-			SG_DEBUG("finished evaluation\n")
-			m_features->remove_subset();
-			SG_REF(result_labels);
-
-			/* evaluate */
-			results[i]=m_evaluation_criterion->evaluate(result_labels, m_labels);
+			/* train, apply and evaluate */
+			CLabels* result_labels=NULL;
+			results[i]=evaluate_fold(m_machine, m_features, m_labels,
+					m_evaluation_criterion, inverse_subset_indices,
+					subset_indices, result_labels);
 			SG_DEBUG("result on fold %d is %f\n", i, results[i])
 
 			/* evtl. update xvalidation output class */
+			m_labels->add_subset(subset_indices);
 			current=(CCrossValidationOutput*)m_xval_outputs->get_first_element();
 			while (current)
 			{
+				current->update_train_indices(inverse_subset_indices, "\t");
+				current->update_trained_machine(m_machine, "\t");
 				current->update_test_indices(subset_indices, "\t");
 				current->update_test_result(result_labels, "\t");
 				current->update_test_true_result(m_labels, "\t");
@@ -387,10 +528,18 @@ float64_t CCrossValidation::evaluate_one_run()
 				current=(CCrossValidationOutput*)
 						m_xval_outputs->get_next_element();
 			}
+			m_labels->remove_subset();
 
-			/* clean up, remove subsets */
+			/* clean up */
 			SG_UNREF(result_labels);
-			m_labels->remove_subset();
+
+			/* skip remaining folds if they cannot beat the threshold */
+			if (check_abandon(results[i]))
+			{
+				for (index_t j=i+1; j<num_subsets; j++)
+					results[j]=m_abandon_bound;
+				break;
+			}
 		}
 
 		SG_DEBUG("done unlocked evaluation\n", get_name())
@@ -408,3 +557,228 @@ void CCrossValidation::add_cross_validation_output(
 {
 	m_xval_outputs->append_element(cross_validation_output);
 }
+
+bool CCrossValidation::can_evaluate_parallel()
+{
+	if (parallel->get_num_threads()<2)
+		return false;
+
+	/* locked machines share precomputed data which is not cloned */
+	if (m_machine->is_data_locked())
+	{
+		SG_INFO("%s is locked, evaluating folds serially. Unlock it to "
+				"evaluate folds in parallel.\n",
+				m_machine->get_name());
+		return false;
+	}
+
+	/* combined features cannot be duplicated and preprocessors are
+	 * shared by all copies of the features */
+	if (m_features->get_feature_class()==C_COMBINED ||
+			m_features->get_num_preprocessors()>0)
+	{
+		SG_INFO("%s cannot be shared among folds, evaluating folds "
+				"serially.\n", m_features->get_name());
+		return false;
+	}
+
+	return true;
+}
+
+float64_t CCrossValidation::evaluate_fold(CMachine* machine,
+		CFeatures* features, CLabels* labels, CEvaluation* evaluation,
+		SGVector<index_t> train_indices, SGVector<index_t> test_indices,
+		CLabels*& result_labels)
+{
+	/* set feature and label subset for training */
+	features->add_subset(train_indices);
+	for (index_t p=0; p<features->get_num_preprocessors(); p++)
+	{
+		CPreprocessor* preprocessor = features->get_preprocessor(p);
+		preprocessor->init(features);
+		SG_UNREF(preprocessor);
+	}
+	labels->add_subset(train_indices);
+
+	/* train machine on training features and remove subset */
+	SG_DEBUG("starting training\n")
+	machine->train(features);
+	SG_DEBUG("finished training\n")
+	features->remove_subset();
+	labels->remove_subset();
+
+	/* apply machine to test features and evaluate */
+	features->add_subset(test_indices);
+	labels->add_subset(test_indices);
+	SG_DEBUG("starting evaluation\n")
+	result_labels=machine->apply(features);
+	SG_REF(result_labels);
+	SG_DEBUG("finished evaluation\n")
+	features->remove_subset();
+
+	float64_t result=evaluation->evaluate(result_labels, labels);
+	labels->remove_subset();
+
+	return result;
+}
+
+void CCrossValidation::evaluate_folds_helper(int32_t start, int32_t end,
+		int32_t thread, void* p)
+{
+	CROSSVALIDATION_THREAD_PARAM* params=(CROSSVALIDATION_THREAD_PARAM*) p;
+
+	for (int32_t i=start; i<end; i++)
+	{
+		CROSSVALIDATION_FOLD* fold=&params->folds[i];
+		CROSSVALIDATION_COPY* copy=
+				&params->copies[params->keep_results ? i : thread];
+
+		CLabels* result_labels=NULL;
+		fold->result=params->xval->evaluate_fold(copy->machine,
+				copy->features, copy->labels, copy->evaluation_criterion,
+				fold->train_indices, fold->test_indices, result_labels);
+
+		if (params->keep_results)
+			fold->result_labels=result_labels;
+		else
+			SG_UNREF(result_labels);
+	}
+}
+
+/** unrefs all members of a copy */
+static void free_copy(CROSSVALIDATION_COPY* copy)
+{
+	SG_UNREF(copy->machine);
+	SG_UNREF(copy->labels);
+	SG_UNREF(copy->features);
+	SG_UNREF(copy->evaluation_criterion);
+}
+
+bool CCrossValidation::evaluate_parallel(SGVector<float64_t> results)
+{
+	SG_DEBUG("entering %s::evaluate_parallel()\n", get_name())
+
+	index_t num_subsets=m_splitting_strategy->get_num_subsets();
+	int32_t num_folds=m_num_runs*num_subsets;
+	bool keep_results=m_xval_outputs->get_num_elements()>0;
+
+	/* copies of the machine (with its own labels and e.g. kernel), the
+	 * features (sharing the data but with their own subset stack) and the
+	 * evaluation criterion. All are made before starting any threads, so
+	 * that nothing is evaluated if one of them fails. Trained machines
+	 * are kept for the output listeners, so every fold needs its own copy
+	 * then */
+	int32_t num_copies=keep_results ? num_folds :
+			CMath::min(parallel->get_num_threads(), num_folds);
+	CROSSVALIDATION_COPY* copies=SG_CALLOC(CROSSVALIDATION_COPY, num_copies);
+
+	bool ok=true;
+	for (int32_t i=0; i<num_copies && ok; i++)
+	{
+		CROSSVALIDATION_COPY* copy=&copies[i];
+		copy->machine=(CMachine*) m_machine->clone();
+		copy->labels=copy->machine ? copy->machine->get_labels() : NULL;
+		copy->features=m_features->duplicate();
+		SG_REF(copy->features);
+		copy->evaluation_criterion=(CEvaluation*)
+				m_evaluation_criterion->clone();
+
+		ok=copy->machine && copy->labels && copy->features &&
+				copy->evaluation_criterion;
+		if (ok)
+			copy->machine->set_store_model_features(true);
+	}
+
+	if (!ok)
+	{
+		for (int32_t i=0; i<num_copies; i++)
+			free_copy(&copies[i]);
+		SG_FREE(copies);
+
+		SG_DEBUG("leaving %s::evaluate_parallel(), cloning failed\n",
+				get_name())
+		return false;
+	}
+
+	/* build index sets of all runs upfront, in the order of the serial
+	 * evaluation */
+	CROSSVALIDATION_FOLD* folds=new CROSSVALIDATION_FOLD[num_folds];
+	for (index_t run=0; run<m_num_runs; run++)
+	{
+		m_splitting_strategy->build_subsets();
+		for (index_t i=0; i<num_subsets; i++)
+		{
+			CROSSVALIDATION_FOLD* fold=&folds[run*num_subsets+i];
+			fold->train_indices=m_splitting_strategy->generate_subset_inverse(i);
+			fold->test_indices=m_splitting_strategy->generate_subset_indices(i);
+			fold->result_labels=NULL;
+			fold->result=0;
+		}
+	}
+
+	CROSSVALIDATION_THREAD_PARAM params;
+	params.xval=this;
+	params.folds=folds;
+	params.copies=copies;
+	params.keep_results=keep_results;
+
+	parallel->parallel_for(0, num_folds, evaluate_folds_helper, &params, 1);
+
+	/* pass results to output listeners in serial order and average */
+	for (index_t run=0; run<m_num_runs; run++)
+	{
+		CCrossValidationOutput* current=(CCrossValidationOutput*)
+				m_xval_outputs->get_first_element();
+		while (current)
+		{
+			current->update_run_index(run);
+			SG_UNREF(current);
+			current=(CCrossValidationOutput*)
+					m_xval_outputs->get_next_element();
+		}
+
+		SGVector<float64_t> fold_results(num_subsets);
+		for (index_t i=0; i<num_subsets; i++)
+		{
+			CROSSVALIDATION_FOLD* fold=&folds[run*num_subsets+i];
+			fold_results[i]=fold->result;
+			SG_DEBUG("result on fold %d of run %d is %f\n", i, run, fold->result)
+
+			if (!params.keep_results)
+				continue;
+
+			m_labels->add_subset(fold->test_indices);
+
+			current=(CCrossValidationOutput*)m_xval_outputs->get_first_element();
+			while (current)
+			{
+				current->update_fold_index(i);
+				current->update_train_indices(fold->train_indices, "\t");
+				current->update_trained_machine(
+						copies[run*num_subsets+i].machine, "\t");
+				current->update_test_indices(fold->test_indices, "\t");
+				current->update_test_result(fold->result_labels, "\t");
+				current->update_test_true_result(m_labels, "\t");
+				current->post_update_results();
+				current->update_evaluation_result(fold->result, "\t");
+				SG_UNREF(current);
+				current=(CCrossValidationOutput*)
+						m_xval_outputs->get_next_element();
+			}
+
+			m_labels->remove_subset();
+			SG_UNREF(fold->result_labels);
+		}
+
+		results[run]=CStatistics::mean(fold_results);
+		SG_DEBUG("result of cross-validation run %d is %f\n", run, results[run])
+	}
+
+	delete[] folds;
+	for (int32_t i=0; i<num_copies; i++)
+		free_copy(&copies[i]);
+	SG_FREE(copies);
+
+	SG_DEBUG("leaving %s::evaluate_parallel()\n", get_name())
+	return true;
+}
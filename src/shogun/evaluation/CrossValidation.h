@@ -133,6 +133,11 @@ class CCrossValidationResult : public CEvaluationResult
  * speed up computations. Can be turned off by the set_autolock()  method.
  * Locking in general may speed up things (eg for kernel machines the kernel
  * matrix is precomputed), however, it is not always supported.
+ *
+ * Folds and runs can be evaluated concurrently, see set_parallel_folds().
+ * Every fold is then trained on its own clone of the machine (see
+ * CSGObject::clone()) and the results are passed to the cross-validation
+ * output listeners in the same order as in the serial case.
  */
 class CCrossValidation: public CMachineEvaluation
 {
@@ -172,6 +177,64 @@ public:
 	/** setter for the number of runs to use for evaluation */
 	void set_conf_int_alpha(float64_t m_conf_int_alpha);
 
+	/** setter for whether folds and runs are evaluated concurrently, using
+	 * as many threads as set in the parallel object. Each fold is trained
+	 * and applied on a clone of the machine, so autolocking is only done
+	 * if the folds end up being evaluated serially. Falls back to serial
+	 * evaluation if the machine is locked already or cannot be cloned, or
+	 * if the features are combined or have preprocessors (which are
+	 * shared among all folds). The attached machine itself is not trained
+	 * in this case.
+	 *
+	 * @param parallel_folds whether to evaluate folds concurrently
+	 */
+	void set_parallel_folds(bool parallel_folds);
+
+	/** @return whether folds and runs are evaluated concurrently */
+	bool get_parallel_folds() const { return m_parallel_folds; }
+
+	/** setter for early abandoning, as useful in model selection where
+	 * only results that beat the best one so far are of interest. After
+	 * every fold, the mean that is still reachable is computed by assuming
+	 * that all remaining folds yield the given bound. Once this is worse
+	 * than the threshold (w.r.t. the evaluation direction), the remaining
+	 * folds are skipped and the reachable mean is returned instead.
+	 * Abandoning only applies to serial evaluation of folds.
+	 *
+	 * @param threshold mean that has to be beaten
+	 * @param bound best possible result of a single fold, e.g. 1 for
+	 * accuracy or 0 for an error rate
+	 */
+	void set_abandon_threshold(float64_t threshold, float64_t bound);
+
+	/** switch early abandoning off again */
+	void unset_abandon_threshold();
+
+	/** @return whether the last evaluation was abandoned early */
+	bool is_abandoned() const { return m_abandoned; }
+
+	/** creates a cross-validation of another machine (e.g. a clone of the
+	 * attached one) that can be evaluated concurrently with this instance:
+	 * features are duplicated, labels, splitting strategy and evaluation
+	 * criterion are cloned. Number of runs, confidence interval, autolock
+	 * and abandoning settings are copied, output listeners are not.
+	 *
+	 * @param machine machine to evaluate
+	 * @return new cross-validation instance or NULL if the features cannot
+	 * be shared (combined features or preprocessors) or cloning failed
+	 */
+	CCrossValidation* duplicate(CMachine* machine);
+
+	/** locks the machine to the features and labels of this instance, if
+	 * autolocking is enabled and the machine supports locking. Unlike the
+	 * locking done in evaluate(), the machine stays locked afterwards, such
+	 * that precomputed data (e.g. a kernel matrix) is reused by subsequent
+	 * evaluations until the machine is unlocked again.
+	 *
+	 * @return whether the machine was locked by this call
+	 */
+	bool lock_machine();
+
 	/** evaluate */
 	virtual CEvaluationResult* evaluate();
 
@@ -203,6 +266,58 @@ protected:
 	 */
 	virtual float64_t evaluate_one_run();
 
+	/** Evaluates all runs, training and applying every fold of every run
+	 * concurrently on its own clone of the machine
+	 *
+	 * @param results vector of length number of runs the arithmetic mean
+	 * of the fold results of each run is written to
+	 * @return false if the machine could not be cloned, in which case
+	 * nothing was evaluated
+	 */
+	virtual bool evaluate_parallel(SGVector<float64_t> results);
+
+	/** @return whether the current setup allows to evaluate folds
+	 * concurrently */
+	bool can_evaluate_parallel();
+
+	/** Trains a machine on the training subset of one fold, applies it to
+	 * the test subset and evaluates the result. Used for the unlocked
+	 * serial evaluation and by the threads of evaluate_parallel(). No
+	 * subsets are left on features and labels.
+	 *
+	 * @param machine machine to train, its labels have to be labels
+	 * @param features features to train and apply on
+	 * @param labels labels to train and evaluate with
+	 * @param evaluation evaluation criterion
+	 * @param train_indices indices of the training vectors
+	 * @param test_indices indices of the test vectors
+	 * @param result_labels output of the machine on the test vectors
+	 * (referenced)
+	 * @return evaluation result of the fold
+	 */
+	float64_t evaluate_fold(CMachine* machine, CFeatures* features,
+			CLabels* labels, CEvaluation* evaluation,
+			SGVector<index_t> train_indices, SGVector<index_t> test_indices,
+			CLabels*& result_labels);
+
+	/** helper to train and apply a range of folds in a thread
+	 *
+	 * @param start first fold
+	 * @param end one past the last fold
+	 * @param thread index of the executing thread
+	 * @param p pointer to the thread parameters
+	 */
+	static void evaluate_folds_helper(int32_t start, int32_t end,
+			int32_t thread, void* p);
+
+	/** accounts the result of a serially evaluated fold for early
+	 * abandoning
+	 *
+	 * @param fold_result result of the fold
+	 * @return whether the remaining folds should be skipped
+	 */
+	bool check_abandon(float64_t fold_result);
+
 	/** number of evaluation runs for one fold */
 	int32_t m_num_runs;
 	/** confidence interval alpha parameter */
@@ -210,6 +325,22 @@ protected:
 
 	/** xval output listeners */
 	CList* m_xval_outputs;
+
+	/** whether folds and runs are evaluated concurrently */
+	bool m_parallel_folds;
+
+	/** whether evaluation is abandoned early */
+	bool m_abandon;
+	/** mean that has to be beaten to not abandon evaluation */
+	float64_t m_abandon_threshold;
+	/** best possible result of a single fold */
+	float64_t m_abandon_bound;
+	/** whether the last evaluation was abandoned */
+	bool m_abandoned;
+	/** number of folds evaluated in the current evaluation */
+	index_t m_num_evaluated_folds;
+	/** sum of the results of these folds */
+	float64_t m_evaluated_folds_sum;
 };
 
 }
@@ -13,6 +13,7 @@
 
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
+#include <shogun/preprocessor/DensePreprocessorPipeline.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/base/Parameter.h>
 #include <shogun/mathematics/Math.h>
@@ -69,6 +70,12 @@ template<class ST> CFeatures* CDenseFeatures<ST>::duplicate() const
 template<class ST> CDenseFeatures<ST>::~CDenseFeatures()
 {
 	free_features();
+
+	/* no reader can hold a pipeline anymore */
+	CDensePreprocessorPipeline<ST>* pipeline = m_preprocessor_pipeline;
+	m_preprocessor_pipeline = NULL;
+	SG_UNREF(pipeline);
+	SG_UNREF(m_retired_pipelines);
 }
 
 template<class ST> void CDenseFeatures<ST>::free_features()
@@ -112,41 +119,100 @@ template<class ST> ST* CDenseFeatures<ST>::get_feature_vector(int32_t num, int32
 			feat = feature_cache->set_entry(real_num);
 	}
 
+	int32_t capacity = num_features;
 	if (!feat)
 		dofree = true;
 	feat = compute_feature_vector(num, len, feat);
+	if (dofree)
+		capacity = len;
 
 	if (get_num_preprocessors())
 	{
-		int32_t tmp_len = len;
-		ST* tmp_feat_before = feat;
-		ST* tmp_feat_after = NULL;
+		CDensePreprocessorPipeline<ST>* pipeline = ensure_preprocessor_pipeline();
+		int32_t tmp_len = pipeline->apply_to_feature_vector(feat, len, capacity);
 
-		for (int32_t i = 0; i < get_num_preprocessors(); i++)
+		if (tmp_len < 0)
 		{
-			CDensePreprocessor<ST>* p =
-					(CDensePreprocessor<ST>*) get_preprocessor(i);
-			// temporary hack
-			SGVector<ST> applied = p->apply_to_feature_vector(
-					SGVector<ST>(tmp_feat_before, tmp_len));
-			tmp_feat_after = applied.vector;
-			SG_UNREF(p);
-
-			if (i != 0) // delete feature vector, except for the the first one, i.e., feat
-				SG_FREE(tmp_feat_before);
-			tmp_feat_before = tmp_feat_after;
+			SG_ERROR("%s::get_feature_vector(): Preprocessed vector %d does not "
+					"fit into %d elements\n", get_name(), num, capacity);
 		}
 
-		// note: tmp_feat_after should be checked as it is used by memcpy
-		if (tmp_feat_after)
-		{
-			memcpy(feat, tmp_feat_after, sizeof(ST) * tmp_len);
-			SG_FREE(tmp_feat_after);
+		len = tmp_len;
+	}
+	return feat;
+}
+
+template<class ST> CDensePreprocessorPipeline<ST>* CDenseFeatures<ST>::get_preprocessor_pipeline()
+{
+	CDensePreprocessorPipeline<ST>* pipeline = ensure_preprocessor_pipeline();
+	SG_REF(pipeline);
+	return pipeline;
+}
+
+template<class ST> CDensePreprocessorPipeline<ST>* CDenseFeatures<ST>::ensure_preprocessor_pipeline()
+{
+#if defined(HAVE_CXX11_ATOMIC)
+	CDensePreprocessorPipeline<ST>* pipeline =
+			m_preprocessor_pipeline.load(std::memory_order_acquire);
+#else
+	CDensePreprocessorPipeline<ST>* pipeline = m_preprocessor_pipeline;
+	__sync_synchronize();
+#endif
+
+	if (pipeline)
+		return pipeline;
+
+	m_pipeline_lock.lock();
+	pipeline = m_preprocessor_pipeline;
+	if (!pipeline)
+	{
+		pipeline = new CDensePreprocessorPipeline<ST>();
+		pipeline->compile(this, 0, get_num_preprocessors());
+		SG_REF(pipeline);
+
+#if defined(HAVE_CXX11_ATOMIC)
+		m_preprocessor_pipeline.store(pipeline, std::memory_order_release);
+#else
+		__sync_synchronize();
+		m_preprocessor_pipeline = pipeline;
+#endif
+	}
+	m_pipeline_lock.unlock();
+
+	return pipeline;
+}
 
-			len = tmp_len;
+template<class ST> void CDenseFeatures<ST>::invalidate_preprocessor_pipeline()
+{
+	m_pipeline_lock.lock();
+	CDensePreprocessorPipeline<ST>* pipeline = m_preprocessor_pipeline;
+	m_preprocessor_pipeline = NULL;
+
+	/* readers use the pipeline without referencing it, so it is kept
+	 * until the features are destroyed */
+	if (pipeline)
+	{
+		if (!m_retired_pipelines)
+		{
+			m_retired_pipelines = new CDynamicObjectArray();
+			SG_REF(m_retired_pipelines);
 		}
+		m_retired_pipelines->append_element(pipeline);
+		SG_UNREF(pipeline);
 	}
-	return feat;
+	m_pipeline_lock.unlock();
+}
+
+template<class ST> void CDenseFeatures<ST>::add_preprocessor(CPreprocessor* p)
+{
+	CDotFeatures::add_preprocessor(p);
+	invalidate_preprocessor_pipeline();
+}
+
+template<class ST> void CDenseFeatures<ST>::del_preprocessor(int32_t num)
+{
+	CDotFeatures::del_preprocessor(num);
+	invalidate_preprocessor_pipeline();
 }
 
 template<class ST> void CDenseFeatures<ST>::set_feature_vector(SGVector<ST> vector, int32_t num)
@@ -203,6 +269,44 @@ template<class ST> void CDenseFeatures<ST>::free_feature_vector(SGVector<ST> vec
 	vec=SGVector<ST>();
 }
 
+template<class ST> ST* CDenseFeatures<ST>::get_feature_block(int32_t start,
+		int32_t num, bool& dofree)
+{
+	dofree=false;
+
+	if (feature_matrix.matrix)
+	{
+		int32_t first=m_subset_stack->subset_idx_conversion(start);
+
+		bool contiguous=true;
+		for (int32_t i=1; i<num && contiguous; i++)
+			contiguous=m_subset_stack->subset_idx_conversion(start+i)==first+i;
+
+		if (contiguous)
+			return &feature_matrix.matrix[first*int64_t(num_features)];
+	}
+
+	ST* block=SG_MALLOC(ST, int64_t(num)*num_features);
+	for (int32_t i=0; i<num; i++)
+	{
+		int32_t len;
+		bool vfree;
+		ST* vec=get_feature_vector(start+i, len, vfree);
+		memcpy(&block[int64_t(i)*num_features], vec, sizeof(ST)*num_features);
+		free_feature_vector(vec, start+i, vfree);
+	}
+
+	dofree=true;
+	return block;
+}
+
+template<class ST> void CDenseFeatures<ST>::free_feature_block(ST* block,
+		bool dofree)
+{
+	if (dofree)
+		SG_FREE(block);
+}
+
 template<class ST> void CDenseFeatures<ST>::vector_subset(int32_t* idx, int32_t idx_len)
 {
 	if (m_subset_stack->has_subsets())
@@ -389,6 +493,51 @@ template<class ST> bool CDenseFeatures<ST>::apply_preprocessor(bool force_prepro
 		{
 			if ((!is_preprocessed(i) || force_preprocessing))
 			{
+				/* runs of preprocessors working in place are applied
+				 * together, vector by vector */
+				int32_t last = i;
+				while (last < get_num_preprocessors() &&
+						(!is_preprocessed(last) || force_preprocessing))
+				{
+					CDensePreprocessor<ST>* p =
+							(CDensePreprocessor<ST>*) get_preprocessor(last);
+					bool inplace = p->supports_inplace();
+					SG_UNREF(p);
+
+					if (!inplace)
+						break;
+					last++;
+				}
+
+				if (last > i)
+				{
+					CDensePreprocessorPipeline<ST>* pipeline =
+							new CDensePreprocessorPipeline<ST>();
+					SG_REF(pipeline);
+					pipeline->compile(this, i, last);
+					SG_INFO("preprocessing using %d preprocs in %d steps\n",
+							last - i, pipeline->get_num_steps())
+
+					int32_t num_feat = pipeline->apply_to_feature_matrix(
+							feature_matrix.matrix, num_features, num_vectors);
+					SG_UNREF(pipeline);
+
+					if (num_feat < 0)
+						return false;
+
+					for (int32_t j = i; j < last; j++)
+						set_preprocessed(j);
+
+					if (num_feat != num_features)
+					{
+						feature_matrix.num_rows = num_feat;
+						set_num_features(num_feat);
+					}
+
+					i = last - 1;
+					continue;
+				}
+
 				set_preprocessed(i);
 				CDensePreprocessor<ST>* p =
 						(CDensePreprocessor<ST>*) get_preprocessor(i);
@@ -621,6 +770,8 @@ template<class ST> void CDenseFeatures<ST>::init()
 
 	feature_matrix = SGMatrix<ST>();
 	feature_cache = NULL;
+	m_preprocessor_pipeline = NULL;
+	m_retired_pipelines = NULL;
 
 	set_generic<ST>();
 
@@ -16,15 +16,21 @@
 
 #include <shogun/lib/common.h>
 #include <shogun/lib/Cache.h>
+#include <shogun/lib/Lock.h>
 #include <shogun/io/File.h>
 #include <shogun/features/DotFeatures.h>
 #include <shogun/features/StringFeatures.h>
 #include <shogun/lib/DataType.h>
 
+#if defined(HAVE_CXX11_ATOMIC) && !defined(SWIG)
+#include <atomic>
+#endif
+
 namespace shogun {
 template<class ST> class CStringFeatures;
 template<class ST> class CDenseFeatures;
 template<class ST> class SGMatrix;
+template<class ST> class CDensePreprocessorPipeline;
 class CDotFeatures;
 
 /** @brief The class DenseFeatures implements dense feature matrices.
@@ -164,6 +170,31 @@ public:
 	 */
 	void free_feature_vector(SGVector<ST> vec, int32_t num);
 
+	/** get the feature vectors [start, start+num) as one contiguous column
+	 * major num_features x num matrix
+	 *
+	 * possible with subset
+	 *
+	 * If the vectors are stored contiguously in the feature matrix a
+	 * pointer into it is returned, otherwise (subsets that are not a
+	 * contiguous range, feature caches, computed features) the vectors are
+	 * copied to a newly allocated buffer.
+	 *
+	 * @param start index of first feature vector
+	 * @param num number of feature vectors
+	 * @param dofree whether returned block must be freed by
+	 * caller via free_feature_block
+	 * @return block of feature vectors
+	 */
+	ST* get_feature_block(int32_t start, int32_t num, bool& dofree);
+
+	/** free block of feature vectors obtained via get_feature_block
+	 *
+	 * @param block block to free
+	 * @param dofree if block should be really deleted
+	 */
+	void free_feature_block(ST* block, bool dofree);
+
 	/**
 	 * Extracts the feature vectors mentioned in idx and replaces them in
 	 * feature matrix in place.
@@ -499,6 +530,20 @@ public:
 	 */
 	static CDenseFeatures* obtain_from_generic(CFeatures* const base_features);
 
+	/** add preprocessor, the pipeline for preprocessing on the fly is
+	 * recompiled on the next access
+	 *
+	 * @param p preprocessor to set
+	 */
+	virtual void add_preprocessor(CPreprocessor* p);
+
+	/** delete preprocessor from list, the pipeline for preprocessing on
+	 * the fly is recompiled on the next access
+	 *
+	 * @param num index of preprocessor in list
+	 */
+	virtual void del_preprocessor(int32_t num);
+
 	/** @return object name */
 	virtual const char* get_name() const { return "DenseFeatures"; }
 
@@ -517,9 +562,24 @@ protected:
 	virtual ST* compute_feature_vector(int32_t num, int32_t& len,
 			ST* target = NULL);
 
+	/** get the pipeline of all preprocessors for preprocessing vectors on
+	 * the fly, it is recompiled when preprocessors were added or deleted
+	 *
+	 * @return pipeline (referenced)
+	 */
+	CDensePreprocessorPipeline<ST>* get_preprocessor_pipeline();
+
 private:
 	void init();
 
+	/** @return the pipeline, compiled if necessary (not referenced). Once
+	 * compiled, it is read without locking, it stays valid until the
+	 * features are destroyed */
+	CDensePreprocessorPipeline<ST>* ensure_preprocessor_pipeline();
+
+	/** retire the pipeline, it is recompiled on the next access */
+	void invalidate_preprocessor_pipeline();
+
 protected:
 	/// number of vectors in cache
 	int32_t num_vectors;
@@ -535,6 +595,21 @@ protected:
 
 	/** feature cache */
 	CCache<ST>* feature_cache;
+
+	/** compiled preprocessors for preprocessing on the fly, NULL if it has
+	 * to be compiled */
+#if defined(HAVE_CXX11_ATOMIC) && !defined(SWIG)
+	std::atomic<CDensePreprocessorPipeline<ST>*> m_preprocessor_pipeline;
+#else
+	CDensePreprocessorPipeline<ST>* volatile m_preprocessor_pipeline;
+#endif
+
+	/** pipelines replaced since construction, kept alive because readers
+	 * on other threads may still use them */
+	CDynamicObjectArray* m_retired_pipelines;
+
+	/** lock for compiling and retiring the pipeline */
+	CLock m_pipeline_lock;
 };
 }
 #endif // _DENSEFEATURES__H__
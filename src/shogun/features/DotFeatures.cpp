@@ -16,10 +16,6 @@
 #include <shogun/base/Parallel.h>
 #include <shogun/base/Parameter.h>
 
-#ifdef HAVE_PTHREAD
-#include <pthread.h>
-#endif
-
 using namespace shogun;
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -36,6 +32,15 @@ struct DF_THREAD_PARAM
 	float64_t bias;
 	bool progress;
 };
+
+struct DF_ADD_THREAD_PARAM
+{
+	CDotFeatures* df;
+	int32_t* sub_index;
+	float64_t* alphas;
+	float64_t* buffers;
+	int32_t dim;
+};
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
 
@@ -77,72 +82,22 @@ void CDotFeatures::dense_dot_range(float64_t* output, int32_t start, int32_t sto
 	int32_t num_vectors=stop-start;
 	ASSERT(num_vectors>0)
 
-	int32_t num_threads=parallel->get_num_threads();
-	ASSERT(num_threads>0)
-
 	CSignal::clear_cancel();
 
-#ifdef HAVE_PTHREAD
-	if (num_threads < 2)
-	{
-#endif
-		DF_THREAD_PARAM params;
-		params.df=this;
-		params.sub_index=NULL;
-		params.output=output;
-		params.start=start;
-		params.stop=stop;
-		params.alphas=alphas;
-		params.vec=vec;
-		params.dim=dim;
-		params.bias=b;
-		params.progress=false; //true;
-		dense_dot_range_helper((void*) &params);
-#ifdef HAVE_PTHREAD
-	}
-	else
-	{
-		pthread_t* threads = SG_MALLOC(pthread_t, num_threads-1);
-		DF_THREAD_PARAM* params = SG_MALLOC(DF_THREAD_PARAM, num_threads);
-		int32_t step= num_vectors/num_threads;
-
-		int32_t t;
-
-		for (t=0; t<num_threads-1; t++)
-		{
-			params[t].df = this;
-			params[t].sub_index=NULL;
-			params[t].output = output;
-			params[t].start = start+t*step;
-			params[t].stop = start+(t+1)*step;
-			params[t].alphas=alphas;
-			params[t].vec=vec;
-			params[t].dim=dim;
-			params[t].bias=b;
-			params[t].progress = false;
-			pthread_create(&threads[t], NULL,
-					CDotFeatures::dense_dot_range_helper, (void*)&params[t]);
-		}
-
-		params[t].df = this;
-		params[t].output = output;
-		params[t].sub_index=NULL;
-		params[t].start = start+t*step;
-		params[t].stop = stop;
-		params[t].alphas=alphas;
-		params[t].vec=vec;
-		params[t].dim=dim;
-		params[t].bias=b;
-		params[t].progress = false; //true;
-		dense_dot_range_helper((void*) &params[t]);
-
-		for (t=0; t<num_threads-1; t++)
-			pthread_join(threads[t], NULL);
-
-		SG_FREE(params);
-		SG_FREE(threads);
-	}
-#endif
+	/* runs serially if only one thread is used */
+	DF_THREAD_PARAM params;
+	params.df=this;
+	params.sub_index=NULL;
+	params.output=output;
+	params.start=start;
+	params.stop=stop;
+	params.alphas=alphas;
+	params.vec=vec;
+	params.dim=dim;
+	params.bias=b;
+	params.progress=false;
+	parallel->parallel_for(start, stop,
+			CDotFeatures::dense_dot_range_range_helper, (void*) &params);
 
 #ifndef WIN32
 		if ( CSignal::cancel_computations() )
@@ -155,72 +110,22 @@ void CDotFeatures::dense_dot_range_subset(int32_t* sub_index, int32_t num, float
 	ASSERT(sub_index)
 	ASSERT(output)
 
-	int32_t num_threads=parallel->get_num_threads();
-	ASSERT(num_threads>0)
-
 	CSignal::clear_cancel();
 
-#ifdef HAVE_PTHREAD
-	if (num_threads < 2)
-	{
-#endif
-		DF_THREAD_PARAM params;
-		params.df=this;
-		params.sub_index=sub_index;
-		params.output=output;
-		params.start=0;
-		params.stop=num;
-		params.alphas=alphas;
-		params.vec=vec;
-		params.dim=dim;
-		params.bias=b;
-		params.progress=false; //true;
-		dense_dot_range_helper((void*) &params);
-#ifdef HAVE_PTHREAD
-	}
-	else
-	{
-		pthread_t* threads = SG_MALLOC(pthread_t, num_threads-1);
-		DF_THREAD_PARAM* params = SG_MALLOC(DF_THREAD_PARAM, num_threads);
-		int32_t step= num/num_threads;
-
-		int32_t t;
-
-		for (t=0; t<num_threads-1; t++)
-		{
-			params[t].df = this;
-			params[t].sub_index=sub_index;
-			params[t].output = output;
-			params[t].start = t*step;
-			params[t].stop = (t+1)*step;
-			params[t].alphas=alphas;
-			params[t].vec=vec;
-			params[t].dim=dim;
-			params[t].bias=b;
-			params[t].progress = false;
-			pthread_create(&threads[t], NULL,
-					CDotFeatures::dense_dot_range_helper, (void*)&params[t]);
-		}
-
-		params[t].df = this;
-		params[t].sub_index=sub_index;
-		params[t].output = output;
-		params[t].start = t*step;
-		params[t].stop = num;
-		params[t].alphas=alphas;
-		params[t].vec=vec;
-		params[t].dim=dim;
-		params[t].bias=b;
-		params[t].progress = false; //true;
-		dense_dot_range_helper((void*) &params[t]);
-
-		for (t=0; t<num_threads-1; t++)
-			pthread_join(threads[t], NULL);
-
-		SG_FREE(params);
-		SG_FREE(threads);
-	}
-#endif
+	/* runs serially if only one thread is used */
+	DF_THREAD_PARAM params;
+	params.df=this;
+	params.sub_index=sub_index;
+	params.output=output;
+	params.start=0;
+	params.stop=num;
+	params.alphas=alphas;
+	params.vec=vec;
+	params.dim=dim;
+	params.bias=b;
+	params.progress=false;
+	parallel->parallel_for(0, num,
+			CDotFeatures::dense_dot_range_range_helper, (void*) &params);
 
 #ifndef WIN32
 		if ( CSignal::cancel_computations() )
@@ -281,6 +186,75 @@ void* CDotFeatures::dense_dot_range_helper(void* p)
 	return NULL;
 }
 
+void CDotFeatures::dense_dot_range_range_helper(int32_t start, int32_t stop,
+		int32_t thread, void* p)
+{
+	DF_THREAD_PARAM params=*((DF_THREAD_PARAM*) p);
+	params.start=start;
+	params.stop=stop;
+	dense_dot_range_helper((void*) &params);
+}
+
+void CDotFeatures::add_to_dense_vec_range(float64_t* alphas,
+		int32_t* sub_index, int32_t num, float64_t* vec, int32_t dim)
+{
+	ASSERT(alphas)
+	ASSERT(vec)
+	ASSERT(num>=0)
+
+	int32_t num_threads=parallel->get_num_threads();
+	ASSERT(num_threads>0)
+
+#ifdef HAVE_PTHREAD
+	/* every thread accumulates into its own buffer of length dim, which
+	 * only pays off if there are considerably more vectors than threads */
+	if (num_threads>1 && num>=4*num_threads)
+	{
+		DF_ADD_THREAD_PARAM params;
+		params.df=this;
+		params.sub_index=sub_index;
+		params.alphas=alphas;
+		params.buffers=SG_CALLOC(float64_t, int64_t(num_threads)*dim);
+		params.dim=dim;
+		parallel->parallel_for(0, num,
+				CDotFeatures::add_to_dense_vec_range_helper, (void*) &params);
+
+		for (int32_t t=0; t<num_threads; t++)
+		{
+			float64_t* buffer=&params.buffers[int64_t(t)*dim];
+			for (int32_t j=0; j<dim; j++)
+				vec[j]+=buffer[j];
+		}
+
+		SG_FREE(params.buffers);
+		return;
+	}
+#endif
+
+	for (int32_t i=0; i<num; i++)
+	{
+		if (alphas[i]!=0)
+			add_to_dense_vec(alphas[i], sub_index ? sub_index[i] : i, vec, dim);
+	}
+}
+
+void CDotFeatures::add_to_dense_vec_range_helper(int32_t start, int32_t stop,
+		int32_t thread, void* p)
+{
+	DF_ADD_THREAD_PARAM* params=(DF_ADD_THREAD_PARAM*) p;
+	CDotFeatures* df=params->df;
+	int32_t* sub_index=params->sub_index;
+	float64_t* alphas=params->alphas;
+	int32_t dim=params->dim;
+	float64_t* buffer=&params->buffers[int64_t(thread)*dim];
+
+	for (int32_t i=start; i<stop; i++)
+	{
+		if (alphas[i]!=0)
+			df->add_to_dense_vec(alphas[i], sub_index ? sub_index[i] : i, buffer, dim);
+	}
+}
+
 SGMatrix<float64_t> CDotFeatures::get_computed_dot_feature_matrix()
 {
 
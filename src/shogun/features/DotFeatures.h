@@ -131,10 +131,40 @@ class CDotFeatures : public CFeatures
 		virtual void dense_dot_range_subset(int32_t* sub_index, int32_t num,
 				float64_t* output, float64_t* alphas, float64_t* vec, int32_t dim, float64_t b);
 
+		/** Add a weighted sum of vectors to a dense vector, i.e. compute the
+		 * transposed product
+		 * vec += \sum_i alphas[i] * sparse[sub_index[i]]
+		 *
+		 * Blocks of vectors are accumulated in parallel into one buffer per
+		 * thread, which are added to vec afterwards.
+		 *
+		 * @param alphas scalars to multiply with, alphas[i] belongs to the
+		 * i-th vector of the range
+		 * @param sub_index index of vectors to add, may be NULL to add the
+		 * first num vectors
+		 * @param num number of vectors to add
+		 * @param vec dense vector to add to
+		 * @param dim length of the dense vector
+		 */
+		virtual void add_to_dense_vec_range(float64_t* alphas,
+				int32_t* sub_index, int32_t num, float64_t* vec, int32_t dim);
+
 		/** Compute the dot product for a range of vectors. This function is
 		 * called by the threads created in dense_dot_range */
 		static void* dense_dot_range_helper(void* p);
 
+		/** Compute the dot product for the sub range [start, stop) of a
+		 * range of vectors. This function is called by
+		 * Parallel::parallel_for in dense_dot_range */
+		static void dense_dot_range_range_helper(int32_t start, int32_t stop,
+				int32_t thread, void* p);
+
+		/** Add the weighted vectors of the sub range [start, stop) to the
+		 * buffer of the calling thread. This function is called by
+		 * Parallel::parallel_for in add_to_dense_vec_range */
+		static void add_to_dense_vec_range_helper(int32_t start, int32_t stop,
+				int32_t thread, void* p);
+
 		/** get number of non-zero features in vector
 		 *
 		 * (in case accurate estimates are too expensive overestimating is OK)
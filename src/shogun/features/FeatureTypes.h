@@ -53,6 +53,7 @@ namespace shogun
 		C_LATENT = 170,
 		C_MATRIX = 180,
 		C_FACTOR_GRAPH = 190,
+		C_PACKED_STRING = 200,
 		C_ANY = 1000
 	};
 
@@ -0,0 +1,269 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/features/PackedStringFeatures.h>
+#include <shogun/features/StringFeatures.h>
+#include <shogun/io/SGIO.h>
+
+using namespace shogun;
+
+/* index of the lowest set bit of a non-zero word */
+static inline int32_t lowest_bit(uint64_t x)
+{
+#ifdef __GNUC__
+	return __builtin_ctzll(x);
+#else
+	int32_t i=0;
+	while (!(x & 1))
+	{
+		x>>=1;
+		i++;
+	}
+	return i;
+#endif
+}
+
+CPackedStringFeatures::CPackedStringFeatures() : CFeatures(0)
+{
+	init();
+}
+
+CPackedStringFeatures::CPackedStringFeatures(CStringFeatures<char>* sf)
+	: CFeatures(0)
+{
+	init();
+	set_features(sf);
+}
+
+CPackedStringFeatures::CPackedStringFeatures(const CPackedStringFeatures& orig)
+	: CFeatures(orig)
+{
+	init();
+
+	alphabet=new CAlphabet(orig.alphabet);
+	SG_REF(alphabet);
+	bits_per_symbol=orig.bits_per_symbol;
+	symbols_per_word=orig.symbols_per_word;
+	symbol_mask=orig.symbol_mask;
+	words=orig.words.clone();
+	offsets=orig.offsets.clone();
+	lengths=orig.lengths.clone();
+	max_string_length=orig.max_string_length;
+}
+
+CPackedStringFeatures::~CPackedStringFeatures()
+{
+	SG_UNREF(alphabet);
+}
+
+void CPackedStringFeatures::init()
+{
+	alphabet=NULL;
+	bits_per_symbol=0;
+	symbols_per_word=0;
+	symbol_mask=0;
+	max_string_length=0;
+
+	m_parameters->add(&bits_per_symbol, "bits_per_symbol",
+			"Number of bits per symbol.");
+	m_parameters->add(&max_string_length, "max_string_length",
+			"Length of longest string.");
+	m_parameters->add((CSGObject**) &alphabet, "alphabet",
+			"Alphabet used in strings.");
+	m_parameters->add(&words, "words", "Packed strings.");
+	m_parameters->add(&offsets, "offsets", "First word of each string.");
+	m_parameters->add(&lengths, "lengths", "Length of each string.");
+}
+
+void CPackedStringFeatures::init_bits_per_symbol()
+{
+	int32_t num_bits=alphabet->get_num_bits();
+	REQUIRE(num_bits<=4, "Only alphabets of up to 16 symbols can be packed "
+			"(%s needs %d bits)\n", alphabet->get_name(), num_bits);
+
+	/* a power of two such that no symbol crosses a word boundary */
+	bits_per_symbol=1;
+	while (bits_per_symbol<num_bits)
+		bits_per_symbol*=2;
+
+	symbols_per_word=64/bits_per_symbol;
+	symbol_mask=(((uint64_t) 1)<<bits_per_symbol)-1;
+}
+
+void CPackedStringFeatures::set_features(CStringFeatures<char>* sf)
+{
+	REQUIRE(sf, "No string features given!\n");
+
+	SG_UNREF(alphabet);
+	CAlphabet* alpha=sf->get_alphabet();
+	alphabet=new CAlphabet(alpha);
+	SG_REF(alphabet);
+	SG_UNREF(alpha);
+	init_bits_per_symbol();
+
+	remove_all_subsets();
+
+	int32_t num=sf->get_num_vectors();
+	offsets=SGVector<int64_t>(num);
+	lengths=SGVector<int32_t>(num);
+	max_string_length=0;
+
+	int64_t num_words=0;
+	for (int32_t i=0; i<num; i++)
+	{
+		lengths[i]=sf->get_vector_length(i);
+		offsets[i]=num_words;
+		num_words+=(lengths[i]+symbols_per_word-1)/symbols_per_word;
+		max_string_length=CMath::max(max_string_length, lengths[i]);
+	}
+
+	/* one padding word such that get_block may always read two words */
+	words=SGVector<uint64_t>(num_words+1);
+	words.zero();
+
+	for (int32_t i=0; i<num; i++)
+	{
+		int32_t len;
+		bool free_vec;
+		char* vec=sf->get_feature_vector(i, len, free_vec);
+
+		uint64_t* w=&words.vector[offsets[i]];
+		for (int32_t j=0; j<len; j++)
+		{
+			uint64_t sym=alphabet->remap_to_bin(vec[j]);
+			w[j/symbols_per_word]|=sym<<((j%symbols_per_word)*bits_per_symbol);
+		}
+
+		sf->free_feature_vector(vec, i, free_vec);
+	}
+}
+
+void CPackedStringFeatures::load_serializable_post() throw (ShogunException)
+{
+	CFeatures::load_serializable_post();
+
+	if (alphabet)
+		init_bits_per_symbol();
+}
+
+CFeatures* CPackedStringFeatures::duplicate() const
+{
+	return new CPackedStringFeatures(*this);
+}
+
+int32_t CPackedStringFeatures::get_num_vectors() const
+{
+	return m_subset_stack->has_subsets() ? m_subset_stack->get_size() :
+		lengths.vlen;
+}
+
+CAlphabet* CPackedStringFeatures::get_alphabet()
+{
+	SG_REF(alphabet);
+	return alphabet;
+}
+
+int32_t CPackedStringFeatures::get_vector_length(int32_t num) const
+{
+	ASSERT(num<get_num_vectors())
+	return lengths[m_subset_stack->subset_idx_conversion(num)];
+}
+
+bool CPackedStringFeatures::have_same_length(int32_t len) const
+{
+	if (len!=-1 && len!=max_string_length)
+		return false;
+
+	for (int32_t i=0; i<get_num_vectors(); i++)
+	{
+		if (get_vector_length(i)!=max_string_length)
+			return false;
+	}
+
+	return true;
+}
+
+char* CPackedStringFeatures::get_feature_vector(int32_t num, int32_t& len,
+		bool& dofree)
+{
+	len=get_vector_length(num);
+	char* vec=SG_MALLOC(char, len);
+	int32_t real_num=m_subset_stack->subset_idx_conversion(num);
+
+	for (int32_t pos=0; pos<len; pos+=symbols_per_word)
+	{
+		uint64_t block=get_block(real_num, pos);
+		int32_t num_sym=CMath::min(symbols_per_word, len-pos);
+
+		for (int32_t k=0; k<num_sym; k++)
+		{
+			vec[pos+k]=alphabet->remap_to_char(block & symbol_mask);
+			block>>=bits_per_symbol;
+		}
+	}
+
+	dofree=true;
+	return vec;
+}
+
+void CPackedStringFeatures::free_feature_vector(char* feat_vec, int32_t num,
+		bool dofree)
+{
+	if (dofree)
+		SG_FREE(feat_vec);
+}
+
+void CPackedStringFeatures::get_bin_vector(int32_t num, int32_t start,
+		int32_t len, int32_t* dst) const
+{
+	int32_t real_num=m_subset_stack->subset_idx_conversion(num);
+	ASSERT(start>=0 && start+len<=lengths[real_num])
+
+	for (int32_t pos=0; pos<len; pos+=symbols_per_word)
+	{
+		uint64_t block=get_block(real_num, start+pos);
+		int32_t num_sym=CMath::min(symbols_per_word, len-pos);
+
+		for (int32_t k=0; k<num_sym; k++)
+		{
+			dst[pos+k]=block & symbol_mask;
+			block>>=bits_per_symbol;
+		}
+	}
+}
+
+uint8_t CPackedStringFeatures::get_symbol(int32_t num, int32_t pos) const
+{
+	int32_t real_num=m_subset_stack->subset_idx_conversion(num);
+	ASSERT(pos>=0 && pos<lengths[real_num])
+
+	return get_block(real_num, pos) & symbol_mask;
+}
+
+int32_t CPackedStringFeatures::match_length(int32_t num, int32_t pos,
+		const CPackedStringFeatures* other, int32_t other_num,
+		int32_t other_pos, int32_t max_len) const
+{
+	ASSERT(other->bits_per_symbol==bits_per_symbol)
+
+	int32_t real_num=m_subset_stack->subset_idx_conversion(num);
+	int32_t other_real_num=other->m_subset_stack->subset_idx_conversion(
+			other_num);
+
+	for (int32_t len=0; len<max_len; len+=symbols_per_word)
+	{
+		uint64_t diff=get_block(real_num, pos+len)^
+			other->get_block(other_real_num, other_pos+len);
+
+		if (diff)
+			return CMath::min(len+lowest_bit(diff)/bits_per_symbol, max_len);
+	}
+
+	return max_len;
+}
@@ -0,0 +1,286 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#ifndef _PACKEDSTRINGFEATURES_H___
+#define _PACKEDSTRINGFEATURES_H___
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/features/Features.h>
+#include <shogun/features/Alphabet.h>
+#include <shogun/mathematics/Math.h>
+
+namespace shogun
+{
+template <class ST> class CStringFeatures;
+
+/** @brief Features of strings over small alphabets stored with 1, 2 or 4 bits
+ * per symbol.
+ *
+ * Strings are packed into 64 bit words, e.g. DNA or RNA with 2 bits per
+ * nucleotide (32 nucleotides per word, a quarter of the memory of
+ * CStringFeatures<char>) and IUPAC nucleic acid codes with 4 bits. Each string
+ * starts at a word boundary, symbol i of a string is stored in the bits
+ * (i%s)*b..(i%s)*b+b-1 of its word i/s, where b is the number of bits per
+ * symbol and s=64/b. The symbols are the ones obtained via
+ * CAlphabet::remap_to_bin.
+ *
+ * Kernels can work on the packed words directly: match_length() compares
+ * two strings a word (up to 64/b symbols) at a time and get_kmers() extracts
+ * the k-mers of a string with a rolling window, yielding the same k-mer
+ * encoding as CStringFeatures::obtain_from_char without ever expanding the
+ * string to one element per symbol (see
+ * CStringFeatures::obtain_from_packed). CWeightedDegreeStringKernel accepts
+ * these features instead of CStringFeatures<char>.
+ */
+class CPackedStringFeatures : public CFeatures
+{
+	public:
+		/** default constructor */
+		CPackedStringFeatures();
+
+		/** constructor
+		 *
+		 * @param sf string features to pack, their alphabet must have at
+		 * most 16 symbols
+		 */
+		CPackedStringFeatures(CStringFeatures<char>* sf);
+
+		/** copy constructor */
+		CPackedStringFeatures(const CPackedStringFeatures& orig);
+
+		/** destructor */
+		virtual ~CPackedStringFeatures();
+
+		/** pack string features, replaces the current strings
+		 *
+		 * @param sf string features to pack, their alphabet must have at
+		 * most 16 symbols
+		 */
+		void set_features(CStringFeatures<char>* sf);
+
+		/** duplicate feature object
+		 *
+		 * @return feature object
+		 */
+		virtual CFeatures* duplicate() const;
+
+		/** get feature type
+		 *
+		 * @return templated feature type
+		 */
+		virtual EFeatureType get_feature_type() const { return F_CHAR; }
+
+		/** get feature class
+		 *
+		 * @return feature class PACKED_STRING
+		 */
+		virtual EFeatureClass get_feature_class() const
+		{
+			return C_PACKED_STRING;
+		}
+
+		/** get number of vectors
+		 *
+		 * @return number of vectors
+		 */
+		virtual int32_t get_num_vectors() const;
+
+		/** get alphabet used in packed strings
+		 *
+		 * @return alphabet
+		 */
+		CAlphabet* get_alphabet();
+
+		/** @return number of bits per symbol (1, 2 or 4) */
+		int32_t get_bits_per_symbol() const { return bits_per_symbol; }
+
+		/** get length of a string
+		 *
+		 * @param num index of string
+		 * @return length of string
+		 */
+		int32_t get_vector_length(int32_t num) const;
+
+		/** @return length of longest string */
+		int32_t get_max_vector_length() const { return max_string_length; }
+
+		/** check if all strings have the same length
+		 *
+		 * @param len length to check for, -1 for the maximum length
+		 * @return if all strings have the same length
+		 */
+		bool have_same_length(int32_t len=-1) const;
+
+		/** get string decoded to characters via the alphabet
+		 *
+		 * The string is unpacked into a newly allocated buffer, it is to
+		 * be released via free_feature_vector.
+		 *
+		 * @param num index of string
+		 * @param len length of string is returned by reference
+		 * @param dofree whether returned string must be freed
+		 * @return decoded string
+		 */
+		char* get_feature_vector(int32_t num, int32_t& len, bool& dofree);
+
+		/** free string obtained via get_feature_vector
+		 *
+		 * @param feat_vec string
+		 * @param num index of string
+		 * @param dofree if string has to be freed
+		 */
+		void free_feature_vector(char* feat_vec, int32_t num, bool dofree);
+
+		/** get symbols (as obtained by CAlphabet::remap_to_bin) of a part
+		 * of a string
+		 *
+		 * @param num index of string
+		 * @param start first position
+		 * @param len number of symbols
+		 * @param dst destination (len)
+		 */
+		void get_bin_vector(int32_t num, int32_t start, int32_t len,
+				int32_t* dst) const;
+
+		/** get a symbol
+		 *
+		 * @param num index of string
+		 * @param pos position
+		 * @return symbol (as obtained by CAlphabet::remap_to_bin)
+		 */
+		uint8_t get_symbol(int32_t num, int32_t pos) const;
+
+		/** length of the common run of two strings
+		 *
+		 * Compares get_symbols_per_word() symbols per step.
+		 *
+		 * @param num index of string
+		 * @param pos position in string
+		 * @param other features of the other string, with the same number
+		 * of bits per symbol
+		 * @param other_num index of other string
+		 * @param other_pos position in other string
+		 * @param max_len maximum length to compare
+		 * @return number of equal symbols starting at pos and other_pos
+		 */
+		int32_t match_length(int32_t num, int32_t pos,
+				const CPackedStringFeatures* other, int32_t other_num,
+				int32_t other_pos, int32_t max_len) const;
+
+		/** get the k-mers of a string, encoded like
+		 * CStringFeatures::obtain_from_char with gap 0
+		 *
+		 * Entry i-start of dst is the k-mer ending at position i, for
+		 * i<p_order-1 the k-mer is padded with zeros.
+		 *
+		 * @param num index of string
+		 * @param start first position (of the last symbol of the k-mer)
+		 * @param p_order k
+		 * @param rev reverse order of symbols in k-mer
+		 * @param dst destination (length of string minus start)
+		 */
+		template <class ST>
+		void get_kmers(int32_t num, int32_t start, int32_t p_order, bool rev,
+				ST* dst) const
+		{
+			int32_t real_num=m_subset_stack->subset_idx_conversion(num);
+			int32_t len=lengths[real_num];
+			int32_t b=alphabet->get_num_bits();
+
+			ST mask=0;
+			for (int32_t i=0; i<p_order*b; i++)
+				mask=(mask<<1) | ((ST) 1);
+
+			ST value=0;
+			for (int32_t pos=0; pos<len; pos+=symbols_per_word)
+			{
+				/* one word at a time, no per symbol lookup */
+				uint64_t block=get_block(real_num, pos);
+				int32_t num_sym=CMath::min(symbols_per_word, len-pos);
+
+				for (int32_t k=0; k<num_sym; k++)
+				{
+					ST sym=(ST) (block & symbol_mask);
+					block>>=bits_per_symbol;
+
+					if (rev)
+						value=(value>>b) | ((ST) (sym<<(b*(p_order-1))));
+					else
+						value=((value<<b) | sym) & mask;
+
+					if (pos+k>=start)
+						dst[pos+k-start]=value;
+				}
+			}
+		}
+
+		/** @return number of symbols per packed word */
+		int32_t get_symbols_per_word() const { return symbols_per_word; }
+
+		/** @return object name */
+		virtual const char* get_name() const { return "PackedStringFeatures"; }
+
+		/** restore the packing parameters after loading */
+		virtual void load_serializable_post() throw (ShogunException);
+
+	protected:
+		/** get up to get_symbols_per_word() symbols, the symbol at pos in
+		 * the lowest bits (symbols beyond the string are undefined)
+		 *
+		 * @param real_num index of string (without subset)
+		 * @param pos position
+		 * @return packed symbols
+		 */
+		inline uint64_t get_block(int32_t real_num, int32_t pos) const
+		{
+			const uint64_t* w=&words.vector[offsets[real_num]+
+				pos/symbols_per_word];
+			int32_t shift=(pos%symbols_per_word)*bits_per_symbol;
+
+			if (shift==0)
+				return w[0];
+
+			/* the words are padded, so w[1] is always valid */
+			return (w[0]>>shift) | (w[1]<<(64-shift));
+		}
+
+	private:
+		void init();
+
+		/** set number of bits per symbol from the alphabet */
+		void init_bits_per_symbol();
+
+	protected:
+		/** alphabet */
+		CAlphabet* alphabet;
+
+		/** number of bits per symbol */
+		int32_t bits_per_symbol;
+
+		/** number of symbols per word */
+		int32_t symbols_per_word;
+
+		/** mask of a single symbol */
+		uint64_t symbol_mask;
+
+		/** packed strings, followed by one padding word */
+		SGVector<uint64_t> words;
+
+		/** index of the first word of each string */
+		SGVector<int64_t> offsets;
+
+		/** length of each string */
+		SGVector<int32_t> lengths;
+
+		/** length of longest string */
+		int32_t max_string_length;
+};
+}
+#endif // _PACKEDSTRINGFEATURES_H___
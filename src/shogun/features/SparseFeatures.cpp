@@ -5,13 +5,198 @@
 #include <shogun/lib/DataType.h>
 #include <shogun/labels/RegressionLabels.h>
 #include <shogun/io/SGIO.h>
+#include <shogun/base/Parallel.h>
 
 #include <string.h>
 #include <stdlib.h>
 
+/* the AVX2 kernels of CSR mode are compiled for x86 independent of the
+ * build flags and only used if the CPU supports AVX2 at runtime */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SPARSE_CSR_AVX2
+#include <immintrin.h>
+#endif
+
 namespace shogun
 {
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/** parameters of dense_dot_range in CSR mode */
+template <class ST> struct CSR_DOT_THREAD_PARAM
+{
+	CSparseFeatures<ST>* sf;
+	float64_t* output;
+	float64_t* alphas;
+	const float64_t* vec;
+	float64_t bias;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/* gathers vec[idx[i]] and multiplies with the contiguous values, four
+ * independent accumulators break the dependency chain of the additions */
+template <class RT, class ST, class VT>
+static inline RT csr_gather_dot_unrolled(const index_t* idx, const ST* val,
+		int32_t len, const VT* vec)
+{
+	RT r0=0;
+	RT r1=0;
+	RT r2=0;
+	RT r3=0;
+
+	int32_t i=0;
+	for (; i+3<len; i+=4)
+	{
+		r0+=vec[idx[i]]*val[i];
+		r1+=vec[idx[i+1]]*val[i+1];
+		r2+=vec[idx[i+2]]*val[i+2];
+		r3+=vec[idx[i+3]]*val[i+3];
+	}
+
+	for (; i<len; i++)
+		r0+=vec[idx[i]]*val[i];
+
+	return (r0+r1)+(r2+r3);
+}
+
+/* adds alpha*val (or alpha*|val|) to vec[idx[i]], unrolled as the indices of
+ * a vector are distinct and the updates are independent */
+template <class ST>
+static inline void csr_scatter_add_unrolled(const index_t* idx, const ST* val,
+		int32_t len, float64_t alpha, float64_t* vec, bool abs_val)
+{
+	int32_t i=0;
+	if (abs_val)
+	{
+		for (; i+3<len; i+=4)
+		{
+			vec[idx[i]]+=alpha*CMath::abs(val[i]);
+			vec[idx[i+1]]+=alpha*CMath::abs(val[i+1]);
+			vec[idx[i+2]]+=alpha*CMath::abs(val[i+2]);
+			vec[idx[i+3]]+=alpha*CMath::abs(val[i+3]);
+		}
+		for (; i<len; i++)
+			vec[idx[i]]+=alpha*CMath::abs(val[i]);
+	}
+	else
+	{
+		for (; i+3<len; i+=4)
+		{
+			vec[idx[i]]+=alpha*val[i];
+			vec[idx[i+1]]+=alpha*val[i+1];
+			vec[idx[i+2]]+=alpha*val[i+2];
+			vec[idx[i+3]]+=alpha*val[i+3];
+		}
+		for (; i<len; i++)
+			vec[idx[i]]+=alpha*val[i];
+	}
+}
+
+template <class RT, class ST, class VT>
+static inline RT csr_gather_dot(const index_t* idx, const ST* val,
+		int32_t len, const VT* vec)
+{
+	return csr_gather_dot_unrolled<RT>(idx, val, len, vec);
+}
+
+template <class ST>
+static inline void csr_scatter_add(const index_t* idx, const ST* val,
+		int32_t len, float64_t alpha, float64_t* vec, bool abs_val)
+{
+	csr_scatter_add_unrolled(idx, val, len, alpha, vec, abs_val);
+}
+
+#ifdef SPARSE_CSR_AVX2
+/** @return whether the CPU supports AVX2, determined once */
+static bool sparse_csr_has_avx2()
+{
+	static const bool has_avx2=__builtin_cpu_supports("avx2");
+	return has_avx2;
+}
+
+__attribute__((target("avx2")))
+static float64_t csr_gather_dot_avx2(const index_t* idx, const float64_t* val,
+		int32_t len, const float64_t* vec)
+{
+	__m256d acc0=_mm256_setzero_pd();
+	__m256d acc1=_mm256_setzero_pd();
+
+	int32_t i=0;
+	for (; i+7<len; i+=8)
+	{
+		__m128i i0=_mm_loadu_si128((const __m128i*) &idx[i]);
+		__m128i i1=_mm_loadu_si128((const __m128i*) &idx[i+4]);
+		__m256d g0=_mm256_i32gather_pd(vec, i0, 8);
+		__m256d g1=_mm256_i32gather_pd(vec, i1, 8);
+		acc0=_mm256_add_pd(acc0, _mm256_mul_pd(g0, _mm256_loadu_pd(&val[i])));
+		acc1=_mm256_add_pd(acc1, _mm256_mul_pd(g1, _mm256_loadu_pd(&val[i+4])));
+	}
+
+	float64_t tmp[4];
+	_mm256_storeu_pd(tmp, _mm256_add_pd(acc0, acc1));
+	float64_t result=(tmp[0]+tmp[1])+(tmp[2]+tmp[3]);
+
+	for (; i<len; i++)
+		result+=vec[idx[i]]*val[i];
+
+	return result;
+}
+
+/* AVX2 has no scatter, the targets are gathered and updated four at a time
+ * and written back lane by lane */
+__attribute__((target("avx2")))
+static void csr_scatter_add_avx2(const index_t* idx, const float64_t* val,
+		int32_t len, float64_t alpha, float64_t* vec, bool abs_val)
+{
+	const __m256d a=_mm256_set1_pd(alpha);
+	const __m256d sign=_mm256_set1_pd(-0.0);
+
+	int32_t i=0;
+	for (; i+3<len; i+=4)
+	{
+		__m128i i0=_mm_loadu_si128((const __m128i*) &idx[i]);
+		__m256d v=_mm256_loadu_pd(&val[i]);
+		if (abs_val)
+			v=_mm256_andnot_pd(sign, v);
+
+		float64_t tmp[4];
+		_mm256_storeu_pd(tmp, _mm256_add_pd(_mm256_i32gather_pd(vec, i0, 8),
+					_mm256_mul_pd(a, v)));
+		vec[idx[i]]=tmp[0];
+		vec[idx[i+1]]=tmp[1];
+		vec[idx[i+2]]=tmp[2];
+		vec[idx[i+3]]=tmp[3];
+	}
+
+	for (; i<len; i++)
+		vec[idx[i]]+=alpha*(abs_val ? CMath::abs(val[i]) : val[i]);
+}
+
+template <>
+inline float64_t csr_gather_dot<float64_t,float64_t,float64_t>(
+		const index_t* idx, const float64_t* val, int32_t len,
+		const float64_t* vec)
+{
+	if (len>=8 && sparse_csr_has_avx2())
+		return csr_gather_dot_avx2(idx, val, len, vec);
+
+	return csr_gather_dot_unrolled<float64_t>(idx, val, len, vec);
+}
+
+template <>
+inline void csr_scatter_add<float64_t>(const index_t* idx,
+		const float64_t* val, int32_t len, float64_t alpha, float64_t* vec,
+		bool abs_val)
+{
+	if (len>=4 && sparse_csr_has_avx2())
+	{
+		csr_scatter_add_avx2(idx, val, len, alpha, vec, abs_val);
+		return;
+	}
+
+	csr_scatter_add_unrolled(idx, val, len, alpha, vec, abs_val);
+}
+#endif // SPARSE_CSR_AVX2
+
 template<class ST> CSparseFeatures<ST>::CSparseFeatures(int32_t size)
 : CDotFeatures(size), feature_cache(NULL)
 {
@@ -34,9 +219,19 @@ template<class ST> CSparseFeatures<ST>::CSparseFeatures(SGMatrix<ST> dense)
 	set_full_feature_matrix(dense);
 }
 
+template<class ST> CSparseFeatures<ST>::CSparseFeatures(SGVector<index_t> indptr,
+		SGVector<index_t> indices, SGVector<ST> values, int32_t num_features)
+: CDotFeatures(0), feature_cache(NULL)
+{
+	init();
+
+	set_csr_feature_matrix(indptr, indices, values, num_features);
+}
+
 template<class ST> CSparseFeatures<ST>::CSparseFeatures(const CSparseFeatures & orig)
 : CDotFeatures(orig), sparse_feature_matrix(orig.sparse_feature_matrix),
-	feature_cache(orig.feature_cache)
+	m_csr_indptr(orig.m_csr_indptr), m_csr_indices(orig.m_csr_indices),
+	m_csr_values(orig.m_csr_values), feature_cache(orig.feature_cache)
 {
 	init();
 
@@ -84,6 +279,12 @@ template<class ST> SGVector<ST> CSparseFeatures<ST>::get_full_feature_vector(int
 
 template<class ST> int32_t CSparseFeatures<ST>::get_nnz_features_for_vector(int32_t num)
 {
+	if (is_csr())
+	{
+		index_t real_num=m_subset_stack->subset_idx_conversion(num);
+		return m_csr_indptr[real_num+1]-m_csr_indptr[real_num];
+	}
+
 	SGSparseVector<ST> sv = get_sparse_feature_vector(num);
 	int32_t len=sv.num_feat_entries;
 	free_sparse_feature_vector(num);
@@ -101,6 +302,19 @@ template<class ST> SGSparseVector<ST> CSparseFeatures<ST>::get_sparse_feature_ve
 	{
 		return sparse_feature_matrix[real_num];
 	}
+	else if (is_csr())
+	{
+		index_t start=m_csr_indptr[real_num];
+		int32_t len=m_csr_indptr[real_num+1]-start;
+
+		SGSparseVector<ST> result(len);
+		for (int32_t i=0; i<len; i++)
+		{
+			result.features[i].feat_index=m_csr_indices[start+i];
+			result.features[i].entry=m_csr_values[start+i];
+		}
+		return result;
+	}
 	else
 	{
 		SGSparseVector<ST> result;
@@ -154,6 +368,16 @@ template<class ST> SGSparseVector<ST> CSparseFeatures<ST>::get_sparse_feature_ve
 
 template<class ST> ST CSparseFeatures<ST>::dense_dot(ST alpha, int32_t num, ST* vec, int32_t dim, ST b)
 {
+	if (is_csr() && dim>=get_num_features())
+	{
+		ASSERT(vec)
+		index_t real_num=m_subset_stack->subset_idx_conversion(num);
+		index_t start=m_csr_indptr[real_num];
+
+		return alpha*csr_gather_dot<ST>(&m_csr_indices[start],
+				&m_csr_values[start], m_csr_indptr[real_num+1]-start, vec)+b;
+	}
+
 	SGSparseVector<ST> sv=get_sparse_feature_vector(num);
 	ST result = sv.dense_dot(alpha,vec,dim,b);
 	free_sparse_feature_vector(num);
@@ -168,6 +392,17 @@ template<class ST> void CSparseFeatures<ST>::add_to_dense_vec(float64_t alpha, i
 		"add_to_dense_vec(num=%d,dim=%d): dim should contain number of features %d\n",
 		num, dim, get_num_features());
 
+	if (is_csr())
+	{
+		index_t real_num=m_subset_stack->subset_idx_conversion(num);
+		index_t start=m_csr_indptr[real_num];
+
+		csr_scatter_add<ST>(&m_csr_indices.vector[start],
+				&m_csr_values.vector[start], m_csr_indptr[real_num+1]-start,
+				alpha, vec, abs_val);
+		return;
+	}
+
 	SGSparseVector<ST> sv=get_sparse_feature_vector(num);
 
 	if (sv.features)
@@ -213,15 +448,38 @@ template<class ST> SGSparseMatrix<ST> CSparseFeatures<ST>::get_sparse_feature_ma
 	if (m_subset_stack->has_subsets())
 		SG_ERROR("Not allowed with subset\n");
 
+	if (is_csr())
+		return csr_to_sparse_matrix();
+
 	return sparse_feature_matrix;
 }
 
+template<class ST> SGSparseMatrix<ST> CSparseFeatures<ST>::csr_to_sparse_matrix()
+{
+	/* array of sparse vectors has to be created from the CSR buffers */
+	int32_t num_vec=m_csr_indptr.vlen-1;
+	SGSparseMatrix<ST> sm(get_num_features(), num_vec);
+	for (int32_t i=0; i<num_vec; i++)
+	{
+		index_t start=m_csr_indptr[i];
+		int32_t len=m_csr_indptr[i+1]-start;
+		sm[i]=SGSparseVector<ST>(len);
+		for (int32_t j=0; j<len; j++)
+		{
+			sm[i].features[j].feat_index=m_csr_indices[start+j];
+			sm[i].features[j].entry=m_csr_values[start+j];
+		}
+	}
+
+	return sm;
+}
+
 template<class ST> CSparseFeatures<ST>* CSparseFeatures<ST>::get_transposed()
 {
 	if (m_subset_stack->has_subsets())
 		SG_ERROR("Not allowed with subset\n");
 
-	return new CSparseFeatures<ST>(sparse_feature_matrix.get_transposed());
+	return new CSparseFeatures<ST>(get_sparse_feature_matrix().get_transposed());
 }
 
 template<class ST> void CSparseFeatures<ST>::set_sparse_feature_matrix(SGSparseMatrix<ST> sm)
@@ -229,6 +487,7 @@ template<class ST> void CSparseFeatures<ST>::set_sparse_feature_matrix(SGSparseM
 	if (m_subset_stack->has_subsets())
 		SG_ERROR("Not allowed with subset\n");
 
+	free_csr_feature_matrix();
 	sparse_feature_matrix=sm;
 
 	// TODO: check should be implemented in sparse matrix class
@@ -246,11 +505,22 @@ template<class ST> SGMatrix<ST> CSparseFeatures<ST>::get_full_feature_matrix()
 	full.zero();
 
 	SG_INFO("converting sparse features to full feature matrix of %d x %d"
-			" entries\n", sparse_feature_matrix.num_vectors, get_num_features())
+			" entries\n", get_num_vectors(), get_num_features())
 
 	for (int32_t v=0; v<full.num_cols; v++)
 	{
 		int32_t idx=m_subset_stack->subset_idx_conversion(v);
+
+		if (is_csr())
+		{
+			for (index_t f=m_csr_indptr[idx]; f<m_csr_indptr[idx+1]; f++)
+			{
+				int64_t offs=(v*get_num_features())+m_csr_indices[f];
+				full.matrix[offs]=m_csr_values[f];
+			}
+			continue;
+		}
+
 		SGSparseVector<ST> current=sparse_feature_matrix[idx];
 
 		for (int32_t f=0; f<current.num_feat_entries; f++)
@@ -274,6 +544,91 @@ template<class ST> void CSparseFeatures<ST>::free_sparse_features()
 template<class ST> void CSparseFeatures<ST>::free_sparse_feature_matrix()
 {
 	sparse_feature_matrix=SGSparseMatrix<ST>();
+	free_csr_feature_matrix();
+}
+
+template<class ST> void CSparseFeatures<ST>::free_csr_feature_matrix()
+{
+	m_csr_indptr=SGVector<index_t>();
+	m_csr_indices=SGVector<index_t>();
+	m_csr_values=SGVector<ST>();
+}
+
+template<class ST> void CSparseFeatures<ST>::set_csr_feature_matrix(
+		SGVector<index_t> indptr, SGVector<index_t> indices,
+		SGVector<ST> values, int32_t num_features)
+{
+	if (m_subset_stack->has_subsets())
+		SG_ERROR("Not allowed with subset\n");
+
+	REQUIRE(indptr.vector && indptr.vlen>0,
+		"indptr must contain num_vectors+1 entries\n");
+	REQUIRE(indices.vlen==values.vlen,
+		"number of indices (%d) and values (%d) differ\n",
+		indices.vlen, values.vlen);
+	REQUIRE(indptr[0]==0 && indptr[indptr.vlen-1]==indices.vlen,
+		"indptr must range from 0 to the number of non-zero entries %d\n",
+		indices.vlen);
+
+	for (index_t i=0; i<indptr.vlen-1; i++)
+	{
+		REQUIRE(indptr[i]<=indptr[i+1],
+			"indptr must be non-decreasing (indptr[%d]=%d > indptr[%d]=%d)\n",
+			i, indptr[i], i+1, indptr[i+1]);
+	}
+
+	for (index_t i=0; i<indices.vlen; i++)
+	{
+		REQUIRE(indices[i]>=0 && indices[i]<num_features,
+			"feature index %d exceeds [0;%d]\n", indices[i], num_features-1);
+	}
+
+	sparse_feature_matrix=SGSparseMatrix<ST>();
+	sparse_feature_matrix.num_features=num_features;
+
+	m_csr_indptr=indptr;
+	m_csr_indices=indices;
+	m_csr_values=values;
+}
+
+template<class ST> void CSparseFeatures<ST>::convert_to_csr()
+{
+	if (m_subset_stack->has_subsets())
+		SG_ERROR("Not allowed with subset\n");
+
+	if (is_csr())
+		return;
+
+	sparse_matrix_to_csr();
+}
+
+template<class ST> void CSparseFeatures<ST>::sparse_matrix_to_csr()
+{
+	int32_t num_vec=sparse_feature_matrix.num_vectors;
+	SGVector<index_t> indptr(num_vec+1);
+	indptr[0]=0;
+	for (int32_t i=0; i<num_vec; i++)
+		indptr[i+1]=indptr[i]+sparse_feature_matrix[i].num_feat_entries;
+
+	SGVector<index_t> indices(indptr[num_vec]);
+	SGVector<ST> values(indptr[num_vec]);
+	for (int32_t i=0; i<num_vec; i++)
+	{
+		SGSparseVector<ST> sv=sparse_feature_matrix[i];
+		for (int32_t j=0; j<sv.num_feat_entries; j++)
+		{
+			indices[indptr[i]+j]=sv.features[j].feat_index;
+			values[indptr[i]+j]=sv.features[j].entry;
+		}
+	}
+
+	int32_t num_features=sparse_feature_matrix.num_features;
+	sparse_feature_matrix=SGSparseMatrix<ST>();
+	sparse_feature_matrix.num_features=num_features;
+
+	m_csr_indptr=indptr;
+	m_csr_indices=indices;
+	m_csr_values=values;
 }
 
 template<class ST> void CSparseFeatures<ST>::set_full_feature_matrix(SGMatrix<ST> full)
@@ -287,8 +642,20 @@ template<class ST> bool CSparseFeatures<ST>::apply_preprocessor(bool force_prepr
 {
 	SG_INFO("force: %d\n", force_preprocessing)
 
+	/* preprocessors work on the array of sparse vectors, the CSR buffers
+	 * are rebuilt afterwards so they do not go stale */
+	bool csr=is_csr();
+	if (csr)
+	{
+		SGSparseMatrix<ST> sm=csr_to_sparse_matrix();
+		free_csr_feature_matrix();
+		sparse_feature_matrix=sm;
+	}
+
+	bool result=false;
 	if ( sparse_feature_matrix.sparse_matrix && get_num_preprocessors() )
 	{
+		result=true;
 		for (int32_t i=0; i<get_num_preprocessors(); i++)
 		{
 			if ( (!is_preprocessed(i) || force_preprocessing) )
@@ -296,17 +663,18 @@ template<class ST> bool CSparseFeatures<ST>::apply_preprocessor(bool force_prepr
 				set_preprocessed(i);
 				SG_INFO("preprocessing using preproc %s\n", get_preprocessor(i)->get_name())
 				if (((CSparsePreprocessor<ST>*) get_preprocessor(i))->apply_to_sparse_feature_matrix(this) == NULL)
-					return false;
+					result=false;
 			}
-			return true;
+			break;
 		}
-		return true;
 	}
 	else
-	{
 		SG_WARNING("no sparse feature matrix available or features already preprocessed - skipping.\n")
-		return false;
-	}
+
+	if (csr)
+		sparse_matrix_to_csr();
+
+	return result;
 }
 
 template<class ST> void CSparseFeatures<ST>::obtain_from_simple(CDenseFeatures<ST>* sf)
@@ -323,7 +691,10 @@ template<> void CSparseFeatures<complex128_t>::obtain_from_simple(CDenseFeatures
 
 template<class ST> int32_t  CSparseFeatures<ST>::get_num_vectors() const
 {
-	return m_subset_stack->has_subsets() ? m_subset_stack->get_size() : sparse_feature_matrix.num_vectors;
+	if (m_subset_stack->has_subsets())
+		return m_subset_stack->get_size();
+
+	return is_csr() ? m_csr_indptr.vlen-1 : sparse_feature_matrix.num_vectors;
 }
 
 template<class ST> int32_t  CSparseFeatures<ST>::get_num_features() const
@@ -357,7 +728,7 @@ template<class ST> int64_t CSparseFeatures<ST>::get_num_nonzero_entries()
 	int64_t num=0;
 	index_t num_vec=get_num_vectors();
 	for (int32_t i=0; i<num_vec; i++)
-		num+=sparse_feature_matrix[m_subset_stack->subset_idx_conversion(i)].num_feat_entries;
+		num+=get_nnz_features_for_vector(i);
 
 	return num;
 }
@@ -460,6 +831,32 @@ template<class ST> float64_t CSparseFeatures<ST>::dot(int32_t vec_idx1,
 	ASSERT(df->get_feature_class() == get_feature_class())
 	CSparseFeatures<ST>* sf = (CSparseFeatures<ST>*) df;
 
+	if (is_csr() && sf->is_csr())
+	{
+		index_t a=m_subset_stack->subset_idx_conversion(vec_idx1);
+		index_t b=sf->m_subset_stack->subset_idx_conversion(vec_idx2);
+		index_t i=m_csr_indptr[a];
+		index_t i_end=m_csr_indptr[a+1];
+		index_t j=sf->m_csr_indptr[b];
+		index_t j_end=sf->m_csr_indptr[b+1];
+		const index_t* a_idx=m_csr_indices.vector;
+		const index_t* b_idx=sf->m_csr_indices.vector;
+
+		/* merge the sorted index lists */
+		float64_t result=0;
+		while (i<i_end && j<j_end)
+		{
+			if (a_idx[i]<b_idx[j])
+				i++;
+			else if (a_idx[i]>b_idx[j])
+				j++;
+			else
+				result+=m_csr_values[i++]*sf->m_csr_values[j++];
+		}
+
+		return result;
+	}
+
 	SGSparseVector<ST> avec=get_sparse_feature_vector(vec_idx1);
 	SGSparseVector<ST> bvec=sf->get_sparse_feature_vector(vec_idx2);
 
@@ -485,6 +882,9 @@ template<class ST> float64_t CSparseFeatures<ST>::dense_dot(int32_t vec_idx1, co
 		"dense_dot(vec_idx1=%d,vec2_len=%d): vec2_len should contain number of features %d %d\n",
 		vec_idx1, vec2_len, get_num_features());
 
+	if (is_csr())
+		return csr_dense_dot(m_subset_stack->subset_idx_conversion(vec_idx1), vec2);
+
 	float64_t result=0;
 	SGSparseVector<ST> sv=get_sparse_feature_vector(vec_idx1);
 
@@ -514,6 +914,71 @@ template<> float64_t CSparseFeatures<complex128_t>::dense_dot(int32_t vec_idx1,
 	return 0.0;
 }
 
+template<class ST> float64_t CSparseFeatures<ST>::csr_dense_dot(int32_t real_num,
+	const float64_t* vec) const
+{
+	index_t start=m_csr_indptr[real_num];
+	return csr_gather_dot<float64_t>(&m_csr_indices.vector[start],
+			&m_csr_values.vector[start], m_csr_indptr[real_num+1]-start, vec);
+}
+
+template<> float64_t CSparseFeatures<complex128_t>::csr_dense_dot(int32_t real_num,
+	const float64_t* vec) const
+{
+	SG_NOTIMPLEMENTED;
+	return 0.0;
+}
+
+template<class ST> void CSparseFeatures<ST>::dense_dot_range(float64_t* output,
+	int32_t start, int32_t stop, float64_t* alphas, float64_t* vec,
+	int32_t dim, float64_t b)
+{
+	if (!is_csr())
+	{
+		CDotFeatures::dense_dot_range(output, start, stop, alphas, vec, dim, b);
+		return;
+	}
+
+	ASSERT(output)
+	ASSERT(vec)
+	ASSERT(start>=0)
+	ASSERT(start<stop)
+	ASSERT(stop<=get_num_vectors())
+	REQUIRE(dim>=get_num_features(),
+		"dense_dot_range(dim=%d): dim should contain number of features %d\n",
+		dim, get_num_features());
+
+	CSR_DOT_THREAD_PARAM<ST> params;
+	params.sf=this;
+	// write access is between output[start..stop]
+	params.output=output-start;
+	params.alphas=alphas;
+	params.vec=vec;
+	params.bias=b;
+
+	parallel->parallel_for(start, stop,
+			CSparseFeatures<ST>::dense_dot_range_csr_helper, (void*) &params);
+}
+
+template<class ST> void CSparseFeatures<ST>::dense_dot_range_csr_helper(
+	int32_t start, int32_t stop, int32_t thread, void* p)
+{
+	CSR_DOT_THREAD_PARAM<ST>* par=(CSR_DOT_THREAD_PARAM<ST>*) p;
+	CSparseFeatures<ST>* sf=par->sf;
+	CSubsetStack* subset_stack=sf->m_subset_stack;
+
+	for (int32_t i=start; i<stop; i++)
+	{
+		float64_t r=sf->csr_dense_dot(subset_stack->subset_idx_conversion(i),
+				par->vec);
+
+		if (par->alphas)
+			par->output[i]=par->alphas[i]*r+par->bias;
+		else
+			par->output[i]=r+par->bias;
+	}
+}
+
 template<class ST> void* CSparseFeatures<ST>::get_feature_iterator(int32_t vector_index)
 {
 	if (vector_index>=get_num_vectors())
@@ -522,7 +987,7 @@ template<class ST> void* CSparseFeatures<ST>::get_feature_iterator(int32_t vecto
 				"requested %d)\n", get_num_vectors(), vector_index);
 	}
 
-	if (!sparse_feature_matrix.sparse_matrix)
+	if (!sparse_feature_matrix.sparse_matrix && !is_csr())
 		SG_ERROR("Requires a in-memory feature matrix\n")
 
 	sparse_feature_iterator* it=new sparse_feature_iterator();
@@ -595,6 +1060,17 @@ template<class ST> SGSparseVectorEntry<ST>* CSparseFeatures<ST>::compute_sparse_
 
 template<class ST> void CSparseFeatures<ST>::sort_features()
 {
+	if (is_csr())
+	{
+		for (index_t i=0; i<m_csr_indptr.vlen-1; i++)
+		{
+			index_t start=m_csr_indptr[i];
+			CMath::qsort_index(&m_csr_indices.vector[start],
+					&m_csr_values.vector[start], m_csr_indptr[i+1]-start);
+		}
+		return;
+	}
+
 	sparse_feature_matrix.sort_features();
 }
 
@@ -609,6 +1085,40 @@ template<class ST> void CSparseFeatures<ST>::init()
 			"Total number of features.");
 }
 
+template<class ST> void CSparseFeatures<ST>::save_serializable_pre() throw (ShogunException)
+{
+	CDotFeatures::save_serializable_pre();
+
+	/* only the array of sparse vectors is serialized */
+	if (is_csr())
+		sparse_feature_matrix=csr_to_sparse_matrix();
+}
+
+template<class ST> void CSparseFeatures<ST>::save_serializable_post() throw (ShogunException)
+{
+	CDotFeatures::save_serializable_post();
+
+	if (is_csr())
+	{
+		int32_t num_features=sparse_feature_matrix.num_features;
+		sparse_feature_matrix=SGSparseMatrix<ST>();
+		sparse_feature_matrix.num_features=num_features;
+	}
+}
+
+template<class ST> void CSparseFeatures<ST>::load_serializable_post() throw (ShogunException)
+{
+	CDotFeatures::load_serializable_post();
+
+	/* CSR buffers of the previous state are rebuilt from the loaded
+	 * vectors */
+	if (is_csr())
+	{
+		free_csr_feature_matrix();
+		sparse_matrix_to_csr();
+	}
+}
+
 #define GET_FEATURE_TYPE(sg_type, f_type)									\
 template<> EFeatureType CSparseFeatures<sg_type>::get_feature_type() const	\
 {																			\
@@ -651,7 +1161,7 @@ template<class ST> void CSparseFeatures<ST>::save(CFile* writer)
 	if (m_subset_stack->has_subsets())
 		SG_ERROR("Not allowed with subset\n");
 	ASSERT(writer)
-	sparse_feature_matrix.save(writer);
+	get_sparse_feature_matrix().save(writer);
 }
 
 template<class ST> void CSparseFeatures<ST>::save_with_labels(CLibSVMFile* writer, SGVector<float64_t> labels)
@@ -659,7 +1169,7 @@ template<class ST> void CSparseFeatures<ST>::save_with_labels(CLibSVMFile* write
 	if (m_subset_stack->has_subsets())
 		SG_ERROR("Not allowed with subset\n");
 	ASSERT(writer)
-	sparse_feature_matrix.save_with_labels(writer, labels);
+	get_sparse_feature_matrix().save_with_labels(writer, labels);
 }
 
 template class CSparseFeatures<bool>;
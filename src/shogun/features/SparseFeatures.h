@@ -49,6 +49,18 @@ template <class ST> class SGSparseMatrix;
  * As this is a template class it can directly be used for different data types
  * like sparse matrices of real valued, integer, byte etc type.
  *
+ * Alternatively, the features can be stored in compressed sparse row (CSR)
+ * format, i.e. three contiguous arrays holding the start of each vector
+ * (indptr), the feature indices and the feature values of all vectors. CSR
+ * buffers can be passed in without copying, see
+ * CSparseFeatures(SGVector<index_t>,SGVector<index_t>,SGVector<ST>,int32_t),
+ * or an existing array of sparse vectors can be converted via
+ * convert_to_csr(). In CSR mode dense_dot(), dense_dot_range() and
+ * add_to_dense_vec() work directly on the contiguous arrays, while
+ * get_sparse_feature_vector() returns a copy of the requested vector. The
+ * CSR buffers are not serialized, features in CSR mode are saved as array of
+ * sparse vectors.
+ *
  * (Partly) subset access is supported for this feature type.
  * Simple use the (inherited) add_subset(), remove_subset() functions.
  * If done, all calls that work with features are translated to the subset.
@@ -78,6 +90,21 @@ template <class ST> class CSparseFeatures : public CDotFeatures
 		 */
 		CSparseFeatures(SGMatrix<ST> dense);
 
+		/** convenience constructor that creates sparse features from
+		 * a matrix in compressed sparse row (CSR) format
+		 *
+		 * the buffers are not copied, pass SGVectors without reference
+		 * counting to use memory that is owned elsewhere
+		 *
+		 * @param indptr start of each vector in indices/values
+		 * (num_vectors+1 entries)
+		 * @param indices feature indices, sorted within each vector
+		 * @param values feature values
+		 * @param num_features number of features
+		 */
+		CSparseFeatures(SGVector<index_t> indptr, SGVector<index_t> indices,
+				SGVector<ST> values, int32_t num_features);
+
 		/** copy constructor */
 		CSparseFeatures(const CSparseFeatures & orig);
 
@@ -139,6 +166,11 @@ template <class ST> class CSparseFeatures : public CDotFeatures
 		 *
 		 * possible with subset
 		 *
+		 * in CSR mode the vector is assembled from the CSR buffers, i.e. each
+		 * call allocates and copies it; use dense_dot(), add_to_dense_vec()
+		 * or get_csr_indptr(), get_csr_indices() and get_csr_values() to
+		 * access the features without copying
+		 *
 		 * @param num index of feature vector
 		 * @return sparse feature vector
 		 */
@@ -185,6 +217,9 @@ template <class ST> class CSparseFeatures : public CDotFeatures
 		 *
 		 * not possible with subset
 		 *
+		 * in CSR mode a copy of the features is returned, see
+		 * get_sparse_feature_matrix()
+		 *
 		 * @param num_feat number of features in matrix
 		 * @param num_vec number of vectors in matrix
 		 * @return feature matrix
@@ -195,6 +230,10 @@ template <class ST> class CSparseFeatures : public CDotFeatures
 		 *
 		 * not possible with subset
 		 *
+		 * in CSR mode the array of sparse vectors is built from the CSR
+		 * buffers on each call, i.e. the returned matrix is a copy and
+		 * changes to it do not affect the features
+		 *
 		 * @return sparse matrix
 		 *
 		 */
@@ -230,6 +269,63 @@ template <class ST> class CSparseFeatures : public CDotFeatures
 		 */
         void set_sparse_feature_matrix(SGSparseMatrix<ST> sm);
 
+		/** set feature matrix in compressed sparse row (CSR) format
+		 *
+		 * the buffers are not copied
+		 *
+		 * not possible with subset
+		 *
+		 * @param indptr start of each vector in indices/values
+		 * (num_vectors+1 entries)
+		 * @param indices feature indices, sorted within each vector
+		 * @param values feature values
+		 * @param num_features number of features
+		 */
+		void set_csr_feature_matrix(SGVector<index_t> indptr,
+				SGVector<index_t> indices, SGVector<ST> values,
+				int32_t num_features);
+
+		/** convert the array of sparse vectors into compressed sparse row
+		 * (CSR) format, the array of sparse vectors is dropped
+		 *
+		 * not possible with subset
+		 */
+		void convert_to_csr();
+
+		/** stores the CSR buffers as array of sparse vectors for
+		 * serialization
+		 *
+		 * @exception ShogunException will be thrown if an error occurs.
+		 */
+		virtual void save_serializable_pre() throw (ShogunException);
+
+		/** drops the array of sparse vectors again in CSR mode
+		 *
+		 * @exception ShogunException will be thrown if an error occurs.
+		 */
+		virtual void save_serializable_post() throw (ShogunException);
+
+		/** rebuilds the CSR buffers from the loaded array of sparse vectors
+		 * if the features were in CSR mode
+		 *
+		 * @exception ShogunException will be thrown if an error occurs.
+		 */
+		virtual void load_serializable_post() throw (ShogunException);
+
+		/** @return whether features are stored in compressed sparse row
+		 * (CSR) format
+		 */
+		bool is_csr() const { return m_csr_indptr.vlen>0; }
+
+		/** @return CSR vector start offsets (empty if not in CSR mode) */
+		SGVector<index_t> get_csr_indptr() const { return m_csr_indptr; }
+
+		/** @return CSR feature indices (empty if not in CSR mode) */
+		SGVector<index_t> get_csr_indices() const { return m_csr_indices; }
+
+		/** @return CSR feature values (empty if not in CSR mode) */
+		SGVector<ST> get_csr_values() const { return m_csr_values; }
+
 		/** gets a copy of a full feature matrix
 		 *
 		 * possible with subset
@@ -416,6 +512,23 @@ template <class ST> class CSparseFeatures : public CDotFeatures
 		 */
 		virtual float64_t dense_dot(int32_t vec_idx1, const float64_t* vec2, int32_t vec2_len);
 
+		/** Compute the dot product for a range of vectors. This function
+		 * makes use of dense_dot alphas[i] * sparse[i]^T * w + b
+		 *
+		 * in CSR mode the contiguous arrays are processed directly
+		 *
+		 * @param output result for the given vector range
+		 * @param start start vector range from this idx
+		 * @param stop stop vector range at this idx
+		 * @param alphas scalars to multiply with, may be NULL
+		 * @param vec dense vector to compute dot product with
+		 * @param dim length of the dense vector
+		 * @param b bias
+		 */
+		virtual void dense_dot_range(float64_t* output, int32_t start,
+				int32_t stop, float64_t* alphas, float64_t* vec, int32_t dim,
+				float64_t b);
+
 		#ifndef DOXYGEN_SHOULD_SKIP_THIS
 		/** iterator for sparse features */
 		struct sparse_feature_iterator
@@ -495,14 +608,51 @@ template <class ST> class CSparseFeatures : public CDotFeatures
 		virtual SGSparseVectorEntry<ST>* compute_sparse_feature_vector(int32_t num,
 			int32_t& len, SGSparseVectorEntry<ST>* target=NULL);
 
+		/** dot product of a vector in CSR mode with a dense vector of at
+		 * least get_num_features() elements
+		 *
+		 * @param real_num index of the vector (after subset conversion)
+		 * @param vec dense vector
+		 * @return dot product
+		 */
+		float64_t csr_dense_dot(int32_t real_num, const float64_t* vec) const;
+
+		/** helper for dense_dot_range in CSR mode, called via
+		 * Parallel::parallel_for
+		 */
+		static void dense_dot_range_csr_helper(int32_t start, int32_t stop,
+				int32_t thread, void* p);
+
 	private:
 		void init();
 
+		/** drop CSR buffers */
+		void free_csr_feature_matrix();
+
+		/** @return array of sparse vectors built from the CSR buffers,
+		 * ignoring subsets */
+		SGSparseMatrix<ST> csr_to_sparse_matrix();
+
+		/** replace the array of sparse vectors by CSR buffers, ignoring
+		 * subsets */
+		void sparse_matrix_to_csr();
+
 	protected:
 
 		/// array of sparse vectors of size num_vectors
 		SGSparseMatrix<ST> sparse_feature_matrix;
 
+		/** CSR start offset of each vector (num_vectors+1 entries), empty
+		 * if the features are stored as array of sparse vectors
+		 */
+		SGVector<index_t> m_csr_indptr;
+
+		/** CSR feature indices */
+		SGVector<index_t> m_csr_indices;
+
+		/** CSR feature values */
+		SGVector<ST> m_csr_values;
+
 		/** feature cache */
 		CCache< SGSparseVectorEntry<ST> >* feature_cache;
 };
@@ -1,4 +1,5 @@
 #include <shogun/features/StringFeatures.h>
+#include <shogun/features/PackedStringFeatures.h>
 #include <shogun/preprocessor/Preprocessor.h>
 #include <shogun/preprocessor/StringPreprocessor.h>
 #include <shogun/io/MemoryMappedFile.h>
@@ -1291,6 +1292,49 @@ template<class ST> bool CStringFeatures<ST>::obtain_from_char(CStringFeatures<ch
 	return obtain_from_char_features(sf, start, p_order, gap, rev);
 }
 
+template<class ST> bool CStringFeatures<ST>::obtain_from_packed(CPackedStringFeatures* pf, int32_t start, int32_t p_order, bool rev)
+{
+	remove_all_subsets();
+	ASSERT(pf)
+
+	CAlphabet* alpha=pf->get_alphabet();
+	int32_t max_val=alpha->get_num_bits();
+
+	this->order=p_order;
+	cleanup();
+
+	num_vectors=pf->get_num_vectors();
+	ASSERT(num_vectors>0)
+	max_string_length=pf->get_max_vector_length()-start;
+	features=SG_MALLOC(SGString<ST>, num_vectors);
+
+	original_num_symbols=alpha->get_num_symbols();
+	SG_UNREF(alpha);
+
+	if (p_order>1)
+		num_symbols=CMath::powl((floatmax_t) 2, (floatmax_t) max_val*p_order);
+	else
+		num_symbols=original_num_symbols;
+
+	if ( ((floatmax_t) num_symbols) > CMath::powl(((floatmax_t) 2),((floatmax_t) sizeof(ST)*8)) )
+	{
+		SG_ERROR("symbol does not fit into datatype \"%c\" (%d)\n", (char) max_val, (int) max_val)
+		return false;
+	}
+
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		int32_t len=CMath::max(pf->get_vector_length(i)-start, 0);
+		features[i].string=SG_MALLOC(ST, len);
+		features[i].slen=len;
+		pf->get_kmers(i, start, p_order, rev, features[i].string);
+	}
+
+	compute_symbol_mask_table(max_val);
+
+	return true;
+}
+
 template<class ST> bool CStringFeatures<ST>::have_same_length(int32_t len)
 {
 	if (len!=-1)
@@ -1854,6 +1898,19 @@ template<> floatmax_t CStringFeatures<floatmax_t>::shift_symbol(floatmax_t symbo
 	return symbol;
 }
 
+template<> bool CStringFeatures<float32_t>::obtain_from_packed(CPackedStringFeatures* pf, int32_t start, int32_t p_order, bool rev)
+{
+	return false;
+}
+template<> bool CStringFeatures<float64_t>::obtain_from_packed(CPackedStringFeatures* pf, int32_t start, int32_t p_order, bool rev)
+{
+	return false;
+}
+template<> bool CStringFeatures<floatmax_t>::obtain_from_packed(CPackedStringFeatures* pf, int32_t start, int32_t p_order, bool rev)
+{
+	return false;
+}
+
 #ifndef SUNOS
 template<>	template <class CT> bool CStringFeatures<float32_t>::obtain_from_char_features(CStringFeatures<CT>* sf, int32_t start, int32_t p_order, int32_t gap, bool rev)
 {
@@ -27,6 +27,7 @@ namespace shogun
 class CAlphabet;
 template <class T> class CDynamicArray;
 class CFile;
+class CPackedStringFeatures;
 template <class T> class SGString;
 template <class T> class SGStringList;
 
@@ -554,6 +555,23 @@ template <class ST> class CStringFeatures : public CFeatures
 			bool obtain_from_char_features(CStringFeatures<CT>* sf, int32_t start,
 					int32_t p_order, int32_t gap, bool rev);
 
+		/** obtain string features from packed strings
+		 *
+		 * same as obtain_from_char with gap 0, but the k-mers are extracted
+		 * from the packed words directly, i.e. the strings are never expanded
+		 * to one element per symbol
+		 *
+		 * any subset is removed before, subset of parameter pf is possible
+		 *
+		 * @param pf packed string features
+		 * @param start start
+		 * @param p_order order
+		 * @param rev reverse
+		 * @return if obtaining was successful
+		 */
+		bool obtain_from_packed(CPackedStringFeatures* pf, int32_t start,
+				int32_t p_order, bool rev=false);
+
 		/** check if length of each vector in this feature object equals the
 		 * given length. if existant, only subset is checked
 		 *
@@ -8,12 +8,180 @@
  */
 
 #include <shogun/io/CSVFile.h>
+#include <shogun/io/FastParser.h>
+#include <shogun/io/MemoryMappedFile.h>
 
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/base/Parallel.h>
+
+/* minimal size of a chunk of a memory mapped file that is parsed by one
+ * thread */
+#define CSV_CHUNK_SIZE 65536
 
 using namespace shogun;
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/** parameters for parsing chunks of a memory mapped csv file */
+template <class T> struct CSV_THREAD_PARAM
+{
+	/** mapped file */
+	const char* text;
+	/** chunk boundaries */
+	const uint64_t* chunks;
+	/** index of the first line of each chunk */
+	int32_t* first_line;
+	/** first line of each chunk with too few values, -1 if none */
+	int32_t* bad_line;
+	/** matrix to fill */
+	T* matrix;
+	/** number of lines */
+	int32_t num_lines;
+	/** number of values per line */
+	int32_t num_tokens;
+	/** whether lines are stored as columns or rows */
+	bool transposed;
+	/** delimiter of values */
+	char delimiter;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/* counts the lines of chunks start...end-1 */
+template <class T>
+static void csv_count_helper(int32_t start, int32_t end, int32_t thread, void* p)
+{
+	CSV_THREAD_PARAM<T>* par=(CSV_THREAD_PARAM<T>*) p;
+
+	for (int32_t c=start; c<end; c++)
+	{
+		par->first_line[c+1]=CFastParser::count_lines(
+				&par->text[par->chunks[c]], &par->text[par->chunks[c+1]]);
+	}
+}
+
+/* parses the lines of chunks start...end-1 */
+template <class T>
+static void csv_parse_helper(int32_t start, int32_t end, int32_t thread, void* p)
+{
+	CSV_THREAD_PARAM<T>* par=(CSV_THREAD_PARAM<T>*) p;
+	int32_t num_tokens=par->num_tokens;
+	char delim=par->delimiter;
+
+	for (int32_t c=start; c<end; c++)
+	{
+		const char* pos=&par->text[par->chunks[c]];
+		const char* chunk_end=&par->text[par->chunks[c+1]];
+		const char* line_end=NULL;
+		const char* line=NULL;
+		int32_t current_line=par->first_line[c];
+		par->bad_line[c]=-1;
+
+		while ((line=CFastParser::next_line(pos, chunk_end, line_end)))
+		{
+			T* dst=&par->matrix[int64_t(current_line)*num_tokens];
+			int64_t stride=1;
+			if (par->transposed)
+			{
+				dst=&par->matrix[current_line];
+				stride=par->num_lines;
+			}
+
+			for (int32_t i=0; i<num_tokens; i++)
+			{
+				line=CFastParser::skip_separators(line, line_end, delim);
+				if (line==line_end)
+				{
+					if (par->bad_line[c]<0)
+						par->bad_line[c]=current_line;
+					break;
+				}
+
+				dst[i*stride]=CFastParser::read<T>(line, line_end);
+				line=CFastParser::skip_token(line, line_end, delim);
+			}
+
+			current_line++;
+		}
+	}
+}
+
+template <class T>
+void CCSVFile::get_matrix_mapped(T*& matrix, int32_t& num_feat, int32_t& num_vec)
+{
+	CMemoryMappedFile<char>* mmf=new CMemoryMappedFile<char>(filename);
+	SG_REF(mmf);
+
+	const char* text=mmf->get_map();
+	const char* end=text+mmf->get_size();
+	const char* pos=text;
+	const char* line_end=NULL;
+
+	/* lines are skipped like in the streaming path */
+	for (int32_t i=0; i<m_num_to_skip; i++)
+		CFastParser::skip_line(pos, end);
+
+	/* number of values is determined by the first line */
+	const char* first=pos;
+	const char* line=CFastParser::next_line(first, end, line_end);
+	int32_t num_tokens=line ?
+		CFastParser::count_tokens(line, line_end, m_delimiter) : 0;
+
+	int32_t num_chunks=CMath::max(1, CMath::min(4*parallel->get_num_threads(),
+				(int32_t) ((end-pos)/CSV_CHUNK_SIZE)));
+	SGVector<uint64_t> chunks=mmf->get_line_chunks(num_chunks, pos-text);
+	SGVector<int32_t> first_line(num_chunks+1);
+	SGVector<int32_t> bad_line(num_chunks);
+	first_line[0]=0;
+
+	CSV_THREAD_PARAM<T> params;
+	params.text=text;
+	params.chunks=chunks.vector;
+	params.first_line=first_line.vector;
+	params.bad_line=bad_line.vector;
+	params.matrix=NULL;
+	params.num_lines=0;
+	params.num_tokens=num_tokens;
+	params.transposed=is_data_transposed;
+	params.delimiter=m_delimiter;
+
+	parallel->parallel_for(0, num_chunks, csv_count_helper<T>, &params, 1);
+	for (int32_t c=0; c<num_chunks; c++)
+		first_line[c+1]+=first_line[c];
+
+	int32_t num_lines=first_line[num_chunks];
+	matrix=SG_MALLOC(T, int64_t(num_lines)*num_tokens);
+	params.matrix=matrix;
+	params.num_lines=num_lines;
+
+	SG_SET_LOCALE_C;
+	parallel->parallel_for(0, num_chunks, csv_parse_helper<T>, &params, 1);
+	SG_RESET_LOCALE;
+
+	SG_UNREF(mmf);
+
+	for (int32_t c=0; c<num_chunks; c++)
+	{
+		if (bad_line[c]>=0)
+		{
+			SG_FREE(matrix);
+			matrix=NULL;
+			SG_ERROR("Line %d of file %s contains less than %d values\n",
+					bad_line[c]+m_num_to_skip+1, filename, num_tokens);
+		}
+	}
+
+	if (!is_data_transposed)
+	{
+		num_feat=num_tokens;
+		num_vec=num_lines;
+	}
+	else
+	{
+		num_feat=num_lines;
+		num_vec=num_tokens;
+	}
+}
+
 CCSVFile::CCSVFile()
 {
 	init();
@@ -182,6 +350,12 @@ void CCSVFile::get_matrix(sg_type*& matrix, int32_t& num_feat, int32_t& num_vec)
 	int32_t current_line_idx=0; \
 	SGVector<char> line; \
 	\
+	if (get_mappable_size()>0) \
+	{ \
+		get_matrix_mapped(matrix, num_feat, num_vec); \
+		return; \
+	} \
+	\
 	skip_lines(m_num_to_skip); \
 	num_lines=get_stats(num_tokens); \
 	\
@@ -202,7 +376,7 @@ void CCSVFile::get_matrix(sg_type*& matrix, int32_t& num_feat, int32_t& num_vec)
 			if (!is_data_transposed) \
 				matrix[i+current_line_idx*num_tokens]=m_parser->read_func(); \
 			else \
-				matrix[current_line_idx+i*num_tokens]=m_parser->read_func(); \
+				matrix[current_line_idx+i*num_lines]=m_parser->read_func(); \
 		} \
 		current_line_idx++; \
 	} \
@@ -389,6 +389,17 @@ private:
 	/** skip m_num_skipped lines */
 	void skip_lines(int32_t num_lines);
 
+	/** load a matrix from a memory mapped file: the file is split into
+	 * chunks at line boundaries which are parsed in parallel, every line
+	 * is written directly into the resulting matrix
+	 *
+	 * @param matrix matrix to load (returned by reference)
+	 * @param num_feat number of features (returned by reference)
+	 * @param num_vec number of vectors (returned by reference)
+	 */
+	template <class T>
+	void get_matrix_mapped(T*& matrix, int32_t& num_feat, int32_t& num_vec);
+
 private:
 	/** object for reading lines from file */
 	CLineReader* m_line_reader;
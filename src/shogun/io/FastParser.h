@@ -0,0 +1,446 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#ifndef __FASTPARSER_H__
+#define __FASTPARSER_H__
+
+#include <shogun/lib/config.h>
+#include <shogun/lib/common.h>
+#include <shogun/mathematics/Math.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace shogun
+{
+
+/** @brief Class FastParser splits text that is not zero terminated (e.g. a
+ * memory mapped file) into lines and tokens and converts numbers into values.
+ *
+ * All functions are given the current position and the end of the text,
+ * they never read beyond the end and advance the position behind the parsed
+ * line or number. They do not allocate and are thread safe and can thus be
+ * used to parse different parts of a file in parallel.
+ *
+ * Real numbers with at most 15 significant digits and a decimal exponent of
+ * at most 22 are converted exactly with a single multiplication or division,
+ * everything else (long mantissas, inf, nan, ...) is handed to strtod.
+ */
+class CFastParser
+{
+	public:
+		/** @return whether c is a blank (space, tab or carriage return) */
+		static inline bool is_blank(char c)
+		{
+			return c==' ' || c=='\t' || c=='\r';
+		}
+
+		/** skip blanks
+		 *
+		 * @param p current position
+		 * @param end end of text
+		 * @return position of the first non-blank character or end
+		 */
+		static inline const char* skip_blanks(const char* p, const char* end)
+		{
+			while (p<end && is_blank(*p))
+				p++;
+
+			return p;
+		}
+
+		/** @return whether c separates tokens, i.e. is a blank or the
+		 * delimiter
+		 */
+		static inline bool is_separator(char c, char delimiter)
+		{
+			return c==delimiter || is_blank(c);
+		}
+
+		/** skip a line the way CLineReader does, i.e. empty lines are
+		 * ignored while lines of blanks count
+		 *
+		 * @param p current position, advanced to the beginning of the
+		 * following line
+		 * @param end end of text
+		 */
+		static inline void skip_line(const char*& p, const char* end)
+		{
+			while (p<end && *p=='\n')
+				p++;
+
+			const char* nl=(const char*) memchr(p, '\n', end-p);
+			p=nl ? nl+1 : end;
+		}
+
+		/** find the next line the way CLineReader does, i.e. empty lines
+		 * are skipped while lines of blanks are returned
+		 *
+		 * @param p current position, advanced to the beginning of the line
+		 * following the returned one
+		 * @param end end of text
+		 * @param line_end set to the end of the returned line (the newline
+		 * is not part of the line)
+		 * @return beginning of the line (without leading blanks) or NULL if
+		 * there is no further line
+		 */
+		static inline const char* next_nonempty_line(const char*& p,
+				const char* end, const char*& line_end)
+		{
+			while (p<end && *p=='\n')
+				p++;
+
+			if (p>=end)
+				return NULL;
+
+			const char* nl=(const char*) memchr(p, '\n', end-p);
+			line_end=nl ? nl : end;
+			const char* line=skip_blanks(p, line_end);
+			p=nl ? nl+1 : end;
+
+			return line;
+		}
+
+		/** count lines the way CLineReader does, see next_nonempty_line()
+		 *
+		 * @param p beginning of text
+		 * @param end end of text
+		 * @return number of lines
+		 */
+		static inline int32_t count_nonempty_lines(const char* p,
+				const char* end)
+		{
+			int32_t num=0;
+			const char* line_end=NULL;
+			while (next_nonempty_line(p, end, line_end))
+				num++;
+
+			return num;
+		}
+
+		/** find the next line that contains more than blanks
+		 *
+		 * @param p current position, advanced to the beginning of the line
+		 * following the returned one
+		 * @param end end of text
+		 * @param line_end set to the end of the returned line (the newline
+		 * is not part of the line)
+		 * @return beginning of the line (without leading blanks) or NULL if
+		 * there is no further line
+		 */
+		static inline const char* next_line(const char*& p, const char* end,
+				const char*& line_end)
+		{
+			while (p<end)
+			{
+				const char* nl=(const char*) memchr(p, '\n', end-p);
+				const char* stop=nl ? nl : end;
+				const char* line=skip_blanks(p, stop);
+				p=nl ? nl+1 : end;
+
+				if (line<stop)
+				{
+					line_end=stop;
+					return line;
+				}
+			}
+
+			return NULL;
+		}
+
+		/** count lines that contain more than blanks
+		 *
+		 * @param p beginning of text
+		 * @param end end of text
+		 * @return number of lines
+		 */
+		static inline int32_t count_lines(const char* p, const char* end)
+		{
+			int32_t num=0;
+			const char* line_end=NULL;
+			while (next_line(p, end, line_end))
+				num++;
+
+			return num;
+		}
+
+		/** count tokens of a line, consecutive separators are treated as
+		 * one
+		 *
+		 * @param p beginning of line
+		 * @param end end of line
+		 * @param delimiter delimiter that separates tokens besides blanks
+		 * @return number of tokens
+		 */
+		static inline int32_t count_tokens(const char* p, const char* end,
+				char delimiter)
+		{
+			int32_t num=0;
+			while (true)
+			{
+				p=skip_separators(p, end, delimiter);
+				if (p==end)
+					break;
+
+				num++;
+				p=skip_token(p, end, delimiter);
+			}
+
+			return num;
+		}
+
+		/** @return position of the first character that is not a separator
+		 * or end
+		 */
+		static inline const char* skip_separators(const char* p,
+				const char* end, char delimiter)
+		{
+			while (p<end && is_separator(*p, delimiter))
+				p++;
+
+			return p;
+		}
+
+		/** @return position of the first separator or end */
+		static inline const char* skip_token(const char* p, const char* end,
+				char delimiter)
+		{
+			while (p<end && !is_separator(*p, delimiter))
+				p++;
+
+			return p;
+		}
+
+		/** parse a real number
+		 *
+		 * @param p current position, advanced behind the number
+		 * @param end end of text
+		 * @return the number, 0 if there is none
+		 */
+		static inline float64_t read_real(const char*& p, const char* end)
+		{
+			static const float64_t pow10[]={1e0, 1e1, 1e2, 1e3, 1e4, 1e5,
+				1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16,
+				1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+			const char* start=p;
+			bool neg=false;
+			if (p<end && (*p=='-' || *p=='+'))
+			{
+				neg=*p=='-';
+				p++;
+			}
+
+			uint64_t mantissa=0;
+			int32_t num_digits=0;
+			int32_t num_parsed=0;
+			int32_t exp10=0;
+
+			for (; p<end && is_digit(*p); p++, num_parsed++)
+			{
+				if (num_digits<19)
+				{
+					mantissa=mantissa*10+(*p-'0');
+					num_digits+=mantissa>0;
+				}
+				else
+					exp10++;
+			}
+
+			if (p<end && *p=='.')
+			{
+				for (p++; p<end && is_digit(*p); p++, num_parsed++)
+				{
+					if (num_digits<19)
+					{
+						mantissa=mantissa*10+(*p-'0');
+						num_digits+=mantissa>0;
+						exp10--;
+					}
+				}
+			}
+
+			if (!num_parsed)
+				return read_real_slow(start, p, end);
+
+			if (p<end && (*p=='e' || *p=='E'))
+			{
+				const char* e=p+1;
+				bool exp_neg=false;
+				if (e<end && (*e=='-' || *e=='+'))
+				{
+					exp_neg=*e=='-';
+					e++;
+				}
+
+				if (e<end && is_digit(*e))
+				{
+					int32_t exponent=0;
+					for (; e<end && is_digit(*e); e++)
+					{
+						if (exponent<100000)
+							exponent=exponent*10+(*e-'0');
+					}
+
+					exp10+=exp_neg ? -exponent : exponent;
+					p=e;
+				}
+			}
+
+			if (num_digits>15 || exp10<-22 || exp10>22)
+				return read_real_slow(start, p, end);
+
+			float64_t result=(float64_t) mantissa;
+			if (exp10<0)
+				result/=pow10[-exp10];
+			else
+				result*=pow10[exp10];
+
+			return neg ? -result : result;
+		}
+
+		/** parse a signed integer
+		 *
+		 * @param p current position, advanced behind the number
+		 * @param end end of text
+		 * @return the number, 0 if there is none
+		 */
+		static inline int64_t read_long(const char*& p, const char* end)
+		{
+			bool neg=false;
+			if (p<end && (*p=='-' || *p=='+'))
+			{
+				neg=*p=='-';
+				p++;
+			}
+
+			uint64_t result=read_ulong(p, end);
+			return neg ? -(int64_t) result : (int64_t) result;
+		}
+
+		/** parse an unsigned integer
+		 *
+		 * @param p current position, advanced behind the number
+		 * @param end end of text
+		 * @return the number, 0 if there is none
+		 */
+		static inline uint64_t read_ulong(const char*& p, const char* end)
+		{
+			if (p<end && *p=='+')
+				p++;
+
+			uint64_t result=0;
+			for (; p<end && is_digit(*p); p++)
+				result=result*10+(*p-'0');
+
+			return result;
+		}
+
+		/** parse a long real number (precision of strtold)
+		 *
+		 * @param p current position, advanced behind the number
+		 * @param end end of text
+		 * @return the number, 0 if there is none
+		 */
+		static inline floatmax_t read_long_real(const char*& p, const char* end)
+		{
+			char buf[NUMBER_BUFFER_SIZE];
+			int32_t len=copy_token(p, end, buf);
+			char* stop=buf;
+#ifdef HAVE_STRTOLD
+			floatmax_t result=strtold(buf, &stop);
+#else
+			floatmax_t result=strtod(buf, &stop);
+#endif
+			p+=CMath::min(len, (int32_t) (stop-buf));
+			return result;
+		}
+
+		/** parse a number as the given type, integer types are parsed as
+		 * real numbers and truncated (like CParser does)
+		 *
+		 * @param p current position, advanced behind the number
+		 * @param end end of text
+		 * @return the number
+		 */
+		template <class T>
+		static inline T read(const char*& p, const char* end)
+		{
+			return (T) read_real(p, end);
+		}
+
+	private:
+		/** maximum length of a number handed to strtod */
+		static const int32_t NUMBER_BUFFER_SIZE=128;
+
+		/** @return whether c is a decimal digit */
+		static inline bool is_digit(char c)
+		{
+			return c>='0' && c<='9';
+		}
+
+		/** copy text starting at p into zero terminated buffer buf
+		 * @return number of copied characters
+		 */
+		static inline int32_t copy_token(const char* p, const char* end,
+				char* buf)
+		{
+			int32_t len=0;
+			while (p+len<end && len<NUMBER_BUFFER_SIZE-1 && p[len]!='\n')
+			{
+				buf[len]=p[len];
+				len++;
+			}
+			buf[len]='\0';
+
+			return len;
+		}
+
+		/** convert the number at start with strtod
+		 *
+		 * @param start beginning of the number
+		 * @param p set behind the number
+		 * @param end end of text
+		 * @return the number
+		 */
+		static inline float64_t read_real_slow(const char* start,
+				const char*& p, const char* end)
+		{
+			char buf[NUMBER_BUFFER_SIZE];
+			int32_t len=copy_token(start, end, buf);
+			char* stop=buf;
+			float64_t result=strtod(buf, &stop);
+			p=start+CMath::min(len, (int32_t) (stop-buf));
+
+			return result;
+		}
+};
+
+/** 64 bit integers are parsed exactly */
+template <>
+inline int64_t CFastParser::read<int64_t>(const char*& p, const char* end)
+{
+	return read_long(p, end);
+}
+
+/** 64 bit integers are parsed exactly */
+template <>
+inline uint64_t CFastParser::read<uint64_t>(const char*& p, const char* end)
+{
+	return read_ulong(p, end);
+}
+
+/** long reals are parsed with full precision */
+template <>
+inline floatmax_t CFastParser::read<floatmax_t>(const char*& p, const char* end)
+{
+	return read_long_real(p, end);
+}
+}
+#endif /* __FASTPARSER_H__ */
@@ -11,6 +11,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <sys/stat.h>
 
 #include <shogun/io/File.h>
 #include <shogun/lib/memory.h>
@@ -237,3 +238,15 @@ char* CFile::read_whole_file(char* fname, size_t& len)
     fclose(tmpf);
     return result;
 }
+
+int64_t CFile::get_mappable_size()
+{
+	if (!filename || !file || task!='r' || ftell(file)!=0)
+		return 0;
+
+	struct stat sb;
+	if (stat(filename, &sb)!=0 || !S_ISREG(sb.st_mode))
+		return 0;
+
+	return sb.st_size;
+}
@@ -497,6 +497,14 @@ public:
     static char* read_whole_file(char* fname, size_t& len);
 
 protected:
+	/** get the size of the file if it can be memory mapped for reading,
+	 * i.e. it is a regular, non-empty file that was opened by name in read
+	 * mode and from which nothing has been read yet
+	 *
+	 * @return size of the file in bytes or 0 if it cannot be mapped
+	 */
+	int64_t get_mappable_size();
+
 	/** file object */
 	FILE* file;
 	/** task */
@@ -73,6 +73,18 @@ void CIOBuffer::reset_file()
 	space.end = space.begin;
 }
 
+void CIOBuffer::seek_file(int64_t offset)
+{
+	lseek(working_file, offset, SEEK_SET);
+	endloaded = space.begin;
+	space.end = space.begin;
+}
+
+int64_t CIOBuffer::tell_file()
+{
+	return lseek(working_file, 0, SEEK_CUR)-(endloaded-space.end);
+}
+
 void CIOBuffer::set(char *p)
 {
 	space.end = p;
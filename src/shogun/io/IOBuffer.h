@@ -90,6 +90,21 @@ namespace shogun
 	 */
 	virtual void reset_file();
 
+	/**
+	 * Seek to a byte offset of the file, reset the buffer markers.
+	 *
+	 * @param offset offset from the beginning of the file
+	 */
+	void seek_file(int64_t offset);
+
+	/**
+	 * Get the offset in the file of the next byte to be read
+	 * from the buffer.
+	 *
+	 * @return offset from the beginning of the file
+	 */
+	int64_t tell_file();
+
 	/**
 	 * Set the buffer marker to a position.
 	 *
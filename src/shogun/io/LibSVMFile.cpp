@@ -8,13 +8,160 @@
  */
 
 #include <shogun/io/LibSVMFile.h>
+#include <shogun/io/FastParser.h>
+#include <shogun/io/MemoryMappedFile.h>
 
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/SGSparseVector.h>
 #include <shogun/base/DynArray.h>
+#include <shogun/base/Parallel.h>
+
+/* minimal size of a chunk of a memory mapped file that is parsed by one
+ * thread */
+#define LIBSVM_CHUNK_SIZE 65536
 
 using namespace shogun;
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/** parameters for parsing chunks of a memory mapped libsvm file */
+template <class T> struct LIBSVM_THREAD_PARAM
+{
+	/** mapped file */
+	const char* text;
+	/** chunk boundaries */
+	const uint64_t* chunks;
+	/** index of the first vector of each chunk */
+	int32_t* first_vec;
+	/** largest feature index of each chunk */
+	int32_t* max_feat;
+	/** matrix to fill */
+	SGSparseVector<T>* matrix;
+	/** labels to fill */
+	float64_t* labels;
+	/** delimiter of feature index and value */
+	char delimiter;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/* counts the vectors of chunks start...end-1 */
+template <class T>
+static void libsvm_count_helper(int32_t start, int32_t end, int32_t thread, void* p)
+{
+	LIBSVM_THREAD_PARAM<T>* par=(LIBSVM_THREAD_PARAM<T>*) p;
+
+	for (int32_t c=start; c<end; c++)
+	{
+		par->first_vec[c+1]=CFastParser::count_nonempty_lines(
+				&par->text[par->chunks[c]], &par->text[par->chunks[c+1]]);
+	}
+}
+
+/* parses the vectors of chunks start...end-1 */
+template <class T>
+static void libsvm_parse_helper(int32_t start, int32_t end, int32_t thread, void* p)
+{
+	LIBSVM_THREAD_PARAM<T>* par=(LIBSVM_THREAD_PARAM<T>*) p;
+
+	for (int32_t c=start; c<end; c++)
+	{
+		const char* pos=&par->text[par->chunks[c]];
+		const char* chunk_end=&par->text[par->chunks[c+1]];
+		const char* line_end=NULL;
+		const char* line=NULL;
+		int32_t vec=par->first_vec[c];
+		int32_t max_feat=0;
+
+		/* lines of blanks are empty vectors, like in the streaming path */
+		while ((line=CFastParser::next_nonempty_line(pos, chunk_end, line_end)))
+		{
+			if (par->labels)
+			{
+				par->labels[vec]=0;
+				if (line<line_end)
+					par->labels[vec]=CFastParser::read_real(line, line_end);
+				line=CFastParser::skip_token(line, line_end, ' ');
+			}
+
+			int32_t num_entries=CFastParser::count_tokens(line, line_end, ' ');
+			par->matrix[vec]=SGSparseVector<T>(num_entries);
+			SGSparseVectorEntry<T>* entries=par->matrix[vec].features;
+
+			for (int32_t i=0; i<num_entries; i++)
+			{
+				line=CFastParser::skip_separators(line, line_end, ' ');
+
+				int32_t feat_index=(int32_t) CFastParser::read_real(line, line_end);
+				T entry=0;
+				if (line<line_end && *line==par->delimiter)
+				{
+					line++;
+					entry=CFastParser::read<T>(line, line_end);
+				}
+				line=CFastParser::skip_token(line, line_end, ' ');
+
+				if (feat_index>max_feat)
+					max_feat=feat_index;
+
+				entries[i].feat_index=feat_index-1;
+				entries[i].entry=entry;
+			}
+
+			vec++;
+		}
+
+		par->max_feat[c]=max_feat;
+	}
+}
+
+template <class T>
+void CLibSVMFile::get_sparse_matrix_mapped(SGSparseVector<T>*& matrix,
+		int32_t& num_feat, int32_t& num_vec, float64_t*& labels,
+		bool load_labels)
+{
+	CMemoryMappedFile<char>* mmf=new CMemoryMappedFile<char>(filename);
+	SG_REF(mmf);
+
+	int32_t num_chunks=CMath::max(1, CMath::min(4*parallel->get_num_threads(),
+				(int32_t) (mmf->get_size()/LIBSVM_CHUNK_SIZE)));
+	SGVector<uint64_t> chunks=mmf->get_line_chunks(num_chunks);
+	SGVector<int32_t> first_vec(num_chunks+1);
+	SGVector<int32_t> max_feat(num_chunks);
+	first_vec[0]=0;
+
+	LIBSVM_THREAD_PARAM<T> params;
+	params.text=mmf->get_map();
+	params.chunks=chunks.vector;
+	params.first_vec=first_vec.vector;
+	params.max_feat=max_feat.vector;
+	params.matrix=NULL;
+	params.labels=NULL;
+	params.delimiter=m_delimiter;
+
+	SG_INFO("counting line numbers in file %s\n", filename)
+	parallel->parallel_for(0, num_chunks, libsvm_count_helper<T>, &params, 1);
+	for (int32_t c=0; c<num_chunks; c++)
+		first_vec[c+1]+=first_vec[c];
+
+	num_vec=first_vec[num_chunks];
+	matrix=SG_MALLOC(SGSparseVector<T>, num_vec);
+	if (load_labels)
+		labels=SG_MALLOC(float64_t, num_vec);
+
+	params.matrix=matrix;
+	params.labels=load_labels ? labels : NULL;
+
+	SG_SET_LOCALE_C;
+	parallel->parallel_for(0, num_chunks, libsvm_parse_helper<T>, &params, 1);
+	SG_RESET_LOCALE;
+
+	num_feat=0;
+	for (int32_t c=0; c<num_chunks; c++)
+		num_feat=CMath::max(num_feat, max_feat[c]);
+
+	SG_UNREF(mmf);
+	SG_INFO("file successfully read\n")
+}
+
 CLibSVMFile::CLibSVMFile()
 {
 	init();
@@ -100,6 +247,12 @@ GET_SPARSE_MATRIX(read_ulong, uint64_t)
 void CLibSVMFile::get_sparse_matrix(SGSparseVector<sg_type>*& matrix, int32_t& num_feat, int32_t& num_vec, \
 					float64_t*& labels, bool load_labels) \
 { \
+	if (get_mappable_size()>0) \
+	{ \
+		get_sparse_matrix_mapped(matrix, num_feat, num_vec, labels, load_labels); \
+		return; \
+	} \
+	\
 	num_feat=0; \
 	\
 	SG_INFO("counting line numbers in file %s\n", filename) \
@@ -126,8 +279,12 @@ void CLibSVMFile::get_sparse_matrix(SGSparseVector<sg_type>*& matrix, int32_t& n
 		m_parser->set_tokenizer(m_whitespace_tokenizer); \
 		m_parser->set_text(line); \
 		\
-		if (load_labels && m_parser->has_next()) \
-			labels[current_line_ind]=m_parser->read_real(); \
+		if (load_labels) \
+		{ \
+			labels[current_line_ind]=0; \
+			if (m_parser->has_next()) \
+				labels[current_line_ind]=m_parser->read_real(); \
+		} \
 		\
 		while (m_parser->has_next()) \
 		{ \
@@ -447,6 +447,21 @@ private:
 	/** get number of lines */
 	int32_t get_num_lines();
 
+	/** load a sparse matrix from a memory mapped file: the file is split
+	 * into chunks at line boundaries which are parsed in parallel, every
+	 * vector is written directly into the resulting matrix
+	 *
+	 * @param matrix matrix to load (returned by reference)
+	 * @param num_feat number of features (returned by reference)
+	 * @param num_vec number of vectors (returned by reference)
+	 * @param labels labels to load (returned by reference)
+	 * @param load_labels whether the first token of a line is a label
+	 */
+	template <class T>
+	void get_sparse_matrix_mapped(SGSparseVector<T>*& matrix,
+			int32_t& num_feat, int32_t& num_vec, float64_t*& labels,
+			bool load_labels);
+
 private:
 	/** delimiter for index and data in sparse entries */
 	char m_delimiter;
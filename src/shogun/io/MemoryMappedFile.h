@@ -13,6 +13,7 @@
 
 #include <shogun/io/SGIO.h>
 #include <shogun/base/SGObject.h>
+#include <shogun/lib/SGVector.h>
 
 #include <stdio.h>
 #include <string.h>
@@ -233,6 +234,42 @@ template <class T> class CMemoryMappedFile : public CSGObject
 			return linecount;
 		}
 
+		/** split the file into parts of roughly equal size that begin at
+		 * the start of a line, e.g. to parse the parts in parallel
+		 *
+		 * @param num_chunks number of parts
+		 * @param offs offset (in bytes) of the first part
+		 * @return start offsets of the parts followed by the size of the
+		 * file (num_chunks+1 entries), parts may be empty
+		 */
+		SGVector<uint64_t> get_line_chunks(int32_t num_chunks, uint64_t offs=0)
+		{
+			REQUIRE(num_chunks>0, "Number of chunks must be positive\n")
+			REQUIRE(offs<=length, "Offset %lu exceeds file size %lu\n",
+					offs, length)
+
+			char* s = (char*) address;
+			SGVector<uint64_t> chunks(num_chunks+1);
+			chunks[0]=offs;
+			for (int32_t i=1; i<num_chunks; i++)
+			{
+				uint64_t pos=offs+((length-offs)*i)/num_chunks;
+				if (pos<chunks[i-1])
+					pos=chunks[i-1];
+
+				/* move behind the next newline */
+				if (pos>offs && pos<length && s[pos-1]!='\n')
+				{
+					char* nl=(char*) memchr(&s[pos], '\n', length-pos);
+					pos=nl ? (nl-s)+1 : length;
+				}
+				chunks[i]=pos;
+			}
+			chunks[num_chunks]=length;
+
+			return chunks;
+		}
+
 		/** operator overload for file read only access
 		 *
 		 * DOES NOT DO ANY BOUNDS CHECKING
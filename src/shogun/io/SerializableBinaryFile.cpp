@@ -0,0 +1,356 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/io/SerializableBinaryFile.h>
+#include <shogun/io/SerializableBinaryReader00.h>
+
+#ifndef WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define STR_HEADER_00                 \
+	"<<_SHOGUN_SERIALIZABLE_BINARY_FILE_V_00_>>"
+
+/* written in native byte order after the header */
+#define BYTE_ORDER_MARK 0x01020304
+
+using namespace shogun;
+
+CSerializableBinaryFile::CSerializableBinaryFile()
+	:CSerializableFile() { init(true); }
+
+CSerializableBinaryFile::CSerializableBinaryFile(FILE* fstream, char rw,
+		bool use_mmap)
+	:CSerializableFile(fstream, rw) { init(use_mmap); }
+
+CSerializableBinaryFile::CSerializableBinaryFile(
+	const char* fname, char rw, bool use_mmap)
+	:CSerializableFile(fname, rw) { init(use_mmap); }
+
+CSerializableBinaryFile::~CSerializableBinaryFile()
+{
+	unmap();
+}
+
+void
+CSerializableBinaryFile::close()
+{
+	unmap();
+	CSerializableFile::close();
+}
+
+void
+CSerializableBinaryFile::init(bool use_mmap)
+{
+	m_use_mmap = use_mmap;
+	m_mapping = NULL;
+	m_mapping_length = 0;
+
+	if (m_fstream == NULL) return;
+
+	switch (m_task) {
+	case 'w':
+	{
+		/* payload lengths are filled in by seeking back, which is not
+		 * possible on e.g. pipes */
+		if (ftell(m_fstream) < 0) {
+			SG_WARNING("Could not open file `%s' for writing, binary "
+					   "serialization requires a seekable stream!\n",
+					   m_filename);
+			close(); return;
+		}
+
+		uint32_t bom = BYTE_ORDER_MARK;
+		if (fprintf(m_fstream, STR_HEADER_00"\n") <= 0
+			|| !write_bytes(&bom, sizeof(bom))) {
+			close(); return;
+		}
+		break;
+	}
+	case 'r': break;
+	default:
+		SG_WARNING("Could not open file `%s', unknown mode!\n",
+				   m_filename);
+		close(); return;
+	}
+}
+
+char*
+CSerializableBinaryFile::map()
+{
+	if (m_mapping != NULL || !m_use_mmap || m_fstream == NULL)
+		return m_mapping;
+
+#ifdef WIN32
+	/* no memory mapping, arrays are read instead */
+	m_use_mmap = false;
+	return NULL;
+#else
+	struct stat st;
+	int fd = fileno(m_fstream);
+	if (fstat(fd, &st) != 0 || st.st_size == 0) {
+		m_use_mmap = false;
+		return NULL;
+	}
+
+	/* private writable mapping: views may be modified in place without
+	 * affecting the file, only touched pages are copied */
+	void* mapping = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE,
+						 MAP_PRIVATE, fd, 0);
+	if (mapping == MAP_FAILED) {
+		SG_DEBUG("Could not map `%s', reading it instead.\n", m_filename)
+		m_use_mmap = false;
+		return NULL;
+	}
+
+	m_mapping = (char*) mapping;
+	m_mapping_length = st.st_size;
+	sg_register_mapped_region(m_mapping, st.st_size);
+
+	return m_mapping;
+#endif
+}
+
+void
+CSerializableBinaryFile::unmap()
+{
+	/* the mapping is released once all views are freed */
+	if (m_mapping != NULL) {
+		sg_unref_mapped_region(m_mapping);
+		m_mapping = NULL;
+		m_mapping_length = 0;
+	}
+}
+
+bool
+CSerializableBinaryFile::write_bytes(const void* buf, size_t len)
+{
+	return fwrite(buf, 1, len, m_fstream) == len;
+}
+
+bool
+CSerializableBinaryFile::write_string(const char* str)
+{
+	uint32_t len = strlen(str);
+
+	return write_bytes(&len, sizeof(len)) && write_bytes(str, len);
+}
+
+CSerializableFile::TSerializableReader*
+CSerializableBinaryFile::new_reader(char* dest_version, size_t n)
+{
+	size_t header_len = strlen(STR_HEADER_00);
+	string_t buf;
+	if (fread(buf, 1, header_len+1, m_fstream) != header_len+1
+		|| buf[header_len] != '\n')
+		return NULL;
+
+	buf[header_len] = '\0';
+	strncpy(dest_version, buf, n < STRING_LEN? n: STRING_LEN);
+
+	if (strcmp(STR_HEADER_00, dest_version) != 0)
+		return NULL;
+
+	uint32_t bom;
+	if (fread(&bom, sizeof(bom), 1, m_fstream) != 1
+		|| bom != BYTE_ORDER_MARK) {
+		SG_WARNING("`%s' was written with a different byte order!\n",
+				   m_filename);
+		return NULL;
+	}
+
+	m_stack_fpos.push_back(ftell(m_fstream));
+
+	return new SerializableBinaryReader00(this);
+}
+
+bool
+CSerializableBinaryFile::write_scalar_wrapped(
+	const TSGDataType* type, const void* param)
+{
+	switch (type->m_ptype) {
+	case PT_BOOL:
+	{
+		uint8_t b = *(bool*) param? 1: 0;
+		return write_bytes(&b, sizeof(b));
+	}
+	case PT_CHAR: case PT_INT8: case PT_UINT8: case PT_INT16:
+	case PT_UINT16: case PT_INT32: case PT_UINT32: case PT_INT64:
+	case PT_UINT64: case PT_FLOAT32: case PT_FLOAT64: case PT_FLOATMAX:
+	case PT_COMPLEX128:
+		return write_bytes(param, type->sizeof_ptype());
+	case PT_UNDEFINED:
+	case PT_SGOBJECT:
+		SG_ERROR("write_scalar_wrapped(): Implementation error during"
+				 " writing BinaryFile!");
+		return false;
+	}
+
+	return false;
+}
+
+bool
+CSerializableBinaryFile::write_cont_begin_wrapped(
+	const TSGDataType* type, index_t len_real_y, index_t len_real_x)
+{
+	return write_bytes(&len_real_y, sizeof(index_t))
+		&& write_bytes(&len_real_x, sizeof(index_t));
+}
+
+bool
+CSerializableBinaryFile::write_cont_end_wrapped(
+	const TSGDataType* type, index_t len_real_y, index_t len_real_x)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_cont_data_wrapped(
+	const TSGDataType* type, const void* data, int64_t num_bytes)
+{
+	/* pad such that the block is aligned within the mapped file */
+	char pad[SERIALIZABLE_BINARY_ALIGNMENT];
+	memset(pad, 0, sizeof(pad));
+	long pos = ftell(m_fstream);
+	if (pos < 0) return false;
+
+	size_t num_pad = (SERIALIZABLE_BINARY_ALIGNMENT
+		- pos%SERIALIZABLE_BINARY_ALIGNMENT)%SERIALIZABLE_BINARY_ALIGNMENT;
+
+	return write_bytes(pad, num_pad) && write_bytes(data, num_bytes);
+}
+
+bool
+CSerializableBinaryFile::write_string_begin_wrapped(
+	const TSGDataType* type, index_t length)
+{
+	return write_bytes(&length, sizeof(index_t));
+}
+
+bool
+CSerializableBinaryFile::write_string_end_wrapped(
+	const TSGDataType* type, index_t length)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_stringentry_begin_wrapped(
+	const TSGDataType* type, index_t y)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_stringentry_end_wrapped(
+	const TSGDataType* type, index_t y)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_sparse_begin_wrapped(
+	const TSGDataType* type, index_t length)
+{
+	return write_bytes(&length, sizeof(index_t));
+}
+
+bool
+CSerializableBinaryFile::write_sparse_end_wrapped(
+	const TSGDataType* type, index_t length)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_sparseentry_begin_wrapped(
+	const TSGDataType* type, const SGSparseVectorEntry<char>* first_entry,
+	index_t feat_index, index_t y)
+{
+	return write_bytes(&feat_index, sizeof(index_t));
+}
+
+bool
+CSerializableBinaryFile::write_sparseentry_end_wrapped(
+	const TSGDataType* type, const SGSparseVectorEntry<char>* first_entry,
+	index_t feat_index, index_t y)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_item_begin_wrapped(
+	const TSGDataType* type, index_t y, index_t x)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_item_end_wrapped(
+	const TSGDataType* type, index_t y, index_t x)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_sgserializable_begin_wrapped(
+	const TSGDataType* type, const char* sgserializable_name,
+	EPrimitiveType generic)
+{
+	/* an empty name denotes a NULL object */
+	int32_t g = generic;
+
+	return write_string(sgserializable_name) && write_bytes(&g, sizeof(g));
+}
+
+bool
+CSerializableBinaryFile::write_sgserializable_end_wrapped(
+	const TSGDataType* type, const char* sgserializable_name,
+	EPrimitiveType generic)
+{
+	/* records never have empty names, so this terminates the object */
+	uint32_t terminator = 0;
+
+	return write_bytes(&terminator, sizeof(terminator));
+}
+
+bool
+CSerializableBinaryFile::write_type_begin_wrapped(
+	const TSGDataType* type, const char* name, const char* prefix)
+{
+	string_t buf;
+	type->to_string(buf, STRING_LEN);
+
+	if (!write_string(name) || !write_string(buf)) return false;
+
+	/* payload length is filled in by write_type_end_wrapped */
+	m_stack_fpos.push_back(ftell(m_fstream));
+	int64_t payload_len = 0;
+
+	return write_bytes(&payload_len, sizeof(payload_len));
+}
+
+bool
+CSerializableBinaryFile::write_type_end_wrapped(
+	const TSGDataType* type, const char* name, const char* prefix)
+{
+	long pos = m_stack_fpos.back();
+	m_stack_fpos.pop_back();
+
+	long end = ftell(m_fstream);
+	int64_t payload_len = end - pos - sizeof(int64_t);
+
+	if (fseek(m_fstream, pos, SEEK_SET) != 0
+		|| !write_bytes(&payload_len, sizeof(payload_len))
+		|| fseek(m_fstream, end, SEEK_SET) != 0)
+		return false;
+
+	return true;
+}
@@ -0,0 +1,181 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+#ifndef __SERIALIZABLE_BINARY_FILE_H__
+#define __SERIALIZABLE_BINARY_FILE_H__
+
+#include <shogun/io/SerializableFile.h>
+#include <shogun/base/DynArray.h>
+
+/** alignment of container data within the file (and thus in memory when
+ * the file is mapped) in bytes */
+#define SERIALIZABLE_BINARY_ALIGNMENT 64
+
+namespace shogun
+{
+/** @brief serializable binary file
+ *
+ * Every parameter is stored as a record consisting of its name, its type
+ * string, the length of the payload and the payload itself. Scalars are
+ * stored as raw bytes in native byte order (a byte order mark in the header
+ * rejects files written on machines of different endianness), records of
+ * unknown parameters are skipped using the payload length.
+ *
+ * The contents of vectors and matrices of primitive types are written as one
+ * contiguous block aligned to SERIALIZABLE_BINARY_ALIGNMENT bytes. When
+ * loading, the file is memory mapped (copy-on-write) and such vectors and
+ * matrices become views into the mapping instead of being copied, i.e.
+ * loading a large model only touches the pages that are actually used.
+ * The mapping stays alive as long as the file or any view exists; views are
+ * released via SG_FREE like ordinary memory, resizing them via SG_REALLOC
+ * copies them to the heap. If the file cannot be mapped, the blocks are read
+ * into freshly allocated memory.
+ *
+ * Strings, sparse vectors and objects are written element by element.
+ * Since the payload length of a record is only known after its payload was
+ * written, writing requires a seekable stream, i.e. pipes and sockets are
+ * rejected when the file is opened.
+ */
+class CSerializableBinaryFile :public CSerializableFile
+{
+	friend class SerializableBinaryReader00;
+
+	/** positions of object starts (reading) and of payload lengths to
+	 * be filled in (writing) */
+	DynArray<long> m_stack_fpos;
+
+	/** whether the file should be memory mapped for reading */
+	bool m_use_mmap;
+
+	/** the memory mapped file, NULL if not (yet) mapped */
+	char* m_mapping;
+
+	/** length of the mapping in bytes */
+	int64_t m_mapping_length;
+
+	void init(bool use_mmap);
+
+	/** map the file for reading, if not already done
+	 *
+	 * @return start of the mapping, NULL if the file cannot be mapped
+	 */
+	char* map();
+
+	/** release the reference of the file to its mapping */
+	void unmap();
+
+	bool write_bytes(const void* buf, size_t len);
+	bool write_string(const char* str);
+
+protected:
+
+	/** new reader
+	 * @param dest_version
+	 * @param n
+	 */
+	virtual TSerializableReader* new_reader(
+		char* dest_version, size_t n);
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+	virtual bool write_scalar_wrapped(
+		const TSGDataType* type, const void* param);
+
+	virtual bool write_cont_begin_wrapped(
+		const TSGDataType* type, index_t len_real_y,
+		index_t len_real_x);
+	virtual bool write_cont_end_wrapped(
+		const TSGDataType* type, index_t len_real_y,
+		index_t len_real_x);
+
+	virtual bool write_string_begin_wrapped(
+		const TSGDataType* type, index_t length);
+	virtual bool write_string_end_wrapped(
+		const TSGDataType* type, index_t length);
+
+	virtual bool write_stringentry_begin_wrapped(
+		const TSGDataType* type, index_t y);
+	virtual bool write_stringentry_end_wrapped(
+		const TSGDataType* type, index_t y);
+
+	virtual bool write_sparse_begin_wrapped(
+		const TSGDataType* type, index_t length);
+	virtual bool write_sparse_end_wrapped(
+		const TSGDataType* type, index_t length);
+
+	virtual bool write_sparseentry_begin_wrapped(
+		const TSGDataType* type, const SGSparseVectorEntry<char>* first_entry,
+		index_t feat_index, index_t y);
+	virtual bool write_sparseentry_end_wrapped(
+		const TSGDataType* type, const SGSparseVectorEntry<char>* first_entry,
+		index_t feat_index, index_t y);
+
+	virtual bool write_item_begin_wrapped(
+		const TSGDataType* type, index_t y, index_t x);
+	virtual bool write_item_end_wrapped(
+		const TSGDataType* type, index_t y, index_t x);
+
+	virtual bool write_sgserializable_begin_wrapped(
+		const TSGDataType* type, const char* sgserializable_name,
+		EPrimitiveType generic);
+	virtual bool write_sgserializable_end_wrapped(
+		const TSGDataType* type, const char* sgserializable_name,
+		EPrimitiveType generic);
+
+	virtual bool write_type_begin_wrapped(
+		const TSGDataType* type, const char* name,
+		const char* prefix);
+	virtual bool write_type_end_wrapped(
+		const TSGDataType* type, const char* name,
+		const char* prefix);
+
+	virtual bool write_cont_data_wrapped(
+		const TSGDataType* type, const void* data, int64_t num_bytes);
+#endif
+public:
+	/** default constructor */
+	explicit CSerializableBinaryFile();
+
+	/** constructor
+	 *
+	 * @param fstream already opened file
+	 * @param rw
+	 * @param use_mmap whether the file is memory mapped for reading
+	 */
+	explicit CSerializableBinaryFile(FILE* fstream, char rw,
+			bool use_mmap=true);
+
+	/** constructor
+	 *
+	 * @param fname filename to open
+	 * @param rw mode, 'r' or 'w'
+	 * @param use_mmap whether the file is memory mapped for reading
+	 */
+	explicit CSerializableBinaryFile(const char* fname, char rw='r',
+			bool use_mmap=true);
+
+	/** default destructor */
+	virtual ~CSerializableBinaryFile();
+
+	/** close, vectors and matrices loaded as views into the mapped file
+	 * stay valid */
+	virtual void close();
+
+	/** @return true, container data is stored as contiguous blocks */
+	virtual bool supports_cont_data() { return true; }
+
+	/** @return whether the file is memory mapped for reading */
+	bool get_use_mmap() const { return m_use_mmap; }
+
+	/** @return object name */
+	virtual const char* get_name() const {
+		return "SerializableBinaryFile";
+	}
+};
+}
+
+#endif /* __SERIALIZABLE_BINARY_FILE_H__  */
@@ -0,0 +1,276 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/io/SerializableBinaryReader00.h>
+#include <shogun/lib/common.h>
+
+using namespace shogun;
+
+SerializableBinaryReader00::SerializableBinaryReader00(
+	CSerializableBinaryFile* file) { m_file = file; }
+
+SerializableBinaryReader00::~SerializableBinaryReader00() {}
+
+bool
+SerializableBinaryReader00::read_bytes(void* buf, size_t len)
+{
+	return fread(buf, 1, len, m_file->m_fstream) == len;
+}
+
+bool
+SerializableBinaryReader00::read_string(char* buf, size_t n)
+{
+	uint32_t len;
+	if (!read_bytes(&len, sizeof(len)) || len >= n) return false;
+	if (!read_bytes(buf, len)) return false;
+	buf[len] = '\0';
+
+	return true;
+}
+
+bool
+SerializableBinaryReader00::skip_records()
+{
+	while (true) {
+		uint32_t len;
+		if (!read_bytes(&len, sizeof(len))) return false;
+
+		/* terminator of the current object */
+		if (len == 0) return true;
+
+		if (fseek(m_file->m_fstream, len, SEEK_CUR) != 0
+			|| !read_bytes(&len, sizeof(len))
+			|| fseek(m_file->m_fstream, len, SEEK_CUR) != 0)
+			return false;
+
+		int64_t payload_len;
+		if (!read_bytes(&payload_len, sizeof(payload_len))
+			|| fseek(m_file->m_fstream, payload_len, SEEK_CUR) != 0)
+			return false;
+	}
+
+	return false;
+}
+
+bool
+SerializableBinaryReader00::read_scalar_wrapped(
+	const TSGDataType* type, void* param)
+{
+	switch (type->m_ptype) {
+	case PT_BOOL:
+	{
+		uint8_t b;
+		if (!read_bytes(&b, sizeof(b))) return false;
+		*(bool*) param = b != 0;
+		return true;
+	}
+	case PT_CHAR: case PT_INT8: case PT_UINT8: case PT_INT16:
+	case PT_UINT16: case PT_INT32: case PT_UINT32: case PT_INT64:
+	case PT_UINT64: case PT_FLOAT32: case PT_FLOAT64: case PT_FLOATMAX:
+	case PT_COMPLEX128:
+		return read_bytes(param, type->sizeof_ptype());
+	case PT_UNDEFINED:
+	case PT_SGOBJECT:
+		SG_ERROR("read_scalar_wrapped(): Implementation error during"
+				 " reading BinaryFile!");
+		return false;
+	}
+
+	return false;
+}
+
+bool
+SerializableBinaryReader00::read_cont_begin_wrapped(
+	const TSGDataType* type, index_t* len_read_y, index_t* len_read_x)
+{
+	return read_bytes(len_read_y, sizeof(index_t))
+		&& read_bytes(len_read_x, sizeof(index_t));
+}
+
+bool
+SerializableBinaryReader00::read_cont_end_wrapped(
+	const TSGDataType* type, index_t len_read_y, index_t len_read_x)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_cont_data_wrapped(
+	const TSGDataType* type, void** data, int64_t num_bytes)
+{
+	long pos = ftell(m_file->m_fstream);
+	if (pos < 0) return false;
+
+	long offset = pos + (SERIALIZABLE_BINARY_ALIGNMENT
+		- pos%SERIALIZABLE_BINARY_ALIGNMENT)%SERIALIZABLE_BINARY_ALIGNMENT;
+
+	char* mapping = m_file->map();
+	if (mapping != NULL) {
+		if (offset + num_bytes > m_file->m_mapping_length) return false;
+
+		*data = mapping + offset;
+		sg_ref_mapped_region(*data);
+
+		return fseek(m_file->m_fstream, offset + num_bytes, SEEK_SET) == 0;
+	}
+
+	if (fseek(m_file->m_fstream, offset, SEEK_SET) != 0) return false;
+
+	*data = SG_MALLOC(char, num_bytes);
+	if (!read_bytes(*data, num_bytes)) {
+		SG_FREE(*data);
+		*data = NULL;
+		return false;
+	}
+
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_string_begin_wrapped(
+	const TSGDataType* type, index_t* length)
+{
+	return read_bytes(length, sizeof(index_t));
+}
+
+bool
+SerializableBinaryReader00::read_string_end_wrapped(
+	const TSGDataType* type, index_t length)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_stringentry_begin_wrapped(
+	const TSGDataType* type, index_t y)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_stringentry_end_wrapped(
+	const TSGDataType* type, index_t y)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_sparse_begin_wrapped(
+	const TSGDataType* type, index_t* length)
+{
+	return read_bytes(length, sizeof(index_t));
+}
+
+bool
+SerializableBinaryReader00::read_sparse_end_wrapped(
+	const TSGDataType* type, index_t length)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_sparseentry_begin_wrapped(
+	const TSGDataType* type, SGSparseVectorEntry<char>* first_entry,
+	index_t* feat_index, index_t y)
+{
+	return read_bytes(feat_index, sizeof(index_t));
+}
+
+bool
+SerializableBinaryReader00::read_sparseentry_end_wrapped(
+	const TSGDataType* type, SGSparseVectorEntry<char>* first_entry,
+	index_t* feat_index, index_t y)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_item_begin_wrapped(
+	const TSGDataType* type, index_t y, index_t x)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_item_end_wrapped(
+	const TSGDataType* type, index_t y, index_t x)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_sgserializable_begin_wrapped(
+	const TSGDataType* type, char* sgserializable_name,
+	EPrimitiveType* generic)
+{
+	int32_t g;
+	if (!read_string(sgserializable_name, STRING_LEN)
+		|| !read_bytes(&g, sizeof(g)))
+		return false;
+
+	*generic = (EPrimitiveType) g;
+	m_file->m_stack_fpos.push_back(ftell(m_file->m_fstream));
+
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_sgserializable_end_wrapped(
+	const TSGDataType* type, const char* sgserializable_name,
+	EPrimitiveType generic)
+{
+	/* parameters might have been read in any order (or not at all), so
+	 * skip over all records of the object up to its terminator */
+	if (fseek(m_file->m_fstream, m_file->m_stack_fpos.back(), SEEK_SET
+			) != 0) return false;
+
+	if (!skip_records()) return false;
+
+	m_file->m_stack_fpos.pop_back();
+
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_type_begin_wrapped(
+	const TSGDataType* type, const char* name, const char* prefix)
+{
+	if (fseek(m_file->m_fstream, m_file->m_stack_fpos.back(), SEEK_SET
+			) != 0) return false;
+
+	string_t type_str;
+	type->to_string(type_str, STRING_LEN);
+
+	string_t r_name, r_type;
+	while (true) {
+		/* fails at the terminator of the current object or at EOF */
+		if (!read_string(r_name, STRING_LEN) || *r_name == '\0'
+			|| !read_string(r_type, STRING_LEN))
+			return false;
+
+		int64_t payload_len;
+		if (!read_bytes(&payload_len, sizeof(payload_len)))
+			return false;
+
+		if (strcmp(r_name, name) == 0
+			&& strcmp(r_type, type_str) == 0) return true;
+
+		if (fseek(m_file->m_fstream, payload_len, SEEK_CUR) != 0)
+			return false;
+	}
+
+	return false;
+}
+
+bool
+SerializableBinaryReader00::read_type_end_wrapped(
+	const TSGDataType* type, const char* name, const char* prefix)
+{
+	return true;
+}
@@ -574,3 +574,29 @@ CSerializableFile::read_type_end(
 
 	return true;
 }
+
+bool
+CSerializableFile::write_cont_data(
+	const TSGDataType* type, const char* name, const char* prefix,
+	const void* data, int64_t num_bytes)
+{
+	if (!is_task_warn('w', name, prefix)) return false;
+
+	if (!write_cont_data_wrapped(type, data, num_bytes))
+		return false_warn(prefix, name);
+
+	return true;
+}
+
+bool
+CSerializableFile::read_cont_data(
+	const TSGDataType* type, const char* name, const char* prefix,
+	void** data, int64_t num_bytes)
+{
+	if (!is_task_warn('r', name, prefix)) return false;
+
+	if (!m_reader->read_cont_data_wrapped(type, data, num_bytes))
+		return false_warn(prefix, name);
+
+	return true;
+}
@@ -83,6 +83,12 @@ public:
 			const TSGDataType* type, const char* name,
 			const char* prefix) = 0;
 
+		virtual bool read_cont_data_wrapped(
+			const TSGDataType* type, void** data, int64_t num_bytes)
+		{
+			return false;
+		}
+
 #endif
 		/* End of abstract write methods  */
 		/* ******************************************************** */
@@ -168,6 +174,12 @@ protected:
 	virtual bool write_type_end_wrapped(
 		const TSGDataType* type, const char* name,
 		const char* prefix) = 0;
+
+	virtual bool write_cont_data_wrapped(
+		const TSGDataType* type, const void* data, int64_t num_bytes)
+	{
+		return false;
+	}
 #endif
 
 	/* End of abstract write methods  */
@@ -200,6 +212,14 @@ public:
 	/** is opened */
 	virtual bool is_opened();
 
+	/** whether the contents of containers of non-object primitive types
+	 * are written and read as one contiguous block via write_cont_data()
+	 * and read_cont_data() instead of element by element
+	 *
+	 * @return false, unless overloaded by a file format
+	 */
+	virtual bool supports_cont_data() { return false; }
+
 	/* ************************************************************ */
 	/* Begin of public wrappers  */
 
@@ -322,6 +342,13 @@ public:
 		const TSGDataType* type, const char* name, const char* prefix);
 	virtual bool read_type_end(
 		const TSGDataType* type, const char* name, const char* prefix);
+
+	virtual bool write_cont_data(
+		const TSGDataType* type, const char* name, const char* prefix,
+		const void* data, int64_t num_bytes);
+	virtual bool read_cont_data(
+		const TSGDataType* type, const char* name, const char* prefix,
+		void** data, int64_t num_bytes);
 #endif
 	/* End of public wrappers  */
 	/* ************************************************************ */
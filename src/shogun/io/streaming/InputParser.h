@@ -17,10 +17,15 @@
 #include <shogun/io/SGIO.h>
 #include <shogun/io/streaming/StreamingFile.h>
 #include <shogun/io/streaming/ParseBuffer.h>
+#include <shogun/mathematics/Math.h>
 #include <pthread.h>
 
 #define PARSER_DEFAULT_BUFFSIZE 100
 
+/* number of bytes of the input parsed in one go by a parse thread, if
+ * several threads are used */
+#define PARSER_SEGMENT_SIZE (1<<20)
+
 namespace shogun
 {
 	/// Type of example, either E_LABELLED
@@ -31,6 +36,19 @@ namespace shogun
 		E_UNLABELLED = 2
 	};
 
+template <class T> class CInputParser;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/** parameters of a parse thread */
+template <class T> struct PARSER_THREAD_PARAM
+{
+	/** parser the thread belongs to */
+	CInputParser<T>* parser;
+	/** index of the thread, selects reader and ring */
+	int32_t thread;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 /** @brief Class CInputParser is a templated class used to
  * maintain the reading/parsing/providing of examples.
  *
@@ -68,8 +86,19 @@ namespace shogun
  * the example, finalize_example() should be called, leaving the
  * spot free for a new example to be loaded.
  *
+ * If the input file asks for several parser threads (see
+ * CStreamingFile::set_num_parser_threads()) and can be opened more than
+ * once (see CStreamingFile::clone_reader()), the input is split into
+ * segments of PARSER_SEGMENT_SIZE bytes, aligned to the next example
+ * (see CStreamingFile::seek_to_example()). Thread k parses the segments
+ * k, k+n, ... through its own reader into its own ring, so every byte
+ * is read by one thread only. The end of a segment is marked in the
+ * ring, and segments are taken from the rings in turn, so examples are
+ * returned in input order.
+ *
  * The parsing thread should be joined with a call to end_parser().
- * exit_parser() may be used to cancel the parse thread if needed.
+ * exit_parser() may be used to stop the parse threads early, they
+ * finish after the example they are parsing.
  *
  * Options are provided for automatic SG_FREEing of example objects
  * after each finalize_example() and also on CInputParser destruction.
@@ -157,12 +186,14 @@ public:
      * @param feature_vector Pointer to feature vector
      * @param length Features in vector
      * @param label Label of example
+     * @param reader reader to read from, input source if NULL
      *
      * @return 1 on success, 0 on failure.
      */
     int32_t get_vector_and_label(T* &feature_vector,
                      int32_t &length,
-                     float64_t &label);
+                     float64_t &label,
+                     CStreamingFile* reader=NULL);
 
     /**
      * Gets feature vector and length by reference.
@@ -171,10 +202,12 @@ public:
      *
      * @param feature_vector Pointer to feature vector
      * @param length Features in vector
+     * @param reader reader to read from, input source if NULL
      *
      * @return 1 on success, 0 on failure
      */
-    int32_t get_vector_only(T* &feature_vector, int32_t &length);
+    int32_t get_vector_only(T* &feature_vector, int32_t &length,
+                     CStreamingFile* reader=NULL);
 
     /**
      * Sets whether to SG_FREE() the vector explicitly
@@ -193,7 +226,7 @@ public:
     void set_free_vectors_on_destruct(bool destroy);
 
     /**
-     * Starts the parser, creating a new thread.
+     * Starts the parser, creating new threads.
      *
      * main_parse_loop is the parsing method.
      */
@@ -203,12 +236,21 @@ public:
      * Main parsing loop. Reads examples from source and stores
      * them in the buffer.
      *
-     * @param params 'this' object
+     * @param params PARSER_THREAD_PARAM of the thread
      *
      * @return NULL
      */
     void* main_parse_loop(void* params);
 
+    /**
+     * Parse the next example of a reader into a ring.
+     *
+     * @param reader reader to read from
+     * @param ring ring to write to
+     *
+     * @return false at the end of the input or if the ring was stopped
+     */
+    bool parse_example(CStreamingFile* reader, CParseBuffer<T>* ring);
 
     /**
      * Copy example into the buffer.
@@ -218,10 +260,11 @@ public:
     void copy_example_into_buffer(Example<T>* ex);
 
     /**
-     * Retrieves the next example from the buffer.
+     * Retrieves the next example from the buffer
+     * without waiting.
      *
-     *
-     * @return The example pointer.
+     * @return The example pointer or NULL if not parsed yet
+     * or if all examples were read.
      */
     Example<T>* retrieve_example();
 
@@ -262,12 +305,13 @@ public:
     void finalize_example();
 
     /**
-     * End the parser, waiting for the parse thread to complete.
+     * End the parser, waiting for the parse threads to complete.
      *
      */
     void end_parser();
 
-    /** Terminates the parsing thread
+    /** Stops the parsing threads after the examples they are
+     * parsing and joins them
      */
     void exit_parser();
 
@@ -278,16 +322,26 @@ public:
      */
     int32_t get_ring_size() { return ring_size; }
 
+    /**
+     * Returns the number of threads parsing the input
+     *
+     * @return number of parse threads
+     */
+    int32_t get_num_parser_threads() { return num_parsers; }
+
 private:
     /**
-     * Entry point for the parse thread.
+     * Entry point for the parse threads.
      *
-     * @param params this object
+     * @param params PARSER_THREAD_PARAM of the thread
      *
      * @return NULL
      */
     static void* parse_loop_entry_point(void* params);
 
+    /** Free rings and readers */
+    void free_rings();
+
 public:
     bool parsing_done;	/**< true if all input is parsed */
     bool reading_done;	/**< true if all examples are fetched */
@@ -314,45 +368,44 @@ protected:
     /// Input source, CStreamingFile object
     CStreamingFile* input_source;
 
-    /// Thread in which the parser runs
-    pthread_t parse_thread;
+    /// Number of parse threads
+    int32_t num_parsers;
 
-    /// The ring of examples, stored as they are parsed
-    CParseBuffer<T>* examples_ring;
+    /// Reader of each parse thread, the first one is the input source
+    CStreamingFile** readers;
 
-    /// Number of features in dataset (max of 'seen' features upto point of access)
-    int32_t number_of_features;
+    /// Threads in which the parsers run
+    pthread_t* parse_threads;
 
-    /// Number of vectors parsed
-    int32_t number_of_vectors_parsed;
+    /// Parameters of the parse threads
+    PARSER_THREAD_PARAM<T>* thread_params;
 
-    /// Number of vectors used by external algorithm
-    int32_t number_of_vectors_read;
+    /// Whether parse threads were started and not joined yet
+    bool threads_started;
 
-    /// Example currently being used
-    Example<T>* current_example;
+    /// The rings of examples of each parse thread
+    CParseBuffer<T>** examples_rings;
 
-    /// Feature vector of current example
-    T* current_feature_vector;
+    /// Ring the next example is read from
+    int32_t current_ring;
 
-    /// Label of current example
-    float64_t current_label;
+    /// Whether the end of each segment is marked in the rings
+    bool use_segments;
 
-    /// Number of features in current example
-    int32_t current_len;
+    /// Number of features in dataset (max of 'seen' features upto point of access)
+    int32_t number_of_features;
+
+    /// Number of vectors used by external algorithm
+    int32_t number_of_vectors_read;
 
     /// Whether to SG_FREE() vector after it is used
     bool free_after_release;
 
+    /// Whether to free the vectors of the rings on destruction
+    bool free_vectors_on_destruct;
+
     /// Size of the ring of examples
     int32_t ring_size;
-
-    /// Mutex which is used when getting/setting state of examples (whether a new example is ready)
-    pthread_mutex_t examples_state_lock;
-
-    /// Condition variable to indicate change of state of examples
-    pthread_cond_t examples_state_changed;
-
 };
 
 template <class T>
@@ -372,12 +425,16 @@ template <class T>
 template <class T>
     CInputParser<T>::CInputParser()
 {
-	/* this line was commented out when I found it. However, the mutex locks
-	 * have to be initialised. Otherwise uninitialised memory error */
-	//init(NULL, true, PARSER_DEFAULT_BUFFSIZE);
-	pthread_mutex_init(&examples_state_lock, NULL);
-	pthread_cond_init(&examples_state_changed, NULL);
-	examples_ring=NULL;
+	input_source=NULL;
+	num_parsers=0;
+	readers=NULL;
+	parse_threads=NULL;
+	thread_params=NULL;
+	threads_started=false;
+	examples_rings=NULL;
+	current_ring=0;
+	use_segments=false;
+	free_vectors_on_destruct=true;
 	parsing_done=true;
 	reading_done=true;
 }
@@ -385,15 +442,39 @@ template <class T>
 template <class T>
     CInputParser<T>::~CInputParser()
 {
-	pthread_mutex_destroy(&examples_state_lock);
-	pthread_cond_destroy(&examples_state_changed);
+	exit_parser();
+	free_rings();
+}
 
-	SG_UNREF(examples_ring);
+template <class T>
+    void CInputParser<T>::free_rings()
+{
+	for (int32_t i=0; i<num_parsers; i++)
+	{
+		SG_UNREF(examples_rings[i]);
+		if (i>0)
+			SG_UNREF(readers[i]);
+	}
+
+	SG_FREE(examples_rings);
+	SG_FREE(readers);
+	SG_FREE(parse_threads);
+	SG_FREE(thread_params);
+	examples_rings=NULL;
+	readers=NULL;
+	parse_threads=NULL;
+	thread_params=NULL;
+	num_parsers=0;
 }
 
 template <class T>
     void CInputParser<T>::init(CStreamingFile* input_file, bool is_labelled, int32_t size)
 {
+    /* further rings are created in start_parser(), once it is known
+     * how many readers the input can provide */
+    exit_parser();
+    free_rings();
+
     input_source = input_file;
 
     if (is_labelled == true)
@@ -401,18 +482,21 @@ template <class T>
     else
         example_type = E_UNLABELLED;
 
-    examples_ring = new CParseBuffer<T>(size);
-    SG_REF(examples_ring);
+    num_parsers = 1;
+    examples_rings = SG_MALLOC(CParseBuffer<T>*, 1);
+    examples_rings[0] = new CParseBuffer<T>(size);
+    examples_rings[0]->set_free_vectors_on_destruct(free_vectors_on_destruct);
+    SG_REF(examples_rings[0]);
+    readers = SG_MALLOC(CStreamingFile*, 1);
+    readers[0] = input_source;
 
     parsing_done = false;
     reading_done = false;
-    number_of_vectors_parsed = 0;
+    threads_started = false;
+    current_ring = 0;
+    use_segments = false;
     number_of_vectors_read = 0;
 
-    current_len = -1;
-    current_label = -1;
-    current_feature_vector = NULL;
-
     free_after_release=true;
     ring_size=size;
 }
@@ -426,7 +510,9 @@ template <class T>
 template <class T>
     void CInputParser<T>::set_free_vectors_on_destruct(bool destroy)
 {
-	examples_ring->set_free_vectors_on_destruct(destroy);
+	free_vectors_on_destruct=destroy;
+	for (int32_t i=0; i<num_parsers; i++)
+		examples_rings[i]->set_free_vectors_on_destruct(destroy);
 }
 
 template <class T>
@@ -438,8 +524,63 @@ template <class T>
         SG_SERROR("Parser thread is already running! Multiple parse threads not supported.\n")
     }
 
-    SG_SDEBUG("creating parse thread\n")
-    pthread_create(&parse_thread, NULL, parse_loop_entry_point, this);
+    if (threads_started)
+    {
+        SG_SDEBUG("leaving CInputParser::start_parser(), parser already started\n")
+        return;
+    }
+
+    /* one reader per thread, stop at the first input that cannot be
+     * cloned. Several threads are only used if the input can be split
+     * into segments and is not partly read yet */
+    int32_t num_threads = input_source->get_num_parser_threads();
+    int64_t input_size = input_source->get_input_size();
+    if (num_threads>1 && (input_size<=PARSER_SEGMENT_SIZE ||
+                input_source->get_example_offset()!=0))
+        num_threads = 1;
+
+    CStreamingFile** all_readers = SG_MALLOC(CStreamingFile*, num_threads);
+    all_readers[0] = input_source;
+
+    int32_t num_readers = 1;
+    for (; num_readers<num_threads; num_readers++)
+    {
+        all_readers[num_readers] = input_source->clone_reader();
+        if (all_readers[num_readers] == NULL)
+        {
+            SG_SWARNING("Input cannot be opened by several readers, parsing with %d thread(s).\n",
+                    num_readers)
+            break;
+        }
+        SG_REF(all_readers[num_readers]);
+    }
+
+    SG_FREE(readers);
+    readers = all_readers;
+
+    examples_rings = SG_REALLOC(CParseBuffer<T>*, examples_rings, num_parsers, num_readers);
+    for (int32_t i=num_parsers; i<num_readers; i++)
+    {
+        examples_rings[i] = new CParseBuffer<T>(ring_size);
+        examples_rings[i]->set_free_vectors_on_destruct(free_vectors_on_destruct);
+        SG_REF(examples_rings[i]);
+    }
+    num_parsers = num_readers;
+    use_segments = num_parsers>1;
+
+    SG_FREE(parse_threads);
+    SG_FREE(thread_params);
+    parse_threads = SG_MALLOC(pthread_t, num_parsers);
+    thread_params = SG_MALLOC(PARSER_THREAD_PARAM<T>, num_parsers);
+
+    SG_SDEBUG("creating %d parse thread(s)\n", num_parsers)
+    for (int32_t i=0; i<num_parsers; i++)
+    {
+        thread_params[i].parser = this;
+        thread_params[i].thread = i;
+        pthread_create(&parse_threads[i], NULL, parse_loop_entry_point, &thread_params[i]);
+    }
+    threads_started = true;
 
     SG_SDEBUG("leaving CInputParser::start_parser()\n")
 }
@@ -447,8 +588,7 @@ template <class T>
 template <class T>
     void* CInputParser<T>::parse_loop_entry_point(void* params)
 {
-    ((CInputParser *) params)->main_parse_loop(params);
-
+    ((PARSER_THREAD_PARAM<T>*) params)->parser->main_parse_loop(params);
     return NULL;
 }
 
@@ -456,19 +596,15 @@ template <class T>
     bool CInputParser<T>::is_running()
 {
 	SG_SDEBUG("entering CInputParser::is_running()\n")
-    bool ret;
 
-    pthread_mutex_lock(&examples_state_lock);
-
-    if (parsing_done)
-        if (reading_done)
-            ret = false;
-        else
-            ret = true;
-    else
-        ret = false;
+    if (!parsing_done && threads_started)
+    {
+        parsing_done = true;
+        for (int32_t i=0; i<num_parsers; i++)
+            parsing_done = parsing_done && examples_rings[i]->is_closed();
+    }
 
-    pthread_mutex_unlock(&examples_state_lock);
+    bool ret = parsing_done && !reading_done;
 
     SG_SDEBUG("leaving CInputParser::is_running(), returning %d\n", ret)
     return ret;
@@ -477,9 +613,13 @@ template <class T>
 template <class T>
     int32_t CInputParser<T>::get_vector_and_label(T* &feature_vector,
                               int32_t &length,
-                              float64_t &label)
+                              float64_t &label,
+                              CStreamingFile* reader)
 {
-    (input_source->*read_vector_and_label)(feature_vector, length, label);
+    if (reader == NULL)
+        reader = input_source;
+
+    (reader->*read_vector_and_label)(feature_vector, length, label);
 
     if (length < 1)
     {
@@ -492,9 +632,13 @@ template <class T>
 
 template <class T>
     int32_t CInputParser<T>::get_vector_only(T* &feature_vector,
-                         int32_t &length)
+                         int32_t &length,
+                         CStreamingFile* reader)
 {
-    (input_source->*read_vector)(feature_vector, length);
+    if (reader == NULL)
+        reader = input_source;
+
+    (reader->*read_vector)(feature_vector, length);
 
     if (length < 1)
     {
@@ -508,135 +652,146 @@ template <class T>
 template <class T>
     void CInputParser<T>::copy_example_into_buffer(Example<T>* ex)
 {
-    examples_ring->copy_example(ex);
+    examples_rings[0]->copy_example(ex);
 }
 
-template <class T> void* CInputParser<T>::main_parse_loop(void* params)
+template <class T>
+    bool CInputParser<T>::parse_example(CStreamingFile* reader, CParseBuffer<T>* ring)
 {
-    // Read the examples into current_* objects
+    // Read the examples into the free slots of the ring
     // Instead of allocating mem for new objects each time
+    Example<T>* ex = ring->get_free_example();
+    if (ex == NULL)
+        return false;
+
+    T* feature_vector = ex->fv;
+    int32_t len = ex->length;
+    float64_t label = ex->label;
+
+    if (example_type == E_LABELLED)
+        get_vector_and_label(feature_vector, len, label, reader);
+    else
+        get_vector_only(feature_vector, len, reader);
+
+    if (len < 0)
+        return false;
+
+    ex->label = label;
+    ex->fv = feature_vector;
+    ex->length = len;
+    ring->write_example(ex);
+
+    return true;
+}
+
+template <class T> void* CInputParser<T>::main_parse_loop(void* params)
+{
 #ifdef HAVE_PTHREAD
-    CInputParser* this_obj = (CInputParser *) params;
-    this->input_source = this_obj->input_source;
+    int32_t thread = ((PARSER_THREAD_PARAM<T>*) params)->thread;
+    CStreamingFile* reader = readers[thread];
+    CParseBuffer<T>* ring = examples_rings[thread];
 
-    while (1)
-	{
-		pthread_mutex_lock(&examples_state_lock);
-		if (parsing_done)
-		{
-			pthread_mutex_unlock(&examples_state_lock);
-			return NULL;
-		}
-		pthread_mutex_unlock(&examples_state_lock);
-
-		pthread_testcancel();
-
-		current_example = examples_ring->get_free_example();
-		current_feature_vector = current_example->fv;
-		current_len = current_example->length;
-		current_label = current_example->label;
-
-		if (example_type == E_LABELLED)
-			get_vector_and_label(current_feature_vector, current_len, current_label);
-		else
-			get_vector_only(current_feature_vector,	current_len);
-
-		if (current_len < 0)
-		{
-			pthread_mutex_lock(&examples_state_lock);
-			parsing_done = true;
-			pthread_cond_signal(&examples_state_changed);
-			pthread_mutex_unlock(&examples_state_lock);
-			return NULL;
-		}
-
-		current_example->label = current_label;
-		current_example->fv = current_feature_vector;
-		current_example->length = current_len;
-
-		examples_ring->copy_example(current_example);
-
-		pthread_mutex_lock(&examples_state_lock);
-		number_of_vectors_parsed++;
-		pthread_cond_signal(&examples_state_changed);
-		pthread_mutex_unlock(&examples_state_lock);
-	}
+    if (!use_segments)
+    {
+        while (parse_example(reader, ring));
+        ring->close();
+        return NULL;
+    }
+
+    /* thread k parses segments k, k+num_parsers, ..., every segment
+     * holds the examples starting in its byte range */
+    int64_t size = input_source->get_input_size();
+    bool more = true;
+    for (int64_t seg=thread; more && seg*PARSER_SEGMENT_SIZE<size; seg+=num_parsers)
+    {
+        int64_t end = CMath::min((seg+1)*PARSER_SEGMENT_SIZE, size);
+        if (!reader->seek_to_example(seg*PARSER_SEGMENT_SIZE))
+            break;
+
+        while (more && reader->get_example_offset()<end)
+            more = parse_example(reader, ring);
+
+        /* the end of the segment is marked by an example of negative
+         * length, which keeps the vector of the slot */
+        Example<T>* ex = ring->get_free_example();
+        if (ex == NULL)
+            break;
+
+        Example<T> marker;
+        marker.fv = ex->fv;
+        marker.length = -1;
+        marker.label = ex->label;
+        ring->write_example(&marker);
+    }
+
+    ring->close();
 #endif /* HAVE_PTHREAD */
     return NULL;
 }
 
 template <class T> Example<T>* CInputParser<T>::retrieve_example()
 {
-    /* This function should be guarded by mutexes while calling  */
-    Example<T> *ex;
+    if (reading_done)
+        return NULL;
 
-    if (parsing_done)
+    while (true)
     {
-        if (number_of_vectors_read == number_of_vectors_parsed)
+        CParseBuffer<T>* ring = examples_rings[current_ring];
+        Example<T>* ex = ring->get_unused_example();
+
+        if (ex == NULL && ring->is_closed())
         {
-            reading_done = true;
-            /* Signal to waiting threads that no more examples are left */
-            pthread_cond_signal(&examples_state_changed);
-            return NULL;
+            /* examples published before closing are visible now */
+            ex = ring->get_unused_example();
+            if (ex == NULL)
+            {
+                parsing_done = true;
+                reading_done = true;
+            }
         }
-    }
 
-    if (number_of_vectors_parsed <= 0)
-        return NULL;
+        if (ex == NULL || ex->length >= 0)
+            return ex;
 
-    if (number_of_vectors_read == number_of_vectors_parsed)
-    {
-        return NULL;
+        /* end of a segment, the next one is in the next ring */
+        ring->finalize_example(false);
+        current_ring = (current_ring + 1) % num_parsers;
     }
-
-    ex = examples_ring->get_unused_example();
-    number_of_vectors_read++;
-
-    return ex;
 }
 
 template <class T> int32_t CInputParser<T>::get_next_example(T* &fv,
         int32_t &length, float64_t &label)
 {
     /* if reading is done, no more examples can be fetched. return 0
-       else, if example can be read, get the example and return 1.
-       otherwise, wait for further parsing, get the example and
-       return 1 */
+       else, wait for the ring holding the next example, get the example
+       and return 1. If the ring is done, so is the input, since the
+       segments are distributed over the rings in turn */
+    if (reading_done || parse_threads == NULL)
+        return 0;
 
-    Example<T> *ex;
+    Example<T>* ex = examples_rings[current_ring]->wait_for_example();
+    while (ex != NULL && ex->length < 0)
+    {
+        /* end of a segment, the next one is in the next ring */
+        examples_rings[current_ring]->finalize_example(false);
+        current_ring = (current_ring + 1) % num_parsers;
+        ex = examples_rings[current_ring]->wait_for_example();
+    }
 
-    while (1)
+    if (ex == NULL)
     {
-        if (reading_done)
-            return 0;
+        parsing_done = true;
+        reading_done = true;
 
-        pthread_mutex_lock(&examples_state_lock);
-        ex = retrieve_example();
+        /* let parse threads waiting for space see the end */
+        for (int32_t i=0; i<num_parsers; i++)
+            examples_rings[i]->release();
 
-        if (ex == NULL)
-        {
-            if (reading_done)
-            {
-                /* No more examples left, return */
-                pthread_mutex_unlock(&examples_state_lock);
-                return 0;
-            }
-            else
-            {
-                /* Examples left, wait for one to become ready */
-                pthread_cond_wait(&examples_state_changed, &examples_state_lock);
-                pthread_mutex_unlock(&examples_state_lock);
-                continue;
-            }
-        }
-        else
-        {
-            /* Example ready, return the example */
-            pthread_mutex_unlock(&examples_state_lock);
-            break;
-        }
+        return 0;
     }
 
+    number_of_vectors_read++;
+
     fv = ex->fv;
     length = ex->length;
     label = ex->label;
@@ -655,21 +810,40 @@ template <class T>
 template <class T>
     void CInputParser<T>::finalize_example()
 {
-    examples_ring->finalize_example(free_after_release);
+    examples_rings[current_ring]->finalize_example(free_after_release);
 }
 
 template <class T> void CInputParser<T>::end_parser()
 {
 	SG_SDEBUG("entering CInputParser::end_parser\n")
-	SG_SDEBUG("joining parse thread\n")
-    pthread_join(parse_thread, NULL);
-    SG_SDEBUG("leaving CInputParser::end_parser\n")
+	if (!threads_started)
+		return;
+
+	for (int32_t i=0; i<num_parsers; i++)
+		examples_rings[i]->release();
+
+	SG_SDEBUG("joining parse threads\n")
+	for (int32_t i=0; i<num_parsers; i++)
+		pthread_join(parse_threads[i], NULL);
+
+	threads_started = false;
+	SG_SDEBUG("leaving CInputParser::end_parser\n")
 }
 
 template <class T> void CInputParser<T>::exit_parser()
 {
-	SG_SDEBUG("cancelling parse thread\n")
-    pthread_cancel(parse_thread);
+	if (!threads_started)
+		return;
+
+	SG_SDEBUG("stopping parse threads\n")
+	for (int32_t i=0; i<num_parsers; i++)
+		examples_rings[i]->stop();
+
+	/* the rings may only be freed once the threads are gone */
+	for (int32_t i=0; i<num_parsers; i++)
+		pthread_join(parse_threads[i], NULL);
+
+	threads_started = false;
 }
 }
 
@@ -14,19 +14,50 @@
 #ifdef HAVE_PTHREAD
 
 #include <shogun/lib/DataType.h>
+#include <shogun/lib/Lock.h>
+#include <shogun/mathematics/Math.h>
 #include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#if defined(HAVE_CXX11_ATOMIC) && !defined(SWIG)
+#include <atomic>
+#endif
 
 namespace shogun
 {
 
-/// Specifies whether location is empty,
-/// contains an unused example or a used example.
-enum E_IS_EXAMPLE_USED
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/** value shared between producer and consumer of a CParseBuffer. Without
+ * std::atomic every access takes a lock that is shared by all values of
+ * the buffer, which also orders the accesses to the ring */
+template <class V> class ParseBufferShared
 {
-	E_EMPTY = 1,
-	E_NOT_USED = 2,
-	E_USED = 3
+public:
+#if defined(HAVE_CXX11_ATOMIC) && !defined(SWIG)
+	void init(V v, CLock* l) { value.store(v); }
+	V load_acquire() const { return value.load(std::memory_order_acquire); }
+	V load_relaxed() const { return value.load(std::memory_order_relaxed); }
+	void store_release(V v) { value.store(v, std::memory_order_release); }
+	void store_relaxed(V v) { value.store(v, std::memory_order_relaxed); }
+	void store_seq_cst(V v) { value.store(v, std::memory_order_seq_cst); }
+
+private:
+	std::atomic<V> value;
+#else
+	void init(V v, CLock* l) { value=v; lock=l; }
+	V load_acquire() const { lock->lock(); V v=value; lock->unlock(); return v; }
+	V load_relaxed() const { return load_acquire(); }
+	void store_release(V v) { lock->lock(); value=v; lock->unlock(); }
+	void store_relaxed(V v) { store_release(v); }
+	void store_seq_cst(V v) { store_release(v); }
+
+private:
+	V value;
+	CLock* lock;
+#endif
 };
+#endif // DOXYGEN_SHOULD_SKIP_THIS
 
 /** @brief Class Example is the container type for
  * the vector+label combination.
@@ -61,8 +92,17 @@ public:
  * when the example is used to make room for another
  * example to take its place.
  *
- * Writing of examples is done into whichever position
- * in the ring is free to be overwritten, or empty.
+ * The ring is a lock-free single producer, single consumer queue:
+ * exactly one thread writes examples and exactly one thread reads
+ * them. Producer and consumer only exchange two counters, the number
+ * of examples written and the number of examples released by the
+ * reader. Both are handed over in batches, such that the cache line
+ * holding a counter moves between the threads only once per batch
+ * and not once per example. A side always hands over everything it
+ * holds before it waits, and does so immediately if the other side
+ * is waiting, such that batching never delays the other side
+ * indefinitely. Waiting spins first, then yields and finally sleeps.
+ * Without C++11 atomics the counters are exchanged under a lock.
  */
 template <class T> class CParseBuffer: public CSGObject
 {
@@ -82,26 +122,17 @@ public:
 
 	/**
 	 * Return the next position to write the example
-	 * into the ring.
+	 * into the ring, waiting for it to be released by the
+	 * reader if necessary. Producer only.
 	 *
-	 * @return pointer to example
+	 * @return pointer to example or NULL if the ring was stopped
 	 */
-	Example<T>* get_free_example()
-	{
-		pthread_mutex_lock(write_lock);
-		pthread_mutex_lock(&ex_in_use_mutex[ex_write_index]);
-		while (ex_used[ex_write_index] == E_NOT_USED)
-			pthread_cond_wait(&ex_in_use_cond[ex_write_index], &ex_in_use_mutex[ex_write_index]);
-		Example<T>* ex=&ex_ring[ex_write_index];
-		pthread_mutex_unlock(&ex_in_use_mutex[ex_write_index]);
-		pthread_mutex_unlock(write_lock);
-
-		return ex;
-	}
+	Example<T>* get_free_example();
 
 	/**
-	 * Writes the given example into the appropriate buffer space.
-	 * Feature vector is copied into a separate block.
+	 * Writes the given example into the next position of the ring,
+	 * which must be free (see get_free_example()). The example's
+	 * members are copied, the vector is not. Producer only.
 	 *
 	 * @param ex Example to copy into buffer
 	 *
@@ -117,15 +148,25 @@ public:
 	Example<T>* return_example_to_read();
 
 	/**
-	 * Returns the next example from the buffer if unused, or NULL.
+	 * Returns the next example from the buffer if it was
+	 * written already, or NULL. Consumer only.
 	 *
 	 * @return unused example object at next 'read' position or NULL.
 	 */
 	Example<T>* get_unused_example();
 
+	/**
+	 * Returns the next example from the buffer, waiting until it
+	 * is written. Consumer only.
+	 *
+	 * @return example at next 'read' position or NULL if the ring
+	 * was closed and all examples were read
+	 */
+	Example<T>* wait_for_example();
+
 	/**
 	 * Copies an example into the buffer, waiting for the
-	 * destination example to be used if necessary.
+	 * destination example to be used if necessary. Producer only.
 	 *
 	 * @param ex Example to copy into buffer
 	 *
@@ -133,15 +174,53 @@ public:
 	 */
 	int32_t copy_example(Example<T>* ex);
 
+	/**
+	 * Make all written examples visible to the reader. Producer only.
+	 */
+	void flush();
+
+	/**
+	 * Flush and indicate that no more examples will be written.
+	 * Producer only.
+	 */
+	void close();
+
+	/** @return whether close() was called */
+	bool is_closed()
+	{
+		return closed.load_acquire();
+	}
+
+	/**
+	 * Ask the producer to stop writing examples, e.g. when the reader
+	 * is not interested in further examples. Consumer only.
+	 */
+	void stop()
+	{
+		stopped.store_release(true);
+	}
+
+	/** @return whether stop() was called */
+	bool is_stopped()
+	{
+		return stopped.load_acquire();
+	}
+
 	/**
 	 * Mark the example in 'read' position as 'used'.
 	 *
-	 * It will then be free to be overwritten.
+	 * It will then be free to be overwritten. Consumer only.
 	 *
 	 * @param free_after_release whether to SG_FREE() the vector or not
 	 */
 	void finalize_example(bool free_after_release);
 
+	/**
+	 * Hand all examples marked as used back to the writer.
+	 * Consumer only.
+	 */
+	void release();
+
 	/**
 	 * Set whether all vectors are to be freed
 	 * on destruction. This is true by default.
@@ -174,80 +253,113 @@ public:
 
 protected:
 	/**
-	 * Increments the 'read' position in the buffer.
+	 * Wait a little while the other side of the ring makes progress,
+	 * spinning first, then yielding and finally sleeping.
 	 *
+	 * @param round number of times waited so far, incremented
 	 */
-	virtual void inc_read_index()
+	static void backoff(int32_t& round)
 	{
-		ex_read_index=(ex_read_index + 1) % ring_size;
-	}
+		if (round<64)
+		{
+			round++;
+			return;
+		}
 
-	/**
-	 * Increments the 'write' position in the buffer.
-	 *
-	 */
-	virtual void inc_write_index()
-	{
-		ex_write_index=(ex_write_index + 1) % ring_size;
+		if (round<128)
+		{
+			round++;
+			sched_yield();
+			return;
+		}
+
+		struct timespec ts={0, 50000};
+		nanosleep(&ts, NULL);
 	}
 
 protected:
 
 	/// Size of ring as number of examples
 	int32_t ring_size;
+	/// Number of examples handed over at once
+	int32_t batch_size;
 	/// Ring of examples
 	Example<T>* ex_ring;
 
-	/// Enum used for representing used/unused/empty state of example
-	E_IS_EXAMPLE_USED* ex_used;
-	/// Lock on state of example - used or unused
-	pthread_mutex_t* ex_in_use_mutex;
-	/// Condition variable triggered when example is being/not being used
-	pthread_cond_t* ex_in_use_cond;
-	/// Lock for reading examples from the ring
-	pthread_mutex_t* read_lock;
-	/// Lock for writing new examples
-	pthread_mutex_t* write_lock;
-
-	/// Write position for next example
-	int32_t ex_write_index;
-	/// Position of next example to be read
-	int32_t ex_read_index;
-
 	/// Whether examples on the ring will be freed on destruction
 	bool free_vectors_on_destruct;
+
+	/// Number of examples written (producer)
+	int64_t ex_write_index;
+	/// Number of examples published (producer)
+	int64_t ex_published_index;
+	/// Last known number of released examples (producer)
+	int64_t ex_released_seen;
+
+	/// Padding to keep producer and consumer data on separate cache lines
+	char padding0[64];
+
+	/// Number of examples read (consumer)
+	int64_t ex_read_index;
+	/// Number of examples released (consumer)
+	int64_t ex_released_index;
+	/// Last known number of published examples (consumer)
+	int64_t ex_published_seen;
+
+	/// Padding to keep producer and consumer data on separate cache lines
+	char padding1[64];
+
+	/// Lock ordering the shared values if there are no atomics
+	CLock shared_lock;
+
+	/// Number of examples visible to the reader
+	ParseBufferShared<int64_t> published;
+	/// Whether the producer is waiting for free space
+	ParseBufferShared<bool> producer_waiting;
+
+	/// Padding to keep the shared counters on separate cache lines
+	char padding2[64];
+
+	/// Number of examples the reader is done with
+	ParseBufferShared<int64_t> released;
+	/// Whether the consumer is waiting for examples
+	ParseBufferShared<bool> consumer_waiting;
+	/// Whether the producer will not write any more examples
+	ParseBufferShared<bool> closed;
+	/// Whether the consumer asked the producer to stop
+	ParseBufferShared<bool> stopped;
 };
 
 template <class T> CParseBuffer<T>::CParseBuffer(int32_t size)
 {
 	ring_size = size;
+	batch_size = CMath::max(1, CMath::min(64, ring_size/4));
 	ex_ring = SG_CALLOC(Example<T>, ring_size);
-	ex_used = SG_MALLOC(E_IS_EXAMPLE_USED, ring_size);
-	ex_in_use_mutex = SG_MALLOC(pthread_mutex_t, ring_size);
-	ex_in_use_cond = SG_MALLOC(pthread_cond_t, ring_size);
-	read_lock = SG_MALLOC(pthread_mutex_t, 1);
-	write_lock = SG_MALLOC(pthread_mutex_t, 1);
 
 	SG_SINFO("Initialized with ring size: %d.\n", ring_size)
 
-	ex_write_index = 0;
-	ex_read_index = 0;
-
 	for (int32_t i=0; i<ring_size; i++)
 	{
-		ex_used[i] = E_EMPTY;
-
 		/* this closes a memory leak, seems to have no bad consequences,
 		 * but I am not completely sure due to lack of any tests */
 		//ex_ring[i].fv = SG_MALLOC(T, 1);
 		//ex_ring[i].length = 1;
 		ex_ring[i].label = FLT_MAX;
-
-		pthread_cond_init(&ex_in_use_cond[i], NULL);
-		pthread_mutex_init(&ex_in_use_mutex[i], NULL);
 	}
-	pthread_mutex_init(read_lock, NULL);
-	pthread_mutex_init(write_lock, NULL);
+
+	ex_write_index = 0;
+	ex_published_index = 0;
+	ex_released_seen = 0;
+	ex_read_index = 0;
+	ex_released_index = 0;
+	ex_published_seen = 0;
+
+	published.init(0, &shared_lock);
+	released.init(0, &shared_lock);
+	producer_waiting.init(false, &shared_lock);
+	consumer_waiting.init(false, &shared_lock);
+	closed.init(false, &shared_lock);
+	stopped.init(false, &shared_lock);
 
 	free_vectors_on_destruct = true;
 }
@@ -262,103 +374,159 @@ template <class T> CParseBuffer<T>::~CParseBuffer()
 					get_name(), get_name(), i, ex_ring[i].fv);
 			SG_FREE(ex_ring[i].fv);
 		}
-		pthread_mutex_destroy(&ex_in_use_mutex[i]);
-		pthread_cond_destroy(&ex_in_use_cond[i]);
 	}
 	SG_FREE(ex_ring);
-	SG_FREE(ex_used);
-	SG_FREE(ex_in_use_mutex);
-	SG_FREE(ex_in_use_cond);
+}
 
-	SG_FREE(read_lock);
-	SG_FREE(write_lock);
+template <class T>
+Example<T>* CParseBuffer<T>::get_free_example()
+{
+	if (ex_write_index-ex_released_seen >= ring_size)
+	{
+		int32_t round=0;
+		while (1)
+		{
+			ex_released_seen=released.load_acquire();
+			if (ex_write_index-ex_released_seen < ring_size)
+				break;
+
+			/* let the reader see everything before waiting for it */
+			if (ex_published_index<ex_write_index)
+				flush();
+
+			producer_waiting.store_seq_cst(true);
+			if (is_stopped())
+			{
+				producer_waiting.store_relaxed(false);
+				return NULL;
+			}
+
+			backoff(round);
+		}
+		producer_waiting.store_relaxed(false);
+	}
+
+	return &ex_ring[ex_write_index % ring_size];
 }
 
 template <class T>
 int32_t CParseBuffer<T>::write_example(Example<T> *ex)
 {
-	ex_ring[ex_write_index].label = ex->label;
-	ex_ring[ex_write_index].fv = ex->fv;
-	ex_ring[ex_write_index].length = ex->length;
-	ex_used[ex_write_index] = E_NOT_USED;
-	inc_write_index();
+	if (ex_write_index-ex_released_seen >= ring_size)
+		return 0;
+
+	Example<T>* slot=&ex_ring[ex_write_index % ring_size];
+	slot->label = ex->label;
+	slot->fv = ex->fv;
+	slot->length = ex->length;
+	ex_write_index++;
+
+	if (ex_write_index-ex_published_index >= batch_size ||
+			consumer_waiting.load_relaxed())
+		flush();
 
 	return 1;
 }
 
+template <class T>
+void CParseBuffer<T>::flush()
+{
+	published.store_release(ex_write_index);
+	ex_published_index=ex_write_index;
+}
+
+template <class T>
+void CParseBuffer<T>::close()
+{
+	flush();
+	closed.store_release(true);
+}
+
 template <class T>
 Example<T>* CParseBuffer<T>::return_example_to_read()
 {
-	if (ex_read_index >= 0)
-		return &ex_ring[ex_read_index];
-	else
-		return NULL;
+	return &ex_ring[ex_read_index % ring_size];
 }
 
 template <class T>
 Example<T>* CParseBuffer<T>::get_unused_example()
 {
-	pthread_mutex_lock(read_lock);
+	if (ex_read_index >= ex_published_seen)
+	{
+		ex_published_seen=published.load_acquire();
+		if (ex_read_index >= ex_published_seen)
+			return NULL;
+	}
 
-	Example<T> *ex;
-	int32_t current_index = ex_read_index;
-	// Because read index will change after return_example_to_read
+	return return_example_to_read();
+}
 
-	pthread_mutex_lock(&ex_in_use_mutex[current_index]);
+template <class T>
+Example<T>* CParseBuffer<T>::wait_for_example()
+{
+	Example<T>* ex=get_unused_example();
+	if (ex)
+		return ex;
 
-	if (ex_used[current_index] == E_NOT_USED)
-		ex = return_example_to_read();
-	else
-		ex = NULL;
+	/* let the writer reuse everything before waiting for it */
+	release();
+	consumer_waiting.store_seq_cst(true);
 
-	pthread_mutex_unlock(&ex_in_use_mutex[current_index]);
+	int32_t round=0;
+	while (!(ex=get_unused_example()))
+	{
+		/* examples published before closing are visible now */
+		if (is_closed())
+		{
+			ex=get_unused_example();
+			break;
+		}
+
+		backoff(round);
+	}
 
-	pthread_mutex_unlock(read_lock);
+	consumer_waiting.store_relaxed(false);
 	return ex;
 }
 
 template <class T>
 int32_t CParseBuffer<T>::copy_example(Example<T> *ex)
 {
-	pthread_mutex_lock(write_lock);
-	int32_t ret;
-	int32_t current_index = ex_write_index;
+	if (!get_free_example())
+		return 0;
 
-	pthread_mutex_lock(&ex_in_use_mutex[current_index]);
-	while (ex_used[ex_write_index] == E_NOT_USED)
-	{
-		pthread_cond_wait(&ex_in_use_cond[ex_write_index], &ex_in_use_mutex[ex_write_index]);
-	}
-
-	ret = write_example(ex);
-
-	pthread_mutex_unlock(&ex_in_use_mutex[current_index]);
-	pthread_mutex_unlock(write_lock);
-
-	return ret;
+	return write_example(ex);
 }
 
 template <class T>
 void CParseBuffer<T>::finalize_example(bool free_after_release)
 {
-	pthread_mutex_lock(read_lock);
-	pthread_mutex_lock(&ex_in_use_mutex[ex_read_index]);
-	ex_used[ex_read_index] = E_USED;
+	Example<T>* ex=return_example_to_read();
 
 	if (free_after_release)
 	{
 		SG_DEBUG("Freeing object in ring at index %d and address: %p.\n",
-			 ex_read_index, ex_ring[ex_read_index].fv);
+			 ex_read_index % ring_size, ex->fv);
 
-		SG_FREE(ex_ring[ex_read_index].fv);
-		ex_ring[ex_read_index].fv=NULL;
+		SG_FREE(ex->fv);
+		ex->fv=NULL;
 	}
 
-	pthread_cond_signal(&ex_in_use_cond[ex_read_index]);
-	pthread_mutex_unlock(&ex_in_use_mutex[ex_read_index]);
-	inc_read_index();
+	ex_read_index++;
 
-	pthread_mutex_unlock(read_lock);
+	if (ex_read_index-ex_released_index >= batch_size ||
+			producer_waiting.load_relaxed())
+		release();
+}
+
+template <class T>
+void CParseBuffer<T>::release()
+{
+	if (ex_released_index<ex_read_index)
+	{
+		released.store_release(ex_read_index);
+		ex_released_index=ex_read_index;
+	}
 }
 
 }
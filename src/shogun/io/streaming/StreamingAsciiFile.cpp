@@ -32,6 +32,16 @@ CStreamingAsciiFile::~CStreamingAsciiFile()
 {
 }
 
+CStreamingFile* CStreamingAsciiFile::clone_reader()
+{
+	if (!can_open_again())
+		return NULL;
+
+	CStreamingAsciiFile* reader=new CStreamingAsciiFile(filename, task);
+	reader->set_delimiter(m_delimiter);
+	return reader;
+}
+
 /* Methods for reading dense vectors from an ascii file */
 
 #define GET_VECTOR(fname, conv, sg_type)									\
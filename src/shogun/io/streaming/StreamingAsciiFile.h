@@ -48,6 +48,13 @@ public:
 	 */
 	void set_delimiter(char delimiter);
 
+	/**
+	 * Open another reader of the same file using the same delimiter
+	 *
+	 * @return new reader or NULL if the file cannot be read again
+	 */
+	virtual CStreamingFile* clone_reader();
+
 	/**
 	 * Utility function to convert a string to a boolean value
 	 *
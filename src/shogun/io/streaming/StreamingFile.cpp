@@ -12,6 +12,7 @@
 #include <shogun/io/streaming/StreamingFile.h>
 
 #include <ctype.h>
+#include <sys/stat.h>
 
 namespace shogun
 {
@@ -197,12 +198,14 @@ CStreamingFile::CStreamingFile() : CSGObject()
 {
 	buf=NULL;
 	filename=NULL;
+	num_parser_threads=1;
 }
 
 CStreamingFile::CStreamingFile(const char* fname, char rw) : CSGObject()
 {
 	task=rw;
 	filename=get_strdup(fname);
+	num_parser_threads=1;
 	int mode = O_LARGEFILE;
 
 	switch (rw)
@@ -235,3 +238,55 @@ CStreamingFile::~CStreamingFile()
 	SG_FREE(filename);
 	SG_UNREF(buf);
 }
+
+void CStreamingFile::set_num_parser_threads(int32_t num)
+{
+	REQUIRE(num>0, "Number of parser threads (%d) must be positive\n", num)
+	num_parser_threads=num;
+}
+
+bool CStreamingFile::seek_to_example(int64_t offset)
+{
+	if (!buf || buf->working_file<0)
+		return false;
+
+	if (offset<=0)
+	{
+		buf->seek_file(0);
+		return true;
+	}
+
+	/* skip the rest of the line the byte before offset belongs to */
+	char* line=NULL;
+	buf->seek_file(offset-1);
+	buf->read_line(line);
+
+	return true;
+}
+
+int64_t CStreamingFile::get_example_offset()
+{
+	if (!buf || buf->working_file<0)
+		return -1;
+
+	return buf->tell_file();
+}
+
+int64_t CStreamingFile::get_input_size()
+{
+	struct stat s;
+	if (!can_open_again() || stat(filename, &s)!=0)
+		return 0;
+
+	return s.st_size;
+}
+
+bool CStreamingFile::can_open_again()
+{
+	struct stat s;
+	if (!filename || task!='r' || stat(filename, &s)!=0)
+		return false;
+
+	/* pipes, sockets and ttys cannot be read twice */
+	return S_ISREG(s.st_mode);
+}
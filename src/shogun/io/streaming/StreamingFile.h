@@ -72,6 +72,55 @@ namespace shogun
 		 */
 		virtual void reset_stream() { SG_ERROR("Unable to reset the input stream!\n") }
 
+		/**
+		 * Set the number of threads the input parser uses to parse
+		 * this input. The input is split into segments of a fixed
+		 * number of bytes, which the threads parse in turn, every
+		 * thread through its own reader (see clone_reader()). Inputs
+		 * that cannot be read more than once are always parsed by a
+		 * single thread.
+		 *
+		 * @param num number of parse threads
+		 */
+		void set_num_parser_threads(int32_t num);
+
+		/** @return number of threads used to parse this input */
+		int32_t get_num_parser_threads() const { return num_parser_threads; }
+
+		/**
+		 * Open another reader of the same input, positioned at its
+		 * beginning and using the same settings as this one.
+		 *
+		 * @return new reader or NULL if the input cannot be read again
+		 */
+		virtual CStreamingFile* clone_reader() { return NULL; }
+
+		/**
+		 * Position the reader at the first example that starts at or
+		 * after the given byte offset of the input.
+		 *
+		 * The default implementation works for all formats storing
+		 * one example per line.
+		 *
+		 * @param offset byte offset from the beginning of the input
+		 * @return false if the reader cannot be positioned
+		 */
+		virtual bool seek_to_example(int64_t offset);
+
+		/**
+		 * Get the byte offset of the next example to be read.
+		 *
+		 * @return offset from the beginning of the input, -1 if unknown
+		 */
+		virtual int64_t get_example_offset();
+
+		/**
+		 * Get the size of the input, if it is a regular file.
+		 *
+		 * @return size in bytes, 0 if unknown
+		 */
+		int64_t get_input_size();
+
 		/** @name Dense Vector Access Functions
 		 *
 		 * Functions to access dense vectors of one of several
@@ -289,6 +338,16 @@ namespace shogun
 		/** @return object name */
 		virtual const char* get_name() const { return "StreamingFile"; }
 
+	protected:
+
+		/**
+		 * Whether the handled file is a regular file opened for
+		 * reading, i.e. whether it can be opened again by clone_reader()
+		 *
+		 * @return true if another reader can be opened
+		 */
+		bool can_open_again();
+
 	protected:
 
 		/// Buffer to hold stuff in memory
@@ -297,6 +356,8 @@ namespace shogun
 		char task;
 		/// Name of the handled file
 		char* filename;
+		/// Number of threads used to parse the input
+		int32_t num_parser_threads;
 
 	};
 }
@@ -65,6 +65,20 @@ void CStreamingVwFile::get_vector_and_label(VwExample* &ex, int32_t &len, float6
 		len = -1;	// indicates failure
 }
 
+CStreamingFile* CStreamingVwFile::clone_reader()
+{
+	if (write_to_cache || !can_open_again())
+		return NULL;
+
+	CStreamingVwFile* reader=new CStreamingVwFile(filename, task);
+	CVwEnvironment* parser_env=parser->get_env();
+	reader->set_env(parser_env);
+	reader->set_parser_type(parser_type);
+	SG_UNREF(parser_env);
+
+	return reader;
+}
+
 void CStreamingVwFile::init()
 {
 	parser = new CVwParser();
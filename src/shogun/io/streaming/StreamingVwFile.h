@@ -117,6 +117,15 @@ public:
 
 	virtual bool is_seekable() { return false; }
 
+	/**
+	 * Open another reader of the same file, sharing the environment
+	 * and using the same parser type. Not supported while a cache is
+	 * written, as examples have to be cached in order.
+	 *
+	 * @return new reader or NULL if the file cannot be read again
+	 */
+	virtual CStreamingFile* clone_reader();
+
 	/** @return object name */
 	virtual const char* get_name() const
 	{
@@ -358,6 +358,13 @@ class CCustomKernel: public CKernel
 					? m_col_subset_stack->get_size() : num_rhs;
 		}
 
+		/** @return whether a row or column subset is active */
+		bool has_subsets()
+		{
+			return m_row_subset_stack->has_subsets() ||
+					m_col_subset_stack->has_subsets();
+		}
+
 		/** test whether features have been assigned to lhs and rhs
 		 *
 		 * works with subset
@@ -375,13 +382,13 @@ class CCustomKernel: public CKernel
 		 */
 		SGMatrix<float32_t> get_float32_kernel_matrix()
 		{
-			REQUIRE(!m_row_subset_stack, "%s::get_float32_kernel_matrix(): "
+			REQUIRE(!m_row_subset_stack->has_subsets(), "%s::get_float32_kernel_matrix(): "
 						"Not possible with row subset active! If you want to"
 						" create a %s from another one with a subset, use "
 						"get_kernel_matrix() and the SGMatrix constructor!\n",
 						get_name(), get_name());
 
-			REQUIRE(!m_col_subset_stack, "%s::get_float32_kernel_matrix(): "
+			REQUIRE(!m_col_subset_stack->has_subsets(), "%s::get_float32_kernel_matrix(): "
 					"Not possible with collumn subset active! If you want to"
 					" create a %s from another one with a subset, use "
 					"get_kernel_matrix() and the SGMatrix constructor!\n",
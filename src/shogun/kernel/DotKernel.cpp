@@ -0,0 +1,58 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/lib/config.h>
+#include <shogun/kernel/DotKernel.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/lapack.h>
+
+using namespace shogun;
+
+bool CDotKernel::has_block_computation()
+{
+#ifdef HAVE_LAPACK
+	if (!has_dot_block_transform() || !lhs || !rhs)
+		return false;
+
+	return lhs->get_feature_class()==C_DENSE &&
+		lhs->get_feature_type()==F_DREAL &&
+		rhs->get_feature_class()==C_DENSE &&
+		rhs->get_feature_type()==F_DREAL;
+#else
+	return false;
+#endif
+}
+
+void CDotKernel::compute_block(float64_t* block, int32_t lhs_start,
+		int32_t num_lhs_block, int32_t rhs_start, int32_t num_rhs_block)
+{
+#ifdef HAVE_LAPACK
+	CDenseFeatures<float64_t>* l=(CDenseFeatures<float64_t>*) lhs;
+	CDenseFeatures<float64_t>* r=(CDenseFeatures<float64_t>*) rhs;
+	int32_t dim=l->get_num_features();
+
+	bool free_a, free_b;
+	float64_t* a=l->get_feature_block(lhs_start, num_lhs_block, free_a);
+	float64_t* b=r->get_feature_block(rhs_start, num_rhs_block, free_b);
+
+	/* block = a^T b */
+	cblas_dgemm(CblasColMajor, CblasTrans, CblasNoTrans,
+			num_lhs_block, num_rhs_block, dim, 1.0, a, dim, b, dim,
+			0.0, block, num_lhs_block);
+
+	l->free_feature_block(a, free_a);
+	r->free_feature_block(b, free_b);
+
+	transform_dot_block(block, lhs_start, num_lhs_block, rhs_start,
+			num_rhs_block);
+#else
+	CKernel::compute_block(block, lhs_start, num_lhs_block, rhs_start,
+			num_rhs_block);
+#endif
+}
@@ -122,6 +122,54 @@ class CDotKernel : public CKernel
 		{
 			return ((CDotFeatures*) lhs)->dot(idx_a, ((CDotFeatures*) rhs), idx_b);
 		}
+
+		/** check whether compute_block() is available, i.e. whether the
+		 * kernel is a transform of the dot product
+		 * (has_dot_block_transform()) and both sides are dense float64
+		 * features whose dot products can be computed via BLAS
+		 *
+		 * @return whether blocks can be computed at once
+		 */
+		virtual bool has_block_computation();
+
+		/** compute a block of the (unnormalized) kernel matrix as one
+		 * matrix-matrix product of the lhs and rhs feature vectors followed
+		 * by transform_dot_block()
+		 *
+		 * @param block column major output of size
+		 * num_lhs_block x num_rhs_block
+		 * @param lhs_start first lhs index
+		 * @param num_lhs_block number of lhs vectors
+		 * @param rhs_start first rhs index
+		 * @param num_rhs_block number of rhs vectors
+		 */
+		virtual void compute_block(float64_t* block, int32_t lhs_start,
+				int32_t num_lhs_block, int32_t rhs_start, int32_t num_rhs_block);
+
+		/** check whether compute() only depends on the dot product of the
+		 * two vectors (and on precomputed per vector quantities), i.e.
+		 * whether transform_dot_block() is implemented
+		 *
+		 * @return false, to be overridden by subclasses
+		 */
+		virtual bool has_dot_block_transform() { return false; }
+
+		/** turn a block of dot products into kernel values in place, i.e.
+		 * block[i+j*num_lhs_block] holds the dot product of lhs vector
+		 * lhs_start+i and rhs vector rhs_start+j on input and the
+		 * corresponding (unnormalized) kernel value on output
+		 *
+		 * @param block column major block of size
+		 * num_lhs_block x num_rhs_block
+		 * @param lhs_start first lhs index
+		 * @param num_lhs_block number of lhs vectors
+		 * @param rhs_start first rhs index
+		 * @param num_rhs_block number of rhs vectors
+		 */
+		virtual void transform_dot_block(float64_t* block, int32_t lhs_start,
+				int32_t num_lhs_block, int32_t rhs_start, int32_t num_rhs_block)
+		{
+		}
 };
 }
 #endif /* _DOTKERNEL_H__ */
@@ -128,6 +128,20 @@ float64_t CGaussianKernel::compute(int32_t idx_a, int32_t idx_b)
 	return result_multiplier*exp(-result/width);
 }
 
+void CGaussianKernel::transform_dot_block(float64_t* block, int32_t lhs_start,
+		int32_t num_lhs_block, int32_t rhs_start, int32_t num_rhs_block)
+{
+	const float64_t* sq_l=&sq_lhs[lhs_start];
+	const float64_t* sq_r=&sq_rhs[rhs_start];
+
+	for (int32_t j=0; j<num_rhs_block; j++)
+	{
+		float64_t* col=&block[int64_t(j)*num_lhs_block];
+		for (int32_t i=0; i<num_lhs_block; i++)
+			col[i]=CMath::exp(-(sq_l[i]+sq_r[j]-2*col[i])/width);
+	}
+}
+
 void CGaussianKernel::load_serializable_post() throw (ShogunException)
 {
 	CKernel::load_serializable_post();
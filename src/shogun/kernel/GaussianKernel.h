@@ -145,6 +145,23 @@ class CGaussianKernel: public CDotKernel
 		 */
 		virtual float64_t compute(int32_t idx_a, int32_t idx_b);
 
+		/** @return whether the kernel can be computed from the dot product
+		 * and the precomputed squared norms, i.e. if compact is disabled */
+		virtual bool has_dot_block_transform() { return !m_compact; }
+
+		/** turn a block of dot products into kernel values in place,
+		 * exp(-(||x||^2+||y||^2-2<x,y>)/width)
+		 *
+		 * @param block column major block of size
+		 * num_lhs_block x num_rhs_block
+		 * @param lhs_start first lhs index
+		 * @param num_lhs_block number of lhs vectors
+		 * @param rhs_start first rhs index
+		 * @param num_rhs_block number of rhs vectors
+		 */
+		virtual void transform_dot_block(float64_t* block, int32_t lhs_start,
+				int32_t num_lhs_block, int32_t rhs_start, int32_t num_rhs_block);
+
 		/** Can (optionally) be overridden to post-initialize some member
 		 * variables which are not PARAMETER::ADD'ed. Make sure that at first
 		 * the overridden method BASE_CLASS::LOAD_SERIALIZABLE_POST is called.
@@ -102,6 +102,10 @@ class CGaussianShiftKernel: public CGaussianKernel
 		 */
 		virtual float64_t compute(int32_t idx_a, int32_t idx_b);
 
+		/** @return false, the shifted kernel is no function of the plain
+		 * dot product */
+		virtual bool has_dot_block_transform() { return false; }
+
 	private:
 		void init();
 
@@ -32,10 +32,6 @@
 #include <unistd.h>
 #include <math.h>
 
-#ifdef HAVE_PTHREAD
-#include <pthread.h>
-#endif
-
 using namespace shogun;
 
 CKernel::CKernel() : CSGObject()
@@ -77,6 +73,7 @@ CKernel::~CKernel()
 
 	remove_lhs_and_rhs();
 	SG_UNREF(normalizer);
+	SG_UNREF(m_row_cache);
 
 	SG_INFO("Kernel deleted (%p).\n", this)
 }
@@ -128,6 +125,10 @@ bool CKernel::init(CFeatures* l, CFeatures* r)
 	num_lhs=l->get_num_vectors();
 	num_rhs=r->get_num_vectors();
 
+	/* cached rows refer to the previous features */
+	if (m_row_cache)
+		m_row_cache->reset(num_lhs, num_rhs);
+
 	/* unref "safety" refs from beginning */
 	SG_UNREF(r);
 	SG_UNREF(l);
@@ -145,6 +146,9 @@ bool CKernel::set_normalizer(CKernelNormalizer* n)
 	SG_UNREF(normalizer);
 	normalizer=n;
 
+	if (m_row_cache)
+		m_row_cache->clear();
+
 	return (normalizer!=NULL);
 }
 
@@ -159,6 +163,22 @@ bool CKernel::init_normalizer()
 	return normalizer->init(this);
 }
 
+void CKernel::set_row_cache(CKernelRowCache* cache)
+{
+	SG_REF(cache);
+	SG_UNREF(m_row_cache);
+	m_row_cache=cache;
+
+	if (m_row_cache && has_features())
+		m_row_cache->reset(num_lhs, num_rhs);
+}
+
+CKernelRowCache* CKernel::get_row_cache()
+{
+	SG_REF(m_row_cache);
+	return m_row_cache;
+}
+
 void CKernel::cleanup()
 {
 	remove_lhs_and_rhs();
@@ -194,6 +214,7 @@ void CKernel::kernel_cache_init(int32_t buffsize, bool regression_hack)
 	kernel_cache.index = SG_MALLOC(int32_t, totdoc);
 	kernel_cache.occu = SG_MALLOC(int32_t, totdoc);
 	kernel_cache.lru = SG_MALLOC(int32_t, totdoc);
+	kernel_cache.referenced = SG_MALLOC(char, totdoc);
 	kernel_cache.invindex = SG_MALLOC(int32_t, totdoc);
 	kernel_cache.active2totdoc = SG_MALLOC(int32_t, totdoc);
 	kernel_cache.totdoc2active = SG_MALLOC(int32_t, totdoc);
@@ -209,6 +230,7 @@ void CKernel::kernel_cache_init(int32_t buffsize, bool regression_hack)
 	for(i=0;i<totdoc;i++) {
 		kernel_cache.index[i]=-1;
 		kernel_cache.lru[i]=0;
+		kernel_cache.referenced[i]=0;
 	}
 	for(i=0;i<totdoc;i++) {
 		kernel_cache.occu[i]=0;
@@ -222,6 +244,7 @@ void CKernel::kernel_cache_init(int32_t buffsize, bool regression_hack)
 	}
 
 	kernel_cache.time=0;
+	kernel_cache.clock_hand=0;
 }
 
 void CKernel::get_kernel_row(
@@ -238,6 +261,7 @@ void CKernel::get_kernel_row(
 	if(kernel_cache.index[docnum] != -1)
 	{
 		kernel_cache.lru[kernel_cache.index[docnum]]=kernel_cache.time; /* lru */
+		kernel_cache.referenced[kernel_cache.index[docnum]]=1;
 		start=((KERNELCACHE_IDX) kernel_cache.activenum)*kernel_cache.index[docnum];
 
 		if (full_line)
@@ -361,6 +385,15 @@ void* CKernel::cache_multiple_kernel_row_helper(void* p)
 	return NULL;
 }
 
+void CKernel::cache_multiple_kernel_row_range_helper(int32_t start,
+		int32_t end, int32_t thread, void* p)
+{
+	S_KTHREAD_PARAM params=*((S_KTHREAD_PARAM*) p);
+	params.start=start;
+	params.end=end;
+	cache_multiple_kernel_row_helper((void*) &params);
+}
+
 // Fills cache for the rows in key
 void CKernel::cache_multiple_kernel_rows(int32_t* rows, int32_t num_rows)
 {
@@ -379,16 +412,11 @@ void CKernel::cache_multiple_kernel_rows(int32_t* rows, int32_t num_rows)
 		// fill up kernel cache
 		int32_t* uncached_rows = SG_MALLOC(int32_t, num_rows);
 		KERNELCACHE_ELEM** cache = SG_MALLOC(KERNELCACHE_ELEM*, num_rows);
-		pthread_t* threads = SG_MALLOC(pthread_t, nthreads-1);
-		S_KTHREAD_PARAM* params = SG_MALLOC(S_KTHREAD_PARAM, nthreads-1);
-		int32_t num_threads=nthreads-1;
 		int32_t num_vec=get_num_vec_lhs();
 		ASSERT(num_vec>0)
 		uint8_t* needs_computation=SG_CALLOC(uint8_t, num_vec);
 
-		int32_t step=0;
 		int32_t num=0;
-		int32_t end=0;
 
 		// allocate cachelines if necessary
 		for (int32_t i=0; i<num_rows; i++)
@@ -412,67 +440,24 @@ void CKernel::cache_multiple_kernel_rows(int32_t* rows, int32_t num_rows)
 
 		if (num>0)
 		{
-			step= num/nthreads;
-
-			if (step<1)
-			{
-				num_threads=num-1;
-				step=1;
-			}
-
-			for (int32_t t=0; t<num_threads; t++)
-			{
-				params[t].kernel = this;
-				params[t].kernel_cache = &kernel_cache;
-				params[t].cache = cache;
-				params[t].uncached_rows = uncached_rows;
-				params[t].needs_computation = needs_computation;
-				params[t].num_uncached = num;
-				params[t].start = t*step;
-				params[t].end = (t+1)*step;
-				params[t].num_vectors = get_num_vec_lhs();
-				end=params[t].end;
-
-				int code=pthread_create(&threads[t], NULL,
-						CKernel::cache_multiple_kernel_row_helper, (void*)&params[t]);
-
-				if (code != 0)
-				{
-					SG_WARNING("Thread creation failed (thread %d of %d) "
-							"with error:'%s'\n",t, num_threads, strerror(code));
-					num_threads=t;
-					end=t*step;
-					break;
-				}
-			}
-		}
-		else
-			num_threads=-1;
-
-
-		S_KTHREAD_PARAM last_param;
-		last_param.kernel = this;
-		last_param.kernel_cache = &kernel_cache;
-		last_param.cache = cache;
-		last_param.uncached_rows = uncached_rows;
-		last_param.needs_computation = needs_computation;
-		last_param.start = end;
-		last_param.num_uncached = num;
-		last_param.end = num;
-		last_param.num_vectors = get_num_vec_lhs();
-
-		cache_multiple_kernel_row_helper(&last_param);
-
-
-		for (int32_t t=0; t<num_threads; t++)
-		{
-			if (pthread_join(threads[t], NULL) != 0)
-				SG_WARNING("pthread_join of thread %d/%d failed\n", t, num_threads)
+			S_KTHREAD_PARAM params;
+			params.kernel = this;
+			params.kernel_cache = &kernel_cache;
+			params.cache = cache;
+			params.uncached_rows = uncached_rows;
+			params.needs_computation = needs_computation;
+			params.num_uncached = num;
+			params.start = 0;
+			params.end = num;
+			params.num_vectors = get_num_vec_lhs();
+
+			/* every row is an expensive task of its own */
+			parallel->parallel_for(0, num,
+					CKernel::cache_multiple_kernel_row_range_helper,
+					(void*) &params, 1);
 		}
 
 		SG_FREE(needs_computation);
-		SG_FREE(params);
-		SG_FREE(threads);
 		SG_FREE(cache);
 		SG_FREE(uncached_rows);
 	}
@@ -558,6 +543,7 @@ void CKernel::kernel_cache_cleanup()
 	SG_FREE(kernel_cache.index);
 	SG_FREE(kernel_cache.occu);
 	SG_FREE(kernel_cache.lru);
+	SG_FREE(kernel_cache.referenced);
 	SG_FREE(kernel_cache.invindex);
 	SG_FREE(kernel_cache.active2totdoc);
 	SG_FREE(kernel_cache.totdoc2active);
@@ -587,26 +573,47 @@ void CKernel::kernel_cache_free(int32_t cacheidx)
 	kernel_cache.elems--;
 }
 
-// remove least recently used cache
-// element
+// remove a cache element chosen by CLOCK, an approximation of LRU: the
+// hand passes over the elements and clears their reference bits, the
+// first element whose bit is already clear (i.e. that was not accessed
+// since the hand passed it last) is evicted. Every access sets a bit at
+// most once, so besides skipping the elements used in the current
+// iteration an eviction takes amortized O(1) steps. Elements used in the
+// current iteration are only evicted if there is no other element.
 int32_t CKernel::kernel_cache_free_lru()
 {
-  register int32_t k,least_elem=-1,least_time;
-
-  least_time=kernel_cache.time+1;
-  for(k=0;k<kernel_cache.max_elems;k++) {
-    if(kernel_cache.invindex[k] != -1) {
-      if(kernel_cache.lru[k]<least_time) {
-	least_time=kernel_cache.lru[k];
-	least_elem=k;
-      }
+  register int32_t k,n,victim=-1,fallback=-1;
+  int32_t max_elems=kernel_cache.max_elems;
+
+  if(kernel_cache.clock_hand>=max_elems)
+    kernel_cache.clock_hand=0;
+
+  /* after one round all reference bits are clear */
+  for(n=0;n<2*max_elems;n++) {
+    k=kernel_cache.clock_hand;
+    kernel_cache.clock_hand=(k+1)%max_elems;
+    if(kernel_cache.invindex[k] == -1)
+      continue;
+    if(kernel_cache.lru[k]>=kernel_cache.time) {
+      if(fallback == -1)
+	fallback=k;
+      continue;
+    }
+    if(kernel_cache.referenced[k]) {
+      kernel_cache.referenced[k]=0;
+      continue;
     }
+    victim=k;
+    break;
   }
 
-  if(least_elem != -1) {
-    kernel_cache_free(least_elem);
-    kernel_cache.index[kernel_cache.invindex[least_elem]]=-1;
-    kernel_cache.invindex[least_elem]=-1;
+  if(victim == -1)
+    victim=fallback;
+
+  if(victim != -1) {
+    kernel_cache_free(victim);
+    kernel_cache.index[kernel_cache.invindex[victim]]=-1;
+    kernel_cache.invindex[victim]=-1;
     return(1);
   }
   return(0);
@@ -628,6 +635,7 @@ KERNELCACHE_ELEM* CKernel::kernel_cache_clean_and_malloc(int32_t cacheidx)
 	}
 	kernel_cache.invindex[result]=cacheidx;
 	kernel_cache.lru[kernel_cache.index[cacheidx]]=kernel_cache.time; // lru
+	kernel_cache.referenced[kernel_cache.index[cacheidx]]=1;
 	return &kernel_cache.buffer[((KERNELCACHE_IDX) kernel_cache.activenum)*kernel_cache.index[cacheidx]];
 }
 #endif //USE_SVMLIGHT
@@ -785,6 +793,7 @@ void CKernel::list_kernel()
 		ENUM_CASE(C_LATENT)
 		ENUM_CASE(C_MATRIX)
 		ENUM_CASE(C_FACTOR_GRAPH)
+		ENUM_CASE(C_PACKED_STRING)
 		ENUM_CASE(C_ANY)
 	}
 
@@ -972,6 +981,7 @@ void CKernel::init()
 	opt_type=FASTBUTMEMHUNGRY;
 	properties=KP_NONE;
 	normalizer=NULL;
+	m_row_cache=NULL;
 
 #ifdef USE_SVMLIGHT
 	memset(&kernel_cache, 0x0, sizeof(KERNEL_CACHE));
@@ -1006,8 +1016,42 @@ template <class T> struct K_THREAD_PARAM
 	/** output progress */
 	bool verbose;
 };
+
+/** parameters for blockwise kernel matrix computation */
+template <class T> struct K_BLOCK_THREAD_PARAM
+{
+	/** kernel */
+	CKernel* kernel;
+	/** result */
+	T* result;
+	/** m */
+	int32_t m;
+	/** n */
+	int32_t n;
+	/** number of blocks along the rows */
+	int32_t num_blocks_m;
+	/** number of blocks along the columns */
+	int32_t num_blocks_n;
+	/** kernel matrix k(i,j)=k(j,i) */
+	bool symmetric;
+};
+
+/** kernel row thread parameters */
+struct K_ROW_THREAD_PARAM
+{
+	/** kernel */
+	CKernel* kernel;
+	/** lhs index */
+	int32_t idx;
+	/** result */
+	float64_t* result;
+};
 }
 
+/** number of rows/columns of the blocks in which kernel matrices of kernels
+ * with block computation are computed */
+#define KERNEL_BLOCK_SIZE 256
+
 template <class T> void* CKernel::get_kernel_matrix_helper(void* p)
 {
 	K_THREAD_PARAM<T>* params= (K_THREAD_PARAM<T>*) p;
@@ -1058,6 +1102,99 @@ template <class T> void* CKernel::get_kernel_matrix_helper(void* p)
 	return NULL;
 }
 
+template <class T> void CKernel::get_kernel_matrix_range_helper(
+		int32_t start, int32_t end, int32_t thread, void* p)
+{
+	K_THREAD_PARAM<T> params=*((K_THREAD_PARAM<T>*) p);
+	params.start=start;
+	params.end=end;
+	get_kernel_matrix_helper<T>((void*) &params);
+}
+
+template <class T> void CKernel::get_kernel_matrix_block_helper(
+		int32_t start, int32_t end, int32_t thread, void* p)
+{
+	K_BLOCK_THREAD_PARAM<T>* params=(K_BLOCK_THREAD_PARAM<T>*) p;
+	CKernel* k=params->kernel;
+	T* result=params->result;
+	int32_t m=params->m;
+	int32_t n=params->n;
+	bool symmetric=params->symmetric;
+
+	float64_t* block=SG_MALLOC(float64_t, KERNEL_BLOCK_SIZE*KERNEL_BLOCK_SIZE);
+
+	for (int32_t b=start; b<end && !CSignal::cancel_computations(); b++)
+	{
+		int32_t bi=b%params->num_blocks_m;
+		int32_t bj=b/params->num_blocks_m;
+
+		/* lower triangle is filled by mirroring the upper one */
+		if (symmetric && bj<bi)
+			continue;
+
+		int32_t i_start=bi*KERNEL_BLOCK_SIZE;
+		int32_t j_start=bj*KERNEL_BLOCK_SIZE;
+		int32_t num_i=CMath::min(KERNEL_BLOCK_SIZE, m-i_start);
+		int32_t num_j=CMath::min(KERNEL_BLOCK_SIZE, n-j_start);
+
+		k->compute_block(block, i_start, num_i, j_start, num_j);
+
+		for (int32_t j=0; j<num_j; j++)
+		{
+			for (int32_t i=0; i<num_i; i++)
+			{
+				int32_t row=i_start+i;
+				int32_t col=j_start+j;
+				T v=(T) k->normalizer->normalize(block[i+j*num_i], row, col);
+				result[row+int64_t(col)*m]=v;
+
+				if (symmetric)
+					result[col+int64_t(row)*m]=v;
+			}
+		}
+	}
+
+	SG_FREE(block);
+}
+
+void CKernel::fill_kernel_row_range_helper(int32_t start, int32_t end,
+		int32_t thread, void* p)
+{
+	K_ROW_THREAD_PARAM* params=(K_ROW_THREAD_PARAM*) p;
+	CKernel* k=params->kernel;
+
+	for (int32_t j=start; j<end; j++)
+		params->result[j]=k->kernel(params->idx, j);
+}
+
+void CKernel::fill_kernel_row(int32_t i, float64_t* row)
+{
+	REQUIRE(has_features(), "no features assigned to kernel\n")
+
+	if (m_row_cache && m_row_cache->lookup(i, row, num_rhs))
+		return;
+
+	if (has_block_computation())
+	{
+		compute_block(row, i, 1, 0, num_rhs);
+		for (int32_t j=0; j<num_rhs; j++)
+			row[j]=normalizer->normalize(row[j], i, j);
+	}
+	else
+	{
+		K_ROW_THREAD_PARAM params;
+		params.kernel=this;
+		params.idx=i;
+		params.result=row;
+
+		parallel->parallel_for(0, num_rhs, CKernel::fill_kernel_row_range_helper,
+				(void*) &params);
+	}
+
+	if (m_row_cache)
+		m_row_cache->insert(i, row, num_rhs);
+}
+
 template <class T>
 SGMatrix<T> CKernel::get_kernel_matrix()
 {
@@ -1077,76 +1214,49 @@ SGMatrix<T> CKernel::get_kernel_matrix()
 
 	result=SG_MALLOC(T, total_num);
 
+	if (has_block_computation())
+	{
+		K_BLOCK_THREAD_PARAM<T> block_params;
+		block_params.kernel=this;
+		block_params.result=result;
+		block_params.m=m;
+		block_params.n=n;
+		block_params.num_blocks_m=(m+KERNEL_BLOCK_SIZE-1)/KERNEL_BLOCK_SIZE;
+		block_params.num_blocks_n=(n+KERNEL_BLOCK_SIZE-1)/KERNEL_BLOCK_SIZE;
+		block_params.symmetric=symmetric;
+
+		/* every block is a task of its own */
+		parallel->parallel_for(0,
+				block_params.num_blocks_m*block_params.num_blocks_n,
+				CKernel::get_kernel_matrix_block_helper<T>,
+				(void*) &block_params, 1);
+
+		SG_DONE()
+
+		return SGMatrix<T>(result,m,n,true);
+	}
+
 	int32_t num_threads=parallel->get_num_threads();
+	K_THREAD_PARAM<T> params;
+	params.kernel=this;
+	params.result=result;
+	params.start=0;
+	params.end=m;
+	params.total_start=0;
+	params.total_end=total_num;
+	params.n=n;
+	params.m=m;
+	params.symmetric=symmetric;
+	params.verbose=num_threads<2;
+
 	if (num_threads < 2)
-	{
-		K_THREAD_PARAM<T> params;
-		params.kernel=this;
-		params.result=result;
-		params.start=0;
-		params.end=m;
-		params.total_start=0;
-		params.total_end=total_num;
-		params.n=n;
-		params.m=m;
-		params.symmetric=symmetric;
-		params.verbose=true;
 		get_kernel_matrix_helper<T>((void*) &params);
-	}
 	else
 	{
-		pthread_t* threads = SG_MALLOC(pthread_t, num_threads-1);
-		K_THREAD_PARAM<T>* params = SG_MALLOC(K_THREAD_PARAM<T>, num_threads);
-		int64_t step= total_num/num_threads;
-
-		int32_t t;
-
-		num_threads--;
-		for (t=0; t<num_threads; t++)
-		{
-			params[t].kernel = this;
-			params[t].result = result;
-			params[t].start = compute_row_start(t*step, n, symmetric);
-			params[t].end = compute_row_start((t+1)*step, n, symmetric);
-			params[t].total_start=t*step;
-			params[t].total_end=(t+1)*step;
-			params[t].n=n;
-			params[t].m=m;
-			params[t].symmetric=symmetric;
-			params[t].verbose=false;
-
-			int code=pthread_create(&threads[t], NULL,
-					CKernel::get_kernel_matrix_helper<T>, (void*)&params[t]);
-
-			if (code != 0)
-			{
-				SG_WARNING("Thread creation failed (thread %d of %d) "
-						"with error:'%s'\n",t, num_threads, strerror(code));
-				num_threads=t;
-				break;
-			}
-		}
-
-		params[t].kernel = this;
-		params[t].result = result;
-		params[t].start = compute_row_start(t*step, n, symmetric);
-		params[t].end = m;
-		params[t].total_start=t*step;
-		params[t].total_end=total_num;
-		params[t].n=n;
-		params[t].m=m;
-		params[t].symmetric=symmetric;
-		params[t].verbose=true;
-		get_kernel_matrix_helper<T>(&params[t]);
-
-		for (t=0; t<num_threads; t++)
-		{
-			if (pthread_join(threads[t], NULL) != 0)
-				SG_WARNING("pthread_join of thread %d/%d failed\n", t, num_threads)
-		}
-
-		SG_FREE(params);
-		SG_FREE(threads);
+		/* rows of a symmetric matrix get shorter towards the end, dynamic
+		 * chunking takes care of balancing the load */
+		parallel->parallel_for(0, m, CKernel::get_kernel_matrix_range_helper<T>,
+				(void*) &params);
 	}
 
 	SG_DONE()
@@ -1159,3 +1269,13 @@ template SGMatrix<float32_t> CKernel::get_kernel_matrix<float32_t>();
 
 template void* CKernel::get_kernel_matrix_helper<float64_t>(void* p);
 template void* CKernel::get_kernel_matrix_helper<float32_t>(void* p);
+
+template void CKernel::get_kernel_matrix_range_helper<float64_t>(
+		int32_t start, int32_t end, int32_t thread, void* p);
+template void CKernel::get_kernel_matrix_range_helper<float32_t>(
+		int32_t start, int32_t end, int32_t thread, void* p);
+
+template void CKernel::get_kernel_matrix_block_helper<float64_t>(
+		int32_t start, int32_t end, int32_t thread, void* p);
+template void CKernel::get_kernel_matrix_block_helper<float32_t>(
+		int32_t start, int32_t end, int32_t thread, void* p);
@@ -24,6 +24,7 @@
 #include <shogun/base/SGObject.h>
 #include <shogun/features/Features.h>
 #include <shogun/kernel/normalizer/KernelNormalizer.h>
+#include <shogun/kernel/KernelRowCache.h>
 
 namespace shogun
 {
@@ -261,6 +262,15 @@ class CKernel : public CSGObject
 
 			SGVector<float64_t> col = SGVector<float64_t>(num_rhs);
 
+			if (has_block_computation())
+			{
+				compute_block(col.vector, 0, num_rhs, j, 1);
+				for (int32_t i=0; i!=num_rhs; i++)
+					col[i] = normalizer->normalize(col[i], i, j);
+
+				return col;
+			}
+
 			for (int32_t i=0; i!=num_rhs; i++)
 				col[i] = kernel(i,j);
 
@@ -277,6 +287,15 @@ class CKernel : public CSGObject
 		{
 			SGVector<float64_t> row = SGVector<float64_t>(num_lhs);
 
+			if (has_block_computation())
+			{
+				compute_block(row.vector, i, 1, 0, num_lhs);
+				for (int32_t j=0; j!=num_lhs; j++)
+					row[j] = normalizer->normalize(row[j], i, j);
+
+				return row;
+			}
+
 			for (int32_t j=0; j!=num_lhs; j++)
 				row[j] = kernel(i,j);
 
@@ -319,6 +338,28 @@ class CKernel : public CSGObject
 		 */
 		virtual bool init_normalizer();
 
+		/** attach a (thread safe) row cache that is consulted by
+		 * fill_kernel_row(). The cache is (re)initialized whenever the
+		 * kernel is initialized with new features or gets a new normalizer.
+		 * Note that the cache must be cleared manually after changing kernel
+		 * parameters.
+		 *
+		 * @param cache row cache, NULL to disable row caching
+		 */
+		void set_row_cache(CKernelRowCache* cache);
+
+		/** @return attached row cache or NULL */
+		CKernelRowCache* get_row_cache();
+
+		/** compute row i of the kernel matrix, i.e. row[j]=kernel(i,j) for
+		 * all rhs vectors j. If a row cache is attached the row is served
+		 * from/stored in the cache, missing rows are computed in parallel.
+		 *
+		 * @param i lhs index
+		 * @param row output of length get_num_vec_rhs()
+		 */
+		void fill_kernel_row(int32_t i, float64_t* row);
+
 		/** clean up your kernel
 		 *
 		 * base method only removes lhs and rhs
@@ -518,6 +559,7 @@ class CKernel : public CSGObject
 			if(kernel_cache.index[cacheidx] != -1)
 			{
 				kernel_cache.lru[kernel_cache.index[cacheidx]]=kernel_cache.time;
+				kernel_cache.referenced[kernel_cache.index[cacheidx]]=1;
 				return(1);
 			}
 			return(0);
@@ -739,6 +781,37 @@ class CKernel : public CSGObject
 		 */
 		virtual float64_t compute(int32_t x, int32_t y)=0;
 
+		/** check whether compute_block() is available for the current
+		 * features. Kernels that can compute whole blocks of the kernel
+		 * matrix faster than by single compute() calls (e.g. via BLAS)
+		 * should override this and compute_block().
+		 *
+		 * @return whether blocks can be computed at once
+		 */
+		virtual bool has_block_computation() { return false; }
+
+		/** compute a block of the (unnormalized) kernel matrix, i.e.
+		 * block[i+j*num_lhs_block]=compute(lhs_start+i, rhs_start+j).
+		 * Only called if has_block_computation() returns true, this
+		 * default implementation loops over compute().
+		 *
+		 * @param block column major output of size
+		 * num_lhs_block x num_rhs_block
+		 * @param lhs_start first lhs index
+		 * @param num_lhs_block number of lhs vectors
+		 * @param rhs_start first rhs index
+		 * @param num_rhs_block number of rhs vectors
+		 */
+		virtual void compute_block(float64_t* block, int32_t lhs_start,
+				int32_t num_lhs_block, int32_t rhs_start, int32_t num_rhs_block)
+		{
+			for (int32_t j=0; j<num_rhs_block; j++)
+			{
+				for (int32_t i=0; i<num_lhs_block; i++)
+					block[i+int64_t(j)*num_lhs_block]=compute(lhs_start+i, rhs_start+j);
+			}
+		}
+
 		/** compute row start offset for parallel kernel matrix computation
 		 *
 		 * @param offs offset
@@ -763,6 +836,39 @@ class CKernel : public CSGObject
 		 */
 		template <class T> static void* get_kernel_matrix_helper(void* p);
 
+		/** helper for computing rows [start, end) of the kernel matrix,
+		 * used by Parallel::parallel_for
+		 *
+		 * @param start first row
+		 * @param end one past the last row
+		 * @param thread index of the executing thread
+		 * @param p parameters shared by all threads
+		 */
+		template <class T> static void get_kernel_matrix_range_helper(
+				int32_t start, int32_t end, int32_t thread, void* p);
+
+		/** helper for computing elements [start, end) of a kernel row, used
+		 * by Parallel::parallel_for
+		 *
+		 * @param start first column
+		 * @param end one past the last column
+		 * @param thread index of the executing thread
+		 * @param p parameters shared by all threads
+		 */
+		static void fill_kernel_row_range_helper(int32_t start, int32_t end,
+				int32_t thread, void* p);
+
+		/** helper for computing blocks [start, end) of the kernel matrix
+		 * via compute_block(), used by Parallel::parallel_for
+		 *
+		 * @param start first block
+		 * @param end one past the last block
+		 * @param thread index of the executing thread
+		 * @param p parameters shared by all threads
+		 */
+		template <class T> static void get_kernel_matrix_block_helper(
+				int32_t start, int32_t end, int32_t thread, void* p);
+
 		/** Can (optionally) be overridden to post-initialize some member
 		 *  variables which are not PARAMETER::ADD'ed.  Make sure that at
 		 *  first the overridden method BASE_CLASS::LOAD_SERIALIZABLE_POST
@@ -819,6 +925,8 @@ class CKernel : public CSGObject
 			int32_t   *totdoc2active;
 			/** least recently used */
 			int32_t   *lru;
+			/** CLOCK reference bits, set on every access */
+			char      *referenced;
 			/** occu */
 			int32_t   *occu;
 			/** elements */
@@ -829,6 +937,8 @@ class CKernel : public CSGObject
 			int32_t   time;
 			/** active num */
 			int32_t   activenum;
+			/** position of the CLOCK hand used for eviction */
+			int32_t   clock_hand;
 
 			/** buffer */
 			KERNELCACHE_ELEM  *buffer;
@@ -862,6 +972,8 @@ class CKernel : public CSGObject
 
 		//@{
 		static void* cache_multiple_kernel_row_helper(void* p);
+		static void cache_multiple_kernel_row_range_helper(int32_t start,
+				int32_t end, int32_t thread, void* p);
 
 		/// init kernel cache of size megabytes
 		void   kernel_cache_free(int32_t cacheidx);
@@ -913,6 +1025,9 @@ class CKernel : public CSGObject
 		/** normalize the kernel(i,j) function based on this normalization
 		 * function */
 		CKernelNormalizer* normalizer;
+
+		/** row cache used by fill_kernel_row() */
+		CKernelRowCache* m_row_cache;
 };
 
 }
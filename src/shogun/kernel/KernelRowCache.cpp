@@ -0,0 +1,411 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/kernel/KernelRowCache.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/base/Parameter.h>
+#include <shogun/lib/Lock.h>
+#include <shogun/io/SGIO.h>
+#include <shogun/mathematics/Math.h>
+
+#include <string.h>
+
+using namespace shogun;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace shogun
+{
+/** one shard of the row cache */
+struct KernelRowCacheShard
+{
+	/** protects all members and the slots of the rows of this shard */
+	CLock lock;
+	/** number of row slots */
+	int32_t capacity;
+	/** number of used row slots */
+	int32_t num_used;
+	/** position of the CLOCK hand */
+	int32_t hand;
+	/** row stored in each slot */
+	int32_t* slot_row;
+	/** reference bit of each slot */
+	uint8_t* referenced;
+	/** row storage (double precision) */
+	float64_t* buffer64;
+	/** row storage (single precision) */
+	float32_t* buffer32;
+	/** number of hits */
+	int64_t hits;
+	/** number of misses */
+	int64_t misses;
+	/** number of evictions */
+	int64_t evictions;
+};
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+CKernelRowCache::CKernelRowCache() : CSGObject()
+{
+	init();
+}
+
+CKernelRowCache::CKernelRowCache(int32_t size, bool use_float32,
+		int32_t num_shards) : CSGObject()
+{
+	init();
+
+	m_cache_size=size;
+	m_use_float32=use_float32;
+	m_num_shards=num_shards;
+}
+
+CKernelRowCache::~CKernelRowCache()
+{
+	lock_layout_exclusive();
+	free_shards();
+	unlock_layout();
+
+#ifdef HAVE_PTHREAD
+	pthread_rwlock_destroy(&m_layout_lock);
+#endif
+}
+
+void CKernelRowCache::init()
+{
+	m_cache_size=10;
+	m_use_float32=false;
+	m_num_shards=0;
+	m_shard_count=0;
+	m_num_rows=0;
+	m_row_len=0;
+	m_row_slot=NULL;
+	m_shards=NULL;
+
+#ifdef HAVE_PTHREAD
+	pthread_rwlock_init(&m_layout_lock, NULL);
+#endif
+
+	SG_ADD(&m_cache_size, "cache_size", "Cache size in MB.", MS_NOT_AVAILABLE);
+	SG_ADD(&m_use_float32, "use_float32",
+			"Whether rows are stored in single precision.", MS_NOT_AVAILABLE);
+	SG_ADD(&m_num_shards, "num_shards", "Number of shards.", MS_NOT_AVAILABLE);
+}
+
+void CKernelRowCache::lock_layout_shared() const
+{
+#ifdef HAVE_PTHREAD
+	pthread_rwlock_rdlock(&m_layout_lock);
+#endif
+}
+
+void CKernelRowCache::lock_layout_exclusive() const
+{
+#ifdef HAVE_PTHREAD
+	pthread_rwlock_wrlock(&m_layout_lock);
+#endif
+}
+
+void CKernelRowCache::unlock_layout() const
+{
+#ifdef HAVE_PTHREAD
+	pthread_rwlock_unlock(&m_layout_lock);
+#endif
+}
+
+void CKernelRowCache::free_shards()
+{
+	if (m_shards)
+	{
+		for (int32_t s=0; s<m_shard_count; s++)
+		{
+			SG_FREE(m_shards[s].slot_row);
+			SG_FREE(m_shards[s].referenced);
+			SG_FREE(m_shards[s].buffer64);
+			SG_FREE(m_shards[s].buffer32);
+		}
+		delete[] m_shards;
+	}
+
+	SG_FREE(m_row_slot);
+	m_shards=NULL;
+	m_row_slot=NULL;
+	m_shard_count=0;
+}
+
+void CKernelRowCache::reset(int32_t num_rows, int32_t row_len)
+{
+	REQUIRE(num_rows>=0 && row_len>=0, "Invalid cache layout %dx%d\n",
+			num_rows, row_len)
+
+	lock_layout_exclusive();
+
+	/* other users of the cache may still hold rows of this layout */
+	if (m_shards && num_rows==m_num_rows && row_len==m_row_len)
+	{
+		clear_shards();
+		unlock_layout();
+		return;
+	}
+
+	free_shards();
+
+	m_shard_count=m_num_shards;
+	if (m_shard_count<=0)
+		m_shard_count=CMath::min(64, 4*parallel->get_num_threads());
+
+	m_num_rows=num_rows;
+	m_row_len=row_len;
+
+	int64_t elem_size=m_use_float32 ? sizeof(float32_t) : sizeof(float64_t);
+	int64_t total=(int64_t(m_cache_size)*1024*1024)/
+		CMath::max(int64_t(1), elem_size*row_len);
+	total=CMath::min(total, int64_t(num_rows));
+
+	/* no point in having more shards than rows */
+	m_shard_count=CMath::max(1, (int32_t) CMath::min(int64_t(m_shard_count), total));
+
+	SG_DEBUG("kernel row cache for %d rows of length %d: %lld rows in %d shards\n",
+			num_rows, row_len, total, m_shard_count)
+
+	m_row_slot=SG_MALLOC(int32_t, num_rows);
+	for (int32_t i=0; i<num_rows; i++)
+		m_row_slot[i]=-1;
+
+	m_shards=new KernelRowCacheShard[m_shard_count];
+	for (int32_t s=0; s<m_shard_count; s++)
+	{
+		KernelRowCacheShard* shard=&m_shards[s];
+		shard->capacity=total/m_shard_count + (s<total%m_shard_count ? 1 : 0);
+		shard->num_used=0;
+		shard->hand=0;
+		shard->slot_row=SG_MALLOC(int32_t, shard->capacity);
+		shard->referenced=SG_CALLOC(uint8_t, shard->capacity);
+		shard->buffer64=NULL;
+		shard->buffer32=NULL;
+
+		if (m_use_float32)
+			shard->buffer32=SG_MALLOC(float32_t, int64_t(shard->capacity)*row_len);
+		else
+			shard->buffer64=SG_MALLOC(float64_t, int64_t(shard->capacity)*row_len);
+
+		shard->hits=0;
+		shard->misses=0;
+		shard->evictions=0;
+	}
+
+	unlock_layout();
+}
+
+void CKernelRowCache::clear()
+{
+	lock_layout_shared();
+	clear_shards();
+	unlock_layout();
+}
+
+void CKernelRowCache::clear_shards()
+{
+	for (int32_t s=0; s<m_shard_count && m_shards; s++)
+	{
+		KernelRowCacheShard* shard=&m_shards[s];
+		shard->lock.lock();
+		for (int32_t i=0; i<shard->num_used; i++)
+		{
+			m_row_slot[shard->slot_row[i]]=-1;
+			shard->referenced[i]=0;
+		}
+		shard->num_used=0;
+		shard->hand=0;
+		shard->lock.unlock();
+	}
+}
+
+bool CKernelRowCache::lookup(int32_t row, float64_t* values, int32_t row_len)
+{
+	lock_layout_shared();
+	if (!m_shards || row<0 || row>=m_num_rows ||
+			(row_len>=0 && row_len!=m_row_len))
+	{
+		unlock_layout();
+		return false;
+	}
+
+	KernelRowCacheShard* shard=&m_shards[row%m_shard_count];
+
+	shard->lock.lock();
+	int32_t slot=m_row_slot[row];
+	if (slot<0)
+	{
+		shard->misses++;
+		shard->lock.unlock();
+		unlock_layout();
+		return false;
+	}
+
+	shard->referenced[slot]=1;
+	shard->hits++;
+
+	if (m_use_float32)
+	{
+		float32_t* src=&shard->buffer32[int64_t(slot)*m_row_len];
+		for (int32_t j=0; j<m_row_len; j++)
+			values[j]=src[j];
+	}
+	else
+		memcpy(values, &shard->buffer64[int64_t(slot)*m_row_len],
+				sizeof(float64_t)*m_row_len);
+
+	shard->lock.unlock();
+	unlock_layout();
+	return true;
+}
+
+void CKernelRowCache::insert(int32_t row, const float64_t* values,
+		int32_t row_len)
+{
+	lock_layout_shared();
+	if (!m_shards || row<0 || row>=m_num_rows ||
+			(row_len>=0 && row_len!=m_row_len))
+	{
+		unlock_layout();
+		return;
+	}
+
+	KernelRowCacheShard* shard=&m_shards[row%m_shard_count];
+
+	shard->lock.lock();
+	if (shard->capacity==0 || m_row_slot[row]>=0)
+	{
+		shard->lock.unlock();
+		unlock_layout();
+		return;
+	}
+
+	int32_t slot;
+	if (shard->num_used<shard->capacity)
+		slot=shard->num_used++;
+	else
+	{
+		/* CLOCK: give recently used rows a second chance */
+		while (shard->referenced[shard->hand])
+		{
+			shard->referenced[shard->hand]=0;
+			shard->hand=(shard->hand+1)%shard->capacity;
+		}
+
+		slot=shard->hand;
+		shard->hand=(shard->hand+1)%shard->capacity;
+
+		m_row_slot[shard->slot_row[slot]]=-1;
+		shard->evictions++;
+	}
+
+	if (m_use_float32)
+	{
+		float32_t* dst=&shard->buffer32[int64_t(slot)*m_row_len];
+		for (int32_t j=0; j<m_row_len; j++)
+			dst[j]=(float32_t) values[j];
+	}
+	else
+		memcpy(&shard->buffer64[int64_t(slot)*m_row_len], values,
+				sizeof(float64_t)*m_row_len);
+
+	shard->slot_row[slot]=row;
+	shard->referenced[slot]=1;
+	m_row_slot[row]=slot;
+
+	shard->lock.unlock();
+	unlock_layout();
+}
+
+int32_t CKernelRowCache::get_capacity() const
+{
+	lock_layout_shared();
+	int32_t capacity=0;
+	for (int32_t s=0; s<m_shard_count && m_shards; s++)
+		capacity+=m_shards[s].capacity;
+
+	unlock_layout();
+	return capacity;
+}
+
+int32_t CKernelRowCache::get_num_cached() const
+{
+	lock_layout_shared();
+	int32_t num=0;
+	for (int32_t s=0; s<m_shard_count && m_shards; s++)
+	{
+		m_shards[s].lock.lock();
+		num+=m_shards[s].num_used;
+		m_shards[s].lock.unlock();
+	}
+
+	unlock_layout();
+	return num;
+}
+
+int64_t CKernelRowCache::get_num_hits() const
+{
+	lock_layout_shared();
+	int64_t num=0;
+	for (int32_t s=0; s<m_shard_count && m_shards; s++)
+	{
+		m_shards[s].lock.lock();
+		num+=m_shards[s].hits;
+		m_shards[s].lock.unlock();
+	}
+
+	unlock_layout();
+	return num;
+}
+
+int64_t CKernelRowCache::get_num_misses() const
+{
+	lock_layout_shared();
+	int64_t num=0;
+	for (int32_t s=0; s<m_shard_count && m_shards; s++)
+	{
+		m_shards[s].lock.lock();
+		num+=m_shards[s].misses;
+		m_shards[s].lock.unlock();
+	}
+
+	unlock_layout();
+	return num;
+}
+
+int64_t CKernelRowCache::get_num_evictions() const
+{
+	lock_layout_shared();
+	int64_t num=0;
+	for (int32_t s=0; s<m_shard_count && m_shards; s++)
+	{
+		m_shards[s].lock.lock();
+		num+=m_shards[s].evictions;
+		m_shards[s].lock.unlock();
+	}
+
+	unlock_layout();
+	return num;
+}
+
+void CKernelRowCache::reset_statistics()
+{
+	lock_layout_shared();
+	for (int32_t s=0; s<m_shard_count && m_shards; s++)
+	{
+		m_shards[s].lock.lock();
+		m_shards[s].hits=0;
+		m_shards[s].misses=0;
+		m_shards[s].evictions=0;
+		m_shards[s].lock.unlock();
+	}
+
+	unlock_layout();
+}
@@ -0,0 +1,191 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#ifndef _KERNELROWCACHE_H___
+#define _KERNELROWCACHE_H___
+
+#include <shogun/lib/config.h>
+#include <shogun/lib/common.h>
+#include <shogun/base/SGObject.h>
+
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+namespace shogun
+{
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+struct KernelRowCacheShard;
+#endif
+
+/** @brief Class KernelRowCache implements a thread safe cache of kernel rows.
+ *
+ * Rows are distributed over a number of shards (row index modulo number of
+ * shards), each protected by its own lock, such that multiple threads (e.g.
+ * several solver threads training on the same kernel) can look up and insert
+ * rows concurrently with little contention.
+ *
+ * Every shard holds a fixed number of row slots. Once a shard is full, the
+ * slot to reuse is selected with the CLOCK (second chance) policy: a hand
+ * sweeps over the slots, clearing the reference bit of recently used rows and
+ * evicting the first row that was not used since the last sweep. Lookup,
+ * insertion and eviction are thus (amortized) O(1) instead of a scan over
+ * all cached rows.
+ *
+ * Rows can optionally be stored in single precision, which doubles the number
+ * of rows that fit into the same amount of memory at the cost of precision.
+ * Hits, misses and evictions are counted to tune the cache size.
+ *
+ * A cache can be attached to a kernel via CKernel::set_row_cache(). It is
+ * invalidated whenever the kernel is initialized with new features. Lookups
+ * and insertions may run concurrently with reset() from another thread (e.g.
+ * when the cache is shared by several kernels): the shards are only
+ * reallocated while no lookup or insertion is in progress, and rows of a
+ * different layout are never returned.
+ */
+class CKernelRowCache : public CSGObject
+{
+	public:
+		/** default constructor */
+		CKernelRowCache();
+
+		/** constructor
+		 *
+		 * @param size cache size in MB
+		 * @param use_float32 whether rows are stored in single precision
+		 * @param num_shards number of shards, if <=0 it is chosen based on
+		 * the number of threads
+		 */
+		CKernelRowCache(int32_t size, bool use_float32=false,
+				int32_t num_shards=0);
+
+		/** destructor */
+		virtual ~CKernelRowCache();
+
+		/** (re)allocate the cache for rows of the given length, drops all
+		 * cached rows. The shards are kept if the layout does not change.
+		 *
+		 * @param num_rows number of different rows (valid row indices are
+		 * 0...num_rows-1)
+		 * @param row_len number of elements per row
+		 */
+		void reset(int32_t num_rows, int32_t row_len);
+
+		/** drop all cached rows */
+		void clear();
+
+		/** look up a row
+		 *
+		 * @param row index of the row
+		 * @param values buffer of length get_row_length() the row is copied
+		 * to if it is cached
+		 * @param row_len length of values, if >=0 the lookup fails unless
+		 * it matches get_row_length()
+		 * @return whether the row was cached
+		 */
+		bool lookup(int32_t row, float64_t* values, int32_t row_len=-1);
+
+		/** insert a row, evicting another row if the shard is full
+		 *
+		 * @param row index of the row
+		 * @param values row of length get_row_length()
+		 * @param row_len length of values, if >=0 the row is only inserted
+		 * if it matches get_row_length()
+		 */
+		void insert(int32_t row, const float64_t* values, int32_t row_len=-1);
+
+		/** @return cache size in MB */
+		int32_t get_cache_size() const { return m_cache_size; }
+
+		/** @return whether rows are stored in single precision */
+		bool get_use_float32() const { return m_use_float32; }
+
+		/** @return number of shards in use */
+		int32_t get_num_shards() const { return m_shard_count; }
+
+		/** @return number of different rows the cache was allocated for */
+		int32_t get_num_rows() const { return m_num_rows; }
+
+		/** @return number of elements per row */
+		int32_t get_row_length() const { return m_row_len; }
+
+		/** @return maximum number of rows that can be cached */
+		int32_t get_capacity() const;
+
+		/** @return number of currently cached rows */
+		int32_t get_num_cached() const;
+
+		/** @return number of successful lookups */
+		int64_t get_num_hits() const;
+
+		/** @return number of failed lookups */
+		int64_t get_num_misses() const;
+
+		/** @return number of rows evicted to make room for others */
+		int64_t get_num_evictions() const;
+
+		/** reset hit, miss and eviction counters */
+		void reset_statistics();
+
+		/** @return name of the SGSerializable */
+		virtual const char* get_name() const { return "KernelRowCache"; }
+
+	private:
+		/** initialize members and register parameters */
+		void init();
+
+		/** free all shards, the layout lock has to be held for writing */
+		void free_shards();
+
+		/** drop all rows, the layout lock has to be held */
+		void clear_shards();
+
+		/** acquire the layout lock for lookups and insertions */
+		void lock_layout_shared() const;
+
+		/** acquire the layout lock for changing the layout */
+		void lock_layout_exclusive() const;
+
+		/** release the layout lock */
+		void unlock_layout() const;
+
+	protected:
+		/** cache size in MB */
+		int32_t m_cache_size;
+
+		/** whether rows are stored in single precision */
+		bool m_use_float32;
+
+		/** requested number of shards (<=0 for automatic) */
+		int32_t m_num_shards;
+
+		/** number of shards in use */
+		int32_t m_shard_count;
+
+		/** number of different rows */
+		int32_t m_num_rows;
+
+		/** number of elements per row */
+		int32_t m_row_len;
+
+		/** slot of each row within its shard, -1 if not cached */
+		int32_t* m_row_slot;
+
+		/** the shards */
+		KernelRowCacheShard* m_shards;
+
+#ifdef HAVE_PTHREAD
+		/** held shared by lookups and insertions and exclusively while the
+		 * shards are (re)allocated */
+		mutable pthread_rwlock_t m_layout_lock;
+#endif
+};
+}
+#endif /* _KERNELROWCACHE_H___ */
@@ -133,6 +133,12 @@ class CLinearKernel: public CDotKernel
 		}
 
 	protected:
+		/** the linear kernel is the dot product itself
+		 *
+		 * @return true
+		 */
+		virtual bool has_dot_block_transform() { return true; }
+
 		/** normal vector (used in case of optimized kernel) */
 		SGVector<float64_t> normal;
 };
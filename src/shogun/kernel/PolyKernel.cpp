@@ -65,6 +65,16 @@ float64_t CPolyKernel::compute(int32_t idx_a, int32_t idx_b)
 	return CMath::pow(result, degree);
 }
 
+void CPolyKernel::transform_dot_block(float64_t* block, int32_t lhs_start,
+		int32_t num_lhs_block, int32_t rhs_start, int32_t num_rhs_block)
+{
+	int64_t len=int64_t(num_lhs_block)*num_rhs_block;
+	float64_t offset=inhomogene ? 1.0 : 0.0;
+
+	for (int64_t i=0; i<len; i++)
+		block[i]=CMath::pow(block[i]+offset, degree);
+}
+
 void CPolyKernel::init()
 {
 	set_normalizer(new CSqrtDiagKernelNormalizer());
@@ -97,6 +97,22 @@ class CPolyKernel: public CDotKernel
 		 */
 		virtual float64_t compute(int32_t idx_a, int32_t idx_b);
 
+		/** @return true, the polynomial kernel is a function of the dot
+		 * product */
+		virtual bool has_dot_block_transform() { return true; }
+
+		/** turn a block of dot products into kernel values in place
+		 *
+		 * @param block column major block of size
+		 * num_lhs_block x num_rhs_block
+		 * @param lhs_start first lhs index
+		 * @param num_lhs_block number of lhs vectors
+		 * @param rhs_start first rhs index
+		 * @param num_rhs_block number of rhs vectors
+		 */
+		virtual void transform_dot_block(float64_t* block, int32_t lhs_start,
+				int32_t num_lhs_block, int32_t rhs_start, int32_t num_rhs_block);
+
 	private:
 		void init();
 
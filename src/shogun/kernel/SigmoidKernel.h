@@ -90,6 +90,27 @@ class CSigmoidKernel: public CDotKernel
 			return tanh(gamma*CDotKernel::compute(idx_a,idx_b)+coef0);
 		}
 
+		/** @return true, the sigmoid kernel is a function of the dot
+		 * product */
+		virtual bool has_dot_block_transform() { return true; }
+
+		/** turn a block of dot products into kernel values in place
+		 *
+		 * @param block column major block of size
+		 * num_lhs_block x num_rhs_block
+		 * @param lhs_start first lhs index
+		 * @param num_lhs_block number of lhs vectors
+		 * @param rhs_start first rhs index
+		 * @param num_rhs_block number of rhs vectors
+		 */
+		virtual void transform_dot_block(float64_t* block, int32_t lhs_start,
+				int32_t num_lhs_block, int32_t rhs_start, int32_t num_rhs_block)
+		{
+			int64_t len=int64_t(num_lhs_block)*num_rhs_block;
+			for (int64_t i=0; i<len; i++)
+				block[i]=tanh(gamma*block[i]+coef0);
+		}
+
 	private:
 		void init();
 
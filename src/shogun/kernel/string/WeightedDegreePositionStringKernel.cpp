@@ -765,17 +765,39 @@ float64_t CWeightedDegreePositionStringKernel::compute_by_tree(int32_t idx)
 
 	((CStringFeatures<char>*) rhs)->free_feature_vector(char_vec, idx, free_vec);
 
-	for (int32_t i=0; i<len; i++)
-		sum += tries.compute_by_tree_helper(vec, len, i, i, i, weights, (length!=0)) ;
+	if (use_compact_trie)
+	{
+		tries.ensure_compact_trees(true);
 
-	if (opt_type==SLOWBUTMEMEFFICIENT)
+		for (int32_t i=0; i<len; i++)
+			sum += tries.compute_by_compact_tree(vec, len, i, i, i, weights, (length!=0)) ;
+
+		if (opt_type==SLOWBUTMEMEFFICIENT)
+		{
+			for (int32_t i=0; i<len; i++)
+			{
+				for (int32_t s=1; (s<=shift[i]) && (i+s<len); s++)
+				{
+					sum+=tries.compute_by_compact_tree(vec, len, i, i+s, i, weights, (length!=0))/(2*s) ;
+					sum+=tries.compute_by_compact_tree(vec, len, i+s, i, i+s, weights, (length!=0))/(2*s) ;
+				}
+			}
+		}
+	}
+	else
 	{
 		for (int32_t i=0; i<len; i++)
+			sum += tries.compute_by_tree_helper(vec, len, i, i, i, weights, (length!=0)) ;
+
+		if (opt_type==SLOWBUTMEMEFFICIENT)
 		{
-			for (int32_t s=1; (s<=shift[i]) && (i+s<len); s++)
+			for (int32_t i=0; i<len; i++)
 			{
-				sum+=tries.compute_by_tree_helper(vec, len, i, i+s, i, weights, (length!=0))/(2*s) ;
-				sum+=tries.compute_by_tree_helper(vec, len, i+s, i, i+s, weights, (length!=0))/(2*s) ;
+				for (int32_t s=1; (s<=shift[i]) && (i+s<len); s++)
+				{
+					sum+=tries.compute_by_tree_helper(vec, len, i, i+s, i, weights, (length!=0))/(2*s) ;
+					sum+=tries.compute_by_tree_helper(vec, len, i+s, i, i+s, weights, (length!=0))/(2*s) ;
+				}
 			}
 		}
 	}
@@ -792,6 +814,9 @@ void CWeightedDegreePositionStringKernel::compute_by_tree(
 	ASSERT(position_weights_rhs==NULL)
 	ASSERT(alphabet)
 	ASSERT(alphabet->get_alphabet()==DNA || alphabet->get_alphabet()==RNA)
+	REQUIRE(!tries.get_trees_released(), "%s::compute_by_tree(): The tries were "
+			"packed into their compact layout, initialize the optimization "
+			"again\n", get_name())
 
 	int32_t len=0;
 	bool free_vec;
@@ -1912,6 +1937,7 @@ void CWeightedDegreePositionStringKernel::init()
 
 	block_weights=NULL;
 	block_computation=true;
+	use_compact_trie=false;
 	type=E_EXTERNAL;
 	which_degree=-1;
 	tries=CTrie<DNATrie>(1);
@@ -1953,6 +1979,8 @@ void CWeightedDegreePositionStringKernel::init()
 			"Number of allowed mismatches.", MS_AVAILABLE);
 	SG_ADD(&block_computation, "block_computation",
 			"If block computation shall be used.", MS_NOT_AVAILABLE);
+	SG_ADD(&use_compact_trie, "use_compact_trie",
+			"If the compact layout of the tries is used.", MS_NOT_AVAILABLE);
 	SG_ADD((machine_int_t*) &type, "type",
 			"WeightedDegree kernel type.", MS_AVAILABLE);
 	SG_ADD(&which_degree, "which_degree",
@@ -321,6 +321,29 @@ class CWeightedDegreePositionStringKernel: public CStringKernel<char>
 		 */
 		inline int32_t get_max_mismatch() { return max_mismatch; }
 
+		/** use the compact level ordered layout of the tries for evaluating
+		 * the optimized kernel (compute_optimized), the weights are stored
+		 * in single precision in this layout. The nodes of the tries are
+		 * freed once they are packed, so the optimization has to be
+		 * initialized again (or cleared by clear_normal()) before adding
+		 * to it, or after switching the layout off.
+		 *
+		 * @param compact if the compact layout shall be used
+		 */
+		inline void set_use_compact_trie(bool compact)
+		{
+			if (!compact && tries.get_trees_released())
+				delete_optimization();
+
+			use_compact_trie=compact;
+		}
+
+		/** check if the compact layout of the tries is used
+		 *
+		 * @return if the compact layout is used
+		 */
+		inline bool get_use_compact_trie() { return use_compact_trie; }
+
 		/** get degree
 		 *
 		 * @return the degree
@@ -743,6 +766,9 @@ class CWeightedDegreePositionStringKernel: public CStringKernel<char>
 		/** if block computation is used */
 		bool block_computation;
 
+		/** if the compact layout of the tries is used */
+		bool use_compact_trie;
+
 		/** (internal) block weights */
 		float64_t* block_weights;
 		/** WeightedDegree kernel type */
@@ -20,6 +20,7 @@
 #include <shogun/kernel/normalizer/FirstElementKernelNormalizer.h>
 #include <shogun/features/Features.h>
 #include <shogun/features/StringFeatures.h>
+#include <shogun/features/PackedStringFeatures.h>
 
 #ifndef WIN32
 #include <pthread.h>
@@ -128,7 +129,7 @@ void CWeightedDegreeStringKernel::create_empty_tries()
 {
 	ASSERT(lhs)
 
-	seq_length=((CStringFeatures<char>*) lhs)->get_max_vector_length();
+	seq_length=get_max_vector_length(lhs);
 
 	if (tries!=NULL)
 	{
@@ -142,25 +143,48 @@ bool CWeightedDegreeStringKernel::init(CFeatures* l, CFeatures* r)
 	int32_t lhs_changed=(lhs!=l);
 	int32_t rhs_changed=(rhs!=r);
 
-	CStringKernel<char>::init(l,r);
-
 	SG_DEBUG("lhs_changed: %i\n", lhs_changed)
 	SG_DEBUG("rhs_changed: %i\n", rhs_changed)
 
-	CStringFeatures<char>* sf_l=(CStringFeatures<char>*) l;
-	CStringFeatures<char>* sf_r=(CStringFeatures<char>*) r;
+	int32_t len;
+	bool same_length_l, same_length_r;
+	CAlphabet* ralphabet;
+	SG_UNREF(alphabet);
+
+	if (l->get_feature_class()==C_PACKED_STRING)
+	{
+		CKernel::init(l,r);
+		ASSERT(r->get_feature_class()==C_PACKED_STRING)
+
+		CPackedStringFeatures* pf_l=(CPackedStringFeatures*) l;
+		CPackedStringFeatures* pf_r=(CPackedStringFeatures*) r;
+
+		len=pf_l->get_max_vector_length();
+		same_length_l=!lhs_changed || pf_l->have_same_length(len);
+		same_length_r=!rhs_changed || pf_r->have_same_length(len);
+		alphabet=pf_l->get_alphabet();
+		ralphabet=pf_r->get_alphabet();
+	}
+	else
+	{
+		CStringKernel<char>::init(l,r);
 
-	int32_t len=sf_l->get_max_vector_length();
-	if (lhs_changed && !sf_l->have_same_length(len))
+		CStringFeatures<char>* sf_l=(CStringFeatures<char>*) l;
+		CStringFeatures<char>* sf_r=(CStringFeatures<char>*) r;
+
+		len=sf_l->get_max_vector_length();
+		same_length_l=!lhs_changed || sf_l->have_same_length(len);
+		same_length_r=!rhs_changed || sf_r->have_same_length(len);
+		alphabet=sf_l->get_alphabet();
+		ralphabet=sf_r->get_alphabet();
+	}
+
+	if (!same_length_l)
 		SG_ERROR("All strings in WD kernel must have same length (lhs wrong)!\n")
 
-	if (rhs_changed && !sf_r->have_same_length(len))
+	if (!same_length_r)
 		SG_ERROR("All strings in WD kernel must have same length (rhs wrong)!\n")
 
-	SG_UNREF(alphabet);
-	alphabet=sf_l->get_alphabet();
-	CAlphabet* ralphabet=sf_r->get_alphabet();
-
 	if (!((alphabet->get_alphabet()==DNA) || (alphabet->get_alphabet()==RNA)))
 		properties &= ((uint64_t) (-1)) ^ (KP_LINADD | KP_BATCHEVALUATION);
 
@@ -360,12 +384,38 @@ float64_t CWeightedDegreeStringKernel::compute_without_mismatch_matrix(
 }
 
 
+float64_t CWeightedDegreeStringKernel::compute_packed_using_block(
+	int32_t idx_a, int32_t idx_b)
+{
+	CPackedStringFeatures* pf_l=(CPackedStringFeatures*) lhs;
+	CPackedStringFeatures* pf_r=(CPackedStringFeatures*) rhs;
+	int32_t alen=pf_l->get_vector_length(idx_a);
+	ASSERT(alen==pf_r->get_vector_length(idx_b))
+
+	float64_t sum=0;
+
+	/* blocks of matching symbols, separated by a mismatch */
+	for (int32_t i=0; i<alen; i++)
+	{
+		int32_t match_len=pf_l->match_length(idx_a, i, pf_r, idx_b, i, alen-i);
+		if (match_len>0)
+			sum+=block_weights[match_len-1];
+		i+=match_len;
+	}
+
+	return sum;
+}
+
 float64_t CWeightedDegreeStringKernel::compute(int32_t idx_a, int32_t idx_b)
 {
+	if (max_mismatch==0 && length==0 && block_computation &&
+			lhs->get_feature_class()==C_PACKED_STRING)
+		return compute_packed_using_block(idx_a, idx_b);
+
 	int32_t alen, blen;
 	bool free_avec, free_bvec;
-	char* avec=((CStringFeatures<char>*) lhs)->get_feature_vector(idx_a, alen, free_avec);
-	char* bvec=((CStringFeatures<char>*) rhs)->get_feature_vector(idx_b, blen, free_bvec);
+	char* avec=get_feature_vector(lhs, idx_a, alen, free_avec);
+	char* bvec=get_feature_vector(rhs, idx_b, blen, free_bvec);
 	float64_t result=0;
 
 	if (max_mismatch==0 && length==0 && block_computation)
@@ -379,8 +429,8 @@ float64_t CWeightedDegreeStringKernel::compute(int32_t idx_a, int32_t idx_b)
 		else
 			result=compute_without_mismatch_matrix(avec, alen, bvec, blen);
 	}
-	((CStringFeatures<char>*) lhs)->free_feature_vector(avec, idx_a, free_avec);
-	((CStringFeatures<char>*) rhs)->free_feature_vector(bvec, idx_b, free_bvec);
+	free_feature_vector(lhs, avec, idx_a, free_avec);
+	free_feature_vector(rhs, bvec, idx_b, free_bvec);
 
 	return result;
 }
@@ -394,13 +444,13 @@ void CWeightedDegreeStringKernel::add_example_to_tree(
 
 	int32_t len=0;
 	bool free_vec;
-	char* char_vec=((CStringFeatures<char>*) lhs)->get_feature_vector(idx, len, free_vec);
+	char* char_vec=get_feature_vector(lhs, idx, len, free_vec);
 	ASSERT(max_mismatch==0)
 	int32_t *vec=SG_MALLOC(int32_t, len);
 
 	for (int32_t i=0; i<len; i++)
 		vec[i]=alphabet->remap_to_bin(char_vec[i]);
-	((CStringFeatures<char>*) lhs)->free_feature_vector(char_vec, idx, free_vec);
+	free_feature_vector(lhs, char_vec, idx, free_vec);
 
 	if (length == 0 || max_mismatch > 0)
 	{
@@ -440,13 +490,13 @@ void CWeightedDegreeStringKernel::add_example_to_single_tree(
 
 	int32_t len;
 	bool free_vec;
-	char* char_vec=((CStringFeatures<char>*) lhs)->get_feature_vector(idx, len, free_vec);
+	char* char_vec=get_feature_vector(lhs, idx, len, free_vec);
 	ASSERT(max_mismatch==0)
 	int32_t *vec = SG_MALLOC(int32_t, len);
 
 	for (int32_t i=tree_num; i<tree_num+degree && i<len; i++)
 		vec[i]=alphabet->remap_to_bin(char_vec[i]);
-	((CStringFeatures<char>*) lhs)->free_feature_vector(char_vec, idx, free_vec);
+	free_feature_vector(lhs, char_vec, idx, free_vec);
 
 
 	ASSERT(tries)
@@ -465,13 +515,13 @@ void CWeightedDegreeStringKernel::add_example_to_tree_mismatch(int32_t idx, floa
 
 	int32_t len ;
 	bool free_vec;
-	char* char_vec=((CStringFeatures<char>*) lhs)->get_feature_vector(idx, len, free_vec);
+	char* char_vec=get_feature_vector(lhs, idx, len, free_vec);
 
 	int32_t *vec = SG_MALLOC(int32_t, len);
 
 	for (int32_t i=0; i<len; i++)
 		vec[i]=alphabet->remap_to_bin(char_vec[i]);
-	((CStringFeatures<char>*) lhs)->free_feature_vector(char_vec, idx, free_vec);
+	free_feature_vector(lhs, char_vec, idx, free_vec);
 
 	for (int32_t i=0; i<len; i++)
 	{
@@ -492,12 +542,12 @@ void CWeightedDegreeStringKernel::add_example_to_single_tree_mismatch(
 
 	int32_t len=0;
 	bool free_vec;
-	char* char_vec=((CStringFeatures<char>*) lhs)->get_feature_vector(idx, len, free_vec);
+	char* char_vec=get_feature_vector(lhs, idx, len, free_vec);
 	int32_t *vec=SG_MALLOC(int32_t, len);
 
 	for (int32_t i=tree_num; i<len && i<tree_num+degree; i++)
 		vec[i]=alphabet->remap_to_bin(char_vec[i]);
-	((CStringFeatures<char>*) lhs)->free_feature_vector(char_vec, idx, free_vec);
+	free_feature_vector(lhs, char_vec, idx, free_vec);
 
 	if (alpha!=0.0)
 	{
@@ -518,18 +568,27 @@ float64_t CWeightedDegreeStringKernel::compute_by_tree(int32_t idx)
 
 	int32_t len=0;
 	bool free_vec;
-	char* char_vec=((CStringFeatures<char>*) rhs)->get_feature_vector(idx, len, free_vec);
+	char* char_vec=get_feature_vector(rhs, idx, len, free_vec);
 	ASSERT(char_vec && len>0)
 	int32_t *vec=SG_MALLOC(int32_t, len);
 
 	for (int32_t i=0; i<len; i++)
 		vec[i]=alphabet->remap_to_bin(char_vec[i]);
-	((CStringFeatures<char>*) lhs)->free_feature_vector(char_vec, idx, free_vec);
+	free_feature_vector(rhs, char_vec, idx, free_vec);
 
 	float64_t sum=0;
 	ASSERT(tries)
-	for (int32_t i=0; i<len; i++)
-		sum+=tries->compute_by_tree_helper(vec, len, i, i, i, weights, (length!=0));
+	if (use_compact_trie)
+	{
+		tries->ensure_compact_trees(true);
+		for (int32_t i=0; i<len; i++)
+			sum+=tries->compute_by_compact_tree(vec, len, i, i, i, weights, (length!=0));
+	}
+	else
+	{
+		for (int32_t i=0; i<len; i++)
+			sum+=tries->compute_by_tree_helper(vec, len, i, i, i, weights, (length!=0));
+	}
 
 	SG_FREE(vec);
 	return normalizer->normalize_rhs(sum, idx);
@@ -540,16 +599,20 @@ void CWeightedDegreeStringKernel::compute_by_tree(
 {
 	ASSERT(alphabet)
 	ASSERT(alphabet->get_alphabet()==DNA || alphabet->get_alphabet()==RNA)
+	ASSERT(tries)
+	REQUIRE(!tries->get_trees_released(), "%s::compute_by_tree(): The tries were "
+			"packed into their compact layout, initialize the optimization "
+			"again\n", get_name())
 
 	int32_t len ;
 	bool free_vec;
-	char* char_vec=((CStringFeatures<char>*) rhs)->get_feature_vector(idx, len, free_vec);
+	char* char_vec=get_feature_vector(rhs, idx, len, free_vec);
 
 	int32_t *vec = SG_MALLOC(int32_t, len);
 
 	for (int32_t i=0; i<len; i++)
 		vec[i]=alphabet->remap_to_bin(char_vec[i]);
-	((CStringFeatures<char>*) lhs)->free_feature_vector(char_vec, idx, free_vec);
+	free_feature_vector(rhs, char_vec, idx, free_vec);
 
 	ASSERT(tries)
 	for (int32_t i=0; i<len; i++)
@@ -823,6 +886,59 @@ bool CWeightedDegreeStringKernel::init_block_weights()
 }
 
 
+char* CWeightedDegreeStringKernel::get_feature_vector(CFeatures* f,
+	int32_t idx, int32_t& len, bool& dofree)
+{
+	if (f->get_feature_class()==C_PACKED_STRING)
+		return ((CPackedStringFeatures*) f)->get_feature_vector(idx, len, dofree);
+
+	return ((CStringFeatures<char>*) f)->get_feature_vector(idx, len, dofree);
+}
+
+void CWeightedDegreeStringKernel::free_feature_vector(CFeatures* f,
+	char* vec, int32_t idx, bool dofree)
+{
+	if (f->get_feature_class()==C_PACKED_STRING)
+		((CPackedStringFeatures*) f)->free_feature_vector(vec, idx, dofree);
+	else
+		((CStringFeatures<char>*) f)->free_feature_vector(vec, idx, dofree);
+}
+
+int32_t CWeightedDegreeStringKernel::get_max_vector_length(CFeatures* f)
+{
+	if (f->get_feature_class()==C_PACKED_STRING)
+		return ((CPackedStringFeatures*) f)->get_max_vector_length();
+
+	return ((CStringFeatures<char>*) f)->get_max_vector_length();
+}
+
+int32_t CWeightedDegreeStringKernel::get_bin_symbols(CFeatures* f,
+	CAlphabet* alpha, int32_t idx, int32_t start, int32_t num, int32_t* dst)
+{
+	int32_t len=0;
+
+	if (f->get_feature_class()==C_PACKED_STRING)
+	{
+		/* unpacked straight from the packed words */
+		CPackedStringFeatures* pf=(CPackedStringFeatures*) f;
+		len=pf->get_vector_length(idx);
+		int32_t n=CMath::min(num, len-start);
+		if (n>0)
+			pf->get_bin_vector(idx, start, n, dst);
+	}
+	else
+	{
+		bool free_vec;
+		CStringFeatures<char>* sf=(CStringFeatures<char>*) f;
+		char* char_vec=sf->get_feature_vector(idx, len, free_vec);
+		for (int32_t k=start; k<CMath::min(len, start+num); k++)
+			dst[k-start]=alpha->remap_to_bin(char_vec[k]);
+		sf->free_feature_vector(char_vec, idx, free_vec);
+	}
+
+	return len;
+}
+
 void* CWeightedDegreeStringKernel::compute_batch_helper(void* p)
 {
 	S_THREAD_PARAM_WD* params = (S_THREAD_PARAM_WD*) p;
@@ -836,17 +952,48 @@ void* CWeightedDegreeStringKernel::compute_batch_helper(void* p)
 	float64_t factor=params->factor;
 	int32_t* vec_idx=params->vec_idx;
 
-	CStringFeatures<char>* rhs_feat=((CStringFeatures<char>*) wd->get_rhs());
+	CFeatures* rhs_feat=wd->get_rhs();
 	CAlphabet* alpha=wd->alphabet;
 
+	if (wd->get_use_compact_trie())
+	{
+		/* evaluate blocks of sequences interleaved, row b of syms holds the
+		 * symbols of sequence start+b at positions j..j+degree-1 */
+		int32_t degree=wd->get_degree();
+		int32_t* syms=SG_MALLOC(int32_t, TRIE_COMPACT_BATCH*degree);
+		int32_t num_syms[TRIE_COMPACT_BATCH];
+		float64_t out[TRIE_COMPACT_BATCH];
+
+		ASSERT(tries)
+
+		for (int32_t start=params->start; start<params->end; start+=TRIE_COMPACT_BATCH)
+		{
+			int32_t num=CMath::min(TRIE_COMPACT_BATCH, params->end-start);
+
+			for (int32_t b=0; b<num; b++)
+			{
+				int32_t len=get_bin_symbols(rhs_feat, alpha, vec_idx[start+b],
+						j, degree, &syms[b*degree]);
+				num_syms[b]=CMath::max(0, CMath::min(len-j, degree));
+			}
+
+			tries->compute_by_compact_tree_batch(syms, num_syms, num, j, j,
+					weights, (length!=0), out);
+
+			for (int32_t b=0; b<num; b++)
+				result[start+b]+=factor*wd->normalizer->normalize_rhs(out[b], vec_idx[start+b]);
+		}
+
+		SG_FREE(syms);
+		SG_UNREF(rhs_feat);
+
+		return NULL;
+	}
+
 	for (int32_t i=params->start; i<params->end; i++)
 	{
-		int32_t len=0;
-		bool free_vec;
-		char* char_vec=rhs_feat->get_feature_vector(vec_idx[i], len, free_vec);
-		for (int32_t k=j; k<CMath::min(len,j+wd->get_degree()); k++)
-			vec[k]=alpha->remap_to_bin(char_vec[k]);
-		rhs_feat->free_feature_vector(char_vec, vec_idx[i], free_vec);
+		int32_t len=get_bin_symbols(rhs_feat, alpha, vec_idx[i], j,
+				wd->get_degree(), &vec[j]);
 
 		ASSERT(tries)
 
@@ -873,7 +1020,7 @@ void CWeightedDegreeStringKernel::compute_batch(
 	ASSERT(result)
 	create_empty_tries();
 
-	int32_t num_feat=((CStringFeatures<char>*) rhs)->get_max_vector_length();
+	int32_t num_feat=get_max_vector_length(rhs);
 	ASSERT(num_feat>0)
 	int32_t num_threads=parallel->get_num_threads();
 	ASSERT(num_threads>0)
@@ -889,6 +1036,8 @@ void CWeightedDegreeStringKernel::compute_batch(
 #endif
 		{
 			init_optimization(num_suppvec, IDX, alphas, j);
+			if (use_compact_trie)
+				tries->create_compact_trees(j, true);
 			S_THREAD_PARAM_WD params;
 			params.vec=vec;
 			params.result=result;
@@ -913,6 +1062,8 @@ void CWeightedDegreeStringKernel::compute_batch(
 		for (int32_t j=0; j<num_feat && !CSignal::cancel_computations(); j++)
 		{
 			init_optimization(num_suppvec, IDX, alphas, j);
+			if (use_compact_trie)
+				tries->create_compact_trees(j, true);
 			pthread_t* threads = SG_MALLOC(pthread_t, num_threads-1);
 			S_THREAD_PARAM_WD* params = SG_MALLOC(S_THREAD_PARAM_WD, num_threads);
 			int32_t step= num_vec/num_threads;
@@ -995,6 +1146,7 @@ void CWeightedDegreeStringKernel::init()
 
 	block_weights=NULL;
 	block_computation=true;
+	use_compact_trie=false;
 	type=E_WD;
 	which_degree=-1;
 	tries=NULL;
@@ -1020,6 +1172,8 @@ void CWeightedDegreeStringKernel::init()
 			"Number of allowed mismatches.", MS_AVAILABLE);
 	SG_ADD(&block_computation, "block_computation",
 			"If block computation shall be used.", MS_NOT_AVAILABLE);
+	SG_ADD(&use_compact_trie, "use_compact_trie",
+			"If the compact layout of the tries is used.", MS_NOT_AVAILABLE);
 	SG_ADD((machine_int_t*) &type, "type",
 			"WeightedDegree kernel type.", MS_AVAILABLE);
 	SG_ADD(&which_degree, "which_degree",
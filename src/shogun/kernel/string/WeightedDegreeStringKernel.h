@@ -566,6 +566,32 @@ class CWeightedDegreeStringKernel: public CStringKernel<char>
 		 */
 		inline bool get_use_block_computation() { return block_computation; }
 
+		/** use the compact level ordered layout of the tries for evaluating
+		 * the optimized kernel (compute_optimized and compute_batch)
+		 *
+		 * The layout is created from the tries on first use after they
+		 * changed and is faster to traverse, the weights are stored in
+		 * single precision though. The nodes of the tries are freed once
+		 * they are packed, so the optimization has to be initialized again
+		 * (or cleared by clear_normal()) before adding to it, or after
+		 * switching the layout off.
+		 *
+		 * @param compact if the compact layout shall be used
+		 */
+		inline void set_use_compact_trie(bool compact)
+		{
+			if (!compact && tries && tries->get_trees_released())
+				delete_optimization();
+
+			use_compact_trie=compact;
+		}
+
+		/** check if the compact layout of the tries is used
+		 *
+		 * @return if the compact layout is used
+		 */
+		inline bool get_use_compact_trie() { return use_compact_trie; }
+
 		/** set MKL steps ize
 		 *
 		 * @param step new step size
@@ -688,6 +714,58 @@ class CWeightedDegreeStringKernel: public CStringKernel<char>
 		float64_t compute_without_mismatch_matrix(
 			char* avec, int32_t alen, char* bvec, int32_t blen);
 
+		/** get string of string or packed string features, decoded to
+		 * characters
+		 *
+		 * @param f features
+		 * @param idx index of string
+		 * @param len length of string is returned by reference
+		 * @param dofree whether returned string must be freed
+		 * @return string
+		 */
+		static char* get_feature_vector(CFeatures* f, int32_t idx,
+				int32_t& len, bool& dofree);
+
+		/** free string obtained via get_feature_vector
+		 *
+		 * @param f features
+		 * @param vec string
+		 * @param idx index of string
+		 * @param dofree if string has to be freed
+		 */
+		static void free_feature_vector(CFeatures* f, char* vec, int32_t idx,
+				bool dofree);
+
+		/** get length of longest string of string or packed string features
+		 *
+		 * @param f features
+		 * @return maximum length
+		 */
+		static int32_t get_max_vector_length(CFeatures* f);
+
+		/** get symbols (remapped to bin) of a part of a string of string or
+		 * packed string features
+		 *
+		 * @param f features
+		 * @param alpha alphabet
+		 * @param idx index of string
+		 * @param start first position
+		 * @param num maximum number of symbols
+		 * @param dst destination of min(num, length of string-start)
+		 * symbols
+		 * @return length of string
+		 */
+		static int32_t get_bin_symbols(CFeatures* f, CAlphabet* alpha,
+				int32_t idx, int32_t start, int32_t num, int32_t* dst);
+
+		/** compute WD kernel on packed strings using block computation
+		 *
+		 * @param idx_a index of left-hand side string
+		 * @param idx_b index of right-hand side string
+		 * @return computed value
+		 */
+		float64_t compute_packed_using_block(int32_t idx_a, int32_t idx_b);
+
 		/** compute using block
 		 *
 		 * @param avec vector a
@@ -742,6 +820,9 @@ class CWeightedDegreeStringKernel: public CStringKernel<char>
 		/** if block computation is used */
 		bool block_computation;
 
+		/** if the compact layout of the tries is used */
+		bool use_compact_trie;
+
 		/** (internal) block weights */
 		float64_t* block_weights;
 		/** WeightedDegree kernel type */
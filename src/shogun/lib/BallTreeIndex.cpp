@@ -0,0 +1,127 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/lib/BallTreeIndex.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/base/Parameter.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+using namespace shogun;
+
+CBallTreeIndex::CBallTreeIndex() : CSpaceTreeIndex()
+{
+	init();
+}
+
+CBallTreeIndex::CBallTreeIndex(int32_t leaf_size) : CSpaceTreeIndex(leaf_size)
+{
+	init();
+}
+
+CBallTreeIndex::~CBallTreeIndex()
+{
+}
+
+void CBallTreeIndex::init()
+{
+	SG_ADD(&m_centers, "centers", "Centers of the balls of nodes",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_radii, "radii", "Radii of the balls of nodes", MS_NOT_AVAILABLE);
+}
+
+void CBallTreeIndex::init_bounds(int32_t num_nodes)
+{
+	m_centers=SGMatrix<float64_t>(m_data.num_rows, num_nodes);
+	m_radii=SGVector<float64_t>(num_nodes);
+}
+
+void CBallTreeIndex::compute_bounds(int32_t node, int32_t start, int32_t end)
+{
+	int32_t dim=m_data.num_rows;
+	float64_t* center=m_centers.get_column_vector(node);
+	memset(center, 0, sizeof(float64_t)*dim);
+
+	for (int32_t i=start; i<end; i++)
+	{
+		const float64_t* x=m_data.get_column_vector(m_perm[i]);
+		for (int32_t d=0; d<dim; d++)
+			center[d]+=x[d];
+	}
+
+	for (int32_t d=0; d<dim; d++)
+		center[d]/=end-start;
+
+	float64_t max_dist=sq_distance(center, m_perm[farthest(center, start, end)]);
+
+	/* slightly enlarged, such that rounding never prunes a contained vector */
+	m_radii[node]=CMath::sqrt(max_dist)*(1+1E-12);
+}
+
+int32_t CBallTreeIndex::farthest(const float64_t* x, int32_t start,
+		int32_t end) const
+{
+	int32_t result=start;
+	float64_t max_dist=-1;
+
+	for (int32_t i=start; i<end; i++)
+	{
+		float64_t dist=sq_distance(x, m_perm[i]);
+		if (dist>max_dist)
+		{
+			max_dist=dist;
+			result=i;
+		}
+	}
+
+	return result;
+}
+
+void CBallTreeIndex::split(int32_t node, int32_t start, int32_t end)
+{
+	int32_t dim=m_data.num_rows;
+	int32_t num=end-start;
+
+	const float64_t* a=m_data.get_column_vector(
+			m_perm[farthest(m_centers.get_column_vector(node), start, end)]);
+	const float64_t* b=m_data.get_column_vector(m_perm[farthest(a, start, end)]);
+
+	/* projections onto b-a, paired with the vector index */
+	std::vector<std::pair<float64_t, index_t> > proj(num);
+	for (int32_t i=0; i<num; i++)
+	{
+		const float64_t* x=m_data.get_column_vector(m_perm[start+i]);
+		float64_t p=0;
+		for (int32_t d=0; d<dim; d++)
+			p+=(b[d]-a[d])*x[d];
+
+		proj[i]=std::make_pair(p, m_perm[start+i]);
+	}
+
+	std::nth_element(proj.begin(), proj.begin()+num/2, proj.end());
+
+	for (int32_t i=0; i<num; i++)
+		m_perm[start+i]=proj[i].second;
+}
+
+float64_t CBallTreeIndex::min_sq_distance(int32_t node, const float64_t* q) const
+{
+	const float64_t* center=m_centers.get_column_vector(node);
+	float64_t dist=0;
+	for (int32_t d=0; d<m_data.num_rows; d++)
+	{
+		float64_t diff=q[d]-center[d];
+		dist+=diff*diff;
+	}
+
+	dist=CMath::sqrt(dist)-m_radii[node];
+	return dist>0 ? dist*dist : 0;
+}
@@ -0,0 +1,98 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#ifndef _BALLTREEINDEX_H__
+#define _BALLTREEINDEX_H__
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/SpaceTreeIndex.h>
+
+namespace shogun
+{
+
+/** @brief Exact nearest neighbor index based on a ball tree.
+ *
+ * Every node is bounded by the smallest ball around the mean of its vectors
+ * that contains all of them. A node is split at the median of the projections
+ * of its vectors onto the direction between two far apart vectors (the
+ * farthest vector a from the mean and the farthest vector from a). Unlike the
+ * boxes of CKDTreeIndex, the balls adapt to data lying on a low dimensional
+ * manifold of a high dimensional space.
+ *
+ * [1] Omohundro, S. M. (1989). Five balltree construction algorithms.
+ * Technical Report TR-89-063, International Computer Science Institute.
+ */
+class CBallTreeIndex : public CSpaceTreeIndex
+{
+	public:
+		/** default constructor */
+		CBallTreeIndex();
+
+		/** constructor
+		 *
+		 * @param leaf_size maximum number of vectors in a leaf
+		 */
+		CBallTreeIndex(int32_t leaf_size);
+
+		/** destructor */
+		virtual ~CBallTreeIndex();
+
+		/** @return type of index NI_BALL_TREE */
+		virtual ENeighborIndexType get_index_type() const { return NI_BALL_TREE; }
+
+		/** @return object name */
+		virtual const char* get_name() const { return "BallTreeIndex"; }
+
+	protected:
+		/** allocate the balls
+		 *
+		 * @param num_nodes number of nodes
+		 */
+		virtual void init_bounds(int32_t num_nodes);
+
+		/** compute the ball of a node
+		 *
+		 * @param node node
+		 * @param start first entry of m_perm covered by node
+		 * @param end one past the last entry of m_perm covered by node
+		 */
+		virtual void compute_bounds(int32_t node, int32_t start, int32_t end);
+
+		/** split a node at the median projection onto a direction between
+		 * two far apart vectors
+		 *
+		 * @param node node to split
+		 * @param start first entry of m_perm covered by node
+		 * @param end one past the last entry of m_perm covered by node
+		 */
+		virtual void split(int32_t node, int32_t start, int32_t end);
+
+		/** squared distance to the ball of a node
+		 *
+		 * @param node node
+		 * @param q query vector
+		 * @return squared distance of q to the ball
+		 */
+		virtual float64_t min_sq_distance(int32_t node, const float64_t* q) const;
+
+	private:
+		void init();
+
+		/** entry of m_perm in start..end-1 farthest from a vector */
+		int32_t farthest(const float64_t* x, int32_t start, int32_t end) const;
+
+	protected:
+		/** center of the ball of each node */
+		SGMatrix<float64_t> m_centers;
+
+		/** radius of the ball of each node */
+		SGVector<float64_t> m_radii;
+};
+}
+#endif
@@ -0,0 +1,325 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/lib/HNSWIndex.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/base/Parameter.h>
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+using namespace shogun;
+
+CHNSWIndex::CHNSWIndex() : CNeighborIndex()
+{
+	init();
+}
+
+CHNSWIndex::CHNSWIndex(int32_t M, int32_t ef_construction) : CNeighborIndex()
+{
+	init();
+	set_M(M);
+	set_ef_construction(ef_construction);
+}
+
+CHNSWIndex::~CHNSWIndex()
+{
+	cleanup_query();
+}
+
+void CHNSWIndex::init()
+{
+	m_M=16;
+	m_ef_construction=200;
+	m_ef_search=50;
+	m_entry_point=-1;
+	m_max_level=-1;
+	m_visited=NULL;
+	m_visit_tag=NULL;
+	m_num_visit_threads=0;
+
+	SG_ADD(&m_M, "M", "Number of links per node and layer", MS_AVAILABLE);
+	SG_ADD(&m_ef_construction, "ef_construction", "Beam width while building",
+			MS_AVAILABLE);
+	SG_ADD(&m_ef_search, "ef_search", "Beam width of queries", MS_AVAILABLE);
+	SG_ADD(&m_entry_point, "entry_point", "Node searches start at",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_max_level, "max_level", "Top layer", MS_NOT_AVAILABLE);
+	SG_ADD(&m_levels, "levels", "Top layer of nodes", MS_NOT_AVAILABLE);
+	SG_ADD(&m_link_offsets, "link_offsets", "Offsets of links of nodes",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_links, "links", "Links of nodes", MS_NOT_AVAILABLE);
+}
+
+void CHNSWIndex::set_M(int32_t M)
+{
+	REQUIRE(M>1, "Number of links (%d) has to be at least 2!\n", M)
+	m_M=M;
+}
+
+void CHNSWIndex::set_ef_construction(int32_t ef_construction)
+{
+	REQUIRE(ef_construction>0, "Beam width (%d) has to be positive!\n",
+			ef_construction)
+	m_ef_construction=ef_construction;
+}
+
+void CHNSWIndex::set_ef_search(int32_t ef_search)
+{
+	REQUIRE(ef_search>0, "Beam width (%d) has to be positive!\n", ef_search)
+	m_ef_search=ef_search;
+}
+
+void CHNSWIndex::init_query(int32_t num_threads)
+{
+	cleanup_query();
+
+	int32_t n=m_data.num_cols;
+	m_num_visit_threads=num_threads;
+	m_visited=SG_CALLOC(uint32_t, int64_t(n)*num_threads);
+	m_visit_tag=SG_CALLOC(uint32_t, num_threads);
+}
+
+void CHNSWIndex::cleanup_query()
+{
+	SG_FREE(m_visited);
+	SG_FREE(m_visit_tag);
+	m_visited=NULL;
+	m_visit_tag=NULL;
+	m_num_visit_threads=0;
+}
+
+void CHNSWIndex::build_index()
+{
+	int32_t n=m_data.num_cols;
+	float64_t level_mult=1.0/CMath::log(m_M);
+
+	/* exponentially decaying probability of the upper layers */
+	m_levels=SGVector<int32_t>(n);
+	m_link_offsets=SGVector<int64_t>(n);
+	int64_t num_links=0;
+	for (int32_t i=0; i<n; i++)
+	{
+		float64_t u=CMath::random(0.0, 1.0);
+		m_levels[i]=(int32_t) (-CMath::log(CMath::max(u, 1E-300))*level_mult);
+
+		m_link_offsets[i]=num_links;
+		num_links+=2*m_M+1+int64_t(m_levels[i])*(m_M+1);
+	}
+
+	m_links=SGVector<index_t>(num_links);
+	m_links.zero();
+	m_entry_point=-1;
+	m_max_level=-1;
+
+	init_query(1);
+	for (int32_t i=0; i<n; i++)
+		insert(i);
+	cleanup_query();
+
+	SG_DEBUG("%s has %d layers above layer 0\n", get_name(), m_max_level)
+}
+
+void CHNSWIndex::insert(index_t node)
+{
+	int32_t level=m_levels[node];
+
+	if (m_entry_point<0)
+	{
+		m_entry_point=node;
+		m_max_level=level;
+		return;
+	}
+
+	const float64_t* q=m_data.get_column_vector(node);
+	index_t ep=m_entry_point;
+	float64_t ep_dist=sq_distance(q, ep);
+
+	for (int32_t l=m_max_level; l>level; l--)
+		ep=greedy_search(q, ep, ep_dist, l);
+
+	candidates_t entry(1, std::make_pair(ep_dist, ep));
+	for (int32_t l=CMath::min(level, m_max_level); l>=0; l--)
+	{
+		int32_t max_links=l ? m_M : 2*m_M;
+		candidates_t found=search_layer(q, entry, m_ef_construction, l, 0);
+
+		index_t* links=get_links(node, l);
+		select_neighbors(found, m_M, links);
+
+		/* link back, pruning overfull neighbor lists */
+		for (int32_t j=1; j<=links[0]; j++)
+		{
+			index_t other=links[j];
+			index_t* other_links=get_links(other, l);
+
+			if (other_links[0]<max_links)
+			{
+				other_links[++other_links[0]]=node;
+				continue;
+			}
+
+			const float64_t* x=m_data.get_column_vector(other);
+			candidates_t candidates;
+			candidates.push_back(std::make_pair(sq_distance(x, node), node));
+			for (int32_t m=1; m<=other_links[0]; m++)
+			{
+				candidates.push_back(std::make_pair(
+						sq_distance(x, other_links[m]), other_links[m]));
+			}
+			std::sort(candidates.begin(), candidates.end());
+			select_neighbors(candidates, max_links, other_links);
+		}
+
+		entry=found;
+	}
+
+	if (level>m_max_level)
+	{
+		m_entry_point=node;
+		m_max_level=level;
+	}
+}
+
+index_t CHNSWIndex::greedy_search(const float64_t* q, index_t node,
+		float64_t& dist, int32_t level)
+{
+	bool changed=true;
+	while (changed)
+	{
+		changed=false;
+		index_t* links=get_links(node, level);
+		for (int32_t j=1; j<=links[0]; j++)
+		{
+			float64_t d=sq_distance(q, links[j]);
+			if (d<dist)
+			{
+				dist=d;
+				node=links[j];
+				changed=true;
+			}
+		}
+	}
+
+	return node;
+}
+
+CHNSWIndex::candidates_t CHNSWIndex::search_layer(const float64_t* q,
+		const candidates_t& entry, int32_t ef, int32_t level, int32_t thread)
+{
+	ASSERT(thread<m_num_visit_threads)
+
+	uint32_t* visited=&m_visited[int64_t(thread)*m_data.num_cols];
+	uint32_t tag=++m_visit_tag[thread];
+	if (tag==0)
+	{
+		/* marks wrapped around */
+		memset(visited, 0, sizeof(uint32_t)*m_data.num_cols);
+		tag=m_visit_tag[thread]=1;
+	}
+
+	typedef std::pair<float64_t, index_t> candidate_t;
+
+	/* closest unexpanded candidate on top */
+	std::priority_queue<candidate_t, candidates_t, std::greater<candidate_t> >
+		candidates;
+	/* farthest of the ef best on top */
+	std::priority_queue<candidate_t, candidates_t> best;
+
+	for (uint32_t i=0; i<entry.size(); i++)
+	{
+		visited[entry[i].second]=tag;
+		candidates.push(entry[i]);
+		best.push(entry[i]);
+		if (int32_t(best.size())>ef)
+			best.pop();
+	}
+
+	while (!candidates.empty())
+	{
+		candidate_t c=candidates.top();
+		if (c.first>best.top().first)
+			break;
+		candidates.pop();
+
+		index_t* links=get_links(c.second, level);
+		for (int32_t j=1; j<=links[0]; j++)
+		{
+			index_t other=links[j];
+			if (visited[other]==tag)
+				continue;
+			visited[other]=tag;
+
+			float64_t d=sq_distance(q, other);
+			if (int32_t(best.size())<ef || d<best.top().first)
+			{
+				candidates.push(std::make_pair(d, other));
+				best.push(std::make_pair(d, other));
+				if (int32_t(best.size())>ef)
+					best.pop();
+			}
+		}
+	}
+
+	candidates_t result(best.size());
+	for (int32_t i=best.size()-1; i>=0; i--)
+	{
+		result[i]=best.top();
+		best.pop();
+	}
+
+	return result;
+}
+
+void CHNSWIndex::select_neighbors(const candidates_t& candidates,
+		int32_t max_links, index_t* links) const
+{
+	int32_t num=0;
+
+	for (uint32_t i=0; i<candidates.size() && num<max_links; i++)
+	{
+		/* skip candidates closer to a selected neighbor than to the vector */
+		const float64_t* x=m_data.get_column_vector(candidates[i].second);
+		bool diverse=true;
+		for (int32_t j=1; j<=num && diverse; j++)
+			diverse=sq_distance(x, links[j])>candidates[i].first;
+
+		if (diverse)
+			links[++num]=candidates[i].second;
+	}
+
+	links[0]=num;
+}
+
+void CHNSWIndex::query_vector(const float64_t* q, int32_t k, index_t* idx,
+		float64_t* dist, int32_t thread)
+{
+	index_t ep=m_entry_point;
+	float64_t ep_dist=sq_distance(q, ep);
+
+	for (int32_t l=m_max_level; l>0; l--)
+		ep=greedy_search(q, ep, ep_dist, l);
+
+	candidates_t entry(1, std::make_pair(ep_dist, ep));
+	candidates_t found=search_layer(q, entry, CMath::max(m_ef_search, k), 0,
+			thread);
+
+	int32_t num=0;
+	if (int32_t(found.size())<k)
+	{
+		/* too few nodes reachable, fall back to all vectors */
+		for (index_t i=0; i<m_data.num_cols; i++)
+			insert_neighbor(i, sq_distance(q, i), k, num, idx, dist);
+		return;
+	}
+
+	for (uint32_t i=0; i<found.size(); i++)
+		insert_neighbor(found[i].second, found[i].first, k, num, idx, dist);
+}
@@ -0,0 +1,215 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#ifndef _HNSWINDEX_H__
+#define _HNSWINDEX_H__
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/NeighborIndex.h>
+#include <shogun/lib/SGVector.h>
+
+#include <vector>
+#include <utility>
+
+namespace shogun
+{
+
+/** @brief Approximate nearest neighbor index based on a hierarchical
+ * navigable small world (HNSW) graph.
+ *
+ * Every indexed vector is a node of a proximity graph on layer 0 and, with
+ * exponentially decreasing probability, of sparser graphs on the layers above.
+ * A query greedily walks down from the single node of the top layer to layer
+ * 0, where a beam search keeping the ef closest nodes seen so far returns the
+ * neighbors. The neighbors of a node are chosen with the heuristic of [1],
+ * which prefers neighbors in different directions and keeps the graph
+ * navigable for clustered data.
+ *
+ * The number of links per node (M, twice as many on layer 0) and the beam
+ * width used while building (ef_construction) control the quality of the
+ * graph, the beam width of queries (ef_search, at least k) trades recall
+ * against query time. Vectors are inserted sequentially (in index order, the
+ * layers are drawn via CMath::random), so the graph is reproducible, queries
+ * run in parallel.
+ *
+ * [1] Malkov, Y. A. and Yashunin, D. A. (2016). Efficient and robust
+ * approximate nearest neighbor search using hierarchical navigable small world
+ * graphs. arXiv:1603.09320.
+ */
+class CHNSWIndex : public CNeighborIndex
+{
+	public:
+		/** default constructor */
+		CHNSWIndex();
+
+		/** constructor
+		 *
+		 * @param M number of links per node and layer (2*M on layer 0)
+		 * @param ef_construction beam width while building
+		 */
+		CHNSWIndex(int32_t M, int32_t ef_construction=200);
+
+		/** destructor */
+		virtual ~CHNSWIndex();
+
+		/** set number of links per node, takes effect on the next build
+		 *
+		 * @param M number of links per node and layer (2*M on layer 0)
+		 */
+		void set_M(int32_t M);
+
+		/** @return number of links per node and layer */
+		int32_t get_M() const { return m_M; }
+
+		/** set beam width while building, takes effect on the next build
+		 *
+		 * @param ef_construction beam width
+		 */
+		void set_ef_construction(int32_t ef_construction);
+
+		/** @return beam width while building */
+		int32_t get_ef_construction() const { return m_ef_construction; }
+
+		/** set beam width of queries, k is used if it is larger
+		 *
+		 * @param ef_search beam width
+		 */
+		void set_ef_search(int32_t ef_search);
+
+		/** @return beam width of queries */
+		int32_t get_ef_search() const { return m_ef_search; }
+
+		/** @return number of layers above layer 0 */
+		int32_t get_max_level() const { return m_max_level; }
+
+		/** @return type of index NI_HNSW */
+		virtual ENeighborIndexType get_index_type() const { return NI_HNSW; }
+
+		/** @return false, neighbors are approximate */
+		virtual bool is_exact() const { return false; }
+
+		/** @return object name */
+		virtual const char* get_name() const { return "HNSWIndex"; }
+
+	protected:
+		/** build the graph over m_data */
+		virtual void build_index();
+
+		/** allocate per thread visited marks
+		 *
+		 * @param num_threads number of threads answering queries
+		 */
+		virtual void init_query(int32_t num_threads);
+
+		/** free per thread visited marks */
+		virtual void cleanup_query();
+
+		/** find (approximately) the k nearest indexed vectors of a vector
+		 *
+		 * @param q query vector
+		 * @param k number of neighbors
+		 * @param idx indices of the neighbors (output, k), closest first
+		 * @param dist squared distances of the neighbors (output, k)
+		 * @param thread index of the calling thread
+		 */
+		virtual void query_vector(const float64_t* q, int32_t k, index_t* idx,
+				float64_t* dist, int32_t thread);
+
+	private:
+		void init();
+
+		/** (squared distance, node) pairs */
+		typedef std::vector<std::pair<float64_t, index_t> > candidates_t;
+
+		/** links of a node on a layer, the first entry is their number */
+		inline index_t* get_links(index_t node, int32_t level)
+		{
+			int64_t offset=m_link_offsets[node];
+			if (level>0)
+				offset+=2*m_M+1+int64_t(level-1)*(m_M+1);
+			return &m_links.vector[offset];
+		}
+
+		/** greedily walk to the node closest to q on a layer
+		 *
+		 * @param q query vector
+		 * @param node start node
+		 * @param dist squared distance of q to node, updated
+		 * @param level layer
+		 * @return closest node found
+		 */
+		index_t greedy_search(const float64_t* q, index_t node, float64_t& dist,
+				int32_t level);
+
+		/** beam search on a layer
+		 *
+		 * @param q query vector
+		 * @param entry start nodes with their distance to q
+		 * @param ef beam width
+		 * @param level layer
+		 * @param thread index of the calling thread (for visited marks)
+		 * @return up to ef closest nodes found, closest first
+		 */
+		candidates_t search_layer(const float64_t* q, const candidates_t& entry,
+				int32_t ef, int32_t level, int32_t thread);
+
+		/** select diverse neighbors of a vector
+		 *
+		 * @param candidates candidates with their squared distance to the
+		 * vector, closest first
+		 * @param max_links maximum number of neighbors
+		 * @param links destination, first entry is the number of neighbors
+		 */
+		void select_neighbors(const candidates_t& candidates,
+				int32_t max_links, index_t* links) const;
+
+		/** insert a vector into the graph
+		 *
+		 * @param node index of vector
+		 */
+		void insert(index_t node);
+
+	protected:
+		/** number of links per node and layer (2*M on layer 0) */
+		int32_t m_M;
+
+		/** beam width while building */
+		int32_t m_ef_construction;
+
+		/** beam width of queries */
+		int32_t m_ef_search;
+
+		/** node the search starts at (on the top layer) */
+		int32_t m_entry_point;
+
+		/** top layer */
+		int32_t m_max_level;
+
+		/** top layer of each node */
+		SGVector<int32_t> m_levels;
+
+		/** offset of the links of each node into m_links */
+		SGVector<int64_t> m_link_offsets;
+
+		/** links of all nodes, per node 2*M+1 entries for layer 0 and M+1
+		 * entries for each layer above */
+		SGVector<index_t> m_links;
+
+	private:
+		/** visited mark of each node, per thread */
+		uint32_t* m_visited;
+
+		/** current visited mark, per thread */
+		uint32_t* m_visit_tag;
+
+		/** number of threads with visited marks */
+		int32_t m_num_visit_threads;
+};
+}
+#endif
@@ -0,0 +1,116 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/lib/KDTreeIndex.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/base/Parameter.h>
+
+#include <algorithm>
+
+using namespace shogun;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/* orders vector indices by one coordinate */
+struct kd_coordinate_less
+{
+	kd_coordinate_less(const SGMatrix<float64_t>& data, int32_t dim)
+		: m_data(data), m_dim(dim) { }
+
+	inline bool operator()(index_t a, index_t b) const
+	{
+		return m_data(m_dim, a)<m_data(m_dim, b);
+	}
+
+	const SGMatrix<float64_t>& m_data;
+	int32_t m_dim;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+CKDTreeIndex::CKDTreeIndex() : CSpaceTreeIndex()
+{
+	init();
+}
+
+CKDTreeIndex::CKDTreeIndex(int32_t leaf_size) : CSpaceTreeIndex(leaf_size)
+{
+	init();
+}
+
+CKDTreeIndex::~CKDTreeIndex()
+{
+}
+
+void CKDTreeIndex::init()
+{
+	SG_ADD(&m_bounds, "bounds", "Bounding boxes of nodes", MS_NOT_AVAILABLE);
+}
+
+void CKDTreeIndex::init_bounds(int32_t num_nodes)
+{
+	m_bounds=SGMatrix<float64_t>(2*m_data.num_rows, num_nodes);
+}
+
+void CKDTreeIndex::compute_bounds(int32_t node, int32_t start, int32_t end)
+{
+	int32_t dim=m_data.num_rows;
+	float64_t* lower=m_bounds.get_column_vector(node);
+	float64_t* upper=lower+dim;
+
+	const float64_t* x=m_data.get_column_vector(m_perm[start]);
+	memcpy(lower, x, sizeof(float64_t)*dim);
+	memcpy(upper, x, sizeof(float64_t)*dim);
+
+	for (int32_t i=start+1; i<end; i++)
+	{
+		x=m_data.get_column_vector(m_perm[i]);
+		for (int32_t d=0; d<dim; d++)
+		{
+			lower[d]=CMath::min(lower[d], x[d]);
+			upper[d]=CMath::max(upper[d], x[d]);
+		}
+	}
+}
+
+void CKDTreeIndex::split(int32_t node, int32_t start, int32_t end)
+{
+	int32_t dim=m_data.num_rows;
+	const float64_t* lower=m_bounds.get_column_vector(node);
+	const float64_t* upper=lower+dim;
+
+	int32_t split_dim=0;
+	for (int32_t d=1; d<dim; d++)
+	{
+		if (upper[d]-lower[d]>upper[split_dim]-lower[split_dim])
+			split_dim=d;
+	}
+
+	index_t* perm=m_perm.vector;
+	std::nth_element(perm+start, perm+start+(end-start)/2, perm+end,
+			kd_coordinate_less(m_data, split_dim));
+}
+
+float64_t CKDTreeIndex::min_sq_distance(int32_t node, const float64_t* q) const
+{
+	int32_t dim=m_data.num_rows;
+	const float64_t* lower=m_bounds.get_column_vector(node);
+	const float64_t* upper=lower+dim;
+
+	float64_t result=0;
+	for (int32_t d=0; d<dim; d++)
+	{
+		float64_t diff=0;
+		if (q[d]<lower[d])
+			diff=lower[d]-q[d];
+		else if (q[d]>upper[d])
+			diff=q[d]-upper[d];
+		result+=diff*diff;
+	}
+
+	return result;
+}
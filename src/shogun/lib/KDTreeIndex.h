@@ -0,0 +1,92 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#ifndef _KDTREEINDEX_H__
+#define _KDTREEINDEX_H__
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/SpaceTreeIndex.h>
+
+namespace shogun
+{
+
+/** @brief Exact nearest neighbor index based on a KD-tree.
+ *
+ * Every node is split at the median of the coordinate in which its vectors
+ * spread most. Nodes are bounded by the axis aligned bounding box of their
+ * vectors, which prunes well in low dimensions (up to about 20). See
+ * CBallTreeIndex for higher dimensional data and CHNSWIndex when approximate
+ * neighbors are sufficient.
+ *
+ * [1] Friedman, J. H., Bentley, J. L. and Finkel, R. A. (1977). An algorithm
+ * for finding best matches in logarithmic expected time. ACM Transactions on
+ * Mathematical Software 3(3).
+ */
+class CKDTreeIndex : public CSpaceTreeIndex
+{
+	public:
+		/** default constructor */
+		CKDTreeIndex();
+
+		/** constructor
+		 *
+		 * @param leaf_size maximum number of vectors in a leaf
+		 */
+		CKDTreeIndex(int32_t leaf_size);
+
+		/** destructor */
+		virtual ~CKDTreeIndex();
+
+		/** @return type of index NI_KD_TREE */
+		virtual ENeighborIndexType get_index_type() const { return NI_KD_TREE; }
+
+		/** @return object name */
+		virtual const char* get_name() const { return "KDTreeIndex"; }
+
+	protected:
+		/** allocate the bounding boxes
+		 *
+		 * @param num_nodes number of nodes
+		 */
+		virtual void init_bounds(int32_t num_nodes);
+
+		/** compute the bounding box of a node
+		 *
+		 * @param node node
+		 * @param start first entry of m_perm covered by node
+		 * @param end one past the last entry of m_perm covered by node
+		 */
+		virtual void compute_bounds(int32_t node, int32_t start, int32_t end);
+
+		/** split a node at the median of its widest coordinate
+		 *
+		 * @param node node to split
+		 * @param start first entry of m_perm covered by node
+		 * @param end one past the last entry of m_perm covered by node
+		 */
+		virtual void split(int32_t node, int32_t start, int32_t end);
+
+		/** squared distance to the bounding box of a node
+		 *
+		 * @param node node
+		 * @param q query vector
+		 * @return squared distance of q to the box
+		 */
+		virtual float64_t min_sq_distance(int32_t node, const float64_t* q) const;
+
+	private:
+		void init();
+
+	protected:
+		/** lower (first dim rows) and upper corner of the bounding box of
+		 * each node */
+		SGMatrix<float64_t> m_bounds;
+};
+}
+#endif
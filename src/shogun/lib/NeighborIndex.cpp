@@ -0,0 +1,112 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/lib/NeighborIndex.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/base/Parameter.h>
+
+using namespace shogun;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+struct NEIGHBOR_QUERY_THREAD_PARAM
+{
+	/** index */
+	CNeighborIndex* index;
+	/** query vectors */
+	SGMatrix<float64_t> queries;
+	/** number of neighbors */
+	int32_t k;
+	/** neighbors (k x n) */
+	index_t* idx;
+	/** squared distances of the neighbors (k x n) */
+	float64_t* dist;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+CNeighborIndex::CNeighborIndex() : CSGObject()
+{
+	init();
+}
+
+CNeighborIndex::~CNeighborIndex()
+{
+}
+
+void CNeighborIndex::init()
+{
+	SG_ADD(&m_data, "data", "Indexed vectors", MS_NOT_AVAILABLE);
+}
+
+void CNeighborIndex::build(CDenseFeatures<float64_t>* data)
+{
+	REQUIRE(data, "No features to index given!\n")
+	REQUIRE(data->get_num_vectors()>0, "No vectors to index!\n")
+
+	/* keep a copy, a subset is copied anyway */
+	m_data=data->get_feature_matrix();
+	if (!data->get_subset_stack()->has_subsets())
+		m_data=m_data.clone();
+
+	SG_DEBUG("Building %s over %d vectors of dimension %d\n", get_name(),
+			m_data.num_cols, m_data.num_rows)
+	build_index();
+}
+
+void CNeighborIndex::query_helper(int32_t start, int32_t end, int32_t thread,
+		void* p)
+{
+	NEIGHBOR_QUERY_THREAD_PARAM* params=(NEIGHBOR_QUERY_THREAD_PARAM*) p;
+	int32_t k=params->k;
+
+	for (int32_t i=start; i<end; i++)
+	{
+		params->index->query_vector(params->queries.get_column_vector(i), k,
+				&params->idx[int64_t(i)*k], &params->dist[int64_t(i)*k],
+				thread);
+	}
+}
+
+SGMatrix<index_t> CNeighborIndex::query(CDenseFeatures<float64_t>* queries,
+		int32_t k, SGMatrix<float64_t> distances)
+{
+	REQUIRE(is_built(), "%s was not built!\n", get_name())
+	REQUIRE(queries, "No query features given!\n")
+	REQUIRE(queries->get_num_features()==m_data.num_rows, "Dimension of "
+			"queries (%d) does not match dimension of indexed vectors (%d)!\n",
+			queries->get_num_features(), m_data.num_rows)
+	REQUIRE(k>0 && k<=m_data.num_cols, "Number of neighbors (%d) has to be "
+			"in 1..%d!\n", k, m_data.num_cols)
+
+	int32_t n=queries->get_num_vectors();
+	SGMatrix<index_t> neighbors(k, n);
+	if (!distances.matrix)
+		distances=SGMatrix<float64_t>(k, n);
+	REQUIRE(distances.num_rows==k && distances.num_cols==n, "Distance matrix "
+			"has to be %d x %d!\n", k, n)
+
+	int32_t num_threads=parallel->get_num_threads();
+	init_query(num_threads);
+
+	NEIGHBOR_QUERY_THREAD_PARAM params;
+	params.index=this;
+	params.queries=queries->get_feature_matrix();
+	params.k=k;
+	params.idx=neighbors.matrix;
+	params.dist=distances.matrix;
+	parallel->parallel_for(0, n, query_helper, &params);
+
+	cleanup_query();
+
+	for (int64_t i=0; i<int64_t(k)*n; i++)
+		distances.matrix[i]=CMath::sqrt(distances.matrix[i]);
+
+	return neighbors;
+}
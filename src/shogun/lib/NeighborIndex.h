@@ -0,0 +1,172 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#ifndef _NEIGHBORINDEX_H__
+#define _NEIGHBORINDEX_H__
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/base/SGObject.h>
+
+namespace shogun
+{
+template <class ST> class CDenseFeatures;
+
+/** type of a nearest neighbor index */
+enum ENeighborIndexType
+{
+	/** exact, axis aligned space partitioning (CKDTreeIndex) */
+	NI_KD_TREE = 0,
+	/** exact, hyper-sphere space partitioning (CBallTreeIndex) */
+	NI_BALL_TREE = 1,
+	/** approximate, hierarchical navigable small world graph (CHNSWIndex) */
+	NI_HNSW = 2
+};
+
+/** @brief Base class of indices answering k nearest neighbor queries on dense
+ * real valued vectors w.r.t. the euclidean distance.
+ *
+ * An index is built once over a set of vectors via build() and afterwards
+ * answers any number of queries via query(). The indexed vectors are copied,
+ * the index does not depend on the features it was built from. All of the
+ * index (vectors and search structure) is registered as parameters, so a
+ * built index can be serialized and is usable right after loading.
+ *
+ * Queries are answered in parallel, the vectors to query are distributed among
+ * the threads set via parallel->set_num_threads().
+ */
+class CNeighborIndex : public CSGObject
+{
+	public:
+		/** default constructor */
+		CNeighborIndex();
+
+		/** destructor */
+		virtual ~CNeighborIndex();
+
+		/** build the index, replaces any previously built index
+		 *
+		 * @param data vectors to index
+		 */
+		void build(CDenseFeatures<float64_t>* data);
+
+		/** find the k nearest indexed vectors of every query vector
+		 *
+		 * @param queries vectors to query, of the dimension of the indexed
+		 * vectors
+		 * @param k number of neighbors, at most the number of indexed vectors
+		 * @param distances if given, k x n matrix (n number of queries) to
+		 * write the euclidean distances of the neighbors to
+		 * @return k x n matrix, column i holds the indices of the neighbors of
+		 * query vector i, the closest in the first row
+		 */
+		SGMatrix<index_t> query(CDenseFeatures<float64_t>* queries, int32_t k,
+				SGMatrix<float64_t> distances=SGMatrix<float64_t>());
+
+		/** @return whether the index was built */
+		bool is_built() const { return m_data.num_cols>0; }
+
+		/** @return number of indexed vectors */
+		int32_t get_num_vectors() const { return m_data.num_cols; }
+
+		/** @return dimension of indexed vectors */
+		int32_t get_dim() const { return m_data.num_rows; }
+
+		/** @return type of index */
+		virtual ENeighborIndexType get_index_type() const=0;
+
+		/** @return whether queries return the exact nearest neighbors */
+		virtual bool is_exact() const { return true; }
+
+		/** @return object name */
+		virtual const char* get_name() const { return "NeighborIndex"; }
+
+	protected:
+		/** build the search structure over m_data */
+		virtual void build_index()=0;
+
+		/** called before a batch of queries is answered, e.g. to allocate
+		 * per thread work space
+		 *
+		 * @param num_threads number of threads answering queries
+		 */
+		virtual void init_query(int32_t num_threads) { }
+
+		/** called after a batch of queries was answered */
+		virtual void cleanup_query() { }
+
+		/** find the k nearest indexed vectors of a single vector, is called
+		 * concurrently by several threads
+		 *
+		 * @param q query vector
+		 * @param k number of neighbors
+		 * @param idx indices of the neighbors (output, k), closest first
+		 * @param dist squared distances of the neighbors (output, k)
+		 * @param thread index of the calling thread
+		 */
+		virtual void query_vector(const float64_t* q, int32_t k, index_t* idx,
+				float64_t* dist, int32_t thread)=0;
+
+		/** squared euclidean distance of a query vector to an indexed vector
+		 *
+		 * @param q query vector
+		 * @param i index of indexed vector
+		 * @return squared distance
+		 */
+		inline float64_t sq_distance(const float64_t* q, index_t i) const
+		{
+			const float64_t* x=m_data.get_column_vector(i);
+			float64_t result=0;
+			for (int32_t d=0; d<m_data.num_rows; d++)
+			{
+				float64_t diff=q[d]-x[d];
+				result+=diff*diff;
+			}
+			return result;
+		}
+
+		/** insert a candidate into the k best neighbors found so far, sorted
+		 * by ascending distance (ties by ascending index)
+		 *
+		 * @param i index of candidate
+		 * @param d squared distance of candidate
+		 * @param k number of neighbors
+		 * @param num number of neighbors found so far, updated
+		 * @param idx neighbors found so far
+		 * @param dist their squared distances
+		 */
+		static inline void insert_neighbor(index_t i, float64_t d, int32_t k,
+				int32_t& num, index_t* idx, float64_t* dist)
+		{
+			if (num==k && (d>dist[k-1] || (d==dist[k-1] && i>idx[k-1])))
+				return;
+
+			int32_t j=num<k ? num++ : k-1;
+			for (; j>0 && (dist[j-1]>d || (dist[j-1]==d && idx[j-1]>i)); j--)
+			{
+				dist[j]=dist[j-1];
+				idx[j]=idx[j-1];
+			}
+			dist[j]=d;
+			idx[j]=i;
+		}
+
+	private:
+		void init();
+
+		/** answers the queries of a range of query vectors */
+		static void query_helper(int32_t start, int32_t end, int32_t thread,
+				void* p);
+
+	protected:
+		/** indexed vectors, one per column */
+		SGMatrix<float64_t> m_data;
+};
+}
+#endif
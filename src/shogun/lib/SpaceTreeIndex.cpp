@@ -0,0 +1,148 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/lib/SpaceTreeIndex.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/base/Parameter.h>
+
+using namespace shogun;
+
+CSpaceTreeIndex::CSpaceTreeIndex() : CNeighborIndex()
+{
+	init();
+}
+
+CSpaceTreeIndex::CSpaceTreeIndex(int32_t leaf_size) : CNeighborIndex()
+{
+	init();
+	set_leaf_size(leaf_size);
+}
+
+CSpaceTreeIndex::~CSpaceTreeIndex()
+{
+}
+
+void CSpaceTreeIndex::init()
+{
+	m_leaf_size=16;
+
+	SG_ADD(&m_leaf_size, "leaf_size", "Maximum number of vectors in a leaf",
+			MS_AVAILABLE);
+	SG_ADD(&m_perm, "perm", "Original index of indexed vectors",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_node_start, "node_start", "First vector of nodes",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_node_end, "node_end", "End of vectors of nodes",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_node_left, "node_left", "First child of nodes",
+			MS_NOT_AVAILABLE);
+}
+
+void CSpaceTreeIndex::set_leaf_size(int32_t leaf_size)
+{
+	REQUIRE(leaf_size>0, "Leaf size (%d) has to be positive!\n", leaf_size)
+	m_leaf_size=leaf_size;
+}
+
+int32_t CSpaceTreeIndex::count_nodes(int32_t num) const
+{
+	if (num<=m_leaf_size)
+		return 1;
+
+	return 1+count_nodes(num/2)+count_nodes(num-num/2);
+}
+
+void CSpaceTreeIndex::build_index()
+{
+	int32_t n=m_data.num_cols;
+	int32_t num_nodes=count_nodes(n);
+
+	m_perm=SGVector<index_t>(n);
+	m_perm.range_fill();
+	m_node_start=SGVector<index_t>(num_nodes);
+	m_node_end=SGVector<index_t>(num_nodes);
+	m_node_left=SGVector<index_t>(num_nodes);
+	init_bounds(num_nodes);
+
+	int32_t next_node=1;
+	build_node(0, 0, n, next_node);
+	ASSERT(next_node==num_nodes)
+
+	/* store the vectors in tree order, such that leaves are contiguous */
+	SGMatrix<float64_t> ordered(m_data.num_rows, n);
+	for (int32_t i=0; i<n; i++)
+	{
+		memcpy(ordered.get_column_vector(i), m_data.get_column_vector(m_perm[i]),
+				sizeof(float64_t)*m_data.num_rows);
+	}
+	m_data=ordered;
+
+	SG_DEBUG("%s has %d nodes\n", get_name(), num_nodes)
+}
+
+void CSpaceTreeIndex::build_node(int32_t node, int32_t start, int32_t end,
+		int32_t& next_node)
+{
+	m_node_start[node]=start;
+	m_node_end[node]=end;
+	compute_bounds(node, start, end);
+
+	if (end-start<=m_leaf_size)
+	{
+		m_node_left[node]=-1;
+		return;
+	}
+
+	split(node, start, end);
+
+	int32_t left=next_node;
+	int32_t mid=start+(end-start)/2;
+	next_node+=2;
+	m_node_left[node]=left;
+	build_node(left, start, mid, next_node);
+	build_node(left+1, mid, end, next_node);
+}
+
+void CSpaceTreeIndex::query_vector(const float64_t* q, int32_t k,
+		index_t* idx, float64_t* dist, int32_t thread)
+{
+	int32_t num=0;
+	search(0, q, k, num, idx, dist);
+	ASSERT(num==k)
+}
+
+void CSpaceTreeIndex::search(int32_t node, const float64_t* q, int32_t k,
+		int32_t& num, index_t* idx, float64_t* dist) const
+{
+	int32_t left=m_node_left[node];
+
+	if (left<0)
+	{
+		for (int32_t i=m_node_start[node]; i<m_node_end[node]; i++)
+			insert_neighbor(m_perm[i], sq_distance(q, i), k, num, idx, dist);
+		return;
+	}
+
+	float64_t bound_left=min_sq_distance(left, q);
+	float64_t bound_right=min_sq_distance(left+1, q);
+
+	/* closer child first, the other one is likely to be pruned */
+	int32_t first=left;
+	int32_t second=left+1;
+	if (bound_right<bound_left)
+	{
+		CMath::swap(first, second);
+		CMath::swap(bound_left, bound_right);
+	}
+
+	if (num<k || bound_left<=dist[k-1])
+		search(first, q, k, num, idx, dist);
+	if (num<k || bound_right<=dist[k-1])
+		search(second, q, k, num, idx, dist);
+}
@@ -0,0 +1,142 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#ifndef _SPACETREEINDEX_H__
+#define _SPACETREEINDEX_H__
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/NeighborIndex.h>
+#include <shogun/lib/SGVector.h>
+
+namespace shogun
+{
+
+/** @brief Base class of exact nearest neighbor indices that recursively split
+ * the indexed vectors into two halves.
+ *
+ * Every node of the binary tree covers a contiguous range of the vectors,
+ * reordered such that the vectors of each node are adjacent in memory, and
+ * keeps a bounding region of its vectors. A node with at most leaf_size
+ * vectors is a leaf. Queries descend into the closer child first and skip
+ * every node whose bounding region is farther away than the k-th neighbor
+ * found so far.
+ *
+ * Subclasses define the bounding region (see CKDTreeIndex and
+ * CBallTreeIndex). Nodes are stored in flat arrays, the children of node i
+ * are the nodes left[i] and left[i]+1.
+ */
+class CSpaceTreeIndex : public CNeighborIndex
+{
+	public:
+		/** default constructor */
+		CSpaceTreeIndex();
+
+		/** constructor
+		 *
+		 * @param leaf_size maximum number of vectors in a leaf
+		 */
+		CSpaceTreeIndex(int32_t leaf_size);
+
+		/** destructor */
+		virtual ~CSpaceTreeIndex();
+
+		/** set maximum number of vectors in a leaf, takes effect on the next
+		 * build
+		 *
+		 * @param leaf_size leaf size
+		 */
+		void set_leaf_size(int32_t leaf_size);
+
+		/** @return maximum number of vectors in a leaf */
+		int32_t get_leaf_size() const { return m_leaf_size; }
+
+		/** @return number of nodes of the tree */
+		int32_t get_num_nodes() const { return m_node_start.vlen; }
+
+		/** @return object name */
+		virtual const char* get_name() const { return "SpaceTreeIndex"; }
+
+	protected:
+		/** build the tree over m_data */
+		virtual void build_index();
+
+		/** find the k nearest indexed vectors of a single vector
+		 *
+		 * @param q query vector
+		 * @param k number of neighbors
+		 * @param idx indices of the neighbors (output, k), closest first
+		 * @param dist squared distances of the neighbors (output, k)
+		 * @param thread index of the calling thread
+		 */
+		virtual void query_vector(const float64_t* q, int32_t k, index_t* idx,
+				float64_t* dist, int32_t thread);
+
+		/** allocate the bounding regions
+		 *
+		 * @param num_nodes number of nodes
+		 */
+		virtual void init_bounds(int32_t num_nodes)=0;
+
+		/** compute the bounding region of a node
+		 *
+		 * @param node node
+		 * @param start first entry of m_perm covered by node
+		 * @param end one past the last entry of m_perm covered by node
+		 */
+		virtual void compute_bounds(int32_t node, int32_t start, int32_t end)=0;
+
+		/** reorder the entries start..end-1 of m_perm such that the ones
+		 * before the middle start+(end-start)/2 form the first child
+		 *
+		 * @param node node to split, its bounds are computed
+		 * @param start first entry of m_perm covered by node
+		 * @param end one past the last entry of m_perm covered by node
+		 */
+		virtual void split(int32_t node, int32_t start, int32_t end)=0;
+
+		/** lower bound of the squared distance of the vectors of a node
+		 *
+		 * @param node node
+		 * @param q query vector
+		 * @return squared distance of q to the bounding region of node
+		 */
+		virtual float64_t min_sq_distance(int32_t node, const float64_t* q) const=0;
+
+	private:
+		void init();
+
+		/** number of nodes of a tree over num vectors */
+		int32_t count_nodes(int32_t num) const;
+
+		/** build the subtree rooted in node */
+		void build_node(int32_t node, int32_t start, int32_t end,
+				int32_t& next_node);
+
+		/** search the subtree rooted in node */
+		void search(int32_t node, const float64_t* q, int32_t k, int32_t& num,
+				index_t* idx, float64_t* dist) const;
+
+	protected:
+		/** maximum number of vectors in a leaf */
+		int32_t m_leaf_size;
+
+		/** original index of every (reordered) indexed vector */
+		SGVector<index_t> m_perm;
+
+		/** first vector of each node */
+		SGVector<index_t> m_node_start;
+
+		/** one past the last vector of each node */
+		SGVector<index_t> m_node_end;
+
+		/** first child of each node, -1 for leaves */
+		SGVector<index_t> m_node_left;
+};
+}
+#endif
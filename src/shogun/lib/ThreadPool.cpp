@@ -0,0 +1,426 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/lib/ThreadPool.h>
+#include <shogun/lib/Lock.h>
+#include <shogun/lib/memory.h>
+#include <shogun/io/SGIO.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/lib/ShogunException.h>
+
+#include <string.h>
+#include <exception>
+
+using namespace shogun;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace shogun
+{
+/** range of indices owned by one participating thread */
+struct ThreadPoolRange
+{
+	/** first unprocessed index */
+	int32_t begin;
+	/** one past the last index */
+	int32_t end;
+	/** protects begin and end, also for reading */
+	CLock lock;
+};
+
+/** a parallel loop as seen by the participating threads */
+struct ThreadPoolJob
+{
+	/** function to call */
+	range_function_t func;
+	/** user data */
+	void* data;
+	/** number of indices processed at once */
+	int32_t chunk_size;
+	/** number of participating threads (including the caller) */
+	int32_t num_participants;
+	/** number of participants that did not yet finish */
+	int32_t num_active;
+	/** one range per participant */
+	ThreadPoolRange* ranges;
+	/** capacity of ranges */
+	int32_t max_participants;
+	/** first exception thrown by func, rethrown in the caller */
+	ShogunException* error;
+	/** protects error */
+	CLock error_lock;
+};
+
+/** parameters of a worker thread */
+struct ThreadPoolWorker
+{
+	/** the pool */
+	CThreadPool* pool;
+	/** participant index of this worker (>=1, 0 is the caller) */
+	int32_t index;
+	/** id of the last job this worker has seen */
+	int64_t seen_job;
+#ifdef HAVE_PTHREAD
+	/** the thread */
+	pthread_t thread;
+#endif
+};
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+#ifdef HAVE_PTHREAD
+static CThreadPool* sg_thread_pool=NULL;
+static pthread_mutex_t sg_thread_pool_mutex=PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+CThreadPool::CThreadPool()
+{
+#ifdef HAVE_PTHREAD
+	m_workers=NULL;
+	m_num_workers=0;
+	m_job_id=0;
+	m_shutdown=false;
+
+	m_job=new ThreadPoolJob();
+	m_job->func=NULL;
+	m_job->data=NULL;
+	m_job->chunk_size=1;
+	m_job->num_participants=0;
+	m_job->num_active=0;
+	m_job->ranges=new ThreadPoolRange[1];
+	m_job->max_participants=1;
+	m_job->error=NULL;
+
+	pthread_mutex_init(&m_mutex, NULL);
+	pthread_mutex_init(&m_submit_mutex, NULL);
+	pthread_cond_init(&m_job_posted, NULL);
+	pthread_cond_init(&m_job_done, NULL);
+#endif
+}
+
+CThreadPool::~CThreadPool()
+{
+#ifdef HAVE_PTHREAD
+	pthread_mutex_lock(&m_mutex);
+	m_shutdown=true;
+	pthread_cond_broadcast(&m_job_posted);
+	pthread_mutex_unlock(&m_mutex);
+
+	for (int32_t i=0; i<m_num_workers; i++)
+	{
+		if (pthread_join(m_workers[i]->thread, NULL) != 0)
+			SG_SWARNING("pthread_join of thread %d/%d failed\n", i, m_num_workers)
+		delete m_workers[i];
+	}
+	SG_FREE(m_workers);
+
+	delete[] m_job->ranges;
+	delete m_job;
+
+	pthread_cond_destroy(&m_job_done);
+	pthread_cond_destroy(&m_job_posted);
+	pthread_mutex_destroy(&m_submit_mutex);
+	pthread_mutex_destroy(&m_mutex);
+#endif
+}
+
+CThreadPool* CThreadPool::get_thread_pool()
+{
+#ifdef HAVE_PTHREAD
+	pthread_mutex_lock(&sg_thread_pool_mutex);
+	if (!sg_thread_pool)
+		sg_thread_pool=new CThreadPool();
+	CThreadPool* pool=sg_thread_pool;
+	pthread_mutex_unlock(&sg_thread_pool_mutex);
+
+	return pool;
+#else
+	return NULL;
+#endif
+}
+
+void CThreadPool::destroy_thread_pool()
+{
+#ifdef HAVE_PTHREAD
+	pthread_mutex_lock(&sg_thread_pool_mutex);
+	CThreadPool* pool=sg_thread_pool;
+	sg_thread_pool=NULL;
+	pthread_mutex_unlock(&sg_thread_pool_mutex);
+
+	delete pool;
+#endif
+}
+
+int32_t CThreadPool::get_num_workers() const
+{
+#ifdef HAVE_PTHREAD
+	return m_num_workers;
+#else
+	return 0;
+#endif
+}
+
+void CThreadPool::ensure_workers(int32_t num)
+{
+#ifdef HAVE_PTHREAD
+	if (num<=m_num_workers)
+		return;
+
+	/* only called while holding m_submit_mutex, i.e. no job is running */
+	if (m_job->max_participants<num+1)
+	{
+		delete[] m_job->ranges;
+		m_job->ranges=new ThreadPoolRange[num+1];
+		m_job->max_participants=num+1;
+	}
+
+	m_workers=SG_REALLOC(ThreadPoolWorker*, m_workers, m_num_workers, num);
+
+	pthread_mutex_lock(&m_mutex);
+	for (int32_t i=m_num_workers; i<num; i++)
+	{
+		ThreadPoolWorker* worker=new ThreadPoolWorker();
+		worker->pool=this;
+		worker->index=i+1;
+		worker->seen_job=m_job_id;
+
+		int code=pthread_create(&worker->thread, NULL,
+				CThreadPool::worker_main, (void*) worker);
+
+		if (code != 0)
+		{
+			SG_SWARNING("Thread creation failed (thread %d of %d) "
+					"with error:'%s'\n", i, num, strerror(code));
+			delete worker;
+			break;
+		}
+
+		m_workers[i]=worker;
+		m_num_workers=i+1;
+	}
+	pthread_mutex_unlock(&m_mutex);
+#endif
+}
+
+void* CThreadPool::worker_main(void* p)
+{
+#ifdef HAVE_PTHREAD
+	ThreadPoolWorker* worker=(ThreadPoolWorker*) p;
+	CThreadPool* pool=worker->pool;
+
+	pthread_mutex_lock(&pool->m_mutex);
+	int64_t seen_job=worker->seen_job;
+
+	while (true)
+	{
+		while (!pool->m_shutdown && (pool->m_job_id==seen_job ||
+				worker->index>=pool->m_job->num_participants))
+		{
+			seen_job=pool->m_job_id;
+			pthread_cond_wait(&pool->m_job_posted, &pool->m_mutex);
+		}
+
+		if (pool->m_shutdown)
+			break;
+
+		seen_job=pool->m_job_id;
+		ThreadPoolJob* job=pool->m_job;
+		pthread_mutex_unlock(&pool->m_mutex);
+
+		run_job(job, worker->index);
+
+		pthread_mutex_lock(&pool->m_mutex);
+		if (--job->num_active==0)
+			pthread_cond_signal(&pool->m_job_done);
+	}
+
+	pthread_mutex_unlock(&pool->m_mutex);
+#endif
+	return NULL;
+}
+
+void CThreadPool::run_job(ThreadPoolJob* job, int32_t thread)
+{
+	ThreadPoolRange* ranges=job->ranges;
+	ThreadPoolRange* own=&ranges[thread];
+	int32_t n=job->num_participants;
+	int32_t chunk=job->chunk_size;
+
+	while (true)
+	{
+		/* work on own range front to back */
+		own->lock.lock();
+		if (own->begin<own->end)
+		{
+			int32_t start=own->begin;
+			int32_t stop=CMath::min(start+chunk, own->end);
+			own->begin=stop;
+			own->lock.unlock();
+
+			try
+			{
+				job->func(start, stop, thread, job->data);
+			}
+			catch (ShogunException& e)
+			{
+				abort_job(job, new ShogunException(e));
+			}
+			catch (std::exception& e)
+			{
+				abort_job(job, new ShogunException(e.what()));
+			}
+			catch (...)
+			{
+				abort_job(job, new ShogunException(
+						"Unknown exception in parallel loop\n"));
+			}
+			continue;
+		}
+		own->lock.unlock();
+
+		/* own range exhausted, steal upper half of the largest other range */
+		int32_t victim=-1;
+		int32_t largest=0;
+		for (int32_t i=1; i<n; i++)
+		{
+			int32_t t=(thread+i)%n;
+			ranges[t].lock.lock();
+			int32_t remaining=ranges[t].end-ranges[t].begin;
+			ranges[t].lock.unlock();
+			if (remaining>largest)
+			{
+				largest=remaining;
+				victim=t;
+			}
+		}
+
+		if (victim<0)
+			break;
+
+		int32_t steal_begin=0;
+		int32_t steal_end=0;
+		ThreadPoolRange* other=&ranges[victim];
+		other->lock.lock();
+		int32_t remaining=other->end-other->begin;
+		if (remaining>0)
+		{
+			steal_end=other->end;
+			if (remaining>chunk)
+				steal_begin=other->begin+remaining/2;
+			else
+				steal_begin=other->begin;
+			other->end=steal_begin;
+		}
+		other->lock.unlock();
+
+		if (steal_begin<steal_end)
+		{
+			own->lock.lock();
+			own->begin=steal_begin;
+			own->end=steal_end;
+			own->lock.unlock();
+		}
+	}
+}
+
+void CThreadPool::abort_job(ThreadPoolJob* job, ShogunException* error)
+{
+	job->error_lock.lock();
+	if (job->error)
+		delete error;
+	else
+		job->error=error;
+	job->error_lock.unlock();
+
+	/* drop all remaining work, participants then run out of ranges and
+	 * finish as usual */
+	for (int32_t t=0; t<job->num_participants; t++)
+	{
+		job->ranges[t].lock.lock();
+		job->ranges[t].end=job->ranges[t].begin;
+		job->ranges[t].lock.unlock();
+	}
+}
+
+void CThreadPool::parallel_for(int32_t start, int32_t end,
+		range_function_t func, void* data, int32_t num_threads,
+		int32_t chunk_size)
+{
+	int32_t num=end-start;
+	if (num<=0)
+		return;
+
+	if (chunk_size<=0)
+		chunk_size=CMath::max(1, num/(CMath::max(1, num_threads)*16));
+
+	int32_t num_participants=CMath::min(num_threads, (num+chunk_size-1)/chunk_size);
+
+#ifdef HAVE_PTHREAD
+	/* run serially if only one thread is requested or the pool is busy
+	 * (nested call from within a job or concurrent call from another
+	 * thread) */
+	if (num_participants<2 || pthread_mutex_trylock(&m_submit_mutex)!=0)
+	{
+#endif
+		func(start, end, 0, data);
+		return;
+#ifdef HAVE_PTHREAD
+	}
+
+	ensure_workers(num_participants-1);
+	num_participants=CMath::min(num_participants, m_num_workers+1);
+
+	if (num_participants<2)
+	{
+		pthread_mutex_unlock(&m_submit_mutex);
+		func(start, end, 0, data);
+		return;
+	}
+
+	/* split [start,end) into one contiguous range per participant */
+	ThreadPoolJob* job=m_job;
+	int32_t step=num/num_participants;
+	for (int32_t t=0; t<num_participants; t++)
+	{
+		job->ranges[t].begin=start+t*step;
+		job->ranges[t].end=(t==num_participants-1) ? end : start+(t+1)*step;
+	}
+
+	pthread_mutex_lock(&m_mutex);
+	job->error=NULL;
+	job->func=func;
+	job->data=data;
+	job->chunk_size=chunk_size;
+	job->num_participants=num_participants;
+	job->num_active=num_participants-1;
+	m_job_id++;
+	pthread_cond_broadcast(&m_job_posted);
+	pthread_mutex_unlock(&m_mutex);
+
+	run_job(job, 0);
+
+	pthread_mutex_lock(&m_mutex);
+	while (job->num_active>0)
+		pthread_cond_wait(&m_job_done, &m_mutex);
+	job->num_participants=0;
+	ShogunException* error=job->error;
+	job->error=NULL;
+	pthread_mutex_unlock(&m_mutex);
+
+	pthread_mutex_unlock(&m_submit_mutex);
+
+	/* all participants are done with the caller's data, so the exception
+	 * can now safely leave parallel_for */
+	if (error)
+	{
+		ShogunException e(*error);
+		delete error;
+		throw e;
+	}
+#endif
+}
@@ -0,0 +1,161 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#ifndef __THREADPOOL_H__
+#define __THREADPOOL_H__
+
+#include <shogun/lib/config.h>
+#include <shogun/lib/common.h>
+
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+namespace shogun
+{
+
+/** function executed by the thread pool on a sub range [start, end) of a
+ * parallel loop
+ *
+ * @param start first index of the range
+ * @param end one past the last index of the range
+ * @param thread index of the executing thread (0 <= thread < number of
+ * threads used for this loop), e.g. to address per thread accumulators
+ * @param data user data passed to parallel_for
+ */
+typedef void (*range_function_t)(int32_t start, int32_t end, int32_t thread,
+		void* data);
+
+class ShogunException;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+struct ThreadPoolJob;
+struct ThreadPoolWorker;
+#endif
+
+/** @brief Class CThreadPool implements a process wide pool of persistent
+ * worker threads.
+ *
+ * Instead of creating and joining threads on every call, parallel loops are
+ * handed to threads that are created once and afterwards sleep until work
+ * arrives. A loop over [start, end) is initially split into one contiguous
+ * range per thread. Threads process their range in chunks of chunk_size
+ * indices and, once their own range is exhausted, steal the upper half of
+ * the largest remaining range of another thread. This way uneven per index
+ * costs (e.g. triangular kernel matrices) do not stall on the slowest
+ * thread.
+ *
+ * The calling thread always participates in the computation. The pool runs
+ * one loop at a time. If it is already busy, the loop is executed serially
+ * by the caller instead of waiting, so nested parallelism can never
+ * deadlock. This applies to nested calls from within a running loop, but
+ * also to concurrent calls from other threads: e.g. while cross-validation
+ * folds or the submachines of a multiclass machine are trained in
+ * parallel, the loops inside each of them run serially, except for the one
+ * that happened to get hold of the pool. The outer level then provides the
+ * parallelism.
+ *
+ * If func throws, the remaining indices of the loop are dropped and the
+ * first exception is rethrown in the calling thread once all participants
+ * have returned.
+ *
+ * Use get_thread_pool() to obtain the process wide instance. Usually one
+ * does not use this class directly but Parallel::parallel_for().
+ */
+class CThreadPool
+{
+public:
+	/** constructor */
+	CThreadPool();
+
+	/** destructor, joins all worker threads */
+	~CThreadPool();
+
+	/** run func on all indices in [start, end)
+	 *
+	 * @param start first index
+	 * @param end one past the last index
+	 * @param func function to call on sub ranges
+	 * @param data user data passed to func
+	 * @param num_threads maximum number of threads (including the caller)
+	 * @param chunk_size number of indices processed at once, if <=0 a chunk
+	 * size is chosen automatically
+	 *
+	 * Runs serially in the caller if the pool is busy with another loop.
+	 * Exceptions thrown by func are rethrown as ShogunException after all
+	 * threads stopped working on the loop.
+	 */
+	void parallel_for(int32_t start, int32_t end, range_function_t func,
+			void* data, int32_t num_threads, int32_t chunk_size=0);
+
+	/** @return number of currently running worker threads (the caller not
+	 * included) */
+	int32_t get_num_workers() const;
+
+	/** @return the process wide thread pool, created on first use */
+	static CThreadPool* get_thread_pool();
+
+	/** shut down the process wide thread pool (it will be re-created on
+	 * next use) */
+	static void destroy_thread_pool();
+
+	/** @return name of the object */
+	const char* get_name() const { return "ThreadPool"; }
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+	/** thread main function of a worker */
+	static void* worker_main(void* p);
+
+	/** process job as participant thread */
+	static void run_job(ThreadPoolJob* job, int32_t thread);
+
+	/** record error (the first one is kept) and drop the remaining work
+	 * of job */
+	static void abort_job(ThreadPoolJob* job, ShogunException* error);
+#endif
+
+private:
+	/** make sure there are at least num worker threads
+	 *
+	 * @param num number of workers
+	 */
+	void ensure_workers(int32_t num);
+
+#ifdef HAVE_PTHREAD
+private:
+	/** worker threads */
+	ThreadPoolWorker** m_workers;
+
+	/** number of running workers */
+	int32_t m_num_workers;
+
+	/** mutex protecting the job state */
+	pthread_mutex_t m_mutex;
+
+	/** condition signalled when a new job is posted */
+	pthread_cond_t m_job_posted;
+
+	/** condition signalled when a participant finished */
+	pthread_cond_t m_job_done;
+
+	/** serializes concurrent calls to parallel_for */
+	pthread_mutex_t m_submit_mutex;
+
+	/** currently running job */
+	ThreadPoolJob* m_job;
+
+	/** id of the current job, incremented on every post */
+	int64_t m_job_id;
+
+	/** whether the workers shall terminate */
+	bool m_shutdown;
+#endif
+};
+}
+#endif // __THREADPOOL_H__
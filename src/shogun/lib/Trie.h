@@ -18,6 +18,7 @@
 #include <shogun/base/DynArray.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/base/SGObject.h>
+#include <shogun/lib/Lock.h>
 
 namespace shogun
 {
@@ -40,6 +41,19 @@ namespace shogun
 
 #define TRIE_TERMINAL_CHARACTER  7
 
+// flag in the child mask of the compact layout, set if the weight of child c
+// is always multiplied by the weights column (nodes of compact terminal nodes)
+#define TRIE_COMPACT_SCALE(c) (0x10<<(c))
+
+// number of sequences traversed interleaved in the compact batch evaluation
+#define TRIE_COMPACT_BATCH 16
+
+#ifdef __GNUC__
+#define TRIE_PREFETCH(x) __builtin_prefetch(x)
+#else
+#define TRIE_PREFETCH(x)
+#endif
+
 /** consensus entry */
 struct ConsensusEntry
 {
@@ -130,6 +144,19 @@ struct TreeParseInfo {
 	float64_t* R_k;
 };
 
+/** node of a trie whose children are not yet laid out in the compact
+ * level ordered layout */
+struct TrieCompactEntry
+{
+	/** node in the tree memory, -1 for leaves */
+	int32_t node;
+	/** position within the sequence of a compact terminal node, -1 for
+	 * regular nodes */
+	int32_t seq_offset;
+	/** depth */
+	int32_t depth;
+};
+
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
 template <class Trie> class CTrie;
@@ -284,6 +311,87 @@ IGNORE_IN_CLASSLIST template <class Trie> class CTrie : public CSGObject
 			int32_t weight_pos, float64_t * weights,
 			bool degree_times_position_weights) ;
 
+		/** create the compact level ordered layout of the trees
+		 *
+		 * The nodes of each tree are stored breadth first in flat arrays
+		 * such that the children of a node are contiguous and nodes of the
+		 * same depth are close in memory. A node consists of a child mask,
+		 * the index of its first child and a float32 weight; compact
+		 * terminal nodes are expanded into paths. The layout is read only,
+		 * any change to the trie invalidates it.
+		 *
+		 * If release_trees is set, the nodes of the trees are freed once
+		 * they are packed, such that only the compact layout is kept in
+		 * memory. Nothing can be added to the trees then until they are
+		 * deleted (see delete_trees()), and everything but the compact
+		 * layout sees empty trees.
+		 *
+		 * @param tree tree to lay out, -1 for all trees
+		 * @param release_trees if the nodes of the trees shall be freed
+		 */
+		void create_compact_trees(int32_t tree=-1, bool release_trees=false);
+
+		/** create the compact layout of all trees unless it is up to date,
+		 * safe to be called from several threads
+		 *
+		 * @param release_trees if the nodes of the trees shall be freed,
+		 * see create_compact_trees()
+		 */
+		void ensure_compact_trees(bool release_trees=false);
+
+		/** @return whether the nodes of the trees were freed after
+		 * creating the compact layout */
+		bool get_trees_released() const { return trees_released; }
+
+		/** delete the compact layout */
+		void delete_compact_trees();
+
+		/** @return whether the compact layout of all trees is up to date */
+		bool has_compact_trees() const { return compact_trees_valid; }
+
+		/** @return number of nodes in the compact layout */
+		int32_t get_num_compact_nodes() const { return num_compact_nodes; }
+
+		/** compute by compact tree, equivalent to compute_by_tree_helper
+		 * up to the float32 precision of the weights
+		 *
+		 * @param vec vector
+		 * @param len length
+		 * @param seq_pos sequence position
+		 * @param tree_pos tree position
+		 * @param weight_pos weight position
+		 * @param weights
+		 * @param degree_times_position_weights if degree times position
+		 *                                      weights shall be applied
+		 * @return a computed value
+		 */
+		float64_t compute_by_compact_tree(
+			int32_t* vec, int32_t len, int32_t seq_pos, int32_t tree_pos,
+			int32_t weight_pos, float64_t* weights,
+			bool degree_times_position_weights);
+
+		/** compute by compact tree for a batch of sequences
+		 *
+		 * The sequences are traversed level by level in an interleaved
+		 * fashion, the nodes of the next level are prefetched while the
+		 * other sequences are processed.
+		 *
+		 * @param syms num x degree matrix (row major) of the symbols of the
+		 *             sequences starting at the tree position
+		 * @param num_syms number of valid symbols of each sequence
+		 * @param num number of sequences
+		 * @param tree_pos tree position
+		 * @param weight_pos weight position
+		 * @param weights
+		 * @param degree_times_position_weights if degree times position
+		 *                                      weights shall be applied
+		 * @param result computed values (num)
+		 */
+		void compute_by_compact_tree_batch(
+			const int32_t* syms, const int32_t* num_syms, int32_t num,
+			int32_t tree_pos, int32_t weight_pos, float64_t* weights,
+			bool degree_times_position_weights, float64_t* result);
+
 		/** compute by tree helper
 		 *
 		 * @param vec vector
@@ -367,6 +475,17 @@ IGNORE_IN_CLASSLIST template <class Trie> class CTrie : public CSGObject
 			const struct TreeParseInfo info, const int32_t p, int32_t* x,
 			const int32_t k);
 
+		/** free the nodes of all trees and shrink the node memory to its
+		 * initial size, the trees are empty afterwards */
+		void release_tree_nodes();
+
+		/** copy the compact layout (and whether the trees were released)
+		 * of another trie of the same length
+		 *
+		 * @param to_copy trie to copy from
+		 */
+		void copy_compact_trees(const CTrie & to_copy);
+
 		/** compact nodes
 		 *
 		 * @param start_node start node
@@ -656,6 +775,25 @@ IGNORE_IN_CLASSLIST template <class Trie> class CTrie : public CSGObject
 
 		/** nofsKmers */
 		int32_t* nofsKmers;
+
+		/** compact layout: first node of each tree, -1 if empty */
+		int32_t* compact_roots;
+		/** compact layout: index of the first child of each node */
+		int32_t* compact_first_child;
+		/** compact layout: child mask (and TRIE_COMPACT_SCALE flags) of
+		 * each node */
+		uint8_t* compact_mask;
+		/** compact layout: weight of each node */
+		float32_t* compact_weights;
+		/** number of nodes in the compact layout */
+		int32_t num_compact_nodes;
+		/** if the compact layout of all trees is up to date */
+		volatile bool compact_trees_valid;
+		/** lock for creating the compact layout on demand */
+		CLock compact_lock;
+		/** if the nodes of the trees were freed after creating the compact
+		 * layout */
+		bool trees_released;
 };
 	template <class Trie>
 	CTrie<Trie>::CTrie()
@@ -671,6 +809,14 @@ IGNORE_IN_CLASSLIST template <class Trie> class CTrie : public CSGObject
 		length=0;
 		trees=NULL;
 
+		compact_roots=NULL;
+		compact_first_child=NULL;
+		compact_mask=NULL;
+		compact_weights=NULL;
+		num_compact_nodes=0;
+		compact_trees_valid=false;
+		trees_released=false;
+
 		NUM_SYMS=4;
 	}
 
@@ -687,6 +833,14 @@ IGNORE_IN_CLASSLIST template <class Trie> class CTrie : public CSGObject
 		length=0;
 		trees=NULL;
 
+		compact_roots=NULL;
+		compact_first_child=NULL;
+		compact_mask=NULL;
+		compact_weights=NULL;
+		num_compact_nodes=0;
+		compact_trees_valid=false;
+		trees_released=false;
+
 		NUM_SYMS=4;
 	}
 
@@ -715,6 +869,15 @@ IGNORE_IN_CLASSLIST template <class Trie> class CTrie : public CSGObject
 		for (int32_t i=0; i<length; i++)
 			trees[i]=to_copy.trees[i];
 
+		compact_roots=NULL;
+		compact_first_child=NULL;
+		compact_mask=NULL;
+		compact_weights=NULL;
+		num_compact_nodes=0;
+		compact_trees_valid=false;
+		trees_released=false;
+		copy_compact_trees(to_copy);
+
 		NUM_SYMS=4;
 	}
 
@@ -749,6 +912,10 @@ const CTrie<Trie> &CTrie<Trie>::operator=(const CTrie<Trie> & to_copy)
 	for (int32_t i=0; i<length; i++)
 		trees[i]=to_copy.trees[i] ;
 
+	delete_compact_trees();
+	trees_released=false;
+	copy_compact_trees(to_copy);
+
 	return *this ;
 }
 
@@ -1133,6 +1300,8 @@ template <class Trie> CTrie<Trie>::~CTrie()
 
 template <class Trie> void CTrie<Trie>::destroy()
 {
+	delete_compact_trees();
+
 	if (trees!=NULL)
 	{
 		delete_trees();
@@ -1162,6 +1331,7 @@ template <class Trie> void CTrie<Trie>::create(
 	for (int32_t i=0; i<len; i++)
 		trees[i]=get_node(degree==1);
 	length = len ;
+	trees_released=false;
 
 	use_compact_terminal_nodes=p_use_compact_terminal_nodes ;
 }
@@ -1173,6 +1343,9 @@ template <class Trie> void CTrie<Trie>::delete_trees(
 	if (trees==NULL)
 		return;
 
+	delete_compact_trees();
+	trees_released=false;
+
 	TreeMemPtr=0 ;
 	for (int32_t i=0; i<length; i++)
 		trees[i]=get_node(degree==1);
@@ -1212,6 +1385,9 @@ float64_t CTrie<Trie>::compute_abs_weights_tree(int32_t tree, int32_t depth)
 	template <class Trie>
 float64_t *CTrie<Trie>::compute_abs_weights(int32_t &len)
 {
+	REQUIRE(!trees_released, "%s::compute_abs_weights(): Nodes of the "
+			"trees were released\n", get_name())
+
 	float64_t * sum=SG_MALLOC(float64_t, length*4);
 	for (int32_t i=0; i<length*4; i++)
 		sum[i]=0 ;
@@ -1236,6 +1412,10 @@ void CTrie<Trie>::add_example_to_tree_mismatch_recursion(
 		int32_t degree_rec, int32_t mismatch_rec,
 		int32_t max_mismatch, float64_t * weights)
 {
+	REQUIRE(!trees_released, "%s: Nodes of the trees were released, "
+			"delete the trees before adding to them\n", get_name())
+	compact_trees_valid=false;
+
 	if (tree==NO_CHILD)
 		tree=trees[i] ;
 	TRIE_ASSERT(tree!=NO_CHILD)
@@ -1499,6 +1679,10 @@ void CTrie<Trie>::add_to_trie(
 	int32_t tree = trees[i] ;
 	//ASSERT(seq_offset==0)
 
+	REQUIRE(!trees_released, "%s: Nodes of the trees were released, "
+			"delete the trees before adding to them\n", get_name())
+	compact_trees_valid=false;
+
 	int32_t max_depth = 0 ;
 	float64_t* weights_column ;
 	if (degree_times_position_weights)
@@ -1792,6 +1976,330 @@ float64_t CTrie<Trie>::compute_by_tree_helper(
 		return sum ;
 }
 
+template <class Trie>
+void CTrie<Trie>::create_compact_trees(int32_t tree, bool release_trees)
+{
+	delete_compact_trees();
+
+	if (trees==NULL)
+		return;
+
+	int32_t first=0;
+	int32_t last=length;
+	if (tree>=0)
+	{
+		first=tree;
+		last=tree+1;
+	}
+
+	compact_roots=SG_MALLOC(int32_t, length);
+	for (int32_t i=0; i<length; i++)
+		compact_roots[i]=-1;
+
+	int32_t max_nodes=1024;
+	compact_first_child=SG_MALLOC(int32_t, max_nodes);
+	compact_mask=SG_MALLOC(uint8_t, max_nodes);
+	compact_weights=SG_MALLOC(float32_t, max_nodes);
+	TrieCompactEntry* entries=SG_MALLOC(TrieCompactEntry, max_nodes);
+	num_compact_nodes=0;
+
+	for (int32_t t=first; t<last; t++)
+	{
+		if (trees[t]==NO_CHILD)
+			continue;
+
+		compact_roots[t]=num_compact_nodes;
+		entries[num_compact_nodes].node=trees[t];
+		entries[num_compact_nodes].seq_offset=-1;
+		entries[num_compact_nodes].depth=0;
+		compact_mask[num_compact_nodes]=0;
+		compact_weights[num_compact_nodes]=0;
+		num_compact_nodes++;
+
+		/* breadth first, the nodes appended so far act as the queue */
+		for (int32_t n=compact_roots[t]; n<num_compact_nodes; n++)
+		{
+			/* at most four children */
+			if (num_compact_nodes+4>max_nodes)
+			{
+				int32_t new_max=2*max_nodes;
+				compact_first_child=SG_REALLOC(int32_t, compact_first_child,
+						max_nodes, new_max);
+				compact_mask=SG_REALLOC(uint8_t, compact_mask, max_nodes,
+						new_max);
+				compact_weights=SG_REALLOC(float32_t, compact_weights,
+						max_nodes, new_max);
+				entries=SG_REALLOC(TrieCompactEntry, entries, max_nodes,
+						new_max);
+				max_nodes=new_max;
+			}
+
+			TrieCompactEntry e=entries[n];
+			compact_first_child[n]=num_compact_nodes;
+
+			for (int32_t c=0; c<4; c++)
+			{
+				int32_t child_node=-1;
+				int32_t child_offset=-1;
+				float32_t child_weight=0;
+				bool scale=false;
+
+				if (e.node<0)
+					break;
+				else if (e.seq_offset>=0)
+				{
+					/* path through a compact terminal node */
+					int32_t k=e.seq_offset+1;
+					if (e.depth>=degree || k>=16 || TreeMem[e.node].seq[k]!=c)
+						continue;
+
+					child_node=e.node;
+					child_offset=k;
+					child_weight=TreeMem[e.node].weight;
+					scale=true;
+				}
+				else if (e.depth==degree-1)
+				{
+					if (TreeMem[e.node].child_weights[c]==0)
+						continue;
+
+					child_weight=TreeMem[e.node].child_weights[c];
+				}
+				else if (e.depth<degree-1)
+				{
+					int32_t child=TreeMem[e.node].children[c];
+					if (child==NO_CHILD)
+						continue;
+
+					if (child<0)
+					{
+						child_node=-child;
+						child_offset=0;
+						scale=true;
+					}
+					else
+						child_node=child;
+
+					child_weight=TreeMem[child_node].weight;
+				}
+				else
+					break;
+
+				compact_mask[n]|=1<<c;
+				if (scale)
+					compact_mask[n]|=TRIE_COMPACT_SCALE(c);
+				entries[num_compact_nodes].node=child_node;
+				entries[num_compact_nodes].seq_offset=child_offset;
+				entries[num_compact_nodes].depth=e.depth+1;
+				compact_mask[num_compact_nodes]=0;
+				compact_weights[num_compact_nodes]=child_weight;
+				num_compact_nodes++;
+			}
+		}
+	}
+
+	SG_FREE(entries);
+
+	/* the arrays grew by doubling */
+	compact_first_child=SG_REALLOC(int32_t, compact_first_child, max_nodes,
+			num_compact_nodes);
+	compact_mask=SG_REALLOC(uint8_t, compact_mask, max_nodes,
+			num_compact_nodes);
+	compact_weights=SG_REALLOC(float32_t, compact_weights, max_nodes,
+			num_compact_nodes);
+
+	compact_trees_valid=(tree<0);
+
+	if (release_trees)
+		release_tree_nodes();
+}
+
+template <class Trie>
+void CTrie<Trie>::ensure_compact_trees(bool release_trees)
+{
+	if (compact_trees_valid)
+		return;
+
+	compact_lock.lock();
+	if (!compact_trees_valid)
+		create_compact_trees(-1, release_trees);
+	compact_lock.unlock();
+}
+
+template <class Trie>
+void CTrie<Trie>::release_tree_nodes()
+{
+	if (trees==NULL)
+		return;
+
+	SG_FREE(TreeMem);
+	TreeMemPtrMax=1024*1024/sizeof(Trie);
+	TreeMemPtr=0;
+	TreeMem=SG_MALLOC(Trie, TreeMemPtrMax);
+
+	for (int32_t i=0; i<length; i++)
+		trees[i]=get_node(degree==1);
+
+	trees_released=true;
+}
+
+template <class Trie>
+void CTrie<Trie>::copy_compact_trees(const CTrie & to_copy)
+{
+	if (to_copy.compact_roots==NULL)
+		return;
+
+	int32_t num=to_copy.num_compact_nodes;
+	compact_roots=SG_MALLOC(int32_t, length);
+	memcpy(compact_roots, to_copy.compact_roots, sizeof(int32_t)*length);
+	compact_first_child=SG_MALLOC(int32_t, num);
+	memcpy(compact_first_child, to_copy.compact_first_child, sizeof(int32_t)*num);
+	compact_mask=SG_MALLOC(uint8_t, num);
+	memcpy(compact_mask, to_copy.compact_mask, sizeof(uint8_t)*num);
+	compact_weights=SG_MALLOC(float32_t, num);
+	memcpy(compact_weights, to_copy.compact_weights, sizeof(float32_t)*num);
+	num_compact_nodes=num;
+	compact_trees_valid=to_copy.compact_trees_valid;
+	trees_released=to_copy.trees_released;
+}
+
+template <class Trie>
+void CTrie<Trie>::delete_compact_trees()
+{
+	compact_trees_valid=false;
+
+	SG_FREE(compact_roots);
+	SG_FREE(compact_first_child);
+	SG_FREE(compact_mask);
+	SG_FREE(compact_weights);
+	compact_roots=NULL;
+	compact_first_child=NULL;
+	compact_mask=NULL;
+	compact_weights=NULL;
+	num_compact_nodes=0;
+}
+
+/* number of children preceding a symbol, indexed by the masked child mask */
+static const uint8_t trie_compact_rank[16]=
+	{ 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+template <class Trie>
+float64_t CTrie<Trie>::compute_by_compact_tree(
+	int32_t* vec, int32_t len, int32_t seq_pos, int32_t tree_pos,
+	int32_t weight_pos, float64_t* weights,
+	bool degree_times_position_weights)
+{
+	if ((position_weights!=NULL) && (position_weights[weight_pos]==0))
+		return 0.0;
+
+	float64_t *weights_column=NULL ;
+	if (degree_times_position_weights)
+		weights_column=&weights[weight_pos*degree] ;
+	else // weights is a vector (1 x degree)
+		weights_column=weights ;
+
+	int32_t node=compact_roots[tree_pos];
+	float64_t sum=0;
+
+	for (int32_t j=0; node>=0 && j<degree && seq_pos+j<len; j++)
+	{
+		int32_t sym=vec[seq_pos+j];
+		uint8_t mask=compact_mask[node];
+		TRIE_ASSERT((sym<4) && (sym>=0))
+
+		if (!(mask & (1<<sym)))
+			break;
+
+		node=compact_first_child[node]+trie_compact_rank[mask & ((1<<sym)-1)];
+
+		if (weights_in_tree && !(mask & TRIE_COMPACT_SCALE(sym)))
+			sum+=compact_weights[node];
+		else
+			sum+=compact_weights[node]*weights_column[j];
+	}
+
+	if (position_weights!=NULL)
+		return sum*position_weights[weight_pos] ;
+	else
+		return sum ;
+}
+
+template <class Trie>
+void CTrie<Trie>::compute_by_compact_tree_batch(
+	const int32_t* syms, const int32_t* num_syms, int32_t num,
+	int32_t tree_pos, int32_t weight_pos, float64_t* weights,
+	bool degree_times_position_weights, float64_t* result)
+{
+	if ((position_weights!=NULL) && (position_weights[weight_pos]==0))
+	{
+		for (int32_t i=0; i<num; i++)
+			result[i]=0.0;
+		return;
+	}
+
+	float64_t *weights_column=NULL ;
+	if (degree_times_position_weights)
+		weights_column=&weights[weight_pos*degree] ;
+	else // weights is a vector (1 x degree)
+		weights_column=weights ;
+
+	float64_t factor=1.0;
+	if (position_weights!=NULL)
+		factor=position_weights[weight_pos];
+
+	int32_t nodes[TRIE_COMPACT_BATCH];
+
+	for (int32_t start=0; start<num; start+=TRIE_COMPACT_BATCH)
+	{
+		int32_t end=CMath::min(start+TRIE_COMPACT_BATCH, num);
+
+		for (int32_t i=start; i<end; i++)
+		{
+			nodes[i-start]=compact_roots[tree_pos];
+			result[i]=0.0;
+		}
+
+		/* one level for all sequences, such that the loads of the next level
+		 * of a sequence are in flight while the others are processed */
+		bool active=true;
+		for (int32_t j=0; active && j<degree; j++)
+		{
+			active=false;
+			for (int32_t i=start; i<end; i++)
+			{
+				int32_t node=nodes[i-start];
+				if (node<0)
+					continue;
+
+				int32_t sym=syms[i*degree+j];
+				uint8_t mask=compact_mask[node];
+
+				if (j>=num_syms[i] || !(mask & (1<<sym)))
+				{
+					nodes[i-start]=-1;
+					continue;
+				}
+
+				node=compact_first_child[node]+
+					trie_compact_rank[mask & ((1<<sym)-1)];
+				TRIE_PREFETCH(&compact_mask[node]);
+				TRIE_PREFETCH(&compact_first_child[node]);
+
+				if (weights_in_tree && !(mask & TRIE_COMPACT_SCALE(sym)))
+					result[i]+=compact_weights[node];
+				else
+					result[i]+=compact_weights[node]*weights_column[j];
+
+				nodes[i-start]=node;
+				active=true;
+			}
+		}
+
+		for (int32_t i=start; i<end; i++)
+			result[i]*=factor;
+	}
+}
+
 	template <class Trie>
 void CTrie<Trie>::compute_by_tree_helper(
 	int32_t* vec, int32_t len, int32_t seq_pos, int32_t tree_pos,
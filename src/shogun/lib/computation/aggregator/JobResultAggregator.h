@@ -14,6 +14,7 @@
 #include <shogun/base/SGObject.h>
 #include <shogun/lib/computation/jobresult/JobResult.h>
 #include <shogun/base/Parameter.h>
+#include <shogun/lib/Lock.h>
 
 namespace shogun
 {
@@ -21,6 +22,10 @@ namespace shogun
 /** @brief Abstract base class that provides an interface for computing an
  * aggeregation of the job results of independent computation jobs as
  * they are submitted and also for finalizing the aggregation.
+ *
+ * Jobs may be computed concurrently (see CThreadPoolComputationEngine), so
+ * implementations of submit_result have to guard the aggregation with
+ * m_lock.
  */
 class CJobResultAggregator : public CSGObject
 {
@@ -71,6 +76,9 @@ protected:
 	/** the final job result */
 	CJobResult* m_result;
 
+	/** lock that serializes concurrently submitted results */
+	CLock m_lock;
+
 private:
 	/** initialize with default values and register params */
 	void init()
@@ -55,7 +55,9 @@ void CStoreVectorAggregator<T>::submit_result(CJobResult* result)
 		if (!new_result)
 			SG_ERROR("result is not of CVectorResult type!\n");
 		// aggregate it with previous
+		m_lock.lock();
 		m_aggregate+=new_result->get_result();
+		m_lock.unlock();
 
 		SG_GCDEBUG("Leaving\n")
 	}
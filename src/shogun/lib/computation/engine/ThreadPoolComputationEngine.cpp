@@ -0,0 +1,119 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/lib/common.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/base/Parameter.h>
+#include <shogun/lib/computation/job/IndependentJob.h>
+#include <shogun/lib/computation/engine/ThreadPoolComputationEngine.h>
+
+namespace shogun
+{
+
+CThreadPoolComputationEngine::CThreadPoolComputationEngine()
+	: CIndependentComputationEngine()
+{
+	init();
+
+	SG_GCDEBUG("%s created (%p)\n", this->get_name(), this)
+}
+
+CThreadPoolComputationEngine::CThreadPoolComputationEngine(int32_t queue_size)
+	: CIndependentComputationEngine()
+{
+	init();
+	set_queue_size(queue_size);
+
+	SG_GCDEBUG("%s created (%p)\n", this->get_name(), this)
+}
+
+CThreadPoolComputationEngine::~CThreadPoolComputationEngine()
+{
+	if (m_jobs.get_num_elements())
+		SG_WARNING("%d jobs were never computed, call wait_for_all()!\n",
+			m_jobs.get_num_elements());
+
+	for (int32_t i=0; i<m_jobs.get_num_elements(); i++)
+	{
+		CIndependentJob* job=m_jobs[i];
+		SG_UNREF(job);
+	}
+
+	SG_GCDEBUG("%s destroyed (%p)\n", this->get_name(), this)
+}
+
+void CThreadPoolComputationEngine::init()
+{
+	m_queue_size=0;
+
+	SG_ADD(&m_queue_size, "queue_size",
+		"Maximum number of queued jobs", MS_NOT_AVAILABLE);
+}
+
+void CThreadPoolComputationEngine::set_queue_size(int32_t queue_size)
+{
+	REQUIRE(queue_size>=0, "Queue size must not be negative (%d)\n",
+		queue_size);
+
+	m_queue_size=queue_size;
+}
+
+void CThreadPoolComputationEngine::submit_job(CIndependentJob* job)
+{
+	SG_DEBUG("Entering. The job is being queued!\n");
+
+	REQUIRE(job, "Job to be computed is NULL\n");
+	SG_REF(job);
+	m_jobs.append_element(job);
+
+	if (m_queue_size>0 && m_jobs.get_num_elements()>=m_queue_size)
+		compute_queued_jobs();
+
+	SG_DEBUG("Leaving!\n");
+}
+
+void CThreadPoolComputationEngine::wait_for_all()
+{
+	SG_DEBUG("Entering. Computing %d queued jobs!\n", m_jobs.get_num_elements());
+
+	compute_queued_jobs();
+
+	SG_DEBUG("All jobs are computed!\n");
+}
+
+void CThreadPoolComputationEngine::compute_queued_jobs()
+{
+	int32_t num_jobs=m_jobs.get_num_elements();
+	if (!num_jobs)
+		return;
+
+	// jobs are of unknown and possibly very different cost, so they are
+	// handed out one at a time
+	parallel->parallel_for(0, num_jobs, compute_jobs_helper,
+			m_jobs.get_array(), 1);
+
+	for (int32_t i=0; i<num_jobs; i++)
+	{
+		CIndependentJob* job=m_jobs[i];
+		SG_UNREF(job);
+	}
+
+	m_jobs.reset(NULL);
+}
+
+void CThreadPoolComputationEngine::compute_jobs_helper(int32_t start,
+		int32_t end, int32_t thread, void* p)
+{
+	CIndependentJob** jobs=(CIndependentJob**) p;
+
+	for (int32_t i=start; i<end; i++)
+		jobs[i]->compute();
+}
+
+}
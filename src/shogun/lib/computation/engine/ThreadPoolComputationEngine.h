@@ -0,0 +1,109 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#ifndef THREAD_POOL_COMPUTATION_ENGINE_H_
+#define THREAD_POOL_COMPUTATION_ENGINE_H_
+
+#include <shogun/lib/config.h>
+#include <shogun/base/DynArray.h>
+#include <shogun/lib/computation/engine/IndependentComputationEngine.h>
+
+namespace shogun
+{
+
+/** @brief Class that computes multiple independent instances of
+ * computation jobs concurrently on the shared thread pool.
+ *
+ * Submitted jobs are queued and computed in parallel (using as many threads
+ * as set in the engine's Parallel object) once wait_for_all is called or the
+ * queue is full, in which case submit_job blocks until the queued jobs are
+ * computed.
+ *
+ * Jobs may run concurrently, i.e. objects shared between jobs (operators,
+ * linear solvers) must be safe to be used from multiple threads. The job
+ * result aggregators serialize the submission of results.
+ */
+class CThreadPoolComputationEngine : public CIndependentComputationEngine
+{
+public:
+	/** default constructor */
+	CThreadPoolComputationEngine();
+
+	/** constructor
+	 *
+	 * @param queue_size maximum number of queued jobs, jobs are computed
+	 * as soon as this number is reached (0 for no limit)
+	 */
+	CThreadPoolComputationEngine(int32_t queue_size);
+
+	/** destructor, releases jobs that were never computed */
+	virtual ~CThreadPoolComputationEngine();
+
+	/**
+	 * method that adds the job to the queue, blocks until the queued jobs
+	 * are computed if the queue is full
+	 *
+	 * @param job the job to be computed
+	 */
+	virtual void submit_job(CIndependentJob* job);
+
+	/** method that computes all queued jobs in parallel and blocks until
+	 * they are done
+	 */
+	virtual void wait_for_all();
+
+	/** @param queue_size maximum number of queued jobs (0 for no limit) */
+	void set_queue_size(int32_t queue_size);
+
+	/** @return maximum number of queued jobs (0 for no limit) */
+	int32_t get_queue_size() const
+	{
+		return m_queue_size;
+	}
+
+	/** @return number of jobs that are queued but not yet computed */
+	int32_t get_num_queued_jobs() const
+	{
+		return m_jobs.get_num_elements();
+	}
+
+	/** @return object name */
+	virtual const char* get_name() const
+	{
+		return "ThreadPoolComputationEngine";
+	}
+
+private:
+	/** initialize with default values and register params */
+	void init();
+
+	/** compute the queued jobs in parallel and release them */
+	void compute_queued_jobs();
+
+	/** computes a range of queued jobs
+	 *
+	 * @param start first job
+	 * @param end last job (exclusive)
+	 * @param thread thread index
+	 * @param p queued jobs
+	 */
+	static void compute_jobs_helper(int32_t start, int32_t end,
+			int32_t thread, void* p);
+
+protected:
+	/** maximum number of queued jobs (0 for no limit) */
+	int32_t m_queue_size;
+
+	/** jobs that are submitted but not yet computed */
+	DynArray<CIndependentJob*> m_jobs;
+};
+
+}
+
+#endif // THREAD_POOL_COMPUTATION_ENGINE_H_
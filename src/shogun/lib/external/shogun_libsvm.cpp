@@ -267,8 +267,41 @@ public:
 		return NULL;
 	}
 
+	// if the kernel has a row cache, Q[i,start:len) is gathered from the
+	// full kernel row of x[i]. The row cache is indexed by the original
+	// example indices and thus unaffected by shrinking (swap_index)
+	void compute_Q_from_kernel_row(Qfloat* data, float64_t* lab, int32_t i, int32_t start, int32_t len) const
+	{
+		// every solver has its own Q matrix, the row buffer is reused
+		// across calls
+		if (!kernel_row)
+			kernel_row=SG_MALLOC(float64_t, kernel->get_num_vec_rhs());
+
+		float64_t* row=kernel_row;
+		kernel->fill_kernel_row(x[i]->index, row);
+
+		if (lab) // two class
+		{
+			for(int32_t j=start;j<len;j++)
+				data[j] = (Qfloat) lab[i]*lab[j]*row[x[j]->index];
+		}
+		else // one class, eps svr
+		{
+			for(int32_t j=start;j<len;j++)
+				data[j] = (Qfloat) row[x[j]->index];
+		}
+	}
+
 	void compute_Q_parallel(Qfloat* data, float64_t* lab, int32_t i, int32_t start, int32_t len) const
 	{
+		CKernelRowCache* row_cache=kernel->get_row_cache();
+		if (row_cache)
+		{
+			SG_UNREF(row_cache);
+			compute_Q_from_kernel_row(data, lab, i, start, len);
+			return;
+		}
+
 		int32_t num_threads=sg_parallel->get_num_threads();
 		if (num_threads < 2)
 		{
@@ -342,12 +375,14 @@ private:
 	CKernel* kernel;
 	const svm_node **x;
 	float64_t *x_square;
+	mutable float64_t *kernel_row;
 };
 
 LibSVMKernel::LibSVMKernel(int32_t l, svm_node * const * x_, const svm_parameter& param)
 {
 	clone(x,x_,l);
 	x_square = 0;
+	kernel_row = 0;
 	kernel=param.kernel;
 	max_train_time=param.max_train_time;
 }
@@ -356,6 +391,7 @@ LibSVMKernel::~LibSVMKernel()
 {
 	SG_FREE(x);
 	SG_FREE(x_square);
+	SG_FREE(kernel_row);
 }
 
 // Generalized SMO+SVMlight algorithm
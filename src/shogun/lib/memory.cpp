@@ -16,8 +16,16 @@
 #include <shogun/lib/SGSparseVector.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/base/SGObject.h>
+#include <shogun/lib/Lock.h>
 
 #include <string.h>
+#ifndef WIN32
+#include <sys/mman.h>
+#endif
+
+#ifdef HAVE_CXX11_ATOMIC
+#include <atomic>
+#endif
 
 #ifdef USE_JEMALLOC
 #include <jemalloc/jemalloc.h>
@@ -188,8 +196,297 @@ void operator delete[](void *p) throw()
 #endif
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/** memory mapped region views of which are released via sg_free */
+struct MappedRegion
+{
+	/** start of the mapping */
+	char* start;
+	/** length of the mapping in bytes */
+	size_t length;
+	/** initial reference plus one per view */
+	int32_t refcount;
+};
+
+/** regions sorted by start. Tables are never modified once published
+ * (except for the reference counts, which are only accessed under
+ * sg_mapped_regions_lock), registering or unmapping a region publishes a
+ * new table instead */
+struct MappedRegionTable
+{
+	/** number of regions */
+	int32_t num_regions;
+	/** next replaced table that still waits to be freed */
+	MappedRegionTable* next_retired;
+	/** the regions */
+	MappedRegion regions[1];
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/* regions are few and only exist while memory mapped files are in use.
+ * sg_free/sg_realloc look up pointers without locking: the current table
+ * is NULL while no region is registered, which is all they check then.
+ * Otherwise a lookup is counted in sg_mapped_regions_readers while it reads
+ * the table. Replaced tables are retired and freed under the lock once no
+ * lookup is running: a lookup starting later can only see a newer table.
+ * Both the reader count and the table pointer are accessed sequentially
+ * consistent for this to hold. */
+#ifdef HAVE_CXX11_ATOMIC
+static std::atomic<MappedRegionTable*> sg_mapped_regions(NULL);
+static std::atomic<int32_t> sg_mapped_regions_readers(0);
+#else
+static MappedRegionTable* volatile sg_mapped_regions=NULL;
+static volatile int32_t sg_mapped_regions_readers=0;
+#endif
+/* replaced tables, only accessed under sg_mapped_regions_lock */
+static MappedRegionTable* sg_retired_mapped_regions=NULL;
+/* whether there are retired tables, read by lookups without locking */
+#ifdef HAVE_CXX11_ATOMIC
+static std::atomic<bool> sg_mapped_regions_retired(false);
+#else
+static volatile bool sg_mapped_regions_retired=false;
+#endif
+static CLock sg_mapped_regions_lock;
+
+static inline MappedRegionTable* get_mapped_regions()
+{
+#ifdef HAVE_CXX11_ATOMIC
+	return sg_mapped_regions.load(std::memory_order_acquire);
+#else
+	MappedRegionTable* table=sg_mapped_regions;
+	__sync_synchronize();
+	return table;
+#endif
+}
+
+/* has to be called with sg_mapped_regions_lock held, the first num regions
+ * of the new table are copied from the current one */
+static MappedRegionTable* new_mapped_regions(int32_t num_regions)
+{
+	/* plain malloc, SG_MALLOC would recurse into the lookup */
+	MappedRegionTable* table=(MappedRegionTable*) malloc(
+			sizeof(MappedRegionTable)+sizeof(MappedRegion)*num_regions);
+	if (!table)
+		throw ShogunException("Out of memory error using malloc.\n");
+
+	table->num_regions=num_regions;
+	table->next_retired=NULL;
+	return table;
+}
+
+/* has to be called with sg_mapped_regions_lock held, frees the retired
+ * tables if no lookup is running */
+static void free_retired_mapped_regions()
+{
+#ifdef HAVE_CXX11_ATOMIC
+	if (sg_mapped_regions_readers.load()!=0)
+		return;
+#else
+	__sync_synchronize();
+	if (sg_mapped_regions_readers!=0)
+		return;
+#endif
+
+	while (sg_retired_mapped_regions)
+	{
+		MappedRegionTable* table=sg_retired_mapped_regions;
+		sg_retired_mapped_regions=table->next_retired;
+		free(table);
+	}
+	sg_mapped_regions_retired=false;
+}
+
+/* has to be called with sg_mapped_regions_lock held, table may be NULL if
+ * there are no regions left. The replaced table is retired */
+static void publish_mapped_regions(MappedRegionTable* table)
+{
+#ifdef HAVE_CXX11_ATOMIC
+	MappedRegionTable* old=sg_mapped_regions.exchange(table);
+#else
+	MappedRegionTable* old=sg_mapped_regions;
+	__sync_synchronize();
+	sg_mapped_regions=table;
+	__sync_synchronize();
+#endif
+
+	if (old)
+	{
+		old->next_retired=sg_retired_mapped_regions;
+		sg_retired_mapped_regions=old;
+		sg_mapped_regions_retired=true;
+	}
+	free_retired_mapped_regions();
+}
+
+/* start a lookup without locking, the returned table (NULL if there are no
+ * regions) stays valid until end_mapped_regions_lookup() */
+static inline MappedRegionTable* begin_mapped_regions_lookup()
+{
+	if (!get_mapped_regions())
+		return NULL;
+
+#ifdef HAVE_CXX11_ATOMIC
+	sg_mapped_regions_readers.fetch_add(1);
+	MappedRegionTable* table=sg_mapped_regions.load();
+	if (!table)
+		sg_mapped_regions_readers.fetch_sub(1);
+#else
+	__sync_fetch_and_add(&sg_mapped_regions_readers, 1);
+	MappedRegionTable* table=sg_mapped_regions;
+	__sync_synchronize();
+	if (!table)
+		__sync_fetch_and_sub(&sg_mapped_regions_readers, 1);
+#endif
+	return table;
+}
+
+/* end a lookup started by begin_mapped_regions_lookup(). The last running
+ * lookup frees the tables retired meanwhile */
+static inline void end_mapped_regions_lookup(MappedRegionTable* table)
+{
+	if (!table)
+		return;
+
+#ifdef HAVE_CXX11_ATOMIC
+	if (sg_mapped_regions_readers.fetch_sub(1)!=1)
+		return;
+#else
+	if (__sync_sub_and_fetch(&sg_mapped_regions_readers, 1)!=0)
+		return;
+#endif
+
+	if (sg_mapped_regions_retired)
+	{
+		sg_mapped_regions_lock.lock();
+		free_retired_mapped_regions();
+		sg_mapped_regions_lock.unlock();
+	}
+}
+
+/* index of the region containing ptr, -1 if there is none */
+static int32_t find_mapped_region(const MappedRegionTable* table,
+		const void* ptr)
+{
+	if (!table || !ptr)
+		return -1;
+
+	/* last region starting at or before ptr */
+	int32_t lo=0;
+	int32_t hi=table->num_regions;
+	while (lo<hi)
+	{
+		int32_t mid=(lo+hi)/2;
+		if (table->regions[mid].start<=(const char*) ptr)
+			lo=mid+1;
+		else
+			hi=mid;
+	}
+
+	if (lo==0)
+		return -1;
+
+	const MappedRegion* r=&table->regions[lo-1];
+	return (const char*) ptr<r->start+r->length ? lo-1 : -1;
+}
+
+/* number of bytes from ptr to the end of its mapped region, 0 if ptr is not
+ * a view */
+static size_t mapped_region_bytes(const void* ptr)
+{
+	MappedRegionTable* table=begin_mapped_regions_lookup();
+	int32_t idx=find_mapped_region(table, ptr);
+	size_t bytes=0;
+	if (idx>=0)
+	{
+		const MappedRegion* r=&table->regions[idx];
+		bytes=r->start+r->length-(const char*) ptr;
+	}
+	end_mapped_regions_lookup(table);
+
+	return bytes;
+}
+
 namespace shogun
 {
+void sg_register_mapped_region(void* start, size_t length)
+{
+	sg_mapped_regions_lock.lock();
+	MappedRegionTable* old=get_mapped_regions();
+	int32_t num=old ? old->num_regions : 0;
+	MappedRegionTable* table=new_mapped_regions(num+1);
+
+	/* insert keeping the regions sorted */
+	int32_t i=0;
+	for (; i<num && old->regions[i].start<(char*) start; i++)
+		table->regions[i]=old->regions[i];
+
+	MappedRegion* r=&table->regions[i];
+	r->start=(char*) start;
+	r->length=length;
+	r->refcount=1;
+
+	for (; i<num; i++)
+		table->regions[i+1]=old->regions[i];
+
+	publish_mapped_regions(table);
+	sg_mapped_regions_lock.unlock();
+}
+
+void sg_ref_mapped_region(void* ptr)
+{
+	sg_mapped_regions_lock.lock();
+	MappedRegionTable* table=get_mapped_regions();
+	int32_t idx=find_mapped_region(table, ptr);
+	if (idx>=0)
+		table->regions[idx].refcount++;
+	sg_mapped_regions_lock.unlock();
+}
+
+bool sg_unref_mapped_region(void* ptr)
+{
+	/* other memory is told apart without locking */
+	MappedRegionTable* table=begin_mapped_regions_lookup();
+	bool mapped=find_mapped_region(table, ptr)>=0;
+	end_mapped_regions_lookup(table);
+	if (!mapped)
+		return false;
+
+	sg_mapped_regions_lock.lock();
+	table=get_mapped_regions();
+	int32_t idx=find_mapped_region(table, ptr);
+	if (idx<0)
+	{
+		sg_mapped_regions_lock.unlock();
+		return false;
+	}
+
+	MappedRegion* r=&table->regions[idx];
+	if (--r->refcount==0)
+	{
+		char* start=r->start;
+		size_t length=r->length;
+
+		MappedRegionTable* next=NULL;
+		if (table->num_regions>1)
+		{
+			next=new_mapped_regions(table->num_regions-1);
+			for (int32_t i=0, j=0; i<table->num_regions; i++)
+			{
+				if (i!=idx)
+					next->regions[j++]=table->regions[i];
+			}
+		}
+		/* may free table */
+		publish_mapped_regions(next);
+#ifndef WIN32
+		munmap(start, length);
+#endif
+	}
+	sg_mapped_regions_lock.unlock();
+
+	return true;
+}
+
 void* sg_malloc(size_t size
 #ifdef TRACE_MEMORY_ALLOCS
 		, const char* file, int line
@@ -261,6 +558,9 @@ void* sg_calloc(size_t num, size_t size
 
 void  sg_free(void* ptr)
 {
+	if (sg_unref_mapped_region(ptr))
+		return;
+
 #ifdef TRACE_MEMORY_ALLOCS
 	if (sg_mallocs)
 		sg_mallocs->remove(ptr);
@@ -281,6 +581,20 @@ void* sg_realloc(void* ptr, size_t size
 #endif
 )
 {
+	size_t mapped_bytes=mapped_region_bytes(ptr);
+	if (mapped_bytes)
+	{
+		/* views of mapped regions cannot be resized in place */
+#ifdef TRACE_MEMORY_ALLOCS
+		void* p=sg_malloc(size, file, line);
+#else
+		void* p=sg_malloc(size);
+#endif
+		memcpy(p, ptr, size<mapped_bytes ? size : mapped_bytes);
+		sg_unref_mapped_region(ptr);
+		return p;
+	}
+
 #if defined(USE_JEMALLOC)
 	void* p=je_realloc(ptr, size);
 #elif defined(USE_TCMALLOC)
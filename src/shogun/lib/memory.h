@@ -203,6 +203,31 @@ SG_SPECIALIZED_MALLOC(SGMatrix<complex128_t>)
 
 void* get_copy(void* src, size_t len);
 char* get_strdup(const char* str);
+
+/** register a memory mapped region, such that pointers into it (views) can
+ * be handed out like memory obtained from SG_MALLOC: SG_FREE on a view only
+ * releases a reference to the region and SG_REALLOC copies the view to
+ * newly allocated memory. The region is unmapped once the initial reference
+ * and the references of all views were released.
+ *
+ * @param start start of the region as returned by mmap
+ * @param length length of the region in bytes
+ */
+void sg_register_mapped_region(void* start, size_t length);
+
+/** add a reference to the mapped region containing ptr, to be called for
+ * every view handed out
+ *
+ * @param ptr pointer into a registered region
+ */
+void sg_ref_mapped_region(void* ptr);
+
+/** release a reference to the mapped region containing ptr
+ *
+ * @param ptr pointer into a registered region
+ * @return whether ptr belonged to a registered region
+ */
+bool sg_unref_mapped_region(void* ptr);
 }
 
 #endif // DOXYGEN_SHOULD_SKIP_THIS
@@ -86,6 +86,18 @@ CDenseFeatures<float64_t>* shogun::tapkee_embed(const shogun::TAPKEE_PARAMETERS_
 	tapkee::EigenMethod eigen_method = tapkee::Dense;
 #endif
 	tapkee::NeighborsMethod neighbors_method = tapkee::CoverTree;
+	switch (parameters.neighbors_method)
+	{
+		case NEIGHBORS_BRUTE_FORCE:
+			neighbors_method = tapkee::Brute;
+			break;
+		case NEIGHBORS_VP_TREE:
+			neighbors_method = tapkee::VpTree;
+			break;
+		case NEIGHBORS_COVER_TREE:
+			neighbors_method = tapkee::CoverTree;
+			break;
+	}
 	size_t N = 0;
 
 	switch (parameters.method)
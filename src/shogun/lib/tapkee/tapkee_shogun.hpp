@@ -16,6 +16,7 @@
 #include <shogun/kernel/Kernel.h>
 #include <shogun/distance/Distance.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/converter/EmbeddingConverter.h>
 
 using namespace shogun;
 
@@ -54,6 +55,7 @@ struct TAPKEE_PARAMETERS_FOR_SHOGUN
 		spe_global_strategy(false), max_iteration(100),
 		fa_epsilon(1e-5), sne_theta(0.5),
 		sne_perplexity(30.0), squishing_rate(0.99),
+		neighbors_method(NEIGHBORS_COVER_TREE),
 		kernel(NULL), distance(NULL), features(NULL)
 	{
 	}
@@ -72,6 +74,7 @@ struct TAPKEE_PARAMETERS_FOR_SHOGUN
 	float64_t sne_theta;
 	float64_t sne_perplexity;
 	float64_t squishing_rate;
+	EEmbeddingNeighborsMethod neighbors_method;
 	CKernel* kernel;
 	CDistance* distance;
 	CDotFeatures* features;
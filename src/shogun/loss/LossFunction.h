@@ -96,7 +96,7 @@ public:
 	 */
 	virtual float64_t first_derivative(float64_t prediction, float64_t label)
 	{
-		return loss(prediction * label);
+		return label*first_derivative(prediction * label);
 	}
 
 	/**
@@ -118,7 +118,7 @@ public:
 	 */
 	virtual float64_t second_derivative(float64_t prediction, float64_t label)
 	{
-		return loss(prediction * label);
+		return label*label*second_derivative(prediction * label);
 	}
 
 	/**
@@ -15,6 +15,7 @@
 #include <shogun/mathematics/Math.h>
 #include <shogun/kernel/Kernel.h>
 #include <shogun/machine/gp/FITCInferenceMethod.h>
+#include <shogun/machine/gp/MatrixFreeInferenceMethod.h>
 
 #include <shogun/mathematics/eigen3.h>
 
@@ -49,6 +50,37 @@ SGVector<float64_t> CGaussianProcessMachine::get_posterior_means(CFeatures* data
 {
 	REQUIRE(m_method, "Inference method should not be NULL\n")
 
+	// compute the cross kernel matrix row by row for the matrix free
+	// inference method
+	if (m_method->get_inference_type()==INF_MATRIX_FREE)
+	{
+		// get alpha first, as the update re-initializes the kernel
+		SGVector<float64_t> alpha=m_method->get_alpha();
+		float64_t scale=CMath::sq(m_method->get_scale());
+
+		CFeatures* feat=m_method->get_features();
+		CKernel* kernel=m_method->get_kernel();
+		kernel->init(data, feat);
+
+		CMeanFunction* mean_function=m_method->get_mean();
+		SGVector<float64_t> mu=mean_function->get_mean_vector(data);
+		SG_UNREF(mean_function);
+
+		// compute mean: mu=Ks'*alpha+m
+		SGVector<float64_t> row(alpha.vlen);
+		for (index_t i=0; i<mu.vlen; i++)
+		{
+			kernel->fill_kernel_row(i, row.vector);
+			mu[i]+=scale*SGVector<float64_t>::dot(row.vector, alpha.vector,
+					alpha.vlen);
+		}
+
+		SG_UNREF(kernel);
+		SG_UNREF(feat);
+
+		return mu;
+	}
+
 	CFeatures* feat;
 
 	// use latent features for FITC inference method
@@ -100,6 +132,46 @@ SGVector<float64_t> CGaussianProcessMachine::get_posterior_variances(
 {
 	REQUIRE(m_method, "Inference method should not be NULL\n")
 
+#ifdef HAVE_LAPACK
+	// solve one linear system per vector for the matrix free inference
+	// method: s2=kss-ks'*(K+sigma^2*I)^-1*ks
+	if (m_method->get_inference_type()==INF_MATRIX_FREE)
+	{
+		CMatrixFreeInferenceMethod* method=
+			CMatrixFreeInferenceMethod::obtain_from_generic(m_method);
+		float64_t scale=CMath::sq(m_method->get_scale());
+
+		SG_REF(data);
+		CFeatures* feat=m_method->get_features();
+		CKernel* kernel=m_method->get_kernel();
+
+		SGVector<float64_t> s2(data->get_num_vectors());
+		SGVector<float64_t> ks(feat->get_num_vectors());
+
+		kernel->init(data, data);
+		for (index_t i=0; i<s2.vlen; i++)
+			s2[i]=scale*kernel->kernel(i, i);
+
+		for (index_t i=0; i<s2.vlen; i++)
+		{
+			// solve re-initializes the kernel with the training features
+			kernel->init(data, feat);
+			kernel->fill_kernel_row(i, ks.vector);
+			ks.scale(scale);
+
+			SGVector<float64_t> v=method->solve(ks);
+			s2[i]-=SGVector<float64_t>::dot(ks.vector, v.vector, ks.vlen);
+		}
+
+		SG_UNREF(kernel);
+		SG_UNREF(feat);
+		SG_UNREF(data);
+		SG_UNREF(method);
+
+		return s2;
+	}
+#endif /* HAVE_LAPACK */
+
 	CFeatures* feat;
 
 	// use latent features for FITC inference method
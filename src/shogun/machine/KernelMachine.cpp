@@ -345,44 +345,19 @@ SGVector<float64_t> CKernelMachine::apply_get_outputs(CFeatures* data)
 				params.indices_len = 0;
 				apply_helper((void*) &params);
 			}
-#ifdef HAVE_PTHREAD
 			else
 			{
-				pthread_t* threads = SG_MALLOC(pthread_t, num_threads-1);
-				S_THREAD_PARAM_KERNEL_MACHINE* params = SG_MALLOC(S_THREAD_PARAM_KERNEL_MACHINE, num_threads);
-				int32_t step= num_vectors/num_threads;
-
-				int32_t t;
-
-				for (t=0; t<num_threads-1; t++)
-				{
-					params[t].kernel_machine = this;
-					params[t].result = output.vector;
-					params[t].start = t*step;
-					params[t].end = (t+1)*step;
-					params[t].verbose = false;
-					params[t].indices = NULL;
-					params[t].indices_len = 0;
-					pthread_create(&threads[t], NULL,
-							CKernelMachine::apply_helper, (void*)&params[t]);
-				}
-
-				params[t].kernel_machine = this;
-				params[t].result = output.vector;
-				params[t].start = t*step;
-				params[t].end = num_vectors;
-				params[t].verbose = true;
-				params[t].indices = NULL;
-				params[t].indices_len = 0;
-				apply_helper((void*) &params[t]);
-
-				for (t=0; t<num_threads-1; t++)
-					pthread_join(threads[t], NULL);
-
-				SG_FREE(params);
-				SG_FREE(threads);
+				S_THREAD_PARAM_KERNEL_MACHINE params;
+				params.kernel_machine=this;
+				params.result=output.vector;
+				params.start=0;
+				params.end=num_vectors;
+				params.verbose=false;
+				params.indices=NULL;
+				params.indices_len=0;
+				parallel->parallel_for(0, num_vectors,
+						CKernelMachine::apply_range_helper, (void*) &params);
 			}
-#endif
 		}
 
 #ifndef WIN32
@@ -447,6 +422,15 @@ void* CKernelMachine::apply_helper(void* p)
 	return NULL;
 }
 
+void CKernelMachine::apply_range_helper(int32_t start, int32_t end,
+		int32_t thread, void* p)
+{
+	S_THREAD_PARAM_KERNEL_MACHINE params=*((S_THREAD_PARAM_KERNEL_MACHINE*) p);
+	params.start=start;
+	params.end=end;
+	apply_helper((void*) &params);
+}
+
 void CKernelMachine::store_model_features()
 {
 	if (!kernel)
@@ -563,49 +547,22 @@ SGVector<float64_t> CKernelMachine::apply_locked_get_output(
 		params.verbose=true;
 		apply_helper((void*) &params);
 	}
-#ifdef HAVE_PTHREAD
 	else
 	{
-		pthread_t* threads = SG_MALLOC(pthread_t, num_threads-1);
-		S_THREAD_PARAM_KERNEL_MACHINE* params=SG_MALLOC(S_THREAD_PARAM_KERNEL_MACHINE, num_threads);
-		int32_t step= num_inds/num_threads;
-
-		int32_t t;
-		for (t=0; t<num_threads-1; t++)
-		{
-			params[t].kernel_machine=this;
-			params[t].result=output.vector;
-
-			/* use the parameter index vector */
-			params[t].start=t*step;
-			params[t].end=(t+1)*step;
-			params[t].indices=indices.vector;
-			params[t].indices_len=indices.vlen;
-
-			params[t].verbose=false;
-			pthread_create(&threads[t], NULL, CKernelMachine::apply_helper,
-					(void*)&params[t]);
-		}
-
-		params[t].kernel_machine=this;
-		params[t].result=output.vector;
+		S_THREAD_PARAM_KERNEL_MACHINE params;
+		params.kernel_machine=this;
+		params.result=output.vector;
 
 		/* use the parameter index vector */
-		params[t].start=t*step;
-		params[t].end=num_inds;
-		params[t].indices=indices.vector;
-		params[t].indices_len=indices.vlen;
-
-		params[t].verbose=true;
-		apply_helper((void*) &params[t]);
-
-		for (t=0; t<num_threads-1; t++)
-			pthread_join(threads[t], NULL);
+		params.start=0;
+		params.end=num_inds;
+		params.indices=indices.vector;
+		params.indices_len=indices.vlen;
 
-		SG_FREE(params);
-		SG_FREE(threads);
+		params.verbose=false;
+		parallel->parallel_for(0, num_inds, CKernelMachine::apply_range_helper,
+				(void*) &params);
 	}
-#endif
 
 #ifndef WIN32
 	if ( CSignal::cancel_computations() )
@@ -234,6 +234,17 @@ class CKernelMachine : public CMachine
 		 */
 		static void* apply_helper(void* p);
 
+		/** apply example helper on the sub range [start, end), used by
+		 * Parallel::parallel_for
+		 *
+		 * @param start first example
+		 * @param end one past the last example
+		 * @param thread index of the executing thread
+		 * @param p params shared by all threads
+		 */
+		static void apply_range_helper(int32_t start, int32_t end,
+				int32_t thread, void* p);
+
 		/** Trains a locked machine on a set of indices. Error if machine is
 		 * not locked
 		 *
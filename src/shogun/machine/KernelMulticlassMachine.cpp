@@ -11,6 +11,7 @@
 
 #include <shogun/lib/Set.h>
 #include <shogun/machine/KernelMulticlassMachine.h>
+#include <shogun/kernel/CustomKernel.h>
 
 using namespace shogun;
 
@@ -80,9 +81,13 @@ void CKernelMulticlassMachine::store_model_features()
 	SG_UNREF(rhs);
 }
 
-CKernelMulticlassMachine::CKernelMulticlassMachine() : CMulticlassMachine(), m_kernel(NULL)
+CKernelMulticlassMachine::CKernelMulticlassMachine() : CMulticlassMachine(), m_kernel(NULL),
+	m_train_kernel(NULL), m_concurrent_single_precision(false)
 {
 	SG_ADD((CSGObject**)&m_kernel,"kernel", "The kernel to be used", MS_AVAILABLE);
+	SG_ADD(&m_concurrent_single_precision, "concurrent_single_precision",
+			"Whether concurrent training may use a single precision kernel "
+			"matrix", MS_NOT_AVAILABLE);
 }
 
 /** standard constructor
@@ -92,16 +97,21 @@ CKernelMulticlassMachine::CKernelMulticlassMachine() : CMulticlassMachine(), m_k
  * @param labs labels
  */
 CKernelMulticlassMachine::CKernelMulticlassMachine(CMulticlassStrategy *strategy, CKernel* kernel, CKernelMachine* machine, CLabels* labs) :
-	CMulticlassMachine(strategy,(CMachine*)machine,labs), m_kernel(NULL)
+	CMulticlassMachine(strategy,(CMachine*)machine,labs), m_kernel(NULL),
+	m_train_kernel(NULL), m_concurrent_single_precision(false)
 {
 	set_kernel(kernel);
 	SG_ADD((CSGObject**)&m_kernel,"kernel", "The kernel to be used", MS_AVAILABLE);
+	SG_ADD(&m_concurrent_single_precision, "concurrent_single_precision",
+			"Whether concurrent training may use a single precision kernel "
+			"matrix", MS_NOT_AVAILABLE);
 }
 
 /** destructor */
 CKernelMulticlassMachine::~CKernelMulticlassMachine()
 {
 	SG_UNREF(m_kernel);
+	SG_UNREF(m_train_kernel);
 }
 
 /** set kernel
@@ -182,4 +192,82 @@ void CKernelMulticlassMachine::remove_machine_subset()
 	SG_NOTIMPLEMENTED
 }
 
+bool CKernelMulticlassMachine::init_machines_for_concurrent_train()
+{
+	REQUIRE(m_kernel && m_kernel->get_num_vec_lhs(), "%s: kernel has to be "
+			"initialized for training\n", get_name())
+
+	SG_UNREF(m_train_kernel);
+	m_train_kernel=NULL;
+
+	/* a custom kernel shares its matrix, others (and custom kernels with
+	 * subsets, which restrict the training data) are computed in parallel,
+	 * which rounds them to single precision */
+	if (m_kernel->get_kernel_type()==K_CUSTOM &&
+			!((CCustomKernel*) m_kernel)->has_subsets())
+	{
+		m_train_kernel=new CCustomKernel(m_kernel);
+	}
+	else if (m_concurrent_single_precision)
+		m_train_kernel=new CCustomKernel(m_kernel->get_kernel_matrix());
+	else
+	{
+		SG_INFO("%s: concurrent training requires a custom kernel or "
+				"set_concurrent_single_precision(true)\n", get_name())
+		return false;
+	}
+
+	SG_REF(m_train_kernel);
+
+	return true;
+}
+
+CMachine* CKernelMulticlassMachine::get_machine_for_concurrent_train(
+		SGVector<index_t> subset)
+{
+	/* clone only the parameters of the base machine, not its kernel */
+	CKernelMachine* base=(CKernelMachine*) m_machine;
+	CLabels* labels=base->get_labels();
+	base->set_kernel(NULL);
+	base->set_labels(NULL);
+	CKernelMachine* machine=(CKernelMachine*) base->clone();
+	base->set_kernel(m_kernel);
+	base->set_labels(labels);
+	SG_UNREF(labels);
+
+	if (!machine)
+		return NULL;
+
+	/* read-only view on the shared matrix, restricted to the subset */
+	CCustomKernel* kernel=new CCustomKernel(m_train_kernel);
+	if (subset.vlen)
+	{
+		kernel->add_row_subset(subset);
+		kernel->add_col_subset(subset);
+	}
+	machine->set_kernel(kernel);
+
+	return machine;
+}
 
+CMachine* CKernelMulticlassMachine::get_machine_from_concurrent_trained(
+		CMachine* machine, SGVector<index_t> subset)
+{
+	CKernelMachine* trained=(CKernelMachine*) machine;
+
+	if (subset.vlen)
+	{
+		for (int32_t i=0; i<trained->get_num_support_vectors(); i++)
+			trained->set_support_vector(i, subset[trained->get_support_vector(i)]);
+	}
+
+	CKernelMachine* result=(CKernelMachine*) get_machine_from_trained(trained);
+	result->set_kernel(m_kernel);
+	return result;
+}
+
+void CKernelMulticlassMachine::cleanup_machines_for_concurrent_train()
+{
+	SG_UNREF(m_train_kernel);
+	m_train_kernel=NULL;
+}
@@ -23,6 +23,7 @@ namespace shogun
 
 class CKernel;
 class CKernelMachine;
+class CCustomKernel;
 
 /** @brief generic kernel multiclass */
 class CKernelMulticlassMachine : public CMulticlassMachine
@@ -60,6 +61,32 @@ class CKernelMulticlassMachine : public CMulticlassMachine
 		 */
 		CKernel* get_kernel();
 
+		/** set whether concurrent training (see
+		 * CMulticlassMachine::set_concurrent_training()) may precompute
+		 * the kernel matrix in single precision
+		 *
+		 * The copies of the base machine share one precomputed kernel
+		 * matrix over all training vectors. For a custom kernel (without
+		 * subsets) this is its own matrix. Otherwise the full matrix is
+		 * computed and stored as a CCustomKernel, i.e. in single precision
+		 * and using 4*n*n bytes for n training vectors, so outputs differ
+		 * slightly from sequential training. Without this option, such
+		 * kernels are trained sequentially.
+		 *
+		 * @param single_precision whether to allow it (default false)
+		 */
+		inline void set_concurrent_single_precision(bool single_precision)
+		{
+			m_concurrent_single_precision=single_precision;
+		}
+
+		/** @return whether concurrent training may precompute the kernel
+		 * matrix in single precision */
+		inline bool get_concurrent_single_precision() const
+		{
+			return m_concurrent_single_precision;
+		}
+
 		/** Stores feature data of underlying model.
 		 *
 		 * Need to store the SVs for all sub-machines. We make a union of the
@@ -94,11 +121,50 @@ class CKernelMulticlassMachine : public CMulticlassMachine
 		/** deletes any subset set to the features of the machine */
 		virtual void remove_machine_subset();
 
+		/** precompute the kernel matrix over the full training data once,
+		 * all copies of the base machine read it concurrently, see
+		 * set_concurrent_single_precision()
+		 *
+		 * @return whether the kernel matrix is available
+		 */
+		virtual bool init_machines_for_concurrent_train();
+
+		/** clone the base machine without kernel, it is trained on a
+		 * custom kernel sharing the precomputed matrix, restricted to the
+		 * subset
+		 *
+		 * @param subset indices of the training vectors, empty for all
+		 * @return machine (SG_REF'ed) or NULL if cloning failed
+		 */
+		virtual CMachine* get_machine_for_concurrent_train(
+				SGVector<index_t> subset);
+
+		/** obtain submachine from a concurrently trained copy, support
+		 * vectors are mapped from the subset to the training data
+		 *
+		 * @param machine trained copy
+		 * @param subset indices of the training vectors, empty for all
+		 * @return submachine using the kernel of this machine
+		 */
+		virtual CMachine* get_machine_from_concurrent_trained(
+				CMachine* machine, SGVector<index_t> subset);
+
+		/** release the precomputed kernel matrix */
+		virtual void cleanup_machines_for_concurrent_train();
+
 	protected:
 
 		/** kernel */
 		CKernel* m_kernel;
 
+	private:
+		/** precomputed kernel shared by concurrently trained machines */
+		CCustomKernel* m_train_kernel;
+
+		/** whether concurrent training may precompute the kernel matrix in
+		 * single precision */
+		bool m_concurrent_single_precision;
+
 };
 }
 #endif
@@ -0,0 +1,288 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/machine/LinearMulticlassMachine.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SparseFeatures.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/mathematics/lapack.h>
+
+using namespace shogun;
+
+/** number of dense vectors scored by one matrix product */
+#define LINEAR_MULTICLASS_BLOCK_SIZE 64
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+struct LINEAR_MULTICLASS_THREAD_PARAM
+{
+	/** features */
+	CDotFeatures* features;
+	/** number of machines */
+	int32_t num_machines;
+	/** dimension */
+	int32_t dim;
+	/** weights, column k holds the k-th weight of every machine */
+	const float64_t* W;
+	/** weight vector of each machine */
+	const float64_t** w;
+	/** bias of each machine */
+	const float64_t* bias;
+	/** outputs, one column per vector, NULL if they are not stored */
+	float64_t* outputs;
+	/** index of the largest output per vector, NULL if not requested */
+	float64_t* arg_max;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/** @return where to write the outputs of the vectors starting at index i,
+ * buffer if the outputs are not stored */
+static inline float64_t* get_outputs(LINEAR_MULTICLASS_THREAD_PARAM* params,
+		int32_t i, float64_t* buffer)
+{
+	if (params->outputs)
+		return &params->outputs[int64_t(i)*params->num_machines];
+
+	return buffer;
+}
+
+/** decide on the vectors [start, start+num) with outputs out */
+static inline void store_arg_max(LINEAR_MULTICLASS_THREAD_PARAM* params,
+		int32_t start, int32_t num, float64_t* out)
+{
+	if (!params->arg_max)
+		return;
+
+	int32_t num_machines=params->num_machines;
+	for (int32_t i=0; i<num; i++)
+	{
+		params->arg_max[start+i]=SGVector<float64_t>::arg_max(
+				&out[int64_t(i)*num_machines], 1, num_machines);
+	}
+}
+
+static void dense_outputs_helper(int32_t start, int32_t end, int32_t thread,
+		void* p)
+{
+	LINEAR_MULTICLASS_THREAD_PARAM* params=(LINEAR_MULTICLASS_THREAD_PARAM*) p;
+	CDenseFeatures<float64_t>* features=
+		(CDenseFeatures<float64_t>*) params->features;
+	int32_t num_machines=params->num_machines;
+	int32_t dim=params->dim;
+	float64_t* X=SG_MALLOC(float64_t, int64_t(dim)*LINEAR_MULTICLASS_BLOCK_SIZE);
+	float64_t* buffer=NULL;
+	if (!params->outputs)
+		buffer=SG_MALLOC(float64_t, num_machines*LINEAR_MULTICLASS_BLOCK_SIZE);
+
+	for (int32_t b=start; b<end; b+=LINEAR_MULTICLASS_BLOCK_SIZE)
+	{
+		int32_t num=CMath::min(LINEAR_MULTICLASS_BLOCK_SIZE, end-b);
+		float64_t* out=get_outputs(params, b, buffer);
+
+		for (int32_t i=0; i<num; i++)
+		{
+			int32_t len;
+			bool dofree;
+			float64_t* vec=features->get_feature_vector(b+i, len, dofree);
+			ASSERT(len==dim)
+			memcpy(&X[int64_t(i)*dim], vec, sizeof(float64_t)*dim);
+			features->free_feature_vector(vec, b+i, dofree);
+
+			memcpy(&out[int64_t(i)*num_machines], params->bias,
+					sizeof(float64_t)*num_machines);
+		}
+
+		/* out+=W*X */
+		cblas_dgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, num_machines,
+				num, dim, 1.0, params->W, num_machines, X, dim, 1.0, out,
+				num_machines);
+
+		store_arg_max(params, b, num, out);
+	}
+
+	SG_FREE(buffer);
+	SG_FREE(X);
+}
+
+static void sparse_outputs_helper(int32_t start, int32_t end, int32_t thread,
+		void* p)
+{
+	LINEAR_MULTICLASS_THREAD_PARAM* params=(LINEAR_MULTICLASS_THREAD_PARAM*) p;
+	CSparseFeatures<float64_t>* features=
+		(CSparseFeatures<float64_t>*) params->features;
+	int32_t num_machines=params->num_machines;
+	float64_t* buffer=NULL;
+	if (!params->outputs)
+		buffer=SG_MALLOC(float64_t, num_machines);
+
+	for (int32_t i=start; i<end; i++)
+	{
+		float64_t* out=get_outputs(params, i, buffer);
+		memcpy(out, params->bias, sizeof(float64_t)*num_machines);
+
+		SGSparseVector<float64_t> vec=features->get_sparse_feature_vector(i);
+		for (int32_t k=0; k<vec.num_feat_entries; k++)
+		{
+			float64_t value=vec.features[k].entry;
+			const float64_t* W=&params->W[int64_t(vec.features[k].feat_index)*
+				num_machines];
+
+			for (int32_t j=0; j<num_machines; j++)
+				out[j]+=value*W[j];
+		}
+		features->free_sparse_feature_vector(i);
+
+		store_arg_max(params, i, 1, out);
+	}
+
+	SG_FREE(buffer);
+}
+
+static void dot_outputs_helper(int32_t start, int32_t end, int32_t thread,
+		void* p)
+{
+	LINEAR_MULTICLASS_THREAD_PARAM* params=(LINEAR_MULTICLASS_THREAD_PARAM*) p;
+	int32_t num_machines=params->num_machines;
+	float64_t* buffer=NULL;
+	if (!params->outputs)
+		buffer=SG_MALLOC(float64_t, num_machines);
+
+	for (int32_t i=start; i<end; i++)
+	{
+		float64_t* out=get_outputs(params, i, buffer);
+		for (int32_t j=0; j<num_machines; j++)
+		{
+			out[j]=params->features->dense_dot(i, params->w[j], params->dim)+
+				params->bias[j];
+		}
+
+		store_arg_max(params, i, 1, out);
+	}
+
+	SG_FREE(buffer);
+}
+
+SGMatrix<float64_t> CLinearMulticlassMachine::get_all_submachine_outputs(
+		int32_t num_vectors)
+{
+	int32_t num_machines=m_machines->get_num_elements();
+	SGMatrix<float64_t> outputs(num_machines, num_vectors);
+	if (!compute_all_submachine_outputs(num_vectors, outputs.matrix, NULL))
+		return SGMatrix<float64_t>();
+
+	return outputs;
+}
+
+SGVector<float64_t> CLinearMulticlassMachine::get_all_submachine_arg_max(
+		int32_t num_vectors)
+{
+	SGVector<float64_t> arg_max(num_vectors);
+	if (!compute_all_submachine_outputs(num_vectors, NULL, arg_max.vector))
+		return SGVector<float64_t>();
+
+	return arg_max;
+}
+
+bool CLinearMulticlassMachine::compute_all_submachine_outputs(
+		int32_t num_vectors, float64_t* outputs, float64_t* arg_max)
+{
+	int32_t num_machines=m_machines->get_num_elements();
+	if (!m_features || num_machines<=0)
+		return false;
+
+	ASSERT(num_vectors==m_features->get_num_vectors())
+	int32_t dim=m_features->get_dim_feature_space();
+
+	SGMatrix<float64_t> W(num_machines, dim);
+	SGVector<float64_t> bias(num_machines);
+	const float64_t** w=SG_MALLOC(const float64_t*, num_machines);
+	for (int32_t j=0; j<num_machines; j++)
+	{
+		CLinearMachine* machine=(CLinearMachine*) m_machines->get_element(j);
+		SGVector<float64_t> w_j=machine->get_w();
+		bias[j]=machine->get_bias();
+		SG_UNREF(machine);
+
+		/* let the machines report the mismatch when applied one by one */
+		if (w_j.vlen!=dim)
+		{
+			SG_FREE(w);
+			return false;
+		}
+
+		/* the machines keep their weights alive */
+		w[j]=w_j.vector;
+		for (int32_t k=0; k<dim; k++)
+			W(j,k)=w_j[k];
+	}
+
+	LINEAR_MULTICLASS_THREAD_PARAM params;
+	params.features=m_features;
+	params.num_machines=num_machines;
+	params.dim=dim;
+	params.W=W.matrix;
+	params.w=w;
+	params.bias=bias.vector;
+	params.outputs=outputs;
+	params.arg_max=arg_max;
+
+	/* feature class and type are forwarded by wrappers like
+	 * CDenseSubsetFeatures, so the actual class is checked */
+	if (dynamic_cast<CDenseFeatures<float64_t>*>(m_features))
+	{
+		parallel->parallel_for(0, num_vectors, dense_outputs_helper, &params,
+				LINEAR_MULTICLASS_BLOCK_SIZE);
+	}
+	else if (dynamic_cast<CSparseFeatures<float64_t>*>(m_features))
+	{
+		parallel->parallel_for(0, num_vectors, sparse_outputs_helper, &params);
+	}
+	else
+		parallel->parallel_for(0, num_vectors, dot_outputs_helper, &params);
+
+	SG_FREE(w);
+
+	return true;
+}
+
+CMachine* CLinearMulticlassMachine::get_machine_for_concurrent_train(
+		SGVector<index_t> subset)
+{
+	/* clone only the parameters of the base machine, not its data */
+	CLinearMachine* base=(CLinearMachine*) m_machine;
+	CLabels* labels=base->get_labels();
+	base->set_features(NULL);
+	base->set_labels(NULL);
+	CLinearMachine* machine=(CLinearMachine*) base->clone();
+	base->set_features(m_features);
+	base->set_labels(labels);
+	SG_UNREF(labels);
+
+	if (!machine)
+		return NULL;
+
+	if (subset.vlen)
+	{
+		/* subsets of the shared features can not be used concurrently */
+		CFeatures* features=m_features->copy_subset(subset);
+		machine->set_features((CDotFeatures*) features);
+		SG_UNREF(features);
+	}
+	else
+		machine->set_features(m_features);
+
+	return machine;
+}
+
+CMachine* CLinearMulticlassMachine::get_machine_from_concurrent_trained(
+		CMachine* machine, SGVector<index_t> subset)
+{
+	CLinearMachine* result=(CLinearMachine*) get_machine_from_trained(machine);
+	result->set_features(m_features);
+	return result;
+}
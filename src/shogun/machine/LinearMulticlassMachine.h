@@ -88,6 +88,30 @@ class CLinearMulticlassMachine : public CMulticlassMachine
 			return m_features;
 		}
 
+		/** get outputs of all submachines for all vectors at once
+		 *
+		 * The weight vectors of all submachines are stacked into one matrix,
+		 * blocks of dense vectors are scored with a single matrix product,
+		 * sparse vectors add the rows of their non-zero features. The data
+		 * is read once instead of once per submachine.
+		 *
+		 * @param num_vectors number of feature vectors
+		 * @return outputs, one column per vector
+		 */
+		virtual SGMatrix<float64_t> get_all_submachine_outputs(
+				int32_t num_vectors);
+
+		/** get the index of the submachine with the largest output for all
+		 * vectors. Scores like get_all_submachine_outputs but decides on
+		 * each block of vectors right away, so only the outputs of one block
+		 * per thread are kept.
+		 *
+		 * @param num_vectors number of feature vectors
+		 * @return index of the largest output per vector
+		 */
+		virtual SGVector<float64_t> get_all_submachine_arg_max(
+				int32_t num_vectors);
+
 	protected:
 
 		/** init machine for train with setting features */
@@ -168,6 +192,43 @@ class CLinearMulticlassMachine : public CMulticlassMachine
 		 */
 		virtual void store_model_features() {}
 
+		/** @return true, the base machine is copied per submachine */
+		virtual bool init_machines_for_concurrent_train()
+		{
+			return true;
+		}
+
+		/** clone the base machine without data, training subsets are copied
+		 * into features of their own
+		 *
+		 * @param subset indices of the training vectors, empty for all
+		 * @return machine (SG_REF'ed) or NULL if cloning failed
+		 */
+		virtual CMachine* get_machine_for_concurrent_train(
+				SGVector<index_t> subset);
+
+		/** obtain submachine from a concurrently trained copy
+		 *
+		 * @param machine trained copy
+		 * @param subset indices of the training vectors, empty for all
+		 * @return submachine using the features of this machine
+		 */
+		virtual CMachine* get_machine_from_concurrent_trained(
+				CMachine* machine, SGVector<index_t> subset);
+
+	private:
+		/** score all vectors with all submachines in parallel
+		 *
+		 * @param num_vectors number of feature vectors
+		 * @param outputs where to store the outputs (one column per vector),
+		 * NULL to not store them
+		 * @param arg_max where to store the index of the largest output per
+		 * vector, NULL to not store it
+		 * @return whether the submachines could be applied at once
+		 */
+		bool compute_all_submachine_outputs(int32_t num_vectors,
+				float64_t* outputs, float64_t* arg_max);
+
 	protected:
 
 		/** features */
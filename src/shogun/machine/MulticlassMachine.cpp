@@ -15,6 +15,7 @@
 #include <shogun/machine/KernelMachine.h>
 #include <shogun/machine/MulticlassMachine.h>
 #include <shogun/base/Parameter.h>
+#include <shogun/base/Parallel.h>
 #include <shogun/labels/MulticlassLabels.h>
 #include <shogun/labels/RegressionLabels.h>
 #include <shogun/mathematics/Statistics.h>
@@ -59,8 +60,15 @@ void CMulticlassMachine::set_labels(CLabels* lab)
 
 void CMulticlassMachine::register_parameters()
 {
+	m_concurrent_training=false;
+	m_store_confidences=true;
+
 	SG_ADD((CSGObject**)&m_multiclass_strategy,"m_multiclass_type", "Multiclass strategy", MS_NOT_AVAILABLE);
 	SG_ADD((CSGObject**)&m_machine, "m_machine", "The base machine", MS_NOT_AVAILABLE);
+	SG_ADD(&m_concurrent_training, "concurrent_training",
+			"Whether submachines are trained concurrently", MS_NOT_AVAILABLE);
+	SG_ADD(&m_store_confidences, "store_confidences",
+			"Whether outputs are stored as confidences", MS_NOT_AVAILABLE);
 }
 
 void CMulticlassMachine::init_strategy()
@@ -119,10 +127,58 @@ CMulticlassLabels* CMulticlassMachine::apply_multiclass(CFeatures* data)
 		int32_t num_classes=m_multiclass_strategy->get_num_classes();
 		EProbHeuristicType heuris = get_prob_heuris();
 
-		if (heuris!=PROB_HEURIS_NONE)
-			result->allocate_confidences_for(num_classes);
-		else
-			result->allocate_confidences_for(num_machines);
+		if (heuris==PROB_HEURIS_NONE && !m_store_confidences &&
+				is_arg_max_strategy())
+		{
+			/* labels are decided per block, outputs are not kept */
+			SGVector<float64_t> arg_max=get_all_submachine_arg_max(
+					num_vectors);
+
+			if (arg_max.vector)
+			{
+				ASSERT(arg_max.vlen==num_vectors)
+				result->set_labels(arg_max);
+
+				SG_DEBUG("leaving %s::apply_multiclass(%s at %p)\n",
+						get_name(), data ? data->get_name() : "NULL", data);
+				return result;
+			}
+		}
+
+		if (m_store_confidences)
+		{
+			if (heuris!=PROB_HEURIS_NONE)
+				result->allocate_confidences_for(num_classes);
+			else
+				result->allocate_confidences_for(num_machines);
+		}
+
+		if (heuris==PROB_HEURIS_NONE)
+		{
+			SGMatrix<float64_t> all_outputs=get_all_submachine_outputs(
+					num_vectors);
+
+			if (all_outputs.matrix)
+			{
+				ASSERT(all_outputs.num_rows==num_machines)
+				ASSERT(all_outputs.num_cols==num_vectors)
+
+				for (int32_t i=0; i<num_vectors; i++)
+				{
+					SGVector<float64_t> output_for_i(
+							all_outputs.get_column_vector(i), num_machines,
+							false);
+					result->set_label(i,
+							m_multiclass_strategy->decide_label(output_for_i));
+					if (m_store_confidences)
+						result->set_multiclass_confidences(i, output_for_i);
+				}
+
+				SG_DEBUG("leaving %s::apply_multiclass(%s at %p)\n",
+						get_name(), data ? data->get_name() : "NULL", data);
+				return result;
+			}
+		}
 
 		CBinaryLabels** outputs=SG_MALLOC(CBinaryLabels*, num_machines);
 		SGVector<float64_t> As(num_machines);
@@ -174,7 +230,8 @@ CMulticlassLabels* CMulticlassMachine::apply_multiclass(CFeatures* data)
 
 			// use rescaled outputs for label decision
 			result->set_label(i, m_multiclass_strategy->decide_label(r_output_for_i));
-			result->set_multiclass_confidences(i, r_output_for_i);
+			if (m_store_confidences)
+				result->set_multiclass_confidences(i, r_output_for_i);
 		}
 
 		for (int32_t i=0; i < num_machines; ++i)
@@ -193,6 +250,18 @@ CMulticlassLabels* CMulticlassMachine::apply_multiclass(CFeatures* data)
 	return return_labels;
 }
 
+bool CMulticlassMachine::is_arg_max_strategy()
+{
+	if (!dynamic_cast<CMulticlassOneVsRestStrategy*>(m_multiclass_strategy))
+		return false;
+
+	CRejectionStrategy* rejection=m_multiclass_strategy->get_rejection_strategy();
+	bool result=rejection==NULL;
+	SG_UNREF(rejection);
+
+	return result;
+}
+
 CMulticlassMultipleOutputLabels* CMulticlassMachine::apply_multiclass_multiple_output(CFeatures* data, int32_t n_outputs)
 {
 	CMulticlassMultipleOutputLabels* return_labels=NULL;
@@ -214,6 +283,21 @@ CMulticlassMultipleOutputLabels* CMulticlassMachine::apply_multiclass_multiple_o
 		REQUIRE(n_outputs<=num_machines,"You request more outputs than machines available")
 
 		CMulticlassMultipleOutputLabels* result=new CMulticlassMultipleOutputLabels(num_vectors);
+
+		SGMatrix<float64_t> all_outputs=get_all_submachine_outputs(num_vectors);
+		if (all_outputs.matrix)
+		{
+			for (int32_t i=0; i<num_vectors; i++)
+			{
+				SGVector<float64_t> output_for_i(
+						all_outputs.get_column_vector(i), num_machines, false);
+				result->set_label(i, m_multiclass_strategy->
+						decide_label_multiple_output(output_for_i, n_outputs));
+			}
+
+			return result;
+		}
+
 		CBinaryLabels** outputs=SG_MALLOC(CBinaryLabels*, num_machines);
 
 		for (int32_t i=0; i < num_machines; ++i)
@@ -256,6 +340,21 @@ bool CMulticlassMachine::train_machine(CFeatures* data)
 	m_machine->set_labels(train_labels);
 
 	m_multiclass_strategy->train_start(CLabelsFactory::to_multiclass(m_labels), train_labels);
+
+	if (m_concurrent_training)
+	{
+		if (init_machines_for_concurrent_train())
+		{
+			train_machines_concurrently(train_labels);
+			cleanup_machines_for_concurrent_train();
+		}
+		else
+		{
+			SG_WARNING("%s does not support concurrent training, training "
+					"submachines sequentially\n", get_name())
+		}
+	}
+
 	while (m_multiclass_strategy->train_has_more())
 	{
 		SGVector<index_t> subset=m_multiclass_strategy->train_prepare_next();
@@ -281,6 +380,64 @@ bool CMulticlassMachine::train_machine(CFeatures* data)
 	return true;
 }
 
+static void train_machines_helper(int32_t start, int32_t end, int32_t thread,
+		void* p)
+{
+	CMachine** machines=(CMachine**) p;
+	for (int32_t i=start; i<end; i++)
+		machines[i]->train();
+}
+
+void CMulticlassMachine::train_machines_concurrently(
+		CBinaryLabels* train_labels)
+{
+	/* a few tasks per thread balance uneven training times while only a
+	 * bounded number of machine copies (and views of the data) exist */
+	int32_t max_tasks=4*parallel->get_num_threads();
+	CMachine** machines=SG_MALLOC(CMachine*, max_tasks);
+	SGVector<index_t>* subsets=new SGVector<index_t>[max_tasks];
+
+	while (m_multiclass_strategy->train_has_more())
+	{
+		int32_t num_tasks=0;
+		while (num_tasks<max_tasks && m_multiclass_strategy->train_has_more())
+		{
+			SGVector<index_t> subset=m_multiclass_strategy->train_prepare_next();
+			if (subset.vlen)
+				train_labels->add_subset(subset);
+
+			/* the strategy overwrites train_labels for the next task */
+			SGVector<float64_t> labels=train_labels->get_labels().clone();
+
+			if (subset.vlen)
+				train_labels->remove_subset();
+
+			CMachine* machine=get_machine_for_concurrent_train(subset);
+			REQUIRE(machine, "%s::train_machines_concurrently(): Could not "
+					"copy %s\n", get_name(), m_machine->get_name())
+			machine->set_labels(new CBinaryLabels(labels));
+
+			machines[num_tasks]=machine;
+			subsets[num_tasks]=subset;
+			num_tasks++;
+		}
+
+		parallel->parallel_for(0, num_tasks, train_machines_helper, machines,
+				1);
+
+		for (int32_t i=0; i<num_tasks; i++)
+		{
+			m_machines->push_back(get_machine_from_concurrent_trained(
+					machines[i], subsets[i]));
+			SG_UNREF(machines[i]);
+			subsets[i]=SGVector<index_t>();
+		}
+	}
+
+	delete[] subsets;
+	SG_FREE(machines);
+}
+
 float64_t CMulticlassMachine::apply_one(int32_t vec_idx)
 {
 	init_machines_for_apply(NULL);
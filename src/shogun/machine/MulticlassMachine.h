@@ -87,6 +87,33 @@ class CMulticlassMachine : public CBaseMulticlassMachine
 		 */
 		virtual float64_t get_submachine_output(int32_t i, int32_t num);
 
+		/** get outputs of all submachines for all vectors at once, in a
+		 * single pass over the data
+		 *
+		 * @param num_vectors number of feature vectors
+		 * @return outputs, one column per vector, or an empty matrix if the
+		 * submachines have to be applied one by one via
+		 * get_submachine_outputs
+		 */
+		virtual SGMatrix<float64_t> get_all_submachine_outputs(
+				int32_t num_vectors)
+		{
+			return SGMatrix<float64_t>();
+		}
+
+		/** get the index of the submachine with the largest output for all
+		 * vectors, without storing the outputs of all vectors
+		 *
+		 * @param num_vectors number of feature vectors
+		 * @return index of the largest output per vector, or an empty vector
+		 * if the submachines have to be applied one by one
+		 */
+		virtual SGVector<float64_t> get_all_submachine_arg_max(
+				int32_t num_vectors)
+		{
+			return SGVector<float64_t>();
+		}
+
 		/** classify all examples
 		 *
 		 * @return resulting labels
@@ -153,6 +180,49 @@ class CMulticlassMachine : public CBaseMulticlassMachine
 			m_multiclass_strategy->set_prob_heuris_type(prob_heuris);
 		}
 
+		/** set whether the submachines are trained concurrently
+		 *
+		 * In concurrent mode, every submachine is trained on its own copy of
+		 * the base machine (cloned without training data) and the copies are
+		 * trained in parallel on the thread pool. Each copy gets its own view
+		 * of the training data, so the base machine's training has to be
+		 * thread-safe otherwise (e.g. results of machines drawing random
+		 * numbers are not reproducible). Multiclass machines that do not
+		 * support it fall back to sequential training.
+		 *
+		 * @param concurrent whether to train concurrently
+		 */
+		inline void set_concurrent_training(bool concurrent)
+		{
+			m_concurrent_training=concurrent;
+		}
+
+		/** @return whether the submachines are trained concurrently */
+		inline bool get_concurrent_training() const
+		{
+			return m_concurrent_training;
+		}
+
+		/** set whether apply_multiclass stores the outputs of the
+		 * submachines as confidences of the labels (default true)
+		 *
+		 * Without confidences, one-vs-rest machines without rejection
+		 * strategy that support get_all_submachine_arg_max decide labels
+		 * per block of vectors instead of storing all outputs.
+		 *
+		 * @param store_confidences whether to store confidences
+		 */
+		inline void set_store_confidences(bool store_confidences)
+		{
+			m_store_confidences=store_confidences;
+		}
+
+		/** @return whether confidences are stored */
+		inline bool get_store_confidences() const
+		{
+			return m_store_confidences;
+		}
+
 	protected:
 		/** init strategy */
 		void init_strategy();
@@ -193,17 +263,73 @@ class CMulticlassMachine : public CBaseMulticlassMachine
 			return true;
 		}
 
+		/** prepare concurrent training of the submachines, called after
+		 * init_machine_for_train
+		 *
+		 * @return whether concurrent training is supported
+		 */
+		virtual bool init_machines_for_concurrent_train()
+		{
+			return false;
+		}
+
+		/** create a copy of the base machine, without labels, that can be
+		 * trained independently of the base machine and of other copies
+		 *
+		 * @param subset indices of the training vectors, empty for all
+		 * @return machine (SG_REF'ed) or NULL if the base machine could not
+		 * be copied
+		 */
+		virtual CMachine* get_machine_for_concurrent_train(
+				SGVector<index_t> subset)
+		{
+			return NULL;
+		}
+
+		/** obtain submachine from a concurrently trained copy
+		 *
+		 * @param machine copy from get_machine_for_concurrent_train
+		 * @param subset indices of the training vectors, empty for all
+		 * @return submachine
+		 */
+		virtual CMachine* get_machine_from_concurrent_trained(
+				CMachine* machine, SGVector<index_t> subset)
+		{
+			return get_machine_from_trained(machine);
+		}
+
+		/** release everything set up for concurrent training */
+		virtual void cleanup_machines_for_concurrent_train() { }
+
 	private:
 
 		/** register parameters */
 		void register_parameters();
 
+		/** @return whether the label is the index of the largest output,
+		 * i.e. one-vs-rest without rejection strategy
+		 */
+		bool is_arg_max_strategy();
+
+		/** train copies of the base machine concurrently, in waves of a few
+		 * tasks per thread
+		 *
+		 * @param train_labels binary labels the strategy writes to
+		 */
+		void train_machines_concurrently(CBinaryLabels* train_labels);
+
 	protected:
 		/** type of multiclass strategy */
 		CMulticlassStrategy *m_multiclass_strategy;
 
 		/** machine */
 		CMachine* m_machine;
+
+		/** whether the submachines are trained concurrently */
+		bool m_concurrent_training;
+
+		/** whether outputs are stored as confidences */
+		bool m_store_confidences;
 };
 }
 #endif
@@ -0,0 +1,509 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/machine/gp/MatrixFreeInferenceMethod.h>
+
+#ifdef HAVE_LAPACK
+#ifdef HAVE_EIGEN3
+
+#include <shogun/machine/gp/GaussianLikelihood.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/mathematics/linalg/linop/KernelMatrixOperator.h>
+#include <shogun/mathematics/linalg/linsolver/ConjugateGradientSolver.h>
+#include <shogun/mathematics/linalg/linsolver/CGMShiftedFamilySolver.h>
+#include <shogun/mathematics/linalg/eigsolver/LanczosEigenSolver.h>
+#include <shogun/mathematics/linalg/ratapprox/logdet/LogDetEstimator.h>
+#include <shogun/mathematics/linalg/ratapprox/logdet/opfunc/LogRationalApproximationCGM.h>
+#include <shogun/mathematics/linalg/ratapprox/tracesampler/NormalSampler.h>
+#include <shogun/lib/computation/engine/SerialComputationEngine.h>
+
+using namespace shogun;
+using namespace Eigen;
+
+/** maximum number of kernel derivative elements computed at once */
+#define KERNEL_DERIVATIVE_BLOCK_ELEMENTS (1<<22)
+
+CMatrixFreeInferenceMethod::CMatrixFreeInferenceMethod() : CInferenceMethod()
+{
+	init();
+}
+
+CMatrixFreeInferenceMethod::CMatrixFreeInferenceMethod(CKernel* kern,
+		CFeatures* feat, CMeanFunction* m, CLabels* lab,
+		CLikelihoodModel* mod) : CInferenceMethod(kern, feat, m, lab, mod)
+{
+	init();
+}
+
+void CMatrixFreeInferenceMethod::init()
+{
+	m_operator=NULL;
+	m_linear_solver=new CConjugateGradientSolver();
+	SG_REF(m_linear_solver);
+	m_computation_engine=new CSerialComputationEngine();
+	SG_REF(m_computation_engine);
+	m_num_probe_vectors=10;
+	m_log_det_accuracy=1E-5;
+	m_log_det=0.0;
+	m_inverse_trace=0.0;
+
+	SG_ADD((CSGObject**)&m_linear_solver, "linear_solver",
+			"Linear solver", MS_NOT_AVAILABLE);
+	SG_ADD((CSGObject**)&m_computation_engine, "computation_engine",
+			"Computation engine for log-determinant jobs", MS_NOT_AVAILABLE);
+	SG_ADD(&m_num_probe_vectors, "num_probe_vectors",
+			"Number of probe vectors for stochastic estimates", MS_NOT_AVAILABLE);
+	SG_ADD(&m_log_det_accuracy, "log_det_accuracy",
+			"Accuracy of the rational approximation", MS_NOT_AVAILABLE);
+}
+
+CMatrixFreeInferenceMethod::~CMatrixFreeInferenceMethod()
+{
+	SG_UNREF(m_operator);
+	SG_UNREF(m_linear_solver);
+	SG_UNREF(m_computation_engine);
+}
+
+CMatrixFreeInferenceMethod* CMatrixFreeInferenceMethod::obtain_from_generic(
+		CInferenceMethod* inference)
+{
+	ASSERT(inference!=NULL);
+
+	if (inference->get_inference_type()!=INF_MATRIX_FREE)
+		SG_SERROR("Provided inference is not of type CMatrixFreeInferenceMethod!\n")
+
+	SG_REF(inference);
+	return (CMatrixFreeInferenceMethod*)inference;
+}
+
+void CMatrixFreeInferenceMethod::update()
+{
+	CInferenceMethod::update();
+	update_chol();
+	update_alpha();
+	update_deriv();
+}
+
+void CMatrixFreeInferenceMethod::check_members() const
+{
+	CInferenceMethod::check_members();
+
+	REQUIRE(m_model->get_model_type()==LT_GAUSSIAN,
+		"Matrix free inference method can only use Gaussian likelihood "
+		"function\n")
+	REQUIRE(m_labels->get_label_type()==LT_REGRESSION,
+		"Labels must be type of CRegressionLabels\n")
+}
+
+void CMatrixFreeInferenceMethod::update_train_kernel()
+{
+	m_kernel->init(m_features, m_features);
+}
+
+CConjugateGradientSolver* CMatrixFreeInferenceMethod::get_linear_solver()
+{
+	SG_REF(m_linear_solver);
+	return m_linear_solver;
+}
+
+void CMatrixFreeInferenceMethod::set_linear_solver(
+		CConjugateGradientSolver* solver)
+{
+	REQUIRE(solver, "Linear solver should not be NULL\n")
+
+	SG_REF(solver);
+	SG_UNREF(m_linear_solver);
+	m_linear_solver=solver;
+}
+
+CIndependentComputationEngine* CMatrixFreeInferenceMethod::get_computation_engine()
+{
+	SG_REF(m_computation_engine);
+	return m_computation_engine;
+}
+
+void CMatrixFreeInferenceMethod::set_computation_engine(
+		CIndependentComputationEngine* engine)
+{
+	REQUIRE(engine, "Computation engine should not be NULL\n")
+
+	SG_REF(engine);
+	SG_UNREF(m_computation_engine);
+	m_computation_engine=engine;
+}
+
+void CMatrixFreeInferenceMethod::set_num_probe_vectors(int32_t num_probe_vectors)
+{
+	REQUIRE(num_probe_vectors>0, "Number of probe vectors must be positive "
+			"but is %d\n", num_probe_vectors)
+
+	m_num_probe_vectors=num_probe_vectors;
+}
+
+void CMatrixFreeInferenceMethod::set_log_det_accuracy(float64_t accuracy)
+{
+	REQUIRE(accuracy>0, "Accuracy must be positive but is %f\n", accuracy)
+
+	m_log_det_accuracy=accuracy;
+}
+
+SGVector<float64_t> CMatrixFreeInferenceMethod::get_diagonal_vector()
+{
+	if (update_parameter_hash())
+		update();
+
+	// get the sigma variable from the Gaussian likelihood model
+	CGaussianLikelihood* lik=CGaussianLikelihood::obtain_from_generic(m_model);
+	float64_t sigma=lik->get_sigma();
+	SG_UNREF(lik);
+
+	// compute diagonal vector: sW=1/sigma
+	SGVector<float64_t> result(m_features->get_num_vectors());
+	result.fill_vector(result.vector, m_features->get_num_vectors(), 1.0/sigma);
+
+	return result;
+}
+
+float64_t CMatrixFreeInferenceMethod::get_negative_log_marginal_likelihood()
+{
+	if (update_parameter_hash())
+		update();
+
+	// get labels and mean vectors and create eigen representation
+	SGVector<float64_t> y=((CRegressionLabels*) m_labels)->get_labels();
+	Map<VectorXd> eigen_y(y.vector, y.vlen);
+	SGVector<float64_t> m=m_mean->get_mean_vector(m_features);
+	Map<VectorXd> eigen_m(m.vector, m.vlen);
+	Map<VectorXd> eigen_alpha(m_alpha.vector, m_alpha.vlen);
+
+	// compute negative log of the marginal likelihood:
+	// nlZ=(y-m)'*alpha/2+log(det(K+sigma^2*I))/2+n*log(2*pi)/2
+	float64_t result=(eigen_y-eigen_m).dot(eigen_alpha)/2.0+m_log_det/2.0+
+		y.vlen*CMath::log(2*CMath::PI)/2.0;
+
+	return result;
+}
+
+SGVector<float64_t> CMatrixFreeInferenceMethod::get_alpha()
+{
+	if (update_parameter_hash())
+		update();
+
+	return SGVector<float64_t>(m_alpha);
+}
+
+SGMatrix<float64_t> CMatrixFreeInferenceMethod::get_cholesky()
+{
+	SG_ERROR("%s does not compute a Cholesky factorization\n", get_name())
+	return SGMatrix<float64_t>();
+}
+
+SGVector<float64_t> CMatrixFreeInferenceMethod::get_posterior_mean()
+{
+	if (update_parameter_hash())
+		update();
+
+	// get the sigma variable from the Gaussian likelihood model
+	CGaussianLikelihood* lik=CGaussianLikelihood::obtain_from_generic(m_model);
+	float64_t sigma=lik->get_sigma();
+	SG_UNREF(lik);
+
+	SGVector<float64_t> y=((CRegressionLabels*) m_labels)->get_labels();
+	Map<VectorXd> eigen_y(y.vector, y.vlen);
+	Map<VectorXd> eigen_alpha(m_alpha.vector, m_alpha.vlen);
+
+	SGVector<float64_t> mu(y.vlen);
+	Map<VectorXd> eigen_mu(mu.vector, mu.vlen);
+
+	// compute mean: mu=K*alpha+m=y-sigma^2*alpha, since (K+sigma^2*I)*alpha=y-m
+	eigen_mu=eigen_y-CMath::sq(sigma)*eigen_alpha;
+
+	return mu;
+}
+
+SGMatrix<float64_t> CMatrixFreeInferenceMethod::get_posterior_covariance()
+{
+	SG_ERROR("%s does not compute the posterior covariance matrix\n",
+			get_name())
+	return SGMatrix<float64_t>();
+}
+
+SGVector<float64_t> CMatrixFreeInferenceMethod::solve(SGVector<float64_t> b)
+{
+	if (update_parameter_hash())
+		update();
+
+	REQUIRE(b.vlen==m_operator->get_dimension(), "Length of vector (%d) must "
+			"match number of training vectors (%d)\n", b.vlen,
+			m_operator->get_dimension())
+
+	// the kernel might have been initialized with other features meanwhile
+	m_kernel->init(m_features, m_features);
+
+	return m_linear_solver->solve(m_operator, b);
+}
+
+void CMatrixFreeInferenceMethod::update_chol()
+{
+	// get the sigma variable from the Gaussian likelihood model
+	CGaussianLikelihood* lik=CGaussianLikelihood::obtain_from_generic(m_model);
+	float64_t sigma=lik->get_sigma();
+	SG_UNREF(lik);
+
+	SG_UNREF(m_operator);
+	m_operator=new CKernelMatrixOperator(m_kernel, CMath::sq(m_scale),
+			CMath::sq(sigma));
+	SG_REF(m_operator);
+
+	// estimate log(det(K+sigma^2*I))=n*log(sigma^2)+log(det(K/sigma^2+I))
+	// with a rational approximation of the matrix logarithm. Most
+	// eigenvalues of K/sigma^2+I are close to one, so the log-determinant of
+	// this operator has a much smaller variance than the one of K+sigma^2*I.
+	// The extremal eigenvalues change with the hyperparameters, so the eigen
+	// solver is not reused
+	CKernelMatrixOperator* op=new CKernelMatrixOperator(m_kernel,
+			CMath::sq(m_scale/sigma), 1.0);
+	CLanczosEigenSolver* eigen_solver=new CLanczosEigenSolver(op);
+	CCGMShiftedFamilySolver* shifted_solver=new CCGMShiftedFamilySolver();
+	CLogRationalApproximationCGM* op_func=new CLogRationalApproximationCGM(
+			op, m_computation_engine, eigen_solver, shifted_solver,
+			m_log_det_accuracy);
+	CNormalSampler* trace_sampler=new CNormalSampler(op->get_dimension());
+
+	CLogDetEstimator* estimator=new CLogDetEstimator(trace_sampler, op_func,
+			m_computation_engine);
+	SG_REF(estimator);
+
+	SGVector<float64_t> estimates=estimator->sample(m_num_probe_vectors);
+	m_log_det=SGVector<float64_t>::sum(estimates)/estimates.vlen+
+		op->get_dimension()*CMath::log(CMath::sq(sigma));
+
+	SG_UNREF(estimator);
+}
+
+void CMatrixFreeInferenceMethod::update_alpha()
+{
+	// get labels and mean vector and create eigen representation
+	SGVector<float64_t> y=((CRegressionLabels*) m_labels)->get_labels();
+	Map<VectorXd> eigen_y(y.vector, y.vlen);
+	SGVector<float64_t> m=m_mean->get_mean_vector(m_features);
+	Map<VectorXd> eigen_m(m.vector, m.vlen);
+
+	SGVector<float64_t> b(y.vlen);
+	Map<VectorXd> eigen_b(b.vector, b.vlen);
+	eigen_b=eigen_y-eigen_m;
+
+	// solve (K+sigma^2*I)*alpha=y-m
+	m_alpha=m_linear_solver->solve(m_operator, b);
+}
+
+void CMatrixFreeInferenceMethod::update_deriv()
+{
+	index_t n=m_operator->get_dimension();
+
+	m_probes=SGMatrix<float64_t>(n, m_num_probe_vectors);
+	m_probe_solutions=SGMatrix<float64_t>(n, m_num_probe_vectors);
+
+	// Hutchinson's estimator with Rademacher probe vectors z_t:
+	// tr(A^-1)=E[z_t'*A^-1*z_t]
+	m_inverse_trace=0.0;
+	for (index_t t=0; t<m_num_probe_vectors; t++)
+	{
+		SGVector<float64_t> z(m_probes.get_column_vector(t), n, false);
+		for (index_t i=0; i<n; i++)
+			z[i]=CMath::random(0, 1) ? 1.0 : -1.0;
+
+		SGVector<float64_t> w=m_linear_solver->solve(m_operator, z);
+		memcpy(m_probe_solutions.get_column_vector(t), w.vector,
+				sizeof(float64_t)*n);
+
+		m_inverse_trace+=SGVector<float64_t>::dot(z.vector, w.vector, n);
+	}
+	m_inverse_trace/=m_num_probe_vectors;
+}
+
+SGVector<float64_t> CMatrixFreeInferenceMethod::get_derivative_wrt_inference_method(
+		const TParameter* param)
+{
+	REQUIRE(!strcmp(param->m_name, "scale"), "Can't compute derivative of "
+			"the nagative log marginal likelihood wrt %s.%s parameter\n",
+			get_name(), param->m_name)
+
+	// get the sigma variable from the Gaussian likelihood model
+	CGaussianLikelihood* lik=CGaussianLikelihood::obtain_from_generic(m_model);
+	float64_t sigma=lik->get_sigma();
+	SG_UNREF(lik);
+
+	SGVector<float64_t> y=((CRegressionLabels*) m_labels)->get_labels();
+	Map<VectorXd> eigen_y(y.vector, y.vlen);
+	SGVector<float64_t> m=m_mean->get_mean_vector(m_features);
+	Map<VectorXd> eigen_m(m.vector, m.vlen);
+	Map<VectorXd> eigen_alpha(m_alpha.vector, m_alpha.vlen);
+
+	SGVector<float64_t> result(1);
+
+	// with A=K*scale^2+sigma^2*I, A^-1*K*scale^2=I-sigma^2*A^-1 and
+	// K*scale^2*alpha=y-m-sigma^2*alpha, such that no kernel evaluations are
+	// needed for dnlZ=(tr(A^-1*K*scale^2)-alpha'*K*scale^2*alpha)/scale
+	float64_t trace=y.vlen-CMath::sq(sigma)*m_inverse_trace;
+	float64_t quad=eigen_alpha.dot(eigen_y-eigen_m)-
+		CMath::sq(sigma)*eigen_alpha.squaredNorm();
+	result[0]=(trace-quad)/m_scale;
+
+	return result;
+}
+
+SGVector<float64_t> CMatrixFreeInferenceMethod::get_derivative_wrt_likelihood_model(
+		const TParameter* param)
+{
+	REQUIRE(!strcmp(param->m_name, "sigma"), "Can't compute derivative of "
+			"the nagative log marginal likelihood wrt %s.%s parameter\n",
+			m_model->get_name(), param->m_name)
+
+	// get the sigma variable from the Gaussian likelihood model
+	CGaussianLikelihood* lik=CGaussianLikelihood::obtain_from_generic(m_model);
+	float64_t sigma=lik->get_sigma();
+	SG_UNREF(lik);
+
+	Map<VectorXd> eigen_alpha(m_alpha.vector, m_alpha.vlen);
+
+	SGVector<float64_t> result(1);
+
+	// compute derivative wrt likelihood model parameter sigma:
+	// dnlZ=sigma^2*(tr(A^-1)-alpha'*alpha)
+	result[0]=CMath::sq(sigma)*(m_inverse_trace-eigen_alpha.squaredNorm());
+
+	return result;
+}
+
+SGVector<float64_t> CMatrixFreeInferenceMethod::get_derivative_wrt_kernel(
+		const TParameter* param)
+{
+	SGVector<float64_t> result;
+
+	if (param->m_datatype.m_ctype==CT_VECTOR ||
+			param->m_datatype.m_ctype==CT_SGVECTOR)
+	{
+		REQUIRE(param->m_datatype.m_length_y,
+				"Length of the parameter %s should not be NULL\n", param->m_name)
+		result=SGVector<float64_t>(*(param->m_datatype.m_length_y));
+	}
+	else
+	{
+		result=SGVector<float64_t>(1);
+	}
+
+	for (index_t i=0; i<result.vlen; i++)
+	{
+		result[i]=get_derivative_wrt_kernel_param(param,
+				result.vlen==1 ? -1 : i);
+	}
+
+	return result;
+}
+
+float64_t CMatrixFreeInferenceMethod::get_derivative_wrt_kernel_param(
+		const TParameter* param, index_t index)
+{
+	index_t n=m_features->get_num_vectors();
+	index_t block_size=CMath::max(1,
+			CMath::min(n, KERNEL_DERIVATIVE_BLOCK_ELEMENTS/n));
+
+	Map<VectorXd> eigen_alpha(m_alpha.vector, m_alpha.vlen);
+	Map<MatrixXd> eigen_Z(m_probes.matrix, m_probes.num_rows,
+			m_probes.num_cols);
+	Map<MatrixXd> eigen_W(m_probe_solutions.matrix, m_probe_solutions.num_rows,
+			m_probe_solutions.num_cols);
+
+	float64_t trace=0.0;
+	float64_t quad=0.0;
+
+	// derivatives are evaluated for blocks of rows, i.e. the kernel is
+	// initialized with a subset of the training features on the left hand
+	// side, which must not happen concurrently
+	m_kernel_lock.lock();
+
+	CFeatures* block_features=m_features->duplicate();
+	SG_REF(block_features);
+
+	for (index_t start=0; start<n; start+=block_size)
+	{
+		index_t len=CMath::min(block_size, n-start);
+
+		SGVector<index_t> subset(len);
+		subset.range_fill(start);
+		block_features->add_subset(subset);
+		m_kernel->init(block_features, m_features);
+
+		SGMatrix<float64_t> dK=m_kernel->get_parameter_gradient(param, index);
+		Map<MatrixXd> eigen_dK(dK.matrix, dK.num_rows, dK.num_cols);
+
+		// alpha'*dK*alpha and sum_t w_t'*dK*z_t restricted to the block rows
+		quad+=eigen_alpha.segment(start, len).dot(eigen_dK*eigen_alpha);
+		trace+=(eigen_W.middleRows(start, len).cwiseProduct(
+				eigen_dK*eigen_Z)).sum();
+
+		block_features->remove_subset();
+	}
+
+	SG_UNREF(block_features);
+	m_kernel->init(m_features, m_features);
+
+	m_kernel_lock.unlock();
+
+	trace/=m_num_probe_vectors;
+
+	// compute derivative wrt kernel parameter:
+	// dnlZ=(tr(A^-1*dK)-alpha'*dK*alpha)*scale^2/2
+	return (trace-quad)*CMath::sq(m_scale)/2.0;
+}
+
+SGVector<float64_t> CMatrixFreeInferenceMethod::get_derivative_wrt_mean(
+		const TParameter* param)
+{
+	// create eigen representation of alpha vector
+	Map<VectorXd> eigen_alpha(m_alpha.vector, m_alpha.vlen);
+
+	SGVector<float64_t> result;
+
+	if (param->m_datatype.m_ctype==CT_VECTOR ||
+			param->m_datatype.m_ctype==CT_SGVECTOR)
+	{
+		REQUIRE(param->m_datatype.m_length_y,
+				"Length of the parameter %s should not be NULL\n", param->m_name)
+
+		result=SGVector<float64_t>(*(param->m_datatype.m_length_y));
+	}
+	else
+	{
+		result=SGVector<float64_t>(1);
+	}
+
+	for (index_t i=0; i<result.vlen; i++)
+	{
+		SGVector<float64_t> dmu;
+
+		if (result.vlen==1)
+			dmu=m_mean->get_parameter_derivative(m_features, param);
+		else
+			dmu=m_mean->get_parameter_derivative(m_features, param, i);
+
+		Map<VectorXd> eigen_dmu(dmu.vector, dmu.vlen);
+
+		// compute derivative wrt mean parameter: dnlZ=-dmu'*alpha
+		result[i]=-eigen_dmu.dot(eigen_alpha);
+	}
+
+	return result;
+}
+
+#endif /* HAVE_EIGEN3 */
+#endif /* HAVE_LAPACK */
@@ -0,0 +1,322 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#ifndef CMATRIXFREEINFERENCEMETHOD_H_
+#define CMATRIXFREEINFERENCEMETHOD_H_
+
+#include <shogun/lib/config.h>
+
+#ifdef HAVE_LAPACK
+#ifdef HAVE_EIGEN3
+
+#include <shogun/machine/gp/InferenceMethod.h>
+#include <shogun/lib/Lock.h>
+
+namespace shogun
+{
+class CKernelMatrixOperator;
+class CConjugateGradientSolver;
+class CIndependentComputationEngine;
+
+/** @brief Exact Gaussian process regression inference that never stores the
+ * kernel matrix.
+ *
+ * All quantities are computed through the linear operator
+ *
+ * \f[
+ * A = K + \sigma^{2}I
+ * \f]
+ *
+ * (see CKernelMatrixOperator), which computes the rows of the (scaled)
+ * kernel matrix \f$K\f$ on the fly, so that memory requirements are linear
+ * in the number of training examples:
+ *
+ * - \f$\alpha=A^{-1}(y-m)\f$ is obtained with the conjugate gradient method
+ *   (CConjugateGradientSolver).
+ * - \f$log(\left|A\right|)\f$, needed for the negative log marginal
+ *   likelihood, is estimated stochastically with CLogDetEstimator using a
+ *   rational approximation of the matrix logarithm (CG-M solves for all
+ *   shifts) and Lanczos for the extremal eigenvalues.
+ * - The traces \f$tr(A^{-1}\frac{\partial K}{\partial\theta})\f$ in the
+ *   derivatives wrt hyperparameters are estimated with Hutchinson's
+ *   estimator \f$\frac{1}{T}\sum_t (A^{-1}z_t)^{T}\frac{\partial K}
+ *   {\partial\theta}z_t\f$ with Rademacher probe vectors \f$z_t\f$, where
+ *   the kernel derivatives are evaluated in blocks of rows.
+ *
+ * The negative log marginal likelihood and its derivatives are therefore
+ * unbiased estimates whose variance decreases with the number of probe
+ * vectors. The posterior covariance and Cholesky factor are not available;
+ * CGaussianProcessMachine computes predictive variances with one linear
+ * solve per test vector instead.
+ *
+ * The log-determinant jobs are computed by the set computation engine, a
+ * CThreadPoolComputationEngine computes them in parallel.
+ *
+ * NOTE: The Gaussian Likelihood Function must be used for this inference
+ * method.
+ */
+class CMatrixFreeInferenceMethod: public CInferenceMethod
+{
+public:
+	/** default constructor */
+	CMatrixFreeInferenceMethod();
+
+	/** constructor
+	 *
+	 * @param kernel covariance function
+	 * @param features features to use in inference
+	 * @param mean mean function to use
+	 * @param labels labels of the features
+	 * @param model likelihood model to use
+	 */
+	CMatrixFreeInferenceMethod(CKernel* kernel, CFeatures* features,
+			CMeanFunction* mean, CLabels* labels, CLikelihoodModel* model);
+
+	virtual ~CMatrixFreeInferenceMethod();
+
+	/** return what type of inference we are
+	 *
+	 * @return inference type MATRIX_FREE
+	 */
+	virtual EInferenceType get_inference_type() const { return INF_MATRIX_FREE; }
+
+	/** returns the name of the inference method
+	 *
+	 * @return name MatrixFreeInferenceMethod
+	 */
+	virtual const char* get_name() const { return "MatrixFreeInferenceMethod"; }
+
+	/** helper method used to specialize a base class instance
+	 *
+	 * @param inference inference method
+	 * @return casted CMatrixFreeInferenceMethod object
+	 */
+	static CMatrixFreeInferenceMethod* obtain_from_generic(
+			CInferenceMethod* inference);
+
+	/** get (an unbiased estimate of the) negative log marginal likelihood
+	 *
+	 * @return the negative log of the marginal likelihood function:
+	 *
+	 * \f[
+	 * -log(p(y|X, \theta))
+	 * \f]
+	 *
+	 * where \f$y\f$ are the labels, \f$X\f$ are the features, and \f$\theta\f$
+	 * represent hyperparameters.
+	 */
+	virtual float64_t get_negative_log_marginal_likelihood();
+
+	/** get alpha vector
+	 *
+	 * @return vector to compute posterior mean of Gaussian Process:
+	 *
+	 * \f[
+	 * \mu = K\alpha
+	 * \f]
+	 *
+	 * where \f$\mu\f$ is the mean and \f$K\f$ is the prior covariance matrix.
+	 */
+	virtual SGVector<float64_t> get_alpha();
+
+	/** not available, as it would require the kernel matrix
+	 *
+	 * @return nothing, raises an error
+	 */
+	virtual SGMatrix<float64_t> get_cholesky();
+
+	/** get diagonal vector
+	 *
+	 * @return diagonal of matrix used to calculate posterior covariance matrix:
+	 *
+	 * \f[
+	 * Cov = (K^{-1}+sW^{2})^{-1}
+	 * \f]
+	 *
+	 * where \f$Cov\f$ is the posterior covariance matrix, \f$K\f$ is the prior
+	 * covariance matrix, and \f$sW\f$ is the diagonal vector.
+	 */
+	virtual SGVector<float64_t> get_diagonal_vector();
+
+	/** returns mean vector \f$\mu\f$ of the posterior Gaussian distribution
+	 * \f$\mathcal{N}(\mu,\Sigma)\f$ at the training features
+	 *
+	 * @return mean vector
+	 */
+	virtual SGVector<float64_t> get_posterior_mean();
+
+	/** not available, as the posterior covariance is a dense matrix of the
+	 * size of the kernel matrix
+	 *
+	 * @return nothing, raises an error
+	 */
+	virtual SGMatrix<float64_t> get_posterior_covariance();
+
+	/**
+	 * @return whether combination of matrix free inference method and given
+	 * likelihood function supports regression
+	 */
+	virtual bool supports_regression() const
+	{
+		check_members();
+		return m_model->supports_regression();
+	}
+
+	/** update all matrices */
+	virtual void update();
+
+	/** solves \f$(K+\sigma^{2}I)x=b\f$ for \f$x\f$ with the linear solver
+	 *
+	 * @param b right hand side
+	 * @return solution \f$x\f$
+	 */
+	SGVector<float64_t> solve(SGVector<float64_t> b);
+
+	/** @return conjugate gradient solver used for all linear systems (to
+	 * adjust its tolerance and iteration limit)
+	 */
+	CConjugateGradientSolver* get_linear_solver();
+
+	/** @param solver conjugate gradient solver used for all linear systems */
+	void set_linear_solver(CConjugateGradientSolver* solver);
+
+	/** @return computation engine for the log-determinant jobs */
+	CIndependentComputationEngine* get_computation_engine();
+
+	/** @param engine computation engine for the log-determinant jobs */
+	void set_computation_engine(CIndependentComputationEngine* engine);
+
+	/** @param num_probe_vectors number of probe vectors for the stochastic
+	 * log-determinant and trace estimates
+	 */
+	void set_num_probe_vectors(int32_t num_probe_vectors);
+
+	/** @return number of probe vectors for the stochastic estimates */
+	int32_t get_num_probe_vectors() const { return m_num_probe_vectors; }
+
+	/** @param accuracy desired accuracy of the rational approximation of
+	 * the matrix logarithm
+	 */
+	void set_log_det_accuracy(float64_t accuracy);
+
+	/** @return desired accuracy of the rational approximation */
+	float64_t get_log_det_accuracy() const { return m_log_det_accuracy; }
+
+protected:
+	/** check if members of object are valid for inference */
+	virtual void check_members() const;
+
+	/** initializes the kernel on the training features, does not compute
+	 * the kernel matrix
+	 */
+	virtual void update_train_kernel();
+
+	/** update alpha vector */
+	virtual void update_alpha();
+
+	/** update the linear operator and the log-determinant estimate */
+	virtual void update_chol();
+
+	/** update the probe vectors which are required to compute negative log
+	 * marginal likelihood derivatives wrt hyperparameter
+	 */
+	virtual void update_deriv();
+
+	/** returns derivative of negative log marginal likelihood wrt parameter of
+	 * CInferenceMethod class
+	 *
+	 * @param param parameter of CInferenceMethod class
+	 *
+	 * @return derivative of negative log marginal likelihood
+	 */
+	virtual SGVector<float64_t> get_derivative_wrt_inference_method(
+			const TParameter* param);
+
+	/** returns derivative of negative log marginal likelihood wrt parameter of
+	 * likelihood model
+	 *
+	 * @param param parameter of given likelihood model
+	 *
+	 * @return derivative of negative log marginal likelihood
+	 */
+	virtual SGVector<float64_t> get_derivative_wrt_likelihood_model(
+			const TParameter* param);
+
+	/** returns derivative of negative log marginal likelihood wrt kernel's
+	 * parameter
+	 *
+	 * @param param parameter of given kernel
+	 *
+	 * @return derivative of negative log marginal likelihood
+	 */
+	virtual SGVector<float64_t> get_derivative_wrt_kernel(
+			const TParameter* param);
+
+	/** returns derivative of negative log marginal likelihood wrt mean
+	 * function's parameter
+	 *
+	 * @param param parameter of given mean function
+	 *
+	 * @return derivative of negative log marginal likelihood
+	 */
+	virtual SGVector<float64_t> get_derivative_wrt_mean(
+			const TParameter* param);
+
+	/** computes the derivative of the negative log marginal likelihood wrt
+	 * one kernel parameter, evaluating the kernel derivative in blocks of
+	 * rows
+	 *
+	 * @param param parameter of given kernel
+	 * @param index index of the parameter, -1 for scalar parameters
+	 *
+	 * @return derivative of negative log marginal likelihood
+	 */
+	float64_t get_derivative_wrt_kernel_param(const TParameter* param,
+			index_t index);
+
+private:
+	void init();
+
+protected:
+	/** linear operator \f$K+\sigma^{2}I\f$ */
+	CKernelMatrixOperator* m_operator;
+
+	/** linear solver */
+	CConjugateGradientSolver* m_linear_solver;
+
+	/** computation engine for the log-determinant jobs */
+	CIndependentComputationEngine* m_computation_engine;
+
+	/** number of probe vectors for the stochastic estimates */
+	int32_t m_num_probe_vectors;
+
+	/** desired accuracy of the rational approximation of the logarithm */
+	float64_t m_log_det_accuracy;
+
+	/** estimate of \f$log(\left|K+\sigma^{2}I\right|)\f$ */
+	float64_t m_log_det;
+
+	/** estimate of \f$tr((K+\sigma^{2}I)^{-1})\f$ */
+	float64_t m_inverse_trace;
+
+	/** Rademacher probe vectors \f$z_t\f$ (one per column) */
+	SGMatrix<float64_t> m_probes;
+
+	/** solutions \f$(K+\sigma^{2}I)^{-1}z_t\f$ (one per column) */
+	SGMatrix<float64_t> m_probe_solutions;
+
+	/** serializes the blockwise evaluation of kernel derivatives, which
+	 * re-initializes the kernel
+	 */
+	CLock m_kernel_lock;
+};
+}
+#endif /* HAVE_EIGEN3 */
+#endif /* HAVE_LAPACK */
+#endif /* CMATRIXFREEINFERENCEMETHOD_H_ */
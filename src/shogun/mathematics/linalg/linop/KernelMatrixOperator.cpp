@@ -0,0 +1,94 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/lib/config.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/base/Parameter.h>
+#include <shogun/kernel/Kernel.h>
+#include <shogun/mathematics/linalg/linop/KernelMatrixOperator.h>
+
+namespace shogun
+{
+
+CKernelMatrixOperator::CKernelMatrixOperator()
+	: CLinearOperator<float64_t>()
+{
+	init();
+
+	SG_GCDEBUG("%s created (%p)\n", this->get_name(), this)
+}
+
+CKernelMatrixOperator::CKernelMatrixOperator(CKernel* kernel, float64_t scale,
+	float64_t ridge)
+	: CLinearOperator<float64_t>()
+{
+	init();
+
+	REQUIRE(kernel, "Kernel is NULL\n");
+	REQUIRE(kernel->get_num_vec_lhs()==kernel->get_num_vec_rhs(),
+		"Kernel matrix must be square (%dx%d)\n", kernel->get_num_vec_lhs(),
+		kernel->get_num_vec_rhs());
+
+	SG_REF(kernel);
+	m_kernel=kernel;
+	m_dimension=kernel->get_num_vec_lhs();
+	m_scale=scale;
+	m_ridge=ridge;
+
+	SG_GCDEBUG("%s created (%p)\n", this->get_name(), this)
+}
+
+void CKernelMatrixOperator::init()
+{
+	m_kernel=NULL;
+	m_scale=1.0;
+	m_ridge=0.0;
+
+	SG_ADD((CSGObject**)&m_kernel, "kernel", "The kernel", MS_NOT_AVAILABLE);
+	SG_ADD(&m_scale, "scale", "Scale of the kernel matrix", MS_NOT_AVAILABLE);
+	SG_ADD(&m_ridge, "ridge", "Ridge added to the diagonal", MS_NOT_AVAILABLE);
+}
+
+CKernelMatrixOperator::~CKernelMatrixOperator()
+{
+	SG_UNREF(m_kernel);
+
+	SG_GCDEBUG("%s destroyed (%p)\n", this->get_name(), this)
+}
+
+CKernel* CKernelMatrixOperator::get_kernel()
+{
+	SG_REF(m_kernel);
+	return m_kernel;
+}
+
+SGVector<float64_t> CKernelMatrixOperator::apply(SGVector<float64_t> b) const
+{
+	REQUIRE(m_kernel, "Kernel is NULL\n");
+	REQUIRE(m_dimension==b.vlen, "Number of rows of vector must be equal to the "
+		"number of cols of the operator (%d), but is %d\n", m_dimension, b.vlen);
+	REQUIRE(m_kernel->get_num_vec_lhs()==m_dimension &&
+		m_kernel->get_num_vec_rhs()==m_dimension,
+		"Kernel must be initialized with %d vectors on both sides\n",
+		m_dimension);
+
+	SGVector<float64_t> result(m_dimension);
+	SGVector<float64_t> row(m_dimension);
+
+	for (index_t i=0; i<m_dimension; ++i)
+	{
+		m_kernel->fill_kernel_row(i, row.vector);
+		result[i]=m_scale*SGVector<float64_t>::dot(row.vector, b.vector,
+			m_dimension)+m_ridge*b[i];
+	}
+
+	return result;
+}
+
+}
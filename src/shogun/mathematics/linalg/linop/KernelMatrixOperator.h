@@ -0,0 +1,97 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#ifndef KERNEL_MATRIX_OPERATOR_H_
+#define KERNEL_MATRIX_OPERATOR_H_
+
+#include <shogun/lib/config.h>
+#include <shogun/mathematics/linalg/linop/LinearOperator.h>
+
+namespace shogun
+{
+template<class T> class SGVector;
+class CKernel;
+
+/** @brief Class that represents the (scaled and shifted) kernel matrix of a
+ * kernel as a linear operator without ever storing the matrix.
+ *
+ * Its apply method computes \f$(sK+rI)x\f$, where \f$K\f$ is the kernel
+ * matrix, \f$s\f$ a scale and \f$r\f$ a ridge. The kernel matrix is
+ * computed row by row (via CKernel::fill_kernel_row) in every application,
+ * so that memory requirements are linear in the number of examples. An
+ * attached CKernelRowCache may be used to avoid recomputing rows.
+ *
+ * The kernel has to be initialized with the same features on both sides
+ * before the operator is applied.
+ */
+class CKernelMatrixOperator : public CLinearOperator<float64_t>
+{
+public:
+	/** default constructor */
+	CKernelMatrixOperator();
+
+	/**
+	 * constructor
+	 *
+	 * @param kernel the (initialized) kernel
+	 * @param scale the scale \f$s\f$ of the kernel matrix
+	 * @param ridge the ridge \f$r\f$ added to the diagonal
+	 */
+	CKernelMatrixOperator(CKernel* kernel, float64_t scale=1.0,
+		float64_t ridge=0.0);
+
+	/** destructor */
+	virtual ~CKernelMatrixOperator();
+
+	/**
+	 * method that applies the kernel matrix operator to a vector
+	 *
+	 * @param b the vector to which the linear operator applies
+	 * @return the result vector \f$(sK+rI)b\f$
+	 */
+	virtual SGVector<float64_t> apply(SGVector<float64_t> b) const;
+
+	/** @return the kernel */
+	CKernel* get_kernel();
+
+	/** @return the scale of the kernel matrix */
+	float64_t get_scale() const
+	{
+		return m_scale;
+	}
+
+	/** @return the ridge added to the diagonal */
+	float64_t get_ridge() const
+	{
+		return m_ridge;
+	}
+
+	/** @return object name */
+	virtual const char* get_name() const
+	{
+		return "KernelMatrixOperator";
+	}
+
+private:
+	/** the kernel */
+	CKernel* m_kernel;
+
+	/** the scale of the kernel matrix */
+	float64_t m_scale;
+
+	/** the ridge added to the diagonal */
+	float64_t m_ridge;
+
+	/** initialize with default values and register params */
+	void init();
+};
+
+}
+
+#endif // KERNEL_MATRIX_OPERATOR_H_
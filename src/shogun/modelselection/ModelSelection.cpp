@@ -10,11 +10,47 @@
 
 #include <shogun/modelselection/ModelSelection.h>
 #include <shogun/modelselection/ModelSelectionParameters.h>
+#include <shogun/modelselection/ParameterCombination.h>
 #include <shogun/evaluation/CrossValidation.h>
+#include <shogun/machine/Machine.h>
 #include <shogun/base/Parameter.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/base/DynArray.h>
+#include <shogun/lib/Lock.h>
 
 using namespace shogun;
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/** parameters of a thread evaluating groups of combinations */
+struct MODELSELECTION_THREAD_PARAM
+{
+	/** combinations to evaluate */
+	CDynamicObjectArray* combinations;
+	/** indices of the combinations, ordered by group */
+	index_t* order;
+	/** offsets of the groups in order, one more than number of groups */
+	index_t* group_offsets;
+	/** machine that is configured and cloned for every group */
+	CMachine* machine;
+	/** cross-validation that is duplicated for every group */
+	CCrossValidation* machine_eval;
+	/** protects machine and best_mean */
+	CLock* lock;
+	/** best mean so far */
+	float64_t best_mean;
+	/** evaluation direction */
+	EEvaluationDirection direction;
+	/** whether evaluations are abandoned early */
+	bool early_abandoning;
+	/** best possible result of a single fold */
+	float64_t fold_result_bound;
+	/** results of all combinations */
+	CCrossValidationResult** results;
+	/** whether a group could not be evaluated, set under lock */
+	bool failed;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 CModelSelection::CModelSelection()
 {
 	init();
@@ -36,12 +72,24 @@ void CModelSelection::init()
 {
 	m_model_parameters=NULL;
 	m_machine_eval=NULL;
+	m_parallel_combinations=false;
+	m_early_abandoning=false;
+	m_fold_result_bound=0;
 
 	SG_ADD((CSGObject**)&m_model_parameters, "model_parameters",
 			"Parameter tree for model selection", MS_NOT_AVAILABLE);
 
 	SG_ADD((CSGObject**)&m_machine_eval, "machine_evaluation",
 			"Machine evaluation strategy", MS_NOT_AVAILABLE);
+
+	SG_ADD(&m_parallel_combinations, "parallel_combinations", "Whether "
+			"combinations are evaluated concurrently", MS_NOT_AVAILABLE);
+
+	SG_ADD(&m_early_abandoning, "early_abandoning", "Whether evaluations "
+			"are abandoned early", MS_NOT_AVAILABLE);
+
+	SG_ADD(&m_fold_result_bound, "fold_result_bound", "Best possible "
+			"result of a single fold", MS_NOT_AVAILABLE);
 }
 
 CModelSelection::~CModelSelection()
@@ -49,3 +97,327 @@ CModelSelection::~CModelSelection()
 	SG_UNREF(m_model_parameters);
 	SG_UNREF(m_machine_eval);
 }
+
+void CModelSelection::set_parallel_combinations(bool parallel_combinations)
+{
+	m_parallel_combinations=parallel_combinations;
+}
+
+void CModelSelection::set_early_abandoning(bool early_abandoning,
+		float64_t fold_result_bound)
+{
+	m_early_abandoning=early_abandoning;
+	m_fold_result_bound=fold_result_bound;
+}
+
+CParameterCombination* CModelSelection::select_best_combination(
+		CDynamicObjectArray* combinations, bool print_state)
+{
+	EEvaluationDirection direction=m_machine_eval->get_evaluation_direction();
+
+	CCrossValidationResult* best_result=new CCrossValidationResult();
+
+	CParameterCombination* best_combination=NULL;
+	if (direction==ED_MAXIMIZE)
+	{
+		if (print_state) SG_PRINT("Direction is maximize\n")
+		best_result->mean=CMath::ALMOST_NEG_INFTY;
+	}
+	else
+	{
+		if (print_state) SG_PRINT("Direction is minimize\n")
+		best_result->mean=CMath::ALMOST_INFTY;
+	}
+
+	/* early abandoning is done by the cross-validation */
+	CCrossValidation* xval=dynamic_cast<CCrossValidation*>(m_machine_eval);
+	if (m_early_abandoning && !xval)
+	{
+		SG_WARNING("Early abandoning requires a CCrossValidation, "
+				"evaluating all folds\n");
+	}
+
+	/* evaluate concurrently if possible */
+	CCrossValidationResult** results=NULL;
+	if (m_parallel_combinations && parallel->get_num_threads()>1)
+	{
+		results=evaluate_parallel(combinations);
+		if (!results)
+		{
+			SG_WARNING("Combinations cannot be evaluated concurrently, "
+					"evaluating them serially\n");
+		}
+	}
+
+	/* underlying learning machine */
+	CMachine* machine=m_machine_eval->get_machine();
+
+	/* apply all combinations and search for best one */
+	for (index_t i=0; i<combinations->get_num_elements(); ++i)
+	{
+		CParameterCombination* current_combination=(CParameterCombination*)
+				combinations->get_element(i);
+
+		/* eventually print */
+		if (print_state)
+		{
+			SG_PRINT("trying combination:\n")
+			current_combination->print_tree();
+		}
+
+		CCrossValidationResult* result=NULL;
+		if (results)
+			result=results[i];
+		else
+		{
+			current_combination->apply_to_modsel_parameter(
+					machine->m_model_selection_parameters);
+
+			/* skip remaining folds if they cannot beat the best result */
+			if (m_early_abandoning && xval)
+			{
+				xval->set_abandon_threshold(best_result->mean,
+						m_fold_result_bound);
+			}
+
+			/* note that this may implicitly lock and unlockthe machine */
+			result=(CCrossValidationResult*)(m_machine_eval->evaluate());
+		}
+
+		if (result->get_result_type() != CROSSVALIDATION_RESULT)
+			SG_ERROR("Evaluation result is not of type CCrossValidationResult!")
+
+		if (print_state)
+			result->print_result();
+
+		/* check if current result is better, delete old combinations */
+		if ((direction==ED_MAXIMIZE && result->mean>best_result->mean) ||
+				(direction==ED_MINIMIZE && result->mean<best_result->mean))
+		{
+			SG_UNREF(best_combination);
+			best_combination=current_combination;
+			SG_REF(best_combination);
+
+			SG_REF(result);
+			SG_UNREF(best_result);
+			best_result=result;
+		}
+
+		SG_UNREF(result);
+		SG_UNREF(current_combination);
+	}
+
+	if (m_early_abandoning && xval)
+		xval->unset_abandon_threshold();
+
+	SG_FREE(results);
+	SG_UNREF(best_result);
+	SG_UNREF(machine);
+
+	return best_combination;
+}
+
+CCrossValidationResult** CModelSelection::evaluate_parallel(
+		CDynamicObjectArray* combinations)
+{
+	SG_DEBUG("entering %s::evaluate_parallel()\n", get_name())
+
+	CCrossValidation* xval=dynamic_cast<CCrossValidation*>(m_machine_eval);
+	if (!xval)
+		return NULL;
+
+	CMachine* machine=m_machine_eval->get_machine();
+
+	/* locked machines share precomputed data which is not cloned, make
+	 * sure the machine and the cross-validation can be copied */
+	CCrossValidation* test_xval=NULL;
+	if (!machine->is_data_locked())
+	{
+		CMachine* test_clone=(CMachine*) machine->clone();
+		if (test_clone)
+			test_xval=xval->duplicate(test_clone);
+		SG_UNREF(test_clone);
+	}
+
+	if (!test_xval)
+	{
+		SG_UNREF(machine);
+		return NULL;
+	}
+	SG_UNREF(test_xval);
+
+	/* group combinations that only differ in values of the machine's own
+	 * parameters, their evaluations can share e.g. a kernel matrix */
+	index_t num_combinations=combinations->get_num_elements();
+	SGVector<index_t> group(num_combinations);
+	DynArray<index_t> representatives;
+	for (index_t i=0; i<num_combinations; i++)
+	{
+		CParameterCombination* combination=(CParameterCombination*)
+				combinations->get_element(i);
+
+		group[i]=-1;
+		for (index_t g=0; g<representatives.get_num_elements() && group[i]<0; g++)
+		{
+			CParameterCombination* representative=(CParameterCombination*)
+					combinations->get_element(representatives[g]);
+			if (combination->differs_only_in_values(representative))
+				group[i]=g;
+			SG_UNREF(representative);
+		}
+
+		if (group[i]<0)
+		{
+			group[i]=representatives.get_num_elements();
+			representatives.append_element(i);
+		}
+
+		SG_UNREF(combination);
+	}
+
+	/* order combinations by group, keeping their order within groups */
+	DynArray<index_t> order(num_combinations);
+	DynArray<index_t> group_offsets;
+	for (index_t g=0; g<representatives.get_num_elements(); g++)
+	{
+		group_offsets.append_element(order.get_num_elements());
+		for (index_t i=0; i<num_combinations; i++)
+		{
+			if (group[i]==g)
+				order.append_element(i);
+		}
+	}
+	group_offsets.append_element(num_combinations);
+
+	/* split largest groups until every thread has some work */
+	int32_t num_threads=parallel->get_num_threads();
+	while (group_offsets.get_num_elements()-1<num_threads)
+	{
+		index_t largest=0;
+		for (index_t g=1; g<group_offsets.get_num_elements()-1; g++)
+		{
+			if (group_offsets[g+1]-group_offsets[g]>
+					group_offsets[largest+1]-group_offsets[largest])
+				largest=g;
+		}
+
+		index_t size=group_offsets[largest+1]-group_offsets[largest];
+		if (size<2)
+			break;
+
+		group_offsets.insert_element(group_offsets[largest]+size/2, largest+1);
+	}
+
+	index_t num_groups=group_offsets.get_num_elements()-1;
+	SG_DEBUG("evaluating %d combinations in %d groups\n", num_combinations,
+			num_groups)
+
+	CLock lock;
+	MODELSELECTION_THREAD_PARAM params;
+	params.combinations=combinations;
+	params.order=order.get_array();
+	params.group_offsets=group_offsets.get_array();
+	params.machine=machine;
+	params.machine_eval=xval;
+	params.lock=&lock;
+	params.direction=m_machine_eval->get_evaluation_direction();
+	params.best_mean=params.direction==ED_MAXIMIZE ?
+			CMath::ALMOST_NEG_INFTY : CMath::ALMOST_INFTY;
+	params.early_abandoning=m_early_abandoning;
+	params.fold_result_bound=m_fold_result_bound;
+	params.results=SG_CALLOC(CCrossValidationResult*, num_combinations);
+	params.failed=false;
+
+	parallel->parallel_for(0, num_groups, evaluate_groups_helper, &params, 1);
+
+	SG_UNREF(machine);
+
+	/* errors are raised here rather than in the threads */
+	if (params.failed)
+	{
+		for (index_t i=0; i<num_combinations; i++)
+			SG_UNREF(params.results[i]);
+		SG_FREE(params.results);
+
+		SG_ERROR("Machine could not be cloned\n")
+	}
+
+	SG_DEBUG("leaving %s::evaluate_parallel()\n", get_name())
+	return params.results;
+}
+
+void CModelSelection::evaluate_groups_helper(int32_t start, int32_t end,
+		int32_t thread, void* p)
+{
+	MODELSELECTION_THREAD_PARAM* params=(MODELSELECTION_THREAD_PARAM*) p;
+
+	for (int32_t g=start; g<end; g++)
+	{
+		index_t first=params->group_offsets[g];
+		index_t last=params->group_offsets[g+1];
+
+		/* configure the shared machine with the group's CSGObjects (and
+		 * their parameters) and clone it */
+		params->lock->lock();
+		CParameterCombination* combination=(CParameterCombination*)
+				params->combinations->get_element(params->order[first]);
+		combination->apply_to_modsel_parameter(
+				params->machine->m_model_selection_parameters);
+		SG_UNREF(combination);
+
+		CMachine* machine=(CMachine*) params->machine->clone();
+		CCrossValidation* xval=machine ?
+				params->machine_eval->duplicate(machine) : NULL;
+		SG_REF(xval);
+		if (!xval)
+			params->failed=true;
+		params->lock->unlock();
+
+		if (!xval)
+		{
+			SG_UNREF(machine);
+			continue;
+		}
+
+		/* precompute data once for the whole group */
+		bool locked=xval->lock_machine();
+
+		for (index_t i=first; i<last; i++)
+		{
+			index_t idx=params->order[i];
+			combination=(CParameterCombination*)
+					params->combinations->get_element(idx);
+			combination->apply_values_to_modsel_parameter(
+					machine->m_model_selection_parameters);
+			SG_UNREF(combination);
+
+			if (params->early_abandoning)
+			{
+				params->lock->lock();
+				float64_t best_mean=params->best_mean;
+				params->lock->unlock();
+
+				xval->set_abandon_threshold(best_mean,
+						params->fold_result_bound);
+			}
+
+			CCrossValidationResult* result=(CCrossValidationResult*)
+					xval->evaluate();
+			params->results[idx]=result;
+
+			params->lock->lock();
+			if ((params->direction==ED_MAXIMIZE &&
+					result->mean>params->best_mean) ||
+					(params->direction==ED_MINIMIZE &&
+					result->mean<params->best_mean))
+				params->best_mean=result->mean;
+			params->lock->unlock();
+		}
+
+		if (locked)
+			machine->data_unlock();
+
+		SG_UNREF(xval);
+		SG_UNREF(machine);
+	}
+}
@@ -18,6 +18,8 @@ namespace shogun
 {
 class CModelSelectionParameters;
 class CParameterCombination;
+class CCrossValidationResult;
+class CDynamicObjectArray;
 
 /** @brief Abstract base class for model selection.
  *
@@ -25,6 +27,10 @@ class CParameterCombination;
  * cross-validation instance and searches for the best combination of parameters
  * in the abstract method select_model(), which has to be implemented in
  * concrete sub-classes.
+ *
+ * Combinations can be evaluated concurrently, see
+ * set_parallel_combinations(), and evaluations that cannot beat the best
+ * combination so far can be abandoned early, see set_early_abandoning().
  */
 class CModelSelection: public CSGObject
 {
@@ -51,6 +57,76 @@ public:
 	 */
 	virtual CParameterCombination* select_model(bool print_state=false)=0;
 
+	/** setter for whether parameter combinations are evaluated
+	 * concurrently, using as many threads as set in the parallel object.
+	 * Requires a CCrossValidation as machine evaluation. Every thread
+	 * evaluates combinations on its own clone of the machine (see
+	 * CSGObject::clone()) and its own copy of the cross-validation (see
+	 * CCrossValidation::duplicate()). Combinations that only differ in the
+	 * machine's own parameters (e.g. C of a SVM, but not the kernel or its
+	 * parameters) are evaluated one after another on the same clone, which
+	 * is kept locked if autolocking is enabled, such that e.g. the kernel
+	 * matrix is only computed once for all of them. Falls back to serial
+	 * evaluation if this is not possible. Output listeners of the
+	 * cross-validation are not called in this case.
+	 *
+	 * @param parallel_combinations whether to evaluate combinations
+	 * concurrently
+	 */
+	void set_parallel_combinations(bool parallel_combinations);
+
+	/** @return whether combinations are evaluated concurrently */
+	bool get_parallel_combinations() const { return m_parallel_combinations; }
+
+	/** setter for early abandoning of combinations. Requires a
+	 * CCrossValidation as machine evaluation, see
+	 * CCrossValidation::set_abandon_threshold(): the remaining folds of a
+	 * combination are skipped once its mean cannot beat the best result so
+	 * far, even if all remaining folds yielded the given bound.
+	 *
+	 * @param early_abandoning whether to abandon evaluations early
+	 * @param fold_result_bound best possible result of a single fold in
+	 * the direction of the evaluation, i.e. the maximum for ED_MAXIMIZE
+	 * (e.g. 1 for accuracy) and the minimum for ED_MINIMIZE (e.g. 0 for
+	 * an error rate)
+	 */
+	void set_early_abandoning(bool early_abandoning,
+			float64_t fold_result_bound);
+
+	/** @return whether evaluations are abandoned early */
+	bool get_early_abandoning() const { return m_early_abandoning; }
+
+protected:
+	/** evaluates all given combinations (serially or concurrently) and
+	 * searches for the best one
+	 *
+	 * @param combinations parameter combinations to evaluate
+	 * @param print_state if true, the current combination is printed
+	 * @return best combination of model parameters
+	 */
+	CParameterCombination* select_best_combination(
+			CDynamicObjectArray* combinations, bool print_state);
+
+	/** evaluates all given combinations concurrently, see
+	 * set_parallel_combinations()
+	 *
+	 * @param combinations parameter combinations to evaluate
+	 * @return array with one (referenced) result for each combination, or
+	 * NULL if the combinations cannot be evaluated concurrently
+	 */
+	CCrossValidationResult** evaluate_parallel(
+			CDynamicObjectArray* combinations);
+
+	/** helper to evaluate a range of combination groups in a thread
+	 *
+	 * @param start first group
+	 * @param end one past the last group
+	 * @param thread index of the executing thread
+	 * @param p pointer to the thread parameters
+	 */
+	static void evaluate_groups_helper(int32_t start, int32_t end,
+			int32_t thread, void* p);
+
 private:
 	/** initializer */
 	void init();
@@ -60,6 +136,12 @@ protected:
 	CModelSelectionParameters* m_model_parameters;
 	/** cross validation */
 	CMachineEvaluation* m_machine_eval;
+	/** whether combinations are evaluated concurrently */
+	bool m_parallel_combinations;
+	/** whether evaluations are abandoned early */
+	bool m_early_abandoning;
+	/** best possible result of a single fold */
+	float64_t m_fold_result_bound;
 };
 }
 #endif /* __MODELSELECTION_H_ */
@@ -754,6 +754,118 @@ void CParameterCombination::apply_to_modsel_parameter(
 		SG_SERROR("CParameterCombination node has illegal type.\n")
 }
 
+void CParameterCombination::apply_values_to_modsel_parameter(
+		Parameter* parameter) const
+{
+	for (index_t i=0; i<m_child_nodes->get_num_elements(); ++i)
+	{
+		CParameterCombination* child=(CParameterCombination*)
+				m_child_nodes->get_element(i);
+
+		if (child->is_value_node())
+			parameter->set_from_parameters(child->m_param);
+
+		SG_UNREF(child);
+	}
+}
+
+bool CParameterCombination::differs_only_in_values(
+		CParameterCombination* other)
+{
+	if (m_child_nodes->get_num_elements()!=
+			other->m_child_nodes->get_num_elements())
+		return false;
+
+	bool result=true;
+	for (index_t i=0; i<m_child_nodes->get_num_elements() && result; ++i)
+	{
+		CParameterCombination* child=(CParameterCombination*)
+				m_child_nodes->get_element(i);
+		CParameterCombination* other_child=(CParameterCombination*)
+				other->m_child_nodes->get_element(i);
+
+		/* values may differ, but they have to belong to the same parameters */
+		if (child->is_value_node() && other_child->is_value_node())
+		{
+			index_t num_params=child->m_param->get_num_parameters();
+			result=num_params==other_child->m_param->get_num_parameters();
+			for (index_t j=0; j<num_params && result; ++j)
+			{
+				result=!strcmp(child->m_param->get_parameter(j)->m_name,
+						other_child->m_param->get_parameter(j)->m_name);
+			}
+		}
+		else
+			result=child->equals_tree(other_child);
+
+		SG_UNREF(child);
+		SG_UNREF(other_child);
+	}
+
+	return result;
+}
+
+bool CParameterCombination::is_value_node() const
+{
+	if (!m_param || has_children())
+		return false;
+
+	for (index_t i=0; i<m_param->get_num_parameters(); ++i)
+	{
+		if (m_param->get_parameter(i)->m_datatype.m_ptype==PT_SGOBJECT)
+			return false;
+	}
+
+	return true;
+}
+
+bool CParameterCombination::equals_tree(CParameterCombination* other)
+{
+	if ((m_param==NULL)!=(other->m_param==NULL))
+		return false;
+
+	if (m_param)
+	{
+		if (m_param->get_num_parameters()!=other->m_param->get_num_parameters())
+			return false;
+
+		for (index_t i=0; i<m_param->get_num_parameters(); ++i)
+		{
+			TParameter* param=m_param->get_parameter(i);
+			TParameter* other_param=other->m_param->get_parameter(i);
+
+			/* objects of a combination are only compared by identity */
+			if (param->m_datatype.m_ptype==PT_SGOBJECT)
+			{
+				if (strcmp(param->m_name, other_param->m_name) ||
+						*((CSGObject**)param->m_parameter)!=
+						*((CSGObject**)other_param->m_parameter))
+					return false;
+			}
+			else if (!param->equals(other_param))
+				return false;
+		}
+	}
+
+	if (m_child_nodes->get_num_elements()!=
+			other->m_child_nodes->get_num_elements())
+		return false;
+
+	bool result=true;
+	for (index_t i=0; i<m_child_nodes->get_num_elements() && result; ++i)
+	{
+		CParameterCombination* child=(CParameterCombination*)
+				m_child_nodes->get_element(i);
+		CParameterCombination* other_child=(CParameterCombination*)
+				other->m_child_nodes->get_element(i);
+		result=child->equals_tree(other_child);
+		SG_UNREF(child);
+		SG_UNREF(other_child);
+	}
+
+	return result;
+}
+
 void CParameterCombination::build_parameter_values_map(
 		CMap<TParameter*, SGVector<float64_t> >* dict)
 {
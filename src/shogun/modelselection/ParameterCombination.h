@@ -90,6 +90,26 @@ public:
 	 */
 	void apply_to_machine(CMachine* machine) const;
 
+	/** applies only the value parameters on the root level of this tree
+	 * (i.e. parameters of the machine itself that are no CSGObjects, such
+	 * as the C of a SVM) to a parameter instance, see
+	 * differs_only_in_values()
+	 *
+	 * @param parameter Parameter instance to apply values to
+	 */
+	void apply_values_to_modsel_parameter(Parameter* parameter) const;
+
+	/** checks whether another combination of the same parameter tree only
+	 * differs from this one in the value parameters on the root level, but
+	 * not in the CSGObjects (e.g. the kernel) or their parameters. Machines
+	 * configured with such combinations may share precomputed data, such
+	 * as a kernel matrix.
+	 *
+	 * @param other combination to compare with
+	 * @return whether both combinations only differ in root level values
+	 */
+	bool differs_only_in_values(CParameterCombination* other);
+
 	/** appends a child to this node
 	 *
 	 * @param child child to append
@@ -298,6 +318,18 @@ protected:
 	 */
 	bool set_parameter_helper(const char* name, float64_t value, index_t index);
 
+	/** @return whether this is a parameter node without children whose
+	 * parameters are no CSGObjects */
+	bool is_value_node() const;
+
+	/** checks whether the tree of this node equals another one, where
+	 * CSGObject parameters are compared by identity
+	 *
+	 * @param other root of other tree
+	 * @return whether both trees are equal
+	 */
+	bool equals_tree(CParameterCombination* other);
+
 private:
 	void init();
 
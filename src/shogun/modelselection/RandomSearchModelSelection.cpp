@@ -49,101 +49,17 @@ CParameterCombination* CRandomSearchModelSelection::select_model(bool print_stat
 	CDynamicObjectArray* combinations=new CDynamicObjectArray();
 
 	for (int32_t i=0; i<combinations_indices.vlen; i++)
-		combinations->append_element(all_combinations->get_element(i));
-
-	CCrossValidationResult* best_result=new CCrossValidationResult();
-
-	CParameterCombination* best_combination=NULL;
-	if (m_machine_eval->get_evaluation_direction()==ED_MAXIMIZE)
 	{
-		if (print_state) SG_PRINT("Direction is maximize\n")
-		best_result->mean=CMath::ALMOST_NEG_INFTY;
+		CSGObject* combination=all_combinations->get_element(
+				combinations_indices[i]);
+		combinations->append_element(combination);
+		SG_UNREF(combination);
 	}
-	else
-	{
-		if (print_state) SG_PRINT("Direction is minimize\n")
-		best_result->mean=CMath::ALMOST_INFTY;
-	}
-
-	/* underlying learning machine */
-	CMachine* machine=m_machine_eval->get_machine();
-
-	/* apply all combinations and search for best one */
-	for (index_t i=0; i<combinations->get_num_elements(); ++i)
-	{
-		CParameterCombination* current_combination=(CParameterCombination*)
-				combinations->get_element(i);
-
-		/* eventually print */
-		if (print_state)
-		{
-			SG_PRINT("trying combination:\n")
-			current_combination->print_tree();
-		}
-
-		current_combination->apply_to_modsel_parameter(
-				machine->m_model_selection_parameters);
+	SG_UNREF(all_combinations);
 
-		/* note that this may implicitly lock and unlockthe machine */
-		CCrossValidationResult* result =
-				(CCrossValidationResult*)(m_machine_eval->evaluate());
-
-		if (result->get_result_type() != CROSSVALIDATION_RESULT)
-			SG_ERROR("Evaluation result is not of type CCrossValidationResult!")
-
-		if (print_state)
-			result->print_result();
-
-		/* check if current result is better, delete old combinations */
-		if (m_machine_eval->get_evaluation_direction()==ED_MAXIMIZE)
-		{
-			if (result->mean>best_result->mean)
-			{
-				if (best_combination)
-					SG_UNREF(best_combination);
-
-				best_combination=(CParameterCombination*)
-						combinations->get_element(i);
-
-				SG_REF(result);
-				SG_UNREF(best_result);
-				best_result=result;
-			}
-			else
-			{
-				CParameterCombination* combination=(CParameterCombination*)
-						combinations->get_element(i);
-				SG_UNREF(combination);
-			}
-		}
-		else
-		{
-			if (result->mean<best_result->mean)
-			{
-				if (best_combination)
-					SG_UNREF(best_combination);
-
-				best_combination=(CParameterCombination*)
-						combinations->get_element(i);
-
-				SG_REF(result);
-				SG_UNREF(best_result);
-				best_result=result;
-			}
-			else
-			{
-				CParameterCombination* combination=(CParameterCombination*)
-						combinations->get_element(i);
-				SG_UNREF(combination);
-			}
-		}
-
-		SG_UNREF(result);
-		SG_UNREF(current_combination);
-	}
+	CParameterCombination* best_combination=select_best_combination(
+			combinations, print_state);
 
-	SG_UNREF(best_result);
-	SG_UNREF(machine);
 	SG_UNREF(combinations);
 
 	return best_combination;
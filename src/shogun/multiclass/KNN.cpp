@@ -17,6 +17,7 @@
 #include <shogun/mathematics/Math.h>
 #include <shogun/lib/Signal.h>
 #include <shogun/lib/JLCoverTree.h>
+#include <shogun/features/DenseFeatures.h>
 #include <shogun/lib/Time.h>
 #include <shogun/base/Parameter.h>
 
@@ -56,6 +57,7 @@ void CKNN::init()
 	m_q=1.0;
 	m_use_covertree=false;
 	m_num_classes=0;
+	m_index=NULL;
 
 	/* use the method classify_multiply_k to experiment with different values
 	 * of k */
@@ -63,10 +65,40 @@ void CKNN::init()
 	SG_ADD(&m_q, "m_q", "Parameter q", MS_AVAILABLE);
 	SG_ADD(&m_use_covertree, "m_use_covertree", "Parameter use_covertree", MS_NOT_AVAILABLE);
 	SG_ADD(&m_num_classes, "m_num_classes", "Number of classes", MS_NOT_AVAILABLE);
+	SG_ADD((CSGObject**) &m_index, "m_index", "Index of training examples", MS_NOT_AVAILABLE);
 }
 
 CKNN::~CKNN()
 {
+	SG_UNREF(m_index);
+}
+
+void CKNN::set_neighbor_index(CNeighborIndex* index)
+{
+	SG_REF(index);
+	SG_UNREF(m_index);
+	m_index=index;
+}
+
+CNeighborIndex* CKNN::get_neighbor_index()
+{
+	SG_REF(m_index);
+	return m_index;
+}
+
+void CKNN::build_neighbor_index()
+{
+	REQUIRE(distance->get_distance_type()==D_EUCLIDEAN, "%s requires a "
+			"euclidean distance, %s given!\n", m_index->get_name(),
+			distance->get_name())
+
+	CFeatures* lhs=distance->get_lhs();
+	REQUIRE(lhs && lhs->get_feature_class()==C_DENSE &&
+			lhs->get_feature_type()==F_DREAL, "%s requires dense real valued "
+			"features!\n", m_index->get_name())
+
+	m_index->build((CDenseFeatures<float64_t>*) lhs);
+	SG_UNREF(lhs);
 }
 
 bool CKNN::train_machine(CFeatures* data)
@@ -100,6 +132,9 @@ bool CKNN::train_machine(CFeatures* data)
 	m_min_label=min_class;
 	m_num_classes=max_class-min_class+1;
 
+	if (m_index)
+		build_neighbor_index();
+
 	SG_INFO("m_num_classes: %d (%+d to %+d) num_train: %d\n", m_num_classes,
 			min_class, max_class, m_train_labels.vlen);
 
@@ -108,40 +143,67 @@ bool CKNN::train_machine(CFeatures* data)
 
 SGMatrix<index_t> CKNN::nearest_neighbors()
 {
+	if (m_index)
+	{
+		/* built on training, only if the index was set afterwards here */
+		if (!m_index->is_built())
+			build_neighbor_index();
+
+		CFeatures* rhs=distance->get_rhs();
+		REQUIRE(rhs && rhs->get_feature_class()==C_DENSE &&
+				rhs->get_feature_type()==F_DREAL, "%s requires dense real "
+				"valued features!\n", m_index->get_name())
+
+		SGMatrix<index_t> NN=m_index->query((CDenseFeatures<float64_t>*) rhs,
+				m_k);
+		SG_UNREF(rhs);
+		return NN;
+	}
+
 	//number of examples to which kNN is applied
 	int32_t n=distance->get_num_vec_rhs();
-	//distances to train data
-	float64_t* dists=SG_MALLOC(float64_t, m_train_labels.vlen);
+	int32_t num_train=m_train_labels.vlen;
+	//number of test examples whose distances are computed at once
+	int32_t batch=get_query_batch_size(num_train, n);
+	//distances to train data, one column per test example of the batch
+	float64_t* dists=SG_MALLOC(float64_t, int64_t(num_train)*batch);
 	//indices to train data
-	index_t* train_idxs=SG_MALLOC(index_t, m_train_labels.vlen);
+	index_t* train_idxs=SG_MALLOC(index_t, num_train);
 	//pre-allocation of the nearest neighbors
 	SGMatrix<index_t> NN(m_k, n);
 
-	//for each test example
-	for (int32_t i=0; i<n && (!CSignal::cancel_computations()); i++)
+	//for each batch of test examples
+	for (int32_t b=0; b<n && (!CSignal::cancel_computations()); b+=batch)
 	{
-		SG_PROGRESS(i, 0, n)
+		SG_PROGRESS(b, 0, n)
+
+		int32_t num_batch=CMath::min(batch, n-b);
 
-		//lhs idx 0..num train examples-1 (i.e., all train examples) and rhs idx i
-		distances_lhs(dists,0,m_train_labels.vlen-1,i);
+		//lhs idx 0..num train examples-1 (i.e., all train examples) and rhs idx b..b+num_batch-1
+		distance->distance_block(dists, 0, num_train, b, num_batch);
+
+		for (int32_t i=0; i<num_batch; i++)
+		{
+			float64_t* col=&dists[int64_t(i)*num_train];
 
-		//fill in an array with 0..num train examples-1
-		for (int32_t j=0; j<m_train_labels.vlen; j++)
-			train_idxs[j]=j;
+			//fill in an array with 0..num train examples-1
+			for (int32_t j=0; j<num_train; j++)
+				train_idxs[j]=j;
 
-		//sort the distance vector between test example i and all train examples
-		CMath::qsort_index(dists, train_idxs, m_train_labels.vlen);
+			//sort the distance vector between test example b+i and all train examples
+			CMath::qsort_index(col, train_idxs, num_train);
 
 #ifdef DEBUG_KNN
-		SG_PRINT("\nQuick sort query %d\n", i)
-		for (int32_t j=0; j<m_k; j++)
-			SG_PRINT("%d ", train_idxs[j])
-		SG_PRINT("\n")
+			SG_PRINT("\nQuick sort query %d\n", b+i)
+			for (int32_t j=0; j<m_k; j++)
+				SG_PRINT("%d ", train_idxs[j])
+			SG_PRINT("\n")
 #endif
 
-		//fill in the output the indices of the nearest neighbors
-		for (int32_t j=0; j<m_k; j++)
-			NN(j,i) = train_idxs[j];
+			//fill in the output the indices of the nearest neighbors
+			for (int32_t j=0; j<m_k; j++)
+				NN(j,b+i) = train_idxs[j];
+		}
 	}
 
 	SG_FREE(train_idxs);
@@ -150,13 +212,20 @@ SGMatrix<index_t> CKNN::nearest_neighbors()
 	return NN;
 }
 
+int32_t CKNN::get_query_batch_size(int32_t num_train, int32_t num_query)
+{
+	/* bound the distance buffer to KNN_BATCH_ELEMENTS entries */
+	int32_t batch=KNN_BATCH_ELEMENTS/CMath::max(1, num_train);
+	return CMath::max(1, CMath::min(batch, num_query));
+}
+
 CMulticlassLabels* CKNN::apply_multiclass(CFeatures* data)
 {
 	if (data)
 		init_distance(data);
 
 	//redirecting to fast (without sorting) classify if k==1
-	if (m_k == 1)
+	if (m_k == 1 && !m_index)
 		return classify_NN();
 
 	ASSERT(m_num_classes>0)
@@ -182,7 +251,7 @@ CMulticlassLabels* CKNN::apply_multiclass(CFeatures* data)
 	float64_t tfinish, tparsed, tcreated, tqueried;
 #endif
 
-	if ( ! m_use_covertree )
+	if ( ! m_use_covertree || m_index )
 	{
 		//get the k nearest neighbors of each example
 		SGMatrix<index_t> NN = nearest_neighbors();
@@ -294,36 +363,44 @@ CMulticlassLabels* CKNN::classify_NN()
 	ASSERT(num_lab)
 
 	CMulticlassLabels* output = new CMulticlassLabels(num_lab);
-	float64_t* distances = SG_MALLOC(float64_t, m_train_labels.vlen);
+	int32_t num_train=m_train_labels.vlen;
+	int32_t batch=get_query_batch_size(num_train, num_lab);
+	float64_t* distances = SG_MALLOC(float64_t, int64_t(num_train)*batch);
 
 	SG_INFO("%d test examples\n", num_lab)
 	CSignal::clear_cancel();
 
-	// for each test example
-	for (int32_t i=0; i<num_lab && (!CSignal::cancel_computations()); i++)
+	// for each batch of test examples
+	for (int32_t b=0; b<num_lab && (!CSignal::cancel_computations()); b+=batch)
 	{
-		SG_PROGRESS(i,0,num_lab)
+		SG_PROGRESS(b,0,num_lab)
 
-		// get distances from i-th test example to 0..num_m_train_labels-1 train examples
-		distances_lhs(distances,0,m_train_labels.vlen-1,i);
-		int32_t j;
+		int32_t num_batch=CMath::min(batch, num_lab-b);
 
-		// assuming 0th train examples as nearest to i-th test example
-		int32_t out_idx = 0;
-		float64_t min_dist = distances[0];
+		// get distances from test examples b..b+num_batch-1 to 0..num_m_train_labels-1 train examples
+		distance->distance_block(distances, 0, num_train, b, num_batch);
 
-		// searching for nearest neighbor by comparing distances
-		for (j=0; j<m_train_labels.vlen; j++)
+		for (int32_t i=0; i<num_batch; i++)
 		{
-			if (distances[j]<min_dist)
+			float64_t* col=&distances[int64_t(i)*num_train];
+
+			// assuming 0th train examples as nearest to i-th test example
+			int32_t out_idx = 0;
+			float64_t min_dist = col[0];
+
+			// searching for nearest neighbor by comparing distances
+			for (int32_t j=0; j<num_train; j++)
 			{
-				min_dist = distances[j];
-				out_idx = j;
+				if (col[j]<min_dist)
+				{
+					min_dist = col[j];
+					out_idx = j;
+				}
 			}
-		}
 
-		// label i-th test example with label of nearest neighbor with out_idx index
-		output->set_label(i,m_train_labels.vector[out_idx]+m_min_label);
+			// label i-th test example with label of nearest neighbor with out_idx index
+			output->set_label(b+i,m_train_labels.vector[out_idx]+m_min_label);
+		}
 	}
 
 	SG_FREE(distances);
@@ -350,7 +427,7 @@ SGMatrix<int32_t> CKNN::classify_for_multiple_k()
 	SG_INFO("%d test examples\n", num_lab)
 	CSignal::clear_cancel();
 
-	if ( ! m_use_covertree )
+	if ( ! m_use_covertree || m_index )
 	{
 		//get the k nearest neighbors of each example
 		SGMatrix<index_t> NN = nearest_neighbors();
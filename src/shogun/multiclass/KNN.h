@@ -20,12 +20,17 @@
 #include <shogun/features/Features.h>
 #include <shogun/distance/Distance.h>
 #include <shogun/machine/DistanceMachine.h>
+#include <shogun/lib/NeighborIndex.h>
 
 namespace shogun
 {
 
 class CDistanceMachine;
 
+/** maximum number of entries of the buffer holding the distances of a batch of
+ * test examples to all training examples */
+#define KNN_BATCH_ELEMENTS 4194304
+
 /** @brief Class KNN, an implementation of the standard k-nearest neigbor
  * classifier.
  *
@@ -51,6 +56,12 @@ class CDistanceMachine;
  * dramatically with the number of examples. Also note that k-NN is capable of
  * multi-class-classification. And finally, in case of k=1 classification will
  * take less time with an special optimization provided.
+ *
+ * Instead of computing the distances to all training examples, the neighbors
+ * can be found via a CNeighborIndex (exact CKDTreeIndex and CBallTreeIndex or
+ * approximate CHNSWIndex) set with set_neighbor_index(). The index is built
+ * over the training examples when training and reused by every subsequent
+ * apply(), it requires a CEuclideanDistance on CDenseFeatures<float64_t>.
  */
 class CKNN : public CDistanceMachine
 {
@@ -152,7 +163,8 @@ class CKNN : public CDistanceMachine
 		 */
 		inline float64_t get_q() { return m_q; }
 
-		/** set whether to use cover trees for fast KNN
+		/** set whether to use cover trees for fast KNN, ignored if a
+		 * neighbor index is set
 		 * @param use_covertree
 		 */
 		inline void set_use_covertree(bool use_covertree)
@@ -165,6 +177,19 @@ class CKNN : public CDistanceMachine
 		 */
 		inline bool get_use_covertree() const { return m_use_covertree; }
 
+		/** set index used to find the nearest neighbors, it is (re)built
+		 * over the training examples on training
+		 *
+		 * @param index index, NULL to compute all distances
+		 */
+		void set_neighbor_index(CNeighborIndex* index);
+
+		/** get index used to find the nearest neighbors
+		 *
+		 * @return index, NULL if all distances are computed
+		 */
+		CNeighborIndex* get_neighbor_index();
+
 		/** @return object name */
 		virtual const char* get_name() const { return "KNN"; }
 
@@ -226,6 +251,18 @@ class CKNN : public CDistanceMachine
 		 */
 		void choose_class_for_multiple_k(int32_t* output, int32_t* classes, int32_t* train_lab, int32_t step);
 
+		/** number of test examples whose distances to all training examples
+		 * are computed at once
+		 *
+		 * @param num_train number of training examples
+		 * @param num_query number of test examples
+		 * @return batch size
+		 */
+		static int32_t get_query_batch_size(int32_t num_train, int32_t num_query);
+
+		/** build m_index over the lhs of the distance */
+		void build_neighbor_index();
+
 	protected:
 		/// the k parameter in KNN
 		int32_t m_k;
@@ -244,6 +281,9 @@ class CKNN : public CDistanceMachine
 
 		/** the actual trainlabels */
 		SGVector<int32_t> m_train_labels;
+
+		/** index of the training examples to find nearest neighbors with */
+		CNeighborIndex* m_index;
 };
 
 }
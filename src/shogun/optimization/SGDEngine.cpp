@@ -0,0 +1,658 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2007- Leon Bottou (SVMSGD), 2009 Antoine Bordes (SGD-QN)
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/optimization/SGDEngine.h>
+#include <shogun/base/Parameter.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/lib/Signal.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/loss/HingeLoss.h>
+
+using namespace shogun;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+struct SGD_THREAD_PARAM
+{
+	CDotFeatures* features;
+	float64_t* y;
+	int32_t* idx;
+	int32_t num;
+	float64_t* w;
+	int32_t dim;
+	float64_t* bias;
+	float64_t t;
+	float64_t t_step;
+	CLossFunction* loss;
+	float64_t lambda;
+	int32_t batch_size;
+	int32_t skip;
+	float64_t bscale;
+	bool use_bias;
+	bool use_regularized_bias;
+	bool nested;
+	Parallel* parallel;
+};
+
+struct SGD_DOT_PARAM
+{
+	CDotFeatures* features;
+	int32_t* idx;
+	float64_t* z;
+	float64_t* w;
+	int32_t dim;
+	float64_t bias;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+static void batch_dot_helper(int32_t start, int32_t end, int32_t thread,
+		void* p)
+{
+	SGD_DOT_PARAM* params=(SGD_DOT_PARAM*) p;
+	for (int32_t k=start; k<end; k++)
+	{
+		params->z[k]=params->features->dense_dot(params->idx[k], params->w,
+				params->dim)+params->bias;
+	}
+}
+
+/* products of a batch with w, in parallel unless nested. Unlike
+ * CDotFeatures::dense_dot_range_subset, a pending cancel request is kept */
+static void batch_dot(Parallel* parallel, CDotFeatures* features,
+		int32_t* idx, int32_t num, float64_t* z, float64_t* w, int32_t dim,
+		float64_t bias, bool nested)
+{
+	SGD_DOT_PARAM params;
+	params.features=features;
+	params.idx=idx;
+	params.z=z;
+	params.w=w;
+	params.dim=dim;
+	params.bias=bias;
+
+	if (nested)
+		batch_dot_helper(0, num, 0, &params);
+	else
+		parallel->parallel_for(0, num, batch_dot_helper, &params);
+}
+
+/* one pass over the examples idx in mini-batches */
+static void sgd_pass(SGD_THREAD_PARAM* p)
+{
+	CDotFeatures* features=p->features;
+	float64_t* w=p->w;
+	int32_t dim=p->dim;
+	float64_t lambda=p->lambda;
+	float64_t* z=SG_MALLOC(float64_t, p->batch_size);
+	float64_t* coef=SG_MALLOC(float64_t, p->batch_size);
+	float64_t t=p->t;
+	int32_t count=p->skip;
+
+	for (int32_t s=0; s<p->num && !CSignal::cancel_computations();
+			s+=p->batch_size)
+	{
+		int32_t b=CMath::min(p->batch_size, p->num-s);
+		int32_t* idx=&p->idx[s];
+		float64_t eta=1.0/(lambda*t);
+
+		/* threads working on their own part of the data compute the
+		 * products of a batch themselves */
+		batch_dot(p->parallel, features, idx, b, z, w, dim, *p->bias,
+				p->nested);
+
+		int32_t num_updates=0;
+		float64_t bias_update=0;
+		for (int32_t k=0; k<b; k++)
+		{
+			float64_t y=p->y[idx[k]];
+			float64_t d=p->loss->first_derivative(y*z[k], 1);
+			coef[k]=-eta*d*y;
+			if (d!=0)
+			{
+				num_updates++;
+				bias_update+=coef[k];
+			}
+		}
+
+		if (num_updates)
+		{
+			if (p->nested)
+			{
+				for (int32_t k=0; k<b; k++)
+				{
+					if (coef[k]!=0)
+						features->add_to_dense_vec(coef[k], idx[k], w, dim);
+				}
+			}
+			else
+				features->add_to_dense_vec_range(coef, idx, b, w, dim);
+
+			if (p->use_bias)
+			{
+				if (p->use_regularized_bias)
+					*p->bias*=CMath::pow(1-eta*lambda*p->bscale, num_updates);
+				*p->bias+=bias_update*p->bscale;
+			}
+		}
+
+		for (count-=b; count<=0; count+=p->skip)
+		{
+			float64_t r=1-eta*lambda*p->skip;
+			if (r<0.8)
+				r=CMath::pow(1-eta*lambda, p->skip);
+			SGVector<float64_t>::scale_vector(r, w, dim);
+		}
+
+		t+=b*p->t_step;
+	}
+
+	SG_FREE(z);
+	SG_FREE(coef);
+}
+
+static void sgd_pass_helper(int32_t start, int32_t end, int32_t thread, void* p)
+{
+	SGD_THREAD_PARAM* params=(SGD_THREAD_PARAM*) p;
+	for (int32_t i=start; i<end; i++)
+		sgd_pass(&params[i]);
+}
+
+CSGDEngine::CSGDEngine() : CSGObject()
+{
+	init();
+}
+
+CSGDEngine::~CSGDEngine()
+{
+	SG_UNREF(m_loss);
+}
+
+void CSGDEngine::init()
+{
+	m_loss=new CHingeLoss();
+	SG_REF(m_loss);
+	m_lambda=1e-4;
+	m_epochs=5;
+	m_batch_size=1;
+	m_thread_mode=SGD_SYNCHRONOUS;
+	m_use_bias=true;
+	m_use_regularized_bias=false;
+	m_quasi_newton=false;
+	m_skip=1000;
+	m_bscale=1;
+
+	SG_ADD((CSGObject**) &m_loss, "loss", "Loss function", MS_NOT_AVAILABLE);
+	SG_ADD(&m_lambda, "lambda", "Regularization constant", MS_AVAILABLE);
+	SG_ADD(&m_epochs, "epochs", "Number of epochs", MS_NOT_AVAILABLE);
+	SG_ADD(&m_batch_size, "batch_size", "Mini-batch size", MS_NOT_AVAILABLE);
+	SG_ADD((machine_int_t*) &m_thread_mode, "thread_mode",
+			"How threads share the work", MS_NOT_AVAILABLE);
+	SG_ADD(&m_use_bias, "use_bias", "Indicates if bias is used",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_use_regularized_bias, "use_regularized_bias",
+			"Indicates if bias is regularized", MS_NOT_AVAILABLE);
+	SG_ADD(&m_quasi_newton, "quasi_newton",
+			"Indicates if the SGD-QN rescaling is used", MS_NOT_AVAILABLE);
+	SG_ADD(&m_skip, "skip", "Regularize every skip examples", MS_NOT_AVAILABLE);
+	SG_ADD(&m_bscale, "bscale", "Bias update scale", MS_NOT_AVAILABLE);
+}
+
+void CSGDEngine::set_loss_function(CLossFunction* loss_func)
+{
+	SG_REF(loss_func);
+	SG_UNREF(m_loss);
+	m_loss=loss_func;
+}
+
+void CSGDEngine::set_batch_size(int32_t batch_size)
+{
+	REQUIRE(batch_size>0, "%s::set_batch_size(): batch size has to be "
+			"positive, not %d\n", get_name(), batch_size)
+	m_batch_size=batch_size;
+}
+
+float64_t CSGDEngine::get_initial_t()
+{
+	// Shift t in order to have a
+	// reasonable initial learning rate.
+	// This assumes |x| \approx 1.
+	float64_t maxw=1.0/CMath::sqrt(m_lambda);
+	float64_t typw=CMath::sqrt(maxw);
+	float64_t eta0=typw/CMath::max(1.0, -m_loss->first_derivative(-typw, 1));
+
+	SG_INFO("lambda=%f, epochs=%d, eta0=%f\n", m_lambda, m_epochs, eta0)
+
+	return 1/(eta0*m_lambda);
+}
+
+void CSGDEngine::train(CDotFeatures* features, SGVector<float64_t> labels,
+		SGVector<float64_t>& w, float64_t& bias)
+{
+	REQUIRE(features, "%s::train(): No features given\n", get_name())
+	REQUIRE(m_loss, "%s::train(): No loss function given\n", get_name())
+
+	int32_t num_vec=features->get_num_vectors();
+	int32_t dim=features->get_dim_feature_space();
+	REQUIRE(num_vec>0 && num_vec==labels.vlen, "%s::train(): Number of "
+			"vectors (%d) has to match number of labels (%d)\n", get_name(),
+			num_vec, labels.vlen)
+
+	w=SGVector<float64_t>(dim);
+	w.zero();
+	bias=0;
+
+	calibrate(features);
+
+	SG_INFO("Training on %d vectors\n", num_vec)
+	CSignal::clear_cancel();
+
+	if (m_quasi_newton)
+	{
+		if (m_thread_mode!=SGD_SYNCHRONOUS)
+		{
+			SG_WARNING("%s: the quasi-Newton rescaling is sequential, "
+					"using SGD_SYNCHRONOUS\n", get_name())
+		}
+
+		train_quasi_newton(features, labels, w);
+		return;
+	}
+
+	float64_t t=get_initial_t();
+
+	int32_t num_threads=parallel->get_num_threads();
+	if (m_thread_mode==SGD_SYNCHRONOUS || num_threads<2 ||
+			num_vec<num_threads*m_batch_size)
+	{
+		num_threads=1;
+	}
+
+	/* every thread takes every num_threads-th example, so that its part
+	 * of the data looks like the whole even if it is sorted by class */
+	SGVector<int32_t> idx(num_vec);
+	SGVector<int32_t> offsets(num_threads+1);
+	offsets[0]=0;
+	for (int32_t k=0, i=0; k<num_threads; k++)
+	{
+		for (int32_t j=k; j<num_vec; j+=num_threads)
+			idx[i++]=j;
+		offsets[k+1]=i;
+	}
+
+	SGMatrix<float64_t> thread_w;
+	SGVector<float64_t> thread_bias;
+	if (num_threads>1 && m_thread_mode==SGD_AVERAGING)
+	{
+		thread_w=SGMatrix<float64_t>(dim, num_threads);
+		thread_bias=SGVector<float64_t>(num_threads);
+	}
+
+	SGD_THREAD_PARAM* params=SG_MALLOC(SGD_THREAD_PARAM, num_threads);
+	for (int32_t k=0; k<num_threads; k++)
+	{
+		params[k].features=features;
+		params[k].y=labels.vector;
+		params[k].idx=&idx.vector[offsets[k]];
+		params[k].num=offsets[k+1]-offsets[k];
+		params[k].w=thread_w.matrix ? thread_w.get_column_vector(k) : w.vector;
+		params[k].dim=dim;
+		params[k].bias=thread_bias.vector ? &thread_bias.vector[k] : &bias;
+		params[k].t_step=num_threads;
+		params[k].loss=m_loss;
+		params[k].lambda=m_lambda;
+		params[k].batch_size=m_batch_size;
+		params[k].skip=m_skip;
+		params[k].bscale=m_bscale;
+		params[k].use_bias=m_use_bias;
+		params[k].use_regularized_bias=m_use_regularized_bias;
+		params[k].nested=num_threads>1;
+		params[k].parallel=parallel;
+	}
+
+	for (int32_t e=0; e<m_epochs && !CSignal::cancel_computations(); e++)
+	{
+		for (int32_t k=0; k<num_threads; k++)
+		{
+			params[k].t=t+k;
+			if (thread_w.matrix)
+			{
+				memcpy(params[k].w, w.vector, sizeof(float64_t)*dim);
+				*params[k].bias=bias;
+			}
+		}
+
+		if (num_threads>1)
+		{
+			parallel->parallel_for(0, num_threads, sgd_pass_helper,
+					(void*) params, 1);
+		}
+		else
+			sgd_pass(params);
+
+		if (thread_w.matrix)
+		{
+			w.zero();
+			for (int32_t k=0; k<num_threads; k++)
+				SGVector<float64_t>::add(w.vector, 1.0, w.vector, 1.0/num_threads,
+						params[k].w, dim);
+			bias=SGVector<float64_t>::sum(thread_bias)/num_threads;
+		}
+
+		t+=num_vec;
+	}
+
+	SG_FREE(params);
+
+	float64_t wnorm=SGVector<float64_t>::dot(w.vector, w.vector, w.vlen);
+	SG_INFO("Norm: %.6f, Bias: %.6f\n", wnorm, bias)
+}
+
+void CSGDEngine::train_quasi_newton(CDotFeatures* features,
+		SGVector<float64_t> labels, SGVector<float64_t>& w)
+{
+	int32_t num_vec=features->get_num_vectors();
+	int32_t dim=w.vlen;
+	float64_t lambda=m_lambda;
+	float64_t t=get_initial_t();
+
+	/* diagonal rescaling, its current estimate and gradient buffer */
+	SGVector<float64_t> Bc(dim);
+	SGVector<float64_t> B(dim);
+	SGVector<float64_t> g(dim);
+	SGVector<float64_t> w_1(dim);
+	Bc.set_const(1/lambda);
+
+	SGVector<int32_t> idx(num_vec);
+	idx.range_fill();
+	float64_t* z=SG_MALLOC(float64_t, m_batch_size);
+	float64_t* coef=SG_MALLOC(float64_t, m_batch_size);
+
+	for (int32_t e=0; e<m_epochs && !CSignal::cancel_computations(); e++)
+	{
+		int32_t count=m_skip;
+		bool updateB=false;
+		for (int32_t s=0; s<num_vec && !CSignal::cancel_computations();
+				s+=m_batch_size)
+		{
+			int32_t b=CMath::min(m_batch_size, num_vec-s);
+			int32_t* bidx=&idx.vector[s];
+			float64_t eta=1.0/t;
+
+			batch_dot(parallel, features, bidx, b, z, w.vector, dim, 0, false);
+			bool update=false;
+			for (int32_t k=0; k<b; k++)
+			{
+				float64_t y=labels[bidx[k]];
+				coef[k]=-m_loss->first_derivative(y*z[k], 1)*y;
+				update|=coef[k]!=0;
+			}
+
+			if (!updateB)
+			{
+				for (count-=b; count<=0; count+=m_skip)
+				{
+					for (int32_t j=0; j<dim; j++)
+						w[j]-=m_skip*lambda*eta*Bc[j]*w[j];
+					updateB=true;
+				}
+			}
+			else if (update)
+			{
+				updateB=false;
+				w_1=w.clone();
+			}
+			else
+				updateB=false;
+
+			if (!update)
+			{
+				t+=b;
+				continue;
+			}
+
+			g.zero();
+			features->add_to_dense_vec_range(coef, bidx, b, g.vector, dim);
+			for (int32_t j=0; j<dim; j++)
+				w[j]+=eta*Bc[j]*g[j];
+
+			/* after a regularization step the next batch estimates the
+			 * curvature from the change of its gradient */
+			if (w_1.vector)
+			{
+				batch_dot(parallel, features, bidx, b, z, w.vector, dim, 0,
+						false);
+				bool changed=false;
+				for (int32_t k=0; k<b; k++)
+				{
+					float64_t y=labels[bidx[k]];
+					coef[k]=-m_loss->first_derivative(y*z[k], 1)*y-coef[k];
+					changed|=coef[k]!=0;
+				}
+
+				if (changed)
+				{
+					g.zero();
+					features->add_to_dense_vec_range(coef, bidx, b, g.vector,
+							dim);
+
+					for (int32_t j=0; j<dim; j++)
+					{
+						float64_t diffw=w_1[j]-w[j];
+						if (diffw)
+							B[j]=diffw/(lambda*diffw+g[j]);
+						else
+							B[j]=1/lambda;
+					}
+
+					float64_t c1=t>m_skip ? (t-m_skip)/(t+m_skip) : t/(t+m_skip);
+					float64_t c2=t>m_skip ? 2*m_skip/(t+m_skip) : m_skip/(t+m_skip);
+					for (int32_t j=0; j<dim; j++)
+					{
+						Bc[j]=Bc[j]*c1+B[j]*c2;
+						Bc[j]=CMath::clamp(Bc[j], 1/(100*lambda), 100/lambda);
+					}
+				}
+
+				w_1=SGVector<float64_t>();
+			}
+
+			t+=b;
+		}
+	}
+
+	SG_FREE(z);
+	SG_FREE(coef);
+}
+
+void CSGDEngine::train(CStreamingDotFeatures* features, float32_t*& w,
+		int32_t& w_dim, float32_t& bias)
+{
+	REQUIRE(features, "%s::train(): No features given\n", get_name())
+	REQUIRE(m_loss, "%s::train(): No loss function given\n", get_name())
+	REQUIRE(!m_quasi_newton, "%s::train(): The quasi-Newton rescaling is not "
+			"supported for streaming features\n", get_name())
+
+	bias=0;
+	float64_t t=get_initial_t();
+
+	calibrate(features);
+	if (features->is_seekable())
+		features->reset_stream();
+
+	CSignal::clear_cancel();
+
+	/* gradient of the pending mini-batch */
+	float32_t* g=NULL;
+	int32_t g_dim=0;
+
+	for (int32_t e=0; e<m_epochs && !CSignal::cancel_computations(); e++)
+	{
+		int32_t count=m_skip;
+		int32_t num_batch=0;
+		int32_t num_updates=0;
+		float64_t bias_update=0;
+		float64_t eta=0;
+		bool has_example=features->get_next_example();
+		while (has_example || num_batch)
+		{
+			if (has_example)
+			{
+				// Expand w vector if more features are seen in this example
+				features->expand_if_required(w, w_dim);
+
+				if (!num_batch)
+					eta=1.0/(m_lambda*t);
+
+				float64_t y=features->get_label();
+				float64_t z=y*(features->dense_dot(w, w_dim)+bias);
+				float64_t d=m_loss->first_derivative(z, 1);
+
+				if (d!=0)
+				{
+					float64_t etd=-eta*d;
+					if (m_batch_size==1)
+						features->add_to_dense_vec(etd*y, w, w_dim);
+					else
+					{
+						features->expand_if_required(g, g_dim);
+						features->add_to_dense_vec(etd*y, g, g_dim);
+					}
+
+					num_updates++;
+					bias_update+=etd*y;
+				}
+
+				num_batch++;
+				t++;
+				features->release_example();
+				has_example=features->get_next_example();
+			}
+
+			/* apply the batch once it is full or the stream ended */
+			if (num_batch==m_batch_size || !has_example)
+			{
+				if (g)
+				{
+					for (int32_t j=0; j<g_dim; j++)
+						w[j]+=g[j];
+					memset(g, 0, sizeof(float32_t)*g_dim);
+				}
+
+				if (m_use_bias && num_updates)
+				{
+					if (m_use_regularized_bias)
+						bias*=CMath::pow(1-eta*m_lambda*m_bscale, num_updates);
+					bias+=bias_update*m_bscale;
+				}
+
+				for (count-=num_batch; count<=0; count+=m_skip)
+				{
+					float32_t r=1-eta*m_lambda*m_skip;
+					if (r<0.8)
+						r=CMath::pow(1-eta*m_lambda, m_skip);
+					SGVector<float32_t>::scale_vector(r, w, w_dim);
+				}
+
+				num_batch=0;
+				num_updates=0;
+				bias_update=0;
+			}
+		}
+
+		// If the stream is seekable, reset the stream to the first
+		// example (for epochs > 1)
+		if (features->is_seekable() && e < m_epochs-1)
+			features->reset_stream();
+		else
+			break;
+	}
+
+	SG_FREE(g);
+
+	float64_t wnorm=SGVector<float32_t>::dot(w, w, w_dim);
+	SG_INFO("Norm: %.6f, Bias: %.6f\n", wnorm, bias)
+}
+
+void CSGDEngine::calibrate(CDotFeatures* features)
+{
+	int32_t num_vec=features->get_num_vectors();
+	int32_t c_dim=features->get_dim_feature_space();
+
+	ASSERT(num_vec>0)
+	ASSERT(c_dim>0)
+
+	float64_t* c=SG_CALLOC(float64_t, c_dim);
+
+	SG_INFO("Estimating sparsity and bscale num_vec=%d num_feat=%d.\n", num_vec, c_dim)
+
+	// compute average gradient size
+	int32_t n=0;
+	float64_t m=0;
+	float64_t r=0;
+
+	for (int32_t j=0; j<num_vec && m<=1000; j++, n++)
+	{
+		r+=features->get_nnz_features_for_vector(j);
+		features->add_to_dense_vec(1, j, c, c_dim, true);
+
+		//waste cpu cycles for readability
+		//(only changed dims need checking)
+		m=SGVector<float64_t>::max(c, c_dim);
+	}
+
+	// bias update scaling
+	m_bscale=0.5*m/n;
+
+	// compute weight decay skip
+	m_skip=(int32_t) ((16*n*c_dim)/r);
+	SG_INFO("using %d examples. skip=%d  bscale=%.6f\n", n, m_skip, m_bscale)
+
+	SG_FREE(c);
+}
+
+void CSGDEngine::calibrate(CStreamingDotFeatures* features, int32_t max_vec_num)
+{
+	int32_t c_dim=1;
+	float32_t* c=SG_CALLOC(float32_t, c_dim);
+
+	// compute average gradient size
+	int32_t n=0;
+	float64_t m=0;
+	float64_t r=0;
+
+	while (features->get_next_example())
+	{
+		//Expand c if more features are seen in this example
+		features->expand_if_required(c, c_dim);
+
+		r+=features->get_nnz_features_for_vector();
+		features->add_to_dense_vec(1, c, c_dim, true);
+
+		//waste cpu cycles for readability
+		//(only changed dims need checking)
+		m=SGVector<float32_t>::max(c, c_dim);
+		n++;
+
+		features->release_example();
+		if ((max_vec_num>0 && n>=max_vec_num) || m>1000)
+			break;
+	}
+
+	SG_PRINT("Online SGD calibrated using %d vectors.\n", n)
+
+	// bias update scaling
+	m_bscale=0.5*m/n;
+
+	// compute weight decay skip
+	m_skip=(int32_t) ((16*n*c_dim)/r);
+
+	SG_INFO("using %d examples. skip=%d  bscale=%.6f\n", n, m_skip, m_bscale)
+
+	SG_FREE(c);
+}
@@ -0,0 +1,233 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2007- Leon Bottou (SVMSGD), 2009 Antoine Bordes (SGD-QN)
+ * Written (W) 2026 agent
+ */
+
+#ifndef _SGDENGINE_H___
+#define _SGDENGINE_H___
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/SGObject.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/features/DotFeatures.h>
+#include <shogun/features/streaming/StreamingDotFeatures.h>
+#include <shogun/loss/LossFunction.h>
+
+namespace shogun
+{
+
+/** how the threads share the work in CSGDEngine */
+enum ESGDThreadMode
+{
+	/** a single sequence of mini-batches, the products of each batch are
+	 * computed in parallel */
+	SGD_SYNCHRONOUS=0,
+	/** every thread runs on its own part of the data and updates the
+	 * shared weights without locking (Hogwild) */
+	SGD_HOGWILD=1,
+	/** every thread runs on its own part of the data with private weights,
+	 * which are averaged after each epoch (parameter mixing) */
+	SGD_AVERAGING=2
+};
+
+/** @brief Stochastic gradient descent for linear models with a pluggable
+ * loss, shared by CSVMSGD, CSGDQN and COnlineSVMSGD.
+ *
+ * Minimizes
+ * \f[
+ *	\frac{\lambda}{2}\|{\bf w}\|^2+\frac{1}{N}\sum_{i=1}^N
+ *	L(y_i({\bf w}\cdot{\bf x}_i+b))
+ * \f]
+ * by going through the examples in mini-batches. The outputs of a batch
+ * are computed with one dense_dot_range call and its gradient is added
+ * with one accumulated add_to_dense_vec, so a batch size of 1 is the
+ * classical per example update. The learning rate is
+ * \f$\eta_t=1/(\lambda t)\f$ (Bottou), the regularization is applied every
+ * skip examples.
+ *
+ * Optionally, the update is rescaled by the diagonal quasi-Newton matrix of
+ * SGD-QN (Bordes et al. 2009), which is estimated from the gradient change
+ * after each regularization step.
+ *
+ * For CDotFeatures several threads can be used, see ESGDThreadMode.
+ * Streaming features are always processed in a single sequence.
+ */
+class CSGDEngine : public CSGObject
+{
+	public:
+		/** default constructor */
+		CSGDEngine();
+
+		/** destructor */
+		virtual ~CSGDEngine();
+
+		/** set the loss function
+		 *
+		 * @param loss_func object derived from CLossFunction
+		 */
+		void set_loss_function(CLossFunction* loss_func);
+
+		/** @return the loss function */
+		inline CLossFunction* get_loss_function() { SG_REF(m_loss); return m_loss; }
+
+		/** set regularization constant
+		 *
+		 * @param lambda regularization constant
+		 */
+		inline void set_lambda(float64_t lambda) { m_lambda=lambda; }
+
+		/** @return regularization constant */
+		inline float64_t get_lambda() { return m_lambda; }
+
+		/** set the number of passes over the data
+		 *
+		 * @param epochs number of epochs
+		 */
+		inline void set_epochs(int32_t epochs) { m_epochs=epochs; }
+
+		/** @return the number of epochs */
+		inline int32_t get_epochs() { return m_epochs; }
+
+		/** set the number of examples per update
+		 *
+		 * @param batch_size mini-batch size
+		 */
+		void set_batch_size(int32_t batch_size);
+
+		/** @return mini-batch size */
+		inline int32_t get_batch_size() { return m_batch_size; }
+
+		/** set how the work is shared among the threads
+		 *
+		 * @param mode thread mode
+		 */
+		inline void set_thread_mode(ESGDThreadMode mode) { m_thread_mode=mode; }
+
+		/** @return thread mode */
+		inline ESGDThreadMode get_thread_mode() { return m_thread_mode; }
+
+		/** set if bias shall be enabled
+		 *
+		 * @param enable_bias if bias shall be enabled
+		 */
+		inline void set_bias_enabled(bool enable_bias) { m_use_bias=enable_bias; }
+
+		/** @return if bias is enabled */
+		inline bool get_bias_enabled() { return m_use_bias; }
+
+		/** set if regularized bias shall be enabled
+		 *
+		 * @param enable_bias if regularized bias shall be enabled
+		 */
+		inline void set_regularized_bias_enabled(bool enable_bias) { m_use_regularized_bias=enable_bias; }
+
+		/** @return if regularized bias is enabled */
+		inline bool get_regularized_bias_enabled() { return m_use_regularized_bias; }
+
+		/** set if the SGD-QN diagonal rescaling shall be used, the learning
+		 * rate is then 1/t and no bias is trained. Only supported for
+		 * SGD_SYNCHRONOUS.
+		 *
+		 * @param quasi_newton if diagonal rescaling shall be used
+		 */
+		inline void set_quasi_newton(bool quasi_newton) { m_quasi_newton=quasi_newton; }
+
+		/** @return if the diagonal rescaling is used */
+		inline bool get_quasi_newton() { return m_quasi_newton; }
+
+		/** @return the number of examples after which the weights are
+		 * regularized, as determined by the last calibration */
+		inline int32_t get_skip() { return m_skip; }
+
+		/** @return bias update scale, as determined by the last calibration */
+		inline float64_t get_bscale() { return m_bscale; }
+
+		/** train on features with random access
+		 *
+		 * @param features training features
+		 * @param labels training labels (+1/-1)
+		 * @param w weight vector, set to the solution
+		 * @param bias bias, set to the solution
+		 */
+		void train(CDotFeatures* features, SGVector<float64_t> labels,
+				SGVector<float64_t>& w, float64_t& bias);
+
+		/** train on a stream of labelled examples, the stream has to be
+		 * seekable for more than one epoch. The parser has to be started.
+		 *
+		 * @param features training features
+		 * @param w weight vector, grown as new dimensions are seen
+		 * @param w_dim dimension of w
+		 * @param bias bias, set to the solution
+		 */
+		void train(CStreamingDotFeatures* features, float32_t*& w,
+				int32_t& w_dim, float32_t& bias);
+
+		/** @return object name */
+		virtual const char* get_name() const { return "SGDEngine"; }
+
+	protected:
+		/** estimate skip and bscale from the first vectors
+		 *
+		 * @param features training features
+		 */
+		void calibrate(CDotFeatures* features);
+
+		/** estimate skip and bscale from the first vectors of a stream
+		 *
+		 * @param features training features
+		 * @param max_vec_num maximum number of vectors to use, -1 for all
+		 */
+		void calibrate(CStreamingDotFeatures* features, int32_t max_vec_num=1000);
+
+		/** initial value of t, such that the first learning rate is
+		 * reasonable for |x|~1 */
+		float64_t get_initial_t();
+
+		/** run SGD-QN, the weights are decayed by the scaled weights every
+		 * skip examples, the next batch is used to update the scaling */
+		void train_quasi_newton(CDotFeatures* features, SGVector<float64_t> labels,
+				SGVector<float64_t>& w);
+
+	private:
+		void init();
+
+	protected:
+		/** loss function */
+		CLossFunction* m_loss;
+
+		/** regularization constant */
+		float64_t m_lambda;
+
+		/** number of epochs */
+		int32_t m_epochs;
+
+		/** mini-batch size */
+		int32_t m_batch_size;
+
+		/** thread mode */
+		ESGDThreadMode m_thread_mode;
+
+		/** if bias is used */
+		bool m_use_bias;
+
+		/** if bias is regularized */
+		bool m_use_regularized_bias;
+
+		/** if SGD-QN rescaling is used */
+		bool m_quasi_newton;
+
+		/** regularize every skip examples */
+		int32_t m_skip;
+
+		/** bias update scale */
+		float64_t m_bscale;
+};
+}
+#endif
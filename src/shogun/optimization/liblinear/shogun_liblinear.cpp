@@ -152,13 +152,10 @@ void l2r_lr_fun::XTv(double *v, double *res_XTv)
 	if (m_prob->use_bias)
 		n--;
 
-	for (int32_t i=0;i<l;i++)
-	{
-		m_prob->x->add_to_dense_vec(v[i], i, res_XTv, n);
+	m_prob->x->add_to_dense_vec_range(v, NULL, l, res_XTv, n);
 
-		if (m_prob->use_bias)
-			res_XTv[n]+=v[i];
-	}
+	if (m_prob->use_bias)
+		res_XTv[n]=SGVector<float64_t>::sum(v, l);
 }
 
 l2r_l2_svc_fun::l2r_l2_svc_fun(const liblinear_problem *p, double* Cs)
@@ -290,13 +287,10 @@ void l2r_l2_svc_fun::subXTv(double *v, double *XTv)
 		n--;
 
 	memset(XTv, 0, sizeof(float64_t)*m_prob->n);
-	for (int32_t i=0;i<sizeI;i++)
-	{
-		m_prob->x->add_to_dense_vec(v[i], I[i], XTv, n);
+	m_prob->x->add_to_dense_vec_range(v, I, sizeI, XTv, n);
 
-		if (m_prob->use_bias)
-			XTv[n]+=v[i];
-	}
+	if (m_prob->use_bias)
+		XTv[n]=SGVector<float64_t>::sum(v, sizeI);
 }
 
 l2r_l2_svr_fun::l2r_l2_svr_fun(const liblinear_problem *prob, double *Cs, double p):
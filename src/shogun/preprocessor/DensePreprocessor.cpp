@@ -1,5 +1,7 @@
 #include <shogun/preprocessor/DensePreprocessor.h>
 
+#include <string.h>
+
 namespace shogun
 {
 template <class ST>
@@ -85,6 +87,33 @@ EPreprocessorType CDensePreprocessor<ST>::get_type() const
 	return P_UNKNOWN;
 }
 
+template <class ST>
+int32_t CDensePreprocessor<ST>::apply_to_feature_vector_inplace(ST* vector,
+		int32_t len, int32_t capacity)
+{
+	SGVector<ST> result=apply_to_feature_vector(SGVector<ST>(vector, len, false));
+	if (result.vlen>capacity)
+		return -1;
+
+	if (result.vector!=vector)
+		memcpy(vector, result.vector, sizeof(ST)*result.vlen);
+
+	return result.vlen;
+}
+
+template <class ST>
+int32_t CDensePreprocessor<ST>::apply_to_feature_vector_inplace_sqnorm(
+		ST* vector, int32_t len, int32_t capacity, float64_t& sq_norm)
+{
+	len=apply_to_feature_vector_inplace(vector, len, capacity);
+
+	sq_norm=0;
+	for (int32_t i=0; i<len; i++)
+		sq_norm+=float64_t(vector[i])*vector[i];
+
+	return len;
+}
+
 template class CDensePreprocessor<bool>;
 template class CDensePreprocessor<char>;
 template class CDensePreprocessor<int8_t>;
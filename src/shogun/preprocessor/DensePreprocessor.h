@@ -44,6 +44,38 @@ template <class ST> class CDensePreprocessor : public CPreprocessor
 		/// result in feature matrix
 		virtual SGVector<ST> apply_to_feature_vector(SGVector<ST> vector)=0;
 
+		/** @return whether apply_to_feature_vector_inplace() is implemented
+		 * without allocating memory, so that it can be used on every vector
+		 * of a feature matrix
+		 */
+		virtual bool supports_inplace() { return false; }
+
+		/** apply preproc in place on a single feature vector. The default
+		 * implementation calls apply_to_feature_vector() and copies the
+		 * result back.
+		 *
+		 * @param vector feature vector, overwritten by the result
+		 * @param len length of vector
+		 * @param capacity number of elements vector has room for
+		 * @return length of the result, -1 if it did not fit
+		 */
+		virtual int32_t apply_to_feature_vector_inplace(ST* vector, int32_t len,
+				int32_t capacity);
+
+		/** like apply_to_feature_vector_inplace(), additionally computes the
+		 * squared euclidean norm of the result, such that a following
+		 * CNormOne can be fused into the same pass. The default
+		 * implementation computes the norm in a second pass.
+		 *
+		 * @param vector feature vector, overwritten by the result
+		 * @param len length of vector
+		 * @param capacity number of elements vector has room for
+		 * @param sq_norm squared norm of the result
+		 * @return length of the result, -1 if it did not fit
+		 */
+		virtual int32_t apply_to_feature_vector_inplace_sqnorm(ST* vector,
+				int32_t len, int32_t capacity, float64_t& sq_norm);
+
 		/// return that we are dense features (just fixed size matrices)
 		virtual EFeatureClass get_feature_class();
 		/// return feature type
@@ -0,0 +1,217 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/preprocessor/DensePreprocessorPipeline.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/mathematics/Math.h>
+
+#include <string.h>
+
+namespace shogun
+{
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template <class ST> struct DENSE_PIPELINE_THREAD_PARAM
+{
+	CDensePreprocessorPipeline<ST>* pipeline;
+	ST* matrix;
+	int32_t num_rows;
+	int32_t* lens;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+template <class ST>
+CDensePreprocessorPipeline<ST>::CDensePreprocessorPipeline() : CSGObject()
+{
+	m_sources=NULL;
+	m_num_sources=0;
+	m_steps=NULL;
+	m_normalize=NULL;
+	m_num_steps=0;
+}
+
+template <class ST>
+CDensePreprocessorPipeline<ST>::~CDensePreprocessorPipeline()
+{
+	cleanup();
+}
+
+template <class ST>
+void CDensePreprocessorPipeline<ST>::cleanup()
+{
+	for (int32_t i=0; i<m_num_sources; i++)
+		SG_UNREF(m_sources[i]);
+
+	SG_FREE(m_sources);
+	SG_FREE(m_steps);
+	SG_FREE(m_normalize);
+	m_sources=NULL;
+	m_steps=NULL;
+	m_normalize=NULL;
+	m_num_sources=0;
+	m_num_steps=0;
+}
+
+template <class ST>
+void CDensePreprocessorPipeline<ST>::compile(CFeatures* features,
+		int32_t first, int32_t last)
+{
+	REQUIRE(features && first>=0 && first<=last &&
+			last<=features->get_num_preprocessors(), "%s::compile(): Invalid "
+			"range [%d, %d) of preprocessors\n", get_name(), first, last)
+
+	cleanup();
+
+	m_num_sources=last-first;
+	m_sources=SG_MALLOC(CSGObject*, m_num_sources);
+	m_steps=SG_MALLOC(CDensePreprocessor<ST>*, m_num_sources);
+	m_normalize=SG_MALLOC(bool, m_num_sources);
+
+	for (int32_t i=0; i<m_num_sources; i++)
+	{
+		CDensePreprocessor<ST>* p=
+			(CDensePreprocessor<ST>*) features->get_preprocessor(first+i);
+		m_sources[i]=p;
+
+		/* a CNormOne only rescales by the norm of the previous result */
+		if (m_num_steps && p->get_type()==P_NORMONE &&
+				!m_normalize[m_num_steps-1])
+		{
+			m_normalize[m_num_steps-1]=true;
+			continue;
+		}
+
+		m_steps[m_num_steps]=p;
+		m_normalize[m_num_steps]=false;
+		m_num_steps++;
+	}
+}
+
+template <class ST>
+bool CDensePreprocessorPipeline<ST>::matches(CFeatures* features)
+{
+	if (features->get_num_preprocessors()!=m_num_sources)
+		return false;
+
+	bool match=true;
+	for (int32_t i=0; i<m_num_sources && match; i++)
+	{
+		CPreprocessor* p=features->get_preprocessor(i);
+		match=p==m_sources[i];
+		SG_UNREF(p);
+	}
+
+	return match;
+}
+
+template <class ST>
+int32_t CDensePreprocessorPipeline<ST>::apply_to_feature_vector(ST* vector,
+		int32_t len, int32_t capacity)
+{
+	for (int32_t i=0; i<m_num_steps && len>=0; i++)
+	{
+		if (m_normalize[i])
+		{
+			float64_t sq_norm=0;
+			len=m_steps[i]->apply_to_feature_vector_inplace_sqnorm(vector, len,
+					capacity, sq_norm);
+
+			float64_t norm=CMath::sqrt(sq_norm);
+			for (int32_t j=0; j<len; j++)
+				vector[j]=vector[j]/norm;
+		}
+		else
+			len=m_steps[i]->apply_to_feature_vector_inplace(vector, len, capacity);
+	}
+
+	return len;
+}
+
+template <class ST>
+void CDensePreprocessorPipeline<ST>::apply_to_feature_matrix_helper(
+		int32_t start, int32_t stop, int32_t thread, void* p)
+{
+	DENSE_PIPELINE_THREAD_PARAM<ST>* params=(DENSE_PIPELINE_THREAD_PARAM<ST>*) p;
+	int32_t num_rows=params->num_rows;
+
+	for (int32_t i=start; i<stop; i++)
+	{
+		params->lens[i]=params->pipeline->apply_to_feature_vector(
+				&params->matrix[int64_t(i)*num_rows], num_rows, num_rows);
+	}
+}
+
+template <class ST>
+int32_t CDensePreprocessorPipeline<ST>::apply_to_feature_matrix(ST* matrix,
+		int32_t num_rows, int32_t num_cols)
+{
+	if (!num_cols)
+		return num_rows;
+
+	int32_t* lens=SG_MALLOC(int32_t, num_cols);
+
+	/* the first vector is done here, so that errors of misconfigured
+	 * preprocessors are not raised in a worker thread */
+	lens[0]=apply_to_feature_vector(matrix, num_rows, num_rows);
+	if (lens[0]<0)
+	{
+		SG_FREE(lens);
+		return -1;
+	}
+
+	DENSE_PIPELINE_THREAD_PARAM<ST> params;
+	params.pipeline=this;
+	params.matrix=matrix;
+	params.num_rows=num_rows;
+	params.lens=lens;
+
+	/* blocks of about 16k elements */
+	int32_t block=CMath::max(1, 16384/CMath::max(num_rows, 1));
+	parallel->parallel_for(1, num_cols, apply_to_feature_matrix_helper,
+			(void*) &params, block);
+
+	int32_t new_rows=lens[0];
+	int32_t len=new_rows;
+	for (int32_t i=1; i<num_cols && len==new_rows; i++)
+		len=lens[i];
+	SG_FREE(lens);
+
+	if (len<0)
+		return -1;
+
+	REQUIRE(len==new_rows, "%s::apply_to_feature_matrix(): Vectors were "
+			"preprocessed to different lengths (%d and %d)\n", get_name(),
+			new_rows, len)
+
+	if (new_rows<num_rows)
+	{
+		for (int32_t i=1; i<num_cols; i++)
+		{
+			memmove(&matrix[int64_t(i)*new_rows], &matrix[int64_t(i)*num_rows],
+					sizeof(ST)*new_rows);
+		}
+	}
+
+	return new_rows;
+}
+
+template class CDensePreprocessorPipeline<bool>;
+template class CDensePreprocessorPipeline<char>;
+template class CDensePreprocessorPipeline<int8_t>;
+template class CDensePreprocessorPipeline<uint8_t>;
+template class CDensePreprocessorPipeline<int16_t>;
+template class CDensePreprocessorPipeline<uint16_t>;
+template class CDensePreprocessorPipeline<int32_t>;
+template class CDensePreprocessorPipeline<uint32_t>;
+template class CDensePreprocessorPipeline<int64_t>;
+template class CDensePreprocessorPipeline<uint64_t>;
+template class CDensePreprocessorPipeline<float32_t>;
+template class CDensePreprocessorPipeline<float64_t>;
+template class CDensePreprocessorPipeline<floatmax_t>;
+}
@@ -0,0 +1,115 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#ifndef _DENSEPREPROCESSORPIPELINE__H__
+#define _DENSEPREPROCESSORPIPELINE__H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/SGObject.h>
+#include <shogun/preprocessor/DensePreprocessor.h>
+
+namespace shogun
+{
+template <class ST> class CDensePreprocessor;
+
+/** @brief Compiled sequence of CDensePreprocessor, as used by CDenseFeatures
+ * to preprocess vectors on the fly and to apply chains of preprocessors to
+ * a feature matrix.
+ *
+ * All steps work in place on the vector they are given (see
+ * CDensePreprocessor::apply_to_feature_vector_inplace()), so preprocessors
+ * that support this do not allocate memory per vector. A CNormOne that
+ * follows another preprocessor is fused into it, i.e. the norm is computed
+ * while the previous step writes its result.
+ *
+ * Feature matrices are processed in blocks of vectors in parallel, every
+ * vector goes through all steps while it is in the cache.
+ */
+template <class ST> class CDensePreprocessorPipeline : public CSGObject
+{
+	public:
+		/** default constructor */
+		CDensePreprocessorPipeline();
+
+		/** destructor */
+		virtual ~CDensePreprocessorPipeline();
+
+		/** compile the preprocessors first to last-1 of features
+		 *
+		 * @param features features with CDensePreprocessor attached
+		 * @param first index of first preprocessor
+		 * @param last one past the index of the last preprocessor
+		 */
+		void compile(CFeatures* features, int32_t first, int32_t last);
+
+		/** check if the pipeline was compiled from exactly the preprocessors
+		 * of features
+		 *
+		 * @param features features
+		 * @return whether the pipeline matches the preprocessors
+		 */
+		bool matches(CFeatures* features);
+
+		/** @return number of steps after fusing */
+		inline int32_t get_num_steps() { return m_num_steps; }
+
+		/** apply all steps in place on a single feature vector
+		 *
+		 * @param vector feature vector, overwritten by the result
+		 * @param len length of vector
+		 * @param capacity number of elements vector has room for
+		 * @return length of the result, -1 if it did not fit
+		 */
+		int32_t apply_to_feature_vector(ST* vector, int32_t len, int32_t capacity);
+
+		/** apply all steps in place on every vector of a feature matrix. If
+		 * the vectors get shorter, the matrix is compacted to the new
+		 * number of rows.
+		 *
+		 * @param matrix feature matrix, one vector per column
+		 * @param num_rows number of rows
+		 * @param num_cols number of columns
+		 * @return number of rows of the result, -1 if it did not fit
+		 */
+		int32_t apply_to_feature_matrix(ST* matrix, int32_t num_rows,
+				int32_t num_cols);
+
+		/** @return object name */
+		virtual const char* get_name() const { return "DensePreprocessorPipeline"; }
+
+	protected:
+		/** apply the steps on the columns [start, stop) of a matrix. This
+		 * function is called by Parallel::parallel_for in
+		 * apply_to_feature_matrix */
+		static void apply_to_feature_matrix_helper(int32_t start, int32_t stop,
+				int32_t thread, void* p);
+
+	private:
+		/** unref and free compiled steps */
+		void cleanup();
+
+	protected:
+		/** preprocessors the pipeline was compiled from (referenced) */
+		CSGObject** m_sources;
+
+		/** number of preprocessors the pipeline was compiled from */
+		int32_t m_num_sources;
+
+		/** preprocessors to apply */
+		CDensePreprocessor<ST>** m_steps;
+
+		/** whether a step is followed by a fused CNormOne */
+		bool* m_normalize;
+
+		/** number of steps */
+		int32_t m_num_steps;
+};
+}
+#endif
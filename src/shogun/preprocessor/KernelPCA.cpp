@@ -22,9 +22,52 @@
 #include <shogun/preprocessor/DimensionReductionPreprocessor.h>
 #include <shogun/features/Features.h>
 #include <shogun/io/SGIO.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/features/RandomFourierDotFeatures.h>
+#include <shogun/base/Parallel.h>
 
 using namespace shogun;
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+struct KPCA_FEATURE_MAP_THREAD_PARAM
+{
+	/** kernel initialized with (features, landmarks), used if rff is NULL */
+	CKernel* kernel;
+	/** random features */
+	CDotFeatures* rff;
+	/** first vector of the block */
+	int32_t block_start;
+	/** dimension of the feature map */
+	int32_t dim;
+	/** dim x block size result */
+	float64_t* result;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+static void kpca_feature_map_helper(int32_t start, int32_t end,
+		int32_t thread, void* p)
+{
+	KPCA_FEATURE_MAP_THREAD_PARAM* params=(KPCA_FEATURE_MAP_THREAD_PARAM*) p;
+	int32_t dim=params->dim;
+
+	for (int32_t i=start; i<end; i++)
+	{
+		float64_t* phi=&params->result[int64_t(i)*dim];
+		int32_t idx=params->block_start+i;
+
+		if (params->rff)
+		{
+			memset(phi, 0, sizeof(float64_t)*dim);
+			params->rff->add_to_dense_vec(1.0, idx, phi, dim);
+		}
+		else
+		{
+			for (int32_t j=0; j<dim; j++)
+				phi[j]=params->kernel->kernel(idx, j);
+		}
+	}
+}
+
 CKernelPCA::CKernelPCA() : CDimensionReductionPreprocessor()
 {
 	init();
@@ -42,7 +85,18 @@ void CKernelPCA::init()
 	m_init_features = NULL;
 	m_transformation_matrix = SGMatrix<float64_t>(NULL, 0, 0, false);
 	m_bias_vector = SGVector<float64_t>(NULL, 0, false);
-
+	m_method = KPCA_EXACT;
+	m_num_landmarks = 100;
+	m_num_random_features = 100;
+
+	SG_ADD((machine_int_t*) &m_method, "method",
+      "method used to compute the principal components", MS_NOT_AVAILABLE);
+	SG_ADD(&m_num_landmarks, "num_landmarks",
+      "number of landmarks (Nystroem)", MS_NOT_AVAILABLE);
+	SG_ADD(&m_num_random_features, "num_random_features",
+      "number of random features (random Fourier features)", MS_NOT_AVAILABLE);
+	SG_ADD(&m_random_coeff, "random_coeff",
+      "coefficients of the random Fourier features", MS_NOT_AVAILABLE);
 	SG_ADD(&m_transformation_matrix, "transformation_matrix",
       "matrix used to transform data", MS_NOT_AVAILABLE);
 	SG_ADD(&m_bias_vector, "bias_vector",
@@ -56,6 +110,7 @@ void CKernelPCA::cleanup()
 	if (m_init_features)
 		SG_UNREF(m_init_features);
 
+	m_random_coeff = SGMatrix<float64_t>();
 	m_initialized = false;
 }
 
@@ -67,6 +122,9 @@ CKernelPCA::~CKernelPCA()
 
 bool CKernelPCA::init(CFeatures* features)
 {
+	if (!m_initialized && m_kernel && m_method!=KPCA_EXACT)
+		return init_approximation(features);
+
 	if (!m_initialized && m_kernel)
 	{
 		SG_REF(features);
@@ -124,12 +182,224 @@ bool CKernelPCA::init(CFeatures* features)
 	return false;
 }
 
+void CKernelPCA::compute_feature_map(CDotFeatures* rff, int32_t start,
+		int32_t num, SGMatrix<float64_t> result)
+{
+	KPCA_FEATURE_MAP_THREAD_PARAM params;
+	params.kernel=m_kernel;
+	params.rff=rff;
+	params.block_start=start;
+	params.dim=result.num_rows;
+	params.result=result.matrix;
+
+	parallel->parallel_for(0, num, kpca_feature_map_helper, (void*) &params);
+}
+
+CDotFeatures* CKernelPCA::get_random_fourier_features(CFeatures* features)
+{
+	REQUIRE(features && features->has_property(FP_DOT),
+			"Random Fourier features need CDotFeatures\n")
+
+	SGVector<float64_t> params(1);
+	params[0]=((CGaussianKernel*) m_kernel)->get_width();
+
+	if (m_random_coeff.matrix)
+	{
+		return new CRandomFourierDotFeatures((CDotFeatures*) features,
+				m_random_coeff.num_cols, GAUSSIAN, params, m_random_coeff);
+	}
+
+	return new CRandomFourierDotFeatures((CDotFeatures*) features,
+			m_num_random_features, GAUSSIAN, params);
+}
+
+bool CKernelPCA::init_approximation(CFeatures* features)
+{
+	int32_t n=features->get_num_vectors();
+	REQUIRE(n>0, "No vectors to initialize from\n")
+
+	CDotFeatures* rff=NULL;
+	SGMatrix<float64_t> map;
+	int32_t dim=0;
+
+	if (m_method==KPCA_NYSTROEM)
+	{
+		REQUIRE(m_num_landmarks>0, "Number of landmarks must be positive\n")
+
+		/* random landmarks, in increasing order for cache friendly access */
+		dim=CMath::min(m_num_landmarks, n);
+		SGVector<index_t> perm=SGVector<index_t>::randperm_vec(n);
+		SGVector<index_t> landmarks(dim);
+		memcpy(landmarks.vector, perm.vector, sizeof(index_t)*dim);
+		CMath::qsort(landmarks.vector, dim);
+
+		m_init_features=features->copy_subset(landmarks);
+		SG_REF(m_init_features);
+
+		/* map=U*Lambda^(-1/2) where K_mm=U*Lambda*U', directions of
+		 * vanishing eigenvalues are dropped */
+		m_kernel->init(m_init_features, m_init_features);
+		map=m_kernel->get_kernel_matrix();
+		float64_t* eigenvalues=SGMatrix<float64_t>::compute_eigenvectors(
+				map.matrix, dim, dim);
+		float64_t max_eigenvalue=CMath::max(eigenvalues[dim-1], 1e-16);
+
+		for (int32_t i=0; i<dim; i++)
+		{
+			float64_t scale=eigenvalues[i]>1e-12*max_eigenvalue ?
+				1.0/CMath::sqrt(eigenvalues[i]) : 0.0;
+
+			for (int32_t j=0; j<dim; j++)
+				map(j,i)*=scale;
+		}
+		SG_FREE(eigenvalues);
+
+		m_kernel->init(features, m_init_features);
+	}
+	else if (m_method==KPCA_RANDOM_FOURIER)
+	{
+		REQUIRE(m_kernel->get_kernel_type()==K_GAUSSIAN,
+				"Random Fourier features are only available for the Gaussian "
+				"kernel\n")
+		REQUIRE(m_num_random_features>0,
+				"Number of random features must be positive\n")
+
+		m_random_coeff=SGMatrix<float64_t>();
+		rff=get_random_fourier_features(features);
+		SG_REF(rff);
+		m_random_coeff=((CRandomFourierDotFeatures*) rff)->get_random_coefficients();
+		dim=m_num_random_features;
+	}
+	else
+		SG_ERROR("Unknown method %d\n", m_method)
+
+	REQUIRE(m_target_dim<=dim, "Target dimension (%d) must not exceed the "
+			"dimension of the approximation (%d)\n", m_target_dim, dim)
+
+	/* mean and second moment of the explicit features */
+	int32_t block_size=CMath::max(1, CMath::min(n, (1<<22)/dim));
+	SGMatrix<float64_t> phi(dim, block_size);
+	SGMatrix<float64_t> cov(dim, dim);
+	SGVector<float64_t> mean(dim);
+	SGVector<float64_t> ones(block_size);
+	cov.zero();
+	mean.zero();
+	ones.set_const(1.0);
+
+	for (int32_t start=0; start<n; start+=block_size)
+	{
+		int32_t num=CMath::min(block_size, n-start);
+		compute_feature_map(rff, start, num, phi);
+
+		cblas_dsyrk(CblasColMajor, CblasUpper, CblasNoTrans, dim, num, 1.0,
+				phi.matrix, dim, 1.0, cov.matrix, dim);
+		cblas_dgemv(CblasColMajor, CblasNoTrans, dim, num, 1.0, phi.matrix,
+				dim, ones.vector, 1, 1.0, mean.vector, 1);
+	}
+
+	SGVector<float64_t>::scale_vector(1.0/n, mean.vector, dim);
+	for (int32_t i=0; i<dim; i++)
+	{
+		for (int32_t j=0; j<=i; j++)
+		{
+			cov(j,i)=cov(j,i)/n-mean[i]*mean[j];
+			cov(i,j)=cov(j,i);
+		}
+	}
+
+	if (map.matrix)
+	{
+		/* covariance of the Nystroem features map'*cov*map */
+		SGMatrix<float64_t> tmp(dim, dim);
+		cblas_dgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, dim, dim, dim,
+				1.0, cov.matrix, dim, map.matrix, dim, 0.0, tmp.matrix, dim);
+		cblas_dgemm(CblasColMajor, CblasTrans, CblasNoTrans, dim, dim, dim,
+				1.0, map.matrix, dim, tmp.matrix, dim, 0.0, cov.matrix, dim);
+	}
+
+	/* principal directions in ascending order of variance */
+	float64_t* eigenvalues=SGMatrix<float64_t>::compute_eigenvectors(
+			cov.matrix, dim, dim);
+	SG_FREE(eigenvalues);
+
+	if (map.matrix)
+	{
+		/* directly transform the kernel values */
+		m_transformation_matrix=SGMatrix<float64_t>(dim, dim);
+		cblas_dgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, dim, dim, dim,
+				1.0, map.matrix, dim, cov.matrix, dim, 0.0,
+				m_transformation_matrix.matrix, dim);
+		m_kernel->cleanup();
+	}
+	else
+		m_transformation_matrix=cov;
+
+	/* centering, bias[k] belongs to the k-th principal component */
+	m_bias_vector=SGVector<float64_t>(dim);
+	for (int32_t k=0; k<dim; k++)
+	{
+		m_bias_vector[k]=-SGVector<float64_t>::dot(mean.vector,
+				m_transformation_matrix.get_column_vector(dim-k-1), dim);
+	}
+
+	SG_UNREF(rff);
+
+	m_initialized=true;
+	SG_INFO("Done\n")
+	return true;
+}
+
+SGMatrix<float64_t> CKernelPCA::apply_random_fourier(CFeatures* features)
+{
+	CDotFeatures* rff=get_random_fourier_features(features);
+	SG_REF(rff);
+
+	int32_t num_vectors=rff->get_num_vectors();
+	int32_t dim=m_transformation_matrix.num_rows;
+	int32_t block_size=CMath::max(1, CMath::min(num_vectors, (1<<22)/dim));
+	SGMatrix<float64_t> phi(dim, block_size);
+	SGMatrix<float64_t> result(m_target_dim, num_vectors);
+
+	/* leading principal directions in descending order */
+	SGMatrix<float64_t> directions(dim, m_target_dim);
+	for (int32_t k=0; k<m_target_dim; k++)
+	{
+		memcpy(directions.get_column_vector(k),
+				m_transformation_matrix.get_column_vector(dim-k-1),
+				sizeof(float64_t)*dim);
+	}
+
+	for (int32_t start=0; start<num_vectors; start+=block_size)
+	{
+		int32_t num=CMath::min(block_size, num_vectors-start);
+		compute_feature_map(rff, start, num, phi);
+
+		for (int32_t i=0; i<num; i++)
+		{
+			memcpy(result.get_column_vector(start+i), m_bias_vector.vector,
+					sizeof(float64_t)*m_target_dim);
+		}
+
+		cblas_dgemm(CblasColMajor, CblasTrans, CblasNoTrans, m_target_dim,
+				num, dim, 1.0, directions.matrix, dim, phi.matrix, dim, 1.0,
+				result.get_column_vector(start), m_target_dim);
+	}
+
+	SG_UNREF(rff);
+	return result;
+}
 
 SGMatrix<float64_t> CKernelPCA::apply_to_feature_matrix(CFeatures* features)
 {
 	ASSERT(m_initialized)
 	CDenseFeatures<float64_t>* simple_features = (CDenseFeatures<float64_t>*)features;
 
+	if (m_method==KPCA_RANDOM_FOURIER)
+	{
+		simple_features->set_feature_matrix(apply_random_fourier(features));
+		return simple_features->get_feature_matrix();
+	}
+
 	int32_t num_vectors = simple_features->get_num_vectors();
 	int32_t i,j,k;
 	int32_t n = m_transformation_matrix.num_cols;
@@ -160,6 +430,18 @@ SGMatrix<float64_t> CKernelPCA::apply_to_feature_matrix(CFeatures* features)
 SGVector<float64_t> CKernelPCA::apply_to_feature_vector(SGVector<float64_t> vector)
 {
 	ASSERT(m_initialized)
+
+	if (m_method==KPCA_RANDOM_FOURIER)
+	{
+		CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(
+				SGMatrix<float64_t>(vector.vector, vector.vlen, 1, false));
+		SG_REF(features);
+		SGMatrix<float64_t> embedding=apply_random_fourier(features);
+		SG_UNREF(features);
+
+		return SGVector<float64_t>(embedding.matrix, m_target_dim, false).clone();
+	}
+
 	SGVector<float64_t> result = SGVector<float64_t>(m_target_dim);
 	m_kernel->init(new CDenseFeatures<float64_t>(SGMatrix<float64_t>(vector.vector,vector.vlen,1)),
 	               m_init_features);
@@ -185,6 +467,8 @@ SGVector<float64_t> CKernelPCA::apply_to_feature_vector(SGVector<float64_t> vect
 CDenseFeatures<float64_t>* CKernelPCA::apply_to_string_features(CFeatures* features)
 {
 	ASSERT(m_initialized)
+	REQUIRE(m_method!=KPCA_RANDOM_FOURIER,
+			"Random Fourier features are not available for string features\n")
 
 	int32_t num_vectors = features->get_num_vectors();
 	int32_t i,j,k;
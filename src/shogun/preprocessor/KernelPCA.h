@@ -23,6 +23,18 @@ namespace shogun
 
 class CFeatures;
 class CKernel;
+class CDotFeatures;
+
+/** method used to compute the kernel principal components */
+enum EKernelPCAMethod
+{
+	/// eigendecomposition of the full kernel matrix
+	KPCA_EXACT=1,
+	/// Nystroem approximation using randomly chosen landmarks
+	KPCA_NYSTROEM=2,
+	/// random Fourier features (Gaussian kernel only)
+	KPCA_RANDOM_FOURIER=3
+};
 
 /** @brief Preprocessor KernelPCA performs kernel principal component analysis
  *
@@ -31,6 +43,16 @@ class CKernel;
  * Advances in kernel methods support vector learning, 1327(3), 327-352. MIT Press.
  * Retrieved from http://citeseerx.ist.psu.edu/viewdoc/summary?doi=10.1.1.32.8744
  *
+ * KPCA_EXACT decomposes the full n x n kernel matrix. The approximate methods
+ * instead map the data explicitly to an m dimensional space and run linear
+ * PCA there, which takes \f$O(nm^2)\f$ time and \f$O(m^2)\f$ memory:
+ *
+ * - KPCA_NYSTROEM uses \f$\phi(x)=\Lambda^{-1/2}U^Tk_m(x)\f$, where
+ *   \f$k_m(x)\f$ are the kernel values of x with m randomly chosen landmarks
+ *   and \f$K_{mm}=U\Lambda U^T\f$. With all training vectors as landmarks
+ *   this is exact.
+ * - KPCA_RANDOM_FOURIER uses CRandomFourierDotFeatures and thus needs a
+ *   CGaussianKernel and CDotFeatures.
  */
 class CKernelPCA: public CDimensionReductionPreprocessor
 {
@@ -81,6 +103,33 @@ public:
 			return m_bias_vector;
 		}
 
+		/** set method used to compute the principal components
+		 *
+		 * @param method method
+		 */
+		void set_method(EKernelPCAMethod method) { m_method=method; }
+
+		/** @return method used to compute the principal components */
+		EKernelPCAMethod get_method() const { return m_method; }
+
+		/** set number of landmarks used by KPCA_NYSTROEM
+		 *
+		 * @param num number of landmarks
+		 */
+		void set_num_landmarks(int32_t num) { m_num_landmarks=num; }
+
+		/** @return number of landmarks used by KPCA_NYSTROEM */
+		int32_t get_num_landmarks() const { return m_num_landmarks; }
+
+		/** set number of random features used by KPCA_RANDOM_FOURIER
+		 *
+		 * @param num number of random features
+		 */
+		void set_num_random_features(int32_t num) { m_num_random_features=num; }
+
+		/** @return number of random features used by KPCA_RANDOM_FOURIER */
+		int32_t get_num_random_features() const { return m_num_random_features; }
+
 		/** @return object name */
 		virtual const char* get_name() const { return "KernelPCA"; }
 
@@ -92,6 +141,41 @@ public:
 		/** default init */
 		void init();
 
+		/** initialize using the Nystroem approximation or random Fourier
+		 * features
+		 *
+		 * @param features training features
+		 * @return whether initialization was successful
+		 */
+		bool init_approximation(CFeatures* features);
+
+		/** compute the explicit (approximate) feature map of a block of
+		 * vectors
+		 *
+		 * @param rff random features or NULL to use kernel rows of the
+		 * initialized kernel
+		 * @param start first vector
+		 * @param num number of vectors
+		 * @param result dim x num matrix the features are written to
+		 */
+		void compute_feature_map(CDotFeatures* rff, int32_t start, int32_t num,
+				SGMatrix<float64_t> result);
+
+		/** wrap features in random Fourier features using the coefficients
+		 * drawn by init
+		 *
+		 * @param features dot features
+		 * @return random Fourier features
+		 */
+		CDotFeatures* get_random_fourier_features(CFeatures* features);
+
+		/** apply the random Fourier features based transformation
+		 *
+		 * @param features dot features
+		 * @return target_dim x num_vectors embedding
+		 */
+		SGMatrix<float64_t> apply_random_fourier(CFeatures* features);
+
 	protected:
 
 		/** features used by init. needed for apply */
@@ -106,6 +190,18 @@ public:
 		/** true when already initialized */
 		bool m_initialized;
 
+		/** method used to compute the principal components */
+		EKernelPCAMethod m_method;
+
+		/** number of landmarks (KPCA_NYSTROEM) */
+		int32_t m_num_landmarks;
+
+		/** number of random features (KPCA_RANDOM_FOURIER) */
+		int32_t m_num_random_features;
+
+		/** random coefficients of the random Fourier features */
+		SGMatrix<float64_t> m_random_coeff;
+
 };
 }
 #endif
@@ -83,3 +83,12 @@ SGVector<float64_t> CLogPlusOne::apply_to_feature_vector(SGVector<float64_t> vec
 
 	return SGVector<float64_t>(log_vec,vector.vlen);
 }
+
+int32_t CLogPlusOne::apply_to_feature_vector_inplace(float64_t* vector,
+		int32_t len, int32_t capacity)
+{
+	for (int32_t i=0; i<len; i++)
+		vector[i]=CMath::log(vector[i]+1.0);
+
+	return len;
+}
@@ -82,3 +82,14 @@ SGVector<float64_t> CNormOne::apply_to_feature_vector(SGVector<float64_t> vector
 
 	return SGVector<float64_t>(normed_vec,vector.vlen);
 }
+
+int32_t CNormOne::apply_to_feature_vector_inplace(float64_t* vector,
+		int32_t len, int32_t capacity)
+{
+	float64_t norm=CMath::sqrt(SGVector<float64_t>::dot(vector, vector, len));
+
+	for (int32_t i=0; i<len; i++)
+		vector[i]/=norm;
+
+	return len;
+}
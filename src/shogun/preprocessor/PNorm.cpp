@@ -97,6 +97,17 @@ SGVector<float64_t> CPNorm::apply_to_feature_vector (SGVector<float64_t> vector)
 	return SGVector<float64_t>(normed_vec,vector.vlen);
 }
 
+int32_t CPNorm::apply_to_feature_vector_inplace(float64_t* vector,
+		int32_t len, int32_t capacity)
+{
+	float64_t norm=get_pnorm(vector, len);
+
+	for (int32_t i=0; i<len; i++)
+		vector[i]/=norm;
+
+	return len;
+}
+
 void CPNorm::set_pnorm (double pnorm)
 {
 	ASSERT (pnorm >= 1.0)
@@ -187,6 +187,47 @@ SGVector<float64_t> CPruneVarSubMean::apply_to_feature_vector(SGVector<float64_t
 	return SGVector<float64_t>(ret,m_num_idx);
 }
 
+int32_t CPruneVarSubMean::apply_to_feature_vector_inplace(float64_t* vector,
+		int32_t len, int32_t capacity)
+{
+	REQUIRE(m_initialized, "%s::apply_to_feature_vector_inplace(): "
+			"Preprocessor is not initialized\n", get_name())
+
+	/* m_idx is increasing, so no entry is overwritten before it is read */
+	if (m_divide_by_std)
+	{
+		for (int32_t i=0; i<m_num_idx; i++)
+			vector[i]=(vector[m_idx[i]]-m_mean[i])/m_std[i];
+	}
+	else
+	{
+		for (int32_t i=0; i<m_num_idx; i++)
+			vector[i]=vector[m_idx[i]]-m_mean[i];
+	}
+
+	return m_num_idx;
+}
+
+int32_t CPruneVarSubMean::apply_to_feature_vector_inplace_sqnorm(
+		float64_t* vector, int32_t len, int32_t capacity, float64_t& sq_norm)
+{
+	REQUIRE(m_initialized, "%s::apply_to_feature_vector_inplace_sqnorm(): "
+			"Preprocessor is not initialized\n", get_name())
+
+	sq_norm=0;
+	for (int32_t i=0; i<m_num_idx; i++)
+	{
+		float64_t v=vector[m_idx[i]]-m_mean[i];
+		if (m_divide_by_std)
+			v/=m_std[i];
+
+		vector[i]=v;
+		sq_norm+=v*v;
+	}
+
+	return m_num_idx;
+}
+
 void CPruneVarSubMean::init()
 {
 	m_initialized = false;
@@ -53,6 +53,18 @@ class CPruneVarSubMean : public CDensePreprocessor<float64_t>
 		/// result in feature matrix
 		virtual SGVector<float64_t> apply_to_feature_vector(SGVector<float64_t> vector);
 
+		/// preproc can be applied in place
+		virtual bool supports_inplace() { return true; }
+
+		/// apply preproc in place on single feature vector
+		virtual int32_t apply_to_feature_vector_inplace(float64_t* vector,
+				int32_t len, int32_t capacity);
+
+		/// apply preproc in place on single feature vector and compute the
+		/// squared norm of the result
+		virtual int32_t apply_to_feature_vector_inplace_sqnorm(float64_t* vector,
+				int32_t len, int32_t capacity, float64_t& sq_norm);
+
 		/** @return object name */
 		virtual const char* get_name() const { return "PruneVarSubMean"; }
 
@@ -112,6 +112,34 @@ SGVector<float64_t> CRescaleFeatures::apply_to_feature_vector(SGVector<float64_t
 	return SGVector<float64_t>(ret,vector.vlen);
 }
 
+int32_t CRescaleFeatures::apply_to_feature_vector_inplace(float64_t* vector,
+		int32_t len, int32_t capacity)
+{
+	ASSERT(m_initialized);
+	ASSERT(m_min.vlen == len);
+
+	for (index_t i = 0; i < len; i++)
+		vector[i] = (vector[i]-m_min[i])*m_range[i];
+
+	return len;
+}
+
+int32_t CRescaleFeatures::apply_to_feature_vector_inplace_sqnorm(
+		float64_t* vector, int32_t len, int32_t capacity, float64_t& sq_norm)
+{
+	ASSERT(m_initialized);
+	ASSERT(m_min.vlen == len);
+
+	sq_norm = 0;
+	for (index_t i = 0; i < len; i++)
+	{
+		vector[i] = (vector[i]-m_min[i])*m_range[i];
+		sq_norm += vector[i]*vector[i];
+	}
+
+	return len;
+}
+
 void CRescaleFeatures::register_parameters()
 {
 	SG_ADD(&m_min, "min", "minimum values of each feature", MS_NOT_AVAILABLE);
@@ -59,6 +59,23 @@ namespace shogun
 			 */
 			virtual SGVector<float64_t> apply_to_feature_vector(SGVector<float64_t> vector);
 
+			/** @return true, preproc can be applied in place */
+			virtual bool supports_inplace() { return true; }
+
+			/**
+			 * Apply preproc in place on a single feature vector
+			 */
+			virtual int32_t apply_to_feature_vector_inplace(float64_t* vector,
+					int32_t len, int32_t capacity);
+
+			/**
+			 * Apply preproc in place on a single feature vector and compute
+			 * the squared norm of the result
+			 */
+			virtual int32_t apply_to_feature_vector_inplace_sqnorm(
+					float64_t* vector, int32_t len, int32_t capacity,
+					float64_t& sq_norm);
+
 			/** @return object name */
 			virtual const char* get_name() const { return "RescaleFeatures"; }
 
@@ -82,3 +82,14 @@ SGVector<float64_t> CSumOne::apply_to_feature_vector(SGVector<float64_t> vector)
 
 	return SGVector<float64_t>(normed_vec,vector.vlen);
 }
+
+int32_t CSumOne::apply_to_feature_vector_inplace(float64_t* vector,
+		int32_t len, int32_t capacity)
+{
+	float64_t sum=SGVector<float64_t>::sum(vector, len);
+
+	for (int32_t i=0; i<len; i++)
+		vector[i]/=sum;
+
+	return len;
+}
@@ -121,13 +121,19 @@ SGVector<float64_t> CGaussianProcessRegression::get_mean_vector(CFeatures* data)
 
 	SG_REF(data);
 	SGVector<float64_t> mu=get_posterior_means(data);
-	SGVector<float64_t> s2=get_posterior_variances(data);
-	SG_UNREF(data);
 
-	// evaluate mean
-	lik=m_method->get_model();
-	mu=lik->get_predictive_means(mu, s2);
-	SG_UNREF(lik);
+	// the predictive means of the Gaussian likelihood do not depend on the
+	// variances, which would cost one linear solve per vector here
+	if (m_method->get_inference_type()!=INF_MATRIX_FREE)
+	{
+		SGVector<float64_t> s2=get_posterior_variances(data);
+
+		// evaluate mean
+		lik=m_method->get_model();
+		mu=lik->get_predictive_means(mu, s2);
+		SG_UNREF(lik);
+	}
+	SG_UNREF(data);
 
 	return mu;
 }
@@ -16,9 +16,54 @@
 #include <shogun/mathematics/lapack.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/labels/RegressionLabels.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/features/RandomFourierDotFeatures.h>
+#include <shogun/base/Parallel.h>
+
+#include <string.h>
 
 using namespace shogun;
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+struct FEATURE_MAP_THREAD_PARAM
+{
+	/** kernel initialized with (train, landmarks), used if rff is NULL */
+	CKernel* kernel;
+	/** random features */
+	CDotFeatures* rff;
+	/** first vector of the block */
+	int32_t block_start;
+	/** dimension of the feature map */
+	int32_t dim;
+	/** dim x block size result */
+	float64_t* result;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+static void compute_feature_map_helper(int32_t start, int32_t end,
+		int32_t thread, void* p)
+{
+	FEATURE_MAP_THREAD_PARAM* params=(FEATURE_MAP_THREAD_PARAM*) p;
+	int32_t dim=params->dim;
+
+	for (int32_t i=start; i<end; i++)
+	{
+		float64_t* phi=&params->result[int64_t(i)*dim];
+		int32_t idx=params->block_start+i;
+
+		if (params->rff)
+		{
+			memset(phi, 0, sizeof(float64_t)*dim);
+			params->rff->add_to_dense_vec(1.0, idx, phi, dim);
+		}
+		else
+		{
+			for (int32_t j=0; j<dim; j++)
+				phi[j]=params->kernel->kernel(idx, j);
+		}
+	}
+}
+
 CKernelRidgeRegression::CKernelRidgeRegression()
 : CKernelMachine()
 {
@@ -40,7 +85,19 @@ void CKernelRidgeRegression::init()
 {
 	m_tau=1e-6;
 	m_epsilon=0.0001;
+	m_train_func=PINV;
+	m_num_landmarks=100;
+	m_num_random_features=100;
 	SG_ADD(&m_tau, "tau", "Regularization parameter", MS_AVAILABLE);
+	SG_ADD(&m_num_landmarks, "num_landmarks", "Number of landmarks (Nystroem)",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_num_random_features, "num_random_features",
+			"Number of random features (random Fourier features)",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_random_coeff, "random_coeff",
+			"Coefficients of the random Fourier features", MS_NOT_AVAILABLE);
+	SG_ADD(&m_rff_weights, "rff_weights",
+			"Weights in the random feature space", MS_NOT_AVAILABLE);
 }
 
 bool CKernelRidgeRegression::train_machine_pinv()
@@ -122,6 +179,192 @@ bool CKernelRidgeRegression::train_machine_gs()
 	return true;
 }
 
+void CKernelRidgeRegression::accumulate_normal_equations(CDotFeatures* rff,
+		int32_t dim, SGMatrix<float64_t> A, SGVector<float64_t> b)
+{
+	SGVector<float64_t> y=((CRegressionLabels*) m_labels)->get_labels();
+	int32_t n=y.vlen;
+
+	/* blocks of ~32MB of explicit features */
+	int32_t block_size=CMath::max(1, CMath::min(n, (1<<22)/dim));
+	SGMatrix<float64_t> phi(dim, block_size);
+
+	FEATURE_MAP_THREAD_PARAM params;
+	params.kernel=kernel;
+	params.rff=rff;
+	params.dim=dim;
+	params.result=phi.matrix;
+
+	for (int32_t start=0; start<n; start+=block_size)
+	{
+		int32_t num=CMath::min(block_size, n-start);
+		params.block_start=start;
+		parallel->parallel_for(0, num, compute_feature_map_helper,
+				(void*) &params);
+
+		cblas_dsyrk(CblasColMajor, CblasUpper, CblasNoTrans, dim, num, 1.0,
+				phi.matrix, dim, 1.0, A.matrix, dim);
+		cblas_dgemv(CblasColMajor, CblasNoTrans, dim, num, 1.0, phi.matrix,
+				dim, &y.vector[start], 1, 1.0, b.vector, 1);
+	}
+}
+
+bool CKernelRidgeRegression::train_machine_nystroem()
+{
+	CFeatures* lhs=kernel->get_lhs();
+	int32_t n=lhs->get_num_vectors();
+	REQUIRE(m_num_landmarks>0, "Number of landmarks must be positive\n")
+
+	if (n!=m_labels->get_num_labels())
+	{
+		SG_ERROR("Number of labels does not match number of kernel"
+				" columns (num_labels=%d cols=%d\n",
+				m_labels->get_num_labels(), n);
+	}
+
+	/* random landmarks, in increasing order for cache friendly access */
+	int32_t m=CMath::min(m_num_landmarks, n);
+	SGVector<index_t> perm=SGVector<index_t>::randperm_vec(n);
+	SGVector<index_t> landmarks(m);
+	memcpy(landmarks.vector, perm.vector, sizeof(index_t)*m);
+	CMath::qsort(landmarks.vector, m);
+
+	CFeatures* landmark_features=lhs->copy_subset(landmarks);
+	SG_REF(landmark_features);
+
+	SGMatrix<float64_t> A(m, m);
+	A.zero();
+	SGVector<float64_t> b(m);
+	b.zero();
+
+	/* A=K_mn*K_nm, b=K_mn*y */
+	kernel->init(lhs, landmark_features);
+	accumulate_normal_equations(NULL, m, A, b);
+
+	/* A+=tau*K_mm */
+	kernel->init(landmark_features, landmark_features);
+	SGMatrix<float64_t> kmm=kernel->get_kernel_matrix<float64_t>();
+	float64_t max_diag=0;
+	for (int64_t i=0; i<int64_t(m)*m; i++)
+		A.matrix[i]+=m_tau*kmm.matrix[i];
+	for (int32_t i=0; i<m; i++)
+		max_diag=CMath::max(max_diag, A(i,i));
+
+	/* duplicate landmarks and a vanishing tau make A singular */
+	for (int32_t i=0; i<m; i++)
+		A(i,i)+=1e-12*max_diag+CMath::MACHINE_EPSILON;
+
+	int32_t info=clapack_dposv(CblasColMajor, CblasUpper, m, 1, A.matrix, m,
+			b.vector, m);
+	REQUIRE(info==0, "Cholesky factorization failed (info=%d)\n", info)
+
+	kernel->init(lhs, lhs);
+	SG_UNREF(landmark_features);
+	SG_UNREF(lhs);
+
+	/* landmarks are the 'support vectors' */
+	m_alpha=b;
+	m_svs=landmarks;
+	set_bias(0);
+
+	return true;
+}
+
+CDotFeatures* CKernelRidgeRegression::get_random_fourier_features(
+		CFeatures* features)
+{
+	REQUIRE(features && features->has_property(FP_DOT),
+			"Random Fourier features need CDotFeatures\n")
+
+	SGVector<float64_t> params(1);
+	params[0]=((CGaussianKernel*) kernel)->get_width();
+
+	return new CRandomFourierDotFeatures((CDotFeatures*) features,
+			m_random_coeff.num_cols, GAUSSIAN, params, m_random_coeff);
+}
+
+bool CKernelRidgeRegression::train_machine_random_fourier()
+{
+	REQUIRE(kernel->get_kernel_type()==K_GAUSSIAN,
+			"Random Fourier features are only available for the Gaussian "
+			"kernel\n")
+	REQUIRE(m_num_random_features>0,
+			"Number of random features must be positive\n")
+
+	CFeatures* lhs=kernel->get_lhs();
+	REQUIRE(lhs && lhs->has_property(FP_DOT),
+			"Random Fourier features need CDotFeatures\n")
+	int32_t D=m_num_random_features;
+
+	if (lhs->get_num_vectors()!=m_labels->get_num_labels())
+	{
+		SG_ERROR("Number of labels does not match number of training"
+				" vectors (num_labels=%d num_vectors=%d\n",
+				m_labels->get_num_labels(), lhs->get_num_vectors());
+	}
+
+	SGVector<float64_t> params(1);
+	params[0]=((CGaussianKernel*) kernel)->get_width();
+	CRandomFourierDotFeatures* rff=new CRandomFourierDotFeatures(
+			(CDotFeatures*) lhs, D, GAUSSIAN, params);
+	SG_REF(rff);
+	m_random_coeff=rff->get_random_coefficients();
+
+	/* (Z*Z'+tau*I)*w=Z*y */
+	SGMatrix<float64_t> A(D, D);
+	A.zero();
+	SGVector<float64_t> w(D);
+	w.zero();
+	accumulate_normal_equations(rff, D, A, w);
+
+	for (int32_t i=0; i<D; i++)
+		A(i,i)+=m_tau+CMath::MACHINE_EPSILON;
+
+	int32_t info=clapack_dposv(CblasColMajor, CblasUpper, D, 1, A.matrix, D,
+			w.vector, D);
+	REQUIRE(info==0, "Cholesky factorization failed (info=%d)\n", info)
+
+	SG_UNREF(rff);
+	SG_UNREF(lhs);
+
+	m_rff_weights=w;
+	m_alpha=SGVector<float64_t>();
+	m_svs=SGVector<index_t>();
+	set_bias(0);
+
+	return true;
+}
+
+CRegressionLabels* CKernelRidgeRegression::apply_regression(CFeatures* data)
+{
+	if (m_train_func!=RANDOM_FOURIER)
+		return CKernelMachine::apply_regression(data);
+
+	REQUIRE(m_rff_weights.vlen>0, "Machine is not trained\n")
+
+	CFeatures* features=NULL;
+	if (data)
+	{
+		SG_REF(data);
+		features=data;
+	}
+	else
+		features=kernel->get_rhs();
+
+	CDotFeatures* rff=get_random_fourier_features(features);
+	SG_REF(rff);
+
+	int32_t num=rff->get_num_vectors();
+	SGVector<float64_t> outputs(num);
+	rff->dense_dot_range(outputs.vector, 0, num, NULL, m_rff_weights.vector,
+			m_rff_weights.vlen, get_bias());
+
+	SG_UNREF(rff);
+	SG_UNREF(features);
+
+	return new CRegressionLabels(outputs);
+}
+
 bool CKernelRidgeRegression::train_machine(CFeatures *data)
 {
 	if (!m_labels)
@@ -146,6 +389,12 @@ bool CKernelRidgeRegression::train_machine(CFeatures *data)
 		case GS:
 			return train_machine_gs();
 			break;
+		case NYSTROEM:
+			return train_machine_nystroem();
+			break;
+		case RANDOM_FOURIER:
+			return train_machine_random_fourier();
+			break;
 		default:
 			return train_machine_pinv();
 			break;
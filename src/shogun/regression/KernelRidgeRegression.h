@@ -18,6 +18,7 @@
 #ifdef HAVE_LAPACK
 
 #include <shogun/machine/KernelMachine.h>
+#include <shogun/features/DotFeatures.h>
 
 namespace shogun
 {
@@ -28,7 +29,11 @@ enum ETrainingType
 	/// via pseudo inverse
 	PINV=1,
 	/// or gauss-seidel iterative method
-	GS=2
+	GS=2,
+	/// Nystroem approximation using randomly chosen landmarks
+	NYSTROEM=3,
+	/// random Fourier features (Gaussian kernel only)
+	RANDOM_FOURIER=4
 };
 
 /** @brief Class KernelRidgeRegression implements Kernel Ridge Regression - a regularized least square
@@ -60,6 +65,26 @@ enum ETrainingType
  * where K is the kernel matrix and y the vector of labels. The expressed
  * solution can again be written as a linear combination of kernels (cf.
  * CKernelMachine) with bias \f$b=0\f$.
+ *
+ * As PINV and GS need the full kernel matrix, two approximations are
+ * available that train in \f$O(nm^2)\f$ time and \f$O(m^2)\f$ memory, where
+ * m is the number of landmarks or random features:
+ *
+ * - NYSTROEM restricts the solution to m randomly chosen landmarks
+ *   \f$l_1,\dots,l_m\f$ and solves
+ *   \f[
+ *   {\bf \alpha}=\left({\bf K}_{mn}{\bf K}_{nm}+\tau{\bf K}_{mm}\right)^{-1}
+ *   {\bf K}_{mn}{\bf y}.
+ *   \f]
+ *   The landmarks become the support vectors, so prediction still works via
+ *   the kernel.
+ * - RANDOM_FOURIER maps the inputs with CRandomFourierDotFeatures and solves
+ *   the linear (primal) ridge regression problem in the random feature space.
+ *   It is only available for CGaussianKernel on CDotFeatures, prediction uses
+ *   the same random features.
+ *
+ * The kernel rows or random features needed are computed blockwise and in
+ * parallel, so the full n x m matrix is never stored.
  */
 class CKernelRidgeRegression : public CKernelMachine
 {
@@ -94,6 +119,47 @@ class CKernelRidgeRegression : public CKernelMachine
 		 */
 		inline void set_epsilon(float64_t epsilon) { m_epsilon = epsilon; }
 
+		/** set training method
+		 *
+		 * @param m training method
+		 */
+		inline void set_training_type(ETrainingType m) { m_train_func = m; }
+
+		/** @return training method */
+		inline ETrainingType get_training_type() const { return m_train_func; }
+
+		/** set number of landmarks used by NYSTROEM
+		 *
+		 * @param num number of landmarks
+		 */
+		inline void set_num_landmarks(int32_t num) { m_num_landmarks = num; }
+
+		/** @return number of landmarks used by NYSTROEM */
+		inline int32_t get_num_landmarks() const { return m_num_landmarks; }
+
+		/** set number of random features used by RANDOM_FOURIER
+		 *
+		 * @param num number of random features
+		 */
+		inline void set_num_random_features(int32_t num)
+		{
+			m_num_random_features = num;
+		}
+
+		/** @return number of random features used by RANDOM_FOURIER */
+		inline int32_t get_num_random_features() const
+		{
+			return m_num_random_features;
+		}
+
+		/** apply regression to data, uses the random features in case of
+		 * RANDOM_FOURIER and the kernel otherwise
+		 *
+		 * @param data (test) data to be classified
+		 * @return classified labels
+		 */
+		virtual CRegressionLabels* apply_regression(CFeatures* data=NULL);
+
 		/** load regression from file
 		 *
 		 * @param srcfile file to load from
@@ -146,6 +212,39 @@ class CKernelRidgeRegression : public CKernelMachine
 		 */
 		bool train_machine_pinv();
 
+		/** train regression using the Nystroem approximation
+		 *
+		 * @return whether training was successful
+		 */
+		bool train_machine_nystroem();
+
+		/** train regression using random Fourier features
+		 *
+		 * @return whether training was successful
+		 */
+		bool train_machine_random_fourier();
+
+		/** accumulate the normal equations \f$A=\Phi\Phi^T\f$,
+		 * \f$b=\Phi y\f$ of an explicit feature map \f$\Phi\f$ (either the
+		 * kernel rows of kernel->init(train, landmarks) or random features),
+		 * block of training vectors by block of training vectors
+		 *
+		 * @param rff random features or NULL to use kernel rows
+		 * @param dim dimension of the feature map
+		 * @param A dim x dim matrix, upper triangle is added to
+		 * @param b vector of length dim added to
+		 */
+		void accumulate_normal_equations(CDotFeatures* rff, int32_t dim,
+				SGMatrix<float64_t> A, SGVector<float64_t> b);
+
+		/** wrap features in random Fourier features using the coefficients
+		 * drawn during training
+		 *
+		 * @param features dot features
+		 * @return random Fourier features
+		 */
+		CDotFeatures* get_random_fourier_features(CFeatures* features);
+
 	private:
 		/** regularization parameter tau */
 		float64_t m_tau;
@@ -155,6 +254,18 @@ class CKernelRidgeRegression : public CKernelMachine
 
 		/** training function */
 		ETrainingType m_train_func;
+
+		/** number of landmarks (NYSTROEM) */
+		int32_t m_num_landmarks;
+
+		/** number of random features (RANDOM_FOURIER) */
+		int32_t m_num_random_features;
+
+		/** random coefficients of the random Fourier features */
+		SGMatrix<float64_t> m_random_coeff;
+
+		/** weight vector in the random feature space */
+		SGVector<float64_t> m_rff_weights;
 };
 }
 
@@ -34,9 +34,99 @@
 #include <shogun/kernel/Kernel.h>
 #include <shogun/kernel/CombinedKernel.h>
 #include <shogun/kernel/CustomKernel.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/mathematics/Random.h>
 
 using namespace shogun;
 
+/** number of permutations that are evaluated in one pass over the kernel
+ * matrix */
+#define BOOTSTRAP_BLOCK_SIZE 16
+
+/** maximum number of kernel matrix elements that are precomputed for
+ * bootstrapping, larger kernels are evaluated on the fly */
+#define BOOTSTRAP_MAX_KERNEL_MATRIX_SIZE (int64_t(1)<<27)
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+struct QUADRATIC_MMD_BOOTSTRAP_PARAM
+{
+	/** kernel matrix of merged samples */
+	const float64_t* kmatrix;
+	/** number of merged samples */
+	index_t num_data;
+	/** number of samples from p */
+	index_t m;
+	/** seed of the random generator of every block of permutations */
+	const uint32_t* seeds;
+	/** number of permutations */
+	index_t num_permutations;
+	/** y'Ky for all permutations */
+	float64_t* quadratic_forms;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+static void bootstrap_block_helper(int32_t start, int32_t end, int32_t thread,
+		void* p)
+{
+	QUADRATIC_MMD_BOOTSTRAP_PARAM* params=(QUADRATIC_MMD_BOOTSTRAP_PARAM*) p;
+	index_t n=params->num_data;
+
+	/* labels of the permutations of one block, label b of sample i is
+	 * stored at i*BOOTSTRAP_BLOCK_SIZE+b */
+	float64_t* y=SG_MALLOC(float64_t, int64_t(n)*BOOTSTRAP_BLOCK_SIZE);
+	index_t* ind_permutation=SG_MALLOC(index_t, n);
+
+	for (int32_t k=start; k<end; k++)
+	{
+		index_t num=CMath::min(BOOTSTRAP_BLOCK_SIZE,
+				params->num_permutations-k*BOOTSTRAP_BLOCK_SIZE);
+
+		/* the permutations of a block only depend on its seed, such that
+		 * results do not depend on the number of threads */
+		CRandom* rand=new CRandom(params->seeds[k]);
+		memset(y, 0, sizeof(float64_t)*n*BOOTSTRAP_BLOCK_SIZE);
+		SGVector<index_t>::range_fill_vector(ind_permutation, n);
+		for (index_t b=0; b<num; b++)
+		{
+			SGVector<index_t>::permute(ind_permutation, n, rand);
+			for (index_t j=0; j<n; j++)
+				y[ind_permutation[j]*BOOTSTRAP_BLOCK_SIZE+b]=j<params->m ? 1 : -1;
+		}
+		SG_UNREF(rand);
+
+		float64_t q[BOOTSTRAP_BLOCK_SIZE];
+		float64_t row[BOOTSTRAP_BLOCK_SIZE];
+		memset(q, 0, sizeof(q));
+
+		/* y'Ky=trace(K)+2*sum_i y_i sum_{j<i} K_ij y_j, the trace is added by
+		 * the caller. The inner loop runs over the permutations of the
+		 * block, such that each kernel value is loaded once per block */
+		for (index_t i=1; i<n; i++)
+		{
+			const float64_t* k_i=&params->kmatrix[int64_t(i)*n];
+			memset(row, 0, sizeof(row));
+
+			for (index_t j=0; j<i; j++)
+			{
+				const float64_t k_ij=k_i[j];
+				const float64_t* y_j=&y[j*BOOTSTRAP_BLOCK_SIZE];
+				for (index_t b=0; b<BOOTSTRAP_BLOCK_SIZE; b++)
+					row[b]+=k_ij*y_j[b];
+			}
+
+			const float64_t* y_i=&y[i*BOOTSTRAP_BLOCK_SIZE];
+			for (index_t b=0; b<BOOTSTRAP_BLOCK_SIZE; b++)
+				q[b]+=y_i[b]*row[b];
+		}
+
+		for (index_t b=0; b<num; b++)
+			params->quadratic_forms[k*BOOTSTRAP_BLOCK_SIZE+b]=2*q[b];
+	}
+
+	SG_FREE(ind_permutation);
+	SG_FREE(y);
+}
+
 CQuadraticTimeMMD::CQuadraticTimeMMD() : CKernelTwoSampleTestStatistic()
 {
 	init();
@@ -226,7 +316,11 @@ float64_t CQuadraticTimeMMD::compute_p_value(float64_t statistic)
 	}
 
 	default:
+		/* bootstrapping may take several rounds, compute kernel once */
+		if (bootstrap_kernel_matrix_fits())
+			m_bootstrap_kmatrix=get_bootstrap_kernel_matrix();
 		result=CKernelTwoSampleTestStatistic::compute_p_value(statistic);
+		m_bootstrap_kmatrix=SGMatrix<float64_t>();
 		break;
 	}
 
@@ -312,6 +406,117 @@ float64_t CQuadraticTimeMMD::compute_threshold(float64_t alpha)
 	return result;
 }
 
+SGMatrix<float64_t> CQuadraticTimeMMD::get_bootstrap_kernel_matrix()
+{
+	REQUIRE(m_kernel, "%s::get_bootstrap_kernel_matrix(): No kernel set!\n",
+			get_name());
+
+	if (m_kernel->get_kernel_type()==K_CUSTOM)
+		return m_kernel->get_kernel_matrix();
+
+	REQUIRE(m_p_and_q, "%s::get_bootstrap_kernel_matrix(): No features and no "
+			"custom kernel set!\n", get_name());
+
+	m_kernel->init(m_p_and_q, m_p_and_q);
+	return m_kernel->get_kernel_matrix();
+}
+
+bool CQuadraticTimeMMD::bootstrap_kernel_matrix_fits()
+{
+	REQUIRE(m_kernel, "%s::bootstrap_kernel_matrix_fits(): No kernel set!\n",
+			get_name());
+
+	int64_t num_elements;
+	if (m_kernel->get_kernel_type()==K_CUSTOM)
+	{
+		num_elements=int64_t(m_kernel->get_num_vec_lhs())*
+			m_kernel->get_num_vec_rhs();
+	}
+	else
+	{
+		REQUIRE(m_p_and_q, "%s::bootstrap_kernel_matrix_fits(): No features "
+				"and no custom kernel set!\n", get_name());
+		num_elements=int64_t(m_p_and_q->get_num_vectors())*
+			m_p_and_q->get_num_vectors();
+	}
+
+	return num_elements<=BOOTSTRAP_MAX_KERNEL_MATRIX_SIZE;
+}
+
+SGVector<float64_t> CQuadraticTimeMMD::bootstrap_null()
+{
+	SG_DEBUG("entering %s::bootstrap_null()\n", get_name())
+
+	SGMatrix<float64_t> kmatrix=m_bootstrap_kmatrix;
+	if (!kmatrix.matrix)
+	{
+		/* kernel matrix too large, evaluate kernel on the fly */
+		if (!bootstrap_kernel_matrix_fits())
+			return CKernelTwoSampleTestStatistic::bootstrap_null();
+
+		kmatrix=get_bootstrap_kernel_matrix();
+	}
+
+	index_t n=kmatrix.num_rows;
+	if (n!=2*m_m || kmatrix.num_cols!=n)
+	{
+		/* samples do not split into p and q, use generic method */
+		return CKernelTwoSampleTestStatistic::bootstrap_null();
+	}
+
+	/* permutations are drawn by the threads, from one seed per block */
+	index_t num_permutations=m_bootstrap_iterations;
+	index_t num_blocks=(num_permutations+BOOTSTRAP_BLOCK_SIZE-1)/
+		BOOTSTRAP_BLOCK_SIZE;
+	SGVector<uint32_t> seeds(num_blocks);
+	for (index_t k=0; k<num_blocks; ++k)
+		seeds[k]=sg_rand->random_32();
+
+	SGVector<float64_t> quadratic_forms(num_permutations);
+	QUADRATIC_MMD_BOOTSTRAP_PARAM params;
+	params.kmatrix=kmatrix.matrix;
+	params.num_data=n;
+	params.m=m_m;
+	params.seeds=seeds.vector;
+	params.num_permutations=num_permutations;
+	params.quadratic_forms=quadratic_forms.vector;
+	parallel->parallel_for(0, num_blocks, bootstrap_block_helper, &params, 1);
+
+	/* sum and trace of the kernel matrix do not depend on the permutation */
+	float64_t sum=0;
+	float64_t trace=0;
+	for (index_t i=0; i<n; ++i)
+	{
+		trace+=kmatrix(i,i);
+		for (index_t j=0; j<n; ++j)
+			sum+=kmatrix(i,j);
+	}
+
+	/* within sample sums are (sum+y'Ky)/2, between sample sum is
+	 * (sum-y'Ky)/4, see compute_biased_statistic() for the terms */
+	SGVector<float64_t> results(num_permutations);
+	index_t m=m_m;
+	for (index_t i=0; i<num_permutations; ++i)
+	{
+		float64_t q=quadratic_forms[i]+trace;
+		switch (m_statistic_type)
+		{
+		case UNBIASED:
+			results[i]=((sum+q)/2-trace)/(m-1)-(sum-q)/(2*m);
+			break;
+		case BIASED:
+			results[i]=q/m;
+			break;
+		default:
+			SG_ERROR("%s::bootstrap_null(): Unknown statistic type!\n",
+					get_name());
+			break;
+		}
+	}
+
+	SG_DEBUG("leaving %s::bootstrap_null()\n", get_name())
+	return results;
+}
 
 #ifdef HAVE_LAPACK
 SGVector<float64_t> CQuadraticTimeMMD::sample_null_spectrum(index_t num_samples,
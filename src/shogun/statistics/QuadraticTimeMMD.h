@@ -93,7 +93,10 @@ enum EQuadraticMMDType
  * MMD2_GAMMA: for a very fast, but not consistent test based on moment matching
  * of a Gamma distribution, as described in [2].
  *
- * BOOTSTRAPPING: For permuting available samples to sample null-distribution
+ * BOOTSTRAPPING: For permuting available samples to sample null-distribution.
+ * The kernel matrix is computed only once, after which many permutations are
+ * evaluated per pass over it, in parallel (see bootstrap_null()). Kernel
+ * matrices that are too large to be stored are evaluated on the fly.
  *
  * For kernel selection see CMMDKernelSelection.
  *
@@ -189,6 +192,23 @@ class CQuadraticTimeMMD : public CKernelTwoSampleTestStatistic
 		 */
 		virtual float64_t compute_threshold(float64_t alpha);
 
+		/** merges both sets of samples and computes the test statistic
+		 * m_bootstrap_iteration times.
+		 *
+		 * The kernel matrix \f$K\f$ of the merged samples is computed once
+		 * (or taken from the custom kernel). A permutation is represented by
+		 * labels \f$y_i=\pm 1\f$, the statistic only depends on
+		 * \f$y^\top Ky\f$ which is computed for blocks of permutations in a
+		 * single pass over \f$K\f$, distributed over all threads.
+		 * Every block draws its permutations from its own seed, which is
+		 * taken from the global random generator, so results do not depend
+		 * on the number of threads. If \f$K\f$ is too large to be stored,
+		 * the superclass method is used.
+		 *
+		 * @return vector of all statistics
+		 */
+		virtual SGVector<float64_t> bootstrap_null();
+
 		virtual const char* get_name() const
 		{
 			return "QuadraticTimeMMD";
@@ -275,6 +295,16 @@ class CQuadraticTimeMMD : public CKernelTwoSampleTestStatistic
 		/** helper method to compute m*biased squared quadratic time MMD */
 		virtual float64_t compute_biased_statistic();
 
+		/** @return kernel matrix of the merged samples of p and q, to be used
+		 * for bootstrapping
+		 */
+		SGMatrix<float64_t> get_bootstrap_kernel_matrix();
+
+		/** @return whether the kernel matrix of the merged samples is small
+		 * enough to be precomputed for bootstrapping
+		 */
+		bool bootstrap_kernel_matrix_fits();
+
 	private:
 		void init();
 
@@ -287,6 +317,10 @@ class CQuadraticTimeMMD : public CKernelTwoSampleTestStatistic
 
 		/** type of statistic (biased/unbiased) */
 		EQuadraticMMDType m_statistic_type;
+
+		/** kernel matrix shared by all bootstrapping rounds of one p-value
+		 * computation, empty otherwise */
+		SGMatrix<float64_t> m_bootstrap_kmatrix;
 };
 
 }
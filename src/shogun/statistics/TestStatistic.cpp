@@ -31,7 +31,16 @@ void CTestStatistic::init()
 			"Method for approximating null distribution",
 			MS_NOT_AVAILABLE);
 
+	SG_ADD(&m_bootstrap_tolerance, "bootstrap_tolerance",
+			"Confidence interval width for sequential bootstrapping",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_max_bootstrap_iterations, "max_bootstrap_iterations",
+			"Maximum number of sequential bootstrapping iterations",
+			MS_NOT_AVAILABLE);
+
 	m_bootstrap_iterations=250;
+	m_bootstrap_tolerance=0;
+	m_max_bootstrap_iterations=0;
 	m_null_approximation_method=BOOTSTRAP;
 }
 
@@ -47,6 +56,16 @@ void CTestStatistic::set_bootstrap_iterations(index_t
 	m_bootstrap_iterations=bootstrap_iterations;
 }
 
+void CTestStatistic::set_bootstrap_early_stopping(float64_t tolerance,
+		index_t max_iterations)
+{
+	REQUIRE(tolerance>=0, "%s::set_bootstrap_early_stopping(): Tolerance "
+			"must not be negative\n", get_name());
+
+	m_bootstrap_tolerance=tolerance;
+	m_max_bootstrap_iterations=max_iterations;
+}
+
 float64_t CTestStatistic::perform_test()
 {
 	/* baseline method here is simply to compute statistic and p-value
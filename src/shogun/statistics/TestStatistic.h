@@ -119,6 +119,20 @@ class CTestStatistic : public CSGObject
 		 */
 		virtual void set_bootstrap_iterations(index_t bootstrap_iterations);
 
+		/** enables sequential bootstrapping for p-value computation: the
+		 * null-distribution is sampled in rounds of m_bootstrap_iterations
+		 * samples until the half width of the 95% confidence interval of the
+		 * p-value drops below the given tolerance, or until max_iterations
+		 * samples were drawn. The interval narrows fastest for p-values
+		 * close to zero or one, i.e. for clear test decisions
+		 *
+		 * @param tolerance half width of confidence interval at which
+		 * sampling stops, 0 disables early stopping (default)
+		 * @param max_iterations maximum number of samples in total
+		 */
+		virtual void set_bootstrap_early_stopping(float64_t tolerance,
+				index_t max_iterations);
+
 		/** sets the method how to approximate the null-distribution
 		 * @param null_approximation_method method to use
 		 */
@@ -137,6 +151,12 @@ class CTestStatistic : public CSGObject
 		/** number of iterations for bootstrapping null-distributions */
 		index_t m_bootstrap_iterations;
 
+		/** confidence interval half width for sequential bootstrapping */
+		float64_t m_bootstrap_tolerance;
+
+		/** maximum number of samples for sequential bootstrapping */
+		index_t m_max_bootstrap_iterations;
+
 		/** Defines how the the null distribution is approximated */
 		ENullApproximationMethod m_null_approximation_method;
 };
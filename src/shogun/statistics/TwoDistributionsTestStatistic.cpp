@@ -9,6 +9,7 @@
 
 #include <shogun/statistics/TwoDistributionsTestStatistic.h>
 #include <shogun/features/Features.h>
+#include <shogun/mathematics/Math.h>
 
 using namespace shogun;
 
@@ -97,7 +98,11 @@ float64_t CTwoDistributionsTestStatistic::compute_p_value(
 {
 	float64_t result=0;
 
-	if (m_null_approximation_method==BOOTSTRAP)
+	if (m_null_approximation_method==BOOTSTRAP && m_bootstrap_tolerance>0)
+	{
+		result=compute_p_value_sequential(statistic);
+	}
+	else if (m_null_approximation_method==BOOTSTRAP)
 	{
 		/* bootstrap a bunch of MMD values from null distribution */
 		SGVector<float64_t> values=bootstrap_null();
@@ -118,6 +123,45 @@ float64_t CTwoDistributionsTestStatistic::compute_p_value(
 	return result;
 }
 
+float64_t CTwoDistributionsTestStatistic::compute_p_value_sequential(
+		float64_t statistic)
+{
+	REQUIRE(m_bootstrap_iterations>0, "%s::compute_p_value_sequential(): "
+			"Number of bootstrap iterations has to be positive\n", get_name());
+
+	index_t num_samples=0;
+	index_t num_larger=0;
+	float64_t result=0;
+
+	while (true)
+	{
+		/* one round of samples from null distribution */
+		SGVector<float64_t> values=bootstrap_null();
+		for (index_t i=0; i<values.vlen; ++i)
+		{
+			if (values[i]>statistic)
+				num_larger++;
+		}
+		num_samples+=values.vlen;
+		result=((float64_t) num_larger)/num_samples;
+
+		/* normal approximation of the binomial proportion, shrunk towards
+		 * 1/2 such that the interval does not collapse for p-values of 0 */
+		float64_t p=(num_larger+1.0)/(num_samples+2.0);
+		float64_t half_width=1.959964*CMath::sqrt(p*(1-p)/num_samples);
+
+		SG_DEBUG("%s::compute_p_value_sequential(): %d samples, p-value %f "
+				"+- %f\n", get_name(), num_samples, result, half_width);
+
+		if (half_width<=m_bootstrap_tolerance ||
+				(m_max_bootstrap_iterations>0 &&
+				 num_samples>=m_max_bootstrap_iterations))
+			break;
+	}
+
+	return result;
+}
+
 float64_t CTwoDistributionsTestStatistic::compute_threshold(
 		float64_t alpha)
 {
@@ -99,6 +99,15 @@ class CTwoDistributionsTestStatistic : public CTestStatistic
 
 		virtual const char* get_name() const=0;
 
+	protected:
+		/** computes a p-value by sequential bootstrapping, see
+		 * set_bootstrap_early_stopping()
+		 *
+		 * @param statistic statistic value to compute the p-value for
+		 * @return fraction of null samples larger than statistic
+		 */
+		float64_t compute_p_value_sequential(float64_t statistic);
+
 	private:
 		void init();
 
@@ -0,0 +1,131 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/classifier/svm/LibLinear.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SparseFeatures.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static CDotFeatures* create_data(int32_t dim, int32_t num, bool sparse,
+		CBinaryLabels*& labels)
+{
+	SGMatrix<float64_t> matrix(dim, num);
+	SGVector<float64_t> lab(num);
+	for (index_t i=0; i<num; i++)
+	{
+		lab[i]=i%2 ? 1 : -1;
+		for (index_t j=0; j<dim; j++)
+		{
+			if (sparse && CMath::random(0, 3))
+				matrix(j,i)=0;
+			else
+				matrix(j,i)=CMath::randn_double()+(j%3==0 ? lab[i] : 0);
+		}
+	}
+
+	labels=new CBinaryLabels(lab);
+	if (sparse)
+		return new CSparseFeatures<float64_t>(matrix);
+
+	return new CDenseFeatures<float64_t>(matrix);
+}
+
+static SGVector<float64_t> train_w(CLibLinear* svm, int32_t num_threads)
+{
+	svm->parallel->set_num_threads(num_threads);
+	svm->train();
+
+	SGVector<float64_t> w=svm->get_w();
+	SGVector<float64_t> result(w.vlen+1);
+	for (index_t j=0; j<w.vlen; j++)
+		result[j]=w[j];
+	result[w.vlen]=svm->get_bias();
+
+	return result;
+}
+
+/* regularized primal objective, the bias is regularized as well */
+static float64_t primal_objective(CDotFeatures* features, CBinaryLabels* labels,
+		SGVector<float64_t> w, LIBLINEAR_SOLVER_TYPE st)
+{
+	int32_t dim=w.vlen-1;
+	float64_t obj=0.5*SGVector<float64_t>::dot(w.vector, w.vector, w.vlen);
+	for (index_t i=0; i<features->get_num_vectors(); i++)
+	{
+		float64_t margin=labels->get_label(i)*
+			(features->dense_dot(i, w.vector, dim)+w[dim]);
+		float64_t loss=CMath::max(0.0, 1-margin);
+		obj+=st==L2R_L1LOSS_SVC_DUAL ? loss : loss*loss;
+	}
+
+	return obj;
+}
+
+static void check_same_solution(LIBLINEAR_SOLVER_TYPE reference,
+		LIBLINEAR_SOLVER_TYPE st, bool sparse, float64_t accuracy)
+{
+	CMath::init_random(17);
+
+	CBinaryLabels* labels;
+	CDotFeatures* features=create_data(20, 500, sparse, labels);
+
+	CLibLinear* svm=new CLibLinear(1.0, features, labels);
+	SG_REF(svm);
+	svm->set_epsilon(1e-8);
+	svm->set_liblinear_solver_type(reference);
+	SGVector<float64_t> expected=train_w(svm, 1);
+
+	svm->set_liblinear_solver_type(st);
+	SGVector<float64_t> w=train_w(svm, 4);
+	for (index_t j=0; j<w.vlen; j++)
+		EXPECT_NEAR(w[j], expected[j], accuracy);
+
+	if (reference!=L2R_LR)
+	{
+		float64_t expected_obj=primal_objective(features, labels, expected,
+				reference);
+		EXPECT_NEAR(primal_objective(features, labels, w, reference),
+				expected_obj, 1E-5*expected_obj);
+	}
+
+	SG_UNREF(svm);
+}
+
+TEST(LibLinear, tron_l2r_lr_parallel)
+{
+	check_same_solution(L2R_LR, L2R_LR, false, 1E-6);
+	check_same_solution(L2R_LR, L2R_LR, true, 1E-6);
+}
+
+TEST(LibLinear, tron_l2r_l2loss_svc_parallel)
+{
+	check_same_solution(L2R_L2LOSS_SVC, L2R_L2LOSS_SVC, false, 1E-6);
+	check_same_solution(L2R_L2LOSS_SVC, L2R_L2LOSS_SVC, true, 1E-6);
+}
+
+TEST(LibLinear, l2r_l1loss_svc_dual_async)
+{
+	/* the hinge loss leaves w less determined than its objective */
+	check_same_solution(L2R_L1LOSS_SVC_DUAL, L2R_L1LOSS_SVC_DUAL_ASYNC,
+			false, 1E-3);
+	check_same_solution(L2R_L1LOSS_SVC_DUAL, L2R_L1LOSS_SVC_DUAL_ASYNC,
+			true, 1E-3);
+}
+
+TEST(LibLinear, l2r_l2loss_svc_dual_async)
+{
+	check_same_solution(L2R_L2LOSS_SVC_DUAL, L2R_L2LOSS_SVC_DUAL_ASYNC,
+			false, 1E-4);
+	check_same_solution(L2R_L2LOSS_SVC_DUAL, L2R_L2LOSS_SVC_DUAL_ASYNC,
+			true, 1E-4);
+}
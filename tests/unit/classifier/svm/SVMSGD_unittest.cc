@@ -0,0 +1,309 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/classifier/svm/SVMSGD.h>
+#include <shogun/classifier/svm/SGDQN.h>
+#include <shogun/classifier/svm/OnlineSVMSGD.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SparseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/loss/LogLoss.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+/* unit norm vectors, as assumed by the initial learning rate of SGD. Only
+ * the first coordinate depends on the class, most others are zero such that
+ * the data is sparse */
+static SGMatrix<float64_t> create_unit_norm_data(int32_t dim, int32_t num,
+		SGVector<float64_t>& lab)
+{
+	SGMatrix<float64_t> matrix(dim, num);
+	matrix.zero();
+	lab=SGVector<float64_t>(num);
+	for (index_t i=0; i<num; i++)
+	{
+		lab[i]=i%2 ? 1 : -1;
+		matrix(0,i)=2*lab[i]+0.5*CMath::randn_double();
+		for (index_t j=1; j<dim; j++)
+		{
+			if (!CMath::random(0, 3))
+				matrix(j,i)=0.5*CMath::randn_double();
+		}
+
+		float64_t norm=SGVector<float64_t>::twonorm(matrix.get_column_vector(i),
+				dim);
+		for (index_t j=0; j<dim; j++)
+			matrix(j,i)/=norm;
+	}
+
+	return matrix;
+}
+
+/* SVMSGD with hinge loss as it was before mini-batches, one update per
+ * example */
+static SGVector<float64_t> train_per_example(CDotFeatures* features,
+		SGVector<float64_t> lab, float64_t C, int32_t epochs, float64_t& bias)
+{
+	int32_t num_vec=features->get_num_vectors();
+	int32_t dim=features->get_dim_feature_space();
+	SGVector<float64_t> w(dim);
+	w.zero();
+	bias=0;
+
+	float64_t lambda=1.0/(C*num_vec);
+	/* the hinge loss has derivative -1 at -typw */
+	float64_t maxw=1.0/CMath::sqrt(lambda);
+	float64_t eta0=CMath::sqrt(maxw);
+	float64_t t=1/(eta0*lambda);
+
+	/* calibrate */
+	SGVector<float64_t> c(dim);
+	c.zero();
+	int32_t n=0;
+	float64_t m=0;
+	float64_t r=0;
+	for (int32_t j=0; j<num_vec && m<=1000; j++, n++)
+	{
+		r+=features->get_nnz_features_for_vector(j);
+		features->add_to_dense_vec(1, j, c.vector, dim, true);
+		m=SGVector<float64_t>::max(c.vector, dim);
+	}
+	float64_t bscale=0.5*m/n;
+	int32_t skip=(int32_t) ((16*n*dim)/r);
+
+	for (int32_t e=0; e<epochs; e++)
+	{
+		int32_t count=skip;
+		for (int32_t i=0; i<num_vec; i++)
+		{
+			float64_t eta=1.0/(lambda*t);
+			float64_t y=lab[i];
+			float64_t z=y*(features->dense_dot(i, w.vector, dim)+bias);
+
+			if (z<1)
+			{
+				features->add_to_dense_vec(eta*y, i, w.vector, dim);
+				bias+=eta*y*bscale;
+			}
+
+			if (--count<=0)
+			{
+				float64_t decay=1-eta*lambda*skip;
+				if (decay<0.8)
+					decay=CMath::pow(1-eta*lambda, skip);
+				SGVector<float64_t>::scale_vector(decay, w.vector, dim);
+				count=skip;
+			}
+			t++;
+		}
+	}
+
+	return w;
+}
+
+static float64_t accuracy(CLinearMachine* machine, CFeatures* features,
+		CBinaryLabels* labels)
+{
+	CBinaryLabels* output=machine->apply_binary(features);
+	int32_t correct=0;
+	for (index_t i=0; i<output->get_num_labels(); i++)
+		correct+=output->get_label(i)==labels->get_label(i);
+	SG_UNREF(output);
+
+	return float64_t(correct)/labels->get_num_labels();
+}
+
+static void check_accuracy(CLinearMachine* machine, CSGDEngine* engine,
+		bool sparse)
+{
+	CMath::init_random(17);
+
+	SGVector<float64_t> lab;
+	SGMatrix<float64_t> matrix=create_unit_norm_data(20, 2000, lab);
+	CDotFeatures* features;
+	if (sparse)
+		features=new CSparseFeatures<float64_t>(matrix);
+	else
+		features=new CDenseFeatures<float64_t>(matrix);
+	CBinaryLabels* labels=new CBinaryLabels(lab);
+	SG_REF(features);
+	SG_REF(labels);
+
+	machine->set_labels(labels);
+	machine->parallel->set_num_threads(4);
+
+	/* the data is separable by the first coordinates up to ~10% */
+	const int32_t batch_sizes[]={1, 16};
+	for (index_t b=0; b<2; b++)
+	{
+		engine->set_batch_size(batch_sizes[b]);
+		machine->train(features);
+		EXPECT_GT(accuracy(machine, features, labels), 0.9);
+	}
+
+	SG_UNREF(features);
+	SG_UNREF(labels);
+}
+
+TEST(SVMSGD, train_synchronous)
+{
+	CSVMSGD* svm=new CSVMSGD(1.0);
+	SG_REF(svm);
+	CSGDEngine* engine=svm->get_engine();
+	engine->set_thread_mode(SGD_SYNCHRONOUS);
+
+	check_accuracy(svm, engine, false);
+	check_accuracy(svm, engine, true);
+
+	SG_UNREF(engine);
+	SG_UNREF(svm);
+}
+
+TEST(SVMSGD, single_example_batches_match_per_example)
+{
+	CMath::init_random(17);
+
+	SGVector<float64_t> lab;
+	SGMatrix<float64_t> matrix=create_unit_norm_data(20, 500, lab);
+	CDotFeatures* features[2]={new CDenseFeatures<float64_t>(matrix),
+		new CSparseFeatures<float64_t>(matrix)};
+	CBinaryLabels* labels=new CBinaryLabels(lab);
+	SG_REF(labels);
+
+	CSVMSGD* svm=new CSVMSGD(1.0);
+	SG_REF(svm);
+	svm->set_labels(labels);
+	svm->parallel->set_num_threads(1);
+	CSGDEngine* engine=svm->get_engine();
+	engine->set_batch_size(1);
+	engine->set_thread_mode(SGD_SYNCHRONOUS);
+
+	for (index_t f=0; f<2; f++)
+	{
+		SG_REF(features[f]);
+		svm->train(features[f]);
+
+		float64_t bias;
+		SGVector<float64_t> expected=train_per_example(features[f], lab, 1.0,
+				5, bias);
+		SGVector<float64_t> w=svm->get_w();
+		ASSERT_EQ(w.vlen, expected.vlen);
+		for (index_t j=0; j<w.vlen; j++)
+			EXPECT_NEAR(w[j], expected[j], 1E-12);
+		EXPECT_NEAR(svm->get_bias(), bias, 1E-12);
+		EXPECT_GT(accuracy(svm, features[f], labels), 0.9);
+
+		SG_UNREF(features[f]);
+	}
+
+	SG_UNREF(engine);
+	SG_UNREF(svm);
+	SG_UNREF(labels);
+}
+
+TEST(SVMSGD, train_hogwild)
+{
+	CSVMSGD* svm=new CSVMSGD(1.0);
+	SG_REF(svm);
+	CSGDEngine* engine=svm->get_engine();
+	engine->set_thread_mode(SGD_HOGWILD);
+
+	check_accuracy(svm, engine, false);
+	check_accuracy(svm, engine, true);
+
+	SG_UNREF(engine);
+	SG_UNREF(svm);
+}
+
+TEST(SVMSGD, train_averaging)
+{
+	CSVMSGD* svm=new CSVMSGD(1.0);
+	SG_REF(svm);
+	CSGDEngine* engine=svm->get_engine();
+	engine->set_thread_mode(SGD_AVERAGING);
+
+	check_accuracy(svm, engine, false);
+	check_accuracy(svm, engine, true);
+
+	SG_UNREF(engine);
+	SG_UNREF(svm);
+}
+
+TEST(SVMSGD, train_log_loss)
+{
+	CSVMSGD* svm=new CSVMSGD(1.0);
+	SG_REF(svm);
+	svm->set_loss_function(new CLogLoss());
+	CSGDEngine* engine=svm->get_engine();
+
+	check_accuracy(svm, engine, false);
+
+	SG_UNREF(engine);
+	SG_UNREF(svm);
+}
+
+TEST(SGDQN, train)
+{
+	CSGDQN* svm=new CSGDQN(1.0);
+	SG_REF(svm);
+	CSGDEngine* engine=svm->get_engine();
+	EXPECT_TRUE(engine->get_quasi_newton());
+
+	check_accuracy(svm, engine, false);
+	check_accuracy(svm, engine, true);
+
+	SG_UNREF(engine);
+	SG_UNREF(svm);
+}
+
+TEST(OnlineSVMSGD, train_mini_batch)
+{
+	CMath::init_random(17);
+
+	SGVector<float64_t> lab;
+	SGMatrix<float64_t> matrix=create_unit_norm_data(20, 2000, lab);
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(matrix);
+	CBinaryLabels* labels=new CBinaryLabels(lab);
+	SG_REF(features);
+	SG_REF(labels);
+
+	COnlineSVMSGD* svm=new COnlineSVMSGD(1.0);
+	SG_REF(svm);
+	svm->set_epochs(2);
+	CSGDEngine* engine=svm->get_engine();
+
+	const int32_t batch_sizes[]={1, 16};
+	for (index_t b=0; b<2; b++)
+	{
+		engine->set_batch_size(batch_sizes[b]);
+
+		CStreamingDenseFeatures<float64_t>* stream=
+			new CStreamingDenseFeatures<float64_t>(features, lab.vector);
+		svm->train(stream);
+
+		SGVector<float32_t> w=svm->get_w();
+		int32_t correct=0;
+		for (index_t i=0; i<matrix.num_cols; i++)
+		{
+			float64_t out=svm->get_bias();
+			for (index_t j=0; j<w.vlen; j++)
+				out+=w[j]*matrix(j,i);
+			correct+=CMath::sign(out)==lab[i];
+		}
+		EXPECT_GT(correct, 0.9*matrix.num_cols);
+	}
+
+	SG_UNREF(engine);
+	SG_UNREF(svm);
+	SG_UNREF(features);
+	SG_UNREF(labels);
+}
@@ -0,0 +1,202 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/lib/config.h>
+
+#ifdef HAVE_LAPACK
+#include <shogun/clustering/GMM.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+/* random mixture of three components of a covariance type */
+static CGMM* create_gmm(int32_t dim, ECovType cov_type)
+{
+	int32_t num_comp=3;
+	vector<CGaussian*> components(num_comp);
+	SGVector<float64_t> coefficients(num_comp);
+
+	for (int32_t j=0; j<num_comp; j++)
+	{
+		components[j]=new CGaussian();
+		components[j]->set_cov_type(cov_type);
+
+		SGVector<float64_t> mean(dim);
+		for (index_t k=0; k<dim; k++)
+			mean[k]=CMath::randn_double()*3;
+		components[j]->set_mean(mean);
+
+		if (cov_type==FULL)
+		{
+			SGMatrix<float64_t> A(dim, dim);
+			SGMatrix<float64_t> cov(dim, dim);
+			for (index_t k=0; k<dim*dim; k++)
+				A.matrix[k]=CMath::randn_double();
+			for (index_t k=0; k<dim; k++)
+			{
+				for (index_t l=0; l<dim; l++)
+				{
+					cov(k,l)=k==l ? 0.5 : 0;
+					for (index_t m=0; m<dim; m++)
+						cov(k,l)+=A(k,m)*A(l,m);
+				}
+			}
+			components[j]->set_cov(cov);
+		}
+		else
+		{
+			SGVector<float64_t> d(cov_type==DIAG ? dim : 1);
+			for (index_t k=0; k<d.vlen; k++)
+				d[k]=CMath::random(0.5, 2.0);
+			components[j]->set_d(d);
+		}
+
+		coefficients[j]=j+1.0;
+	}
+
+	for (int32_t j=0; j<num_comp; j++)
+		coefficients[j]/=6.0;
+
+	return new CGMM(components, coefficients);
+}
+
+static void check_em_step(ECovType cov_type)
+{
+	CMath::init_random(17);
+
+	int32_t dim=4;
+	int32_t num=500;
+	SGMatrix<float64_t> X(dim, num);
+	for (index_t i=0; i<dim*num; i++)
+		X.matrix[i]=CMath::randn_double()*3;
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(X);
+	CGMM* gmm=create_gmm(dim, cov_type);
+	SG_REF(gmm);
+	gmm->parallel->set_num_threads(4);
+	gmm->train(features);
+
+	/* reference E-step and M-step via CGaussian::compute_log_PDF */
+	int32_t num_comp=gmm->get_num_components();
+	float64_t expected_log_likelihood=0;
+	SGMatrix<float64_t> post(num_comp, num);
+	for (index_t i=0; i<num; i++)
+	{
+		SGVector<float64_t> p=gmm->cluster(
+				SGVector<float64_t>(X.get_column_vector(i), dim, false));
+		expected_log_likelihood+=p[num_comp];
+		for (index_t j=0; j<num_comp; j++)
+			post(j,i)=CMath::exp(p[j]-p[num_comp]);
+	}
+
+	float64_t log_likelihood=gmm->train_em(1e-9, 1);
+	EXPECT_NEAR(log_likelihood, expected_log_likelihood,
+			1E-10*CMath::abs(expected_log_likelihood));
+
+	float64_t post_sum_sum=0;
+	for (index_t j=0; j<num_comp; j++)
+	{
+		float64_t post_sum=0;
+		SGVector<float64_t> mean(dim);
+		mean.zero();
+		for (index_t i=0; i<num; i++)
+		{
+			post_sum+=post(j,i);
+			for (index_t k=0; k<dim; k++)
+				mean[k]+=post(j,i)*X(k,i);
+		}
+		post_sum_sum+=post_sum;
+
+		SGVector<float64_t> trained_mean=gmm->get_nth_mean(j);
+		for (index_t k=0; k<dim; k++)
+			EXPECT_NEAR(trained_mean[k], mean[k]/post_sum, 1E-10);
+
+		SGMatrix<float64_t> cov(dim, dim);
+		cov.zero();
+		for (index_t i=0; i<num; i++)
+		{
+			for (index_t k=0; k<dim; k++)
+			{
+				for (index_t l=0; l<dim; l++)
+				{
+					cov(k,l)+=post(j,i)*(X(k,i)-mean[k]/post_sum)*
+						(X(l,i)-mean[l]/post_sum)/post_sum;
+				}
+			}
+		}
+
+		SGMatrix<float64_t> trained_cov=gmm->get_nth_cov(j);
+		float64_t trace=0;
+		for (index_t k=0; k<dim; k++)
+			trace+=cov(k,k);
+
+		for (index_t k=0; k<dim; k++)
+		{
+			for (index_t l=0; l<dim; l++)
+			{
+				float64_t expected=cov(k,l);
+				if (cov_type==DIAG && k!=l)
+					expected=0;
+				else if (cov_type==SPHERICAL)
+					expected=k==l ? trace/dim : 0;
+
+				EXPECT_NEAR(trained_cov(k,l), expected, 1E-8);
+			}
+		}
+
+		EXPECT_NEAR(gmm->get_coef()[j], post_sum/num, 1E-10);
+	}
+	EXPECT_NEAR(post_sum_sum, num, 1E-8);
+
+	SG_UNREF(gmm);
+}
+
+TEST(GMM, em_step_full)
+{
+	check_em_step(FULL);
+}
+
+TEST(GMM, em_step_diag)
+{
+	check_em_step(DIAG);
+}
+
+TEST(GMM, em_step_spherical)
+{
+	check_em_step(SPHERICAL);
+}
+
+TEST(GMM, train_em_far_points)
+{
+	CMath::init_random(17);
+
+	/* points far from all components, the log-sum-exp must not underflow */
+	int32_t num=200;
+	SGMatrix<float64_t> X(2, num);
+	for (index_t i=0; i<2*num; i++)
+		X.matrix[i]=CMath::randn_double()+(i%4<2 ? 0 : 100);
+
+	CGMM* gmm=create_gmm(2, DIAG);
+	SG_REF(gmm);
+	for (index_t j=0; j<gmm->get_num_components(); j++)
+	{
+		SGVector<float64_t> mean=gmm->get_nth_mean(j);
+		mean[0]=1000;
+	}
+
+	gmm->train(new CDenseFeatures<float64_t>(X));
+	float64_t log_likelihood=gmm->train_em(1e-9, 1);
+	EXPECT_FALSE(CMath::is_nan(log_likelihood));
+	EXPECT_GT(log_likelihood, -CMath::INFTY);
+
+	SG_UNREF(gmm);
+}
+#endif // HAVE_LAPACK
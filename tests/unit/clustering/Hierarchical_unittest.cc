@@ -0,0 +1,172 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/clustering/Hierarchical.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/distance/EuclideanDistance.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+/* distance between two clusters, computed from all their elements */
+static float64_t linkage_distance(SGMatrix<float64_t> X,
+		SGVector<int32_t> cluster, int32_t a, int32_t b, ELinkage linkage)
+{
+	int32_t dim=X.num_rows;
+	float64_t result=linkage==LINKAGE_SINGLE ? CMath::INFTY : 0;
+	SGVector<float64_t> mean_a(dim);
+	SGVector<float64_t> mean_b(dim);
+	mean_a.zero();
+	mean_b.zero();
+	int32_t n_a=0;
+	int32_t n_b=0;
+
+	for (index_t i=0; i<X.num_cols; i++)
+	{
+		if (cluster[i]==a)
+		{
+			n_a++;
+			for (index_t d=0; d<dim; d++)
+				mean_a[d]+=X(d,i);
+		}
+		if (cluster[i]==b)
+		{
+			n_b++;
+			for (index_t d=0; d<dim; d++)
+				mean_b[d]+=X(d,i);
+		}
+
+		for (index_t j=0; j<X.num_cols; j++)
+		{
+			if (cluster[i]!=a || cluster[j]!=b)
+				continue;
+
+			float64_t dist=0;
+			for (index_t d=0; d<dim; d++)
+				dist+=CMath::sq(X(d,i)-X(d,j));
+			dist=CMath::sqrt(dist);
+
+			if (linkage==LINKAGE_SINGLE)
+				result=CMath::min(result, dist);
+			else if (linkage==LINKAGE_COMPLETE)
+				result=CMath::max(result, dist);
+			else
+				result+=dist;
+		}
+	}
+
+	if (linkage==LINKAGE_AVERAGE)
+		result/=n_a*n_b;
+	else if (linkage==LINKAGE_WARD)
+	{
+		float64_t dist=0;
+		for (index_t d=0; d<dim; d++)
+			dist+=CMath::sq(mean_a[d]/n_a-mean_b[d]/n_b);
+		result=CMath::sqrt(2.0*n_a*n_b/(n_a+n_b)*dist);
+	}
+
+	return result;
+}
+
+static void check_linkage(ELinkage linkage)
+{
+	CMath::init_random(17);
+
+	int32_t num=30;
+	SGMatrix<float64_t> X(2, num);
+	for (index_t i=0; i<2*num; i++)
+		X.matrix[i]=CMath::randn_double()+(i%4 ? 0 : 5);
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(X);
+	CEuclideanDistance* distance=new CEuclideanDistance(features, features);
+
+	int32_t merges=10;
+	CHierarchical* clustering=new CHierarchical(merges, distance);
+	SG_REF(clustering);
+	clustering->set_linkage(linkage);
+	EXPECT_EQ(clustering->get_linkage(), linkage);
+	clustering->train();
+
+	/* naive agglomeration, always merging the closest clusters */
+	SGVector<int32_t> cluster(num);
+	cluster.range_fill();
+	SGVector<float64_t> expected(num-merges+1);
+	for (index_t l=0; l<num-merges+1; l++)
+	{
+		float64_t best=CMath::INFTY;
+		int32_t best_a=-1;
+		int32_t best_b=-1;
+		for (index_t a=0; a<num+l; a++)
+		{
+			for (index_t b=a+1; b<num+l; b++)
+			{
+				if (cluster.find(a).vlen==0 || cluster.find(b).vlen==0)
+					continue;
+
+				float64_t d=linkage_distance(X, cluster, a, b, linkage);
+				if (d<best)
+				{
+					best=d;
+					best_a=a;
+					best_b=b;
+				}
+			}
+		}
+
+		expected[l]=best;
+		for (index_t i=0; i<num; i++)
+		{
+			if (cluster[i]==best_a || cluster[i]==best_b)
+				cluster[i]=num+l;
+		}
+	}
+
+	SGVector<float64_t> merge_distances=clustering->get_merge_distances();
+	ASSERT_EQ(merge_distances.vlen, merges);
+	for (index_t l=0; l<merges; l++)
+		EXPECT_NEAR(merge_distances[l], expected[l], 1E-5);
+
+	SGMatrix<int32_t> pairs=clustering->get_cluster_pairs();
+	for (index_t l=0; l<merges; l++)
+		EXPECT_LT(pairs(0,l), pairs(1,l));
+
+	/* same partition */
+	SGVector<int32_t> assignment=clustering->get_assignment();
+	ASSERT_EQ(assignment.vlen, num-merges);
+	for (index_t i=0; i<assignment.vlen; i++)
+	{
+		for (index_t j=0; j<assignment.vlen; j++)
+		{
+			EXPECT_EQ(assignment[i]==assignment[j], cluster[i]==cluster[j]);
+		}
+	}
+
+	SG_UNREF(clustering);
+}
+
+TEST(Hierarchical, single_linkage)
+{
+	check_linkage(LINKAGE_SINGLE);
+}
+
+TEST(Hierarchical, complete_linkage)
+{
+	check_linkage(LINKAGE_COMPLETE);
+}
+
+TEST(Hierarchical, average_linkage)
+{
+	check_linkage(LINKAGE_AVERAGE);
+}
+
+TEST(Hierarchical, ward_linkage)
+{
+	check_linkage(LINKAGE_WARD);
+}
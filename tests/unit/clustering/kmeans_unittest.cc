@@ -11,6 +11,7 @@
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/clustering/KMeans.h>
 #include <shogun/distance/EuclideanDistance.h>
+#include <shogun/mathematics/Math.h>
 #include <gtest/gtest.h>
 
 using namespace shogun;
@@ -162,3 +163,133 @@ TEST(KMeans, minibatch_training_test)
 	SG_UNREF(features);
 }
 
+
+TEST(KMeans, elkan_hamerly_manual_center_initialization_test)
+{
+	/*create a rectangle with four points as (0,0) (0,10) (2,0) (2,10)*/
+	SGMatrix<float64_t> rect(2, 4);
+	rect(0,0)=0;
+	rect(0,1)=0;
+	rect(0,2)=2;
+	rect(0,3)=2;
+	rect(1,0)=0;
+	rect(1,1)=10;
+	rect(1,2)=0;
+	rect(1,3)=10;
+
+	/*choose local minima points (0,5) (2,5) as initial centers*/
+	SGMatrix<float64_t> initial_centers(2,2);
+	initial_centers(0,0)=0;
+	initial_centers(0,1)=2;
+	initial_centers(1,0)=5;
+	initial_centers(1,1)=5;
+
+	EKMeansMethod methods[2]={KMM_ELKAN, KMM_HAMERLY};
+	for (int32_t m=0; m<2; m++)
+	{
+		CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(rect);
+		CEuclideanDistance* distance=new CEuclideanDistance(features, features);
+		CKMeans* clustering=new CKMeans(2, distance, initial_centers, methods[m]);
+		clustering->train(features);
+
+		CMulticlassLabels* result=CLabelsFactory::to_multiclass(clustering->apply());
+		EXPECT_EQ(0.000000, result->get_label(0));
+		EXPECT_EQ(0.000000, result->get_label(1));
+		EXPECT_EQ(1.000000, result->get_label(2));
+		EXPECT_EQ(1.000000, result->get_label(3));
+
+		SGMatrix<float64_t> learnt_centers_matrix=clustering->get_cluster_centers();
+		EXPECT_EQ(0, learnt_centers_matrix(0,0));
+		EXPECT_EQ(2, learnt_centers_matrix(0,1));
+		EXPECT_EQ(5, learnt_centers_matrix(1,0));
+		EXPECT_EQ(5, learnt_centers_matrix(1,1));
+
+		SG_UNREF(result);
+		SG_UNREF(clustering);
+	}
+}
+
+TEST(KMeans, elkan_hamerly_equal_batch_lloyd)
+{
+	CMath::init_random(17);
+
+	int32_t dim=3;
+	int32_t num=300;
+	int32_t k=7;
+	SGMatrix<float64_t> data(dim, num);
+	for (int32_t i=0; i<num; i++)
+	{
+		/* some structure, but overlapping clusters */
+		float64_t offset=CMath::random(0, 4);
+		for (int32_t j=0; j<dim; j++)
+			data(j,i)=offset+CMath::randn_double();
+	}
+
+	SGMatrix<float64_t> initial_centers(dim, k);
+	for (int32_t c=0; c<k; c++)
+	{
+		for (int32_t j=0; j<dim; j++)
+			initial_centers(j,c)=data(j,c);
+	}
+
+	/* plain batch Lloyd iterations */
+	SGMatrix<float64_t> expected=initial_centers.clone();
+	SGVector<int32_t> assignment(num);
+	assignment.set_const(-1);
+	bool changed=true;
+	while (changed)
+	{
+		changed=false;
+		for (int32_t i=0; i<num; i++)
+		{
+			int32_t best=0;
+			float64_t best_dist=CMath::INFTY;
+			for (int32_t c=0; c<k; c++)
+			{
+				float64_t dist=0;
+				for (int32_t j=0; j<dim; j++)
+					dist+=CMath::sq(data(j,i)-expected(j,c));
+
+				if (dist<best_dist)
+				{
+					best_dist=dist;
+					best=c;
+				}
+			}
+			changed|=assignment[i]!=best;
+			assignment[i]=best;
+		}
+
+		SGMatrix<float64_t> sums(dim, k);
+		SGVector<int32_t> counts(k);
+		sums.zero();
+		counts.zero();
+		for (int32_t i=0; i<num; i++)
+		{
+			counts[assignment[i]]++;
+			for (int32_t j=0; j<dim; j++)
+				sums(j,assignment[i])+=data(j,i);
+		}
+
+		for (int32_t c=0; c<k; c++)
+		{
+			for (int32_t j=0; j<dim && counts[c]>0; j++)
+				expected(j,c)=sums(j,c)/counts[c];
+		}
+	}
+
+	EKMeansMethod methods[2]={KMM_ELKAN, KMM_HAMERLY};
+	for (int32_t m=0; m<2; m++)
+	{
+		CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+		CEuclideanDistance* distance=new CEuclideanDistance(features, features);
+		CKMeans* clustering=new CKMeans(k, distance, initial_centers, methods[m]);
+		clustering->train(features);
+
+		SGMatrix<float64_t> centers=clustering->get_cluster_centers();
+		for (int32_t i=0; i<dim*k; i++)
+			EXPECT_NEAR(centers[i], expected[i], 1E-10);
+
+		SG_UNREF(clustering);
+	}
+}
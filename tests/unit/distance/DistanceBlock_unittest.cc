@@ -0,0 +1,117 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/distance/EuclideanDistance.h>
+#include <shogun/distance/CosineDistance.h>
+#include <shogun/distance/ManhattanMetric.h>
+#include <shogun/distance/ChebyshewMetric.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static CDenseFeatures<float64_t>* create_features(index_t dim, index_t num)
+{
+	SGMatrix<float64_t> data(dim, num);
+	for (index_t i=0; i<dim*num; i++)
+		data.matrix[i]=CMath::randn_double();
+
+	return new CDenseFeatures<float64_t>(data);
+}
+
+/* compares the (blocked) distance matrix against single distance() calls */
+static void check_distance_matrix(CDistance* distance, CFeatures* l,
+		CFeatures* r, float64_t eps)
+{
+	distance->init(l, r);
+
+	SGMatrix<float64_t> dm=distance->get_distance_matrix();
+	ASSERT_EQ(dm.num_rows, l->get_num_vectors());
+	ASSERT_EQ(dm.num_cols, r->get_num_vectors());
+
+	for (index_t j=0; j<dm.num_cols; j++)
+	{
+		for (index_t i=0; i<dm.num_rows; i++)
+			EXPECT_NEAR(dm(i,j), distance->distance(i,j), eps);
+	}
+
+	SGMatrix<float32_t> dm32=distance->get_distance_matrix<float32_t>();
+	for (index_t j=0; j<dm.num_cols; j++)
+	{
+		for (index_t i=0; i<dm.num_rows; i++)
+			EXPECT_NEAR(dm32(i,j), dm(i,j), 1E-4);
+	}
+
+	/* a block not starting at the origin */
+	index_t num_l=l->get_num_vectors()-3;
+	index_t num_r=r->get_num_vectors()-5;
+	SGMatrix<float64_t> block(num_l, num_r);
+	distance->distance_block(block.matrix, 3, num_l, 5, num_r);
+	for (index_t j=0; j<num_r; j++)
+	{
+		for (index_t i=0; i<num_l; i++)
+			EXPECT_NEAR(block(i,j), distance->distance(i+3,j+5), eps);
+	}
+}
+
+static void check_distance(CDistance* distance, float64_t eps)
+{
+	SG_REF(distance);
+
+	/* larger than one tile to test tile boundaries */
+	CDenseFeatures<float64_t>* lhs=create_features(9, 300);
+	CDenseFeatures<float64_t>* rhs=create_features(9, 270);
+	SG_REF(lhs);
+	SG_REF(rhs);
+
+	/* symmetric and asymmetric case */
+	check_distance_matrix(distance, lhs, lhs, eps);
+	check_distance_matrix(distance, lhs, rhs, eps);
+
+	/* non-contiguous feature vectors */
+	SGVector<index_t> subset(50);
+	for (index_t i=0; i<subset.vlen; i++)
+		subset[i]=(i*7)%lhs->get_num_vectors();
+
+	lhs->add_subset(subset);
+	check_distance_matrix(distance, lhs, rhs, eps);
+	check_distance_matrix(distance, lhs, lhs, eps);
+	lhs->remove_subset();
+
+	distance->cleanup();
+	SG_UNREF(lhs);
+	SG_UNREF(rhs);
+	SG_UNREF(distance);
+}
+
+TEST(DistanceBlockTest, euclidean_distance_matrix)
+{
+	/* identical vectors suffer from cancellation in the norm expansion */
+	check_distance(new CEuclideanDistance(), 1E-6);
+
+	CEuclideanDistance* distance=new CEuclideanDistance();
+	distance->set_disable_sqrt(true);
+	check_distance(distance, 1E-10);
+}
+
+TEST(DistanceBlockTest, cosine_distance_matrix)
+{
+	check_distance(new CCosineDistance(), 1E-10);
+}
+
+TEST(DistanceBlockTest, manhattan_distance_matrix)
+{
+	check_distance(new CManhattanMetric(), 1E-10);
+}
+
+TEST(DistanceBlockTest, distance_block_without_block_computation)
+{
+	check_distance(new CChebyshewMetric(), 1E-10);
+}
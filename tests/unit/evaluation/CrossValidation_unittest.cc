@@ -0,0 +1,136 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/evaluation/CrossValidation.h>
+#include <shogun/evaluation/CrossValidationOutput.h>
+#include <shogun/evaluation/StratifiedCrossValidationSplitting.h>
+#include <shogun/evaluation/ContingencyTableEvaluation.h>
+#include <shogun/classifier/svm/LibSVM.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+/* records the order of all fold results it is told about */
+class CFoldResultRecorder : public CCrossValidationOutput
+{
+public:
+	CFoldResultRecorder() : CCrossValidationOutput(), num_results(0) { }
+
+	virtual void update_evaluation_result(float64_t result,
+			const char* prefix="")
+	{
+		results[num_results++]=result;
+	}
+
+	virtual void update_trained_machine(CMachine* machine,
+			const char* prefix="")
+	{
+		EXPECT_TRUE(machine!=NULL);
+	}
+
+	virtual const char* get_name() const { return "FoldResultRecorder"; }
+
+	float64_t results[100];
+	int32_t num_results;
+};
+
+static float64_t cross_validate(bool parallel_folds, CFoldResultRecorder* recorder,
+		bool autolock=false, bool* trained=NULL)
+{
+	index_t num=100;
+	SGMatrix<float64_t> data(2, num);
+	SGVector<float64_t> lab(num);
+	for (index_t i=0; i<num; i++)
+	{
+		lab[i]=i%2 ? 1 : -1;
+		data(0,i)=CMath::randn_double()+lab[i];
+		data(1,i)=CMath::randn_double();
+	}
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+	CBinaryLabels* labels=new CBinaryLabels(lab);
+	CLibSVM* svm=new CLibSVM(1.0, new CGaussianKernel(10, 2.0), labels);
+
+	CStratifiedCrossValidationSplitting* splitting=
+			new CStratifiedCrossValidationSplitting(labels, 5);
+	CCrossValidation* cross=new CCrossValidation(svm, features, labels,
+			splitting, new CContingencyTableEvaluation(ACCURACY), autolock);
+	cross->set_num_runs(3);
+	cross->set_parallel_folds(parallel_folds);
+	cross->parallel->set_num_threads(4);
+	cross->add_cross_validation_output(recorder);
+
+	CCrossValidationResult* result=(CCrossValidationResult*) cross->evaluate();
+	float64_t mean=result->mean;
+
+	/* the attached machine is only trained by serial evaluation */
+	if (trained)
+		*trained=svm->get_num_support_vectors()>0;
+
+	SG_UNREF(result);
+	SG_UNREF(cross);
+	return mean;
+}
+
+TEST(CrossValidation, parallel_folds_equal_serial)
+{
+	CFoldResultRecorder* serial=new CFoldResultRecorder();
+	CFoldResultRecorder* parallel=new CFoldResultRecorder();
+	SG_REF(serial);
+	SG_REF(parallel);
+
+	CMath::init_random(17);
+	float64_t serial_mean=cross_validate(false, serial);
+	CMath::init_random(17);
+	float64_t parallel_mean=cross_validate(true, parallel);
+
+	EXPECT_NEAR(serial_mean, parallel_mean, 1E-12);
+
+	/* listeners see the same folds in the same order */
+	ASSERT_EQ(serial->num_results, 15);
+	ASSERT_EQ(parallel->num_results, 15);
+	for (int32_t i=0; i<15; i++)
+		EXPECT_NEAR(serial->results[i], parallel->results[i], 1E-12);
+
+	SG_UNREF(serial);
+	SG_UNREF(parallel);
+}
+
+TEST(CrossValidation, parallel_folds_with_autolock)
+{
+	CFoldResultRecorder* serial=new CFoldResultRecorder();
+	CFoldResultRecorder* parallel=new CFoldResultRecorder();
+	SG_REF(serial);
+	SG_REF(parallel);
+
+	bool serial_trained=false;
+	bool parallel_trained=true;
+	CMath::init_random(17);
+	float64_t serial_mean=cross_validate(false, serial, true, &serial_trained);
+	CMath::init_random(17);
+	float64_t parallel_mean=cross_validate(true, parallel, true,
+			&parallel_trained);
+
+	/* autolocking does not prevent evaluating folds in parallel */
+	EXPECT_TRUE(serial_trained);
+	EXPECT_FALSE(parallel_trained);
+	EXPECT_NEAR(serial_mean, parallel_mean, 1E-12);
+
+	ASSERT_EQ(serial->num_results, 15);
+	ASSERT_EQ(parallel->num_results, 15);
+	for (int32_t i=0; i<15; i++)
+		EXPECT_NEAR(serial->results[i], parallel->results[i], 1E-12);
+
+	SG_UNREF(serial);
+	SG_UNREF(parallel);
+}
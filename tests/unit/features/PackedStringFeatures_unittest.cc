@@ -0,0 +1,245 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/features/PackedStringFeatures.h>
+#include <shogun/features/StringFeatures.h>
+#include <shogun/kernel/string/WeightedDegreeStringKernel.h>
+#include <shogun/lib/SGStringList.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static CStringFeatures<char>* create_strings(const char* symbols,
+		EAlphabet alpha, index_t num, index_t min_len, index_t max_len)
+{
+	index_t num_symbols=strlen(symbols);
+	SGStringList<char> list(num, max_len);
+
+	for (index_t i=0; i<num; i++)
+	{
+		index_t len=CMath::random(min_len, max_len);
+		list.strings[i]=SGString<char>(len);
+		for (index_t j=0; j<len; j++)
+			list.strings[i].string[j]=symbols[CMath::random(0, num_symbols-1)];
+	}
+
+	return new CStringFeatures<char>(list, alpha);
+}
+
+static void check_unpacked(CStringFeatures<char>* sf, CPackedStringFeatures* pf)
+{
+	ASSERT_EQ(pf->get_num_vectors(), sf->get_num_vectors());
+	EXPECT_EQ(pf->get_max_vector_length(), sf->get_max_vector_length());
+
+	CAlphabet* alpha=sf->get_alphabet();
+	for (index_t i=0; i<sf->get_num_vectors(); i++)
+	{
+		int32_t len, plen;
+		bool free_vec, free_pvec;
+		char* vec=sf->get_feature_vector(i, len, free_vec);
+		char* pvec=pf->get_feature_vector(i, plen, free_pvec);
+
+		ASSERT_EQ(plen, len);
+		for (index_t j=0; j<len; j++)
+		{
+			EXPECT_EQ(pvec[j], vec[j]);
+			EXPECT_EQ(pf->get_symbol(i, j), alpha->remap_to_bin(vec[j]));
+		}
+
+		/* unaligned part of the string */
+		if (len>3)
+		{
+			SGVector<int32_t> bin(len-3);
+			pf->get_bin_vector(i, 3, len-3, bin.vector);
+			for (index_t j=0; j<len-3; j++)
+				EXPECT_EQ(bin[j], alpha->remap_to_bin(vec[j+3]));
+		}
+
+		sf->free_feature_vector(vec, i, free_vec);
+		pf->free_feature_vector(pvec, i, free_pvec);
+	}
+	SG_UNREF(alpha);
+}
+
+TEST(PackedStringFeatures, pack_dna)
+{
+	CMath::init_random(17);
+
+	CStringFeatures<char>* sf=create_strings("ACGT", DNA, 20, 1, 100);
+	CPackedStringFeatures* pf=new CPackedStringFeatures(sf);
+	SG_REF(sf);
+	SG_REF(pf);
+
+	EXPECT_EQ(pf->get_bits_per_symbol(), 2);
+	EXPECT_EQ(pf->get_symbols_per_word(), 32);
+	check_unpacked(sf, pf);
+
+	CPackedStringFeatures* copy=(CPackedStringFeatures*) pf->duplicate();
+	check_unpacked(sf, copy);
+	SG_UNREF(copy);
+
+	SG_UNREF(pf);
+	SG_UNREF(sf);
+}
+
+TEST(PackedStringFeatures, pack_iupac)
+{
+	CMath::init_random(17);
+
+	CStringFeatures<char>* sf=create_strings("ACGTURYMKWSBDHVN",
+			IUPAC_NUCLEIC_ACID, 20, 1, 50);
+	CPackedStringFeatures* pf=new CPackedStringFeatures(sf);
+	SG_REF(sf);
+	SG_REF(pf);
+
+	EXPECT_EQ(pf->get_bits_per_symbol(), 4);
+	check_unpacked(sf, pf);
+
+	SG_UNREF(pf);
+	SG_UNREF(sf);
+}
+
+TEST(PackedStringFeatures, match_length)
+{
+	CMath::init_random(17);
+
+	/* few symbols, such that there are long matches */
+	CStringFeatures<char>* sf=create_strings("AAAAAAAAAAAAAAAC", DNA, 10, 100,
+			100);
+	CPackedStringFeatures* pf=new CPackedStringFeatures(sf);
+	SG_REF(sf);
+	SG_REF(pf);
+
+	for (index_t t=0; t<1000; t++)
+	{
+		int32_t a=CMath::random(0, 9);
+		int32_t b=CMath::random(0, 9);
+		int32_t pos_a=CMath::random(0, 99);
+		int32_t pos_b=CMath::random(0, 99);
+		int32_t max_len=CMath::min(100-pos_a, 100-pos_b);
+
+		int32_t expected=0;
+		while (expected<max_len &&
+				pf->get_symbol(a, pos_a+expected)==pf->get_symbol(b, pos_b+expected))
+			expected++;
+
+		EXPECT_EQ(pf->match_length(a, pos_a, pf, b, pos_b, max_len), expected);
+	}
+
+	SG_UNREF(pf);
+	SG_UNREF(sf);
+}
+
+TEST(PackedStringFeatures, obtain_from_packed)
+{
+	CMath::init_random(17);
+
+	CStringFeatures<char>* sf=create_strings("ACGT", DNA, 10, 20, 80);
+	CPackedStringFeatures* pf=new CPackedStringFeatures(sf);
+	SG_REF(sf);
+	SG_REF(pf);
+
+	int32_t order=8;
+	for (index_t rev=0; rev<2; rev++)
+	{
+		for (int32_t start=0; start<order; start+=order-1)
+		{
+			CStringFeatures<uint16_t>* from_char=
+				new CStringFeatures<uint16_t>(DNA);
+			from_char->obtain_from_char(sf, start, order, 0, rev==1);
+			CStringFeatures<uint16_t>* from_packed=
+				new CStringFeatures<uint16_t>(DNA);
+			from_packed->obtain_from_packed(pf, start, order, rev==1);
+
+			ASSERT_EQ(from_packed->get_num_vectors(), from_char->get_num_vectors());
+			EXPECT_EQ(from_packed->get_num_symbols(), from_char->get_num_symbols());
+
+			for (index_t i=0; i<from_char->get_num_vectors(); i++)
+			{
+				int32_t len, plen;
+				bool free_vec, free_pvec;
+				uint16_t* vec=from_char->get_feature_vector(i, len, free_vec);
+				uint16_t* pvec=from_packed->get_feature_vector(i, plen, free_pvec);
+
+				ASSERT_EQ(plen, len);
+				for (index_t j=0; j<len; j++)
+					EXPECT_EQ(pvec[j], vec[j]);
+
+				from_char->free_feature_vector(vec, i, free_vec);
+				from_packed->free_feature_vector(pvec, i, free_pvec);
+			}
+
+			SG_UNREF(from_packed);
+			SG_UNREF(from_char);
+		}
+	}
+
+	SG_UNREF(pf);
+	SG_UNREF(sf);
+}
+
+TEST(PackedStringFeatures, weighted_degree_kernel)
+{
+	CMath::init_random(17);
+
+	CStringFeatures<char>* sf=create_strings("ACGT", DNA, 15, 70, 70);
+	CPackedStringFeatures* pf=new CPackedStringFeatures(sf);
+	SG_REF(sf);
+	SG_REF(pf);
+
+	CWeightedDegreeStringKernel* kernel=new CWeightedDegreeStringKernel(10);
+	SG_REF(kernel);
+
+	kernel->init(sf, sf);
+	SGMatrix<float64_t> expected=kernel->get_kernel_matrix();
+	kernel->init(pf, pf);
+	SGMatrix<float64_t> packed=kernel->get_kernel_matrix();
+
+	for (index_t i=0; i<expected.num_rows*expected.num_cols; i++)
+		EXPECT_NEAR(packed[i], expected[i], 1E-10);
+
+	/* without block computation the strings are decoded */
+	kernel->set_use_block_computation(false);
+	kernel->init(pf, pf);
+	packed=kernel->get_kernel_matrix();
+	for (index_t i=0; i<expected.num_rows*expected.num_cols; i++)
+		EXPECT_NEAR(packed[i], expected[i], 1E-10);
+
+	/* linadd reads the symbols from the packed words */
+	SGVector<int32_t> idx(15);
+	SGVector<float64_t> alphas(15);
+	SGVector<int32_t> vec_idx(15);
+	for (index_t i=0; i<15; i++)
+	{
+		idx[i]=i;
+		vec_idx[i]=i;
+		alphas[i]=CMath::random(-1.0, 1.0);
+	}
+
+	SGVector<float64_t> result(15);
+	result.zero();
+	kernel->compute_batch(15, vec_idx.vector, result.vector, 15, idx.vector,
+			alphas.vector, 1.0);
+	kernel->init_optimization(15, idx.vector, alphas.vector);
+
+	for (index_t j=0; j<15; j++)
+	{
+		float64_t sum=0;
+		for (index_t i=0; i<15; i++)
+			sum+=alphas[i]*kernel->kernel(i, j);
+
+		EXPECT_NEAR(kernel->compute_optimized(j), sum, 1E-5*CMath::abs(sum));
+		EXPECT_NEAR(result[j], sum, 1E-5*CMath::abs(sum));
+	}
+
+	SG_UNREF(kernel);
+	SG_UNREF(pf);
+	SG_UNREF(sf);
+}
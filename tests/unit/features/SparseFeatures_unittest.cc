@@ -1,6 +1,7 @@
 #include <shogun/io/SerializableAsciiFile.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/features/SparseFeatures.h>
+#include <shogun/mathematics/Math.h>
 #include <gtest/gtest.h>
 
 using namespace shogun;
@@ -392,3 +393,224 @@ TEST(SparseFeaturesTest,subset_get_full_feature_vector_smaller)
 
 	SG_UNREF(features);
 }
+
+static SGMatrix<float64_t> create_sparse_data(index_t dim, index_t num)
+{
+	SGMatrix<float64_t> data(dim, num);
+	for (index_t i=0; i<dim*num; ++i)
+		data.matrix[i]=CMath::random(0, 3)==0 ? CMath::randn_double() : 0;
+
+	return data;
+}
+
+TEST(SparseFeaturesTest,csr_constructor)
+{
+	/* 3x4 matrix with an empty vector */
+	index_t indptr[]={0, 2, 2, 3, 5};
+	index_t indices[]={0, 2, 1, 0, 1};
+	float64_t values[]={1, 2, 3, 4, 5};
+
+	CSparseFeatures<float64_t>* features=new CSparseFeatures<float64_t>(
+			SGVector<index_t>(indptr, 5, false),
+			SGVector<index_t>(indices, 5, false),
+			SGVector<float64_t>(values, 5, false), 3);
+
+	EXPECT_TRUE(features->is_csr());
+	EXPECT_EQ(features->get_num_features(), 3);
+	EXPECT_EQ(features->get_num_vectors(), 4);
+	EXPECT_EQ(features->get_num_nonzero_entries(), 5);
+	EXPECT_EQ(features->get_nnz_features_for_vector(1), 0);
+
+	/* buffers are used without copying */
+	EXPECT_EQ(features->get_csr_values().vector, values);
+
+	SGMatrix<float64_t> full=features->get_full_feature_matrix();
+	EXPECT_EQ(full(0,0), 1);
+	EXPECT_EQ(full(2,0), 2);
+	EXPECT_EQ(full(1,2), 3);
+	EXPECT_EQ(full(0,3), 4);
+	EXPECT_EQ(full(1,3), 5);
+	EXPECT_EQ(full(1,1), 0);
+
+	SGSparseVector<float64_t> sv=features->get_sparse_feature_vector(3);
+	EXPECT_EQ(sv.num_feat_entries, 2);
+	EXPECT_EQ(sv.features[1].feat_index, 1);
+	EXPECT_EQ(sv.features[1].entry, 5);
+	features->free_sparse_feature_vector(3);
+
+	SG_UNREF(features);
+}
+
+TEST(SparseFeaturesTest,csr_dense_dot_and_add_to_dense_vec)
+{
+	index_t dim=50;
+	index_t num=40;
+	SGMatrix<float64_t> data=create_sparse_data(dim, num);
+
+	CSparseFeatures<float64_t>* sv_features=new CSparseFeatures<float64_t>(data);
+	CSparseFeatures<float64_t>* csr_features=new CSparseFeatures<float64_t>(data);
+	SG_REF(sv_features);
+	SG_REF(csr_features);
+	csr_features->convert_to_csr();
+	EXPECT_TRUE(csr_features->is_csr());
+	EXPECT_FALSE(sv_features->is_csr());
+	EXPECT_EQ(csr_features->get_num_nonzero_entries(),
+			sv_features->get_num_nonzero_entries());
+
+	SGVector<float64_t> w(dim);
+	for (index_t i=0; i<dim; ++i)
+		w[i]=CMath::randn_double();
+
+	SGVector<float64_t> alphas(num);
+	for (index_t i=0; i<num; ++i)
+		alphas[i]=CMath::randn_double();
+
+	/* with and without subset */
+	SGVector<index_t> subset(20);
+	for (index_t i=0; i<subset.vlen; ++i)
+		subset[i]=(i*7)%num;
+
+	for (index_t s=0; s<2; ++s)
+	{
+		if (s==1)
+		{
+			sv_features->add_subset(subset);
+			csr_features->add_subset(subset);
+		}
+
+		index_t n=csr_features->get_num_vectors();
+		for (index_t i=0; i<n; ++i)
+		{
+			EXPECT_NEAR(csr_features->dense_dot(i, w.vector, dim),
+					sv_features->dense_dot(i, w.vector, dim), 1E-12);
+			EXPECT_NEAR(csr_features->dense_dot(2.0, i, w.vector, dim, 1.0),
+					sv_features->dense_dot(2.0, i, w.vector, dim, 1.0), 1E-12);
+
+			for (index_t j=0; j<n; ++j)
+			{
+				EXPECT_NEAR(csr_features->dot(i, csr_features, j),
+						sv_features->dot(i, sv_features, j), 1E-12);
+			}
+		}
+
+		SGVector<float64_t> out_sv(n);
+		SGVector<float64_t> out_csr(n);
+		sv_features->dense_dot_range(out_sv.vector, 0, n, alphas.vector,
+				w.vector, dim, 0.5);
+		csr_features->dense_dot_range(out_csr.vector, 0, n, alphas.vector,
+				w.vector, dim, 0.5);
+		for (index_t i=0; i<n; ++i)
+			EXPECT_NEAR(out_csr[i], out_sv[i], 1E-12);
+
+		SGVector<float64_t> acc_sv(dim);
+		SGVector<float64_t> acc_csr(dim);
+		acc_sv.zero();
+		acc_csr.zero();
+		for (index_t i=0; i<n; ++i)
+		{
+			sv_features->add_to_dense_vec(0.3, i, acc_sv.vector, dim, i%2==0);
+			csr_features->add_to_dense_vec(0.3, i, acc_csr.vector, dim, i%2==0);
+		}
+		for (index_t i=0; i<dim; ++i)
+			EXPECT_NEAR(acc_csr[i], acc_sv[i], 1E-12);
+	}
+
+	csr_features->remove_subset();
+	SGMatrix<float64_t> full=csr_features->get_full_feature_matrix();
+	EXPECT_TRUE(full.equals(data));
+
+	SG_UNREF(sv_features);
+	SG_UNREF(csr_features);
+}
+
+TEST(SparseFeaturesTest,csr_serialization)
+{
+	/* values that survive the ascii format exactly */
+	SGMatrix<float64_t> data=create_sparse_data(20, 30);
+	for (index_t i=0; i<data.num_rows*data.num_cols; i++)
+		data.matrix[i]=CMath::round(data.matrix[i]*100);
+	CSparseFeatures<float64_t>* features=new CSparseFeatures<float64_t>(data);
+	SG_REF(features);
+	features->convert_to_csr();
+
+	CSerializableAsciiFile* outfile=new CSerializableAsciiFile("sparseFeaturesCSR.txt", 'w');
+	features->save_serializable(outfile);
+	SG_UNREF(outfile);
+
+	/* still in CSR mode after saving */
+	EXPECT_TRUE(features->is_csr());
+	EXPECT_TRUE(features->get_full_feature_matrix().equals(data));
+
+	/* loaded as array of sparse vectors */
+	CSparseFeatures<float64_t>* loaded=new CSparseFeatures<float64_t>();
+	SG_REF(loaded);
+	CSerializableAsciiFile* infile=new CSerializableAsciiFile("sparseFeaturesCSR.txt", 'r');
+	loaded->load_serializable(infile);
+	SG_UNREF(infile);
+	EXPECT_FALSE(loaded->is_csr());
+	EXPECT_TRUE(loaded->get_full_feature_matrix().equals(data));
+
+	/* CSR buffers of features loaded into are rebuilt */
+	CSparseFeatures<float64_t>* csr_loaded=new CSparseFeatures<float64_t>(
+			create_sparse_data(5, 3));
+	SG_REF(csr_loaded);
+	csr_loaded->convert_to_csr();
+	infile=new CSerializableAsciiFile("sparseFeaturesCSR.txt", 'r');
+	csr_loaded->load_serializable(infile);
+	SG_UNREF(infile);
+	EXPECT_TRUE(csr_loaded->is_csr());
+	EXPECT_EQ(csr_loaded->get_num_vectors(), 30);
+	EXPECT_TRUE(csr_loaded->get_full_feature_matrix().equals(data));
+
+	SG_UNREF(features);
+	SG_UNREF(loaded);
+	SG_UNREF(csr_loaded);
+}
+
+TEST(SparseFeaturesTest,add_to_dense_vec_range)
+{
+	index_t dim=30;
+	index_t num=200;
+	SGMatrix<float64_t> data=create_sparse_data(dim, num);
+
+	CSparseFeatures<float64_t>* features=new CSparseFeatures<float64_t>(data);
+	SG_REF(features);
+
+	SGVector<float64_t> alphas(num);
+	for (index_t i=0; i<num; ++i)
+		alphas[i]=CMath::randn_double();
+
+	SGVector<index_t> sub_index(num/2);
+	for (index_t i=0; i<sub_index.vlen; ++i)
+		sub_index[i]=(i*7)%num;
+
+	for (index_t threads=1; threads<=4; threads+=3)
+	{
+		features->parallel->set_num_threads(threads);
+
+		SGVector<float64_t> expected(dim);
+		SGVector<float64_t> result(dim);
+		expected.set_const(1.0);
+		result.set_const(1.0);
+		for (index_t i=0; i<num; ++i)
+			features->add_to_dense_vec(alphas[i], i, expected.vector, dim);
+		features->add_to_dense_vec_range(alphas.vector, NULL, num,
+				result.vector, dim);
+		for (index_t j=0; j<dim; ++j)
+			EXPECT_NEAR(result[j], expected[j], 1E-12);
+
+		expected.set_const(1.0);
+		result.set_const(1.0);
+		for (index_t i=0; i<sub_index.vlen; ++i)
+		{
+			features->add_to_dense_vec(alphas[i], sub_index[i],
+					expected.vector, dim);
+		}
+		features->add_to_dense_vec_range(alphas.vector, sub_index.vector,
+				sub_index.vlen, result.vector, dim);
+		for (index_t j=0; j<dim; ++j)
+			EXPECT_NEAR(result[j], expected[j], 1E-12);
+	}
+
+	SG_UNREF(features);
+}
@@ -61,6 +61,62 @@ TEST(StreamingDenseFeaturesTest, example_reading_from_file)
 	ASSERT_EQ(0, delete_success);
 }
 
+TEST(StreamingDenseFeaturesTest, example_reading_with_several_parser_threads)
+{
+	/* a few MB, i.e. several segments parsed by different threads */
+	index_t n=50000;
+	index_t dim=3;
+	std::string tmp_name = "/tmp/StreamingDenseFeatures_threads.XXXXXX";
+	char* fname = mktemp(const_cast<char*>(tmp_name.c_str()));
+
+	SGMatrix<float64_t> data(dim,n);
+	for (index_t i=0; i<dim*n; ++i)
+		data.matrix[i] = sg_rand->std_normal_distrib();
+
+	CDenseFeatures<float64_t>* orig_feats=new CDenseFeatures<float64_t>(data);
+	CCSVFile* saved_features = new CCSVFile(fname, 'w');
+	orig_feats->save(saved_features);
+	saved_features->close();
+	SG_UNREF(saved_features);
+
+	/* ring sizes smaller and larger than the batches handed over */
+	int32_t ring_sizes[2]={1, 64};
+	for (int32_t r=0; r<2; r++)
+	{
+		CStreamingAsciiFile* input = new CStreamingAsciiFile(fname);
+		input->set_delimiter(',');
+		input->set_num_parser_threads(4);
+		CStreamingDenseFeatures<float64_t>* feats
+			= new CStreamingDenseFeatures<float64_t>(input, false, ring_sizes[r]);
+
+		index_t i = 0;
+		feats->start_parser();
+		while (feats->get_next_example())
+		{
+			SGVector<float64_t> example = feats->get_vector();
+			SGVector<float64_t> expected = orig_feats->get_feature_vector(i);
+
+			ASSERT_EQ(dim, example.vlen);
+
+			/* examples are returned in file order */
+			for (index_t j = 0; j < dim; j++)
+				EXPECT_NEAR(expected.vector[j], example.vector[j], 1E-5);
+
+			feats->release_example();
+			i++;
+		}
+		feats->end_parser();
+		EXPECT_EQ(n, i);
+
+		SG_UNREF(feats);
+	}
+
+	SG_UNREF(orig_feats);
+
+	int delete_success = unlink(fname);
+	ASSERT_EQ(0, delete_success);
+}
+
 TEST(StreamingDenseFeaturesTest, example_reading_from_features)
 {
 	index_t n=20;
@@ -189,3 +189,94 @@ TEST(CSVFileTest, string_list_char)
 	SG_FREE(lines_to_read);
 	unlink("CSVFileTest_string_list_char_output.txt");
 }
+
+TEST(CSVFileTest, matrix_float64_memory_mapped)
+{
+	const char* fname="CSVFileTest_matrix_float64_memory_mapped.txt";
+	CRandom* rand=new CRandom();
+
+	int32_t num_rows=7;
+	int32_t num_cols=5000;
+	SGMatrix<float64_t> data(num_rows, num_cols);
+
+	/* header lines to skip, blank lines and windows line endings */
+	FILE* f=fopen(fname, "w");
+	fprintf(f, "a,b,c,d,e,f,g\nheader\n");
+	for (int32_t j=0; j<num_cols; j++)
+	{
+		for (int32_t i=0; i<num_rows; i++)
+		{
+			data(i, j)=rand->random(-1e5, 1e5);
+			fprintf(f, i ? ", %.17g" : "%.17g", data(i, j));
+		}
+		fprintf(f, j%1000==0 ? "\r\n\n" : "\n");
+	}
+	fclose(f);
+
+	SGMatrix<float64_t> data_from_file(true);
+	CCSVFile* fin=new CCSVFile(fname, 'r', NULL);
+	fin->set_lines_to_skip(2);
+	fin->get_matrix(data_from_file.matrix, data_from_file.num_rows,
+			data_from_file.num_cols);
+	SG_UNREF(fin);
+
+	EXPECT_EQ(data_from_file.num_rows, num_rows);
+	EXPECT_EQ(data_from_file.num_cols, num_cols);
+	EXPECT_TRUE(data_from_file.equals(data));
+
+	/* lines as features */
+	SGMatrix<float64_t> transposed(true);
+	fin=new CCSVFile(fname, 'r', NULL);
+	fin->set_lines_to_skip(2);
+	fin->set_transpose(true);
+	fin->get_matrix(transposed.matrix, transposed.num_rows,
+			transposed.num_cols);
+	SG_UNREF(fin);
+
+	EXPECT_EQ(transposed.num_rows, num_cols);
+	EXPECT_EQ(transposed.num_cols, num_rows);
+	for (int32_t i=0; i<num_rows; i++)
+	{
+		for (int32_t j=0; j<num_cols; j++)
+			EXPECT_EQ(transposed(j, i), data(i, j));
+	}
+
+	SG_UNREF(rand);
+	unlink(fname);
+}
+
+TEST(CSVFileTest, streaming_and_memory_mapped_agree)
+{
+	const char* fname="CSVFileTest_streaming_and_memory_mapped_agree.txt";
+
+	/* the second header line only contains blanks */
+	FILE* f=fopen(fname, "w");
+	fprintf(f, "a,b,c\n  \n1,2,3\n4,5,6\n7,8,9\n10,11,12\n");
+	fclose(f);
+
+	for (int32_t transpose=0; transpose<2; transpose++)
+	{
+		SGMatrix<float64_t> mapped(true);
+		CCSVFile* fin=new CCSVFile(fname, 'r', NULL);
+		fin->set_lines_to_skip(2);
+		fin->set_transpose(transpose);
+		fin->get_matrix(mapped.matrix, mapped.num_rows, mapped.num_cols);
+		SG_UNREF(fin);
+
+		/* without a file name the file is read line by line */
+		SGMatrix<float64_t> streamed(true);
+		f=fopen(fname, "r");
+		fin=new CCSVFile(f, NULL);
+		fin->set_lines_to_skip(2);
+		fin->set_transpose(transpose);
+		fin->get_matrix(streamed.matrix, streamed.num_rows, streamed.num_cols);
+		SG_UNREF(fin);
+
+		EXPECT_EQ(mapped.num_rows, transpose ? 4 : 3);
+		EXPECT_EQ(mapped.num_cols, transpose ? 3 : 4);
+		EXPECT_EQ(mapped(0, 1), transpose ? 2 : 4);
+		EXPECT_TRUE(streamed.equals(mapped));
+	}
+
+	unlink(fname);
+}
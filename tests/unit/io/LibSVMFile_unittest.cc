@@ -136,3 +136,127 @@ TEST(LibSVMFileTest, sparse_matrix_float64)
 	SG_FREE(labels_from_file);
 	unlink("LibSVMFileTest_sparse_matrix_float64_output.txt");
 }
+
+TEST(LibSVMFileTest, memory_mapped_equals_stream)
+{
+	const char* fname="LibSVMFileTest_memory_mapped_equals_stream.txt";
+	CRandom* rand=new CRandom();
+
+	/* large enough to be split into several chunks, with blank lines */
+	FILE* f=fopen(fname, "w");
+	for (int32_t i=0; i<4000; i++)
+	{
+		fprintf(f, "%d", rand->random(-1, 1));
+		int32_t num_entries=rand->random(0, 20);
+		/* short numbers take the exact fast path, long ones go to strtod */
+		for (int32_t j=0; j<num_entries; j++)
+			fprintf(f, j%2 ? " %d:%.17g" : " %d:%.10g", 3*j+1, rand->random(-1e3, 1e3));
+		fprintf(f, i%100==0 ? "\r\n\n" : "\n");
+	}
+	fprintf(f, "1 5:1.5e-3 7:-2E+4");
+	fclose(f);
+
+	int32_t num_vec=0;
+	int32_t num_feat=0;
+	SGSparseVector<float64_t>* data;
+	float64_t* labels;
+	CLibSVMFile* fin=new CLibSVMFile(fname, 'r', NULL);
+	fin->get_sparse_matrix(data, num_feat, num_vec, labels);
+	SG_UNREF(fin);
+
+	int32_t num_vec_stream=0;
+	int32_t num_feat_stream=0;
+	SGSparseVector<float64_t>* data_stream;
+	float64_t* labels_stream;
+	/* the file is closed by the destructor */
+	FILE* fs=fopen(fname, "r");
+	fin=new CLibSVMFile(fs, NULL);
+	fin->get_sparse_matrix(data_stream, num_feat_stream, num_vec_stream,
+			labels_stream);
+	SG_UNREF(fin);
+
+	EXPECT_EQ(num_vec, 4001);
+	EXPECT_EQ(num_vec_stream, num_vec);
+	EXPECT_EQ(num_feat_stream, num_feat);
+	for (int32_t i=0; i<num_vec; i++)
+	{
+		EXPECT_EQ(labels[i], labels_stream[i]);
+		ASSERT_EQ(data[i].num_feat_entries, data_stream[i].num_feat_entries);
+		for (int32_t j=0; j<data[i].num_feat_entries; j++)
+		{
+			EXPECT_EQ(data[i].features[j].feat_index,
+					data_stream[i].features[j].feat_index);
+			EXPECT_EQ(data[i].features[j].entry,
+					data_stream[i].features[j].entry);
+		}
+	}
+
+	EXPECT_EQ(data[num_vec-1].features[0].entry, 1.5e-3);
+	EXPECT_EQ(data[num_vec-1].features[1].entry, -2e4);
+
+	SG_UNREF(rand);
+	SG_FREE(data);
+	SG_FREE(labels);
+	SG_FREE(data_stream);
+	SG_FREE(labels_stream);
+
+	unlink(fname);
+}
+
+TEST(LibSVMFileTest, memory_mapped_equals_stream_blank_lines)
+{
+	const char* fname="LibSVMFileTest_memory_mapped_equals_stream_blank_lines.txt";
+
+	/* empty lines are skipped, lines of blanks are empty vectors */
+	FILE* f=fopen(fname, "w");
+	fprintf(f, "  \n1 1:2 3:4\n\n\t\n-1 2:5\n \n\n1 1:1\n");
+	fclose(f);
+
+	int32_t num_vec=0;
+	int32_t num_feat=0;
+	SGSparseVector<float64_t>* data;
+	float64_t* labels;
+	CLibSVMFile* fin=new CLibSVMFile(fname, 'r', NULL);
+	fin->get_sparse_matrix(data, num_feat, num_vec, labels);
+	SG_UNREF(fin);
+
+	int32_t num_vec_stream=0;
+	int32_t num_feat_stream=0;
+	SGSparseVector<float64_t>* data_stream;
+	float64_t* labels_stream;
+	/* the file is closed by the destructor */
+	FILE* fs=fopen(fname, "r");
+	fin=new CLibSVMFile(fs, NULL);
+	fin->get_sparse_matrix(data_stream, num_feat_stream, num_vec_stream,
+			labels_stream);
+	SG_UNREF(fin);
+
+	EXPECT_EQ(num_vec, 6);
+	EXPECT_EQ(num_vec_stream, num_vec);
+	EXPECT_EQ(num_feat, 3);
+	EXPECT_EQ(num_feat_stream, num_feat);
+
+	float64_t expected_labels[6]={0, 1, 0, -1, 0, 1};
+	int32_t expected_entries[6]={0, 2, 0, 1, 0, 1};
+	for (int32_t i=0; i<num_vec; i++)
+	{
+		EXPECT_EQ(labels[i], expected_labels[i]);
+		EXPECT_EQ(labels_stream[i], expected_labels[i]);
+		EXPECT_EQ(data[i].num_feat_entries, expected_entries[i]);
+		ASSERT_EQ(data_stream[i].num_feat_entries, data[i].num_feat_entries);
+		for (int32_t j=0; j<data[i].num_feat_entries; j++)
+		{
+			EXPECT_EQ(data[i].features[j].feat_index,
+					data_stream[i].features[j].feat_index);
+			EXPECT_EQ(data[i].features[j].entry,
+					data_stream[i].features[j].entry);
+		}
+	}
+
+	SG_FREE(data);
+	SG_FREE(labels);
+	SG_FREE(data_stream);
+	SG_FREE(labels_stream);
+
+	unlink(fname);
+}
@@ -10,9 +10,14 @@
 #include <shogun/lib/common.h>
 #include <shogun/base/Parameter.h>
 #include <shogun/io/SerializableAsciiFile.h>
+#include <shogun/io/SerializableBinaryFile.h>
 #include <shogun/io/SerializableJsonFile.h>
 #include <shogun/io/SerializableXmlFile.h>
 #include <shogun/io/SerializableHdf5File.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/mathematics/Math.h>
+#include <unistd.h>
 #include <gtest/gtest.h>
 
 using namespace shogun;
@@ -1739,3 +1744,111 @@ TEST(Serialization, Hdf5_matrix_equal_FLOAT64)
 }
 
 #endif // HAVE_HDF5
+
+TEST(Serialization, Binary_matrix_equal_FLOAT64)
+{
+	for (int32_t use_mmap=0; use_mmap<2; use_mmap++)
+	{
+		SGMatrix<float64_t> a(3, 5);
+		SGMatrix<float64_t> b(2, 2);
+
+		for (index_t i=0; i<15; i++)
+			a.matrix[i]=i*1.14263158;
+		b.zero();
+
+		TSGDataType type(CT_SGMATRIX, ST_NONE, PT_FLOAT64, &a.num_rows, &a.num_cols);
+		TSGDataType type2(CT_SGMATRIX, ST_NONE, PT_FLOAT64, &b.num_rows, &b.num_cols);
+		TParameter* param1=new TParameter(&type, &a.matrix, "param", "");
+		TParameter* param2=new TParameter(&type2, &b.matrix, "param", "");
+
+		const char* filename="float64_sgmat_param.bin";
+		// save parameter to a binary file
+		CSerializableBinaryFile *file=new CSerializableBinaryFile(filename, 'w');
+		param1->save(file);
+		file->close();
+		SG_UNREF(file);
+
+		// load parameter from a binary file
+		file=new CSerializableBinaryFile(filename, 'r', use_mmap);
+		EXPECT_TRUE(param2->load(file));
+		file->close();
+		SG_UNREF(file);
+
+		// check for equality
+		EXPECT_EQ(b.num_rows, 3);
+		EXPECT_EQ(b.num_cols, 5);
+		float64_t accuracy=0.0;
+		EXPECT_TRUE(param1->equals(param2, accuracy));
+
+		/* resizing copies views of the mapped file */
+		b.matrix=SG_REALLOC(float64_t, b.matrix, 15, 30);
+		for (index_t i=0; i<15; i++)
+			EXPECT_EQ(b.matrix[i], a.matrix[i]);
+
+		delete param1;
+		delete param2;
+		unlink(filename);
+	}
+}
+
+TEST(Serialization, Binary_mapped_features)
+{
+	CMath::init_random(17);
+
+	SGMatrix<float64_t> data(7, 1000);
+	for (index_t i=0; i<data.num_rows*data.num_cols; i++)
+		data.matrix[i]=CMath::randn_double();
+
+	SGVector<float64_t> lab(1000);
+	lab.range_fill();
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+	CRegressionLabels* labels=new CRegressionLabels(lab);
+	SG_REF(features);
+	SG_REF(labels);
+
+	const char* filename="mapped_features.bin";
+	const char* labels_filename="mapped_labels.bin";
+	CSerializableBinaryFile* file=new CSerializableBinaryFile(filename, 'w');
+	EXPECT_TRUE(features->save_serializable(file));
+	SG_UNREF(file);
+	file=new CSerializableBinaryFile(labels_filename, 'w');
+	EXPECT_TRUE(labels->save_serializable(file));
+	SG_UNREF(file);
+
+	CDenseFeatures<float64_t>* loaded=new CDenseFeatures<float64_t>();
+	CRegressionLabels* loaded_labels=new CRegressionLabels();
+	SG_REF(loaded);
+	SG_REF(loaded_labels);
+
+	file=new CSerializableBinaryFile(filename, 'r');
+	EXPECT_TRUE(loaded->load_serializable(file));
+	EXPECT_TRUE(file->get_use_mmap());
+	SG_UNREF(file);
+	file=new CSerializableBinaryFile(labels_filename, 'r');
+	EXPECT_TRUE(loaded_labels->load_serializable(file));
+	SG_UNREF(file);
+
+	/* the views stay valid after closing and removing the files */
+	EXPECT_EQ(unlink(filename), 0);
+	EXPECT_EQ(unlink(labels_filename), 0);
+
+	SGMatrix<float64_t> m=loaded->get_feature_matrix();
+	EXPECT_EQ(((size_t) m.matrix)%SERIALIZABLE_BINARY_ALIGNMENT, 0);
+	ASSERT_EQ(m.num_rows, data.num_rows);
+	ASSERT_EQ(m.num_cols, data.num_cols);
+	for (index_t i=0; i<m.num_rows*m.num_cols; i++)
+		EXPECT_EQ(m.matrix[i], data.matrix[i]);
+
+	/* mapping is private, views can be written to */
+	m(0,0)=42;
+	EXPECT_EQ(loaded->get_feature_matrix()(0,0), 42);
+
+	SGVector<float64_t> loaded_lab=loaded_labels->get_labels();
+	EXPECT_TRUE(loaded_lab.equals(lab));
+
+	SG_UNREF(loaded_labels);
+	SG_UNREF(loaded);
+	SG_UNREF(labels);
+	SG_UNREF(features);
+}
@@ -0,0 +1,117 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/LinearKernel.h>
+#include <shogun/kernel/PolyKernel.h>
+#include <shogun/kernel/SigmoidKernel.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static CDenseFeatures<float64_t>* create_features(index_t dim, index_t num)
+{
+	SGMatrix<float64_t> data(dim, num);
+	for (index_t i=0; i<dim*num; i++)
+		data.matrix[i]=CMath::randn_double();
+
+	return new CDenseFeatures<float64_t>(data);
+}
+
+/* compares the (blocked) kernel matrix against single kernel() calls */
+static void check_kernel_matrix(CKernel* kernel, CFeatures* l, CFeatures* r)
+{
+	kernel->init(l, r);
+
+	SGMatrix<float64_t> km=kernel->get_kernel_matrix();
+	ASSERT_EQ(km.num_rows, l->get_num_vectors());
+	ASSERT_EQ(km.num_cols, r->get_num_vectors());
+
+	for (index_t j=0; j<km.num_cols; j++)
+	{
+		for (index_t i=0; i<km.num_rows; i++)
+			EXPECT_NEAR(km(i,j), kernel->kernel(i,j), 1E-10);
+	}
+
+	SGMatrix<float32_t> km32=kernel->get_kernel_matrix<float32_t>();
+	for (index_t j=0; j<km.num_cols; j++)
+	{
+		for (index_t i=0; i<km.num_rows; i++)
+			EXPECT_NEAR(km32(i,j), km(i,j), 1E-5);
+	}
+
+	/* rows and columns are only defined for symmetric kernel matrices */
+	if (l!=r)
+		return;
+
+	SGVector<float64_t> row=kernel->get_kernel_row(1);
+	for (index_t j=0; j<row.vlen; j++)
+		EXPECT_NEAR(row[j], kernel->kernel(1,j), 1E-10);
+}
+
+static void check_dot_kernel(CKernel* kernel)
+{
+	SG_REF(kernel);
+
+	/* larger than one block to test block boundaries */
+	CDenseFeatures<float64_t>* lhs=create_features(7, 300);
+	CDenseFeatures<float64_t>* rhs=create_features(7, 270);
+	SG_REF(lhs);
+	SG_REF(rhs);
+
+	/* symmetric and asymmetric case */
+	check_kernel_matrix(kernel, lhs, lhs);
+	check_kernel_matrix(kernel, lhs, rhs);
+
+	/* non-contiguous feature vectors */
+	SGVector<index_t> subset(50);
+	for (index_t i=0; i<subset.vlen; i++)
+		subset[i]=(i*7)%lhs->get_num_vectors();
+
+	lhs->add_subset(subset);
+	check_kernel_matrix(kernel, lhs, rhs);
+	check_kernel_matrix(kernel, lhs, lhs);
+	lhs->remove_subset();
+
+	kernel->cleanup();
+	SG_UNREF(lhs);
+	SG_UNREF(rhs);
+	SG_UNREF(kernel);
+}
+
+TEST(DotKernelTest, linear_kernel_matrix)
+{
+	check_dot_kernel(new CLinearKernel());
+}
+
+TEST(DotKernelTest, gaussian_kernel_matrix)
+{
+	check_dot_kernel(new CGaussianKernel(10, 3.0));
+}
+
+TEST(DotKernelTest, poly_kernel_matrix)
+{
+	/* poly kernel uses the sqrt diag normalizer by default */
+	check_dot_kernel(new CPolyKernel(10, 3, true));
+	check_dot_kernel(new CPolyKernel(10, 2, false));
+}
+
+TEST(DotKernelTest, sigmoid_kernel_matrix)
+{
+	check_dot_kernel(new CSigmoidKernel(10, 0.1, 0.5));
+}
+
+TEST(DotKernelTest, gaussian_compact_kernel_matrix)
+{
+	CGaussianKernel* kernel=new CGaussianKernel(10, 3.0);
+	kernel->set_compact_enabled(true);
+	check_dot_kernel(kernel);
+}
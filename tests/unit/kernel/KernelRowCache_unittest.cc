@@ -0,0 +1,325 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/kernel/KernelRowCache.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/classifier/svm/LibSVM.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static void fill_row(int32_t row, float64_t* values, int32_t len)
+{
+	for (int32_t j=0; j<len; j++)
+		values[j]=row*1000+j+0.25;
+}
+
+TEST(KernelRowCacheTest, lookup_and_insert)
+{
+	CKernelRowCache* cache=new CKernelRowCache(1, false, 4);
+	SG_REF(cache);
+	cache->reset(100, 50);
+
+	SGVector<float64_t> row(50);
+	SGVector<float64_t> out(50);
+
+	EXPECT_FALSE(cache->lookup(3, out.vector));
+	fill_row(3, row.vector, 50);
+	cache->insert(3, row.vector);
+	EXPECT_TRUE(cache->lookup(3, out.vector));
+
+	for (int32_t j=0; j<50; j++)
+		EXPECT_EQ(out[j], row[j]);
+
+	EXPECT_EQ(cache->get_num_hits(), 1);
+	EXPECT_EQ(cache->get_num_misses(), 1);
+	EXPECT_EQ(cache->get_num_cached(), 1);
+
+	cache->clear();
+	EXPECT_FALSE(cache->lookup(3, out.vector));
+	EXPECT_EQ(cache->get_num_cached(), 0);
+
+	SG_UNREF(cache);
+}
+
+TEST(KernelRowCacheTest, clock_eviction)
+{
+	/* 1MB for rows of 65536 doubles = 2 rows */
+	CKernelRowCache* cache=new CKernelRowCache(1, false, 1);
+	SG_REF(cache);
+	cache->reset(10, 65536);
+	EXPECT_EQ(cache->get_capacity(), 2);
+
+	SGVector<float64_t> row(65536);
+	SGVector<float64_t> out(65536);
+
+	for (int32_t i=0; i<10; i++)
+	{
+		fill_row(i, row.vector, row.vlen);
+		cache->insert(i, row.vector);
+		EXPECT_LE(cache->get_num_cached(), 2);
+
+		/* the row just inserted is always available */
+		EXPECT_TRUE(cache->lookup(i, out.vector));
+		EXPECT_EQ(out[17], row[17]);
+	}
+
+	EXPECT_EQ(cache->get_num_evictions(), 8);
+
+	cache->reset_statistics();
+	EXPECT_EQ(cache->get_num_hits(), 0);
+	EXPECT_EQ(cache->get_num_evictions(), 0);
+
+	SG_UNREF(cache);
+}
+
+TEST(KernelRowCacheTest, float32_storage)
+{
+	CKernelRowCache* cache=new CKernelRowCache(1, true);
+	SG_REF(cache);
+	cache->reset(20, 30);
+
+	SGVector<float64_t> row(30);
+	SGVector<float64_t> out(30);
+	fill_row(7, row.vector, 30);
+	cache->insert(7, row.vector);
+	EXPECT_TRUE(cache->lookup(7, out.vector));
+
+	for (int32_t j=0; j<30; j++)
+		EXPECT_NEAR(out[j], row[j], 1E-3);
+
+	SG_UNREF(cache);
+}
+
+struct RowCacheTestData
+{
+	CKernelRowCache* cache;
+	int32_t row_len;
+	int32_t* errors;
+};
+
+static void concurrent_access(int32_t start, int32_t end, int32_t thread, void* p)
+{
+	RowCacheTestData* data=(RowCacheTestData*) p;
+	int32_t len=data->row_len;
+	float64_t* row=SG_MALLOC(float64_t, len);
+	float64_t* expected=SG_MALLOC(float64_t, len);
+
+	for (int32_t i=start; i<end; i++)
+	{
+		int32_t r=(i*7919)%data->cache->get_num_rows();
+		fill_row(r, expected, len);
+
+		if (data->cache->lookup(r, row))
+		{
+			for (int32_t j=0; j<len; j++)
+			{
+				if (row[j]!=expected[j])
+					data->errors[thread]++;
+			}
+		}
+		else
+			data->cache->insert(r, expected);
+	}
+
+	SG_FREE(row);
+	SG_FREE(expected);
+}
+
+TEST(KernelRowCacheTest, concurrent_access)
+{
+	CKernelRowCache* cache=new CKernelRowCache(1, false, 8);
+	SG_REF(cache);
+	cache->reset(500, 1000);
+
+	Parallel parallel;
+	parallel.set_num_threads(4);
+
+	int32_t errors[4]={0, 0, 0, 0};
+	RowCacheTestData data;
+	data.cache=cache;
+	data.row_len=1000;
+	data.errors=errors;
+
+	parallel.parallel_for(0, 20000, concurrent_access, &data, 16);
+
+	for (int32_t t=0; t<4; t++)
+		EXPECT_EQ(errors[t], 0);
+
+	EXPECT_EQ(cache->get_num_hits()+cache->get_num_misses(), 20000);
+
+	SG_UNREF(cache);
+}
+
+TEST(KernelRowCacheTest, layout_mismatch)
+{
+	CKernelRowCache* cache=new CKernelRowCache(1, false, 4);
+	SG_REF(cache);
+	cache->reset(100, 50);
+
+	SGVector<float64_t> row(50);
+	fill_row(3, row.vector, 50);
+	cache->insert(3, row.vector, 50);
+	EXPECT_FALSE(cache->lookup(3, row.vector, 40));
+	EXPECT_TRUE(cache->lookup(3, row.vector, 50));
+
+	/* same layout keeps the shards but drops the rows */
+	int32_t capacity=cache->get_capacity();
+	cache->reset(100, 50);
+	EXPECT_EQ(cache->get_capacity(), capacity);
+	EXPECT_FALSE(cache->lookup(3, row.vector, 50));
+
+	/* rows outside of the current layout are misses */
+	cache->reset(10, 50);
+	EXPECT_FALSE(cache->lookup(30, row.vector, 50));
+	cache->insert(30, row.vector, 50);
+	EXPECT_EQ(cache->get_num_cached(), 0);
+
+	SG_UNREF(cache);
+}
+
+static void concurrent_reset(int32_t start, int32_t end, int32_t thread, void* p)
+{
+	RowCacheTestData* data=(RowCacheTestData*) p;
+	float64_t* row=SG_MALLOC(float64_t, data->row_len);
+	float64_t* expected=SG_MALLOC(float64_t, data->row_len);
+
+	for (int32_t i=start; i<end; i++)
+	{
+		/* another user of the cache switches between two layouts */
+		int32_t len=(i/100)%2 ? data->row_len : data->row_len/2;
+		if (i%100==0)
+			data->cache->reset(500, len);
+
+		int32_t r=(i*7919)%500;
+		fill_row(r, expected, len);
+
+		if (data->cache->lookup(r, row, len))
+		{
+			for (int32_t j=0; j<len; j++)
+			{
+				if (row[j]!=expected[j])
+					data->errors[thread]++;
+			}
+		}
+		else
+			data->cache->insert(r, expected, len);
+	}
+
+	SG_FREE(row);
+	SG_FREE(expected);
+}
+
+TEST(KernelRowCacheTest, concurrent_reset)
+{
+	CKernelRowCache* cache=new CKernelRowCache(1, false, 8);
+	SG_REF(cache);
+	cache->reset(500, 1000);
+
+	Parallel parallel;
+	parallel.set_num_threads(4);
+
+	int32_t errors[4]={0, 0, 0, 0};
+	RowCacheTestData data;
+	data.cache=cache;
+	data.row_len=1000;
+	data.errors=errors;
+
+	parallel.parallel_for(0, 20000, concurrent_reset, &data, 16);
+
+	for (int32_t t=0; t<4; t++)
+		EXPECT_EQ(errors[t], 0);
+
+	SG_UNREF(cache);
+}
+
+static CDenseFeatures<float64_t>* create_features(index_t dim, index_t num)
+{
+	SGMatrix<float64_t> data(dim, num);
+	for (index_t i=0; i<dim*num; i++)
+		data.matrix[i]=CMath::randn_double();
+
+	return new CDenseFeatures<float64_t>(data);
+}
+
+TEST(KernelRowCacheTest, fill_kernel_row)
+{
+	CDenseFeatures<float64_t>* feats=create_features(3, 40);
+	CGaussianKernel* kernel=new CGaussianKernel(10, 2.0);
+	SG_REF(kernel);
+	kernel->init(feats, feats);
+
+	CKernelRowCache* cache=new CKernelRowCache(1);
+	kernel->set_row_cache(cache);
+
+	SGVector<float64_t> row(40);
+	for (int32_t pass=0; pass<2; pass++)
+	{
+		for (int32_t i=0; i<40; i++)
+		{
+			kernel->fill_kernel_row(i, row.vector);
+			for (int32_t j=0; j<40; j++)
+				EXPECT_NEAR(row[j], kernel->kernel(i,j), 1E-12);
+		}
+	}
+
+	EXPECT_EQ(cache->get_num_hits(), 40);
+	EXPECT_EQ(cache->get_num_misses(), 40);
+
+	/* new features invalidate the cache */
+	CDenseFeatures<float64_t>* feats2=create_features(3, 30);
+	kernel->init(feats2, feats2);
+	EXPECT_EQ(cache->get_num_cached(), 0);
+	EXPECT_EQ(cache->get_row_length(), 30);
+
+	kernel->cleanup();
+	SG_UNREF(kernel);
+}
+
+TEST(KernelRowCacheTest, libsvm_with_row_cache)
+{
+	CDenseFeatures<float64_t>* feats=create_features(2, 80);
+	SG_REF(feats);
+	SGVector<float64_t> lab(80);
+	SGMatrix<float64_t> fm=feats->get_feature_matrix();
+	for (int32_t i=0; i<80; i++)
+	{
+		lab[i]=i%2 ? 1 : -1;
+		fm(0,i)+=lab[i];
+	}
+	CBinaryLabels* labels=new CBinaryLabels(lab);
+
+	CGaussianKernel* kernel=new CGaussianKernel(10, 2.0);
+	CLibSVM* svm=new CLibSVM(1.0, kernel, labels);
+	SG_REF(svm);
+	svm->train(feats);
+	SGVector<float64_t> alphas=svm->get_alphas();
+	SGVector<int32_t> svs=svm->get_support_vectors();
+	float64_t bias=svm->get_bias();
+
+	CKernelRowCache* cache=new CKernelRowCache(1);
+	kernel->set_row_cache(cache);
+	svm->train(feats);
+
+	EXPECT_GT(cache->get_num_misses(), 0);
+	ASSERT_EQ(svm->get_alphas().vlen, alphas.vlen);
+	for (int32_t i=0; i<alphas.vlen; i++)
+	{
+		EXPECT_NEAR(svm->get_alphas()[i], alphas[i], 1E-10);
+		EXPECT_EQ(svm->get_support_vectors()[i], svs[i]);
+	}
+	EXPECT_NEAR(svm->get_bias(), bias, 1E-10);
+
+	SG_UNREF(svm);
+	SG_UNREF(feats);
+}
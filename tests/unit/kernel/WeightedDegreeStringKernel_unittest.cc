@@ -0,0 +1,197 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/kernel/string/WeightedDegreeStringKernel.h>
+#include <shogun/kernel/string/WeightedDegreePositionStringKernel.h>
+#include <shogun/features/StringFeatures.h>
+#include <shogun/lib/SGStringList.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static CStringFeatures<char>* create_dna(index_t num, index_t len)
+{
+	const char acgt[]="ACGT";
+	SGStringList<char> list(num, len);
+
+	for (index_t i=0; i<num; i++)
+	{
+		list.strings[i]=SGString<char>(len);
+		for (index_t j=0; j<len; j++)
+			list.strings[i].string[j]=acgt[CMath::random(0, 3)];
+	}
+
+	return new CStringFeatures<char>(list, DNA);
+}
+
+static void create_svs(index_t num, SGVector<int32_t>& idx,
+		SGVector<float64_t>& alphas)
+{
+	idx=SGVector<int32_t>(num);
+	alphas=SGVector<float64_t>(num);
+	for (index_t i=0; i<num; i++)
+	{
+		idx[i]=i;
+		alphas[i]=CMath::random(-1.0, 1.0);
+	}
+}
+
+TEST(WeightedDegreeStringKernel, compact_trie_equals_trie)
+{
+	CMath::init_random(17);
+
+	/* degree larger than the remaining suffix length for the last
+	 * positions, long compact terminal nodes in the tries */
+	int32_t degree=20;
+	CStringFeatures<char>* train=create_dna(30, 40);
+	CStringFeatures<char>* test=create_dna(25, 40);
+	SG_REF(test);
+
+	CWeightedDegreeStringKernel* kernel=
+		new CWeightedDegreeStringKernel(train, test, degree);
+	SG_REF(kernel);
+
+	SGVector<int32_t> idx;
+	SGVector<float64_t> alphas;
+	create_svs(30, idx, alphas);
+
+	kernel->init_optimization(idx.vlen, idx.vector, alphas.vector);
+	SGVector<float64_t> expected(test->get_num_vectors());
+	for (index_t i=0; i<expected.vlen; i++)
+		expected[i]=kernel->compute_optimized(i);
+
+	kernel->set_use_compact_trie(true);
+	for (index_t i=0; i<expected.vlen; i++)
+		EXPECT_NEAR(kernel->compute_optimized(i), expected[i],
+				1E-5*CMath::abs(expected[i])+1E-8);
+	kernel->delete_optimization();
+
+	/* the batch evaluation goes through the interleaved traversal */
+	SGVector<int32_t> vec_idx(expected.vlen);
+	vec_idx.range_fill();
+	for (index_t c=0; c<2; c++)
+	{
+		kernel->set_use_compact_trie(c==1);
+		SGVector<float64_t> result(expected.vlen);
+		result.zero();
+		kernel->compute_batch(vec_idx.vlen, vec_idx.vector, result.vector,
+				idx.vlen, idx.vector, alphas.vector, 1.0);
+
+		for (index_t i=0; i<expected.vlen; i++)
+			EXPECT_NEAR(result[i], expected[i],
+					1E-5*CMath::abs(expected[i])+1E-8);
+	}
+
+	SG_UNREF(kernel);
+	SG_UNREF(test);
+}
+
+TEST(WeightedDegreeStringKernel, compact_trie_invalidated)
+{
+	CMath::init_random(17);
+
+	CStringFeatures<char>* train=create_dna(10, 15);
+	CWeightedDegreeStringKernel* kernel=
+		new CWeightedDegreeStringKernel(train, train, 4);
+	SG_REF(kernel);
+	kernel->set_use_compact_trie(true);
+
+	SGVector<int32_t> idx;
+	SGVector<float64_t> alphas;
+	create_svs(10, idx, alphas);
+
+	kernel->init_optimization(5, idx.vector, alphas.vector);
+	float64_t first=kernel->compute_optimized(0);
+
+	/* adding examples has to rebuild the compact layout */
+	kernel->init_optimization(10, idx.vector, alphas.vector);
+	float64_t all=kernel->compute_optimized(0);
+
+	float64_t expected=0;
+	for (index_t i=0; i<10; i++)
+		expected+=alphas[i]*kernel->kernel(i, 0);
+
+	EXPECT_NE(first, all);
+	EXPECT_NEAR(all, expected, 1E-5*CMath::abs(expected));
+
+	SG_UNREF(kernel);
+}
+
+TEST(WeightedDegreeStringKernel, compact_trie_releases_tries)
+{
+	CMath::init_random(17);
+
+	CStringFeatures<char>* train=create_dna(10, 15);
+	CWeightedDegreeStringKernel* kernel=
+		new CWeightedDegreeStringKernel(train, train, 4);
+	SG_REF(kernel);
+	kernel->set_use_compact_trie(true);
+
+	SGVector<int32_t> idx;
+	SGVector<float64_t> alphas;
+	create_svs(10, idx, alphas);
+
+	kernel->init_optimization(10, idx.vector, alphas.vector);
+	float64_t compact=kernel->compute_optimized(0);
+
+	/* the tries are freed once packed, switching the layout off requires
+	 * initializing the optimization again */
+	kernel->set_use_compact_trie(false);
+	EXPECT_FALSE(kernel->get_is_initialized());
+
+	kernel->init_optimization(10, idx.vector, alphas.vector);
+	EXPECT_NEAR(kernel->compute_optimized(0), compact,
+			1E-5*CMath::abs(compact));
+
+	SG_UNREF(kernel);
+}
+
+TEST(WeightedDegreePositionStringKernel, compact_trie_equals_trie)
+{
+	CMath::init_random(17);
+
+	CStringFeatures<char>* train=create_dna(20, 30);
+	CStringFeatures<char>* test=create_dna(15, 30);
+	SG_REF(test);
+
+	SGVector<int32_t> shifts(30);
+	shifts.set_const(2);
+
+	CWeightedDegreePositionStringKernel* kernel=
+		new CWeightedDegreePositionStringKernel(train, test, 8);
+	kernel->set_shifts(shifts);
+	SG_REF(kernel);
+
+	SGVector<int32_t> idx;
+	SGVector<float64_t> alphas;
+	create_svs(20, idx, alphas);
+
+	EOptimizationType types[2]={ FASTBUTMEMHUNGRY, SLOWBUTMEMEFFICIENT };
+	for (index_t t=0; t<2; t++)
+	{
+		kernel->set_optimization_type(types[t]);
+		kernel->set_use_compact_trie(false);
+		kernel->init_optimization(idx.vlen, idx.vector, alphas.vector);
+
+		SGVector<float64_t> expected(test->get_num_vectors());
+		for (index_t i=0; i<expected.vlen; i++)
+			expected[i]=kernel->compute_optimized(i);
+
+		kernel->set_use_compact_trie(true);
+		for (index_t i=0; i<expected.vlen; i++)
+			EXPECT_NEAR(kernel->compute_optimized(i), expected[i],
+					1E-5*CMath::abs(expected[i])+1E-8);
+
+		kernel->delete_optimization();
+	}
+
+	SG_UNREF(kernel);
+	SG_UNREF(test);
+}
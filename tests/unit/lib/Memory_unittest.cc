@@ -2,9 +2,14 @@
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/lib/SGSparseVector.h>
 #include <shogun/lib/SGVector.h>
+#include <shogun/base/Parallel.h>
 
 #include <gtest/gtest.h>
 
+#ifndef WIN32
+#include <sys/mman.h>
+#endif
+
 using namespace shogun;
 
 TEST(MemoryTest,get_copy)
@@ -54,3 +59,59 @@ TEST(MemoryTest,SGMatrix)
 	EXPECT_NE((SGMatrix<float64_t>*) NULL, m);
 	SG_FREE(m);
 }
+
+#ifndef WIN32
+static void free_mapped_views(int32_t start, int32_t end, int32_t thread,
+		void* p)
+{
+	char** regions=(char**) p;
+	for (int32_t i=start; i<end; i++)
+	{
+		/* a view, then ordinary memory */
+		SG_FREE(regions[i%4]+i);
+		char* buf=SG_MALLOC(char, 16);
+		SG_FREE(buf);
+	}
+}
+
+TEST(MemoryTest,mapped_regions)
+{
+	const int32_t num_views=1000;
+	const size_t length=4096;
+
+	char* regions[4];
+	for (int32_t r=0; r<4; r++)
+	{
+		void* p=mmap(NULL, length, PROT_READ|PROT_WRITE,
+				MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+		ASSERT_NE(MAP_FAILED, p);
+		regions[r]=(char*) p;
+		sg_register_mapped_region(p, length);
+	}
+
+	for (int32_t i=0; i<num_views; i++)
+		sg_ref_mapped_region(regions[i%4]+i);
+
+	/* views are copied on realloc */
+	regions[1][7]=42;
+	sg_ref_mapped_region(regions[1]+7);
+	char* copy=SG_REALLOC(char, regions[1]+7, 1, 2);
+	EXPECT_EQ(42, copy[0]);
+	SG_FREE(copy);
+
+	/* regions are unmapped in a different order than registered while
+	 * other threads look up pointers */
+	EXPECT_TRUE(sg_unref_mapped_region(regions[2]));
+	EXPECT_TRUE(sg_unref_mapped_region(regions[0]));
+
+	Parallel parallel;
+	parallel.set_num_threads(4);
+	parallel.parallel_for(0, num_views, free_mapped_views, regions, 1);
+
+	EXPECT_TRUE(sg_unref_mapped_region(regions[3]));
+	EXPECT_TRUE(sg_unref_mapped_region(regions[1]));
+
+	for (int32_t r=0; r<4; r++)
+		EXPECT_FALSE(sg_unref_mapped_region(regions[r]));
+}
+#endif
@@ -0,0 +1,192 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/lib/KDTreeIndex.h>
+#include <shogun/lib/BallTreeIndex.h>
+#include <shogun/lib/HNSWIndex.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/io/SerializableAsciiFile.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static CDenseFeatures<float64_t>* create_gaussian(int32_t dim, int32_t num)
+{
+	SGMatrix<float64_t> data(dim, num);
+	for (index_t i=0; i<dim*num; i++)
+		data.matrix[i]=CMath::randn_double();
+
+	return new CDenseFeatures<float64_t>(data);
+}
+
+/* all distances, sorted */
+static SGMatrix<index_t> brute_force(CDenseFeatures<float64_t>* data,
+		CDenseFeatures<float64_t>* queries, int32_t k,
+		SGMatrix<float64_t> distances)
+{
+	SGMatrix<float64_t> X=data->get_feature_matrix();
+	SGMatrix<float64_t> Q=queries->get_feature_matrix();
+	SGMatrix<index_t> result(k, Q.num_cols);
+	SGVector<float64_t> dists(X.num_cols);
+	SGVector<index_t> idx(X.num_cols);
+
+	for (index_t i=0; i<Q.num_cols; i++)
+	{
+		for (index_t j=0; j<X.num_cols; j++)
+		{
+			dists[j]=0;
+			for (index_t d=0; d<X.num_rows; d++)
+				dists[j]+=CMath::sq(X(d,j)-Q(d,i));
+			dists[j]=CMath::sqrt(dists[j]);
+			idx[j]=j;
+		}
+		CMath::qsort_index(dists.vector, idx.vector, X.num_cols);
+
+		for (index_t j=0; j<k; j++)
+		{
+			result(j,i)=idx[j];
+			distances(j,i)=dists[j];
+		}
+	}
+
+	return result;
+}
+
+static void check_exact(CNeighborIndex* index, int32_t dim)
+{
+	CMath::init_random(17);
+
+	CDenseFeatures<float64_t>* data=create_gaussian(dim, 500);
+	CDenseFeatures<float64_t>* queries=create_gaussian(dim, 100);
+	SG_REF(data);
+	SG_REF(queries);
+
+	index->build(data);
+	EXPECT_TRUE(index->is_built());
+	EXPECT_EQ(index->get_num_vectors(), 500);
+
+	int32_t k=7;
+	SGMatrix<float64_t> expected_dists(k, 100);
+	SGMatrix<index_t> expected=brute_force(data, queries, k, expected_dists);
+
+	SGMatrix<float64_t> dists(k, 100);
+	SGMatrix<index_t> neighbors=index->query(queries, k, dists);
+	ASSERT_EQ(neighbors.num_rows, k);
+	ASSERT_EQ(neighbors.num_cols, 100);
+
+	for (index_t i=0; i<k*100; i++)
+	{
+		EXPECT_EQ(neighbors[i], expected[i]);
+		EXPECT_NEAR(dists[i], expected_dists[i], 1E-10);
+	}
+
+	/* the indexed vectors themselves are their closest neighbors */
+	neighbors=index->query(data, 1);
+	for (index_t i=0; i<500; i++)
+		EXPECT_EQ(neighbors[i], i);
+
+	SG_UNREF(queries);
+	SG_UNREF(data);
+}
+
+TEST(NeighborIndex, kd_tree_equals_brute_force)
+{
+	CKDTreeIndex* index=new CKDTreeIndex(5);
+	SG_REF(index);
+	check_exact(index, 3);
+	EXPECT_GT(index->get_num_nodes(), 1);
+	SG_UNREF(index);
+}
+
+TEST(NeighborIndex, ball_tree_equals_brute_force)
+{
+	CBallTreeIndex* index=new CBallTreeIndex(5);
+	SG_REF(index);
+	check_exact(index, 10);
+	EXPECT_GT(index->get_num_nodes(), 1);
+	SG_UNREF(index);
+}
+
+TEST(NeighborIndex, hnsw_recall)
+{
+	CMath::init_random(17);
+
+	CDenseFeatures<float64_t>* data=create_gaussian(8, 2000);
+	CDenseFeatures<float64_t>* queries=create_gaussian(8, 100);
+	SG_REF(data);
+	SG_REF(queries);
+
+	CHNSWIndex* index=new CHNSWIndex(8, 100);
+	SG_REF(index);
+	index->build(data);
+	EXPECT_FALSE(index->is_exact());
+	EXPECT_GT(index->get_max_level(), 0);
+
+	int32_t k=10;
+	SGMatrix<float64_t> expected_dists(k, 100);
+	SGMatrix<index_t> expected=brute_force(data, queries, k, expected_dists);
+	SGMatrix<index_t> neighbors=index->query(queries, k);
+
+	int32_t found=0;
+	for (index_t i=0; i<100; i++)
+	{
+		for (index_t j=0; j<k; j++)
+		{
+			for (index_t l=0; l<k; l++)
+				found+=neighbors(j,i)==expected(l,i);
+		}
+	}
+	EXPECT_GT(found, 0.95*k*100);
+
+	SG_UNREF(index);
+	SG_UNREF(queries);
+	SG_UNREF(data);
+}
+
+TEST(NeighborIndex, serialization)
+{
+	CMath::init_random(17);
+
+	CDenseFeatures<float64_t>* data=create_gaussian(4, 300);
+	CDenseFeatures<float64_t>* queries=create_gaussian(4, 50);
+	SG_REF(data);
+	SG_REF(queries);
+
+	CNeighborIndex* indices[2]={new CBallTreeIndex(), new CHNSWIndex()};
+	CNeighborIndex* loaded[2]={new CBallTreeIndex(), new CHNSWIndex()};
+
+	for (index_t i=0; i<2; i++)
+	{
+		SG_REF(indices[i]);
+		SG_REF(loaded[i]);
+		indices[i]->build(data);
+
+		CSerializableAsciiFile* outfile=new CSerializableAsciiFile(
+				"neighbor_index.tmp", 'w');
+		indices[i]->save_serializable(outfile);
+		SG_UNREF(outfile);
+
+		CSerializableAsciiFile* infile=new CSerializableAsciiFile(
+				"neighbor_index.tmp", 'r');
+		loaded[i]->load_serializable(infile);
+		SG_UNREF(infile);
+
+		SGMatrix<index_t> expected=indices[i]->query(queries, 5);
+		SGMatrix<index_t> neighbors=loaded[i]->query(queries, 5);
+		for (index_t j=0; j<5*50; j++)
+			EXPECT_EQ(neighbors[j], expected[j]);
+
+		SG_UNREF(loaded[i]);
+		SG_UNREF(indices[i]);
+	}
+
+	SG_UNREF(queries);
+	SG_UNREF(data);
+}
@@ -0,0 +1,190 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/base/Parallel.h>
+#include <shogun/lib/ThreadPool.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/lib/ShogunException.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+struct ThreadPoolTestData
+{
+	int32_t* visited;
+	float64_t* thread_sums;
+	Parallel* parallel;
+};
+
+static void count_range(int32_t start, int32_t end, int32_t thread, void* p)
+{
+	ThreadPoolTestData* data=(ThreadPoolTestData*) p;
+	for (int32_t i=start; i<end; i++)
+	{
+		data->visited[i]++;
+		data->thread_sums[thread]+=i;
+	}
+}
+
+static void nested_range(int32_t start, int32_t end, int32_t thread, void* p)
+{
+	ThreadPoolTestData* data=(ThreadPoolTestData*) p;
+	for (int32_t i=start; i<end; i++)
+	{
+		ThreadPoolTestData inner;
+		int32_t visited[10]={0};
+		float64_t sums[4]={0};
+		inner.visited=visited;
+		inner.thread_sums=sums;
+		data->parallel->parallel_for(0, 10, count_range, &inner, 1);
+		for (int32_t j=0; j<10; j++)
+			data->visited[i]+=visited[j];
+	}
+}
+
+static void throwing_range(int32_t start, int32_t end, int32_t thread, void* p)
+{
+	ThreadPoolTestData* data=(ThreadPoolTestData*) p;
+	for (int32_t i=start; i<end; i++)
+	{
+		if (i==data->visited[0])
+			throw ShogunException("index reached");
+	}
+}
+
+TEST(ThreadPoolTest, parallel_for_visits_every_index_once)
+{
+	const int32_t num=10007;
+	const int32_t num_threads=4;
+
+	Parallel parallel;
+	parallel.set_num_threads(num_threads);
+
+	SGVector<int32_t> visited(num);
+	visited.zero();
+	SGVector<float64_t> sums(num_threads);
+	sums.zero();
+
+	ThreadPoolTestData data;
+	data.visited=visited.vector;
+	data.thread_sums=sums.vector;
+
+	for (int32_t chunk=0; chunk<5; chunk++)
+	{
+		visited.zero();
+		sums.zero();
+		parallel.parallel_for(0, num, count_range, &data, chunk);
+
+		for (int32_t i=0; i<num; i++)
+			EXPECT_EQ(visited[i], 1);
+
+		float64_t total=0;
+		for (int32_t t=0; t<num_threads; t++)
+			total+=sums[t];
+
+		EXPECT_EQ(total, float64_t(num-1)*num/2);
+	}
+}
+
+TEST(ThreadPoolTest, parallel_for_offset_range)
+{
+	Parallel parallel;
+	parallel.set_num_threads(3);
+
+	SGVector<int32_t> visited(100);
+	visited.zero();
+	SGVector<float64_t> sums(3);
+	sums.zero();
+
+	ThreadPoolTestData data;
+	data.visited=visited.vector;
+	data.thread_sums=sums.vector;
+
+	parallel.parallel_for(40, 100, count_range, &data);
+
+	for (int32_t i=0; i<100; i++)
+		EXPECT_EQ(visited[i], i<40 ? 0 : 1);
+}
+
+TEST(ThreadPoolTest, nested_parallel_for)
+{
+	Parallel parallel;
+	parallel.set_num_threads(4);
+
+	SGVector<int32_t> visited(50);
+	visited.zero();
+
+	ThreadPoolTestData data;
+	data.visited=visited.vector;
+	data.thread_sums=NULL;
+	data.parallel=&parallel;
+
+	parallel.parallel_for(0, 50, nested_range, &data, 1);
+
+	for (int32_t i=0; i<50; i++)
+		EXPECT_EQ(visited[i], 10);
+}
+
+TEST(ThreadPoolTest, workers_are_reused)
+{
+	Parallel parallel;
+	parallel.set_num_threads(4);
+
+	SGVector<int32_t> visited(1000);
+	SGVector<float64_t> sums(4);
+
+	ThreadPoolTestData data;
+	data.visited=visited.vector;
+	data.thread_sums=sums.vector;
+
+	visited.zero();
+	parallel.parallel_for(0, 1000, count_range, &data);
+	int32_t num_workers=CThreadPool::get_thread_pool()->get_num_workers();
+
+	for (int32_t i=0; i<100; i++)
+		parallel.parallel_for(0, 1000, count_range, &data);
+
+	EXPECT_EQ(num_workers, CThreadPool::get_thread_pool()->get_num_workers());
+	EXPECT_LE(num_workers, 3);
+
+	for (int32_t i=0; i<1000; i++)
+		EXPECT_EQ(visited[i], 101);
+}
+
+TEST(ThreadPoolTest, exception_is_rethrown_in_caller)
+{
+	Parallel parallel;
+	parallel.set_num_threads(4);
+
+	/* the first and the last index are processed by different threads */
+	int32_t throw_at[2]={0, 999};
+	for (int32_t k=0; k<2; k++)
+	{
+		ThreadPoolTestData data;
+		data.visited=&throw_at[k];
+		data.thread_sums=NULL;
+
+		EXPECT_THROW(parallel.parallel_for(0, 1000, throwing_range, &data, 1),
+				ShogunException);
+	}
+
+	/* the pool can be used again */
+	SGVector<int32_t> visited(1000);
+	visited.zero();
+	SGVector<float64_t> sums(4);
+	sums.zero();
+
+	ThreadPoolTestData data;
+	data.visited=visited.vector;
+	data.thread_sums=sums.vector;
+	parallel.parallel_for(0, 1000, count_range, &data);
+
+	for (int32_t i=0; i<1000; i++)
+		EXPECT_EQ(visited[i], 1);
+}
@@ -0,0 +1,110 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/lib/common.h>
+
+#ifdef HAVE_EIGEN3
+#include <shogun/mathematics/eigen3.h>
+
+#if EIGEN_VERSION_AT_LEAST(3,1,0)
+#include <unsupported/Eigen/MatrixFunctions>
+#include <shogun/lib/SGVector.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/mathematics/linalg/linop/DenseMatrixOperator.h>
+#include <shogun/lib/computation/jobresult/ScalarResult.h>
+#include <shogun/lib/computation/aggregator/StoreScalarAggregator.h>
+#include <shogun/mathematics/linalg/ratapprox/logdet/computation/job/DenseExactLogJob.h>
+#include <shogun/lib/computation/engine/ThreadPoolComputationEngine.h>
+#include <shogun/mathematics/Statistics.h>
+#include <gtest/gtest.h>
+
+using namespace Eigen;
+using namespace shogun;
+
+static float64_t compute_log_det(CThreadPoolComputationEngine* e,
+	SGMatrix<float64_t> mat)
+{
+	const index_t size=mat.num_rows;
+	SGMatrix<float64_t> log_mat(size, size);
+	Map<MatrixXd> m(mat.matrix, mat.num_rows, mat.num_cols);
+	Map<MatrixXd> log_m(log_mat.matrix, log_mat.num_rows, log_mat.num_cols);
+	log_m=m.log();
+
+	CDenseMatrixOperator<float64_t>* log_op=new CDenseMatrixOperator<float64_t>(log_mat);
+	SG_REF(log_op);
+	CStoreScalarAggregator<float64_t>* agg=new CStoreScalarAggregator<float64_t>;
+	SG_REF(agg);
+
+	// one job per unit-vector extracts the trace of log(mat)
+	for (index_t i=0; i<size; ++i)
+	{
+		SGVector<float64_t> s(size);
+		s.set_const(0.0);
+		s[i]=1.0;
+		CDenseExactLogJob *job=new CDenseExactLogJob((CJobResultAggregator*)agg,
+			log_op, s);
+		SG_REF(job);
+		e->submit_job(job);
+		SG_UNREF(job);
+	}
+
+	e->wait_for_all();
+	EXPECT_EQ(e->get_num_queued_jobs(), 0);
+	agg->finalize();
+
+	CScalarResult<float64_t>* r=dynamic_cast<CScalarResult<float64_t>*>
+		(agg->get_final_result());
+	float64_t result=r->get_result();
+
+	SG_UNREF(log_op);
+	SG_UNREF(agg);
+
+	return result;
+}
+
+static SGMatrix<float64_t> create_spd_matrix(index_t size)
+{
+	SGMatrix<float64_t> mat(size, size);
+	for (index_t i=0; i<size; ++i)
+	{
+		for (index_t j=0; j<size; ++j)
+			mat(i,j)=1.0/(1+CMath::abs(i-j));
+		mat(i,i)+=size;
+	}
+
+	return mat;
+}
+
+TEST(ThreadPoolComputationEngine, dense_log_det)
+{
+	CThreadPoolComputationEngine* e=new CThreadPoolComputationEngine();
+	SG_REF(e);
+	e->parallel->set_num_threads(4);
+
+	SGMatrix<float64_t> mat=create_spd_matrix(50);
+	EXPECT_NEAR(compute_log_det(e, mat), CStatistics::log_det(mat), 1E-10);
+
+	SG_UNREF(e);
+}
+
+TEST(ThreadPoolComputationEngine, bounded_queue)
+{
+	CThreadPoolComputationEngine* e=new CThreadPoolComputationEngine(7);
+	SG_REF(e);
+	e->parallel->set_num_threads(4);
+	EXPECT_EQ(e->get_queue_size(), 7);
+
+	SGMatrix<float64_t> mat=create_spd_matrix(30);
+	EXPECT_NEAR(compute_log_det(e, mat), CStatistics::log_det(mat), 1E-10);
+
+	SG_UNREF(e);
+}
+#endif // EIGEN_VERSION_AT_LEAST(3,1,0)
+#endif // HAVE_EIGEN3
@@ -0,0 +1,255 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/machine/LinearMulticlassMachine.h>
+#include <shogun/machine/KernelMulticlassMachine.h>
+#include <shogun/multiclass/MulticlassOneVsRestStrategy.h>
+#include <shogun/multiclass/MulticlassOneVsOneStrategy.h>
+#include <shogun/classifier/svm/LibLinear.h>
+#include <shogun/classifier/svm/LibSVM.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/CustomKernel.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/lib/DynamicObjectArray.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static CDenseFeatures<float64_t>* create_blobs(int32_t num_vec,
+		int32_t num_class, CMulticlassLabels*& labels)
+{
+	SGMatrix<float64_t> matrix(2, num_vec);
+	labels=new CMulticlassLabels(num_vec);
+	for (index_t i=0; i<num_vec; i++)
+	{
+		int32_t label=i%num_class;
+		labels->set_label(i, label);
+		matrix(0,i)=CMath::randn_double()+3*CMath::cos(label);
+		matrix(1,i)=CMath::randn_double()+3*CMath::sin(label);
+	}
+
+	return new CDenseFeatures<float64_t>(matrix);
+}
+
+static void check_same_outputs(CMulticlassMachine* machine,
+		CFeatures* train, CFeatures* test, float64_t accuracy)
+{
+	/* applying replaces the features, so pass them for each training */
+	machine->set_concurrent_training(false);
+	machine->train(train);
+	CMulticlassLabels* expected=machine->apply_multiclass(test);
+
+	machine->set_concurrent_training(true);
+	EXPECT_TRUE(machine->get_concurrent_training());
+	machine->train(train);
+	CMulticlassLabels* output=machine->apply_multiclass(test);
+
+	for (index_t i=0; i<test->get_num_vectors(); i++)
+	{
+		EXPECT_EQ(output->get_label(i), expected->get_label(i));
+		SGVector<float64_t> conf=output->get_multiclass_confidences(i);
+		SGVector<float64_t> expected_conf=
+			expected->get_multiclass_confidences(i);
+		for (index_t j=0; j<conf.vlen; j++)
+			EXPECT_NEAR(conf[j], expected_conf[j], accuracy);
+	}
+
+	SG_UNREF(output);
+	SG_UNREF(expected);
+}
+
+TEST(MulticlassMachine, concurrent_training_linear_one_vs_one)
+{
+	CMath::init_random(17);
+
+	CMulticlassLabels* labels;
+	CDenseFeatures<float64_t>* features=create_blobs(300, 5, labels);
+	CMulticlassLabels* test_labels;
+	CDenseFeatures<float64_t>* test=create_blobs(100, 5, test_labels);
+	SG_REF(features);
+	SG_REF(test);
+
+	/* primal solver, deterministic */
+	CLibLinear* svm=new CLibLinear(L2R_L2LOSS_SVC);
+	svm->set_epsilon(1e-8);
+	CLinearMulticlassMachine* machine=new CLinearMulticlassMachine(
+			new CMulticlassOneVsOneStrategy(), features, svm, labels);
+	SG_REF(machine);
+	machine->parallel->set_num_threads(4);
+
+	check_same_outputs(machine, features, test, 1E-6);
+
+	SG_UNREF(machine);
+	SG_UNREF(features);
+	SG_UNREF(test);
+	SG_UNREF(test_labels);
+}
+
+TEST(MulticlassMachine, concurrent_training_kernel_one_vs_rest)
+{
+	CMath::init_random(17);
+
+	CMulticlassLabels* labels;
+	CDenseFeatures<float64_t>* features=create_blobs(300, 4, labels);
+	CMulticlassLabels* test_labels;
+	CDenseFeatures<float64_t>* test=create_blobs(100, 4, test_labels);
+	SG_REF(features);
+	SG_REF(test);
+
+	CGaussianKernel* kernel=new CGaussianKernel(10, 2.0);
+	kernel->init(features, features);
+	CLibSVM* svm=new CLibSVM();
+	svm->set_epsilon(1e-8);
+	CKernelMulticlassMachine* machine=new CKernelMulticlassMachine(
+			new CMulticlassOneVsRestStrategy(), kernel, svm, labels);
+	SG_REF(machine);
+	machine->parallel->set_num_threads(4);
+
+	/* without opting in, the kernel is not rounded */
+	EXPECT_FALSE(machine->get_concurrent_single_precision());
+	check_same_outputs(machine, features, test, 1E-12);
+
+	/* the shared kernel matrix is stored in single precision */
+	machine->set_concurrent_single_precision(true);
+	check_same_outputs(machine, features, test, 1E-4);
+
+	SG_UNREF(machine);
+	SG_UNREF(features);
+	SG_UNREF(test);
+	SG_UNREF(test_labels);
+}
+
+TEST(MulticlassMachine, concurrent_training_custom_kernel_subset)
+{
+	CMath::init_random(17);
+
+	CMulticlassLabels* labels;
+	CDenseFeatures<float64_t>* features=create_blobs(300, 4, labels);
+	SG_REF(features);
+	SG_REF(labels);
+
+	CGaussianKernel* gaussian=new CGaussianKernel(10, 2.0);
+	gaussian->init(features, features);
+	CCustomKernel* kernel=new CCustomKernel(gaussian);
+	SG_UNREF(gaussian);
+
+	/* train on half of the vectors only */
+	SGVector<index_t> subset(150);
+	CMulticlassLabels* subset_labels=new CMulticlassLabels(subset.vlen);
+	for (index_t i=0; i<subset.vlen; i++)
+	{
+		subset[i]=(7*i)%300;
+		subset_labels->set_label(i, labels->get_label(subset[i]));
+	}
+	kernel->add_row_subset(subset);
+	kernel->add_col_subset(subset);
+
+	CLibSVM* svm=new CLibSVM();
+	svm->set_epsilon(1e-8);
+	CKernelMulticlassMachine* machine=new CKernelMulticlassMachine(
+			new CMulticlassOneVsRestStrategy(), kernel, svm, subset_labels);
+	SG_REF(machine);
+	machine->parallel->set_num_threads(4);
+
+	machine->set_concurrent_training(false);
+	machine->train();
+	CDynamicObjectArray* expected=new CDynamicObjectArray();
+	SG_REF(expected);
+	for (index_t m=0; m<machine->get_num_machines(); m++)
+	{
+		CMachine* submachine=machine->get_machine(m);
+		expected->append_element(submachine);
+		SG_UNREF(submachine);
+	}
+
+	/* the custom kernel is in single precision already, and support
+	 * vectors index into the subset in both cases */
+	machine->set_concurrent_training(true);
+	machine->train();
+	ASSERT_EQ(machine->get_num_machines(), expected->get_num_elements());
+	for (index_t m=0; m<machine->get_num_machines(); m++)
+	{
+		CKernelMachine* submachine=(CKernelMachine*) machine->get_machine(m);
+		CKernelMachine* expected_submachine=
+			(CKernelMachine*) expected->get_element(m);
+
+		EXPECT_NEAR(submachine->get_bias(), expected_submachine->get_bias(),
+				1E-6);
+		ASSERT_EQ(submachine->get_num_support_vectors(),
+				expected_submachine->get_num_support_vectors());
+		for (index_t i=0; i<submachine->get_num_support_vectors(); i++)
+		{
+			EXPECT_LT(submachine->get_support_vector(i), subset.vlen);
+			EXPECT_EQ(submachine->get_support_vector(i),
+					expected_submachine->get_support_vector(i));
+			EXPECT_NEAR(submachine->get_alpha(i),
+					expected_submachine->get_alpha(i), 1E-6);
+		}
+
+		SG_UNREF(expected_submachine);
+		SG_UNREF(submachine);
+	}
+
+	SG_UNREF(expected);
+	SG_UNREF(machine);
+	SG_UNREF(features);
+	SG_UNREF(labels);
+}
+
+TEST(MulticlassMachine, concurrent_training_kernel_one_vs_one)
+{
+	CMath::init_random(17);
+
+	int32_t num_class=4;
+	CMulticlassLabels* labels;
+	CDenseFeatures<float64_t>* features=create_blobs(200, num_class, labels);
+	SG_REF(labels);
+
+	CGaussianKernel* kernel=new CGaussianKernel(10, 2.0);
+	kernel->init(features, features);
+	CKernelMulticlassMachine* machine=new CKernelMulticlassMachine(
+			new CMulticlassOneVsOneStrategy(), kernel, new CLibSVM(), labels);
+	SG_REF(machine);
+	machine->set_concurrent_training(true);
+	machine->set_concurrent_single_precision(true);
+	machine->train();
+
+	ASSERT_EQ(machine->get_num_machines(), num_class*(num_class-1)/2);
+
+	/* submachines are trained on pairs of classes, their support vectors
+	 * index into the full training data */
+	int32_t m=0;
+	for (index_t a=0; a<num_class; a++)
+	{
+		for (index_t b=a+1; b<num_class; b++)
+		{
+			CKernelMachine* submachine=(CKernelMachine*) machine->get_machine(m++);
+			EXPECT_GT(submachine->get_num_support_vectors(), 0);
+			for (index_t i=0; i<submachine->get_num_support_vectors(); i++)
+			{
+				int32_t label=labels->get_int_label(
+						submachine->get_support_vector(i));
+				EXPECT_TRUE(label==a || label==b);
+			}
+			SG_UNREF(submachine);
+		}
+	}
+
+	CMulticlassLabels* output=machine->apply_multiclass(features);
+	int32_t correct=0;
+	for (index_t i=0; i<output->get_num_labels(); i++)
+		correct+=output->get_label(i)==labels->get_label(i);
+	EXPECT_GT(correct, 0.8*output->get_num_labels());
+
+	SG_UNREF(output);
+	SG_UNREF(machine);
+	SG_UNREF(labels);
+}
@@ -0,0 +1,182 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/lib/config.h>
+
+#ifdef HAVE_LAPACK
+#ifdef HAVE_EIGEN3
+
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/machine/gp/ExactInferenceMethod.h>
+#include <shogun/machine/gp/MatrixFreeInferenceMethod.h>
+#include <shogun/machine/gp/ZeroMean.h>
+#include <shogun/machine/gp/GaussianLikelihood.h>
+#include <shogun/mathematics/linalg/linsolver/ConjugateGradientSolver.h>
+#include <shogun/lib/computation/engine/ThreadPoolComputationEngine.h>
+#include <shogun/regression/GaussianProcessRegression.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+/* 1d noisy sine wave */
+static void create_data(index_t n, SGMatrix<float64_t>& X,
+		SGVector<float64_t>& Y)
+{
+	X=SGMatrix<float64_t>(1, n);
+	Y=SGVector<float64_t>(n);
+
+	for (index_t i=0; i<n; ++i)
+	{
+		X[i]=CMath::random(0.0, 6.0);
+		Y[i]=CMath::sin(X[i])+0.25*CMath::randn_double();
+	}
+}
+
+static CMatrixFreeInferenceMethod* create_matrix_free(CKernel* kernel,
+		CFeatures* feat, CLabels* lab, CLikelihoodModel* lik,
+		int32_t num_probe_vectors)
+{
+	CMatrixFreeInferenceMethod* inf=new CMatrixFreeInferenceMethod(kernel,
+			feat, new CZeroMean(), lab, lik);
+	inf->set_num_probe_vectors(num_probe_vectors);
+
+	CConjugateGradientSolver* solver=inf->get_linear_solver();
+	solver->set_relative_tolerence(1E-12);
+	solver->set_absolute_tolerence(1E-12);
+	SG_UNREF(solver);
+
+	return inf;
+}
+
+TEST(MatrixFreeInferenceMethod,compare_with_exact)
+{
+	CMath::init_random(17);
+
+	SGMatrix<float64_t> X;
+	SGVector<float64_t> Y;
+	create_data(40, X, Y);
+
+	CDenseFeatures<float64_t>* feat=new CDenseFeatures<float64_t>(X);
+	CRegressionLabels* lab=new CRegressionLabels(Y);
+
+	CExactInferenceMethod* exact=new CExactInferenceMethod(
+			new CGaussianKernel(10, 0.5), feat, new CZeroMean(), lab,
+			new CGaussianLikelihood(0.25));
+	exact->set_scale(1.5);
+	SG_REF(exact);
+
+	CGaussianKernel* kernel=new CGaussianKernel(10, 0.5);
+	CGaussianLikelihood* lik=new CGaussianLikelihood(0.25);
+	CMatrixFreeInferenceMethod* inf=create_matrix_free(kernel, feat, lab, lik,
+			100);
+	inf->set_scale(1.5);
+	inf->set_computation_engine(new CThreadPoolComputationEngine());
+	SG_REF(inf);
+
+	SGVector<float64_t> alpha=inf->get_alpha();
+	SGVector<float64_t> exact_alpha=exact->get_alpha();
+	SGVector<float64_t> mu=inf->get_posterior_mean();
+	SGVector<float64_t> exact_mu=exact->get_posterior_mean();
+	for (index_t i=0; i<alpha.vlen; ++i)
+	{
+		EXPECT_NEAR(alpha[i], exact_alpha[i], 1E-8);
+		EXPECT_NEAR(mu[i], exact_mu[i], 1E-8);
+	}
+
+	// stochastic estimates
+	float64_t nlZ=exact->get_negative_log_marginal_likelihood();
+	EXPECT_NEAR(inf->get_negative_log_marginal_likelihood(), nlZ,
+			0.1*CMath::abs(nlZ));
+
+	CMap<TParameter*, CSGObject*>* exact_params=
+		new CMap<TParameter*, CSGObject*>();
+	exact->build_gradient_parameter_dictionary(exact_params);
+	CMap<TParameter*, SGVector<float64_t> >* exact_gradient=
+		exact->get_negative_log_marginal_likelihood_derivatives(exact_params);
+
+	CMap<TParameter*, CSGObject*>* params=new CMap<TParameter*, CSGObject*>();
+	inf->build_gradient_parameter_dictionary(params);
+	CMap<TParameter*, SGVector<float64_t> >* gradient=
+		inf->get_negative_log_marginal_likelihood_derivatives(params);
+
+	ASSERT_EQ(gradient->get_num_elements(), exact_gradient->get_num_elements());
+	for (index_t i=0; i<gradient->get_num_elements(); ++i)
+	{
+		const char* name=gradient->get_node_ptr(i)->key->m_name;
+		float64_t value=gradient->get_node_ptr(i)->data[0];
+
+		for (index_t j=0; j<exact_gradient->get_num_elements(); ++j)
+		{
+			if (strcmp(exact_gradient->get_node_ptr(j)->key->m_name, name))
+				continue;
+
+			float64_t expected=exact_gradient->get_node_ptr(j)->data[0];
+			EXPECT_NEAR(value, expected, 0.2*CMath::abs(expected)+0.2)
+				<< "derivative wrt " << name;
+		}
+	}
+
+	SG_UNREF(gradient);
+	SG_UNREF(params);
+	SG_UNREF(exact_gradient);
+	SG_UNREF(exact_params);
+	SG_UNREF(inf);
+	SG_UNREF(exact);
+}
+
+TEST(MatrixFreeInferenceMethod,apply_regression)
+{
+	CMath::init_random(17);
+
+	SGMatrix<float64_t> X;
+	SGVector<float64_t> Y;
+	create_data(50, X, Y);
+
+	SGMatrix<float64_t> X_test(1, 20);
+	for (index_t i=0; i<X_test.num_cols; ++i)
+		X_test[i]=0.3*i;
+
+	CDenseFeatures<float64_t>* feat=new CDenseFeatures<float64_t>(X);
+	CDenseFeatures<float64_t>* feat_test=new CDenseFeatures<float64_t>(X_test);
+	SG_REF(feat_test);
+	CRegressionLabels* lab=new CRegressionLabels(Y);
+
+	CGaussianProcessRegression* exact_gpr=new CGaussianProcessRegression(
+			new CExactInferenceMethod(new CGaussianKernel(10, 1.0), feat,
+			new CZeroMean(), lab, new CGaussianLikelihood(0.25)));
+	SG_REF(exact_gpr);
+
+	CGaussianProcessRegression* gpr=new CGaussianProcessRegression(
+			create_matrix_free(new CGaussianKernel(10, 1.0), feat, lab,
+			new CGaussianLikelihood(0.25), 1));
+	SG_REF(gpr);
+
+	exact_gpr->train();
+	gpr->train();
+
+	SGVector<float64_t> exact_mean=exact_gpr->get_mean_vector(feat_test);
+	SGVector<float64_t> exact_var=exact_gpr->get_variance_vector(feat_test);
+	SGVector<float64_t> mean=gpr->get_mean_vector(feat_test);
+	SGVector<float64_t> var=gpr->get_variance_vector(feat_test);
+
+	for (index_t i=0; i<X_test.num_cols; ++i)
+	{
+		EXPECT_NEAR(mean[i], exact_mean[i], 1E-8);
+		EXPECT_NEAR(var[i], exact_var[i], 1E-8);
+	}
+
+	SG_UNREF(gpr);
+	SG_UNREF(exact_gpr);
+	SG_UNREF(feat_test);
+}
+
+#endif /* HAVE_EIGEN3 */
+#endif /* HAVE_LAPACK */
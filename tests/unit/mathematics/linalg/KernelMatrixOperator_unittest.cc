@@ -0,0 +1,62 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/KernelRowCache.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/linalg/linop/KernelMatrixOperator.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+TEST(KernelMatrixOperator, apply)
+{
+	const index_t size=30;
+	SGMatrix<float64_t> data(2, size);
+	for (index_t i=0; i<data.num_rows*data.num_cols; ++i)
+		data.matrix[i]=CMath::randn_double();
+
+	CDenseFeatures<float64_t>* feat=new CDenseFeatures<float64_t>(data);
+	CGaussianKernel* kernel=new CGaussianKernel(10, 2.0);
+	SG_REF(kernel);
+	kernel->init(feat, feat);
+	SGMatrix<float64_t> K=kernel->get_kernel_matrix();
+
+	const float64_t scale=1.5;
+	const float64_t ridge=0.3;
+	CKernelMatrixOperator* op=new CKernelMatrixOperator(kernel, scale, ridge);
+	SG_REF(op);
+	EXPECT_EQ(op->get_dimension(), size);
+
+	SGVector<float64_t> b(size);
+	for (index_t i=0; i<size; ++i)
+		b[i]=CMath::randn_double();
+
+	// applying twice gives the same result when rows are served from a cache
+	kernel->set_row_cache(new CKernelRowCache(1));
+	for (index_t pass=0; pass<2; ++pass)
+	{
+		SGVector<float64_t> result=op->apply(b);
+		for (index_t i=0; i<size; ++i)
+		{
+			float64_t expected=ridge*b[i];
+			for (index_t j=0; j<size; ++j)
+				expected+=scale*K(i,j)*b[j];
+
+			EXPECT_NEAR(result[i], expected, 1E-12);
+		}
+	}
+
+	SG_UNREF(op);
+	SG_UNREF(kernel);
+}
@@ -0,0 +1,178 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/modelselection/GridSearchModelSelection.h>
+#include <shogun/modelselection/RandomSearchModelSelection.h>
+#include <shogun/modelselection/ModelSelectionParameters.h>
+#include <shogun/modelselection/ParameterCombination.h>
+#include <shogun/evaluation/CrossValidation.h>
+#include <shogun/evaluation/CrossValidationSplitting.h>
+#include <shogun/evaluation/MeanSquaredError.h>
+#include <shogun/regression/svr/LibSVR.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static CModelSelectionParameters* create_param_tree(CKernel* kernel)
+{
+	CModelSelectionParameters* root=new CModelSelectionParameters();
+
+	CModelSelectionParameters* c1=new CModelSelectionParameters("C1");
+	root->append_child(c1);
+	c1->build_values(-2.0, 2.0, R_EXP);
+
+	CModelSelectionParameters* param_kernel=
+			new CModelSelectionParameters("kernel", kernel);
+	CModelSelectionParameters* width=new CModelSelectionParameters("width");
+	width->build_values(-2.0, 2.0, R_EXP);
+	param_kernel->append_child(width);
+	root->append_child(param_kernel);
+
+	return root;
+}
+
+/* noisy sine, evaluated by leave-one-out such that the result of each
+ * combination does not depend on the random splitting */
+static CCrossValidation* create_xval(CKernel* kernel)
+{
+	index_t num=30;
+	SGMatrix<float64_t> data(1, num);
+	SGVector<float64_t> lab(num);
+	for (index_t i=0; i<num; i++)
+	{
+		data(0,i)=CMath::random(-3.0, 3.0);
+		lab[i]=CMath::sin(data(0,i))+0.1*CMath::randn_double();
+	}
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+	CRegressionLabels* labels=new CRegressionLabels(lab);
+	CLibSVR* svr=new CLibSVR();
+	svr->set_kernel(kernel);
+
+	CCrossValidationSplitting* splitting=
+			new CCrossValidationSplitting(labels, num);
+	CMeanSquaredError* mse=new CMeanSquaredError();
+
+	return new CCrossValidation(svr, features, labels, splitting, mse);
+}
+
+static void get_selected(CParameterCombination* combination,
+		CCrossValidation* xval, CGaussianKernel* kernel, float64_t& C,
+		float64_t& width)
+{
+	CLibSVR* svr=(CLibSVR*) xval->get_machine();
+	combination->apply_to_machine(svr);
+	C=svr->get_C1();
+	width=kernel->get_width();
+	SG_UNREF(svr);
+}
+
+TEST(GridSearchModelSelection, parallel_equals_serial)
+{
+	CMath::init_random(17);
+
+	CGaussianKernel* kernel=new CGaussianKernel(10, 1.0);
+	CCrossValidation* xval=create_xval(kernel);
+	CModelSelectionParameters* params=create_param_tree(kernel);
+	CGridSearchModelSelection* grid=new CGridSearchModelSelection(xval, params);
+	SG_REF(grid);
+
+	float64_t C[3];
+	float64_t width[3];
+
+	CParameterCombination* best=grid->select_model();
+	get_selected(best, xval, kernel, C[0], width[0]);
+	SG_UNREF(best);
+
+	grid->parallel->set_num_threads(4);
+	grid->set_parallel_combinations(true);
+	best=grid->select_model();
+	get_selected(best, xval, kernel, C[1], width[1]);
+	SG_UNREF(best);
+
+	/* abandoning only skips combinations that cannot be the best one */
+	grid->set_early_abandoning(true, 0.0);
+	best=grid->select_model();
+	get_selected(best, xval, kernel, C[2], width[2]);
+	SG_UNREF(best);
+
+	for (index_t i=1; i<3; i++)
+	{
+		EXPECT_EQ(C[0], C[i]);
+		EXPECT_EQ(width[0], width[i]);
+	}
+
+	SG_UNREF(grid);
+}
+
+TEST(GridSearchModelSelection, serial_early_abandoning)
+{
+	CMath::init_random(17);
+
+	CGaussianKernel* kernel=new CGaussianKernel(10, 1.0);
+	CCrossValidation* xval=create_xval(kernel);
+	CModelSelectionParameters* params=create_param_tree(kernel);
+	CGridSearchModelSelection* grid=new CGridSearchModelSelection(xval, params);
+	SG_REF(grid);
+	grid->parallel->set_num_threads(1);
+
+	float64_t C[2];
+	float64_t width[2];
+
+	CParameterCombination* best=grid->select_model();
+	get_selected(best, xval, kernel, C[0], width[0]);
+	SG_UNREF(best);
+
+	grid->set_early_abandoning(true, 0.0);
+	best=grid->select_model();
+	get_selected(best, xval, kernel, C[1], width[1]);
+	SG_UNREF(best);
+
+	EXPECT_EQ(C[0], C[1]);
+	EXPECT_EQ(width[0], width[1]);
+
+	/* a threshold that cannot be beaten stops after the first fold */
+	xval->set_abandon_threshold(-1.0, 0.0);
+	CCrossValidationResult* result=(CCrossValidationResult*) xval->evaluate();
+	EXPECT_TRUE(xval->is_abandoned());
+	EXPECT_GE(result->mean, 0.0);
+	SG_UNREF(result);
+
+	xval->unset_abandon_threshold();
+	result=(CCrossValidationResult*) xval->evaluate();
+	EXPECT_FALSE(xval->is_abandoned());
+	SG_UNREF(result);
+
+	SG_UNREF(grid);
+}
+
+TEST(RandomSearchModelSelection, parallel_select_model)
+{
+	CMath::init_random(17);
+
+	CGaussianKernel* kernel=new CGaussianKernel(10, 1.0);
+	CCrossValidation* xval=create_xval(kernel);
+	CModelSelectionParameters* params=create_param_tree(kernel);
+	CRandomSearchModelSelection* random=
+			new CRandomSearchModelSelection(xval, params, 0.5);
+	SG_REF(random);
+
+	random->parallel->set_num_threads(4);
+	random->set_parallel_combinations(true);
+	CParameterCombination* best=random->select_model();
+	ASSERT_TRUE(best!=NULL);
+	SG_UNREF(best);
+
+	SG_UNREF(random);
+}
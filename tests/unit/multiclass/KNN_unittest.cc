@@ -0,0 +1,80 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/multiclass/KNN.h>
+#include <shogun/lib/KDTreeIndex.h>
+#include <shogun/lib/BallTreeIndex.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/distance/EuclideanDistance.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+TEST(KNN, neighbor_index_equals_brute_force)
+{
+	CMath::init_random(17);
+
+	int32_t num_train=300;
+	int32_t num_test=100;
+	int32_t num_classes=3;
+
+	SGMatrix<float64_t> train(2, num_train);
+	SGMatrix<float64_t> test(2, num_test);
+	SGVector<float64_t> lab(num_train);
+	for (index_t i=0; i<num_train; i++)
+	{
+		lab[i]=i%num_classes;
+		train(0,i)=CMath::randn_double()+lab[i];
+		train(1,i)=CMath::randn_double()-lab[i];
+	}
+	for (index_t i=0; i<num_test*2; i++)
+		test.matrix[i]=CMath::randn_double()*2;
+
+	CDenseFeatures<float64_t>* features_train=
+		new CDenseFeatures<float64_t>(train);
+	CDenseFeatures<float64_t>* features_test=
+		new CDenseFeatures<float64_t>(test);
+	CMulticlassLabels* labels=new CMulticlassLabels(lab);
+	SG_REF(features_test);
+
+	CKNN* knn=new CKNN(5, new CEuclideanDistance(features_train,
+			features_train), labels);
+	SG_REF(knn);
+	knn->train();
+
+	CMulticlassLabels* expected=knn->apply_multiclass(features_test);
+	SGMatrix<int32_t> expected_multiple_k=knn->classify_for_multiple_k();
+
+	CNeighborIndex* indices[2]={new CKDTreeIndex(4), new CBallTreeIndex(4)};
+	for (index_t i=0; i<2; i++)
+	{
+		knn->set_neighbor_index(indices[i]);
+		knn->train();
+		EXPECT_TRUE(indices[i]->is_built());
+
+		/* the index is reused for every apply */
+		for (index_t rep=0; rep<2; rep++)
+		{
+			CMulticlassLabels* output=knn->apply_multiclass(features_test);
+			for (index_t j=0; j<num_test; j++)
+				EXPECT_EQ(output->get_label(j), expected->get_label(j));
+			SG_UNREF(output);
+		}
+
+		SGMatrix<int32_t> multiple_k=knn->classify_for_multiple_k();
+		for (index_t j=0; j<multiple_k.num_rows*multiple_k.num_cols; j++)
+			EXPECT_EQ(multiple_k[j], expected_multiple_k[j]);
+	}
+
+	SG_UNREF(expected);
+	SG_UNREF(knn);
+	SG_UNREF(features_test);
+}
@@ -1,5 +1,7 @@
 #include <shogun/multiclass/MulticlassLibLinear.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/DenseSubsetFeatures.h>
+#include <shogun/features/SparseFeatures.h>
 #include <gtest/gtest.h>
 
 using namespace shogun;
@@ -56,3 +58,82 @@ TEST(MulticlassLibLinearTest,train_and_apply)
 	SG_UNREF(labels_test);
 	SG_UNREF(pred);
 }
+
+TEST(MulticlassLibLinearTest,apply_all_submachines_at_once)
+{
+	CMath::init_random(17);
+
+	index_t num_vec=300;
+	index_t num_feat=20;
+	index_t num_class=5;
+
+	SGMatrix<float64_t> matrix(num_feat, num_vec);
+	SGMatrix<float64_t> matrix_test(num_feat, num_vec);
+	CMulticlassLabels* labels=new CMulticlassLabels(num_vec);
+	for (index_t i=0; i<num_vec; ++i)
+	{
+		labels->set_label(i, i%num_class);
+		for (index_t j=0; j<num_feat; ++j)
+		{
+			matrix(j, i)=CMath::randn_double()+(j==i%num_class ? 2 : 0);
+			/* sparse test vectors */
+			matrix_test(j, i)=CMath::random(0, 2) ? 0 : CMath::randn_double();
+		}
+	}
+
+	CMulticlassLibLinear* machine=new CMulticlassLibLinear(1.0,
+			new CDenseFeatures<float64_t>(matrix), labels);
+	SG_REF(machine);
+	machine->parallel->set_num_threads(4);
+	machine->train();
+
+	CDenseFeatures<float64_t>* dense_test=new CDenseFeatures<float64_t>(
+			matrix_test);
+	SGVector<int32_t> idx(num_feat);
+	idx.range_fill();
+	CDotFeatures* tests[3]={dense_test,
+		new CSparseFeatures<float64_t>(matrix_test),
+		new CDenseSubsetFeatures<float64_t>(dense_test, idx)};
+
+	for (index_t t=0; t<3; t++)
+	{
+		SG_REF(tests[t]);
+		CMulticlassLabels* pred=machine->apply_multiclass(tests[t]);
+
+		/* reference: outputs of each submachine */
+		for (index_t j=0; j<num_class; j++)
+		{
+			CBinaryLabels* outputs=machine->get_submachine_outputs(j);
+			for (index_t i=0; i<num_vec; i++)
+			{
+				EXPECT_NEAR(pred->get_multiclass_confidences(i)[j],
+						outputs->get_value(i), 1E-10);
+			}
+			SG_UNREF(outputs);
+		}
+
+		for (index_t i=0; i<num_vec; i++)
+		{
+			SGVector<float64_t> conf=pred->get_multiclass_confidences(i);
+			EXPECT_EQ(pred->get_int_label(i),
+					SGVector<float64_t>::arg_max(conf.vector, 1, conf.vlen));
+		}
+
+		/* without confidences labels are decided per block */
+		machine->set_store_confidences(false);
+		CMulticlassLabels* fused=machine->apply_multiclass(tests[t]);
+		machine->set_store_confidences(true);
+		for (index_t i=0; i<num_vec; i++)
+		{
+			EXPECT_EQ(fused->get_int_label(i), pred->get_int_label(i));
+			EXPECT_EQ(fused->get_multiclass_confidences(i).vlen, 0);
+		}
+		SG_UNREF(fused);
+
+		SG_UNREF(pred);
+	}
+
+	for (index_t t=0; t<3; t++)
+		SG_UNREF(tests[t]);
+	SG_UNREF(machine);
+}
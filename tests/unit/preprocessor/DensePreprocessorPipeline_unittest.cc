@@ -0,0 +1,170 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/mathematics/Math.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/preprocessor/DensePreprocessorPipeline.h>
+#include <shogun/preprocessor/PruneVarSubMean.h>
+#include <shogun/preprocessor/NormOne.h>
+#include <shogun/preprocessor/LogPlusOne.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+/* features without a matrix, vectors are computed (and preprocessed) on
+ * the fly */
+class CComputedFeatures : public CDenseFeatures<float64_t>
+{
+	public:
+		CComputedFeatures(SGMatrix<float64_t> data) : CDenseFeatures<float64_t>()
+		{
+			m_data=data;
+			set_num_features(data.num_rows);
+			set_num_vectors(data.num_cols);
+		}
+
+		virtual const char* get_name() const { return "ComputedFeatures"; }
+
+	protected:
+		virtual float64_t* compute_feature_vector(int32_t num, int32_t& len,
+				float64_t* target=NULL)
+		{
+			len=m_data.num_rows;
+			if (!target)
+				target=SG_MALLOC(float64_t, len);
+
+			memcpy(target, m_data.get_column_vector(num), sizeof(float64_t)*len);
+			return target;
+		}
+
+		SGMatrix<float64_t> m_data;
+};
+
+static SGMatrix<float64_t> create_data(int32_t num_features, int32_t num_vectors)
+{
+	SGMatrix<float64_t> data(num_features, num_vectors);
+	for (index_t i=0; i<num_vectors; i++)
+	{
+		for (index_t j=0; j<num_features; j++)
+			data(j,i)=j%3 ? CMath::randn_double()+j : 1.0;
+	}
+
+	return data;
+}
+
+/* PruneVarSubMean followed by NormOne, computed directly */
+static SGMatrix<float64_t> expected_result(SGMatrix<float64_t> data)
+{
+	CDenseFeatures<float64_t>* feats=new CDenseFeatures<float64_t>(data.clone());
+	CPruneVarSubMean* prune=new CPruneVarSubMean();
+	prune->init(feats);
+	SG_REF(prune);
+
+	SGMatrix<float64_t> result(0, data.num_cols);
+	for (index_t i=0; i<data.num_cols; i++)
+	{
+		SGVector<float64_t> v=prune->apply_to_feature_vector(
+				SGVector<float64_t>(data.get_column_vector(i), data.num_rows, false));
+
+		if (!result.num_rows)
+			result=SGMatrix<float64_t>(v.vlen, data.num_cols);
+
+		float64_t norm=CMath::sqrt(SGVector<float64_t>::dot(v.vector, v.vector, v.vlen));
+		for (index_t j=0; j<v.vlen; j++)
+			result(j,i)=v[j]/norm;
+	}
+
+	SG_UNREF(prune);
+	SG_UNREF(feats);
+	return result;
+}
+
+TEST(DensePreprocessorPipeline, fused_prune_var_sub_mean_norm_one)
+{
+	CMath::init_random(17);
+	SGMatrix<float64_t> data=create_data(9, 100);
+	SGMatrix<float64_t> expected=expected_result(data);
+
+	CDenseFeatures<float64_t>* feats=new CDenseFeatures<float64_t>(data.clone());
+	CPruneVarSubMean* prune=new CPruneVarSubMean();
+	prune->init(feats);
+	feats->add_preprocessor(prune);
+	feats->add_preprocessor(new CNormOne());
+	feats->parallel->set_num_threads(4);
+
+	CDensePreprocessorPipeline<float64_t>* pipeline=
+		new CDensePreprocessorPipeline<float64_t>();
+	SG_REF(pipeline);
+	pipeline->compile(feats, 0, 2);
+	EXPECT_EQ(pipeline->get_num_steps(), 1);
+	EXPECT_TRUE(pipeline->matches(feats));
+	SG_UNREF(pipeline);
+
+	EXPECT_TRUE(feats->apply_preprocessor());
+	EXPECT_EQ(feats->get_num_features(), expected.num_rows);
+
+	SGMatrix<float64_t> result=feats->get_feature_matrix();
+	EXPECT_EQ(result.num_rows, expected.num_rows);
+	for (index_t i=0; i<data.num_cols; i++)
+	{
+		for (index_t j=0; j<expected.num_rows; j++)
+			EXPECT_NEAR(result(j,i), expected(j,i), 1E-14);
+	}
+
+	SG_UNREF(feats);
+}
+
+TEST(DensePreprocessorPipeline, on_the_fly)
+{
+	CMath::init_random(17);
+	SGMatrix<float64_t> data=create_data(9, 20);
+	SGMatrix<float64_t> expected=expected_result(data);
+
+	CDenseFeatures<float64_t>* dense=new CDenseFeatures<float64_t>(data.clone());
+	CPruneVarSubMean* prune=new CPruneVarSubMean();
+	prune->init(dense);
+	SG_UNREF(dense);
+
+	CComputedFeatures* feats=new CComputedFeatures(data);
+	feats->add_preprocessor(prune);
+	feats->add_preprocessor(new CNormOne());
+
+	for (index_t i=0; i<data.num_cols; i++)
+	{
+		SGVector<float64_t> v=feats->get_feature_vector(i);
+		ASSERT_EQ(v.vlen, expected.num_rows);
+		for (index_t j=0; j<v.vlen; j++)
+			EXPECT_NEAR(v[j], expected(j,i), 1E-14);
+		feats->free_feature_vector(v, i);
+	}
+
+	/* the pipeline is recompiled when the preprocessors change */
+	feats->add_preprocessor(new CLogPlusOne());
+	for (index_t i=0; i<data.num_cols; i++)
+	{
+		SGVector<float64_t> v=feats->get_feature_vector(i);
+		ASSERT_EQ(v.vlen, expected.num_rows);
+		for (index_t j=0; j<v.vlen; j++)
+			EXPECT_NEAR(v[j], CMath::log(expected(j,i)+1.0), 1E-14);
+		feats->free_feature_vector(v, i);
+	}
+
+	/* and when they are deleted */
+	feats->del_preprocessor(2);
+	for (index_t i=0; i<data.num_cols; i++)
+	{
+		SGVector<float64_t> v=feats->get_feature_vector(i);
+		ASSERT_EQ(v.vlen, expected.num_rows);
+		for (index_t j=0; j<v.vlen; j++)
+			EXPECT_NEAR(v[j], expected(j,i), 1E-14);
+		feats->free_feature_vector(v, i);
+	}
+
+	SG_UNREF(feats);
+}
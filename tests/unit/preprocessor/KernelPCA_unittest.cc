@@ -48,4 +48,102 @@ TEST(KernelPCA, DISABLED_apply_to_feature_matrix_input)
 	for (index_t i = 0; i < num_features * num_vectors; ++i)
 		EXPECT_LE(CMath::abs(embedding.matrix[i] - s * resdata[i]), 1E-6);
 }
+
+/* projections of the training vectors on the leading principal components,
+ * computed from the full centered kernel matrix */
+static SGMatrix<float64_t> kpca_reference(SGMatrix<float64_t> data,
+		float64_t width, int32_t target_dim)
+{
+	CDenseFeatures<float64_t>* feats=new CDenseFeatures<float64_t>(data);
+	CGaussianKernel* kernel=new CGaussianKernel(feats, feats, width);
+	SGMatrix<float64_t> K=kernel->get_kernel_matrix();
+	int32_t n=K.num_rows;
+	SGMatrix<float64_t>::center_matrix(K.matrix, n, n);
+	float64_t* eigenvalues=SGMatrix<float64_t>::compute_eigenvectors(K.matrix, n, n);
+
+	SGMatrix<float64_t> result(target_dim, n);
+	for (int32_t k=0; k<target_dim; k++)
+	{
+		for (int32_t i=0; i<n; i++)
+			result(k,i)=CMath::sqrt(eigenvalues[n-k-1])*K(i,n-k-1);
+	}
+
+	SG_FREE(eigenvalues);
+	SG_UNREF(kernel);
+	return result;
+}
+
+static SGMatrix<float64_t> kpca_embedding(SGMatrix<float64_t> data,
+		float64_t width, int32_t target_dim, EKernelPCAMethod method, int32_t num)
+{
+	CDenseFeatures<float64_t>* feats=new CDenseFeatures<float64_t>(data.clone());
+	SG_REF(feats);
+	CKernelPCA* kpca=new CKernelPCA(new CGaussianKernel(10, width));
+	SG_REF(kpca);
+	kpca->set_target_dim(target_dim);
+	kpca->set_method(method);
+	kpca->set_num_landmarks(num);
+	kpca->set_num_random_features(num);
+	kpca->init(feats);
+	SGMatrix<float64_t> embedding=kpca->apply_to_feature_matrix(feats);
+
+	SG_UNREF(kpca);
+	SG_UNREF(feats);
+	return embedding;
+}
+
+/* relative difference of two embeddings, allowing opposite signs */
+static float64_t embedding_difference(SGMatrix<float64_t> a,
+		SGMatrix<float64_t> b)
+{
+	float64_t diff=0;
+	float64_t norm=0;
+	for (index_t k=0; k<a.num_rows; k++)
+	{
+		float64_t s=a(k,0)*b(k,0)<0 ? -1 : 1;
+		for (index_t i=0; i<a.num_cols; i++)
+		{
+			diff+=CMath::sq(a(k,i)-s*b(k,i));
+			norm+=CMath::sq(b(k,i));
+		}
+	}
+
+	return CMath::sqrt(diff/norm);
+}
+
+TEST(KernelPCA, nystroem_all_landmarks)
+{
+	CMath::init_random(17);
+	SGMatrix<float64_t> data(2, 60);
+	for (index_t i=0; i<data.num_rows*data.num_cols; i++)
+		data.matrix[i]=CMath::randn_double();
+
+	SGMatrix<float64_t> expected=kpca_reference(data, 2.0, 3);
+	SGMatrix<float64_t> embedding=kpca_embedding(data, 2.0, 3, KPCA_NYSTROEM,
+			60);
+
+	EXPECT_LE(embedding_difference(embedding, expected), 1E-8);
+}
+
+TEST(KernelPCA, approximations)
+{
+	CMath::init_random(17);
+	SGMatrix<float64_t> data(2, 500);
+	/* well separated eigenvalues */
+	for (index_t i=0; i<data.num_cols; i++)
+	{
+		data(0,i)=3*CMath::randn_double();
+		data(1,i)=CMath::randn_double();
+	}
+
+	SGMatrix<float64_t> expected=kpca_reference(data, 2.0, 2);
+	SGMatrix<float64_t> nystroem=kpca_embedding(data, 2.0, 2, KPCA_NYSTROEM,
+			100);
+	SGMatrix<float64_t> rff=kpca_embedding(data, 2.0, 2, KPCA_RANDOM_FOURIER,
+			500);
+
+	EXPECT_LE(embedding_difference(nystroem, expected), 0.01);
+	/* Monte Carlo error of the random features is O(1/sqrt(D)) */
+	EXPECT_LE(embedding_difference(rff, expected), 0.25);
+}
 #endif // HAVE_LAPACK
@@ -0,0 +1,118 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2026 agent
+ */
+
+#include <shogun/lib/config.h>
+
+#ifdef HAVE_LAPACK
+
+#include <shogun/regression/KernelRidgeRegression.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+/* noisy sine on [0,6] */
+static void create_data(index_t num, CDenseFeatures<float64_t>*& features,
+		CRegressionLabels*& labels)
+{
+	SGMatrix<float64_t> X(1, num);
+	SGVector<float64_t> y(num);
+
+	for (index_t i=0; i<num; i++)
+	{
+		X(0,i)=CMath::random(0.0, 6.0);
+		y[i]=CMath::sin(X(0,i))+0.1*CMath::randn_double();
+	}
+
+	features=new CDenseFeatures<float64_t>(X);
+	labels=new CRegressionLabels(y);
+}
+
+static SGVector<float64_t> train_and_apply(ETrainingType type, int32_t num,
+		CDenseFeatures<float64_t>* train, CRegressionLabels* labels,
+		CDenseFeatures<float64_t>* test)
+{
+	CKernelRidgeRegression* krr=new CKernelRidgeRegression(0.1,
+			new CGaussianKernel(10, 0.5), labels, type);
+	krr->set_num_landmarks(num);
+	krr->set_num_random_features(num);
+	SG_REF(krr);
+
+	krr->train(train);
+	CRegressionLabels* predicted=krr->apply_regression(test);
+	SGVector<float64_t> result=predicted->get_labels();
+
+	SG_UNREF(predicted);
+	SG_UNREF(krr);
+	return result;
+}
+
+TEST(KernelRidgeRegression, nystroem_all_landmarks)
+{
+	CMath::init_random(17);
+
+	CDenseFeatures<float64_t>* train;
+	CRegressionLabels* labels;
+	CDenseFeatures<float64_t>* test;
+	CRegressionLabels* test_labels;
+	create_data(40, train, labels);
+	create_data(20, test, test_labels);
+	SG_REF(train);
+	SG_REF(labels);
+	SG_REF(test);
+
+	SGVector<float64_t> exact=train_and_apply(PINV, 0, train, labels, test);
+	SGVector<float64_t> nystroem=train_and_apply(NYSTROEM, 40, train, labels,
+			test);
+
+	for (index_t i=0; i<exact.vlen; i++)
+		EXPECT_NEAR(nystroem[i], exact[i], 1E-6);
+
+	SG_UNREF(test_labels);
+	SG_UNREF(test);
+	SG_UNREF(labels);
+	SG_UNREF(train);
+}
+
+TEST(KernelRidgeRegression, approximations)
+{
+	CMath::init_random(17);
+
+	CDenseFeatures<float64_t>* train;
+	CRegressionLabels* labels;
+	CDenseFeatures<float64_t>* test;
+	CRegressionLabels* test_labels;
+	create_data(1000, train, labels);
+	create_data(100, test, test_labels);
+	SG_REF(train);
+	SG_REF(labels);
+	SG_REF(test);
+
+	SGVector<float64_t> exact=train_and_apply(PINV, 0, train, labels, test);
+	SGVector<float64_t> nystroem=train_and_apply(NYSTROEM, 50, train, labels,
+			test);
+	SGVector<float64_t> rff=train_and_apply(RANDOM_FOURIER, 300, train,
+			labels, test);
+
+	for (index_t i=0; i<exact.vlen; i++)
+	{
+		EXPECT_NEAR(nystroem[i], exact[i], 1E-2);
+		EXPECT_NEAR(rff[i], exact[i], 5E-2);
+	}
+
+	SG_UNREF(test_labels);
+	SG_UNREF(test);
+	SG_UNREF(labels);
+	SG_UNREF(train);
+}
+
+#endif // HAVE_LAPACK
@@ -16,6 +16,7 @@
 #include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/features/streaming/generators/MeanShiftDataGenerator.h>
 #include <shogun/mathematics/Statistics.h>
+#include <shogun/mathematics/Random.h>
 #include <gtest/gtest.h>
 
 using namespace shogun;
@@ -344,3 +345,116 @@ TEST(QuadraticTimeMMD,custom_kernel_vs_normal_kernel)
 	SG_UNREF(feat_p);
 	SG_UNREF(feat_q);
 }
+
+TEST(QuadraticTimeMMD,bootstrap_null_equals_permuted_statistic)
+{
+	index_t m=15;
+	index_t dim=3;
+
+	CMeanShiftDataGenerator* gen_p=new CMeanShiftDataGenerator(0, dim, 0);
+	CMeanShiftDataGenerator* gen_q=new CMeanShiftDataGenerator(0.5, dim, 0);
+	CFeatures* feat_p=gen_p->get_streamed_features(m);
+	CFeatures* feat_q=gen_q->get_streamed_features(m);
+
+	CGaussianKernel* kernel=new CGaussianKernel(10, 2);
+	CQuadraticTimeMMD* mmd=new CQuadraticTimeMMD(kernel, feat_p, feat_q);
+	mmd->set_bootstrap_iterations(37);
+	CFeatures* p_and_q=mmd->get_p_and_q();
+
+	EQuadraticMMDType types[2]={ BIASED, UNBIASED };
+	for (index_t t=0; t<2; ++t)
+	{
+		mmd->set_statistic_type(types[t]);
+
+		mmd->parallel->set_num_threads(4);
+		sg_rand->set_seed(12345);
+		SGVector<float64_t> null_samples=mmd->bootstrap_null();
+
+		/* result does not depend on the number of threads */
+		mmd->parallel->set_num_threads(1);
+		sg_rand->set_seed(12345);
+		SGVector<float64_t> serial=mmd->bootstrap_null();
+
+		/* permute features and compute statistic explicitly, blocks of 16
+		 * permutations are drawn from one seed each */
+		sg_rand->set_seed(12345);
+		SGVector<uint32_t> seeds(3);
+		for (index_t k=0; k<seeds.vlen; ++k)
+			seeds[k]=sg_rand->random_32();
+
+		SGVector<index_t> inds(2*m);
+		CRandom* rand=NULL;
+		ASSERT_EQ(null_samples.vlen, 37);
+		for (index_t i=0; i<null_samples.vlen; ++i)
+		{
+			if (i%16==0)
+			{
+				SG_UNREF(rand);
+				rand=new CRandom(seeds[i/16]);
+				inds.range_fill();
+			}
+
+			SGVector<index_t>::permute(inds.vector, inds.vlen, rand);
+			p_and_q->add_subset(inds);
+			float64_t expected=mmd->compute_statistic();
+			p_and_q->remove_subset();
+
+			EXPECT_NEAR(null_samples[i], expected, 1E-10);
+			EXPECT_EQ(null_samples[i], serial[i]);
+		}
+		SG_UNREF(rand);
+	}
+
+	SG_UNREF(p_and_q);
+	SG_UNREF(mmd);
+	SG_UNREF(feat_p);
+	SG_UNREF(feat_q);
+	SG_UNREF(gen_p);
+	SG_UNREF(gen_q);
+}
+
+TEST(QuadraticTimeMMD,sequential_bootstrap_p_value)
+{
+	index_t m=15;
+	index_t dim=3;
+
+	CMeanShiftDataGenerator* gen_p=new CMeanShiftDataGenerator(0, dim, 0);
+	CMeanShiftDataGenerator* gen_q=new CMeanShiftDataGenerator(0.5, dim, 0);
+	CFeatures* feat_p=gen_p->get_streamed_features(m);
+	CFeatures* feat_q=gen_q->get_streamed_features(m);
+
+	CGaussianKernel* kernel=new CGaussianKernel(10, 2);
+	CQuadraticTimeMMD* mmd=new CQuadraticTimeMMD(kernel, feat_p, feat_q);
+	mmd->set_null_approximation_method(BOOTSTRAP);
+	mmd->set_bootstrap_iterations(50);
+	float64_t statistic=mmd->compute_statistic();
+
+	sg_rand->set_seed(12345);
+	float64_t p_value=mmd->compute_p_value(statistic);
+
+	/* a loose tolerance settles after the first round */
+	mmd->set_bootstrap_early_stopping(1.0, 1000);
+	sg_rand->set_seed(12345);
+	EXPECT_NEAR(mmd->compute_p_value(statistic), p_value, 1E-15);
+
+	/* a tight one runs until the maximum number of samples is reached */
+	mmd->set_bootstrap_early_stopping(1E-10, 200);
+	sg_rand->set_seed(12345);
+	float64_t sequential=mmd->compute_p_value(statistic);
+
+	sg_rand->set_seed(12345);
+	index_t num_larger=0;
+	for (index_t i=0; i<4; ++i)
+	{
+		SGVector<float64_t> null_samples=mmd->bootstrap_null();
+		for (index_t j=0; j<null_samples.vlen; ++j)
+			num_larger+=null_samples[j]>statistic ? 1 : 0;
+	}
+	EXPECT_NEAR(sequential, num_larger/200.0, 1E-15);
+
+	SG_UNREF(mmd);
+	SG_UNREF(feat_p);
+	SG_UNREF(feat_q);
+	SG_UNREF(gen_p);
+	SG_UNREF(gen_q);
+}